@@ -2140,7 +2140,7 @@ with optional architecture-specific hardware acceleration
           {
             name = "ed25519-dalek";
             packageId = "ed25519-dalek";
-            features = [ "rand_core" "serde" ];
+            features = [ "batch" "rand_core" "serde" ];
           }
           {
             name = "frost-ed25519";
@@ -2615,7 +2615,7 @@ with optional architecture-specific hardware acceleration
           {
             name = "ed25519-dalek";
             packageId = "ed25519-dalek";
-            features = [ "rand_core" "serde" ];
+            features = [ "batch" "rand_core" "serde" ];
           }
           {
             name = "frost-ed25519";
@@ -8858,6 +8858,12 @@ decoding/encoding support
             packageId = "ed25519";
             usesDefaultFeatures = false;
           }
+          {
+            name = "merlin";
+            packageId = "merlin";
+            optional = true;
+            usesDefaultFeatures = false;
+          }
           {
             name = "rand_core";
             packageId = "rand_core 0.6.4";
@@ -8922,7 +8928,7 @@ decoding/encoding support
           "std" = [ "alloc" "ed25519/std" "serde?/std" "sha2/std" ];
           "zeroize" = [ "dep:zeroize" "curve25519-dalek/zeroize" ];
         };
-        resolvedDefaultFeatures = [ "alloc" "default" "fast" "rand_core" "serde" "std" "zeroize" ];
+        resolvedDefaultFeatures = [ "alloc" "batch" "default" "fast" "merlin" "rand_core" "serde" "std" "zeroize" ];
       };
       "either" = rec {
         crateName = "either";
@@ -12178,7 +12184,7 @@ as in the AES-GCM authenticated encryption cipher.
           {
             name = "ed25519-dalek";
             packageId = "ed25519-dalek";
-            features = [ "rand_core" "serde" ];
+            features = [ "batch" "rand_core" "serde" ];
           }
           {
             name = "frost-ed25519";
@@ -12968,7 +12974,7 @@ as in the AES-GCM authenticated encryption cipher.
           {
             name = "ed25519-dalek";
             packageId = "ed25519-dalek";
-            features = [ "rand_core" "serde" ];
+            features = [ "batch" "rand_core" "serde" ];
           }
           {
             name = "futures";
@@ -13290,7 +13296,7 @@ as in the AES-GCM authenticated encryption cipher.
           {
             name = "ed25519-dalek";
             packageId = "ed25519-dalek";
-            features = [ "rand_core" "serde" ];
+            features = [ "batch" "rand_core" "serde" ];
           }
           {
             name = "frost-core";
@@ -13396,6 +13402,16 @@ as in the AES-GCM authenticated encryption cipher.
           }
         ];
         devDependencies = [
+          {
+            name = "criterion";
+            packageId = "criterion";
+            target = { target, features }: (!("wasm32" == target."arch" or null));
+          }
+          {
+            name = "hxrts-aura-effects";
+            packageId = "hxrts-aura-effects";
+            rename = "aura-effects";
+          }
           {
             name = "proptest";
             packageId = "proptest";
@@ -13451,7 +13467,7 @@ as in the AES-GCM authenticated encryption cipher.
           {
             name = "ed25519-dalek";
             packageId = "ed25519-dalek";
-            features = [ "rand_core" "serde" ];
+            features = [ "batch" "rand_core" "serde" ];
           }
           {
             name = "frost-ed25519";
@@ -13606,6 +13622,11 @@ as in the AES-GCM authenticated encryption cipher.
             packageId = "biscuit-auth";
             features = [ "wasm" ];
           }
+          {
+            name = "bytes";
+            packageId = "bytes";
+            features = [ "serde" ];
+          }
           {
             name = "cfg-if";
             packageId = "cfg-if";
@@ -13625,7 +13646,7 @@ as in the AES-GCM authenticated encryption cipher.
           {
             name = "ed25519-dalek";
             packageId = "ed25519-dalek";
-            features = [ "rand_core" "serde" ];
+            features = [ "batch" "rand_core" "serde" ];
           }
           {
             name = "fastrand";
@@ -14413,7 +14434,7 @@ as in the AES-GCM authenticated encryption cipher.
           {
             name = "ed25519-dalek";
             packageId = "ed25519-dalek";
-            features = [ "rand_core" "serde" ];
+            features = [ "batch" "rand_core" "serde" ];
           }
           {
             name = "frost-ed25519";
@@ -14826,7 +14847,7 @@ as in the AES-GCM authenticated encryption cipher.
           {
             name = "ed25519-dalek";
             packageId = "ed25519-dalek";
-            features = [ "rand_core" "serde" ];
+            features = [ "batch" "rand_core" "serde" ];
           }
           {
             name = "futures";
@@ -14984,7 +15005,7 @@ as in the AES-GCM authenticated encryption cipher.
           {
             name = "ed25519-dalek";
             packageId = "ed25519-dalek";
-            features = [ "rand_core" "serde" ];
+            features = [ "batch" "rand_core" "serde" ];
           }
           {
             name = "proptest";
@@ -15269,6 +15290,11 @@ as in the AES-GCM authenticated encryption cipher.
             packageId = "aura-testkit";
             rename = "aura-testkit";
           }
+          {
+            name = "criterion";
+            packageId = "criterion";
+            target = { target, features }: (!("wasm32" == target."arch" or null));
+          }
           {
             name = "hxrts-aura-macros";
             packageId = "hxrts-aura-macros";
@@ -17140,6 +17166,25 @@ Node.js and browsers, built on `#[wasm_bindgen]` using the `wasm-bindgen` crate.
         };
         resolvedDefaultFeatures = [ "default" "futures" "std" "unsafe-eval" ];
       };
+      "keccak" = rec {
+        crateName = "keccak";
+        version = "0.1.5";
+        edition = "2018";
+        description = "Pure Rust implementation of the Keccak sponge function including the keccak-f and keccak-p variants";
+        sha256 = "0m06swsyd58hvb1z17q6picdwywprf1yf1s6l491zi8r26dazhpc";
+        authors = [
+          "RustCrypto Developers"
+        ];
+        dependencies = [
+          {
+            name = "cpufeatures";
+            packageId = "cpufeatures 0.2.17";
+            target = { target, features }: ("aarch64" == target."arch" or null);
+          }
+        ];
+        features = {
+        };
+      };
       "keyboard-types" = rec {
         crateName = "keyboard-types";
         version = "0.7.0";
@@ -18152,6 +18197,44 @@ be used outside of a proc-macro context.
         };
         resolvedDefaultFeatures = [ "default" ];
       };
+      "merlin" = rec {
+        crateName = "merlin";
+        version = "3.0.0";
+        edition = "2018";
+        description = "Composable proof transcripts for public-coin arguments of knowledge";
+        sha256 = "0z9rh9jlpcs0i0cijbs6pcq26gl4qwz05y7zbnv7h2gwk4kqxhsq";
+        authors = [
+          "Henry de Valence <hdevalence@hdevalence.ca>"
+        ];
+        dependencies = [
+          {
+            name = "byteorder";
+            packageId = "byteorder";
+            usesDefaultFeatures = false;
+          }
+          {
+            name = "keccak";
+            packageId = "keccak";
+          }
+          {
+            name = "rand_core";
+            packageId = "rand_core 0.6.4";
+            usesDefaultFeatures = false;
+          }
+          {
+            name = "zeroize";
+            packageId = "zeroize";
+            usesDefaultFeatures = false;
+            features = [ "zeroize_derive" ];
+          }
+        ];
+        features = {
+          "debug-transcript" = [ "hex" ];
+          "default" = [ "std" ];
+          "hex" = [ "dep:hex" ];
+          "std" = [ "rand_core/std" ];
+        };
+      };
       "mime" = rec {
         crateName = "mime";
         version = "0.3.17";
@@ -0,0 +1,63 @@
+#![allow(clippy::expect_used, clippy::disallowed_methods)]
+#![allow(missing_docs)]
+//! Multi-threaded ingestion and query contention on `IndexedJournalHandler`.
+//!
+//! Extends the single-threaded 10k-fact performance test: the same 10k facts
+//! over 100 predicates are split across writer threads, and every writer
+//! interleaves predicate queries, Bloom checks, and Merkle root reads.
+
+use aura_agent::database::IndexedJournalHandler;
+use aura_core::domain::journal::FactValue;
+use aura_core::effects::IndexedJournalEffects;
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use futures::executor::block_on;
+
+const TOTAL_FACTS: usize = 10_000;
+const PREDICATES: usize = 100;
+const QUERY_EVERY: usize = 10;
+
+fn ingest_and_query(handler: &IndexedJournalHandler, thread: usize, threads: usize) {
+    for i in (thread..TOTAL_FACTS).step_by(threads) {
+        let predicate = format!("key.{}", i % PREDICATES);
+        handler
+            .add_fact(predicate.clone(), FactValue::Number(i as i64), None, None)
+            .expect("add fact");
+
+        if i % QUERY_EVERY == 0 {
+            let facts = block_on(handler.facts_by_predicate(&predicate)).expect("query");
+            black_box(facts.len());
+            black_box(handler.might_contain(&predicate, &FactValue::Number(i as i64)));
+            black_box(block_on(handler.merkle_root()).expect("root"));
+        }
+    }
+}
+
+fn bench_contention(c: &mut Criterion) {
+    let mut group = c.benchmark_group("indexed_journal_contention");
+    group.sample_size(10);
+    group.throughput(Throughput::Elements(TOTAL_FACTS as u64));
+
+    for threads in [1usize, 2, 4, 8] {
+        group.bench_with_input(
+            BenchmarkId::from_parameter(threads),
+            &threads,
+            |b, &threads| {
+                b.iter(|| {
+                    let handler = IndexedJournalHandler::with_capacity(TOTAL_FACTS as u64);
+                    std::thread::scope(|scope| {
+                        for thread in 0..threads {
+                            let handler = &handler;
+                            scope.spawn(move || ingest_and_query(handler, thread, threads));
+                        }
+                    });
+                    black_box(block_on(handler.merkle_root()).expect("root"));
+                });
+            },
+        );
+    }
+
+    group.finish();
+}
+
+criterion_group!(benches, bench_contention);
+criterion_main!(benches);
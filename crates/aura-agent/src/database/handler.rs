@@ -5,19 +5,28 @@
 //! cryptographic verification of integrity using Merkle trees.
 
 use super::authority_index::AuthorityIndex;
-use super::merkle::build_merkle_tree;
+use super::merkle::MerkleMountainRange;
 use super::stream::TokioFactStreamReceiver;
+use super::time_key::TimeKey;
 use async_trait::async_trait;
 use aura_core::{
+    crypto::merkle::{verify_mountain_range_proof, MerkleMountainRangeProof},
     domain::journal::FactValue,
     effects::indexed::{FactId, FactStreamReceiver, IndexedFact},
-    effects::{BloomConfig, BloomFilter, IndexStats, IndexedJournalEffects},
+    effects::{BloomConfig, BloomFilter, IndexStats, IndexedJournalEffects, ScalableBloomFilter},
     time::TimeStamp,
     types::identifiers::AuthorityId,
     AuraError,
 };
-use parking_lot::RwLock;
-use std::collections::HashSet;
+use parking_lot::{Mutex, RwLock};
+use std::collections::BTreeSet;
+use std::sync::atomic::{AtomicU64, Ordering};
+
+/// Compound false positive bound for the fact Bloom filter
+const BLOOM_FALSE_POSITIVE_RATE: f64 = 0.01;
+
+/// Number of predicate shards in the B-tree index
+const INDEX_SHARDS: usize = 16;
 
 /// Production indexed journal handler
 ///
@@ -30,49 +39,40 @@ use std::collections::HashSet;
 /// - `facts_by_predicate`: O(log n + k) where k is result size
 /// - `facts_by_authority`: O(log n + k) where k is result size
 /// - `facts_in_range`: O(log n + k) where k is result size
-/// - `might_contain`: O(1) with <1% false positive rate
-/// - `merkle_root`: O(n) on first call, O(1) cached
-/// - `verify_fact_inclusion`: O(log n)
+/// - `might_contain`: O(log n) stages, <1% false positive rate at any size
+/// - `get_bloom_filter`: O(1) amortized; the wire filter is updated on append
+/// - `merkle_root`: O(1), maintained in O(log n) per append
+/// - `verify_fact_inclusion`: O(log n), checked against a real inclusion proof
+/// - `fact_inclusion_proof`: O(log n)
 ///
 /// # Concurrency Model
 ///
-/// Uses `parking_lot::RwLock` for synchronous locking of the state bundle.
-/// Each operation acquires and releases the lock in sub-millisecond time.
-/// See module documentation for scale expectations and alternatives.
+/// The B-tree index is split into [`INDEX_SHARDS`] shards by predicate, and
+/// the Bloom filter and Merkle mountain range each sit behind their own
+/// `parking_lot::RwLock`. Fact IDs come from an atomic counter. Writers to
+/// different predicates do not contend on the index, and Merkle and Bloom
+/// reads take shared locks only, so queries proceed alongside ingestion.
+///
+/// `add_fact` updates the Bloom filter, then the index, then the Merkle
+/// range. A fallible Bloom grow fails the append before anything else
+/// changes. A concurrent reader may see a fact in the index before its root
+/// includes it, never the reverse.
 pub struct IndexedJournalHandler {
-    /// Database handler state (index, bloom, merkle cache)
-    state: RwLock<DatabaseState>,
+    /// B-tree indexes sharded by predicate
+    shards: Box<[RwLock<AuthorityIndex>]>,
+    /// Next fact ID to assign
+    next_id: AtomicU64,
+    /// Grows with the index so the false positive rate stays bounded
+    bloom_filter: RwLock<ScalableBloomFilter>,
+    /// Single-filter wire view of the index, updated on append and rebuilt
+    /// only when it outgrows its sizing
+    bloom_snapshot: Mutex<Option<BloomFilter>>,
+    /// Distinct fact hashes in first-indexed order
+    merkle: RwLock<MerkleMountainRange>,
     /// Broadcast channel for streaming fact updates to subscribers
     pub(crate) fact_updates: tokio::sync::broadcast::Sender<Vec<IndexedFact>>,
 }
 
-#[derive(Debug)]
-struct DatabaseState {
-    index: AuthorityIndex,
-    bloom_filter: BloomFilter,
-    merkle_root_cache: Option<[u8; 32]>,
-    fact_hashes: HashSet<[u8; 32]>,
-}
-
-impl DatabaseState {
-    #[allow(dead_code)] // For use with with_state_mut_validated
-    fn validate(&self) -> Result<(), crate::runtime::services::invariant::InvariantViolation> {
-        if self.bloom_filter.element_count < self.fact_hashes.len() as u64 {
-            return Err(
-                crate::runtime::services::invariant::InvariantViolation::new(
-                    "IndexedJournal",
-                    format!(
-                        "bloom filter count {} below fact hash count {}",
-                        self.bloom_filter.element_count,
-                        self.fact_hashes.len()
-                    ),
-                ),
-            );
-        }
-        Ok(())
-    }
-}
-
 impl IndexedJournalHandler {
     /// Create a new indexed journal handler with default configuration
     pub fn new() -> Self {
@@ -80,105 +80,128 @@ impl IndexedJournalHandler {
     }
 
     /// Create a new indexed journal handler with specified expected capacity
+    ///
+    /// The capacity sizes the first Bloom filter stage; the filter keeps
+    /// growing past it without losing its false positive bound.
     pub fn with_capacity(expected_elements: u64) -> Self {
-        let bloom_config = BloomConfig::optimal(expected_elements, 0.01);
-        let bloom_filter = BloomFilter::new(bloom_config).expect("Failed to create bloom filter");
+        let bloom_filter = ScalableBloomFilter::new(expected_elements, BLOOM_FALSE_POSITIVE_RATE)
+            .expect("Failed to create bloom filter");
 
         // Create broadcast channel for fact streaming (capacity: 100 batches)
         let (fact_updates_tx, _) = tokio::sync::broadcast::channel(100);
 
         Self {
-            state: RwLock::new(DatabaseState {
-                index: AuthorityIndex::new(),
-                bloom_filter,
-                merkle_root_cache: None,
-                fact_hashes: HashSet::new(),
-            }),
+            shards: (0..INDEX_SHARDS)
+                .map(|_| RwLock::new(AuthorityIndex::new()))
+                .collect(),
+            next_id: AtomicU64::new(0),
+            bloom_filter: RwLock::new(bloom_filter),
+            bloom_snapshot: Mutex::new(None),
+            merkle: RwLock::new(MerkleMountainRange::new()),
             fact_updates: fact_updates_tx,
         }
     }
 
-    fn with_state<R>(&self, op: impl FnOnce(&DatabaseState) -> R) -> R {
-        let guard = self.state.read();
-        op(&guard)
+    fn shard_for(&self, predicate: &str) -> &RwLock<AuthorityIndex> {
+        let digest = aura_core::hash::hash(predicate.as_bytes());
+        let mut prefix = [0u8; 8];
+        prefix.copy_from_slice(&digest[..8]);
+        &self.shards[(u64::from_le_bytes(prefix) % self.shards.len() as u64) as usize]
     }
 
-    fn with_state_mut<R>(&self, op: impl FnOnce(&mut DatabaseState) -> R) -> R {
-        let mut guard = self.state.write();
-        let result = op(&mut guard);
-        #[cfg(debug_assertions)]
-        {
-            if let Err(message) = guard.validate() {
-                tracing::error!(%message, "IndexedJournalHandler state invariant violated");
-                debug_assert!(
-                    false,
-                    "IndexedJournalHandler invariant violated: {}",
-                    message
-                );
-            }
+    /// Collect results from every shard.
+    fn gather<R>(&self, op: impl Fn(&AuthorityIndex) -> Vec<R>) -> Vec<R> {
+        self.shards
+            .iter()
+            .flat_map(|shard| op(&shard.read()))
+            .collect()
+    }
+
+    /// Check that every Merkle leaf has been counted by the Bloom filter.
+    ///
+    /// Writers update the Bloom filter before the Merkle range, so reading
+    /// the Merkle length first keeps the check sound under concurrency.
+    #[allow(dead_code)] // Only checked in debug builds
+    fn validate(&self) -> Result<(), crate::runtime::services::invariant::InvariantViolation> {
+        let merkle_len = self.merkle.read().len();
+        let bloom_count = self.bloom_filter.read().element_count();
+        if bloom_count < merkle_len {
+            return Err(
+                crate::runtime::services::invariant::InvariantViolation::new(
+                    "IndexedJournal",
+                    format!(
+                        "bloom filter count {} below fact hash count {}",
+                        bloom_count, merkle_len
+                    ),
+                ),
+            );
         }
-        result
+        Ok(())
     }
 
     /// Add a fact to the index
+    ///
+    /// # Errors
+    ///
+    /// Fails without indexing the fact if the Bloom filter cannot grow.
     pub fn add_fact(
         &self,
         predicate: String,
         value: FactValue,
         authority: Option<AuthorityId>,
         timestamp: Option<TimeStamp>,
-    ) -> FactId {
+    ) -> Result<FactId, AuraError> {
         let element = self.fact_to_bytes(&predicate, &value);
         let fact_hash = aura_core::hash::hash(&element);
 
-        let (id, fact_to_broadcast) = self.with_state_mut(|state| {
-            // Insert into B-tree indexes
-            let id = state
-                .index
-                .insert(predicate.clone(), value.clone(), authority, timestamp);
-
-            // Insert into Bloom filter
-            // Direct bloom filter insertion (synchronous for lock-based access)
-            for i in 0..state.bloom_filter.config.num_hash_functions {
-                let i = i as u64;
-                let hash_bytes = {
-                    let mut hasher = aura_core::hash::hasher();
-                    hasher.update(&i.to_le_bytes());
-                    hasher.update(&element);
-                    hasher.finalize().to_vec()
-                };
-                let mut hash_u64_bytes = [0u8; 8];
-                hash_u64_bytes.copy_from_slice(&hash_bytes[..8]);
-                let hash_value = u64::from_le_bytes(hash_u64_bytes);
-
-                let bit_index = hash_value % state.bloom_filter.config.bit_vector_size;
-                let byte_index = (bit_index / 8) as usize;
-                let bit_offset = (bit_index % 8) as u8;
-
-                if byte_index < state.bloom_filter.bits.len() {
-                    state.bloom_filter.bits[byte_index] |= 1u8 << bit_offset;
+        // Insert into Bloom filter first; a failed grow leaves no trace
+        self.bloom_filter.write().insert(&element)?;
+
+        let fact = IndexedFact {
+            id: FactId::new(self.next_id.fetch_add(1, Ordering::Relaxed)),
+            predicate,
+            value,
+            authority,
+            timestamp,
+        };
+        let id = fact.id;
+
+        // Insert into B-tree indexes
+        self.shard_for(&fact.predicate).write().insert(fact.clone());
+
+        // Keep the wire filter in step. A rebuild scans the index under this
+        // lock, so a fact indexed after that scan is added here instead.
+        {
+            let mut snapshot = self.bloom_snapshot.lock();
+            if let Some(filter) = snapshot.as_mut() {
+                if filter.element_count < filter.config.expected_elements {
+                    filter.insert(&element);
+                } else {
+                    *snapshot = None;
                 }
             }
-            state.bloom_filter.element_count += 1;
-
-            // Add to Merkle tree hashes
-            state.fact_hashes.insert(fact_hash);
+        }
 
-            // Invalidate Merkle cache
-            state.merkle_root_cache = None;
+        // Append to the Merkle mountain range (duplicates are ignored)
+        self.merkle.write().push(fact_hash);
 
-            // Retrieve the fact we just added for broadcasting.
-            let fact = state.index.facts.get(&id).cloned();
-            (id, fact)
-        });
+        #[cfg(debug_assertions)]
+        {
+            if let Err(message) = self.validate() {
+                tracing::error!(%message, "IndexedJournalHandler state invariant violated");
+                debug_assert!(
+                    false,
+                    "IndexedJournalHandler invariant violated: {}",
+                    message
+                );
+            }
+        }
 
-        if let Some(fact) = fact_to_broadcast {
-            // Send as a batch of one fact
-            // Ignore send errors (happens when there are no subscribers)
-            let _ = self.fact_updates.send(vec![fact]);
-        };
+        // Send as a batch of one fact
+        // Ignore send errors (happens when there are no subscribers)
+        let _ = self.fact_updates.send(vec![fact]);
 
-        id
+        Ok(id)
     }
 
     /// Convert a fact to bytes for hashing
@@ -223,51 +246,48 @@ impl IndexedJournalHandler {
     /// Check if a fact might be contained (using Bloom filter)
     pub(crate) fn bloom_check(&self, predicate: &str, value: &FactValue) -> bool {
         let element = self.fact_to_bytes(predicate, value);
-        self.with_state(|state| {
-            let filter = &state.bloom_filter;
-            for i in 0..filter.config.num_hash_functions {
-                let i = i as u64;
-                let hash_bytes = {
-                    let mut hasher = aura_core::hash::hasher();
-                    hasher.update(&i.to_le_bytes());
-                    hasher.update(&element);
-                    hasher.finalize().to_vec()
-                };
-                let mut hash_u64_bytes = [0u8; 8];
-                hash_u64_bytes.copy_from_slice(&hash_bytes[..8]);
-                let hash_value = u64::from_le_bytes(hash_u64_bytes);
-
-                let bit_index = hash_value % filter.config.bit_vector_size;
-                let byte_index = (bit_index / 8) as usize;
-                let bit_offset = (bit_index % 8) as u8;
-
-                if byte_index >= filter.bits.len()
-                    || (filter.bits[byte_index] & (1u8 << bit_offset)) == 0
-                {
-                    return false;
-                }
-            }
-            true
-        })
+        self.bloom_filter.read().might_contain(&element)
     }
 
-    /// Compute or retrieve cached Merkle root
-    pub(crate) fn compute_merkle_root(&self) -> [u8; 32] {
-        self.with_state_mut(|state| {
-            if let Some(root) = state.merkle_root_cache {
-                return root;
-            }
+    /// Single Bloom filter over every indexed fact, in the peer wire format
+    ///
+    /// Sized for the current fact count rather than the initial capacity, so
+    /// it passes peer-side `validate_wire` however far the index has grown.
+    /// Appends insert into the cached filter directly; it is rebuilt from the
+    /// index, with room to double, only once it reaches its sizing.
+    pub(crate) fn bloom_snapshot(&self) -> Result<BloomFilter, AuraError> {
+        let mut cached = self.bloom_snapshot.lock();
+        if let Some(snapshot) = cached.as_ref() {
+            return Ok(snapshot.clone());
+        }
 
-            let hashes: Vec<[u8; 32]> = state.fact_hashes.iter().copied().collect();
-            let root = if let Some(tree) = build_merkle_tree(hashes) {
-                tree.hash
-            } else {
-                [0u8; 32]
-            };
+        let elements = self.gather(|index| {
+            index
+                .facts
+                .values()
+                .map(|fact| self.fact_to_bytes(&fact.predicate, &fact.value))
+                .collect()
+        });
+        let mut snapshot = BloomFilter::new(BloomConfig::optimal(
+            (elements.len() as u64).saturating_mul(2).max(64),
+            BLOOM_FALSE_POSITIVE_RATE,
+        ))?;
+        for element in &elements {
+            snapshot.insert(element);
+        }
+        *cached = Some(snapshot.clone());
+        Ok(snapshot)
+    }
 
-            state.merkle_root_cache = Some(root);
-            root
-        })
+    /// Retrieve the Merkle root
+    pub(crate) fn compute_merkle_root(&self) -> [u8; 32] {
+        self.merkle.read().root()
+    }
+
+    /// Inclusion proof for a fact against the current Merkle root
+    pub(crate) fn inclusion_proof(&self, fact: &IndexedFact) -> Option<MerkleMountainRangeProof> {
+        let fact_hash = aura_core::hash::hash(&self.fact_to_bytes(&fact.predicate, &fact.value));
+        self.merkle.read().proof(&fact_hash)
     }
 }
 
@@ -279,21 +299,33 @@ impl Default for IndexedJournalHandler {
 
 impl std::fmt::Debug for IndexedJournalHandler {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
-        let (fact_count, predicate_count, authority_count) = self.with_state(|state| {
-            (
-                state.index.facts.len(),
-                state.index.by_predicate.len(),
-                state.index.by_authority.len(),
-            )
-        });
+        let stats = self.stats();
         f.debug_struct("IndexedJournalHandler")
-            .field("fact_count", &fact_count)
-            .field("predicate_count", &predicate_count)
-            .field("authority_count", &authority_count)
+            .field("fact_count", &stats.fact_count)
+            .field("predicate_count", &stats.predicate_count)
+            .field("authority_count", &stats.authority_count)
             .finish()
     }
 }
 
+impl IndexedJournalHandler {
+    /// Index statistics merged across shards
+    fn stats(&self) -> IndexStats {
+        let mut authorities = BTreeSet::new();
+        let mut stats = IndexStats::default();
+        for shard in self.shards.iter() {
+            let shard = shard.read();
+            stats.fact_count += shard.facts.len() as u64;
+            // Predicates never span shards; authorities can
+            stats.predicate_count += shard.by_predicate.len() as u64;
+            authorities.extend(shard.by_authority.keys().copied());
+        }
+        stats.authority_count = authorities.len() as u64;
+        stats.merkle_depth = self.merkle.read().depth();
+        stats
+    }
+}
+
 #[async_trait]
 impl IndexedJournalEffects for IndexedJournalHandler {
     fn watch_facts(&self) -> Box<dyn FactStreamReceiver> {
@@ -301,14 +333,16 @@ impl IndexedJournalEffects for IndexedJournalHandler {
     }
 
     async fn facts_by_predicate(&self, predicate: &str) -> Result<Vec<IndexedFact>, AuraError> {
-        Ok(self.with_state(|state| state.index.get_by_predicate(predicate)))
+        Ok(self.shard_for(predicate).read().get_by_predicate(predicate))
     }
 
     async fn facts_by_authority(
         &self,
         authority: &AuthorityId,
     ) -> Result<Vec<IndexedFact>, AuraError> {
-        Ok(self.with_state(|state| state.index.get_by_authority(authority)))
+        let mut facts = self.gather(|index| index.get_by_authority(authority));
+        facts.sort_by_key(|fact| fact.id);
+        Ok(facts)
     }
 
     async fn facts_in_range(
@@ -316,11 +350,17 @@ impl IndexedJournalEffects for IndexedJournalHandler {
         start: TimeStamp,
         end: TimeStamp,
     ) -> Result<Vec<IndexedFact>, AuraError> {
-        Ok(self.with_state(|state| state.index.get_in_range(&start, &end)))
+        let mut facts = self.gather(|index| index.get_in_range(&start, &end));
+        facts.sort_by_cached_key(|fact| {
+            (fact.timestamp.clone().map(TimeKey::from_timestamp), fact.id)
+        });
+        Ok(facts)
     }
 
     async fn all_facts(&self) -> Result<Vec<IndexedFact>, AuraError> {
-        Ok(self.with_state(|state| state.index.facts.values().cloned().collect()))
+        let mut facts = self.gather(|index| index.facts.values().cloned().collect());
+        facts.sort_by_key(|fact| fact.id);
+        Ok(facts)
     }
 
     fn might_contain(&self, predicate: &str, value: &FactValue) -> bool {
@@ -332,32 +372,29 @@ impl IndexedJournalEffects for IndexedJournalHandler {
     }
 
     async fn verify_fact_inclusion(&self, fact: &IndexedFact) -> Result<bool, AuraError> {
-        let element = self.fact_to_bytes(&fact.predicate, &fact.value);
-        let fact_hash = aura_core::hash::hash(&element);
-        Ok(self.with_state(|state| state.fact_hashes.contains(&fact_hash)))
+        let fact_hash = aura_core::hash::hash(&self.fact_to_bytes(&fact.predicate, &fact.value));
+        let (root, proof) = {
+            let merkle = self.merkle.read();
+            (merkle.root(), merkle.proof(&fact_hash))
+        };
+        Ok(proof.is_some_and(|proof| verify_mountain_range_proof(&proof, &root, &fact_hash)))
+    }
+
+    async fn fact_inclusion_proof(
+        &self,
+        fact: &IndexedFact,
+    ) -> Result<Option<MerkleMountainRangeProof>, AuraError> {
+        Ok(self.inclusion_proof(fact))
     }
 
     async fn get_bloom_filter(&self) -> Result<BloomFilter, AuraError> {
-        Ok(self.with_state(|state| state.bloom_filter.clone()))
+        self.bloom_snapshot()
     }
 
     async fn index_stats(&self) -> Result<IndexStats, AuraError> {
-        let (stats, filter) =
-            self.with_state(|state| (state.index.stats(), state.bloom_filter.clone()));
-        let mut stats = stats;
-        // Estimate false positive rate based on filter fill ratio
-        // Note: set_bits could be used for more accurate FP estimation in the future
-        let _set_bits: u64 = filter.bits.iter().map(|b| b.count_ones() as u64).sum();
-        let m = filter.config.bit_vector_size as f64;
-        let k = filter.config.num_hash_functions as f64;
-        let n = filter.element_count as f64;
-
-        if n > 0.0 {
-            // FP rate ≈ (1 - e^(-kn/m))^k
-            let fill_ratio: f64 = (-k * n / m).exp();
-            stats.bloom_fp_rate = (1.0_f64 - fill_ratio).powf(k);
-        }
-
+        let mut stats = self.stats();
+        // Compound estimate across stages: 1 - Π(1 - (1 - e^(-kn/m))^k)
+        stats.bloom_fp_rate = self.bloom_filter.read().current_false_positive_rate();
         Ok(stats)
     }
 }
@@ -1,61 +1,185 @@
-//! Merkle tree construction for integrity verification.
-
-/// Merkle tree node for integrity verification
-#[derive(Debug, Clone)]
-pub(crate) struct MerkleNode {
-    pub(crate) hash: [u8; 32],
-    /// Left child (used for Merkle proof generation)
-    _left: Option<Box<MerkleNode>>,
-    /// Right child (used for Merkle proof generation)
-    _right: Option<Box<MerkleNode>>,
+//! Merkle mountain range for integrity verification.
+//!
+//! Leaves are fact hashes in the order they were first indexed, tagged as
+//! leaves before they enter the range. Appending a leaf merges equal-height
+//! trees like a binary counter and re-bags the peaks with the leaf count, so each append costs `O(log n)` hashes, and inclusion proofs are
+//! `O(log n)` hashes that verify with
+//! [`verify_mountain_range_proof`](aura_core::crypto::merkle::verify_mountain_range_proof).
+
+use aura_core::crypto::merkle::{
+    bag_mountain_range_peaks, mountain_range_leaf, mountain_range_node, MerkleMountainRangeProof,
+};
+use std::collections::HashMap;
+
+/// Append-only Merkle mountain range over distinct leaf hashes
+#[derive(Debug, Clone, Default)]
+pub(crate) struct MerkleMountainRange {
+    /// `levels[h][i]` is the tagged root of the perfect subtree over leaves
+    /// `i * 2^h .. (i + 1) * 2^h`
+    levels: Vec<Vec<[u8; 32]>>,
+    /// Leaf position by hash
+    positions: HashMap<[u8; 32], u64>,
+    /// Root of the current range, re-bagged on append
+    root: [u8; 32],
 }
 
-impl MerkleNode {
-    fn branch(left: MerkleNode, right: MerkleNode) -> Self {
-        let mut combined = Vec::with_capacity(64);
-        combined.extend_from_slice(&left.hash);
-        combined.extend_from_slice(&right.hash);
-        let hash = aura_core::hash::hash(&combined);
-        Self {
-            hash,
-            _left: Some(Box::new(left)),
-            _right: Some(Box::new(right)),
+impl MerkleMountainRange {
+    pub(crate) fn new() -> Self {
+        Self::default()
+    }
+
+    /// Number of distinct leaves.
+    pub(crate) fn len(&self) -> u64 {
+        self.positions.len() as u64
+    }
+
+    pub(crate) fn contains(&self, leaf: &[u8; 32]) -> bool {
+        self.positions.contains_key(leaf)
+    }
+
+    /// Height of the tallest peak.
+    pub(crate) fn depth(&self) -> u32 {
+        self.levels.len().saturating_sub(1) as u32
+    }
+
+    /// Append a leaf; returns `false` if it is already present.
+    pub(crate) fn push(&mut self, leaf: [u8; 32]) -> bool {
+        if self.contains(&leaf) {
+            return false;
+        }
+        self.positions.insert(leaf, self.len());
+
+        let mut node = mountain_range_leaf(&leaf);
+        let mut height = 0;
+        loop {
+            if self.levels.len() == height {
+                self.levels.push(Vec::new());
+            }
+            let level = &mut self.levels[height];
+            level.push(node);
+            if level.len() % 2 == 1 {
+                break;
+            }
+            node = mountain_range_node(&level[level.len() - 2], &level[level.len() - 1]);
+            height += 1;
         }
+
+        let peaks: Vec<[u8; 32]> = self.peaks().collect();
+        self.root = bag_mountain_range_peaks(&peaks, self.len());
+        true
+    }
+
+    /// Current peaks, tallest (leftmost) first.
+    fn peaks(&self) -> impl Iterator<Item = [u8; 32]> + '_ {
+        self.levels
+            .iter()
+            .rev()
+            .filter(|level| level.len() % 2 == 1)
+            .filter_map(|level| level.last().copied())
     }
-}
 
-/// Build a Merkle tree from leaf hashes
-pub(crate) fn build_merkle_tree(leaves: Vec<[u8; 32]>) -> Option<MerkleNode> {
-    if leaves.is_empty() {
-        return None;
+    /// Root over all leaves, or all zeroes when empty.
+    pub(crate) fn root(&self) -> [u8; 32] {
+        self.root
     }
 
-    let mut nodes: Vec<MerkleNode> = leaves
-        .into_iter()
-        .map(|hash| MerkleNode {
-            hash,
-            _left: None,
-            _right: None,
+    /// Inclusion proof for `leaf` against the current root.
+    pub(crate) fn proof(&self, leaf: &[u8; 32]) -> Option<MerkleMountainRangeProof> {
+        let leaf_index = *self.positions.get(leaf)?;
+
+        let mut sibling_path = Vec::new();
+        let mut index = leaf_index as usize;
+        let mut height = 0;
+        while let Some(sibling) = self.levels[height].get(index ^ 1) {
+            sibling_path.push(*sibling);
+            index /= 2;
+            height += 1;
+        }
+
+        // Peaks are listed tallest first, so the taller peaks precede ours
+        let position = self.levels[height + 1..]
+            .iter()
+            .filter(|level| level.len() % 2 == 1)
+            .count();
+        let mut peaks: Vec<[u8; 32]> = self.peaks().collect();
+        peaks.remove(position);
+
+        Some(MerkleMountainRangeProof {
+            leaf_index,
+            leaf_count: self.len(),
+            sibling_path,
+            peaks,
         })
-        .collect();
-
-    while nodes.len() > 1 {
-        let mut next_level = Vec::new();
-        let mut i = 0;
-        while i < nodes.len() {
-            if i + 1 < nodes.len() {
-                let left = nodes[i].clone();
-                let right = nodes[i + 1].clone();
-                next_level.push(MerkleNode::branch(left, right));
-                i += 2;
-            } else {
-                // Odd node - promote to next level
-                next_level.push(nodes[i].clone());
-                i += 1;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use aura_core::crypto::merkle::verify_mountain_range_proof;
+
+    fn leaf(n: u32) -> [u8; 32] {
+        aura_core::hash::hash(&n.to_le_bytes())
+    }
+
+    #[test]
+    fn every_leaf_proves_against_every_root() {
+        let mut range = MerkleMountainRange::new();
+        assert_eq!(range.root(), [0u8; 32]);
+
+        for n in 0..33 {
+            assert!(range.push(leaf(n)));
+            let root = range.root();
+            for existing in 0..=n {
+                let proof = range.proof(&leaf(existing)).unwrap();
+                assert!(verify_mountain_range_proof(&proof, &root, &leaf(existing)));
+                assert!(!verify_mountain_range_proof(&proof, &root, &leaf(n + 1)));
             }
         }
-        nodes = next_level;
+        assert_eq!(range.depth(), 5);
     }
 
-    nodes.into_iter().next()
+    #[test]
+    fn root_depends_on_content_and_order_only() {
+        let mut a = MerkleMountainRange::new();
+        let mut b = MerkleMountainRange::new();
+        for n in 0..7 {
+            a.push(leaf(n));
+            b.push(leaf(n));
+        }
+        assert!(!b.push(leaf(3)));
+        assert_eq!(a.root(), b.root());
+
+        let stale = a.root();
+        let proof = a.proof(&leaf(2)).unwrap();
+        a.push(leaf(7));
+        assert_ne!(a.root(), stale);
+        assert!(!verify_mountain_range_proof(&proof, &a.root(), &leaf(2)));
+        assert!(a.proof(&leaf(99)).is_none());
+    }
+
+    #[test]
+    fn interior_nodes_and_leaf_counts_do_not_verify() {
+        let mut range = MerkleMountainRange::new();
+        range.push(leaf(0));
+        range.push(leaf(1));
+        let root = range.root();
+
+        // The single peak over two leaves, presented as a one-leaf range.
+        let peak = range.levels[1][0];
+        let forged = MerkleMountainRangeProof {
+            leaf_index: 0,
+            leaf_count: 1,
+            sibling_path: Vec::new(),
+            peaks: Vec::new(),
+        };
+        assert!(!verify_mountain_range_proof(&forged, &root, &peak));
+
+        // A genuine proof rebound to a different leaf count.
+        let mut proof = range.proof(&leaf(0)).unwrap();
+        assert!(verify_mountain_range_proof(&proof, &root, &leaf(0)));
+        proof.leaf_count = 3;
+        proof.peaks.push(leaf(2));
+        assert!(!verify_mountain_range_proof(&proof, &root, &leaf(0)));
+    }
 }
@@ -11,10 +11,12 @@
 //!
 //! # Scale Expectations
 //!
-//! Designed for 10k-100k facts per index. If scaling beyond this, consider:
-//! - Migrating to `tokio::sync::RwLock` for async-safe access
+//! Designed for 100k+ facts per index. The B-tree index is sharded by
+//! predicate and the Bloom filter and Merkle range have their own locks, so
+//! ingestion and queries on different predicates do not serialize. If a
+//! single hot predicate becomes the bottleneck, consider:
 //! - Using a dedicated indexing thread with channels
-//! - Switching to lock-free concurrent data structures (DashMap)
+//! - Publishing immutable per-shard snapshots so reads never take a lock
 
 #![allow(clippy::disallowed_types)]
 // Note: Module-level allow covers handler.rs, wrapper.rs, and test code
@@ -27,7 +29,7 @@
 //!
 //! This module provides production-grade indexed journal lookups with:
 //! - B-tree indexes for O(log n) predicate/authority/time queries
-//! - Bloom filters for O(1) membership testing with <1% false positive rate
+//! - Scalable Bloom filters for membership testing with <1% false positive rate
 //! - Merkle trees for cryptographic integrity verification
 //!
 //! # Module Structure
@@ -35,7 +37,7 @@
 //! - [`stream`]: Tokio-specific fact stream receiver
 //! - [`time_key`]: Timestamp ordering utilities for B-tree indexing
 //! - [`authority_index`]: B-tree index for efficient fact lookups
-//! - [`merkle`]: Merkle tree construction for cryptographic integrity
+//! - [`merkle`]: Append-only Merkle mountain range with inclusion proofs
 //! - [`handler`]: Production indexed journal handler
 //! - [`wrapper`]: Combines JournalEffects with IndexedJournalEffects
 //!
@@ -82,24 +84,30 @@ mod tests {
     async fn test_add_and_query_by_predicate() {
         let handler = IndexedJournalHandler::new();
 
-        handler.add_fact(
-            "user.name".to_string(),
-            FactValue::String("alice".to_string()),
-            None,
-            None,
-        );
-        handler.add_fact(
-            "user.name".to_string(),
-            FactValue::String("bob".to_string()),
-            None,
-            None,
-        );
-        handler.add_fact(
-            "user.email".to_string(),
-            FactValue::String("alice@example.com".to_string()),
-            None,
-            None,
-        );
+        handler
+            .add_fact(
+                "user.name".to_string(),
+                FactValue::String("alice".to_string()),
+                None,
+                None,
+            )
+            .unwrap();
+        handler
+            .add_fact(
+                "user.name".to_string(),
+                FactValue::String("bob".to_string()),
+                None,
+                None,
+            )
+            .unwrap();
+        handler
+            .add_fact(
+                "user.email".to_string(),
+                FactValue::String("alice@example.com".to_string()),
+                None,
+                None,
+            )
+            .unwrap();
 
         let facts = handler.facts_by_predicate("user.name").await.unwrap();
         assert_eq!(facts.len(), 2);
@@ -116,24 +124,30 @@ mod tests {
         let auth1 = AuthorityId::new_from_entropy([1u8; 32]);
         let auth2 = AuthorityId::new_from_entropy([2u8; 32]);
 
-        handler.add_fact(
-            "data".to_string(),
-            FactValue::Number(100),
-            Some(auth1),
-            None,
-        );
-        handler.add_fact(
-            "data".to_string(),
-            FactValue::Number(200),
-            Some(auth1),
-            None,
-        );
-        handler.add_fact(
-            "data".to_string(),
-            FactValue::Number(300),
-            Some(auth2),
-            None,
-        );
+        handler
+            .add_fact(
+                "data".to_string(),
+                FactValue::Number(100),
+                Some(auth1),
+                None,
+            )
+            .unwrap();
+        handler
+            .add_fact(
+                "data".to_string(),
+                FactValue::Number(200),
+                Some(auth1),
+                None,
+            )
+            .unwrap();
+        handler
+            .add_fact(
+                "data".to_string(),
+                FactValue::Number(300),
+                Some(auth2),
+                None,
+            )
+            .unwrap();
 
         let auth1_facts = handler.facts_by_authority(&auth1).await.unwrap();
         assert_eq!(auth1_facts.len(), 2);
@@ -159,24 +173,30 @@ mod tests {
             uncertainty: None,
         });
 
-        handler.add_fact(
-            "event".to_string(),
-            FactValue::Number(1),
-            None,
-            Some(ts1.clone()),
-        );
-        handler.add_fact(
-            "event".to_string(),
-            FactValue::Number(2),
-            None,
-            Some(ts2.clone()),
-        );
-        handler.add_fact(
-            "event".to_string(),
-            FactValue::Number(3),
-            None,
-            Some(ts3.clone()),
-        );
+        handler
+            .add_fact(
+                "event".to_string(),
+                FactValue::Number(1),
+                None,
+                Some(ts1.clone()),
+            )
+            .unwrap();
+        handler
+            .add_fact(
+                "event".to_string(),
+                FactValue::Number(2),
+                None,
+                Some(ts2.clone()),
+            )
+            .unwrap();
+        handler
+            .add_fact(
+                "event".to_string(),
+                FactValue::Number(3),
+                None,
+                Some(ts3.clone()),
+            )
+            .unwrap();
 
         // Query range [1000, 2000]
         let facts = handler
@@ -194,12 +214,14 @@ mod tests {
     async fn test_bloom_filter_membership() {
         let handler = IndexedJournalHandler::new();
 
-        handler.add_fact(
-            "exists".to_string(),
-            FactValue::String("yes".to_string()),
-            None,
-            None,
-        );
+        handler
+            .add_fact(
+                "exists".to_string(),
+                FactValue::String("yes".to_string()),
+                None,
+                None,
+            )
+            .unwrap();
 
         // Should return true for existing fact
         assert!(handler.might_contain("exists", &FactValue::String("yes".to_string())));
@@ -208,6 +230,58 @@ mod tests {
         assert!(!handler.might_contain("nonexistent", &FactValue::String("no".to_string())));
     }
 
+    #[tokio::test]
+    async fn test_bloom_filter_grows_past_capacity() {
+        let handler = IndexedJournalHandler::with_capacity(64);
+        for i in 0..2_000 {
+            handler
+                .add_fact(format!("grow.{i}"), FactValue::Number(i), None, None)
+                .unwrap();
+        }
+
+        assert!(
+            (0..2_000).all(|i| handler.might_contain(&format!("grow.{i}"), &FactValue::Number(i)))
+        );
+        let stats = handler.index_stats().await.unwrap();
+        assert!(
+            stats.bloom_fp_rate < 0.01,
+            "fp rate {}",
+            stats.bloom_fp_rate
+        );
+
+        // The wire filter is resized to the index, so peers accept it
+        let filter = handler.get_bloom_filter().await.unwrap();
+        assert_eq!(filter.element_count, 2_000);
+        assert!(filter.validate_wire().is_ok());
+    }
+
+    #[tokio::test]
+    async fn test_bloom_snapshot_tracks_appends_after_caching() {
+        let handler = IndexedJournalHandler::new();
+        let value = |i: i64| FactValue::Number(i);
+        handler
+            .add_fact("wire.0".to_string(), value(0), None, None)
+            .unwrap();
+        let first = handler.get_bloom_filter().await.unwrap();
+        assert_eq!(first.element_count, 1);
+
+        // Appends past the cached filter's sizing force a resize; every
+        // fact stays visible and the filter stays within wire limits.
+        for i in 1..500 {
+            handler
+                .add_fact(format!("wire.{i}"), value(i), None, None)
+                .unwrap();
+            if i % 50 == 0 {
+                let filter = handler.get_bloom_filter().await.unwrap();
+                assert_eq!(filter.element_count, (i + 1) as u64);
+                assert!(filter.validate_wire().is_ok());
+            }
+        }
+        let filter = handler.get_bloom_filter().await.unwrap();
+        let element = |i: i64| handler.fact_to_bytes(&format!("wire.{i}"), &value(i));
+        assert!((0..500).all(|i| filter.might_contain(&element(i))));
+    }
+
     #[tokio::test]
     async fn test_merkle_root() {
         let handler = IndexedJournalHandler::new();
@@ -217,19 +291,23 @@ mod tests {
         assert_eq!(root1, [0u8; 32]);
 
         // Add a fact
-        handler.add_fact(
-            "test".to_string(),
-            FactValue::String("value".to_string()),
-            None,
-            None,
-        );
+        handler
+            .add_fact(
+                "test".to_string(),
+                FactValue::String("value".to_string()),
+                None,
+                None,
+            )
+            .unwrap();
 
         // Root should now be non-zero
         let root2 = handler.merkle_root().await.unwrap();
         assert_ne!(root2, [0u8; 32]);
 
         // Adding more facts should change the root
-        handler.add_fact("test2".to_string(), FactValue::Number(42), None, None);
+        handler
+            .add_fact("test2".to_string(), FactValue::Number(42), None, None)
+            .unwrap();
 
         let root3 = handler.merkle_root().await.unwrap();
         assert_ne!(root3, root2);
@@ -239,12 +317,14 @@ mod tests {
     async fn test_fact_inclusion_verification() {
         let handler = IndexedJournalHandler::new();
 
-        let _id = handler.add_fact(
-            "verified".to_string(),
-            FactValue::String("data".to_string()),
-            None,
-            None,
-        );
+        let _id = handler
+            .add_fact(
+                "verified".to_string(),
+                FactValue::String("data".to_string()),
+                None,
+                None,
+            )
+            .unwrap();
 
         // Get the fact
         let facts = handler.facts_by_predicate("verified").await.unwrap();
@@ -267,15 +347,52 @@ mod tests {
         assert!(!not_included);
     }
 
+    #[tokio::test]
+    async fn test_fact_inclusion_proof_verifies_without_fact_set() {
+        let handler = IndexedJournalHandler::new();
+        for i in 0..11 {
+            handler
+                .add_fact(format!("proof.{i}"), FactValue::Number(i), None, None)
+                .unwrap();
+        }
+
+        let root = handler.merkle_root().await.unwrap();
+        let facts = handler.facts_by_predicate("proof.6").await.unwrap();
+        let proof = handler
+            .fact_inclusion_proof(&facts[0])
+            .await
+            .unwrap()
+            .expect("indexed fact has a proof");
+        assert_eq!(proof.leaf_count, 11);
+
+        // A peer only needs the root, the proof, and the fact itself
+        let leaf = aura_core::hash::hash(&handler.fact_to_bytes("proof.6", &FactValue::Number(6)));
+        assert!(aura_core::crypto::merkle::verify_mountain_range_proof(
+            &proof, &root, &leaf
+        ));
+
+        // Re-adding a fact leaves the committed state unchanged
+        handler
+            .add_fact("proof.6".to_string(), FactValue::Number(6), None, None)
+            .unwrap();
+        assert_eq!(handler.merkle_root().await.unwrap(), root);
+    }
+
     #[tokio::test]
     async fn test_index_stats() {
         let handler = IndexedJournalHandler::new();
 
         let auth = AuthorityId::new_from_entropy([3u8; 32]);
 
-        handler.add_fact("pred1".to_string(), FactValue::Number(1), Some(auth), None);
-        handler.add_fact("pred2".to_string(), FactValue::Number(2), Some(auth), None);
-        handler.add_fact("pred1".to_string(), FactValue::Number(3), None, None);
+        handler
+            .add_fact("pred1".to_string(), FactValue::Number(1), Some(auth), None)
+            .unwrap();
+        handler
+            .add_fact("pred2".to_string(), FactValue::Number(2), Some(auth), None)
+            .unwrap();
+        handler
+            .add_fact("pred1".to_string(), FactValue::Number(3), None, None)
+            .unwrap();
 
         let stats = handler.index_stats().await.unwrap();
         assert_eq!(stats.fact_count, 3);
@@ -290,12 +407,14 @@ mod tests {
 
         // Add 10k facts
         for i in 0..10000 {
-            handler.add_fact(
-                format!("key.{}", i % 100), // 100 unique predicates
-                FactValue::Number(i as i64),
-                None,
-                None,
-            );
+            handler
+                .add_fact(
+                    format!("key.{}", i % 100), // 100 unique predicates
+                    FactValue::Number(i as i64),
+                    None,
+                    None,
+                )
+                .unwrap();
         }
 
         let start = aura_effects::time::monotonic_now();
@@ -312,6 +431,42 @@ mod tests {
         );
     }
 
+    #[tokio::test]
+    async fn test_concurrent_ingestion_across_shards() {
+        let handler = IndexedJournalHandler::with_capacity(1000);
+        let auth = AuthorityId::new_from_entropy([9u8; 32]);
+
+        std::thread::scope(|scope| {
+            for thread in 0..8i64 {
+                let handler = &handler;
+                scope.spawn(move || {
+                    for i in 0..500 {
+                        handler
+                            .add_fact(
+                                format!("shard.{}", i % 37),
+                                FactValue::Number(thread * 1000 + i),
+                                Some(auth),
+                                None,
+                            )
+                            .unwrap();
+                    }
+                });
+            }
+        });
+
+        let all = handler.all_facts().await.unwrap();
+        assert_eq!(all.len(), 4000);
+        assert!(all.windows(2).all(|pair| pair[0].id < pair[1].id));
+        assert_eq!(handler.facts_by_authority(&auth).await.unwrap().len(), 4000);
+
+        let stats = handler.index_stats().await.unwrap();
+        assert_eq!(stats.predicate_count, 37);
+        assert_eq!(stats.authority_count, 1);
+        for fact in all.iter().step_by(97) {
+            assert!(handler.verify_fact_inclusion(fact).await.unwrap());
+        }
+    }
+
     // === IndexedJournalWrapper Integration Tests ===
 
     /// Test-only JournalEffects for testing the wrapper
@@ -3,6 +3,7 @@
 use super::handler::IndexedJournalHandler;
 use async_trait::async_trait;
 use aura_core::{
+    crypto::merkle::MerkleMountainRangeProof,
     domain::journal::FactValue,
     effects::indexed::{FactStreamReceiver, IndexedFact},
     effects::{BloomFilter, IndexStats, IndexedJournalEffects, JournalEffects},
@@ -60,7 +61,7 @@ impl<J: JournalEffects> IndexedJournalWrapper<J> {
     }
 
     /// Index facts from a journal, skipping already-indexed keys.
-    fn index_journal(&self, journal: &aura_core::Journal) {
+    fn index_journal(&self, journal: &aura_core::Journal) -> Result<(), AuraError> {
         let mut indexed_keys = self.indexed_keys.write();
 
         for (key, value) in journal.facts.iter() {
@@ -77,10 +78,11 @@ impl<J: JournalEffects> IndexedJournalWrapper<J> {
                 value.clone(),
                 None, // Authority not available from basic Fact iteration
                 None, // Timestamp not available from basic Fact iteration
-            );
+            )?;
 
             indexed_keys.insert(key_owned);
         }
+        Ok(())
     }
 
     /// Get a reference to the inner JournalEffects handler.
@@ -111,7 +113,7 @@ impl<J: JournalEffects> JournalEffects for IndexedJournalWrapper<J> {
         delta: aura_core::Journal,
     ) -> Result<aura_core::Journal, AuraError> {
         // Index the delta facts before consuming it
-        self.index_journal(&delta);
+        self.index_journal(&delta)?;
         let result = self.inner.merge_facts(target, delta).await?;
         Ok(result)
     }
@@ -127,13 +129,13 @@ impl<J: JournalEffects> JournalEffects for IndexedJournalWrapper<J> {
     async fn get_journal(&self) -> Result<aura_core::Journal, AuraError> {
         let journal = self.inner.get_journal().await?;
         // Ensure the retrieved journal is indexed
-        self.index_journal(&journal);
+        self.index_journal(&journal)?;
         Ok(journal)
     }
 
     async fn persist_journal(&self, journal: &aura_core::Journal) -> Result<(), AuraError> {
         // Index the journal before persisting
-        self.index_journal(journal);
+        self.index_journal(journal)?;
         self.inner.persist_journal(journal).await
     }
 
@@ -205,6 +207,13 @@ impl<J: JournalEffects> IndexedJournalEffects for IndexedJournalWrapper<J> {
         self.index.verify_fact_inclusion(fact).await
     }
 
+    async fn fact_inclusion_proof(
+        &self,
+        fact: &IndexedFact,
+    ) -> Result<Option<MerkleMountainRangeProof>, AuraError> {
+        self.index.fact_inclusion_proof(fact).await
+    }
+
     async fn get_bloom_filter(&self) -> Result<BloomFilter, AuraError> {
         self.index.get_bloom_filter().await
     }
@@ -6,6 +6,8 @@
 //! All chat operations go through `ChatFactService` which provides guard chain
 //! integration (capability checks, flow budget charging, fact emission).
 
+mod history;
+
 use crate::core::{AgentError, AgentResult};
 use crate::handlers::shared::context_commitment_from_journal;
 use crate::runtime::consensus::build_consensus_params;
@@ -27,7 +29,7 @@ use aura_core::effects::amp::{
 use aura_core::effects::{PhysicalTimeEffects, RandomExtendedEffects};
 use aura_core::hash::hash;
 use aura_core::threshold::{policy_for, AgreementMode, CeremonyFlow};
-use aura_core::time::{OrderingPolicy, PhysicalTime, TimeOrdering, TimeStamp};
+use aura_core::time::{OrderingPolicy, PhysicalTime, TimeStamp};
 use aura_core::types::identifiers::{AuthorityId, ChannelId, ContextId};
 use aura_core::util::serialization::to_vec;
 use aura_core::{CapabilityName, Hash32, Prestate};
@@ -35,8 +37,8 @@ use aura_guards::GuardContextProvider;
 use aura_journal::fact::{ChannelBumpReason, ProposedChannelEpochBump};
 use aura_journal::DomainFact;
 use aura_protocol::amp::{
-    commit_bump_with_consensus, emit_proposed_bump, get_channel_state, prepare_send,
-    AmpChannelCoordinator, AmpJournalEffects,
+    commit_bump_with_consensus, emit_proposed_bump, prepare_send, AmpChannelCoordinator,
+    AmpJournalEffects, ChannelStateCache,
 };
 use aura_protocol::amp::{AmpMessage, AmpReceipt};
 use aura_protocol::effects::TreeEffects;
@@ -74,6 +76,8 @@ fn map_amp_finalize_error(error: impl Display) -> AgentError {
 pub struct ChatServiceApi {
     effects: std::sync::Arc<AuraEffectSystem>,
     facts: ChatFactService,
+    channel_states: std::sync::Arc<ChannelStateCache>,
+    history: std::sync::Arc<history::ChatHistoryCache>,
 }
 
 impl std::fmt::Debug for ChatServiceApi {
@@ -146,10 +150,13 @@ impl ChatServiceApi {
         Ok(Self {
             effects,
             facts: ChatFactService::new(),
+            channel_states: std::sync::Arc::new(ChannelStateCache::new()),
+            history: std::sync::Arc::default(),
         })
     }
 
-    fn channel_id_for_group(group_id: &ChatGroupId) -> ChannelId {
+    /// AMP channel carrying a group's messages.
+    pub fn channel_id_for_group(group_id: &ChatGroupId) -> ChannelId {
         // Deterministic mapping: embed the group UUID twice into a 32-byte ChannelId.
         // This makes the mapping stable across runs without consuming entropy.
         let mut bytes = [0u8; 32];
@@ -158,7 +165,8 @@ impl ChatServiceApi {
         ChannelId::from_bytes(bytes)
     }
 
-    fn context_id_for_group(group_id: &ChatGroupId) -> ContextId {
+    /// Relational context holding a group's facts.
+    pub fn context_id_for_group(group_id: &ChatGroupId) -> ContextId {
         ContextId::from_uuid(group_id.0)
     }
 
@@ -269,7 +277,9 @@ impl ChatServiceApi {
         channel_id: ChannelId,
         reason: ChannelBumpReason,
     ) -> AgentResult<()> {
-        let state = get_channel_state(self.effects.as_ref(), context_id, channel_id)
+        let state = self
+            .channel_states
+            .get_channel_state(self.effects.as_ref(), context_id, channel_id)
             .await
             .map_err(map_amp_state_error)?;
         let bump_nonce = self.effects.random_uuid().await.as_bytes().to_vec();
@@ -557,6 +567,73 @@ impl ChatServiceApi {
         ordered
     }
 
+    /// Fold one message fact into the per-message reduction.
+    ///
+    /// Facts must be applied in `ordered_chat_facts` order.
+    fn apply_message_fact(
+        group_id: &ChatGroupId,
+        messages: &mut std::collections::BTreeMap<String, ChatMessage>,
+        fact: aura_chat::ChatFact,
+    ) {
+        match fact {
+            aura_chat::ChatFact::MessageSentSealed {
+                message_id,
+                sender_id,
+                payload,
+                sent_at,
+                reply_to,
+                ..
+            } => {
+                let mut message = ChatMessage::new_text(
+                    Self::parse_message_id(&message_id),
+                    group_id.clone(),
+                    sender_id,
+                    Self::decode_payload(payload),
+                    Self::physical_timestamp(sent_at),
+                );
+                if let Some(reply_to) = reply_to {
+                    if let Ok(reply_uuid) = Uuid::parse_str(&reply_to) {
+                        message = message.set_reply_to(ChatMessageId(reply_uuid));
+                    }
+                }
+                messages.insert(message_id, message);
+            }
+            aura_chat::ChatFact::MessageEdited {
+                message_id,
+                editor_id,
+                new_payload,
+                edited_at,
+                ..
+            } => {
+                let edited_content = Self::decode_payload(new_payload);
+                let timestamp = Self::physical_timestamp(edited_at);
+                if let Some(existing) = messages.get_mut(&message_id) {
+                    existing.content = edited_content;
+                    existing.timestamp = timestamp;
+                    existing.message_type = aura_chat::types::MessageType::Edit;
+                } else {
+                    messages.insert(
+                        message_id.clone(),
+                        ChatMessage {
+                            id: Self::parse_message_id(&message_id),
+                            group_id: group_id.clone(),
+                            sender_id: editor_id,
+                            content: edited_content,
+                            message_type: aura_chat::types::MessageType::Edit,
+                            timestamp,
+                            reply_to: None,
+                            metadata: std::collections::HashMap::default(),
+                        },
+                    );
+                }
+            }
+            aura_chat::ChatFact::MessageDeleted { message_id, .. } => {
+                messages.remove(&message_id);
+            }
+            _ => {}
+        }
+    }
+
     fn reduce_group_messages(
         group_id: &ChatGroupId,
         facts: Vec<aura_chat::ChatFact>,
@@ -564,63 +641,7 @@ impl ChatServiceApi {
         let mut messages = std::collections::BTreeMap::<String, ChatMessage>::new();
 
         for (_, fact) in Self::ordered_chat_facts(facts) {
-            match fact {
-                aura_chat::ChatFact::MessageSentSealed {
-                    message_id,
-                    sender_id,
-                    payload,
-                    sent_at,
-                    reply_to,
-                    ..
-                } => {
-                    let mut message = ChatMessage::new_text(
-                        Self::parse_message_id(&message_id),
-                        group_id.clone(),
-                        sender_id,
-                        Self::decode_payload(payload),
-                        Self::physical_timestamp(sent_at),
-                    );
-                    if let Some(reply_to) = reply_to {
-                        if let Ok(reply_uuid) = Uuid::parse_str(&reply_to) {
-                            message = message.set_reply_to(ChatMessageId(reply_uuid));
-                        }
-                    }
-                    messages.insert(message_id, message);
-                }
-                aura_chat::ChatFact::MessageEdited {
-                    message_id,
-                    editor_id,
-                    new_payload,
-                    edited_at,
-                    ..
-                } => {
-                    let edited_content = Self::decode_payload(new_payload);
-                    let timestamp = Self::physical_timestamp(edited_at);
-                    if let Some(existing) = messages.get_mut(&message_id) {
-                        existing.content = edited_content;
-                        existing.timestamp = timestamp;
-                        existing.message_type = aura_chat::types::MessageType::Edit;
-                    } else {
-                        messages.insert(
-                            message_id.clone(),
-                            ChatMessage {
-                                id: Self::parse_message_id(&message_id),
-                                group_id: group_id.clone(),
-                                sender_id: editor_id,
-                                content: edited_content,
-                                message_type: aura_chat::types::MessageType::Edit,
-                                timestamp,
-                                reply_to: None,
-                                metadata: std::collections::HashMap::default(),
-                            },
-                        );
-                    }
-                }
-                aura_chat::ChatFact::MessageDeleted { message_id, .. } => {
-                    messages.remove(&message_id);
-                }
-                _ => {}
-            }
+            Self::apply_message_fact(group_id, &mut messages, fact);
         }
 
         let mut messages: Vec<_> = messages.into_values().collect();
@@ -840,7 +861,9 @@ impl ChatServiceApi {
         let message_id = message_uuid.to_string();
 
         // Get AMP channel state for epoch tracking (for consensus finalization)
-        let channel_state = get_channel_state(self.effects.as_ref(), context_id, channel_id)
+        let channel_state = self
+            .channel_states
+            .get_channel_state(self.effects.as_ref(), context_id, channel_id)
             .await
             .map_err(map_amp_state_error)?;
         let epoch_hint = Some(channel_state.chan_epoch as u32);
@@ -875,33 +898,49 @@ impl ChatServiceApi {
         ))
     }
 
+    /// Ingest a sealed message delivered by transport.
+    ///
+    /// Commits a `ChatFact::MessageSentSealed` carrying the AMP wire bytes and
+    /// waits for the view update; the chat view decrypts the payload while
+    /// reducing the fact.
+    pub async fn ingest_sealed_message(
+        &self,
+        group_id: &ChatGroupId,
+        sender_id: AuthorityId,
+        message_id: String,
+        payload: Vec<u8>,
+        sent_at_ms: u64,
+    ) -> AgentResult<()> {
+        let context_id = Self::context_id_for_group(group_id);
+        let fact = aura_chat::ChatFact::message_sent_sealed_ms(
+            context_id,
+            Self::channel_id_for_group(group_id),
+            message_id,
+            sender_id,
+            sender_id.to_string(),
+            payload,
+            sent_at_ms,
+            None,
+            None,
+        );
+        self.commit_chat_fact_and_wait(context_id, &fact).await
+    }
+
     /// Get message history for a group.
+    ///
+    /// Returns up to `limit` of the newest messages strictly before `before`,
+    /// oldest first. Served from the incremental history index, so a page
+    /// costs O(`limit`) once the facts committed since the last call are
+    /// absorbed.
     pub async fn get_history(
         &self,
         group_id: &ChatGroupId,
         limit: Option<usize>,
         before: Option<TimeStamp>,
     ) -> AgentResult<Vec<ChatMessage>> {
-        let facts = self.load_group_facts(group_id).await?;
-        let mut messages = Self::reduce_group_messages(group_id, facts);
-
-        if let Some(before_ts) = &before {
-            messages.retain(|message| {
-                matches!(
-                    message.timestamp.compare(before_ts, OrderingPolicy::Native),
-                    TimeOrdering::Before
-                )
-            });
-        }
-
-        if let Some(limit) = limit {
-            if messages.len() > limit {
-                messages = messages.into_iter().rev().take(limit).collect();
-                messages.reverse();
-            }
-        }
-
-        Ok(messages)
+        self.history
+            .history(self.effects.as_ref(), group_id, limit, before.as_ref())
+            .await
     }
 
     /// Get a chat group by ID.
@@ -1180,14 +1219,20 @@ impl ChatServiceApi {
         Ok(())
     }
 
+    /// Search a group's live messages, best BM25 match first.
+    ///
+    /// Queries are tokenized like message content; `sender` restricts results
+    /// to one author.
     pub async fn search_messages(
         &self,
-        _group_id: &ChatGroupId,
-        _query: &str,
-        _limit: usize,
-        _sender: Option<&AuthorityId>,
+        group_id: &ChatGroupId,
+        query: &str,
+        limit: usize,
+        sender: Option<&AuthorityId>,
     ) -> AgentResult<Vec<ChatMessage>> {
-        Err(AgentError::effects("Message search is not yet fact-backed"))
+        self.history
+            .search(self.effects.as_ref(), group_id, query, limit, sender)
+            .await
     }
 
     /// Update group details (Category A operation - fact-backed)
@@ -1536,6 +1581,89 @@ mod tests {
         assert_eq!(service.get_message(&message_two).await.unwrap(), None);
     }
 
+    #[tokio::test]
+    async fn get_history_pages_by_timestamp_and_search_ranks_messages() {
+        let config = AgentConfig::default();
+        let effects = crate::testing::simulation_effect_system_arc(&config);
+        let service = ChatServiceApi::new(effects.clone()).unwrap();
+        let group_id = group_id(5);
+        let context_id = ChatServiceApi::context_id_for_group(&group_id);
+        let channel_id = ChatServiceApi::channel_id_for_group(&group_id);
+        let alice = authority(1);
+        let bob = authority(2);
+        let texts = [
+            "rollout plan for the storage service",
+            "lunch order",
+            "storage storage migration notes",
+            "weekend plans",
+            "unrelated chatter",
+        ];
+        let message_ids: Vec<ChatMessageId> = (0..texts.len())
+            .map(|index| ChatMessageId::from_uuid(Uuid::from_bytes([40 + index as u8; 16])))
+            .collect();
+
+        for (index, text) in texts.iter().enumerate() {
+            let sender = if index % 2 == 0 { alice } else { bob };
+            commit_chat_fact(
+                &effects,
+                context_id,
+                aura_chat::ChatFact::message_sent_sealed_ms(
+                    context_id,
+                    channel_id,
+                    message_ids[index].to_string(),
+                    sender,
+                    sender.to_string(),
+                    text.as_bytes().to_vec(),
+                    100 * (index as u64 + 1),
+                    None,
+                    None,
+                ),
+            )
+            .await;
+        }
+
+        let before = TimeStamp::PhysicalClock(PhysicalTime {
+            ts_ms: 400,
+            uncertainty: None,
+        });
+        let page = service
+            .get_history(&group_id, Some(2), Some(before))
+            .await
+            .unwrap();
+        let page_ids: Vec<_> = page.iter().map(|message| message.id.clone()).collect();
+        assert_eq!(page_ids, [message_ids[1].clone(), message_ids[2].clone()]);
+
+        let hits = service
+            .search_messages(&group_id, "Storage", 10, None)
+            .await
+            .unwrap();
+        let hit_ids: Vec<_> = hits.iter().map(|message| message.id.clone()).collect();
+        assert_eq!(hit_ids, [message_ids[2].clone(), message_ids[0].clone()]);
+
+        // Facts committed after the first read are absorbed incrementally
+        commit_chat_fact(
+            &effects,
+            context_id,
+            aura_chat::ChatFact::message_edited_ms(
+                context_id,
+                channel_id,
+                message_ids[2].to_string(),
+                alice,
+                b"migration finished".to_vec(),
+                600,
+            ),
+        )
+        .await;
+        let hits = service
+            .search_messages(&group_id, "storage", 10, Some(&alice))
+            .await
+            .unwrap();
+        assert_eq!(hits.len(), 1);
+        assert_eq!(hits[0].id, message_ids[0]);
+        let latest = service.get_history(&group_id, Some(1), None).await.unwrap();
+        assert_eq!(latest[0].content, "migration finished");
+    }
+
     #[tokio::test]
     async fn edit_message_returns_refetched_fact_backed_message() {
         let config = AgentConfig::default();
@@ -0,0 +1,447 @@
+//! Incremental per-group chat history index
+//!
+//! Reducing every committed chat fact on each `get_history` call made a
+//! scroll through a long channel O(total messages). [`ChatHistoryCache`]
+//! instead absorbs only the facts committed since its last refresh, read
+//! from the runtime's commit feed through a [`CommittedFactCursor`]; the
+//! full store is listed only on first use or after the feed is invalidated.
+//! For each group it keeps:
+//! - the live messages keyed by `(timestamp, message id)`, so a keyset page
+//!   (`before`, `limit`) is a range scan of `limit` entries;
+//! - the facts of each message in reduction order, so an edit or delete
+//!   re-reduces only that message;
+//! - an [`InvertedIndex`] over message content for ranked search.
+
+use super::ChatServiceApi;
+use crate::core::{AgentError, AgentResult};
+use crate::runtime::effects::CommittedFactCursor;
+use crate::runtime::AuraEffectSystem;
+use aura_chat::{ChatFact, ChatGroupId, ChatMessage, CHAT_FACT_TYPE_ID};
+use aura_core::time::{OrderTime, OrderingPolicy, TimeOrdering, TimeStamp};
+use aura_core::types::identifiers::AuthorityId;
+use aura_journal::fact::{Fact, FactContent, RelationalFact};
+use aura_store::search::{tokenize, InvertedIndex};
+use std::collections::{BTreeMap, HashMap};
+use tokio::sync::Mutex;
+use uuid::Uuid;
+
+/// Reduction order of a message fact: physical timestamp, then commit order
+type FactPosition = (u64, OrderTime);
+
+/// Position of a message in the timeline: timestamp in ms, then message id
+type TimelineKey = (u64, String);
+
+fn timeline_ms(timestamp: &TimeStamp) -> u64 {
+    match timestamp {
+        TimeStamp::PhysicalClock(physical) => physical.ts_ms,
+        other => other.to_index_ms().value(),
+    }
+}
+
+/// Shared chat history index, refreshed from the committed fact store
+#[derive(Debug, Default)]
+pub(super) struct ChatHistoryCache {
+    state: Mutex<ChatHistoryState>,
+}
+
+#[derive(Debug, Default)]
+struct ChatHistoryState {
+    /// Committed facts already absorbed
+    cursor: CommittedFactCursor,
+    groups: HashMap<ChatGroupId, GroupHistory>,
+}
+
+#[derive(Debug, Default)]
+struct GroupHistory {
+    /// Message facts per message id, in reduction order
+    message_facts: HashMap<String, BTreeMap<FactPosition, ChatFact>>,
+    /// Live messages in timestamp order
+    timeline: BTreeMap<TimelineKey, ChatMessage>,
+    /// Timeline timestamp of each live message
+    timeline_positions: HashMap<String, u64>,
+    /// Term index over live message content
+    terms: InvertedIndex<String>,
+}
+
+impl ChatHistoryCache {
+    /// Up to `limit` of the newest messages before `before`, oldest first.
+    pub(super) async fn history(
+        &self,
+        effects: &AuraEffectSystem,
+        group_id: &ChatGroupId,
+        limit: Option<usize>,
+        before: Option<&TimeStamp>,
+    ) -> AgentResult<Vec<ChatMessage>> {
+        let mut state = self.state.lock().await;
+        state.refresh(effects).await?;
+        Ok(state
+            .groups
+            .get(group_id)
+            .map(|group| group.page(limit, before))
+            .unwrap_or_default())
+    }
+
+    /// Up to `limit` messages ranked by relevance to `query`.
+    pub(super) async fn search(
+        &self,
+        effects: &AuraEffectSystem,
+        group_id: &ChatGroupId,
+        query: &str,
+        limit: usize,
+        sender: Option<&AuthorityId>,
+    ) -> AgentResult<Vec<ChatMessage>> {
+        let mut state = self.state.lock().await;
+        state.refresh(effects).await?;
+        Ok(state
+            .groups
+            .get(group_id)
+            .map(|group| group.search(query, limit, sender))
+            .unwrap_or_default())
+    }
+}
+
+impl ChatHistoryState {
+    async fn refresh(&mut self, effects: &AuraEffectSystem) -> AgentResult<()> {
+        let authority_id = effects.authority_id();
+        let facts = match effects
+            .load_unseen_committed_facts(authority_id, &mut self.cursor)
+            .await
+            .map_err(AgentError::from)?
+        {
+            Some(facts) => facts,
+            None => {
+                // Absorbed facts left the store; rebuild from what remains
+                *self = Self::default();
+                effects
+                    .load_unseen_committed_facts(authority_id, &mut self.cursor)
+                    .await
+                    .map_err(AgentError::from)?
+                    .unwrap_or_default()
+            }
+        };
+
+        for fact in facts {
+            self.absorb(fact)?;
+        }
+        Ok(())
+    }
+
+    fn absorb(&mut self, fact: Fact) -> AgentResult<()> {
+        let FactContent::Relational(RelationalFact::Generic {
+            context_id,
+            envelope,
+        }) = fact.content
+        else {
+            return Ok(());
+        };
+        if envelope.type_id.as_str() != CHAT_FACT_TYPE_ID {
+            return Ok(());
+        }
+        let Some(chat_fact) = ChatFact::from_envelope(&envelope) else {
+            return Ok(());
+        };
+
+        let (channel_id, message_id) = match &chat_fact {
+            ChatFact::MessageSentSealed {
+                channel_id,
+                message_id,
+                ..
+            }
+            | ChatFact::MessageEdited {
+                channel_id,
+                message_id,
+                ..
+            }
+            | ChatFact::MessageDeleted {
+                channel_id,
+                message_id,
+                ..
+            } => (*channel_id, message_id.clone()),
+            _ => return Ok(()),
+        };
+
+        // Same group mapping and single-channel restriction as load_group_facts
+        let group_id = ChatGroupId::from_uuid(Uuid::from_bytes(context_id.to_bytes()));
+        if ChatServiceApi::context_id_for_group(&group_id) != context_id
+            || ChatServiceApi::channel_id_for_group(&group_id) != channel_id
+        {
+            return Ok(());
+        }
+
+        let position = (chat_fact.timestamp_ms(), fact.order);
+        let group = self.groups.entry(group_id.clone()).or_default();
+        group
+            .message_facts
+            .entry(message_id.clone())
+            .or_default()
+            .insert(position, chat_fact);
+        group.refresh_message(&group_id, &message_id)
+    }
+}
+
+impl GroupHistory {
+    /// Re-reduce one message from its facts and update the timeline and terms
+    fn refresh_message(&mut self, group_id: &ChatGroupId, message_id: &str) -> AgentResult<()> {
+        let mut reduced = BTreeMap::new();
+        for fact in self
+            .message_facts
+            .get(message_id)
+            .into_iter()
+            .flat_map(BTreeMap::values)
+        {
+            ChatServiceApi::apply_message_fact(group_id, &mut reduced, fact.clone());
+        }
+
+        if let Some(previous_ms) = self.timeline_positions.remove(message_id) {
+            self.timeline.remove(&(previous_ms, message_id.to_string()));
+        }
+        let Some(message) = reduced.remove(message_id) else {
+            self.terms.remove_document(&message_id.to_string());
+            return Ok(());
+        };
+
+        let terms = tokenize(&message.content);
+        self.terms
+            .add_document(message_id.to_string(), terms.iter().map(String::as_str))
+            .map_err(|e| AgentError::internal(format!("chat search index update failed: {e}")))?;
+        let ms = timeline_ms(&message.timestamp);
+        self.timeline_positions.insert(message_id.to_string(), ms);
+        self.timeline.insert((ms, message_id.to_string()), message);
+        Ok(())
+    }
+
+    fn page(&self, limit: Option<usize>, before: Option<&TimeStamp>) -> Vec<ChatMessage> {
+        let limit = limit.unwrap_or(usize::MAX);
+        let mut page: Vec<ChatMessage> = match before {
+            None => self.timeline.values().rev().take(limit).cloned().collect(),
+            Some(TimeStamp::PhysicalClock(before)) => self
+                .timeline
+                .range(..(before.ts_ms, String::new()))
+                .rev()
+                .take(limit)
+                .map(|(_, message)| message.clone())
+                .collect(),
+            // Other clock domains have no timeline key order; compare directly
+            Some(before) => self
+                .timeline
+                .values()
+                .rev()
+                .filter(|message| {
+                    matches!(
+                        message.timestamp.compare(before, OrderingPolicy::Native),
+                        TimeOrdering::Before
+                    )
+                })
+                .take(limit)
+                .cloned()
+                .collect(),
+        };
+        page.reverse();
+        page
+    }
+
+    fn search(&self, query: &str, limit: usize, sender: Option<&AuthorityId>) -> Vec<ChatMessage> {
+        let terms = tokenize(query);
+        let ranked = self
+            .terms
+            .top_k(terms.iter().map(String::as_str), limit, |message_id| {
+                sender.is_none_or(|sender| {
+                    self.message(message_id)
+                        .is_some_and(|message| message.sender_id == *sender)
+                })
+            });
+        ranked
+            .hits
+            .iter()
+            .filter_map(|hit| self.message(hit.key).cloned())
+            .collect()
+    }
+
+    fn message(&self, message_id: &str) -> Option<&ChatMessage> {
+        let ms = *self.timeline_positions.get(message_id)?;
+        self.timeline.get(&(ms, message_id.to_string()))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::core::AgentConfig;
+    use aura_chat::ChatMessageId;
+    use aura_core::effects::StorageCoreEffects;
+    use aura_core::time::PhysicalTime;
+    use aura_core::types::identifiers::ContextId;
+    use std::sync::Arc;
+
+    struct Fixture {
+        effects: Arc<AuraEffectSystem>,
+        cache: ChatHistoryCache,
+        group_id: ChatGroupId,
+        sender: AuthorityId,
+    }
+
+    impl Fixture {
+        fn new(seed: u8) -> Self {
+            Self {
+                effects: crate::testing::simulation_effect_system_arc(&AgentConfig::default()),
+                cache: ChatHistoryCache::default(),
+                group_id: ChatGroupId::from_uuid(Uuid::from_bytes([seed; 16])),
+                sender: AuthorityId::new_from_entropy([seed; 32]),
+            }
+        }
+
+        fn context(&self) -> ContextId {
+            ChatServiceApi::context_id_for_group(&self.group_id)
+        }
+
+        async fn commit(&self, fact: ChatFact) {
+            self.effects
+                .commit_generic_fact_bytes(
+                    self.context(),
+                    CHAT_FACT_TYPE_ID.into(),
+                    fact.to_bytes(),
+                )
+                .await
+                .unwrap();
+        }
+
+        async fn send(&self, id: &ChatMessageId, content: &str, ts_ms: u64) {
+            self.commit(ChatFact::message_sent_sealed_ms(
+                self.context(),
+                ChatServiceApi::channel_id_for_group(&self.group_id),
+                id.to_string(),
+                self.sender,
+                self.sender.to_string(),
+                content.as_bytes().to_vec(),
+                ts_ms,
+                None,
+                None,
+            ))
+            .await;
+        }
+
+        async fn page(&self, limit: Option<usize>, before_ms: Option<u64>) -> Vec<ChatMessageId> {
+            let before = before_ms.map(|ts_ms| {
+                TimeStamp::PhysicalClock(PhysicalTime {
+                    ts_ms,
+                    uncertainty: None,
+                })
+            });
+            self.cache
+                .history(&self.effects, &self.group_id, limit, before.as_ref())
+                .await
+                .unwrap()
+                .into_iter()
+                .map(|message| message.id)
+                .collect()
+        }
+
+        async fn search(&self, query: &str) -> Vec<ChatMessageId> {
+            self.cache
+                .search(&self.effects, &self.group_id, query, 10, None)
+                .await
+                .unwrap()
+                .into_iter()
+                .map(|message| message.id)
+                .collect()
+        }
+    }
+
+    fn message_id(byte: u8) -> ChatMessageId {
+        ChatMessageId::from_uuid(Uuid::from_bytes([byte; 16]))
+    }
+
+    #[tokio::test]
+    async fn edits_and_deletes_re_reduce_absorbed_messages() {
+        let fixture = Fixture::new(21);
+        let (kept, dropped) = (message_id(1), message_id(2));
+        fixture.send(&kept, "draft agenda", 100).await;
+        fixture.send(&dropped, "typo message", 200).await;
+        assert_eq!(
+            fixture.page(None, None).await,
+            [kept.clone(), dropped.clone()]
+        );
+
+        let channel_id = ChatServiceApi::channel_id_for_group(&fixture.group_id);
+        fixture
+            .commit(ChatFact::message_edited_ms(
+                fixture.context(),
+                channel_id,
+                kept.to_string(),
+                fixture.sender,
+                b"final agenda".to_vec(),
+                300,
+            ))
+            .await;
+        fixture
+            .commit(ChatFact::message_deleted_ms(
+                fixture.context(),
+                channel_id,
+                dropped.to_string(),
+                fixture.sender,
+                400,
+            ))
+            .await;
+
+        let history = fixture
+            .cache
+            .history(&fixture.effects, &fixture.group_id, None, None)
+            .await
+            .unwrap();
+        assert_eq!(history.len(), 1);
+        assert_eq!(history[0].id, kept);
+        assert_eq!(history[0].content, "final agenda");
+        assert!(fixture.search("draft").await.is_empty());
+        assert!(fixture.search("typo").await.is_empty());
+        assert_eq!(fixture.search("final").await, [kept]);
+    }
+
+    #[tokio::test]
+    async fn rebuilds_when_absorbed_facts_leave_the_store() {
+        let fixture = Fixture::new(22);
+        let prefix = format!("journal/facts/{}/", fixture.effects.authority_id());
+        let (removed, kept) = (message_id(1), message_id(2));
+        fixture.send(&removed, "first", 100).await;
+        let removed_keys = fixture.effects.list_keys(Some(&prefix)).await.unwrap();
+        fixture.send(&kept, "second", 200).await;
+        assert_eq!(
+            fixture.page(None, None).await,
+            [removed.clone(), kept.clone()]
+        );
+
+        for key in &removed_keys {
+            assert!(fixture.effects.remove(key).await.unwrap());
+        }
+        assert_eq!(fixture.page(None, None).await, [kept.clone()]);
+        assert!(fixture.search("first").await.is_empty());
+    }
+
+    #[tokio::test]
+    async fn before_cursor_pages_walk_back_through_the_timeline() {
+        let fixture = Fixture::new(23);
+        let ids: Vec<ChatMessageId> = (1..=5).map(message_id).collect();
+        for (index, id) in ids.iter().enumerate() {
+            fixture
+                .send(id, &format!("message {index}"), 100 * (index as u64 + 1))
+                .await;
+        }
+
+        assert_eq!(fixture.page(Some(2), None).await, ids[3..5]);
+        // Each page's oldest timestamp is the next page's exclusive cursor
+        assert_eq!(fixture.page(Some(2), Some(400)).await, ids[1..3]);
+        assert_eq!(fixture.page(Some(2), Some(200)).await, ids[..1]);
+        assert!(fixture.page(Some(2), Some(100)).await.is_empty());
+
+        // A message committed after the first page is visible to later pages
+        let late = message_id(6);
+        fixture.send(&late, "late", 250).await;
+        assert_eq!(
+            fixture.page(Some(2), Some(400)).await,
+            [late.clone(), ids[2].clone()]
+        );
+        assert_eq!(
+            fixture.page(None, Some(300)).await,
+            [ids[0].clone(), ids[1].clone(), late]
+        );
+    }
+}
@@ -211,6 +211,9 @@ async fn attach_test_rendezvous_manager(
     crate::runtime::services::RuntimeService::start(&manager, &service_context)
         .await
         .unwrap();
+    effects
+        .tcp_connection_pool()
+        .attach_tasks(tasks.group("tcp_connection_pool"));
     tasks
 }
 
@@ -37,7 +37,7 @@ use std::collections::BTreeSet;
 use std::sync::Arc;
 use tokio::sync::Mutex;
 
-use super::scheduler::{ReactiveUpdateFuture, ReactiveView};
+use super::scheduler::{FactInterest, ReactiveUpdateFuture, ReactiveView};
 use crate::reactive::app_signal_projection;
 
 use crate::runtime::AuraEffectSystem;
@@ -556,6 +556,10 @@ impl ReactiveView for InvitationsSignalView {
     fn view_id(&self) -> &str {
         "signals:invitations"
     }
+
+    fn interest(&self) -> FactInterest {
+        FactInterest::GenericTypes(&[INVITATION_FACT_TYPE_ID])
+    }
 }
 
 // =============================================================================
@@ -1134,6 +1138,20 @@ impl ReactiveView for HomeSignalView {
     fn view_id(&self) -> &str {
         "signals:homes"
     }
+
+    fn interest(&self) -> FactInterest {
+        FactInterest::GenericTypes(&[
+            HOME_BAN_FACT_TYPE_ID,
+            HOME_UNBAN_FACT_TYPE_ID,
+            HOME_MUTE_FACT_TYPE_ID,
+            HOME_UNMUTE_FACT_TYPE_ID,
+            HOME_KICK_FACT_TYPE_ID,
+            HOME_PIN_FACT_TYPE_ID,
+            HOME_UNPIN_FACT_TYPE_ID,
+            HOME_GRANT_MODERATOR_FACT_TYPE_ID,
+            HOME_REVOKE_MODERATOR_FACT_TYPE_ID,
+        ])
+    }
 }
 
 // =============================================================================
@@ -51,7 +51,7 @@ pub use reductions::{
     RecoveryReduction,
 };
 pub use scheduler::{
-    topological_sort_dag, AnyView, FactCommitError, FactCommitResult, FactSource,
+    topological_sort_dag, AnyView, FactCommitError, FactCommitResult, FactInterest, FactSource,
     ReactiveScheduler, ReactiveView, SchedulerConfig, ViewAdapter, ViewNode, ViewReduction,
     ViewUpdate,
 };
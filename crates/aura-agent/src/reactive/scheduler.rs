@@ -5,7 +5,10 @@
 //! The ReactiveScheduler is a Tokio task that:
 //! - Receives facts from multiple sources (journal, network, timer)
 //! - Batches facts with a 5ms window to reduce update thrashing
-//! - Updates views in topological order for glitch-freedom
+//! - Updates views level by level through their dependency DAG: views at the
+//!   same level run concurrently, and each level finishes before the next
+//!   starts, which keeps updates glitch-free
+//! - Skips views whose [`FactInterest`] matches nothing in the batch
 //! - Emits ViewUpdate events for UI consumption
 //!
 //! ## Runtime Layer Note
@@ -22,6 +25,8 @@ use aura_core::types::identifiers::AuthorityId;
 use aura_core::util::graph::{CycleError, DagNode};
 use aura_journal::fact::{Fact, FactContent, RelationalFact};
 use aura_journal::FactRegistry;
+use futures::future::join_all;
+use std::collections::HashMap;
 use std::future::Future;
 use std::pin::Pin;
 use std::sync::Arc;
@@ -111,6 +116,8 @@ pub enum ViewUpdate {
         batch_count: u64,
         facts_processed: u64,
         avg_batch_latency_ms: f64,
+        /// p99 update latency per view ID
+        view_p99_latency_ms: Vec<(String, u64)>,
     },
 }
 
@@ -216,6 +223,52 @@ impl<T> FactCommitResult<T> {
     }
 }
 
+/// Facts a view wants to be updated for
+///
+/// The scheduler skips a view for any batch in which no fact matches its
+/// interest. A view that is updated still receives the whole batch.
+#[derive(Clone, Default)]
+pub enum FactInterest {
+    /// Every batch (default)
+    #[default]
+    All,
+    /// Generic facts whose envelope type ID is one of these
+    GenericTypes(&'static [&'static str]),
+    /// Facts accepted by a predicate
+    Predicate(Arc<dyn Fn(&Fact) -> bool + Send + Sync>),
+}
+
+impl FactInterest {
+    /// Whether a single fact is of interest
+    pub fn matches(&self, fact: &Fact) -> bool {
+        match self {
+            Self::All => true,
+            Self::GenericTypes(type_ids) => match &fact.content {
+                FactContent::Relational(RelationalFact::Generic { envelope, .. }) => {
+                    type_ids.contains(&envelope.type_id.as_str())
+                }
+                _ => false,
+            },
+            Self::Predicate(predicate) => predicate(fact),
+        }
+    }
+
+    /// Whether any fact in a batch is of interest
+    pub fn matches_any(&self, facts: &[Fact]) -> bool {
+        matches!(self, Self::All) || facts.iter().any(|fact| self.matches(fact))
+    }
+}
+
+impl std::fmt::Debug for FactInterest {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        match self {
+            Self::All => f.write_str("All"),
+            Self::GenericTypes(type_ids) => f.debug_tuple("GenericTypes").field(type_ids).finish(),
+            Self::Predicate(_) => f.write_str("Predicate(..)"),
+        }
+    }
+}
+
 /// Trait for reactive views that can be updated from journal facts
 pub trait ReactiveView: Send + Sync {
     /// Update the view based on new facts
@@ -233,6 +286,11 @@ pub trait ReactiveView: Send + Sync {
     fn dependencies(&self) -> Vec<String> {
         Vec::new()
     }
+
+    /// Facts this view reacts to; batches with none of them are skipped
+    fn interest(&self) -> FactInterest {
+        FactInterest::All
+    }
 }
 
 /// Type-erased reactive view for heterogeneous collections
@@ -248,6 +306,9 @@ pub trait AnyView: Send + Sync {
 
     /// Get dependencies
     fn dependencies(&self) -> Vec<String>;
+
+    /// Get the fact interest used to skip unrelated batches
+    fn interest(&self) -> FactInterest;
 }
 
 impl<T: ReactiveView> AnyView for T {
@@ -262,6 +323,10 @@ impl<T: ReactiveView> AnyView for T {
     fn dependencies(&self) -> Vec<String> {
         ReactiveView::dependencies(self)
     }
+
+    fn interest(&self) -> FactInterest {
+        ReactiveView::interest(self)
+    }
 }
 
 /// Configuration for the reactive scheduler
@@ -290,7 +355,8 @@ impl Default for SchedulerConfig {
 /// ## Design Principles
 ///
 /// 1. **Batching**: Facts are batched with a 5ms window to reduce update thrashing
-/// 2. **Ordering**: Views are updated in topological order to guarantee glitch-freedom
+/// 2. **Ordering**: Views are updated one dependency level at a time to guarantee
+///    glitch-freedom; views within a level update concurrently
 /// 3. **Determinism**: Given the same fact sequence, produces the same outputs
 /// 4. **Backpressure**: Handles high fact rates gracefully
 ///
@@ -315,8 +381,10 @@ impl Default for SchedulerConfig {
 pub struct ReactiveScheduler {
     /// Configuration
     config: SchedulerConfig,
-    /// Registered views (in topological order)
+    /// Registered views, not yet scheduled
     views: Vec<Arc<dyn AnyView>>,
+    /// Scheduled views grouped by dependency level
+    levels: Vec<Vec<ScheduledView>>,
     /// Fact ingestion channel (receiver side)
     fact_rx: mpsc::Receiver<FactSource>,
     /// View update broadcaster
@@ -335,6 +403,12 @@ struct ReactiveSchedulerShared {
     stats: RwLock<SchedulerStats>,
 }
 
+/// A registered view with its fact interest resolved once at startup
+struct ScheduledView {
+    view: Arc<dyn AnyView>,
+    interest: FactInterest,
+}
+
 impl ReactiveScheduler {
     /// Create a new reactive scheduler
     ///
@@ -360,6 +434,7 @@ impl ReactiveScheduler {
         let scheduler = Self {
             config,
             views: Vec::new(),
+            levels: Vec::new(),
             fact_rx,
             update_tx: update_tx.clone(),
             shutdown_rx,
@@ -401,8 +476,7 @@ impl ReactiveScheduler {
             self.config.batch_window
         );
 
-        // Sort views topologically for glitch-freedom
-        self.views = topological_sort(std::mem::take(&mut self.views));
+        self.schedule_views();
 
         // Batching state: None = no batch in progress, Some(deadline_ms) = batch deadline
         let mut batch: Vec<Fact> = Vec::new();
@@ -492,14 +566,36 @@ impl ReactiveScheduler {
                 batch_count: stats.batch_count,
                 facts_processed: stats.facts_processed,
                 avg_batch_latency_ms: avg_latency,
+                view_p99_latency_ms: stats
+                    .view_latency
+                    .iter()
+                    .map(|(view_id, histogram)| (view_id.clone(), histogram.quantile_ms(0.99)))
+                    .collect(),
             });
         }
     }
 
+    /// Group registered views into dependency levels for glitch-freedom
+    fn schedule_views(&mut self) {
+        let sorted = topological_sort(std::mem::take(&mut self.views));
+        self.levels = dependency_levels(sorted)
+            .into_iter()
+            .map(|level| {
+                level
+                    .into_iter()
+                    .map(|view| ScheduledView {
+                        interest: view.interest(),
+                        view,
+                    })
+                    .collect()
+            })
+            .collect();
+    }
+
     /// Process a batch of facts
     ///
     /// This is the core update cycle:
-    /// 1. Update all views in topological order
+    /// 1. Update interested views level by level, concurrently within a level
     /// 2. Emit update events
     /// 3. Update statistics
     async fn process_batch(&self, facts: Vec<Fact>) {
@@ -520,10 +616,15 @@ impl ReactiveScheduler {
 
         tracing::trace!("Processing batch of {} facts", fact_count);
 
-        // Update all views in topological order
-        // This guarantees glitch-freedom: downstream views only see consistent state
-        for view in &self.views {
-            view.update(&facts).await;
+        // Each level completes before the next starts, so downstream views
+        // only see consistent upstream state (glitch-freedom)
+        let mut view_latencies = Vec::new();
+        for level in &self.levels {
+            let updates = level
+                .iter()
+                .filter(|scheduled| scheduled.interest.matches_any(&facts))
+                .map(|scheduled| self.update_view(scheduled, &facts));
+            view_latencies.extend(join_all(updates).await.into_iter().flatten());
         }
 
         // Emit update event
@@ -542,10 +643,47 @@ impl ReactiveScheduler {
             stats.batch_count += 1;
             stats.facts_processed += fact_count as u64;
             stats.total_batch_latency_ms += batch_latency;
+            for (view_id, latency_ms) in view_latencies {
+                stats
+                    .view_latency
+                    .entry(view_id.to_string())
+                    .or_default()
+                    .record(latency_ms);
+            }
         }
     }
 
+    /// Update one view, returning its latency when statistics are enabled
+    async fn update_view<'a>(
+        &self,
+        scheduled: &'a ScheduledView,
+        facts: &'a [Fact],
+    ) -> Option<(&'a str, u64)> {
+        if !self.config.collect_stats {
+            scheduled.view.update(facts).await;
+            return None;
+        }
+
+        let start_ms = self.now_ms().await;
+        scheduled.view.update(facts).await;
+        let end_ms = self.now_ms().await;
+        Some((scheduled.view.view_id(), end_ms.saturating_sub(start_ms)))
+    }
+
+    async fn now_ms(&self) -> u64 {
+        self.time_effects
+            .physical_time()
+            .await
+            .map(|t| t.ts_ms)
+            .unwrap_or(0)
+    }
+
     fn inspect_generic_facts(&self, facts: &[Fact]) {
+        // The reduction exists only for this trace output
+        if !tracing::enabled!(tracing::Level::TRACE) {
+            return;
+        }
+
         for fact in facts {
             if let FactContent::Relational(RelationalFact::Generic {
                 context_id,
@@ -553,12 +691,10 @@ impl ReactiveScheduler {
             }) = &fact.content
             {
                 let binding = self.fact_registry.reduce_envelope(*context_id, envelope);
-                let binding_type_desc = format!("{:?}", binding.binding_type);
-                let context_display = context_id.to_string();
                 tracing::trace!(
                     fact_type = envelope.type_id.as_str(),
-                    binding = binding_type_desc,
-                    ctx = context_display,
+                    binding = ?binding.binding_type,
+                    ctx = %context_id,
                     "reduced generic fact"
                 );
             }
@@ -631,6 +767,8 @@ where
     apply_fn: ApplyFn<V, Delta>,
     /// Own authority for contextual reduction
     own_authority: Option<AuthorityId>,
+    /// Facts the reduction reacts to
+    interest: FactInterest,
 }
 
 impl<Delta, R, V> ViewAdapter<Delta, R, V>
@@ -664,8 +802,15 @@ where
             view,
             apply_fn: Arc::new(move |v, d| Box::pin(apply_fn(v, d))),
             own_authority,
+            interest: FactInterest::All,
         }
     }
+
+    /// Skip batches that contain no facts matching `interest`
+    pub fn with_interest(mut self, interest: FactInterest) -> Self {
+        self.interest = interest;
+        self
+    }
 }
 
 impl<Delta, R, V> ReactiveView for ViewAdapter<Delta, R, V>
@@ -689,6 +834,10 @@ where
     fn view_id(&self) -> &str {
         &self.view_id
     }
+
+    fn interest(&self) -> FactInterest {
+        self.interest.clone()
+    }
 }
 
 // =============================================================================
@@ -837,6 +986,32 @@ fn topological_sort(views: Vec<Arc<dyn AnyView>>) -> Vec<Arc<dyn AnyView>> {
     }
 }
 
+/// Group topologically sorted views by dependency depth.
+///
+/// A view's level is one more than the deepest view it depends on, so no two
+/// views in a level depend on each other. Dependencies on unregistered views
+/// are ignored, as in [`topological_sort_dag`].
+fn dependency_levels(sorted: Vec<Arc<dyn AnyView>>) -> Vec<Vec<Arc<dyn AnyView>>> {
+    let mut view_levels: HashMap<String, usize> = HashMap::with_capacity(sorted.len());
+    let mut levels: Vec<Vec<Arc<dyn AnyView>>> = Vec::new();
+
+    for view in sorted {
+        let level = view
+            .dependencies()
+            .iter()
+            .filter_map(|dep| view_levels.get(dep))
+            .map(|dep_level| dep_level + 1)
+            .max()
+            .unwrap_or(0);
+        view_levels.insert(view.view_id().to_string(), level);
+        if levels.len() <= level {
+            levels.resize_with(level + 1, Vec::new);
+        }
+        levels[level].push(view);
+    }
+    levels
+}
+
 // =============================================================================
 // Delta Types and Reduction Functions
 // =============================================================================
@@ -1437,4 +1612,132 @@ mod tests {
         ];
         topological_sort(views);
     }
+
+    /// View that logs when each update starts and finishes
+    struct LoggingView {
+        id: String,
+        deps: Vec<String>,
+        interest: FactInterest,
+        log: Arc<RwLock<Vec<String>>>,
+    }
+
+    impl LoggingView {
+        fn new(
+            id: &str,
+            deps: &[&str],
+            interest: FactInterest,
+            log: &Arc<RwLock<Vec<String>>>,
+        ) -> Arc<Self> {
+            Arc::new(Self {
+                id: id.to_string(),
+                deps: deps.iter().map(|s| s.to_string()).collect(),
+                interest,
+                log: log.clone(),
+            })
+        }
+    }
+
+    impl ReactiveView for LoggingView {
+        fn update<'a>(&'a self, _facts: &'a [Fact]) -> ReactiveUpdateFuture<'a> {
+            Box::pin(async move {
+                self.log.write().await.push(format!("{}:start", self.id));
+                tokio::task::yield_now().await;
+                self.log.write().await.push(format!("{}:end", self.id));
+            })
+        }
+
+        fn view_id(&self) -> &str {
+            &self.id
+        }
+
+        fn dependencies(&self) -> Vec<String> {
+            self.deps.clone()
+        }
+
+        fn interest(&self) -> FactInterest {
+            self.interest.clone()
+        }
+    }
+
+    fn generic_test_fact(order_index: u64, type_id: &str) -> Fact {
+        make_test_fact(
+            order_index,
+            FactContent::Relational(RelationalFact::Generic {
+                context_id: test_context_id(),
+                envelope: aura_core::types::facts::FactEnvelope {
+                    type_id: aura_core::types::facts::FactTypeId::from(type_id),
+                    schema_version: 1,
+                    encoding: aura_core::types::facts::FactEncoding::DagCbor,
+                    payload: vec![],
+                },
+            }),
+        )
+    }
+
+    #[test]
+    fn test_dependency_levels_diamond() {
+        let views: Vec<Arc<dyn AnyView>> = vec![
+            Arc::new(TestView::with_deps("d", &["b", "c"])),
+            Arc::new(TestView::with_deps("b", &["a"])),
+            Arc::new(TestView::with_deps("c", &["a", "missing"])),
+            Arc::new(TestView::new("a")),
+            Arc::new(TestView::new("e")),
+        ];
+        let levels: Vec<Vec<String>> = dependency_levels(topological_sort(views))
+            .iter()
+            .map(|level| level.iter().map(|v| v.view_id().to_string()).collect())
+            .collect();
+        assert_eq!(levels, [vec!["a", "e"], vec!["b", "c"], vec!["d"]]);
+    }
+
+    #[test]
+    fn test_fact_interest_generic_types() {
+        let interest = FactInterest::GenericTypes(&["chat"]);
+        let chat = generic_test_fact(1, "chat");
+        let other = generic_test_fact(2, "other");
+        assert!(interest.matches(&chat));
+        assert!(!interest.matches(&other));
+        assert!(interest.matches_any(&[other.clone(), chat]));
+        assert!(!interest.matches_any(std::slice::from_ref(&other)));
+        assert!(FactInterest::All.matches_any(&[]));
+    }
+
+    #[tokio::test]
+    async fn test_process_batch_runs_levels_concurrently_and_skips_uninterested_views() {
+        let config = SchedulerConfig {
+            collect_stats: true,
+            ..SchedulerConfig::default()
+        };
+        let (mut scheduler, _fact_tx, _shutdown_tx) = scheduler_with_registry(config);
+        let log = Arc::new(RwLock::new(Vec::new()));
+        scheduler.register_view(LoggingView::new("b", &["a"], FactInterest::All, &log));
+        scheduler.register_view(LoggingView::new("a", &[], FactInterest::All, &log));
+        scheduler.register_view(LoggingView::new(
+            "c",
+            &[],
+            FactInterest::GenericTypes(&["chat"]),
+            &log,
+        ));
+        scheduler.register_view(LoggingView::new(
+            "skipped",
+            &[],
+            FactInterest::GenericTypes(&["invitation"]),
+            &log,
+        ));
+        scheduler.schedule_views();
+
+        scheduler
+            .process_batch(vec![generic_test_fact(1, "chat")])
+            .await;
+
+        // a and c share level 0 and interleave; b waits for the whole level
+        assert_eq!(
+            *log.read().await,
+            ["a:start", "c:start", "a:end", "c:end", "b:start", "b:end"]
+        );
+        let stats = scheduler.shared.stats.read().await;
+        let recorded: Vec<_> = stats.view_latency.keys().cloned().collect();
+        assert_eq!(recorded, ["a", "b", "c"]);
+        assert!(stats.view_latency.values().all(|h| h.count == 1));
+    }
 }
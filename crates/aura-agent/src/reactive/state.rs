@@ -1,6 +1,7 @@
 //! Internal reactive state containers.
 
 use crate::task_registry::TaskSupervisor;
+use std::collections::BTreeMap;
 use std::sync::Arc;
 use tokio::sync::broadcast;
 
@@ -17,4 +18,67 @@ pub(crate) struct SchedulerStats {
     pub(crate) batch_count: u64,
     pub(crate) facts_processed: u64,
     pub(crate) total_batch_latency_ms: f64,
+    /// Update latency per view ID
+    pub(crate) view_latency: BTreeMap<String, LatencyHistogram>,
+}
+
+/// Upper bounds (ms) of the latency buckets; a final bucket holds the rest.
+const LATENCY_BUCKET_BOUNDS_MS: [u64; 11] = [1, 2, 5, 10, 25, 50, 100, 250, 500, 1000, 5000];
+
+/// Fixed-bucket latency histogram in milliseconds.
+#[derive(Debug, Clone, Default)]
+pub(crate) struct LatencyHistogram {
+    buckets: [u64; LATENCY_BUCKET_BOUNDS_MS.len() + 1],
+    pub(crate) count: u64,
+    pub(crate) total_ms: u64,
+    pub(crate) max_ms: u64,
+}
+
+impl LatencyHistogram {
+    pub(crate) fn record(&mut self, latency_ms: u64) {
+        let bucket = LATENCY_BUCKET_BOUNDS_MS.partition_point(|&bound| bound < latency_ms);
+        self.buckets[bucket] += 1;
+        self.count += 1;
+        self.total_ms = self.total_ms.saturating_add(latency_ms);
+        self.max_ms = self.max_ms.max(latency_ms);
+    }
+
+    /// Upper bound of the bucket holding quantile `q` (0.0..=1.0).
+    ///
+    /// Latencies beyond the last bound report the observed maximum.
+    pub(crate) fn quantile_ms(&self, q: f64) -> u64 {
+        if self.count == 0 {
+            return 0;
+        }
+        let rank = ((q.clamp(0.0, 1.0) * self.count as f64).ceil() as u64).max(1);
+        let mut seen = 0;
+        for (bucket, &count) in self.buckets.iter().enumerate() {
+            seen += count;
+            if seen >= rank {
+                return LATENCY_BUCKET_BOUNDS_MS
+                    .get(bucket)
+                    .map_or(self.max_ms, |&bound| bound.min(self.max_ms));
+            }
+        }
+        self.max_ms
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn latency_histogram_reports_bucket_quantiles() {
+        let mut histogram = LatencyHistogram::default();
+        for latency_ms in [0, 1, 3, 3, 4, 8, 40, 40, 90, 7000] {
+            histogram.record(latency_ms);
+        }
+
+        assert_eq!(histogram.count, 10);
+        assert_eq!(histogram.quantile_ms(0.5), 5);
+        assert_eq!(histogram.quantile_ms(0.9), 100);
+        assert_eq!(histogram.quantile_ms(1.0), 7000);
+        assert_eq!(LatencyHistogram::default().quantile_ms(0.99), 0);
+    }
 }
@@ -99,6 +99,7 @@ mod aura;
 mod choreography;
 mod crypto;
 mod effect_api;
+mod fact_feed;
 mod flow;
 mod guard;
 mod journal;
@@ -111,6 +112,8 @@ mod time;
 mod transport;
 mod tree;
 
+pub use fact_feed::CommittedFactCursor;
+
 const DEFAULT_WINDOW: u32 = 1024;
 const TYPED_FACT_STORAGE_PREFIX: &str = "journal/facts";
 const DEFAULT_CHOREO_FLOW_COST: u32 = 1;
@@ -257,6 +260,10 @@ pub struct AuraEffectSystem {
     /// LAN transport service (optional, for TCP envelope delivery)
     lan_transport: parking_lot::RwLock<Option<Arc<LanTransportService>>>,
 
+    /// Pooled, multiplexed TCP connections for direct envelope delivery
+    #[cfg(not(target_arch = "wasm32"))]
+    tcp_connection_pool: crate::runtime::tcp_pool::TcpConnectionPool,
+
     /// Rendezvous manager (optional, for address resolution)
     rendezvous_manager: parking_lot::RwLock<Option<RendezvousManager>>,
 
@@ -266,6 +273,12 @@ pub struct AuraEffectSystem {
     /// Cached Biscuit token for guard chain authorization.
     biscuit_cache: parking_lot::RwLock<Option<BiscuitCache>>,
 
+    /// Biscuit authorizers and decisions shared by every guarded send.
+    biscuit_authorizers: Arc<aura_authorization::BiscuitAuthorizerCache>,
+
+    /// Recent facts committed through this runtime, for incremental readers.
+    committed_fact_feed: parking_lot::Mutex<fact_feed::CommittedFactFeed>,
+
     /// Runtime-local key used to sign flow receipts and their transport binding.
     receipt_signing_key: Ed25519SigningKey,
 
@@ -650,9 +663,13 @@ impl AuraEffectSystem {
             choreography_state: parking_lot::RwLock::new(ChoreographyState::default()),
             vm_fragment_registry: parking_lot::RwLock::new(VmFragmentRegistry::default()),
             lan_transport: parking_lot::RwLock::new(None),
+            #[cfg(not(target_arch = "wasm32"))]
+            tcp_connection_pool: crate::runtime::tcp_pool::TcpConnectionPool::default(),
             rendezvous_manager: parking_lot::RwLock::new(None),
             move_manager: parking_lot::RwLock::new(None),
             biscuit_cache: parking_lot::RwLock::new(initial_biscuit_cache),
+            biscuit_authorizers: Arc::new(aura_authorization::BiscuitAuthorizerCache::new()),
+            committed_fact_feed: parking_lot::Mutex::new(fact_feed::CommittedFactFeed::default()),
             receipt_signing_key,
             effect_api_ledger: parking_lot::Mutex::new(EffectApiLedgerState::default()),
             system_config: parking_lot::RwLock::new(HashMap::new()),
@@ -1083,6 +1100,12 @@ impl AuraEffectSystem {
         self.lan_transport.read().clone()
     }
 
+    /// Pool of reusable TCP connections keyed by resolved peer address.
+    #[cfg(not(target_arch = "wasm32"))]
+    pub fn tcp_connection_pool(&self) -> &crate::runtime::tcp_pool::TcpConnectionPool {
+        &self.tcp_connection_pool
+    }
+
     pub fn attach_rendezvous_manager(&self, manager: RendezvousManager) {
         *self.rendezvous_manager.write() = Some(manager);
     }
@@ -1277,6 +1300,29 @@ impl AuraEffectSystem {
         )
     }
 
+    /// Persist a committed fact and record it in the commit feed.
+    async fn persist_typed_fact(&self, fact: &TypedFact) -> Result<(), AuraError> {
+        let key = Self::typed_fact_storage_key(self.authority_id, &fact.order);
+        let bytes = aura_core::util::serialization::to_vec(fact)
+            .map_err(|e| AuraError::internal(format!("serialize fact: {e}")))?;
+        self.storage_handler
+            .store(&key, bytes)
+            .await
+            .map_err(|e| AuraError::storage(format!("persist fact: {e}")))?;
+        self.committed_fact_feed.lock().push(key, fact.clone());
+        Ok(())
+    }
+
+    /// Invalidate the commit feed after a raw storage write to a fact key.
+    ///
+    /// Facts written or removed outside [`Self::persist_typed_fact`] are not
+    /// in the feed, so incremental readers must relist the store.
+    fn note_raw_fact_write(&self, key: Option<&str>) {
+        if key.is_none_or(|key| key.starts_with(TYPED_FACT_STORAGE_PREFIX)) {
+            self.committed_fact_feed.lock().invalidate();
+        }
+    }
+
     /// Commit a batch of typed relational facts into the canonical fact store and publish them.
     ///
     /// This is the single write path for UI-facing facts in the runtime.
@@ -1301,13 +1347,7 @@ impl AuraEffectSystem {
                 FactContent::Relational(rel),
             );
 
-            let key = Self::typed_fact_storage_key(self.authority_id, &order);
-            let bytes = aura_core::util::serialization::to_vec(&fact)
-                .map_err(|e| AuraError::internal(format!("serialize fact: {e}")))?;
-            self.store(&key, bytes)
-                .await
-                .map_err(|e| AuraError::storage(format!("persist fact: {e}")))?;
-
+            self.persist_typed_fact(&fact).await?;
             committed.push(fact);
         }
 
@@ -1350,13 +1390,7 @@ impl AuraEffectSystem {
                 fact = fact.with_agreement(agreement.clone());
             }
 
-            let key = Self::typed_fact_storage_key(self.authority_id, &order);
-            let bytes = aura_core::util::serialization::to_vec(&fact)
-                .map_err(|e| AuraError::internal(format!("serialize fact: {e}")))?;
-            self.store(&key, bytes)
-                .await
-                .map_err(|e| AuraError::storage(format!("persist fact: {e}")))?;
-
+            self.persist_typed_fact(&fact).await?;
             committed.push(fact);
         }
 
@@ -1420,6 +1454,68 @@ impl AuraEffectSystem {
         Ok(facts)
     }
 
+    /// Load committed typed facts not yet returned through `cursor`.
+    ///
+    /// Facts committed through this runtime since the previous call come
+    /// from the in-memory commit feed, so a steady-state call costs
+    /// O(new commits). The first call, a cursor that fell behind the feed,
+    /// and raw writes to fact keys fall back to listing every stored key.
+    /// Returns `None` when a previously returned fact is no longer stored;
+    /// the caller's derived state is stale and must be rebuilt from a fresh
+    /// cursor.
+    pub async fn load_unseen_committed_facts(
+        &self,
+        authority_id: AuthorityId,
+        cursor: &mut CommittedFactCursor,
+    ) -> Result<Option<Vec<TypedFact>>, AuraError> {
+        let prefix = Self::typed_fact_storage_prefix(authority_id);
+        if let Some(position) = cursor.feed {
+            let recent = self.committed_fact_feed.lock().since(position, &prefix);
+            if let Some((recent, next)) = recent {
+                cursor.feed = Some(next);
+                let mut facts: Vec<TypedFact> = recent
+                    .into_iter()
+                    .filter_map(|(key, fact)| cursor.seen.insert(key).then_some(fact))
+                    .collect();
+                facts.sort();
+                return Ok(Some(facts));
+            }
+        }
+
+        // Take the feed position before listing: a commit racing the listing
+        // is then read from the feed next time, and `seen` drops duplicates.
+        let position = self.committed_fact_feed.lock().tail();
+        let keys: std::collections::BTreeSet<String> = self
+            .list_keys(Some(&prefix))
+            .await
+            .map_err(|e| AuraError::storage(format!("list_keys: {e}")))?
+            .into_iter()
+            .collect();
+        if !cursor.seen.is_subset(&keys) {
+            return Ok(None);
+        }
+
+        let mut facts = Vec::new();
+        for key in keys.into_iter().filter(|key| !cursor.seen.contains(key)) {
+            let Some(bytes) = self
+                .retrieve(&key)
+                .await
+                .map_err(|e| AuraError::storage(format!("retrieve: {e}")))?
+            else {
+                continue;
+            };
+
+            let fact: TypedFact = aura_core::util::serialization::from_slice(&bytes)
+                .map_err(|e| AuraError::internal(format!("deserialize fact: {e}")))?;
+            facts.push(fact);
+            cursor.seen.insert(key);
+        }
+        cursor.feed = Some(position);
+
+        facts.sort();
+        Ok(Some(facts))
+    }
+
     /// Check whether a consensus-finalized DKG transcript commit exists for an epoch.
     pub async fn has_dkg_transcript_commit(
         &self,
@@ -48,6 +48,12 @@ impl GuardContextProvider for AuraEffectSystem {
     fn can_perform_operation(&self, _operation: &str) -> bool {
         true
     }
+
+    fn biscuit_authorizer_cache(
+        &self,
+    ) -> Option<std::sync::Arc<aura_authorization::BiscuitAuthorizerCache>> {
+        Some(self.biscuit_authorizers.clone())
+    }
 }
 
 // ============================================================================
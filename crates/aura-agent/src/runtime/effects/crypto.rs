@@ -3,8 +3,8 @@ use async_trait::async_trait;
 use aura_core::crypto::single_signer::{SigningMode, SingleSignerKeyPackage};
 use aura_core::crypto::tree_signing;
 use aura_core::effects::crypto::{
-    FrostKeyGenResult, FrostSigningPackage, KeyDerivationContext, KeyGenerationMethod,
-    SigningKeyGenResult,
+    Ed25519BatchItem, FrostKeyGenResult, FrostSigningPackage, KeyDerivationContext,
+    KeyGenerationMethod, SigningKeyGenResult,
 };
 use aura_core::effects::{
     CryptoCoreEffects, CryptoError, CryptoExtendedEffects, RandomCoreEffects,
@@ -333,6 +333,10 @@ impl CryptoCoreEffects for AuraEffectSystem {
             .await
     }
 
+    async fn ed25519_verify_batch(&self, items: &[Ed25519BatchItem]) -> Result<bool, CryptoError> {
+        self.crypto.handler().ed25519_verify_batch(items).await
+    }
+
     fn is_simulated(&self) -> bool {
         self.crypto.handler().is_simulated()
     }
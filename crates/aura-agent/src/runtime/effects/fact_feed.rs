@@ -0,0 +1,166 @@
+//! Bounded feed of facts committed through the runtime
+//!
+//! Readers that keep derived state over the committed fact store (chat
+//! history, for example) would otherwise relist every fact key to find new
+//! commits. The feed keeps the most recent commits in sequence order, so a
+//! reader holding a [`CommittedFactCursor`] absorbs only what was committed
+//! since its last read.
+//!
+//! The feed is a fast path, not a source of truth. A cursor falls back to a
+//! full listing of the store when it is new, when it has fallen behind the
+//! retained window, or when the feed was invalidated because fact keys were
+//! written or removed outside the commit path.
+
+use aura_journal::fact::Fact as TypedFact;
+use std::collections::{BTreeSet, VecDeque};
+
+/// Default number of recent commits the feed retains.
+pub(super) const DEFAULT_FACT_FEED_CAPACITY: usize = 4_096;
+
+#[derive(Debug)]
+pub(super) struct CommittedFactFeed {
+    /// Bumped whenever the store may hold facts the feed never saw
+    epoch: u64,
+    /// Sequence number of the front entry
+    start: u64,
+    entries: VecDeque<(String, TypedFact)>,
+    capacity: usize,
+}
+
+/// Feed position: facts from `next` on in feed `epoch` have not been read.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub(super) struct FeedPosition {
+    epoch: u64,
+    next: u64,
+}
+
+impl Default for CommittedFactFeed {
+    fn default() -> Self {
+        Self::with_capacity(DEFAULT_FACT_FEED_CAPACITY)
+    }
+}
+
+impl CommittedFactFeed {
+    pub(super) fn with_capacity(capacity: usize) -> Self {
+        Self {
+            epoch: 0,
+            start: 0,
+            entries: VecDeque::new(),
+            capacity: capacity.max(1),
+        }
+    }
+
+    /// Position just past the newest commit.
+    pub(super) fn tail(&self) -> FeedPosition {
+        FeedPosition {
+            epoch: self.epoch,
+            next: self.start + self.entries.len() as u64,
+        }
+    }
+
+    /// Record a fact persisted under `key`.
+    pub(super) fn push(&mut self, key: String, fact: TypedFact) {
+        self.entries.push_back((key, fact));
+        while self.entries.len() > self.capacity {
+            self.entries.pop_front();
+            self.start += 1;
+        }
+    }
+
+    /// Forget retained commits and move every outstanding cursor to a full
+    /// listing.
+    pub(super) fn invalidate(&mut self) {
+        self.epoch += 1;
+        self.start += self.entries.len() as u64;
+        self.entries.clear();
+    }
+
+    /// Commits since `position` whose key starts with `prefix`, or `None` if
+    /// `position` is from an older epoch or outside the retained window.
+    pub(super) fn since(
+        &self,
+        position: FeedPosition,
+        prefix: &str,
+    ) -> Option<(Vec<(String, TypedFact)>, FeedPosition)> {
+        let tail = self.tail();
+        if position.epoch != self.epoch || position.next < self.start || position.next > tail.next {
+            return None;
+        }
+        let skip = (position.next - self.start) as usize;
+        let facts = self
+            .entries
+            .iter()
+            .skip(skip)
+            .filter(|(key, _)| key.starts_with(prefix))
+            .cloned()
+            .collect();
+        Some((facts, tail))
+    }
+}
+
+/// A reader's progress through the committed fact store.
+///
+/// Pass the same cursor to every
+/// [`AuraEffectSystem::load_unseen_committed_facts`](super::AuraEffectSystem::load_unseen_committed_facts)
+/// call; reset it with [`Default`] when the derived state is rebuilt.
+#[derive(Debug, Default)]
+pub struct CommittedFactCursor {
+    /// Storage keys of facts already returned
+    pub(super) seen: BTreeSet<String>,
+    /// Feed position after the last read, once a full listing has run
+    pub(super) feed: Option<FeedPosition>,
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use aura_core::time::{OrderTime, TimeStamp};
+    use aura_journal::fact::{FactContent, RelationalFact};
+
+    fn fact(tag: u8) -> TypedFact {
+        let order = OrderTime([tag; 32]);
+        TypedFact::new(
+            order.clone(),
+            TimeStamp::OrderClock(order),
+            FactContent::Relational(RelationalFact::Generic {
+                context_id: aura_core::types::identifiers::ContextId::new_from_entropy([tag; 32]),
+                envelope: aura_core::types::facts::FactEnvelope {
+                    type_id: "test".into(),
+                    schema_version: 1,
+                    encoding: aura_core::types::facts::FactEncoding::DagCbor,
+                    payload: vec![tag],
+                },
+            }),
+        )
+    }
+
+    #[test]
+    fn reads_commits_since_position_for_prefix() {
+        let mut feed = CommittedFactFeed::with_capacity(8);
+        let start = feed.tail();
+        feed.push("a/1".to_string(), fact(1));
+        feed.push("b/2".to_string(), fact(2));
+        feed.push("a/3".to_string(), fact(3));
+
+        let (facts, next) = feed.since(start, "a/").unwrap();
+        let keys: Vec<_> = facts.iter().map(|(key, _)| key.as_str()).collect();
+        assert_eq!(keys, ["a/1", "a/3"]);
+        assert_eq!(next, feed.tail());
+        assert!(feed.since(next, "a/").unwrap().0.is_empty());
+    }
+
+    #[test]
+    fn overrun_and_invalidation_force_a_listing() {
+        let mut feed = CommittedFactFeed::with_capacity(2);
+        let start = feed.tail();
+        for tag in 0..3 {
+            feed.push(format!("a/{tag}"), fact(tag));
+        }
+        assert!(feed.since(start, "a/").is_none());
+
+        let current = feed.tail();
+        feed.invalidate();
+        assert!(feed.since(current, "a/").is_none());
+        assert!(feed.since(feed.tail(), "a/").unwrap().0.is_empty());
+    }
+}
@@ -1,20 +1,15 @@
 use super::AuraEffectSystem;
 use async_trait::async_trait;
 use aura_authorization::VerifiedBiscuitToken;
-use aura_core::effects::{FlowBudgetEffects, JournalEffects};
+use aura_core::effects::{batch_charge_nonces, total_flow_cost, FlowBudgetEffects, JournalEffects};
 use aura_core::types::scope::{AuthorizationOp, ContextOp, ResourceScope};
-use aura_core::{AuraError, AuthorityId, ContextId, FlowCost, FlowNonce, Hash32, ReceiptSig};
+use aura_core::{
+    AuraError, AuthorityId, ContextId, FlowBudget, FlowCost, FlowNonce, Hash32, ReceiptSig,
+};
 
-// Implementation of FlowBudgetEffects
-#[cfg_attr(target_arch = "wasm32", async_trait(?Send))]
-#[cfg_attr(not(target_arch = "wasm32"), async_trait)]
-impl FlowBudgetEffects for AuraEffectSystem {
-    async fn charge_flow(
-        &self,
-        context: &ContextId,
-        peer: &AuthorityId,
-        cost: FlowCost,
-    ) -> aura_core::AuraResult<aura_core::Receipt> {
+impl AuraEffectSystem {
+    /// Enforce the journal's Biscuit flow-charge policy, if one is configured.
+    async fn authorize_flow_charge(&self, context: &ContextId) -> aura_core::AuraResult<()> {
         if let Some((token, bridge)) = &self.journal.journal_policy() {
             let scope = ResourceScope::Context {
                 context_id: *context,
@@ -38,15 +33,24 @@ impl FlowBudgetEffects for AuraEffectSystem {
                 ));
             }
         }
+        Ok(())
+    }
 
-        let budget = JournalEffects::charge_flow_budget(self, context, peer, cost).await?;
+    fn signed_flow_receipt(
+        &self,
+        context: &ContextId,
+        peer: &AuthorityId,
+        budget: &FlowBudget,
+        cost: FlowCost,
+        nonce: FlowNonce,
+    ) -> aura_core::AuraResult<aura_core::Receipt> {
         let mut receipt = aura_core::Receipt::new(
             *context,
             self.authority_id,
             *peer,
             budget.epoch,
             cost,
-            FlowNonce::new(budget.spent),
+            nonce,
             Hash32::default(),
             ReceiptSig::new(Vec::new())?,
         );
@@ -54,3 +58,41 @@ impl FlowBudgetEffects for AuraEffectSystem {
         Ok(receipt)
     }
 }
+
+// Implementation of FlowBudgetEffects
+#[cfg_attr(target_arch = "wasm32", async_trait(?Send))]
+#[cfg_attr(not(target_arch = "wasm32"), async_trait)]
+impl FlowBudgetEffects for AuraEffectSystem {
+    async fn charge_flow(
+        &self,
+        context: &ContextId,
+        peer: &AuthorityId,
+        cost: FlowCost,
+    ) -> aura_core::AuraResult<aura_core::Receipt> {
+        self.authorize_flow_charge(context).await?;
+
+        let budget = JournalEffects::charge_flow_budget(self, context, peer, cost).await?;
+        self.signed_flow_receipt(context, peer, &budget, cost, FlowNonce::new(budget.spent))
+    }
+
+    async fn charge_flow_batch(
+        &self,
+        context: &ContextId,
+        peer: &AuthorityId,
+        costs: &[FlowCost],
+    ) -> aura_core::AuraResult<Vec<aura_core::Receipt>> {
+        if costs.is_empty() {
+            return Ok(Vec::new());
+        }
+        self.authorize_flow_charge(context).await?;
+
+        // One debit for the whole batch; receipts replay the per-send nonces.
+        let total = total_flow_cost(costs)?;
+        let budget = JournalEffects::charge_flow_budget(self, context, peer, total).await?;
+        costs
+            .iter()
+            .zip(batch_charge_nonces(budget.spent, costs))
+            .map(|(&cost, nonce)| self.signed_flow_receipt(context, peer, &budget, cost, nonce))
+            .collect()
+    }
+}
@@ -39,7 +39,7 @@ impl JournalEffects for AuraEffectSystem {
             uncertainty: None,
         });
         self.journal
-            .index_new_journal_facts(journal, Some(self.authority_id), Some(timestamp));
+            .index_new_journal_facts(journal, Some(self.authority_id), Some(timestamp))?;
 
         Ok(())
     }
@@ -140,6 +140,16 @@ impl IndexedJournalEffects for AuraEffectSystem {
             .await
     }
 
+    async fn fact_inclusion_proof(
+        &self,
+        fact: &indexed::IndexedFact,
+    ) -> Result<Option<aura_core::crypto::merkle::MerkleMountainRangeProof>, AuraError> {
+        self.journal
+            .indexed_journal()
+            .fact_inclusion_proof(fact)
+            .await
+    }
+
     async fn get_bloom_filter(&self) -> Result<BloomFilter, AuraError> {
         self.journal.indexed_journal().get_bloom_filter().await
     }
@@ -12,7 +12,9 @@ use std::collections::HashMap;
 #[cfg_attr(not(target_arch = "wasm32"), async_trait)]
 impl StorageCoreEffects for AuraEffectSystem {
     async fn store(&self, key: &str, value: Vec<u8>) -> Result<(), StorageError> {
-        self.storage_handler.store(key, value).await
+        let result = self.storage_handler.store(key, value).await;
+        self.note_raw_fact_write(Some(key));
+        result
     }
 
     async fn retrieve(&self, key: &str) -> Result<Option<Vec<u8>>, StorageError> {
@@ -20,7 +22,9 @@ impl StorageCoreEffects for AuraEffectSystem {
     }
 
     async fn remove(&self, key: &str) -> Result<bool, StorageError> {
-        self.storage_handler.remove(key).await
+        let result = self.storage_handler.remove(key).await;
+        self.note_raw_fact_write(Some(key));
+        result
     }
 
     async fn list_keys(&self, prefix: Option<&str>) -> Result<Vec<String>, StorageError> {
@@ -36,7 +40,15 @@ impl StorageExtendedEffects for AuraEffectSystem {
     }
 
     async fn store_batch(&self, pairs: HashMap<String, Vec<u8>>) -> Result<(), StorageError> {
-        self.storage_handler.store_batch(pairs).await
+        let fact_key = pairs
+            .keys()
+            .find(|key| key.starts_with(super::TYPED_FACT_STORAGE_PREFIX))
+            .cloned();
+        let result = self.storage_handler.store_batch(pairs).await;
+        if let Some(key) = fact_key {
+            self.note_raw_fact_write(Some(&key));
+        }
+        result
     }
 
     async fn retrieve_batch(
@@ -47,7 +59,9 @@ impl StorageExtendedEffects for AuraEffectSystem {
     }
 
     async fn clear_all(&self) -> Result<(), StorageError> {
-        self.storage_handler.clear_all().await
+        let result = self.storage_handler.clear_all().await;
+        self.note_raw_fact_write(None);
+        result
     }
 
     async fn stats(&self) -> Result<StorageStats, StorageError> {
@@ -29,10 +29,6 @@ use std::future::Future;
 #[cfg(not(target_arch = "wasm32"))]
 use std::net::{IpAddr, Ipv6Addr, SocketAddr};
 #[cfg(not(target_arch = "wasm32"))]
-use tokio::io::AsyncWriteExt;
-#[cfg(not(target_arch = "wasm32"))]
-use tokio::net::TcpStream;
-#[cfg(not(target_arch = "wasm32"))]
 use tokio_tungstenite::{connect_async, tungstenite::Message as TungsteniteMessage};
 
 #[cfg(target_arch = "wasm32")]
@@ -399,7 +395,7 @@ async fn send_planned_envelope(
             "Resolved invitation transport target"
         );
     }
-    send_envelope_tcp(&addr, &envelope).await
+    send_envelope_tcp(effects, &addr, &envelope).await
 }
 
 fn enforce_transport_payload_size(envelope: &TransportEnvelope) -> Result<(), TransportError> {
@@ -511,9 +507,14 @@ fn route_destination_addr(endpoint: &LinkEndpoint) -> Option<String> {
     endpoint.address.clone()
 }
 
-async fn send_envelope_tcp(addr: &str, envelope: &TransportEnvelope) -> Result<(), TransportError> {
+async fn send_envelope_tcp(
+    effects: &AuraEffectSystem,
+    addr: &str,
+    envelope: &TransportEnvelope,
+) -> Result<(), TransportError> {
     cfg_if! {
         if #[cfg(target_arch = "wasm32")] {
+            let _ = effects;
             let payload = aura_core::util::serialization::to_vec(envelope).map_err(|e| {
                 TransportError::SendFailed {
                     destination: envelope.destination,
@@ -630,14 +631,18 @@ async fn send_envelope_tcp(addr: &str, envelope: &TransportEnvelope) -> Result<(
                 reason: format!("Invalid transport address '{addr}': {e}"),
             })?;
 
-            let mut stream = execute_transport_timeout(
+            // Path selection resolved `addr`; pooled connections to it are
+            // reused, and each envelope travels on its own short-lived stream.
+            let stream = execute_transport_timeout(
                 config.connect_timeout.get(),
                 || TransportError::SendFailed {
                     destination: envelope.destination,
                     reason: "TCP connect timeout".to_string(),
                 },
                 || async {
-                    TcpStream::connect(socket_addr)
+                    effects
+                        .tcp_connection_pool()
+                        .open_stream(socket_addr)
                         .await
                         .map_err(|e| TransportError::SendFailed {
                             destination: envelope.destination,
@@ -654,7 +659,6 @@ async fn send_envelope_tcp(addr: &str, envelope: &TransportEnvelope) -> Result<(
                 }
             })?;
 
-            let len = (payload.len() as u32).to_be_bytes();
             execute_transport_timeout(
                 config.write_timeout.get(),
                 || TransportError::SendFailed {
@@ -662,8 +666,9 @@ async fn send_envelope_tcp(addr: &str, envelope: &TransportEnvelope) -> Result<(
                     reason: "TCP write timeout".to_string(),
                 },
                 || async {
+                    // Only report success once the writer has flushed the frame
                     stream
-                        .write_all(&len)
+                        .send_flushed(payload)
                         .await
                         .map_err(|e| TransportError::SendFailed {
                             destination: envelope.destination,
@@ -672,37 +677,6 @@ async fn send_envelope_tcp(addr: &str, envelope: &TransportEnvelope) -> Result<(
                 },
             )
             .await?;
-            execute_transport_timeout(
-                config.write_timeout.get(),
-                || TransportError::SendFailed {
-                    destination: envelope.destination,
-                    reason: "TCP write timeout".to_string(),
-                },
-                || async {
-                    stream
-                        .write_all(&payload)
-                        .await
-                        .map_err(|e| TransportError::SendFailed {
-                            destination: envelope.destination,
-                            reason: format!("TCP write failed: {e}"),
-                        })
-                },
-            )
-            .await?;
-            execute_transport_timeout(
-                config.write_timeout.get(),
-                || TransportError::SendFailed {
-                    destination: envelope.destination,
-                    reason: "TCP flush timeout".to_string(),
-                },
-                || async {
-                    stream.flush().await.map_err(|e| TransportError::SendFailed {
-                        destination: envelope.destination,
-                        reason: format!("TCP flush failed: {e}"),
-                    })
-                },
-            )
-            .await?;
 
             Ok(())
         }
@@ -1,5 +1,6 @@
 use super::AuraEffectSystem;
 use async_trait::async_trait;
+use aura_core::effects::{CryptoCoreEffects, Ed25519BatchItem};
 use aura_core::AuraError;
 use aura_journal::commitment_tree::state::TreeState as JournalTreeState;
 
@@ -33,6 +34,30 @@ impl aura_protocol::effects::TreeEffects for AuraEffectSystem {
         self.tree_handler.verify_aggregate_sig(op, state).await
     }
 
+    async fn aggregate_sig_check(
+        &self,
+        op: &aura_core::AttestedOp,
+        state: &JournalTreeState,
+    ) -> Result<Option<Ed25519BatchItem>, AuraError> {
+        self.tree_handler.aggregate_sig_check(op, state).await
+    }
+
+    // Route batches through the runtime crypto handler rather than the
+    // tree handler's pure default.
+    async fn verify_aggregate_sig_batch(
+        &self,
+        checks: &[Ed25519BatchItem],
+    ) -> Result<bool, AuraError> {
+        self.ed25519_verify_batch(checks).await
+    }
+
+    async fn verify_aggregate_sig_check(
+        &self,
+        check: &Ed25519BatchItem,
+    ) -> Result<bool, AuraError> {
+        self.tree_handler.verify_aggregate_sig_check(check).await
+    }
+
     async fn add_leaf(
         &self,
         leaf: aura_core::LeafNode,
@@ -44,6 +44,10 @@ pub mod system;
 // Shared in-memory transport wiring for simulations/demos
 pub mod shared_transport;
 
+// Pooled, multiplexed TCP connections for direct envelope delivery
+#[cfg(not(target_arch = "wasm32"))]
+pub mod tcp_pool;
+
 // Simulation factory (feature-gated)
 #[cfg(feature = "simulation")]
 pub mod simulation_factory;
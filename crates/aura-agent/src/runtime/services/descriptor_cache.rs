@@ -0,0 +1,347 @@
+//! Expiry-indexed rendezvous descriptor cache.
+//!
+//! Relays cache descriptors for thousands of contexts, and the maintenance
+//! loop asks for refresh candidates and peer listings on every tick.
+//! [`DescriptorCache`] stores descriptors by `(context, authority)` alongside
+//! secondary indexes, so each query reads only the entries it returns:
+//! - contexts per authority ordered by `valid_until`, so a refresh sweep stops
+//!   at the first descriptor outside the refresh window;
+//! - authorities per context and descriptor keys per device for peer
+//!   listings, already sorted and deduplicated;
+//! - `valid_until` and `valid_from` buckets, so cleanup visits only the
+//!   descriptors it drops.
+//!
+//! Refresh deadlines are spread by a per-descriptor offset (see
+//! [`refresh_due`]) so descriptors published in one burst do not all come due
+//! on the same tick.
+
+use super::invariant::InvariantViolation;
+use aura_core::types::identifiers::{AuthorityId, ContextId, DeviceId};
+use aura_rendezvous::RendezvousDescriptor;
+use std::collections::{BTreeMap, BTreeSet, HashMap};
+use std::ops::Bound;
+
+/// Cache key of a descriptor.
+pub(crate) type DescriptorKey = (ContextId, AuthorityId);
+
+/// Domain separator for refresh jitter offsets.
+const REFRESH_JITTER_DOMAIN: &[u8] = b"aura.rendezvous.refresh_jitter";
+
+/// Descriptors with secondary indexes by authority, context, device and expiry.
+#[derive(Debug, Default)]
+pub(crate) struct DescriptorCache {
+    entries: HashMap<DescriptorKey, RendezvousDescriptor>,
+    /// Contexts per authority, ordered by `valid_until`.
+    by_authority: BTreeMap<AuthorityId, BTreeSet<(u64, ContextId)>>,
+    /// Authorities per context.
+    by_context: BTreeMap<ContextId, BTreeSet<AuthorityId>>,
+    /// Descriptor keys per advertised device.
+    by_device: BTreeMap<DeviceId, BTreeSet<DescriptorKey>>,
+    /// Descriptor keys by `valid_until`.
+    expires_at: BTreeMap<u64, BTreeSet<DescriptorKey>>,
+    /// Descriptor keys by `valid_from`.
+    valid_from: BTreeMap<u64, BTreeSet<DescriptorKey>>,
+}
+
+impl DescriptorCache {
+    pub fn get(&self, key: &DescriptorKey) -> Option<&RendezvousDescriptor> {
+        self.entries.get(key)
+    }
+
+    pub fn iter(&self) -> impl Iterator<Item = (&DescriptorKey, &RendezvousDescriptor)> {
+        self.entries.iter()
+    }
+
+    /// Insert or replace the descriptor for its `(context, authority)` key.
+    pub fn insert(&mut self, descriptor: RendezvousDescriptor) -> Option<RendezvousDescriptor> {
+        let key = (descriptor.context_id, descriptor.authority_id);
+        let previous = self.remove(&key);
+        add_member(
+            &mut self.by_authority,
+            key.1,
+            (descriptor.valid_until, key.0),
+        );
+        add_member(&mut self.by_context, key.0, key.1);
+        if let Some(device_id) = descriptor.device_id {
+            add_member(&mut self.by_device, device_id, key);
+        }
+        add_member(&mut self.expires_at, descriptor.valid_until, key);
+        add_member(&mut self.valid_from, descriptor.valid_from, key);
+        self.entries.insert(key, descriptor);
+        previous
+    }
+
+    pub fn remove(&mut self, key: &DescriptorKey) -> Option<RendezvousDescriptor> {
+        let descriptor = self.entries.remove(key)?;
+        remove_member(
+            &mut self.by_authority,
+            &key.1,
+            &(descriptor.valid_until, key.0),
+        );
+        remove_member(&mut self.by_context, &key.0, &key.1);
+        if let Some(device_id) = descriptor.device_id {
+            remove_member(&mut self.by_device, &device_id, key);
+        }
+        remove_member(&mut self.expires_at, &descriptor.valid_until, key);
+        remove_member(&mut self.valid_from, &descriptor.valid_from, key);
+        Some(descriptor)
+    }
+
+    /// Drop every descriptor that is not valid at `now_ms`.
+    pub fn remove_invalid(&mut self, now_ms: u64) -> usize {
+        let expired = self
+            .expires_at
+            .range(..=now_ms)
+            .flat_map(|(_, keys)| keys.iter().copied());
+        let pending = self
+            .valid_from
+            .range((Bound::Excluded(now_ms), Bound::Unbounded))
+            .flat_map(|(_, keys)| keys.iter().copied());
+        let keys = expired.chain(pending).collect::<Vec<_>>();
+        keys.iter().filter(|key| self.remove(key).is_some()).count()
+    }
+
+    /// Drop every descriptor cached for `context_id`.
+    pub fn remove_context(&mut self, context_id: ContextId) {
+        let authorities = self
+            .by_context
+            .get(&context_id)
+            .cloned()
+            .unwrap_or_default();
+        for authority_id in authorities {
+            self.remove(&(context_id, authority_id));
+        }
+    }
+
+    /// Descriptors of `authority_id` ordered by `valid_until`.
+    pub fn for_authority(
+        &self,
+        authority_id: AuthorityId,
+    ) -> impl DoubleEndedIterator<Item = &RendezvousDescriptor> {
+        self.by_authority
+            .get(&authority_id)
+            .into_iter()
+            .flatten()
+            .filter_map(move |(_, context_id)| self.entries.get(&(*context_id, authority_id)))
+    }
+
+    /// Descriptors in `context_id` ordered by authority.
+    pub fn in_context(&self, context_id: ContextId) -> impl Iterator<Item = &RendezvousDescriptor> {
+        self.by_context
+            .get(&context_id)
+            .into_iter()
+            .flatten()
+            .filter_map(move |authority_id| self.entries.get(&(context_id, *authority_id)))
+    }
+
+    /// Authorities with at least one cached descriptor, in order.
+    pub fn authorities(&self) -> impl Iterator<Item = AuthorityId> + '_ {
+        self.by_authority.keys().copied()
+    }
+
+    /// Authorities cached in `context_id`, in order.
+    pub fn authorities_in_context(
+        &self,
+        context_id: ContextId,
+    ) -> impl Iterator<Item = AuthorityId> + '_ {
+        self.by_context
+            .get(&context_id)
+            .into_iter()
+            .flatten()
+            .copied()
+    }
+
+    /// Advertised devices in order, with the descriptor keys naming them.
+    pub fn devices(&self) -> impl Iterator<Item = (DeviceId, &BTreeSet<DescriptorKey>)> {
+        self.by_device
+            .iter()
+            .map(|(device_id, keys)| (*device_id, keys))
+    }
+
+    /// Descriptors of `authority_id` expiring at or before `deadline_ms`.
+    pub fn expiring_by(
+        &self,
+        authority_id: AuthorityId,
+        deadline_ms: u64,
+    ) -> impl Iterator<Item = &RendezvousDescriptor> {
+        self.for_authority(authority_id)
+            .take_while(move |descriptor| descriptor.valid_until <= deadline_ms)
+    }
+
+    /// Check that every index agrees with the descriptor map.
+    pub fn validate(&self) -> Result<(), InvariantViolation> {
+        let indexed = |index_len: usize, name: &str| {
+            if index_len == self.entries.len() {
+                Ok(())
+            } else {
+                Err(InvariantViolation::new(
+                    "DescriptorCache",
+                    format!(
+                        "{name} index holds {index_len} descriptors, cache holds {}",
+                        self.entries.len()
+                    ),
+                ))
+            }
+        };
+        indexed(member_count(&self.by_authority), "authority")?;
+        indexed(member_count(&self.by_context), "context")?;
+        indexed(member_count(&self.expires_at), "expiry")?;
+        indexed(member_count(&self.valid_from), "valid_from")?;
+
+        for (key, descriptor) in &self.entries {
+            let listed = self
+                .by_authority
+                .get(&key.1)
+                .is_some_and(|contexts| contexts.contains(&(descriptor.valid_until, key.0)))
+                && descriptor.device_id.map_or(true, |device_id| {
+                    self.by_device
+                        .get(&device_id)
+                        .is_some_and(|keys| keys.contains(key))
+                });
+            if !listed {
+                return Err(InvariantViolation::new(
+                    "DescriptorCache",
+                    format!("descriptor {key:?} missing from secondary indexes"),
+                ));
+            }
+        }
+        Ok(())
+    }
+}
+
+/// Whether `descriptor` is due for refresh at `now_ms`.
+///
+/// Refresh starts `refresh_window_ms` before expiry, delayed by an offset
+/// below `refresh_jitter_ms` (capped at the window) that is derived from the
+/// descriptor's context and authority. The offset is stable, so every sweep
+/// agrees on a descriptor's deadline and simulated runs stay reproducible.
+pub(crate) fn refresh_due(
+    descriptor: &RendezvousDescriptor,
+    refresh_window_ms: u64,
+    refresh_jitter_ms: u64,
+    now_ms: u64,
+) -> bool {
+    let start = descriptor.valid_until.saturating_sub(refresh_window_ms);
+    let spread = refresh_jitter_ms.min(refresh_window_ms);
+    if spread == 0 {
+        return now_ms >= start;
+    }
+    let offset = refresh_jitter_offset(descriptor.context_id, descriptor.authority_id) % spread;
+    let latest = descriptor.valid_until.saturating_sub(1).max(start);
+    now_ms >= start.saturating_add(offset).min(latest)
+}
+
+fn refresh_jitter_offset(context_id: ContextId, authority_id: AuthorityId) -> u64 {
+    let mut hasher = aura_core::hash::hasher();
+    hasher.update(REFRESH_JITTER_DOMAIN);
+    hasher.update(&context_id.to_bytes());
+    hasher.update(&authority_id.to_bytes());
+    let digest = hasher.finalize();
+    let mut prefix = [0u8; 8];
+    prefix.copy_from_slice(&digest[..8]);
+    u64::from_le_bytes(prefix)
+}
+
+fn add_member<K: Ord, V: Ord>(index: &mut BTreeMap<K, BTreeSet<V>>, key: K, member: V) {
+    index.entry(key).or_default().insert(member);
+}
+
+fn remove_member<K: Ord, V: Ord>(index: &mut BTreeMap<K, BTreeSet<V>>, key: &K, member: &V) {
+    if let Some(members) = index.get_mut(key) {
+        members.remove(member);
+        if members.is_empty() {
+            index.remove(key);
+        }
+    }
+}
+
+fn member_count<K, V>(index: &BTreeMap<K, BTreeSet<V>>) -> usize {
+    index.values().map(BTreeSet::len).sum()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use aura_rendezvous::TransportHint;
+
+    fn authority(seed: u8) -> AuthorityId {
+        AuthorityId::new_from_entropy([seed; 32])
+    }
+
+    fn context(seed: u8) -> ContextId {
+        ContextId::new_from_entropy([seed; 32])
+    }
+
+    fn descriptor(
+        authority_id: AuthorityId,
+        context_id: ContextId,
+        valid_from: u64,
+        valid_until: u64,
+    ) -> RendezvousDescriptor {
+        RendezvousDescriptor {
+            authority_id,
+            device_id: None,
+            context_id,
+            transport_hints: vec![TransportHint::tcp_direct("127.0.0.1:8080").expect("hint")],
+            handshake_psk_commitment: [1u8; 32],
+            public_key: [2u8; 32],
+            valid_from,
+            valid_until,
+            nonce: [3u8; 32],
+            nickname_suggestion: None,
+        }
+    }
+
+    #[test]
+    fn replacing_a_descriptor_reindexes_it() {
+        let mut cache = DescriptorCache::default();
+        let peer = authority(1);
+        let ctx = context(2);
+        let device = DeviceId::new_from_entropy([4u8; 32]);
+        let mut first = descriptor(peer, ctx, 0, 100);
+        first.device_id = Some(device);
+        cache.insert(first);
+        cache.insert(descriptor(peer, ctx, 0, 500));
+
+        assert_eq!(cache.iter().count(), 1);
+        assert_eq!(cache.devices().count(), 0);
+        assert_eq!(cache.expiring_by(peer, 200).count(), 0);
+        assert_eq!(cache.expiring_by(peer, 500).count(), 1);
+        cache.validate().unwrap();
+    }
+
+    #[test]
+    fn remove_invalid_drops_expired_and_future_descriptors() {
+        let mut cache = DescriptorCache::default();
+        let ctx = context(1);
+        cache.insert(descriptor(authority(2), ctx, 0, 100));
+        cache.insert(descriptor(authority(3), ctx, 0, 500));
+        cache.insert(descriptor(authority(4), ctx, 300, 600));
+
+        assert_eq!(cache.remove_invalid(200), 2);
+        assert_eq!(
+            cache.authorities_in_context(ctx).collect::<Vec<_>>(),
+            vec![authority(3)]
+        );
+        cache.validate().unwrap();
+    }
+
+    #[test]
+    fn refresh_jitter_stays_inside_the_window() {
+        let owner = authority(1);
+        let mut offsets = BTreeSet::new();
+        for seed in 0..32 {
+            let descriptor = descriptor(owner, context(seed), 0, 10_000);
+            assert!(!refresh_due(&descriptor, 1_000, 500, 8_999));
+            assert!(refresh_due(&descriptor, 1_000, 500, 9_500));
+            let due_at = (9_000..=9_500)
+                .find(|now| refresh_due(&descriptor, 1_000, 500, *now))
+                .unwrap();
+            offsets.insert(due_at);
+        }
+        assert!(offsets.len() > 1, "jitter should spread refresh deadlines");
+
+        let descriptor = descriptor(owner, context(1), 0, 10_000);
+        assert!(refresh_due(&descriptor, 1_000, 0, 9_000));
+    }
+}
@@ -16,11 +16,41 @@ use async_trait::async_trait;
 use aura_core::effects::PhysicalTimeEffects;
 use aura_core::hash::hash;
 use aura_core::types::identifiers::{AuthorityId, ContextId, DeviceId};
+use aura_core::OwnedTaskHandle;
+use aura_effects::LogStructuredStorageHandler;
 use std::collections::HashSet;
 use std::sync::Arc;
 use std::time::Duration;
 use tokio::sync::RwLock;
 
+/// Run log-structured storage compaction from the agent's task registry.
+///
+/// Commits only mark sealed segments due; this task performs the copy off
+/// the commit path, so compaction is owned, named and cancelled with the
+/// rest of the runtime's tasks.
+#[must_use = "retain or explicitly discard the owned task handle"]
+pub fn spawn_log_compaction(
+    tasks: &TaskGroup,
+    time_effects: Arc<dyn PhysicalTimeEffects + Send + Sync>,
+    storage: LogStructuredStorageHandler,
+    interval: Duration,
+) -> OwnedTaskHandle<u64> {
+    tasks.spawn_interval_until_named(
+        "log_storage_compaction",
+        time_effects,
+        interval,
+        move || {
+            let storage = storage.clone();
+            async move {
+                if let Err(error) = storage.compact_sealed().await {
+                    tracing::warn!(error = %error, "Log storage compaction failed");
+                }
+                true
+            }
+        },
+    )
+}
+
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub enum MaintenanceServiceState {
     Stopped,
@@ -432,6 +462,25 @@ impl RuntimeMaintenanceService {
             );
         }
 
+        #[cfg(not(target_arch = "wasm32"))]
+        {
+            let pool = self.effects.tcp_connection_pool().clone();
+            let interval = pool.config().maintenance_interval;
+            let _tcp_pool_task_handle = tasks.spawn_interval_until_named(
+                "tcp_connection_pool_maintenance",
+                time_effects.clone(),
+                interval,
+                move || {
+                    let pool = pool.clone();
+                    async move {
+                        pool.prune().await;
+                        pool.health_check().await;
+                        true
+                    }
+                },
+            );
+        }
+
         if let (Some(rendezvous_manager), Some(lan_transport)) =
             (self.rendezvous_manager.clone(), self.lan_transport.clone())
         {
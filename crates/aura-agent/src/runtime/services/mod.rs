@@ -14,6 +14,7 @@ pub mod ceremony_tracker;
 mod config_profiles;
 pub mod context_manager;
 pub mod cover_traffic_generator;
+mod descriptor_cache;
 pub mod flow_budget_manager;
 pub mod hold_manager;
 pub mod invariant;
@@ -70,7 +71,7 @@ pub use local_health_observer::{
     LocalHealthObserverConfig, LocalHealthObserverService as LocalHealthObserver,
 };
 pub use logical_clock_manager::LogicalClockManager;
-pub use maintenance_service::RuntimeMaintenanceService;
+pub use maintenance_service::{spawn_log_compaction, RuntimeMaintenanceService};
 #[allow(unused_imports)]
 pub use move_manager::{MoveDeliveryPlan, MoveManager, MoveManagerConfig, MoveProjection};
 #[allow(unused_imports)] // Public runtime service API.
@@ -67,6 +67,10 @@ pub struct RendezvousManagerConfig {
     /// Refresh window - refresh descriptors this long before expiry (default: 5 min)
     pub refresh_window: Duration,
 
+    /// Refresh jitter - delay each descriptor's refresh by a stable per-context
+    /// offset below this, capped at the refresh window (default: 2 min)
+    pub refresh_jitter: Duration,
+
     /// Default descriptor validity duration (default: 1 hour)
     pub descriptor_validity: Duration,
 
@@ -94,6 +98,7 @@ impl Default for RendezvousManagerConfig {
         Self {
             auto_refresh_enabled: true,
             refresh_window: Duration::from_secs(300), // 5 minutes
+            refresh_jitter: Duration::from_secs(120), // 2 minutes
             descriptor_validity: Duration::from_secs(3600), // 1 hour
             auto_cleanup_enabled: true,
             cleanup_interval: Duration::from_secs(60),
@@ -110,6 +115,7 @@ impl_service_config_profiles!(RendezvousManagerConfig {
         Self {
             auto_refresh_enabled: true,
             refresh_window: Duration::from_secs(30),
+            refresh_jitter: Duration::from_secs(10),
             descriptor_validity: Duration::from_secs(300),
             auto_cleanup_enabled: true,
             cleanup_interval: Duration::from_secs(10),
@@ -856,16 +862,32 @@ impl RendezvousManager {
     /// Check if our descriptor needs refresh in a context
     pub async fn needs_refresh(&self, context_id: ContextId, now_ms: u64) -> bool {
         let refresh_window_ms = self.config.refresh_window.as_millis() as u64;
+        let refresh_jitter_ms = self.config.refresh_jitter.as_millis() as u64;
         self.registry
-            .descriptor_needs_refresh(context_id, self.authority_id, refresh_window_ms, now_ms)
+            .descriptor_needs_refresh(
+                context_id,
+                self.authority_id,
+                refresh_window_ms,
+                refresh_jitter_ms,
+                now_ms,
+            )
             .await
     }
 
     /// Get contexts needing descriptor refresh
+    ///
+    /// Deadlines are jittered per context, so contexts published together
+    /// come due over `refresh_jitter` instead of on one tick.
     pub async fn contexts_needing_refresh(&self, now_ms: u64) -> Vec<ContextId> {
         let refresh_window_ms = self.config.refresh_window.as_millis() as u64;
+        let refresh_jitter_ms = self.config.refresh_jitter.as_millis() as u64;
         self.registry
-            .contexts_needing_refresh(self.authority_id, refresh_window_ms, now_ms)
+            .contexts_needing_refresh(
+                self.authority_id,
+                refresh_window_ms,
+                refresh_jitter_ms,
+                now_ms,
+            )
             .await
     }
 
@@ -1533,11 +1555,9 @@ impl RendezvousManager {
             .list_cached_devices_for_authority(authority_id, None)
             .await;
         devices.extend(
-            self.list_lan_discovered_peers()
+            self.get_lan_discovered_peer(authority_id)
                 .await
-                .into_iter()
-                .filter(|peer| peer.authority_id == authority_id)
-                .filter_map(|peer| peer.descriptor.device_id),
+                .and_then(|peer| peer.descriptor.device_id),
         );
         devices.sort();
         devices.dedup();
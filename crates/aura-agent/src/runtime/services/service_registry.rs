@@ -5,6 +5,7 @@
 //! and hold observations. These are all derived, actor-owned runtime views and
 //! must not be treated as replicated truth.
 
+use super::descriptor_cache::{refresh_due, DescriptorCache};
 use super::invariant::InvariantViolation;
 use super::state::with_state_mut_validated;
 use aura_core::service::{Route, SelectionState, ServiceFamily};
@@ -72,7 +73,7 @@ struct ProviderHealthRecord {
 
 #[derive(Debug, Default)]
 struct ServiceRegistryState {
-    descriptors: HashMap<(ContextId, AuthorityId), RendezvousDescriptor>,
+    descriptors: DescriptorCache,
     provider_health: HashMap<(ServiceFamily, AuthorityId), ProviderHealthRecord>,
     selection_state: HashMap<(ContextId, ServiceFamily), SelectionState>,
     hold_observations: HashMap<(ContextId, AuthorityId), HoldObservation>,
@@ -81,7 +82,7 @@ struct ServiceRegistryState {
 
 impl ServiceRegistryState {
     fn validate(&self) -> Result<(), InvariantViolation> {
-        for ((scope, authority_id), descriptor) in &self.descriptors {
+        for ((scope, authority_id), descriptor) in self.descriptors.iter() {
             if *scope != descriptor.context_id || *authority_id != descriptor.authority_id {
                 return Err(InvariantViolation::new(
                     "ServiceRegistry",
@@ -92,6 +93,7 @@ impl ServiceRegistryState {
                 ));
             }
         }
+        self.descriptors.validate()?;
 
         for ((scope, family), state) in &self.selection_state {
             if state.family != *family {
@@ -166,9 +168,7 @@ impl ServiceRegistryService {
         with_state_mut_validated(
             &self.state,
             |state| {
-                state
-                    .descriptors
-                    .insert((descriptor.context_id, descriptor.authority_id), descriptor);
+                state.descriptors.insert(descriptor);
             },
             ServiceRegistryState::validate,
         )
@@ -205,8 +205,8 @@ impl ServiceRegistryService {
             .read()
             .await
             .descriptors
-            .values()
-            .find(|descriptor| descriptor.authority_id == authority_id)
+            .for_authority(authority_id)
+            .next_back()
             .cloned()
     }
 
@@ -219,8 +219,7 @@ impl ServiceRegistryService {
             .read()
             .await
             .descriptors
-            .values()
-            .filter(|descriptor| descriptor.authority_id == authority_id)
+            .for_authority(authority_id)
             .cloned()
             .collect::<Vec<_>>();
         descriptors.sort_by_key(|descriptor| {
@@ -233,11 +232,14 @@ impl ServiceRegistryService {
         descriptors
     }
 
+    /// Whether the descriptor for `(context_id, authority_id)` is missing or
+    /// past its jittered refresh deadline (see [`refresh_due`]).
     pub async fn descriptor_needs_refresh(
         &self,
         context_id: ContextId,
         authority_id: AuthorityId,
         refresh_window_ms: u64,
+        refresh_jitter_ms: u64,
         now_ms: u64,
     ) -> bool {
         self.state
@@ -245,17 +247,18 @@ impl ServiceRegistryService {
             .await
             .descriptors
             .get(&(context_id, authority_id))
-            .map(|descriptor| {
-                let refresh_threshold = descriptor.valid_until.saturating_sub(refresh_window_ms);
-                now_ms >= refresh_threshold
-            })
+            .map(|descriptor| refresh_due(descriptor, refresh_window_ms, refresh_jitter_ms, now_ms))
             .unwrap_or(true)
     }
 
+    /// Contexts whose `authority_id` descriptor is past its refresh deadline.
+    ///
+    /// Reads only descriptors expiring within the refresh window.
     pub async fn contexts_needing_refresh(
         &self,
         authority_id: AuthorityId,
         refresh_window_ms: u64,
+        refresh_jitter_ms: u64,
         now_ms: u64,
     ) -> Vec<ContextId> {
         let mut contexts = self
@@ -263,18 +266,13 @@ impl ServiceRegistryService {
             .read()
             .await
             .descriptors
-            .iter()
-            .filter(|((_, candidate_authority), descriptor)| {
-                *candidate_authority == authority_id && {
-                    let refresh_threshold =
-                        descriptor.valid_until.saturating_sub(refresh_window_ms);
-                    now_ms >= refresh_threshold
-                }
+            .expiring_by(authority_id, now_ms.saturating_add(refresh_window_ms))
+            .filter(|descriptor| {
+                refresh_due(descriptor, refresh_window_ms, refresh_jitter_ms, now_ms)
             })
-            .map(|((context_id, _), _)| *context_id)
+            .map(|descriptor| descriptor.context_id)
             .collect::<Vec<_>>();
         contexts.sort();
-        contexts.dedup();
         contexts
     }
 
@@ -283,35 +281,20 @@ impl ServiceRegistryService {
         context_id: ContextId,
         now_ms: u64,
     ) -> Vec<RendezvousDescriptor> {
-        let mut descriptors = self
-            .state
+        self.state
             .read()
             .await
             .descriptors
-            .values()
-            .filter(|descriptor| descriptor.context_id == context_id && descriptor.is_valid(now_ms))
+            .in_context(context_id)
+            .filter(|descriptor| descriptor.is_valid(now_ms))
             .cloned()
-            .collect::<Vec<_>>();
-        descriptors.sort_by_key(|descriptor| {
-            (
-                descriptor.context_id,
-                descriptor.authority_id,
-                descriptor.device_id,
-            )
-        });
-        descriptors
+            .collect()
     }
 
     pub async fn cleanup_expired_descriptors(&self, now_ms: u64) -> usize {
         with_state_mut_validated(
             &self.state,
-            |state| {
-                let before = state.descriptors.len();
-                state
-                    .descriptors
-                    .retain(|_, descriptor| descriptor.is_valid(now_ms));
-                before.saturating_sub(state.descriptors.len())
-            },
+            |state| state.descriptors.remove_invalid(now_ms),
             ServiceRegistryState::validate,
         )
         .await
@@ -525,9 +508,7 @@ impl ServiceRegistryService {
         let _ = with_state_mut_validated(
             &self.state,
             |state| {
-                state
-                    .descriptors
-                    .retain(|(candidate_scope, _), _| *candidate_scope != scope);
+                state.descriptors.remove_context(scope);
                 state
                     .selection_state
                     .retain(|(candidate_scope, _), _| *candidate_scope != scope);
@@ -549,20 +530,31 @@ impl ServiceRegistryService {
         now_ms: u64,
     ) -> ServiceRegistryProjection {
         let state = self.state.read().await;
-        let mut descriptors = state
-            .descriptors
-            .values()
-            .filter(|descriptor| descriptor.is_valid(now_ms))
-            .filter(|descriptor| scope.map_or(true, |value| descriptor.context_id == value))
-            .cloned()
-            .collect::<Vec<_>>();
-        descriptors.sort_by_key(|descriptor| {
-            (
-                descriptor.context_id,
-                descriptor.authority_id,
-                descriptor.device_id,
-            )
-        });
+        let descriptors = match scope {
+            Some(context_id) => state
+                .descriptors
+                .in_context(context_id)
+                .filter(|descriptor| descriptor.is_valid(now_ms))
+                .cloned()
+                .collect(),
+            None => {
+                let mut descriptors = state
+                    .descriptors
+                    .iter()
+                    .map(|(_, descriptor)| descriptor)
+                    .filter(|descriptor| descriptor.is_valid(now_ms))
+                    .cloned()
+                    .collect::<Vec<_>>();
+                descriptors.sort_by_key(|descriptor| {
+                    (
+                        descriptor.context_id,
+                        descriptor.authority_id,
+                        descriptor.device_id,
+                    )
+                });
+                descriptors
+            }
+        };
         let mut provider_health = state
             .provider_health
             .iter()
@@ -621,19 +613,19 @@ impl ServiceRegistryService {
         owner: AuthorityId,
         scope: Option<ContextId>,
     ) -> Vec<AuthorityId> {
-        let mut peers = self
-            .state
-            .read()
-            .await
-            .descriptors
-            .values()
-            .filter(|descriptor| descriptor.authority_id != owner)
-            .filter(|descriptor| scope.map_or(true, |value| descriptor.context_id == value))
-            .map(|descriptor| descriptor.authority_id)
-            .collect::<Vec<_>>();
-        peers.sort();
-        peers.dedup();
-        peers
+        let state = self.state.read().await;
+        match scope {
+            Some(context_id) => state
+                .descriptors
+                .authorities_in_context(context_id)
+                .filter(|authority_id| *authority_id != owner)
+                .collect(),
+            None => state
+                .descriptors
+                .authorities()
+                .filter(|authority_id| *authority_id != owner)
+                .collect(),
+        }
     }
 
     pub async fn list_cached_peer_devices(
@@ -641,19 +633,26 @@ impl ServiceRegistryService {
         owner: AuthorityId,
         scope: Option<ContextId>,
     ) -> Vec<DeviceId> {
-        let mut devices = self
-            .state
-            .read()
-            .await
-            .descriptors
-            .values()
-            .filter(|descriptor| descriptor.authority_id != owner)
-            .filter(|descriptor| scope.map_or(true, |value| descriptor.context_id == value))
-            .filter_map(|descriptor| descriptor.device_id)
-            .collect::<Vec<_>>();
-        devices.sort();
-        devices.dedup();
-        devices
+        let state = self.state.read().await;
+        match scope {
+            Some(context_id) => {
+                let mut devices = state
+                    .descriptors
+                    .in_context(context_id)
+                    .filter(|descriptor| descriptor.authority_id != owner)
+                    .filter_map(|descriptor| descriptor.device_id)
+                    .collect::<Vec<_>>();
+                devices.sort();
+                devices.dedup();
+                devices
+            }
+            None => state
+                .descriptors
+                .devices()
+                .filter(|(_, keys)| keys.iter().any(|(_, authority_id)| *authority_id != owner))
+                .map(|(device_id, _)| device_id)
+                .collect(),
+        }
     }
 
     pub async fn list_cached_devices_for_authority(
@@ -666,8 +665,7 @@ impl ServiceRegistryService {
             .read()
             .await
             .descriptors
-            .values()
-            .filter(|descriptor| descriptor.authority_id == authority_id)
+            .for_authority(authority_id)
             .filter(|descriptor| scope.map_or(true, |value| descriptor.context_id == value))
             .filter_map(|descriptor| descriptor.device_id)
             .collect::<Vec<_>>();
@@ -728,6 +726,38 @@ mod tests {
         assert!(registry.get_descriptor(ctx, expired).await.is_none());
     }
 
+    #[tokio::test]
+    async fn refresh_sweep_returns_only_own_contexts_in_window() {
+        let registry = ServiceRegistryService::new();
+        let owner = authority(1);
+        let peer = authority(2);
+        registry
+            .cache_descriptor(descriptor(owner, context(1), 1_000))
+            .await;
+        registry
+            .cache_descriptor(descriptor(owner, context(2), 5_000))
+            .await;
+        registry
+            .cache_descriptor(descriptor(peer, context(3), 1_000))
+            .await;
+
+        assert_eq!(
+            registry.contexts_needing_refresh(owner, 200, 0, 850).await,
+            vec![context(1)]
+        );
+        assert!(
+            !registry
+                .descriptor_needs_refresh(context(2), owner, 200, 0, 850)
+                .await
+        );
+        assert!(
+            registry
+                .descriptor_needs_refresh(context(4), owner, 200, 0, 850)
+                .await
+        );
+        assert_eq!(registry.list_cached_peers(owner, None).await, vec![peer]);
+    }
+
     #[tokio::test]
     async fn epoch_invalidation_prunes_scope_local_state() {
         let registry = ServiceRegistryService::new();
@@ -1143,6 +1143,14 @@ mod tests {
             Ok(facts.iter().any(|f| f.id == fact.id))
         }
 
+        async fn fact_inclusion_proof(
+            &self,
+            _fact: &IndexedFact,
+        ) -> Result<Option<aura_core::crypto::merkle::MerkleMountainRangeProof>, aura_core::AuraError>
+        {
+            Ok(None)
+        }
+
         async fn get_bloom_filter(&self) -> Result<BloomFilter, aura_core::AuraError> {
             BloomFilter::new(BloomConfig::for_sync(100))
         }
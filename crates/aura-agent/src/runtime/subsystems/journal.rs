@@ -138,7 +138,7 @@ impl JournalSubsystem {
         journal: &aura_core::Journal,
         authority: Option<aura_core::AuthorityId>,
         timestamp: Option<aura_core::time::TimeStamp>,
-    ) -> usize {
+    ) -> Result<usize, aura_core::AuraError> {
         let mut indexed_keys = self.shared.indexed_keys.lock();
         let mut added = 0usize;
 
@@ -148,12 +148,20 @@ impl JournalSubsystem {
                 continue;
             }
 
-            self.indexed_journal
-                .add_fact(key_owned, value.clone(), authority, timestamp.clone());
+            if let Err(error) = self.indexed_journal.add_fact(
+                key_owned.clone(),
+                value.clone(),
+                authority,
+                timestamp.clone(),
+            ) {
+                // Leave the key unmirrored so the next call retries it
+                indexed_keys.remove(&key_owned);
+                return Err(error);
+            }
             added += 1;
         }
 
-        added
+        Ok(added)
     }
 
     /// Get the fact registry
@@ -329,8 +337,12 @@ mod tests {
             )
             .unwrap();
 
-        let added_first = subsystem.index_new_journal_facts(&journal, None, None);
-        let added_second = subsystem.index_new_journal_facts(&journal, None, None);
+        let added_first = subsystem
+            .index_new_journal_facts(&journal, None, None)
+            .unwrap();
+        let added_second = subsystem
+            .index_new_journal_facts(&journal, None, None)
+            .unwrap();
         let stats = subsystem.indexed_journal().index_stats().await.unwrap();
 
         assert_eq!(added_first, 1);
@@ -34,6 +34,10 @@ use aura_core::{
     TimeoutRunError,
 };
 #[cfg(not(target_arch = "wasm32"))]
+use aura_effects::transport::mux::{
+    MultiplexedConnection, MuxConfig, MuxRole, MuxStream, MUX_PREFACE,
+};
+#[cfg(not(target_arch = "wasm32"))]
 use aura_protocol::{
     DecodedIngress, IngressSource, IngressVerificationEvidence, VerifiedIngress,
     VerifiedIngressMetadata,
@@ -126,6 +130,15 @@ impl LanIngressController {
     }
 }
 
+/// Stream limits for pooled LAN connections, shared by dialers and listeners.
+#[cfg(not(target_arch = "wasm32"))]
+pub(crate) fn lan_mux_config() -> MuxConfig {
+    MuxConfig {
+        max_frame_size: MAX_LAN_FRAME_BYTES as u32,
+        ..MuxConfig::default()
+    }
+}
+
 #[cfg(not(target_arch = "wasm32"))]
 fn lan_websocket_config() -> WebSocketConfig {
     WebSocketConfig {
@@ -943,6 +956,13 @@ pub(crate) fn spawn_lan_transport_listener_tasks(
                 let _connection_task =
                     connection_group.spawn_named(format!("tcp_connection.{addr}"), async move {
                         let _connection_permit = connection_permit;
+                        let ingress = LanFrameIngress {
+                            addr,
+                            effects,
+                            metrics,
+                            time_effects,
+                            ingress_controller,
+                        };
                         let mut len_buf = [0u8; 4];
                         if let Err(err) = stream.read_exact(&mut len_buf).await {
                             tracing::debug!(
@@ -950,17 +970,17 @@ pub(crate) fn spawn_lan_transport_listener_tasks(
                                 addr = %addr,
                                 "LAN transport read len failed"
                             );
-                            let now_ms = time_effects
-                                .physical_time()
-                                .await
-                                .ok()
-                                .map(|t| t.ts_ms)
-                                .unwrap_or(0);
-                            let mut metrics = metrics.write().await;
-                            metrics.read_errors = metrics.read_errors.saturating_add(1);
-                            if now_ms > 0 {
-                                metrics.last_error_ms = now_ms;
-                            }
+                            ingress
+                                .record_error(|metrics| {
+                                    metrics.read_errors = metrics.read_errors.saturating_add(1);
+                                })
+                                .await;
+                            return;
+                        }
+                        // The mux preface decodes to a length far above the frame
+                        // bound, so it cannot be mistaken for a single-envelope frame
+                        if len_buf[..] == MUX_PREFACE[..len_buf.len()] {
+                            serve_multiplexed_lan_connection(stream, &ingress).await;
                             return;
                         }
                         let len = u32::from_be_bytes(len_buf) as usize;
@@ -971,17 +991,12 @@ pub(crate) fn spawn_lan_transport_listener_tasks(
                                 max_len = MAX_LAN_FRAME_BYTES,
                                 "LAN transport invalid frame size"
                             );
-                            let now_ms = time_effects
-                                .physical_time()
-                                .await
-                                .ok()
-                                .map(|t| t.ts_ms)
-                                .unwrap_or(0);
-                            let mut metrics = metrics.write().await;
-                            metrics.frames_rejected = metrics.frames_rejected.saturating_add(1);
-                            if now_ms > 0 {
-                                metrics.last_error_ms = now_ms;
-                            }
+                            ingress
+                                .record_error(|metrics| {
+                                    metrics.frames_rejected =
+                                        metrics.frames_rejected.saturating_add(1);
+                                })
+                                .await;
                             return;
                         }
                         let mut payload = vec![0u8; len];
@@ -991,73 +1006,15 @@ pub(crate) fn spawn_lan_transport_listener_tasks(
                                 addr = %addr,
                                 "LAN transport read payload failed"
                             );
-                            let now_ms = time_effects
-                                .physical_time()
-                                .await
-                                .ok()
-                                .map(|t| t.ts_ms)
-                                .unwrap_or(0);
-                            let mut metrics = metrics.write().await;
-                            metrics.read_errors = metrics.read_errors.saturating_add(1);
-                            if now_ms > 0 {
-                                metrics.last_error_ms = now_ms;
-                            }
-                            return;
-                        }
-
-                        let now_ms = time_effects
-                            .physical_time()
-                            .await
-                            .ok()
-                            .map(|t| t.ts_ms)
-                            .unwrap_or(0);
-                        if !ingress_controller.allow_frame(addr.ip(), now_ms).await {
-                            tracing::warn!(
-                                addr = %addr,
-                                per_peer_limit = MAX_LAN_FRAMES_PER_PEER_WINDOW,
-                                window_ms = LAN_PEER_RATE_WINDOW_MS,
-                                "LAN transport rate-limited inbound frame"
-                            );
-                            let mut metrics = metrics.write().await;
-                            metrics.frames_rejected = metrics.frames_rejected.saturating_add(1);
-                            if now_ms > 0 {
-                                metrics.last_error_ms = now_ms;
-                            }
+                            ingress
+                                .record_error(|metrics| {
+                                    metrics.read_errors = metrics.read_errors.saturating_add(1);
+                                })
+                                .await;
                             return;
                         }
 
-                        let envelope = match aura_core::util::serialization::from_slice(&payload) {
-                            Ok(envelope) => envelope,
-                            Err(err) => {
-                                tracing::debug!(
-                                    error = %err,
-                                    addr = %addr,
-                                    "LAN transport decode failed"
-                                );
-                                let now_ms = time_effects
-                                    .physical_time()
-                                    .await
-                                    .ok()
-                                    .map(|t| t.ts_ms)
-                                    .unwrap_or(0);
-                                let mut metrics = metrics.write().await;
-                                metrics.decode_errors = metrics.decode_errors.saturating_add(1);
-                                if now_ms > 0 {
-                                    metrics.last_error_ms = now_ms;
-                                }
-                                return;
-                            }
-                        };
-                        {
-                            let mut metrics = metrics.write().await;
-                            metrics.frames_received = metrics.frames_received.saturating_add(1);
-                            metrics.bytes_received = metrics.bytes_received.saturating_add(len as u64);
-                            if now_ms > 0 {
-                                metrics.last_frame_ms = now_ms;
-                            }
-                        }
-
-                        let _ = handle_inbound_transport_envelope(effects, metrics, envelope).await;
+                        ingress.process_frame(&payload).await;
                     });
             }
         });
@@ -1264,6 +1221,144 @@ pub(crate) fn spawn_lan_transport_listener_tasks(
         });
 }
 
+/// Per-connection context for decoding and dispatching inbound LAN frames.
+#[cfg(not(target_arch = "wasm32"))]
+struct LanFrameIngress {
+    addr: std::net::SocketAddr,
+    effects: Arc<AuraEffectSystem>,
+    metrics: Arc<tokio::sync::RwLock<LanTransportMetrics>>,
+    time_effects: Arc<dyn PhysicalTimeEffects + Send + Sync>,
+    ingress_controller: LanIngressController,
+}
+
+#[cfg(not(target_arch = "wasm32"))]
+impl LanFrameIngress {
+    async fn now_ms(&self) -> u64 {
+        self.time_effects
+            .physical_time()
+            .await
+            .ok()
+            .map(|t| t.ts_ms)
+            .unwrap_or(0)
+    }
+
+    async fn record_error(&self, update: impl FnOnce(&mut LanTransportMetrics)) {
+        let now_ms = self.now_ms().await;
+        let mut metrics = self.metrics.write().await;
+        update(&mut metrics);
+        if now_ms > 0 {
+            metrics.last_error_ms = now_ms;
+        }
+    }
+
+    /// Rate-limit, decode and dispatch one envelope frame.
+    async fn process_frame(&self, payload: &[u8]) {
+        let addr = self.addr;
+        let now_ms = self.now_ms().await;
+        if !self.ingress_controller.allow_frame(addr.ip(), now_ms).await {
+            tracing::warn!(
+                addr = %addr,
+                per_peer_limit = MAX_LAN_FRAMES_PER_PEER_WINDOW,
+                window_ms = LAN_PEER_RATE_WINDOW_MS,
+                "LAN transport rate-limited inbound frame"
+            );
+            let mut metrics = self.metrics.write().await;
+            metrics.frames_rejected = metrics.frames_rejected.saturating_add(1);
+            if now_ms > 0 {
+                metrics.last_error_ms = now_ms;
+            }
+            return;
+        }
+
+        let envelope = match aura_core::util::serialization::from_slice(payload) {
+            Ok(envelope) => envelope,
+            Err(err) => {
+                tracing::debug!(
+                    error = %err,
+                    addr = %addr,
+                    "LAN transport decode failed"
+                );
+                self.record_error(|metrics| {
+                    metrics.decode_errors = metrics.decode_errors.saturating_add(1);
+                })
+                .await;
+                return;
+            }
+        };
+        {
+            let mut metrics = self.metrics.write().await;
+            metrics.frames_received = metrics.frames_received.saturating_add(1);
+            metrics.bytes_received = metrics.bytes_received.saturating_add(payload.len() as u64);
+            if now_ms > 0 {
+                metrics.last_frame_ms = now_ms;
+            }
+        }
+
+        let _ =
+            handle_inbound_transport_envelope(self.effects.clone(), self.metrics.clone(), envelope)
+                .await;
+    }
+}
+
+/// Serve a pooled sender's connection: every stream frame is one envelope.
+#[cfg(not(target_arch = "wasm32"))]
+async fn serve_multiplexed_lan_connection(
+    mut stream: tokio::net::TcpStream,
+    ingress: &LanFrameIngress,
+) {
+    let mut rest = [0u8; MUX_PREFACE.len() - 4];
+    let preface_ok = stream.read_exact(&mut rest).await.is_ok() && rest[..] == MUX_PREFACE[4..];
+    if !preface_ok {
+        tracing::debug!(addr = %ingress.addr, "LAN transport invalid mux preface");
+        ingress
+            .record_error(|metrics| {
+                metrics.frames_rejected = metrics.frames_rejected.saturating_add(1);
+            })
+            .await;
+        return;
+    }
+    let (connection, driver) = match MultiplexedConnection::new(
+        stream,
+        MuxRole::Acceptor,
+        &lan_mux_config(),
+    ) {
+        Ok(multiplexed) => multiplexed,
+        Err(err) => {
+            tracing::debug!(error = %err, addr = %ingress.addr, "LAN transport mux setup failed");
+            ingress
+                .record_error(|metrics| {
+                    metrics.read_errors = metrics.read_errors.saturating_add(1);
+                })
+                .await;
+            return;
+        }
+    };
+
+    // Drain streams concurrently so one long-lived stream cannot stall the rest
+    let serve_streams = async move {
+        let mut streams = futures::stream::FuturesUnordered::new();
+        loop {
+            tokio::select! {
+                accepted = connection.accept_stream() => match accepted {
+                    Some(inbound) => streams.push(drain_lan_stream(inbound, ingress)),
+                    None => break,
+                },
+                Some(()) = streams.next(), if !streams.is_empty() => {}
+            }
+        }
+        while streams.next().await.is_some() {}
+    };
+    // The driver returns once `serve_streams` has dropped the connection
+    tokio::join!(driver.run(), serve_streams);
+}
+
+#[cfg(not(target_arch = "wasm32"))]
+async fn drain_lan_stream(mut inbound: MuxStream, ingress: &LanFrameIngress) {
+    while let Some(payload) = inbound.recv().await {
+        ingress.process_frame(&payload).await;
+    }
+}
+
 #[cfg(not(target_arch = "wasm32"))]
 async fn handle_inbound_transport_envelope(
     effects: Arc<AuraEffectSystem>,
@@ -23,6 +23,13 @@ impl RuntimeSystem {
             .await
             .map_err(|e| ServiceError::startup_failed("authority_manager", e.to_string()))?;
 
+        // Pooled TCP connections dialed from here on run their I/O under the
+        // runtime task tree.
+        #[cfg(not(target_arch = "wasm32"))]
+        self.effect_system
+            .tcp_connection_pool()
+            .attach_tasks(self.runtime_tasks.group("tcp_connection_pool"));
+
         let time_effects: Arc<dyn PhysicalTimeEffects + Send + Sync> =
             Arc::new(self.effect_system.time_effects().clone());
         let service_context = RuntimeServiceContext::new(self.runtime_tasks.clone(), time_effects);
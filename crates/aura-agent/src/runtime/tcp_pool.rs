@@ -0,0 +1,389 @@
+//! Per-peer pool of multiplexed TCP connections.
+//!
+//! Direct envelope delivery used to dial a fresh socket per envelope, so
+//! anti-entropy rounds, receipts and rendezvous messages all paid TCP setup
+//! on top of the Aura handshake. The pool keeps [`MultiplexedConnection`]s
+//! keyed by the address that rendezvous path selection resolved, and each
+//! send opens a short-lived stream on one of them:
+//! - **Reuse**: the least-loaded live connection with a free stream slot
+//!   carries the next stream, so concurrent sessions share one socket.
+//! - **Back-pressure**: up to `max_connections_per_peer` sockets are dialed
+//!   per address; once every stream slot is taken, callers wait for one.
+//! - **Idle timeout**: connections without open streams for `idle_timeout`
+//!   are dropped on the next checkout or [`TcpConnectionPool::prune`].
+//! - **Health checks**: [`TcpConnectionPool::health_check`] heartbeats each
+//!   pooled connection and drops the ones that miss `health_check_timeout`.
+//!   The maintenance service runs it with `prune` every
+//!   `maintenance_interval`.
+//!
+//! Each dialed connection's socket I/O runs as a named task in the group
+//! attached with [`TcpConnectionPool::attach_tasks`], so it is owned and
+//! cancelled with the rest of the runtime's tasks.
+
+use crate::runtime::TaskGroup;
+use aura_effects::transport::mux::{MultiplexedConnection, MuxConfig, MuxStream};
+use aura_effects::transport::{TransportError, TransportSocketAddr};
+use aura_effects::TcpTransportHandler;
+use futures::future::join_all;
+use std::collections::HashMap;
+use std::net::SocketAddr;
+use std::num::NonZeroUsize;
+use std::sync::Arc;
+use std::time::Duration;
+use tokio::sync::Mutex;
+
+/// Connections to one peer address, locked while dialing so concurrent
+/// first sends share one handshake.
+type PeerConnections = Arc<Mutex<Vec<MultiplexedConnection>>>;
+
+/// Pool sizing and liveness policy.
+#[derive(Debug, Clone)]
+pub struct TcpConnectionPoolConfig {
+    /// Sockets dialed per peer address before callers wait for a stream slot
+    pub max_connections_per_peer: NonZeroUsize,
+    /// How long a connection may sit without open streams before it is dropped
+    pub idle_timeout: Duration,
+    /// Deadline for a heartbeat round trip during health checks
+    pub health_check_timeout: Duration,
+    /// Cadence of the runtime's prune and health-check pass
+    pub maintenance_interval: Duration,
+    /// Per-connection stream and frame limits
+    pub mux: MuxConfig,
+}
+
+impl Default for TcpConnectionPoolConfig {
+    #[allow(clippy::expect_used)] // Default pool limits are compile-time non-zero values.
+    fn default() -> Self {
+        Self {
+            max_connections_per_peer: NonZeroUsize::new(4)
+                .expect("connection limit should be non-zero"),
+            idle_timeout: Duration::from_secs(60),
+            health_check_timeout: Duration::from_secs(5),
+            maintenance_interval: Duration::from_secs(30),
+            mux: super::system::lan_mux_config(),
+        }
+    }
+}
+
+/// Shared pool of multiplexed TCP connections keyed by peer address.
+#[derive(Debug, Clone)]
+pub struct TcpConnectionPool {
+    shared: Arc<PoolShared>,
+}
+
+struct PoolShared {
+    config: TcpConnectionPoolConfig,
+    transport: TcpTransportHandler,
+    peers: Mutex<HashMap<SocketAddr, PeerConnections>>,
+    /// Runs the drivers of dialed connections
+    tasks: parking_lot::RwLock<Option<TaskGroup>>,
+}
+
+impl std::fmt::Debug for PoolShared {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("PoolShared")
+            .field("config", &self.config)
+            .field("transport", &self.transport)
+            .field("peers", &self.peers)
+            .field("tasks_attached", &self.tasks.read().is_some())
+            .finish()
+    }
+}
+
+impl TcpConnectionPool {
+    /// Create an empty pool.
+    pub fn new(config: TcpConnectionPoolConfig) -> Self {
+        Self {
+            shared: Arc::new(PoolShared {
+                config,
+                transport: TcpTransportHandler::default(),
+                peers: Mutex::new(HashMap::new()),
+                tasks: parking_lot::RwLock::new(None),
+            }),
+        }
+    }
+
+    /// Hand the pool the task group that runs its connections' I/O.
+    ///
+    /// Until a group is attached the pool cannot dial new connections.
+    pub fn attach_tasks(&self, tasks: TaskGroup) {
+        *self.shared.tasks.write() = Some(tasks);
+    }
+
+    /// Pool policy.
+    pub fn config(&self) -> &TcpConnectionPoolConfig {
+        &self.shared.config
+    }
+
+    /// Open a stream to `addr`, reusing a pooled connection when one has room.
+    pub async fn open_stream(&self, addr: SocketAddr) -> Result<MuxStream, TransportError> {
+        let peer = self.peer(addr).await;
+        let mut connections = peer.lock().await;
+        connections.retain(|connection| self.is_reusable(connection));
+
+        let least_loaded = connections
+            .iter()
+            .min_by_key(|connection| connection.open_stream_count())
+            .cloned();
+        if let Some(stream) = least_loaded
+            .as_ref()
+            .and_then(MultiplexedConnection::try_open_stream)
+        {
+            return stream;
+        }
+
+        if connections.len() < self.shared.config.max_connections_per_peer.get() {
+            let Some(tasks) = self.shared.tasks.read().clone() else {
+                return Err(TransportError::ConnectionFailed(
+                    "TCP connection pool has no task group attached".to_string(),
+                ));
+            };
+            let (connection, driver) = self
+                .shared
+                .transport
+                .connect_multiplexed(TransportSocketAddr::from(addr), &self.shared.config.mux)
+                .await?;
+            let _driver_task_handle = tasks.spawn_named("tcp_pool_connection", driver.run());
+            connections.push(connection.clone());
+            drop(connections);
+            return connection.open_stream().await;
+        }
+        drop(connections);
+
+        // Every pooled connection is full; wait for a slot on the least loaded
+        let Some(connection) = least_loaded else {
+            return Err(TransportError::ConnectionFailed(format!(
+                "No pooled connection available for {addr}"
+            )));
+        };
+        connection.open_stream().await
+    }
+
+    /// Number of pooled connections to `addr`.
+    pub async fn connection_count(&self, addr: SocketAddr) -> usize {
+        match self.shared.peers.lock().await.get(&addr).cloned() {
+            Some(peer) => peer.lock().await.len(),
+            None => 0,
+        }
+    }
+
+    /// Drop closed and idle connections; returns how many were removed.
+    pub async fn prune(&self) -> usize {
+        let mut removed = 0;
+        for (addr, peer) in self.peer_snapshot().await {
+            let mut connections = peer.lock().await;
+            let before = connections.len();
+            connections.retain(|connection| self.is_reusable(connection));
+            removed += before - connections.len();
+            if connections.is_empty() {
+                drop(connections);
+                self.forget_if_empty(addr, &peer).await;
+            }
+        }
+        removed
+    }
+
+    /// Heartbeat every pooled connection and drop the ones that fail;
+    /// returns how many were removed.
+    pub async fn health_check(&self) -> usize {
+        let deadline = self.shared.config.health_check_timeout;
+        let mut removed = 0;
+        for (addr, peer) in self.peer_snapshot().await {
+            // Probe outside the peer lock so sends are not held up
+            let connections = peer.lock().await.clone();
+            let results = join_all(
+                connections
+                    .iter()
+                    .map(|connection| connection.health_check(deadline)),
+            )
+            .await;
+            let failed: Vec<&MultiplexedConnection> = connections
+                .iter()
+                .zip(results)
+                .filter_map(|(connection, result)| result.is_err().then_some(connection))
+                .collect();
+
+            let mut pooled = peer.lock().await;
+            let before = pooled.len();
+            pooled.retain(|connection| !failed.iter().any(|dead| dead.ptr_eq(connection)));
+            removed += before - pooled.len();
+            if pooled.is_empty() {
+                drop(pooled);
+                self.forget_if_empty(addr, &peer).await;
+            }
+        }
+        removed
+    }
+
+    fn is_reusable(&self, connection: &MultiplexedConnection) -> bool {
+        !connection.is_closed()
+            && connection
+                .idle_for()
+                .map_or(true, |idle| idle < self.shared.config.idle_timeout)
+    }
+
+    async fn peer(&self, addr: SocketAddr) -> PeerConnections {
+        self.shared
+            .peers
+            .lock()
+            .await
+            .entry(addr)
+            .or_default()
+            .clone()
+    }
+
+    async fn peer_snapshot(&self) -> Vec<(SocketAddr, PeerConnections)> {
+        self.shared
+            .peers
+            .lock()
+            .await
+            .iter()
+            .map(|(addr, peer)| (*addr, peer.clone()))
+            .collect()
+    }
+
+    async fn forget_if_empty(&self, addr: SocketAddr, peer: &PeerConnections) {
+        let mut peers = self.shared.peers.lock().await;
+        let still_empty = match peer.try_lock() {
+            Ok(connections) => connections.is_empty(),
+            Err(_) => false,
+        };
+        if still_empty
+            && peers
+                .get(&addr)
+                .is_some_and(|entry| Arc::ptr_eq(entry, peer))
+        {
+            peers.remove(&addr);
+        }
+    }
+}
+
+impl Default for TcpConnectionPool {
+    fn default() -> Self {
+        Self::new(TcpConnectionPoolConfig::default())
+    }
+}
+
+#[cfg(test)]
+#[allow(clippy::expect_used)]
+mod tests {
+    use super::*;
+    use crate::runtime::TaskSupervisor;
+    use aura_effects::transport::mux::MuxDriver;
+    use futures::stream::{FuturesUnordered, StreamExt};
+    use std::future::Future;
+    use tokio::net::TcpListener;
+
+    /// Run `body` against an echo server on a fresh local listener.
+    async fn with_echo_server<F, Fut>(body: F)
+    where
+        F: FnOnce(SocketAddr) -> Fut,
+        Fut: Future<Output = ()>,
+    {
+        let listener = TcpListener::bind("127.0.0.1:0").await.expect("bind");
+        let addr = listener.local_addr().expect("listener addr");
+        let finished = tokio::select! {
+            () = body(addr) => true,
+            () = serve_echo(listener) => false,
+        };
+        assert!(finished, "echo server stopped before the test finished");
+    }
+
+    async fn serve_echo(listener: TcpListener) {
+        let transport = TcpTransportHandler::default();
+        let config = MuxConfig::default();
+        let mut connections = FuturesUnordered::new();
+        loop {
+            tokio::select! {
+                accepted = transport.accept_multiplexed(&listener, &config) => match accepted {
+                    Ok((connection, driver)) => {
+                        connections.push(echo_connection(connection, driver));
+                    }
+                    Err(_) => break,
+                },
+                Some(()) = connections.next(), if !connections.is_empty() => {}
+            }
+        }
+    }
+
+    async fn echo_connection(connection: MultiplexedConnection, driver: MuxDriver) {
+        let echo_streams = async move {
+            let mut streams = FuturesUnordered::new();
+            loop {
+                tokio::select! {
+                    accepted = connection.accept_stream() => match accepted {
+                        Some(stream) => streams.push(echo_stream(stream)),
+                        None => break,
+                    },
+                    Some(()) = streams.next(), if !streams.is_empty() => {}
+                }
+            }
+        };
+        tokio::join!(driver.run(), echo_streams);
+    }
+
+    async fn echo_stream(mut stream: MuxStream) {
+        while let Some(payload) = stream.recv().await {
+            let _ = stream.send(payload).await;
+        }
+    }
+
+    fn attached_pool(tasks: &TaskSupervisor, config: TcpConnectionPoolConfig) -> TcpConnectionPool {
+        let pool = TcpConnectionPool::new(config);
+        pool.attach_tasks(tasks.group("tcp_connection_pool"));
+        pool
+    }
+
+    #[tokio::test]
+    async fn sequential_and_concurrent_sends_reuse_one_socket() {
+        let tasks = TaskSupervisor::new();
+        let pool = attached_pool(&tasks, TcpConnectionPoolConfig::default());
+        with_echo_server(|addr| async move {
+            for round in 0..3u8 {
+                let mut stream = pool.open_stream(addr).await.expect("pooled stream");
+                stream.send(vec![round]).await.expect("send");
+                assert_eq!(stream.recv().await.as_deref(), Some(&[round][..]));
+            }
+            let first = pool.open_stream(addr).await.expect("first concurrent");
+            let second = pool.open_stream(addr).await.expect("second concurrent");
+            assert_ne!(first.id(), second.id());
+            assert_eq!(pool.connection_count(addr).await, 1);
+
+            drop((first, second));
+            assert_eq!(pool.health_check().await, 0);
+            assert_eq!(pool.prune().await, 0);
+        })
+        .await;
+    }
+
+    #[tokio::test]
+    async fn idle_connections_are_pruned() {
+        let tasks = TaskSupervisor::new();
+        let pool = attached_pool(
+            &tasks,
+            TcpConnectionPoolConfig {
+                idle_timeout: Duration::from_millis(20),
+                ..TcpConnectionPoolConfig::default()
+            },
+        );
+        with_echo_server(|addr| async move {
+            drop(pool.open_stream(addr).await.expect("stream"));
+            assert_eq!(pool.connection_count(addr).await, 1);
+            tokio::time::sleep(Duration::from_millis(40)).await;
+
+            assert_eq!(pool.prune().await, 1);
+            assert_eq!(pool.connection_count(addr).await, 0);
+        })
+        .await;
+    }
+
+    #[tokio::test]
+    async fn dialing_requires_an_attached_task_group() {
+        let pool = TcpConnectionPool::new(TcpConnectionPoolConfig::default());
+        with_echo_server(|addr| async move {
+            assert!(pool.open_stream(addr).await.is_err());
+            assert_eq!(pool.connection_count(addr).await, 0);
+        })
+        .await;
+    }
+}
@@ -11,11 +11,14 @@ use aura_core::effects::{JournalEffects, OrderClockEffects};
 use aura_core::hash::hash;
 use aura_core::time::{OrderTime, TimeStamp};
 use aura_core::types::identifiers::{AuthorityId, ChannelId, ContextId};
-use aura_core::{AuraError, FactValue, Journal, Result};
+use aura_core::{AuraError, FactRevision, FactValue, Journal, Result};
 use aura_journal::{
     fact::{Fact, FactContent, JournalNamespace, RelationalFact},
-    reduce_context, ChannelEpochState, DomainFact, FactJournal, ProtocolRelationalFact,
+    reduce_context_ref, ChannelEpochState, DomainFact, FactJournal, IncrementalContextReducer,
+    ProtocolRelationalFact,
 };
+use std::collections::{HashMap, HashSet};
+use std::sync::Mutex;
 
 // ============================================================================
 // AmpJournalEffects Trait
@@ -99,15 +102,124 @@ pub async fn get_channel_state<A: AmpJournalEffects>(
     channel: ChannelId,
 ) -> Result<ChannelEpochState> {
     let journal = effects.fetch_context_journal(context).await?;
-    let state = reduce_context(&journal)
+    let mut state = reduce_context_ref(&journal)
         .map_err(|e| AuraError::internal(format!("context reduction failed: {e}")))?;
     state
         .channel_epochs
-        .get(&channel)
-        .cloned()
+        .remove(&channel)
         .ok_or_else(|| AuraError::not_found("channel state not found"))
 }
 
+/// Per-context incremental reducers for repeated channel state reads.
+///
+/// `get_channel_state` re-reduces the whole context journal on every call.
+/// Services that read channel state repeatedly can hold a cache instead. Each
+/// context keeps a cursor into the core journal: the fact revision it last
+/// caught up to and the journal keys it has already decoded. A read against
+/// an unchanged journal touches no facts, and a read after a merge decodes
+/// and reduces only the facts merged since the previous one.
+#[derive(Debug, Default)]
+pub struct ChannelStateCache {
+    contexts: Mutex<HashMap<ContextId, CachedContext>>,
+}
+
+/// Cursor and reduction state for one context.
+#[derive(Debug)]
+struct CachedContext {
+    reducer: IncrementalContextReducer,
+    /// Context facts decoded so far
+    journal: FactJournal,
+    /// Core journal keys already decoded, whether or not they held a fact
+    /// for this context. Fact keys carry their order token, so each key is
+    /// written once.
+    decoded_keys: HashSet<String>,
+    /// Core fact revision the context was last caught up to
+    revision: Option<FactRevision>,
+}
+
+impl CachedContext {
+    fn new(context: ContextId) -> Self {
+        Self {
+            reducer: IncrementalContextReducer::new(context),
+            journal: FactJournal {
+                namespace: JournalNamespace::Context(context),
+                facts: std::collections::BTreeSet::new(),
+            },
+            decoded_keys: HashSet::new(),
+            revision: None,
+        }
+    }
+
+    /// Decode and reduce the core journal facts past the cursor.
+    fn catch_up(
+        &mut self,
+        context: ContextId,
+        core: &Journal,
+    ) -> Result<&aura_journal::RelationalState> {
+        let revision = core.read_facts().revision();
+        let mut fresh = Vec::new();
+        if self.revision.as_ref() != Some(&revision) {
+            for (key, value) in core.read_facts().iter() {
+                if self.decoded_keys.contains(key.as_str()) {
+                    continue;
+                }
+                self.decoded_keys.insert(key.as_str().to_string());
+                let Some(fact) = decode_fact_content(value).and_then(|content| {
+                    context_fact(context, parse_order_from_key(key.as_str()), content)
+                }) else {
+                    continue;
+                };
+                if self.journal.facts.insert(fact.clone()) {
+                    fresh.push(fact);
+                }
+            }
+            self.revision = Some(revision);
+        }
+
+        self.reducer
+            .apply_facts(&self.journal, &fresh)
+            .map_err(|e| AuraError::internal(format!("context reduction failed: {e}")))
+    }
+}
+
+impl ChannelStateCache {
+    /// Create an empty cache.
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Reduce to AMP channel state for a (context, channel) pair, reusing
+    /// the context's cached reduction.
+    pub async fn get_channel_state<A: AmpJournalEffects>(
+        &self,
+        effects: &A,
+        context: ContextId,
+        channel: ChannelId,
+    ) -> Result<ChannelEpochState> {
+        let core = effects.get_journal().await?;
+        let mut contexts = self
+            .contexts
+            .lock()
+            .map_err(|_| AuraError::internal("channel state cache lock poisoned"))?;
+        let state = contexts
+            .entry(context)
+            .or_insert_with(|| CachedContext::new(context))
+            .catch_up(context, &core)?;
+        state
+            .channel_epochs
+            .get(&channel)
+            .cloned()
+            .ok_or_else(|| AuraError::not_found("channel state not found"))
+    }
+
+    /// Drop the cached reduction for a context, e.g. after journal compaction.
+    pub fn invalidate(&self, context: ContextId) {
+        if let Ok(mut contexts) = self.contexts.lock() {
+            contexts.remove(&context);
+        }
+    }
+}
+
 /// Reduce the current AMP channel participants for a `(context, channel)` pair.
 pub async fn list_channel_participants<A: AmpJournalEffects>(
     effects: &A,
@@ -196,19 +308,23 @@ fn extract_fact_contents(journal: &Journal) -> Vec<(Option<OrderTime>, FactConte
         .read_facts()
         .iter()
         .filter_map(|(key, value)| {
-            let content = match value {
-                FactValue::Bytes(bytes) => serde_json::from_slice(bytes).ok(),
-                FactValue::String(text) => serde_json::from_str(text).ok(),
-                FactValue::Nested(nested) => serde_json::to_vec(nested)
-                    .ok()
-                    .and_then(|bytes| serde_json::from_slice(&bytes).ok()),
-                _ => None,
-            };
-            content.map(|content| (parse_order_from_key(key.as_str()), content))
+            decode_fact_content(value).map(|content| (parse_order_from_key(key.as_str()), content))
         })
         .collect()
 }
 
+/// Decode one core journal value as fact content, if it holds one.
+fn decode_fact_content(value: &FactValue) -> Option<FactContent> {
+    match value {
+        FactValue::Bytes(bytes) => serde_json::from_slice(bytes).ok(),
+        FactValue::String(text) => serde_json::from_str(text).ok(),
+        FactValue::Nested(nested) => serde_json::to_vec(nested)
+            .ok()
+            .and_then(|bytes| serde_json::from_slice(&bytes).ok()),
+        _ => None,
+    }
+}
+
 /// Parse an order time from a journal key suffix.
 fn parse_order_from_key(key: &str) -> Option<OrderTime> {
     let suffix = key.rsplit(':').next()?;
@@ -221,25 +337,35 @@ fn parse_order_from_key(key: &str) -> Option<OrderTime> {
     Some(OrderTime(order))
 }
 
+/// Wrap decoded content as a journal fact if it is relational and belongs to
+/// `context`.
+fn context_fact(
+    context: ContextId,
+    order_hint: Option<OrderTime>,
+    content: FactContent,
+) -> Option<Fact> {
+    let FactContent::Relational(ref relational) = content else {
+        return None;
+    };
+    if fact_context(relational).ok() != Some(context) {
+        return None;
+    }
+
+    let bytes = serde_json::to_vec(&content).unwrap_or_default();
+    let order = order_hint.unwrap_or_else(|| OrderTime(hash(&bytes)));
+    let timestamp = TimeStamp::OrderClock(order.clone());
+    Some(Fact::new(order, timestamp, content))
+}
+
 /// Build a context-scoped fact journal from extracted contents.
 fn build_context_journal(
     context: ContextId,
     contents: Vec<(Option<OrderTime>, FactContent)>,
 ) -> FactJournal {
-    let mut facts = std::collections::BTreeSet::new();
-
-    for (order_hint, content) in contents {
-        if let FactContent::Relational(ref relational) = content {
-            if fact_context(relational).ok() != Some(context) {
-                continue;
-            }
-
-            let bytes = serde_json::to_vec(&content).unwrap_or_default();
-            let order = order_hint.unwrap_or_else(|| OrderTime(hash(&bytes)));
-            let timestamp = TimeStamp::OrderClock(order.clone());
-            facts.insert(Fact::new(order, timestamp, content));
-        }
-    }
+    let facts = contents
+        .into_iter()
+        .filter_map(|(order_hint, content)| context_fact(context, order_hint, content))
+        .collect();
 
     FactJournal {
         namespace: JournalNamespace::Context(context),
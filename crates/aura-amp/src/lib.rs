@@ -53,6 +53,7 @@ pub mod wire;
 
 pub use journal::{
     get_channel_state, list_channel_participants, AmpContextStore, AmpJournalEffects,
+    ChannelStateCache,
 };
 
 // ============================================================================
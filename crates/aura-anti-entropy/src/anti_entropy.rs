@@ -9,6 +9,7 @@ use super::pure;
 use async_lock::RwLock;
 use aura_core::effects::time::PhysicalTimeEffects;
 use aura_core::effects::TransportEffects;
+use aura_core::latency::{self, LatencyStage};
 use aura_core::tree::verification::{check_attested_op, extract_target_node};
 use aura_core::tree::{Epoch, NodeIndex, TreeHash32};
 use aura_core::types::identifiers::{AuthorityId, ContextId, DeviceId};
@@ -162,11 +163,13 @@ impl AntiEntropyHandler {
         remote: &BloomDigest,
     ) -> Result<Vec<AttestedOp>, SyncError> {
         let state = self.state.read().await;
+        let _latency = latency::span(LatencyStage::AntiEntropyPlan);
         pure::compute_ops_to_push(&state.oplog, local, remote)
     }
 
     /// Compute which CIDs we should pull from peer
     fn compute_cids_to_pull(&self, local: &BloomDigest, remote: &BloomDigest) -> Vec<Hash32> {
+        let _latency = latency::span(LatencyStage::AntiEntropyPlan);
         pure::compute_cids_to_pull(local, remote)
             .into_iter()
             .collect()
@@ -308,6 +311,7 @@ impl AntiEntropyHandler {
     /// Get digest of local OpLog.
     pub async fn get_oplog_digest(&self) -> Result<BloomDigest, SyncError> {
         let state = self.state.read().await;
+        let _latency = latency::span(LatencyStage::AntiEntropyDigest);
         let cids: BTreeSet<Hash32> = state
             .oplog
             .iter()
@@ -331,6 +335,7 @@ impl AntiEntropyHandler {
         &self,
         ops: VerifiedIngress<Vec<AttestedOp>>,
     ) -> Result<(), SyncError> {
+        let _latency = latency::span(LatencyStage::AntiEntropyMerge);
         let (ops, _) = ops.into_parts();
         let anchor = self.verification_anchor.read().await.clone();
         let mut state = self.state.write().await;
@@ -2,18 +2,47 @@
 //!
 //! Implements operation broadcast with rate limiting, back pressure handling,
 //! and configurable eager push to neighbors and lazy pull on request.
+//!
+//! ## Plumtree Mode
+//!
+//! [`BroadcastMode::Flood`] pushes every op to every peer, so each node
+//! receives one copy per neighbor. [`BroadcastMode::Plumtree`] splits peers
+//! into eager and lazy sets whose eager edges form a spanning tree:
+//! - ops are pushed to eager peers and announced to lazy peers with IHAVE;
+//! - a duplicate op demotes its sender to lazy and answers with PRUNE;
+//! - an announced op that does not arrive within `graft_timeout_ms` is
+//!   requested with GRAFT, which promotes the announcer back to eager and is
+//!   answered through `lazy_pull_response`.
+//!
+//! The handler does not read the network itself. The caller decodes incoming
+//! [`SyncWireMessage`]s, feeds them to the `handle_*` methods and drives
+//! [`BroadcasterHandler::expire_missing`] from its own clock, which keeps the
+//! protocol deterministic under simulated time.
 
 use super::effects::{BloomDigest, SyncEffects, SyncError, SyncMetrics};
 use async_lock::RwLock;
 use async_trait::async_trait;
 use aura_core::effects::NetworkEffects;
+use aura_core::latency::{self, LatencyStage};
 use aura_core::types::identifiers::{ContextId, DeviceId};
 use aura_core::{tree::AttestedOp, Hash32};
 use aura_guards::VerifiedIngress;
+
+use crate::wire::{serialize_message, SyncWireMessage};
 use std::collections::VecDeque;
 use std::collections::{BTreeMap, BTreeSet};
 use std::sync::Arc;
 
+/// Dissemination strategy for new operations
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub enum BroadcastMode {
+    /// Push every op to every eligible peer
+    #[default]
+    Flood,
+    /// Push along a spanning tree and announce to the remaining peers
+    Plumtree,
+}
+
 /// Configuration for broadcast behavior
 #[derive(Debug, Clone)]
 pub struct BroadcastConfig {
@@ -27,6 +56,10 @@ pub struct BroadcastConfig {
     pub lazy_pull_enabled: bool,
     /// Maximum number of ops to keep in the in-memory oplog cache
     pub max_oplog_entries: usize,
+    /// Dissemination strategy
+    pub mode: BroadcastMode,
+    /// Plumtree: time to wait for an announced op before grafting (ms)
+    pub graft_timeout_ms: u64,
 }
 
 impl Default for BroadcastConfig {
@@ -37,6 +70,8 @@ impl Default for BroadcastConfig {
             eager_push_enabled: true,
             lazy_pull_enabled: true,
             max_oplog_entries: 10_000,
+            mode: BroadcastMode::Flood,
+            graft_timeout_ms: 500,
         }
     }
 }
@@ -69,6 +104,21 @@ struct BroadcasterState {
     pending_announcements: BTreeMap<Hash32, BTreeSet<DeviceId>>,
     /// Rate limiting: peer -> count of ops pushed in current interval
     rate_limits: BTreeMap<DeviceId, usize>,
+    /// Plumtree: peers receiving full ops (spanning tree edges)
+    eager_peers: BTreeSet<DeviceId>,
+    /// Plumtree: peers receiving IHAVE announcements only
+    lazy_peers: BTreeSet<DeviceId>,
+    /// Plumtree: announced ops not yet received
+    missing: BTreeMap<Hash32, MissingOp>,
+}
+
+/// An op announced by IHAVE that has not arrived yet
+#[derive(Debug)]
+struct MissingOp {
+    /// Peers that announced the op, in announcement order
+    announcers: VecDeque<DeviceId>,
+    /// When to graft the next announcer (ms)
+    deadline_ms: u64,
 }
 
 impl BroadcasterState {
@@ -113,6 +163,16 @@ impl BroadcasterState {
         }
         eligible_peers
     }
+
+    fn make_eager(&mut self, peer: DeviceId) {
+        self.lazy_peers.remove(&peer);
+        self.eager_peers.insert(peer);
+    }
+
+    fn make_lazy(&mut self, peer: DeviceId) {
+        self.eager_peers.remove(&peer);
+        self.lazy_peers.insert(peer);
+    }
 }
 
 impl BroadcasterHandler {
@@ -157,6 +217,10 @@ impl BroadcasterHandler {
             return Err(SyncError::BackPressure);
         }
 
+        if self.config.mode == BroadcastMode::Plumtree {
+            return self.tree_push(op, None).await;
+        }
+
         let peers = self.get_connected_peers().await?;
         let cid = Hash32::from(op.op.parent_commitment);
 
@@ -177,6 +241,232 @@ impl BroadcasterHandler {
         Ok(())
     }
 
+    /// Push an op along the tree, excluding the peer it came from
+    ///
+    /// Eager peers over their rate limit get an IHAVE instead, so they can
+    /// graft the op once the limit resets.
+    async fn tree_push(&self, op: AttestedOp, from: Option<DeviceId>) -> Result<(), SyncError> {
+        let cid = Hash32::from(op.op.parent_commitment);
+        let (eager, lazy) = {
+            let mut state = self.state.write().await;
+            let tree_peers: Vec<DeviceId> = state
+                .eager_peers
+                .iter()
+                .copied()
+                .filter(|peer| Some(*peer) != from)
+                .collect();
+            let eager = state.eligible_peers(tree_peers.clone(), self.config.max_ops_per_peer);
+            let lazy: Vec<DeviceId> = state
+                .lazy_peers
+                .iter()
+                .chain(tree_peers.iter().filter(|peer| !eager.contains(peer)))
+                .copied()
+                .filter(|peer| Some(*peer) != from)
+                .collect();
+            (eager, lazy)
+        };
+
+        let pushed = if eager.is_empty() {
+            Ok(())
+        } else {
+            self.push_op_to_peers(op, eager).await
+        };
+        self.send_control(&lazy, &SyncWireMessage::ihave(vec![cid]))
+            .await?;
+        pushed
+    }
+
+    /// Best-effort send of a Plumtree control message
+    async fn send_control(
+        &self,
+        peers: &[DeviceId],
+        message: &SyncWireMessage,
+    ) -> Result<(), SyncError> {
+        if peers.is_empty() {
+            return Ok(());
+        }
+        let Some(network) = &self.network else {
+            tracing::warn!(
+                peer_count = peers.len(),
+                "send_control called without network effects - message not sent"
+            );
+            return Ok(());
+        };
+
+        let data = serialize_message(message)?;
+        for peer in peers {
+            if let Err(e) = network.send_to_peer(peer.0, data.clone()).await {
+                tracing::warn!(peer = ?peer, error = %e, "Failed to send control message");
+            }
+        }
+        Ok(())
+    }
+
+    /// Plumtree: receive ops pushed by a peer
+    ///
+    /// New ops are stored and forwarded along the tree. A duplicate means
+    /// the sender's edge is redundant, so it is pruned.
+    pub async fn handle_gossip(
+        &self,
+        from: DeviceId,
+        ops: VerifiedIngress<Vec<AttestedOp>>,
+    ) -> Result<(), SyncError> {
+        let (ops, _) = ops.into_parts();
+        let mut fresh = Vec::new();
+        let mut duplicate = false;
+        {
+            let mut state = self.state.write().await;
+            state.peers.insert(from);
+            for op in ops {
+                let cid = Hash32::from(op.op.parent_commitment);
+                if state.oplog.contains_key(&cid) {
+                    duplicate = true;
+                    continue;
+                }
+                state.missing.remove(&cid);
+                state.merge_op_bounded(op.clone(), self.config.max_oplog_entries);
+                fresh.push(op);
+            }
+            if !fresh.is_empty() {
+                state.make_eager(from);
+            } else if duplicate {
+                state.make_lazy(from);
+            }
+        }
+
+        if fresh.is_empty() && duplicate {
+            self.send_control(&[from], &SyncWireMessage::prune())
+                .await?;
+        }
+        for op in fresh {
+            self.tree_push(op, Some(from)).await?;
+        }
+        Ok(())
+    }
+
+    /// Plumtree: record ops a peer announced
+    ///
+    /// Unknown ops start a graft timer that expires at
+    /// `now_ms + graft_timeout_ms`.
+    pub async fn handle_ihave(&self, from: DeviceId, cids: Vec<Hash32>, now_ms: u64) {
+        let mut state = self.state.write().await;
+        state.peers.insert(from);
+        if !state.eager_peers.contains(&from) {
+            state.lazy_peers.insert(from);
+        }
+        for cid in cids {
+            if state.oplog.contains_key(&cid) {
+                continue;
+            }
+            if let Some(missing) = state.missing.get_mut(&cid) {
+                if !missing.announcers.contains(&from) {
+                    missing.announcers.push_back(from);
+                }
+                continue;
+            }
+            if state.missing.len() < self.config.max_pending_announcements {
+                state.missing.insert(
+                    cid,
+                    MissingOp {
+                        announcers: VecDeque::from([from]),
+                        deadline_ms: now_ms.saturating_add(self.config.graft_timeout_ms),
+                    },
+                );
+            }
+        }
+    }
+
+    /// Plumtree: a peer asked to join our tree and receive these ops
+    pub async fn handle_graft(&self, from: DeviceId, cids: Vec<Hash32>) -> Result<(), SyncError> {
+        {
+            let mut state = self.state.write().await;
+            state.peers.insert(from);
+            state.make_eager(from);
+        }
+        for cid in cids {
+            match self.lazy_pull_response(from, cid).await {
+                Ok(op) => self.push_op_to_peers(op, vec![from]).await?,
+                Err(SyncError::OperationNotFound) => {
+                    tracing::debug!(cid = ?cid, peer = ?from, "Grafted op no longer available");
+                }
+                Err(e) => return Err(e),
+            }
+        }
+        Ok(())
+    }
+
+    /// Plumtree: a peer asked to stop receiving full ops from us
+    pub async fn handle_prune(&self, from: DeviceId) {
+        let mut state = self.state.write().await;
+        if state.peers.contains(&from) {
+            state.make_lazy(from);
+        }
+    }
+
+    /// Plumtree: graft announced ops whose timer expired by `now_ms`
+    ///
+    /// Each expired op is requested from its earliest remaining announcer,
+    /// which becomes an eager peer; the timer restarts for the next one.
+    /// Returns the number of GRAFT requests sent.
+    pub async fn expire_missing(&self, now_ms: u64) -> Result<usize, SyncError> {
+        let grafts = {
+            let mut state = self.state.write().await;
+            let mut grafts: BTreeMap<DeviceId, Vec<Hash32>> = BTreeMap::new();
+            let mut exhausted = Vec::new();
+            for (cid, missing) in &mut state.missing {
+                if missing.deadline_ms > now_ms {
+                    continue;
+                }
+                match missing.announcers.pop_front() {
+                    Some(peer) => {
+                        grafts.entry(peer).or_default().push(*cid);
+                        missing.deadline_ms = now_ms.saturating_add(self.config.graft_timeout_ms);
+                    }
+                    None => exhausted.push(*cid),
+                }
+            }
+            for cid in exhausted {
+                state.missing.remove(&cid);
+            }
+            for peer in grafts.keys() {
+                state.make_eager(*peer);
+            }
+            grafts
+        };
+
+        let mut sent = 0;
+        for (peer, cids) in grafts {
+            sent += cids.len();
+            self.send_control(&[peer], &SyncWireMessage::graft(cids))
+                .await?;
+        }
+        Ok(sent)
+    }
+
+    /// Forget a peer and every tree edge to it
+    pub async fn remove_peer(&self, peer_id: DeviceId) {
+        let mut state = self.state.write().await;
+        state.peers.remove(&peer_id);
+        state.eager_peers.remove(&peer_id);
+        state.lazy_peers.remove(&peer_id);
+        state.rate_limits.remove(&peer_id);
+        for missing in state.missing.values_mut() {
+            missing.announcers.retain(|peer| *peer != peer_id);
+        }
+    }
+
+    /// Plumtree: peers currently receiving full ops
+    pub async fn eager_peers(&self) -> Vec<DeviceId> {
+        let state = self.state.read().await;
+        state.eager_peers.iter().copied().collect()
+    }
+
+    /// Plumtree: peers currently receiving announcements only
+    pub async fn lazy_peers(&self) -> Vec<DeviceId> {
+        let state = self.state.read().await;
+        state.lazy_peers.iter().copied().collect()
+    }
+
     /// Lazy pull: Respond to peer request for specific operation
     async fn lazy_pull_response(
         &self,
@@ -205,6 +495,10 @@ impl BroadcasterHandler {
     pub async fn add_peer(&self, peer_id: DeviceId) {
         let mut state = self.state.write().await;
         state.peers.insert(peer_id);
+        // New peers join the tree eagerly until a duplicate prunes them
+        if !state.lazy_peers.contains(&peer_id) {
+            state.eager_peers.insert(peer_id);
+        }
     }
 
     /// Reset rate limits (should be called periodically)
@@ -236,6 +530,7 @@ impl SyncEffects for BroadcasterHandler {
 
     async fn get_oplog_digest(&self) -> Result<BloomDigest, SyncError> {
         let state = self.state.read().await;
+        let _latency = latency::span(LatencyStage::AntiEntropyDigest);
         let cids: BTreeSet<Hash32> = state.oplog.keys().copied().collect();
         Ok(BloomDigest { cids })
     }
@@ -279,6 +574,7 @@ impl SyncEffects for BroadcasterHandler {
         ops: VerifiedIngress<Vec<AttestedOp>>,
     ) -> Result<(), SyncError> {
         let mut state = self.state.write().await;
+        let _latency = latency::span(LatencyStage::AntiEntropyMerge);
         let (ops, _) = ops.into_parts();
 
         for op in ops {
@@ -331,8 +627,7 @@ impl SyncEffects for BroadcasterHandler {
         };
 
         // Serialize the operation for transport using the wire module
-        let op_data =
-            crate::wire::serialize_message(&crate::wire::SyncWireMessage::op(op.clone()))?;
+        let op_data = serialize_message(&SyncWireMessage::op(op.clone()))?;
 
         // Send to each peer
         let mut send_errors = Vec::new();
@@ -398,6 +693,75 @@ mod tests {
         DecodedIngress::new(ops, metadata).verify(evidence).unwrap()
     }
 
+    /// Network stub recording every message sent, by wire payload kind
+    #[derive(Default)]
+    struct RecordingNetwork {
+        sent: async_lock::Mutex<Vec<(DeviceId, &'static str)>>,
+    }
+
+    impl RecordingNetwork {
+        async fn take(&self) -> Vec<(DeviceId, &'static str)> {
+            std::mem::take(&mut *self.sent.lock().await)
+        }
+    }
+
+    #[cfg_attr(target_arch = "wasm32", async_trait(?Send))]
+    #[cfg_attr(not(target_arch = "wasm32"), async_trait)]
+    impl aura_core::effects::NetworkCoreEffects for RecordingNetwork {
+        async fn send_to_peer(
+            &self,
+            peer_id: uuid::Uuid,
+            message: Vec<u8>,
+        ) -> Result<(), aura_core::effects::NetworkError> {
+            let kind = match crate::wire::deserialize_message(&message).unwrap().payload {
+                crate::wire::SyncWirePayload::Op(_) => "op",
+                crate::wire::SyncWirePayload::IHave(_) => "ihave",
+                crate::wire::SyncWirePayload::Graft(_) => "graft",
+                crate::wire::SyncWirePayload::Prune => "prune",
+                _ => "other",
+            };
+            self.sent.lock().await.push((DeviceId(peer_id), kind));
+            Ok(())
+        }
+
+        async fn broadcast(
+            &self,
+            _message: Vec<u8>,
+        ) -> Result<(), aura_core::effects::NetworkError> {
+            Ok(())
+        }
+
+        async fn receive(&self) -> Result<(uuid::Uuid, Vec<u8>), aura_core::effects::NetworkError> {
+            Err(aura_core::effects::NetworkError::NoMessage)
+        }
+    }
+
+    #[cfg_attr(target_arch = "wasm32", async_trait(?Send))]
+    #[cfg_attr(not(target_arch = "wasm32"), async_trait)]
+    impl aura_core::effects::NetworkExtendedEffects for RecordingNetwork {}
+
+    async fn plumtree_handler(
+        seed: u8,
+        peers: &[DeviceId],
+    ) -> (BroadcasterHandler, Arc<RecordingNetwork>) {
+        let network = Arc::new(RecordingNetwork::default());
+        let config = BroadcastConfig {
+            mode: BroadcastMode::Plumtree,
+            graft_timeout_ms: 100,
+            ..Default::default()
+        };
+        let handler = BroadcasterHandler::with_network(config, test_context(seed), network.clone());
+        for peer in peers {
+            handler.add_peer(*peer).await;
+        }
+        (handler, network)
+    }
+
+    fn sorted(mut sent: Vec<(DeviceId, &'static str)>) -> Vec<(DeviceId, &'static str)> {
+        sent.sort();
+        sent
+    }
+
     #[tokio::test]
     async fn test_eager_push_enabled() {
         let config = BroadcastConfig {
@@ -579,4 +943,85 @@ mod tests {
         let result = handler.eager_push_to_neighbors(op).await;
         assert!(result.is_ok());
     }
+
+    #[tokio::test]
+    async fn test_plumtree_prunes_duplicate_senders_from_the_tree() {
+        let (a, b, c) = (test_device(1), test_device(2), test_device(3));
+        let (handler, network) = plumtree_handler(10, &[a, b, c]).await;
+        let op = create_test_op(aura_core::Hash32([1u8; 32]));
+
+        // First copy is forwarded to every tree peer except the sender
+        handler
+            .handle_gossip(a, verified_ops(vec![op.clone()]))
+            .await
+            .unwrap();
+        assert_eq!(
+            sorted(network.take().await),
+            sorted(vec![(b, "op"), (c, "op")])
+        );
+
+        // A second copy marks b's edge as redundant
+        handler
+            .handle_gossip(b, verified_ops(vec![op]))
+            .await
+            .unwrap();
+        assert_eq!(network.take().await, vec![(b, "prune")]);
+        assert_eq!(handler.lazy_peers().await, vec![b]);
+
+        // Local ops now reach b as an announcement only
+        let op2 = create_test_op(aura_core::Hash32([2u8; 32]));
+        handler.add_op(op2).await;
+        handler
+            .announce_new_op(aura_core::Hash32([2u8; 32]))
+            .await
+            .unwrap();
+        assert_eq!(
+            sorted(network.take().await),
+            sorted(vec![(a, "op"), (c, "op"), (b, "ihave")])
+        );
+    }
+
+    #[tokio::test]
+    async fn test_plumtree_grafts_missing_op_after_timeout() {
+        let (a, b) = (test_device(1), test_device(2));
+        let (handler, network) = plumtree_handler(11, &[a, b]).await;
+        handler.handle_prune(a).await;
+        handler.handle_prune(b).await;
+        let cid = aura_core::Hash32([3u8; 32]);
+
+        handler.handle_ihave(a, vec![cid], 1_000).await;
+        handler.handle_ihave(b, vec![cid], 1_010).await;
+        assert_eq!(handler.expire_missing(1_050).await.unwrap(), 0);
+
+        // The first announcer is grafted back into the tree
+        assert_eq!(handler.expire_missing(1_100).await.unwrap(), 1);
+        assert_eq!(network.take().await, vec![(a, "graft")]);
+        assert_eq!(handler.eager_peers().await, vec![a]);
+
+        // Falls back to the next announcer if the graft goes unanswered
+        assert_eq!(handler.expire_missing(1_200).await.unwrap(), 1);
+        assert_eq!(network.take().await, vec![(b, "graft")]);
+
+        // Receiving the op cancels the timer
+        handler
+            .handle_gossip(b, verified_ops(vec![create_test_op(cid)]))
+            .await
+            .unwrap();
+        network.take().await;
+        assert_eq!(handler.expire_missing(10_000).await.unwrap(), 0);
+        assert!(network.take().await.is_empty());
+    }
+
+    #[tokio::test]
+    async fn test_plumtree_graft_is_answered_by_lazy_pull() {
+        let a = test_device(1);
+        let (handler, network) = plumtree_handler(12, &[a]).await;
+        handler.handle_prune(a).await;
+        let cid = aura_core::Hash32([4u8; 32]);
+        handler.add_op(create_test_op(cid)).await;
+
+        handler.handle_graft(a, vec![cid]).await.unwrap();
+        assert_eq!(network.take().await, vec![(a, "op")]);
+        assert_eq!(handler.eager_peers().await, vec![a]);
+    }
 }
@@ -63,7 +63,7 @@ pub use aura_core::effects::WakeCondition;
 
 // Re-export handler types
 pub use anti_entropy::AntiEntropyHandler;
-pub use broadcast::{BroadcastConfig, BroadcasterHandler};
+pub use broadcast::{BroadcastConfig, BroadcastMode, BroadcasterHandler};
 pub use persistent::PersistentSyncHandler;
 
 // Re-export storage constants for shared access
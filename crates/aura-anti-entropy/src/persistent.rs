@@ -11,15 +11,58 @@ use super::effects::{BloomDigest, SyncEffects, SyncError, SyncMetrics};
 use async_lock::RwLock;
 use async_trait::async_trait;
 use aura_core::effects::storage::StorageEffects;
+use aura_core::latency::{self, LatencyStage};
 use aura_core::tree::AttestedOp;
 use aura_core::types::identifiers::DeviceId;
 use aura_core::Hash32;
 use aura_guards::VerifiedIngress;
 use aura_journal::commitment_tree::storage as tree_storage;
-use std::collections::BTreeSet;
+use std::collections::{BTreeSet, HashMap};
 use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::Arc;
 
+/// In-memory oplog with each operation's content hash cached beside it.
+///
+/// The position map makes duplicate checks and lookups `O(1)`, so merging a
+/// remote batch costs `O(batch)` instead of re-hashing the whole log per op.
+#[derive(Default)]
+struct OpCache {
+    ops: Vec<AttestedOp>,
+    hashes: Vec<[u8; 32]>,
+    positions: HashMap<Hash32, usize>,
+}
+
+impl OpCache {
+    fn from_parts(ops: Vec<AttestedOp>, hashes: Vec<[u8; 32]>) -> Self {
+        let mut cache = Self::default();
+        for (op, hash) in ops.into_iter().zip(hashes) {
+            cache.push(op, hash);
+        }
+        cache
+    }
+
+    fn contains(&self, hash: &Hash32) -> bool {
+        self.positions.contains_key(hash)
+    }
+
+    fn get(&self, hash: &Hash32) -> Option<&AttestedOp> {
+        self.positions
+            .get(hash)
+            .map(|&position| &self.ops[position])
+    }
+
+    /// Append an op; returns `false` if an op with the same hash is cached.
+    fn push(&mut self, op: AttestedOp, hash: [u8; 32]) -> bool {
+        if self.contains(&Hash32(hash)) {
+            return false;
+        }
+        self.positions.insert(Hash32(hash), self.ops.len());
+        self.ops.push(op);
+        self.hashes.push(hash);
+        true
+    }
+}
+
 /// Persistent sync handler backed by StorageEffects.
 ///
 /// This handler shares the same storage backend as `PersistentTreeHandler`,
@@ -37,8 +80,8 @@ use std::sync::Arc;
 pub struct PersistentSyncHandler {
     /// Storage backend (shared with PersistentTreeHandler)
     storage: Arc<dyn StorageEffects>,
-    /// In-memory cache of operations (loaded from storage on first access)
-    ops_cache: RwLock<Vec<AttestedOp>>,
+    /// In-memory cache of operations and their hashes (loaded from storage on first access)
+    ops_cache: RwLock<OpCache>,
     /// Whether we've loaded from storage yet
     initialized: AtomicBool,
 }
@@ -48,7 +91,7 @@ impl PersistentSyncHandler {
     pub fn new(storage: Arc<dyn StorageEffects>) -> Self {
         Self {
             storage,
-            ops_cache: RwLock::new(Vec::new()),
+            ops_cache: RwLock::new(OpCache::default()),
             initialized: AtomicBool::new(false),
         }
     }
@@ -77,9 +120,12 @@ impl PersistentSyncHandler {
     }
 
     /// Load all operations from storage in order.
+    ///
+    /// Ops are stored under their content hash, so the index supplies each
+    /// op's hash without re-serializing it.
     async fn load_ops_from_storage(
         storage: &dyn StorageEffects,
-    ) -> Result<Vec<AttestedOp>, aura_core::AuraError> {
+    ) -> Result<OpCache, aura_core::AuraError> {
         use aura_core::AuraError;
 
         // Load the index of op hashes
@@ -95,7 +141,7 @@ impl PersistentSyncHandler {
 
         // Load each operation by hash
         let mut ops = Vec::with_capacity(op_hashes.len());
-        for op_hash in op_hashes {
+        for &op_hash in &op_hashes {
             let key = tree_storage::op_key(op_hash);
             let op_bytes = storage
                 .retrieve(&key)
@@ -107,39 +153,33 @@ impl PersistentSyncHandler {
             ops.push(op);
         }
 
-        Ok(ops)
+        Ok(OpCache::from_parts(ops, op_hashes))
     }
 
-    /// Persist an operation to storage.
-    async fn persist_op(
+    /// Persist newly cached operations, then rewrite the index once.
+    async fn persist_ops(
         &self,
-        op: &AttestedOp,
-        op_hash: [u8; 32],
+        new_ops: &[(AttestedOp, [u8; 32])],
     ) -> Result<(), aura_core::AuraError> {
         use aura_core::AuraError;
 
-        // Serialize the operation
-        let op_bytes = tree_storage::serialize_op(op)?;
+        for (op, op_hash) in new_ops {
+            // Serialize the operation
+            let op_bytes = tree_storage::serialize_op(op)?;
 
-        // Store the operation by hash
-        let key = tree_storage::op_key(op_hash);
-        self.storage
-            .store(&key, op_bytes)
-            .await
-            .map_err(|e| AuraError::storage(format!("Failed to store tree op: {e}")))?;
-
-        // Update the index
-        let hashes: Vec<[u8; 32]> = {
-            let ops = self.ops_cache.read().await;
-            let mut hashes = Vec::with_capacity(ops.len());
-            for op in ops.iter() {
-                let op_hash = tree_storage::op_hash(op)?;
-                hashes.push(op_hash);
-            }
-            hashes
-        };
+            // Store the operation by hash
+            let key = tree_storage::op_key(*op_hash);
+            self.storage
+                .store(&key, op_bytes)
+                .await
+                .map_err(|e| AuraError::storage(format!("Failed to store tree op: {e}")))?;
+        }
 
-        let index_bytes = tree_storage::serialize_op_index(&hashes)?;
+        // Update the index from the cached hashes
+        let index_bytes = {
+            let cache = self.ops_cache.read().await;
+            tree_storage::serialize_op_index(&cache.hashes)?
+        };
 
         self.storage
             .store(tree_storage::TREE_OPS_INDEX_KEY, index_bytes)
@@ -175,14 +215,9 @@ impl SyncEffects for PersistentSyncHandler {
     async fn get_oplog_digest(&self) -> Result<BloomDigest, SyncError> {
         self.ensure_initialized_for("load_cached_digest").await?;
 
-        let ops = self.ops_cache.read().await;
-
-        let mut cids = BTreeSet::new();
-        for op in ops.iter() {
-            if let Ok(hash) = tree_storage::op_hash(op) {
-                cids.insert(Hash32(hash));
-            }
-        }
+        let cache = self.ops_cache.read().await;
+        let _latency = latency::span(LatencyStage::AntiEntropyDigest);
+        let cids: BTreeSet<Hash32> = cache.hashes.iter().copied().map(Hash32).collect();
         Ok(BloomDigest { cids })
     }
 
@@ -193,8 +228,8 @@ impl SyncEffects for PersistentSyncHandler {
         self.ensure_initialized_for("load_missing_ops").await?;
 
         // Return full oplog; guard chain filters where needed
-        let ops = self.ops_cache.read().await;
-        Ok(ops.clone())
+        let cache = self.ops_cache.read().await;
+        Ok(cache.ops.clone())
     }
 
     async fn request_ops_from_peer(
@@ -211,36 +246,38 @@ impl SyncEffects for PersistentSyncHandler {
         ops: VerifiedIngress<Vec<AttestedOp>>,
     ) -> Result<(), SyncError> {
         self.ensure_initialized_for("merge_remote_ops").await?;
+        let _latency = latency::span(LatencyStage::AntiEntropyMerge);
         let (ops, _) = ops.into_parts();
 
-        for op in ops {
-            let op_hash =
-                tree_storage::op_hash(&op).map_err(|e| SyncError::VerificationFailed {
-                    target: "persisted_op_hash",
-                    detail: e.to_string(),
-                })?;
-
-            // Check for duplicate
-            let already = {
-                let store = self.ops_cache.read().await;
-                store
-                    .iter()
-                    .any(|existing| stored_op_hash(existing) == Some(Hash32(op_hash)))
-            };
-
-            if !already {
-                // Add to cache
-                {
-                    let mut store = self.ops_cache.write().await;
-                    store.push(op.clone());
+        // Hash only the incoming batch; duplicates are resolved against the
+        // cached hash index.
+        let hashed = ops
+            .into_iter()
+            .map(|op| {
+                tree_storage::op_hash(&op)
+                    .map(|op_hash| (op, op_hash))
+                    .map_err(|e| SyncError::VerificationFailed {
+                        target: "persisted_op_hash",
+                        detail: e.to_string(),
+                    })
+            })
+            .collect::<Result<Vec<_>, _>>()?;
+
+        let mut new_ops = Vec::with_capacity(hashed.len());
+        {
+            let mut cache = self.ops_cache.write().await;
+            for (op, op_hash) in hashed {
+                if cache.push(op.clone(), op_hash) {
+                    new_ops.push((op, op_hash));
                 }
-
-                // Persist to storage
-                self.persist_op(&op, op_hash)
-                    .await
-                    .map_err(|e| sync_network_error("persist_op", e))?;
             }
         }
+
+        if !new_ops.is_empty() {
+            self.persist_ops(&new_ops)
+                .await
+                .map_err(|e| sync_network_error("persist_op", e))?;
+        }
         Ok(())
     }
 
@@ -251,12 +288,8 @@ impl SyncEffects for PersistentSyncHandler {
     async fn request_op(&self, _peer_id: DeviceId, cid: Hash32) -> Result<AttestedOp, SyncError> {
         self.ensure_initialized_for("request_op").await?;
 
-        let store = self.ops_cache.read().await;
-        store
-            .iter()
-            .find(|op| stored_op_hash(op) == Some(cid))
-            .cloned()
-            .ok_or(SyncError::OperationNotFound)
+        let cache = self.ops_cache.read().await;
+        cache.get(&cid).cloned().ok_or(SyncError::OperationNotFound)
     }
 
     async fn push_op_to_peers(
@@ -280,7 +313,3 @@ fn sync_network_error(operation: &'static str, error: impl ToString) -> SyncErro
         detail: error.to_string(),
     }
 }
-
-fn stored_op_hash(op: &AttestedOp) -> Option<Hash32> {
-    tree_storage::op_hash(op).ok().map(Hash32)
-}
@@ -4,9 +4,10 @@ use super::effects::SyncError;
 use aura_core::time::{OrderTime, PhysicalTime};
 use aura_core::tree::AttestedOp;
 use aura_core::types::identifiers::AuthorityId;
+use aura_core::Hash32;
 use serde::{Deserialize, Serialize};
 
-pub const SYNC_WIRE_SCHEMA_VERSION: u16 = 2;
+pub const SYNC_WIRE_SCHEMA_VERSION: u16 = 3;
 
 /// Acknowledgment for a received fact.
 ///
@@ -67,6 +68,12 @@ pub enum SyncWirePayload {
     OpWithAck(OpWithAckRequest),
     /// Acknowledgment for a received fact (v2)
     Ack(FactAck),
+    /// Plumtree announcement of ops the sender holds (v3)
+    IHave(Vec<Hash32>),
+    /// Plumtree request to join the sender's tree and receive these ops (v3)
+    Graft(Vec<Hash32>),
+    /// Plumtree request to demote the sender to lazy announcements (v3)
+    Prune,
 }
 
 #[derive(Debug, Clone, Serialize, Deserialize)]
@@ -101,12 +108,26 @@ impl SyncWireMessage {
         Self::new(SyncWirePayload::Ack(ack))
     }
 
+    /// Create a Plumtree IHAVE announcement.
+    pub fn ihave(cids: Vec<Hash32>) -> Self {
+        Self::new(SyncWirePayload::IHave(cids))
+    }
+
+    /// Create a Plumtree GRAFT request.
+    pub fn graft(cids: Vec<Hash32>) -> Self {
+        Self::new(SyncWirePayload::Graft(cids))
+    }
+
+    /// Create a Plumtree PRUNE request.
+    pub fn prune() -> Self {
+        Self::new(SyncWirePayload::Prune)
+    }
+
     /// Check if this message is an ack request.
     pub fn is_ack_requested(&self) -> bool {
         match &self.payload {
-            SyncWirePayload::Op(_) => false,
             SyncWirePayload::OpWithAck(wrap) => wrap.ack_requested,
-            SyncWirePayload::Ack(_) => false,
+            _ => false,
         }
     }
 
@@ -115,7 +136,7 @@ impl SyncWireMessage {
         match &self.payload {
             SyncWirePayload::Op(op) => Some(op),
             SyncWirePayload::OpWithAck(wrap) => Some(&wrap.op),
-            SyncWirePayload::Ack(_) => None,
+            _ => None,
         }
     }
 
@@ -0,0 +1,231 @@
+//! Layer 2: Reusable Biscuit Authorizer State
+//!
+//! Building an `Authorizer` from a token re-loads every token block into a
+//! fresh Datalog world, and evaluating it re-runs the engine from scratch.
+//! Guarded sends authorize the same token against the same scope many times
+//! per second, so this module keeps:
+//! - **Base authorizers** per token, with token facts pre-loaded; each request
+//!   clones one and adds only its ambient facts and policies.
+//! - **Decisions** keyed by token, authority, operation, resource scope and
+//!   time bucket.
+//!
+//! **Time buckets**: A bucket is the whole second passed to the `time(..)`
+//! ambient fact. That is the finest granularity policies can observe, so a
+//! cached decision is exactly the decision a fresh evaluation would make.
+//! Only successful evaluations are cached; run-limit and library errors are
+//! always re-evaluated.
+//!
+//! The caches are bounded and evict oldest-first. Locks are only held for
+//! synchronous map access and never across `.await`.
+
+// Synchronous, runtime-agnostic cache; no lock is held across `.await`.
+#![allow(clippy::disallowed_types)]
+
+use crate::biscuit_evaluator::VerifiedBiscuitToken;
+use crate::BiscuitError;
+use aura_core::types::identifiers::AuthorityId;
+use aura_core::types::scope::ResourceScope;
+use biscuit_auth::Authorizer;
+use std::collections::{HashMap, VecDeque};
+use std::fmt;
+use std::hash::Hash;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Mutex, MutexGuard, PoisonError};
+
+/// Default number of tokens whose base authorizers are retained.
+pub const DEFAULT_AUTHORIZER_CACHE_CAPACITY: usize = 64;
+
+/// Default number of authorization decisions retained.
+pub const DEFAULT_DECISION_CACHE_CAPACITY: usize = 4_096;
+
+/// Cache key for a single authorization decision.
+#[derive(Debug, Clone, PartialEq, Eq, Hash)]
+pub struct AuthorizationDecisionKey {
+    token_id: [u8; 32],
+    authority: AuthorityId,
+    operation: String,
+    resource: ResourceScope,
+    time_bucket: u64,
+}
+
+impl AuthorizationDecisionKey {
+    /// Key the decision for `token` performing `operation` on `resource` at
+    /// `current_time_seconds`, as evaluated by `authority`.
+    pub fn new(
+        token: &VerifiedBiscuitToken,
+        authority: AuthorityId,
+        operation: &str,
+        resource: &ResourceScope,
+        current_time_seconds: u64,
+    ) -> Self {
+        Self {
+            token_id: token.token_id(),
+            authority,
+            operation: operation.to_string(),
+            resource: resource.clone(),
+            time_bucket: current_time_seconds,
+        }
+    }
+}
+
+/// Shared authorizer and decision caches for Biscuit evaluation.
+///
+/// Bridges clone an `Arc` of this cache, so callers that construct a bridge
+/// per request can still share cached state across requests.
+pub struct BiscuitAuthorizerCache {
+    authorizers: Mutex<BoundedCache<[u8; 32], Authorizer>>,
+    decisions: Mutex<BoundedCache<AuthorizationDecisionKey, bool>>,
+    decision_hits: AtomicU64,
+}
+
+impl BiscuitAuthorizerCache {
+    /// Create a cache with the default capacities.
+    pub fn new() -> Self {
+        Self::with_capacity(
+            DEFAULT_AUTHORIZER_CACHE_CAPACITY,
+            DEFAULT_DECISION_CACHE_CAPACITY,
+        )
+    }
+
+    /// Create a cache with explicit bounds on retained tokens and decisions.
+    pub fn with_capacity(max_authorizers: usize, max_decisions: usize) -> Self {
+        Self {
+            authorizers: Mutex::new(BoundedCache::new(max_authorizers)),
+            decisions: Mutex::new(BoundedCache::new(max_decisions)),
+            decision_hits: AtomicU64::new(0),
+        }
+    }
+
+    /// Fresh authorizer for `token` with its facts already loaded.
+    ///
+    /// The returned authorizer is a private copy; adding ambient facts and
+    /// policies to it does not affect the cached base.
+    pub fn authorizer(&self, token: &VerifiedBiscuitToken) -> Result<Authorizer, BiscuitError> {
+        let token_id = token.token_id();
+        if let Some(base) = lock(&self.authorizers).get(&token_id) {
+            return Ok(base.clone());
+        }
+
+        let base = token.authorizer()?;
+        let authorizer = base.clone();
+        lock(&self.authorizers).insert(token_id, base);
+        Ok(authorizer)
+    }
+
+    /// Cached decision for `key`, if one was recorded.
+    pub fn decision(&self, key: &AuthorizationDecisionKey) -> Option<bool> {
+        let decision = lock(&self.decisions).get(key).copied();
+        if decision.is_some() {
+            self.decision_hits.fetch_add(1, Ordering::Relaxed);
+        }
+        decision
+    }
+
+    /// Record the outcome of a completed evaluation.
+    pub fn record_decision(&self, key: AuthorizationDecisionKey, authorized: bool) {
+        lock(&self.decisions).insert(key, authorized);
+    }
+
+    /// Number of tokens with a cached base authorizer.
+    pub fn authorizer_count(&self) -> usize {
+        lock(&self.authorizers).len()
+    }
+
+    /// Number of cached decisions.
+    pub fn decision_count(&self) -> usize {
+        lock(&self.decisions).len()
+    }
+
+    /// Number of lookups answered from the decision cache.
+    pub fn decision_hits(&self) -> u64 {
+        self.decision_hits.load(Ordering::Relaxed)
+    }
+}
+
+impl Default for BiscuitAuthorizerCache {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl fmt::Debug for BiscuitAuthorizerCache {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("BiscuitAuthorizerCache")
+            .field("authorizers", &self.authorizer_count())
+            .field("decisions", &self.decision_count())
+            .field("decision_hits", &self.decision_hits())
+            .finish()
+    }
+}
+
+/// Cached entries are immutable once inserted, so a panic while holding the
+/// lock cannot leave a half-written entry behind.
+fn lock<T>(mutex: &Mutex<T>) -> MutexGuard<'_, T> {
+    mutex.lock().unwrap_or_else(PoisonError::into_inner)
+}
+
+/// Map bounded to `capacity` entries, evicting in insertion order.
+struct BoundedCache<K, V> {
+    entries: HashMap<K, V>,
+    order: VecDeque<K>,
+    capacity: usize,
+}
+
+impl<K: Clone + Eq + Hash, V> BoundedCache<K, V> {
+    fn new(capacity: usize) -> Self {
+        Self {
+            entries: HashMap::new(),
+            order: VecDeque::new(),
+            capacity,
+        }
+    }
+
+    fn len(&self) -> usize {
+        self.entries.len()
+    }
+
+    fn get(&self, key: &K) -> Option<&V> {
+        self.entries.get(key)
+    }
+
+    fn insert(&mut self, key: K, value: V) {
+        if self.capacity == 0 {
+            return;
+        }
+        if self.entries.insert(key.clone(), value).is_none() {
+            self.order.push_back(key);
+        }
+        while self.entries.len() > self.capacity {
+            let Some(oldest) = self.order.pop_front() else {
+                break;
+            };
+            self.entries.remove(&oldest);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn bounded_cache_evicts_oldest_first() {
+        let mut cache = BoundedCache::new(2);
+        cache.insert(1, "a");
+        cache.insert(2, "b");
+        cache.insert(1, "c");
+        cache.insert(3, "d");
+
+        assert_eq!(cache.len(), 2);
+        assert!(cache.get(&1).is_none());
+        assert_eq!(cache.get(&2), Some(&"b"));
+        assert_eq!(cache.get(&3), Some(&"d"));
+    }
+
+    #[test]
+    fn zero_capacity_caches_nothing() {
+        let mut cache = BoundedCache::new(0);
+        cache.insert(1, ());
+        assert_eq!(cache.len(), 0);
+    }
+}
@@ -11,10 +11,12 @@
 //! **Integration Point**: CapGuard in aura-protocol/guards evaluates Biscuit tokens at message
 //! entry point (first guard in chain); enables delegation without trusted intermediaries.
 
+use crate::biscuit_cache::{AuthorizationDecisionKey, BiscuitAuthorizerCache};
 use crate::BiscuitError;
 use aura_core::types::scope::{AuthorizationOp, ResourceScope};
 use aura_core::{types::identifiers::AuthorityId, CapabilityName, CapabilityNameError};
 use biscuit_auth::{macros::*, AuthorizerLimits, Biscuit, PublicKey};
+use std::sync::Arc;
 use std::time::Duration;
 
 pub const AURA_BISCUIT_LIMITS: AuthorizerLimits = AuthorizerLimits {
@@ -27,13 +29,17 @@ pub const AURA_BISCUIT_LIMITS: AuthorizerLimits = AuthorizerLimits {
 #[derive(Clone, Debug)]
 pub struct VerifiedBiscuitToken {
     token: Biscuit,
+    token_id: [u8; 32],
 }
 
 impl VerifiedBiscuitToken {
     /// Verify serialized Biscuit bytes against the configured root public key.
     pub fn from_bytes(bytes: &[u8], root_public_key: PublicKey) -> Result<Self, BiscuitError> {
         let token = Biscuit::from(bytes, root_public_key).map_err(BiscuitError::BiscuitLib)?;
-        Ok(Self { token })
+        Ok(Self {
+            token,
+            token_id: aura_core::hash::hash(bytes),
+        })
     }
 
     /// Re-serialize and reparse an existing Biscuit under the configured root
@@ -49,6 +55,12 @@ impl VerifiedBiscuitToken {
         &self.token
     }
 
+    /// Hash of the verified serialized token, used to key cached evaluation state.
+    #[must_use]
+    pub fn token_id(&self) -> [u8; 32] {
+        self.token_id
+    }
+
     /// Create an authorizer from the verified token.
     pub fn authorizer(&self) -> Result<biscuit_auth::Authorizer, BiscuitError> {
         self.token.authorizer().map_err(BiscuitError::BiscuitLib)
@@ -59,17 +71,34 @@ impl VerifiedBiscuitToken {
 // Biscuit Authorization Bridge
 // ============================================================================
 
+/// Clones share the same [`BiscuitAuthorizerCache`].
 #[derive(Clone, Debug)]
 pub struct BiscuitAuthorizationBridge {
     root_public_key: PublicKey,
     authority_id: AuthorityId,
+    cache: Arc<BiscuitAuthorizerCache>,
 }
 
 impl BiscuitAuthorizationBridge {
     pub fn new(root_public_key: PublicKey, authority_id: AuthorityId) -> Self {
+        Self::with_cache(
+            root_public_key,
+            authority_id,
+            Arc::new(BiscuitAuthorizerCache::new()),
+        )
+    }
+
+    /// Bridge that reuses an existing authorizer cache, for callers that
+    /// construct a bridge per request.
+    pub fn with_cache(
+        root_public_key: PublicKey,
+        authority_id: AuthorityId,
+        cache: Arc<BiscuitAuthorizerCache>,
+    ) -> Self {
         Self {
             root_public_key,
             authority_id,
+            cache,
         }
     }
 
@@ -77,12 +106,10 @@ impl BiscuitAuthorizationBridge {
     fn test_bridge() -> Self {
         use biscuit_auth::KeyPair;
         let keypair = KeyPair::new();
-        Self {
-            root_public_key: keypair.public(),
-            authority_id: AuthorityId::new_from_entropy(aura_core::hash::hash(
-                &keypair.public().to_bytes(),
-            )),
-        }
+        Self::new(
+            keypair.public(),
+            AuthorityId::new_from_entropy(aura_core::hash::hash(&keypair.public().to_bytes())),
+        )
     }
 
     /// Create a mock bridge for testing with a generated keypair
@@ -92,6 +119,9 @@ impl BiscuitAuthorizationBridge {
     }
 
     /// Production Biscuit authorization with explicit time and pre-verified token evidence.
+    ///
+    /// Decisions are cached per token, operation, scope and second; repeated
+    /// checks within the same second skip Datalog evaluation.
     pub fn authorize_with_time(
         &self,
         token: &VerifiedBiscuitToken,
@@ -99,13 +129,27 @@ impl BiscuitAuthorizationBridge {
         resource: &ResourceScope,
         current_time_seconds: Option<u64>,
     ) -> Result<AuthorizationResult, BiscuitError> {
-        self.authorize_with_time_and_limits(
+        let current_time_seconds = require_time(current_time_seconds)?;
+        let key = AuthorizationDecisionKey::new(
             token,
-            operation,
+            self.authority_id,
+            operation.as_str(),
             resource,
             current_time_seconds,
+        );
+        if let Some(authorized) = self.cache.decision(&key) {
+            return Ok(self.authorization_result(token, authorized));
+        }
+
+        let result = self.authorize_with_time_and_limits(
+            token,
+            operation,
+            resource,
+            Some(current_time_seconds),
             AURA_BISCUIT_LIMITS,
-        )
+        )?;
+        self.cache.record_decision(key, result.authorized);
+        Ok(result)
     }
 
     /// Check if a verified token has a specific capability through Datalog evaluation.
@@ -135,7 +179,7 @@ impl BiscuitAuthorizationBridge {
         let operation_name =
             CapabilityName::parse(operation.as_str()).map_err(invalid_capability_error)?;
         let operation_str = operation_name.as_str();
-        let mut authorizer = token.authorizer()?;
+        let mut authorizer = self.cache.authorizer(token)?;
         self.add_operation_authority_time_facts(
             &mut authorizer,
             operation_str,
@@ -166,11 +210,18 @@ impl BiscuitAuthorizationBridge {
             Err(e) => return Err(BiscuitError::BiscuitLib(e)),
         };
 
-        Ok(AuthorizationResult {
+        Ok(self.authorization_result(token, authorized))
+    }
+
+    fn authorization_result(
+        &self,
+        token: &VerifiedBiscuitToken,
+        authorized: bool,
+    ) -> AuthorizationResult {
+        AuthorizationResult {
             authorized,
             delegation_depth: self.extract_delegation_depth_from_token(token.token()),
-            token_facts: self.extract_diagnostic_token_facts(token),
-        })
+        }
     }
 
     fn has_capability_with_time_and_limits(
@@ -184,7 +235,7 @@ impl BiscuitAuthorizationBridge {
         let capability_name =
             CapabilityName::parse(capability).map_err(invalid_capability_error)?;
         let capability = capability_name.as_str();
-        let mut authorizer = token.authorizer()?;
+        let mut authorizer = self.cache.authorizer(token)?;
 
         self.add_authority_and_time_facts(&mut authorizer, current_time_seconds)?;
         Self::add_policy(
@@ -219,7 +270,9 @@ impl BiscuitAuthorizationBridge {
         }
     }
 
-    /// Extract readable token facts from token blocks
+    /// Extract readable token facts from token blocks.
+    ///
+    /// Diagnostics are built only on request; authorization never formats facts.
     pub fn extract_diagnostic_token_facts(&self, token: &VerifiedBiscuitToken) -> Vec<String> {
         let mut facts = Vec::new();
 
@@ -229,7 +282,7 @@ impl BiscuitAuthorizationBridge {
         facts.push(format!("verified_at({})", now));
 
         // Try to extract facts from the verified token using an authorizer.
-        if let Ok(authorizer) = token.authorizer() {
+        if let Ok(authorizer) = self.cache.authorizer(token) {
             // Get the world facts which include facts from all token blocks
             let (world_facts, world_rules, _world_checks, _world_policies) = authorizer.dump();
             // Parse facts from the world dump
@@ -260,6 +313,11 @@ impl BiscuitAuthorizationBridge {
         self.authority_id
     }
 
+    /// Authorizer and decision cache shared by clones of this bridge.
+    pub fn cache(&self) -> &Arc<BiscuitAuthorizerCache> {
+        &self.cache
+    }
+
     fn add_operation_authority_time_facts(
         &self,
         authorizer: &mut biscuit_auth::Authorizer,
@@ -542,6 +600,65 @@ mod tests {
         (keypair, verified)
     }
 
+    fn scoped_read_token(scope_authority: AuthorityId) -> (KeyPair, VerifiedBiscuitToken) {
+        let keypair = KeyPair::new();
+        let mut builder = BiscuitBuilder::new();
+        let scope_authority = scope_authority.to_string();
+        builder
+            .add_fact(fact!("capability(\"read\")"))
+            .expect("add capability");
+        builder
+            .add_fact(fact!("scope_authority({scope_authority})"))
+            .expect("add authority scope");
+        let token = builder.build(&keypair).expect("build token");
+        let verified = VerifiedBiscuitToken::from_token(&token, keypair.public()).expect("verify");
+        (keypair, verified)
+    }
+
+    #[test]
+    fn cached_authorizers_do_not_leak_ambient_facts_between_requests() {
+        let in_scope = AuthorityId::new_from_entropy([8; 32]);
+        let out_of_scope = ResourceScope::Authority {
+            authority_id: AuthorityId::new_from_entropy([9; 32]),
+            operation: AuthorityOp::UpdateTree,
+        };
+        let (keypair, verified) = scoped_read_token(in_scope);
+        let bridge = test_bridge(&keypair);
+
+        let allowed = bridge
+            .authorize_with_time(&verified, AuthorizationOp::Read, &test_scope(), Some(1_000))
+            .expect("in-scope authorization");
+        let denied = bridge
+            .authorize_with_time(&verified, AuthorizationOp::Read, &out_of_scope, Some(1_000))
+            .expect("out-of-scope authorization");
+
+        assert!(allowed.authorized);
+        assert!(!denied.authorized);
+        assert_eq!(bridge.cache().authorizer_count(), 1);
+        assert_eq!(bridge.cache().decision_count(), 2);
+    }
+
+    #[test]
+    fn repeated_decisions_within_a_second_are_served_from_cache() {
+        let (keypair, verified) = scoped_read_token(AuthorityId::new_from_entropy([8; 32]));
+        let bridge = test_bridge(&keypair);
+        let shared = bridge.clone();
+
+        for _ in 0..3 {
+            let result = shared
+                .authorize_with_time(&verified, AuthorizationOp::Read, &test_scope(), Some(1_000))
+                .expect("authorization");
+            assert!(result.authorized);
+            assert_eq!(result.delegation_depth, Some(0));
+        }
+        assert_eq!(bridge.cache().decision_count(), 1);
+
+        bridge
+            .authorize_with_time(&verified, AuthorizationOp::Read, &test_scope(), Some(1_001))
+            .expect("authorization in the next second");
+        assert_eq!(bridge.cache().decision_count(), 2);
+    }
+
     #[test]
     fn authorize_with_limits_rejects_tokens_that_exceed_fact_budget() {
         let (keypair, verified) = token_with_iteration_chain(32);
@@ -620,9 +737,13 @@ mod tests {
 // Authorization Result
 // ============================================================================
 
-#[derive(Debug, Clone)]
+/// Outcome of a Biscuit authorization check.
+///
+/// Token facts are not collected here; use
+/// [`BiscuitAuthorizationBridge::extract_diagnostic_token_facts`] when
+/// diagnostics are needed.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub struct AuthorizationResult {
     pub authorized: bool,
     pub delegation_depth: Option<u32>,
-    pub token_facts: Vec<String>,
 }
@@ -4,8 +4,8 @@
 //! keeping Layer 2 free of in-memory mutable state.
 
 use async_trait::async_trait;
-use aura_core::effects::{FlowBudgetEffects, JournalEffects};
-use aura_core::types::flow::{FlowCost, FlowNonce, Receipt, ReceiptSig};
+use aura_core::effects::{batch_charge_nonces, total_flow_cost, FlowBudgetEffects, JournalEffects};
+use aura_core::types::flow::{FlowBudget, FlowCost, FlowNonce, Receipt, ReceiptSig};
 use aura_core::types::identifiers::{AuthorityId, ContextId};
 use aura_core::{AuraError, AuraResult, Hash32};
 use biscuit_auth::Biscuit;
@@ -79,15 +79,14 @@ impl<J: JournalEffects> JournalBackedFlowBudgetHandler<J> {
     }
 }
 
-#[cfg_attr(target_arch = "wasm32", async_trait(?Send))]
-#[cfg_attr(not(target_arch = "wasm32"), async_trait)]
-impl<J: JournalEffects + Send + Sync> FlowBudgetEffects for JournalBackedFlowBudgetHandler<J> {
-    async fn charge_flow(
+impl<J: JournalEffects + Send + Sync> JournalBackedFlowBudgetHandler<J> {
+    /// Debit `cost` from the `(context, peer)` budget in one journal update.
+    async fn debit(
         &self,
         context: &ContextId,
         peer: &AuthorityId,
         cost: FlowCost,
-    ) -> AuraResult<Receipt> {
+    ) -> AuraResult<FlowBudget> {
         let scope = ResourceScope::Context {
             context_id: *context,
             operation: ContextOp::UpdateParams,
@@ -106,20 +105,59 @@ impl<J: JournalEffects + Send + Sync> FlowBudgetEffects for JournalBackedFlowBud
                 AuraError::invalid("flow budget overflow while recording unbounded spend")
             })?;
         }
-        let updated = self
-            .journal
+        self.journal
             .update_flow_budget(context, peer, &updated)
-            .await?;
+            .await
+    }
 
+    fn receipt(
+        &self,
+        context: &ContextId,
+        peer: &AuthorityId,
+        budget: &FlowBudget,
+        cost: FlowCost,
+        nonce: FlowNonce,
+    ) -> AuraResult<Receipt> {
         Ok(Receipt::new(
             *context,
             self.authority,
             *peer,
-            updated.epoch,
+            budget.epoch,
             cost,
-            FlowNonce::new(updated.spent),
+            nonce,
             Hash32::default(),
             ReceiptSig::new(Vec::new())?,
         ))
     }
 }
+
+#[cfg_attr(target_arch = "wasm32", async_trait(?Send))]
+#[cfg_attr(not(target_arch = "wasm32"), async_trait)]
+impl<J: JournalEffects + Send + Sync> FlowBudgetEffects for JournalBackedFlowBudgetHandler<J> {
+    async fn charge_flow(
+        &self,
+        context: &ContextId,
+        peer: &AuthorityId,
+        cost: FlowCost,
+    ) -> AuraResult<Receipt> {
+        let updated = self.debit(context, peer, cost).await?;
+        self.receipt(context, peer, &updated, cost, FlowNonce::new(updated.spent))
+    }
+
+    async fn charge_flow_batch(
+        &self,
+        context: &ContextId,
+        peer: &AuthorityId,
+        costs: &[FlowCost],
+    ) -> AuraResult<Vec<Receipt>> {
+        if costs.is_empty() {
+            return Ok(Vec::new());
+        }
+        let updated = self.debit(context, peer, total_flow_cost(costs)?).await?;
+        costs
+            .iter()
+            .zip(batch_charge_nonces(updated.spent, costs))
+            .map(|(&cost, nonce)| self.receipt(context, peer, &updated, cost, nonce))
+            .collect()
+    }
+}
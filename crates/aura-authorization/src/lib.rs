@@ -48,6 +48,7 @@ pub mod flow_budget;
 pub mod proposals;
 
 // Biscuit-based authorization
+pub mod biscuit_cache;
 pub mod biscuit_evaluator;
 pub mod biscuit_token;
 pub mod facts;
@@ -76,6 +77,7 @@ pub use facts::{WotFact, WotFactDelta, WotFactReducer, WOT_FACT_TYPE_ID};
 pub use aura_core::types::scope::{AuthorityOp, ContextOp, ResourceScope};
 
 // Biscuit authorization types
+pub use biscuit_cache::{AuthorizationDecisionKey, BiscuitAuthorizerCache};
 pub use biscuit_evaluator::{
     AuthorizationResult, BiscuitAuthorizationBridge, VerifiedBiscuitToken, AURA_BISCUIT_LIMITS,
 };
@@ -0,0 +1,113 @@
+#![allow(clippy::expect_used, clippy::disallowed_methods)]
+#![allow(missing_docs)]
+//! Pooled versus on-demand FROST nonces in `FrostConsensusOrchestrator`.
+//!
+//! The on-demand case disables pipelining, so every round generates and
+//! exchanges commitments before signing. The pooled case tops the nonce pool
+//! up outside the measured routine, leaving a single signing round.
+
+use aura_consensus::{frost::FrostConsensusOrchestrator, ConsensusConfig, ConsensusRequest};
+use aura_core::{
+    frost::{PublicKeyPackage, Share},
+    types::Epoch,
+    AuthorityId, Hash32,
+};
+use aura_effects::{PhysicalTimeHandler, RealRandomHandler};
+use criterion::{black_box, criterion_group, criterion_main, BatchSize, BenchmarkId, Criterion};
+use futures::executor::block_on;
+use rand::SeedableRng;
+use rand_chacha::ChaCha20Rng;
+use std::collections::HashMap;
+
+const THRESHOLDS: [(u16, u16); 3] = [(3, 5), (5, 7), (7, 10)];
+
+fn orchestrator(threshold: u16, total: u16, pipelining: bool) -> FrostConsensusOrchestrator {
+    let mut rng = ChaCha20Rng::from_seed([17u8; 32]);
+    let (secret_shares, group_public_key) = frost_ed25519::keys::generate_with_dealer(
+        total,
+        threshold,
+        frost_ed25519::keys::IdentifierList::Default,
+        &mut rng,
+    )
+    .expect("dealer key generation");
+    let witnesses: Vec<AuthorityId> = (0..total)
+        .map(|i| AuthorityId::new_from_entropy([i as u8 + 1; 32]))
+        .collect();
+    let key_packages: HashMap<AuthorityId, Share> = witnesses
+        .iter()
+        .copied()
+        .zip(secret_shares.into_values().map(|secret_share| {
+            Share::from(
+                frost_ed25519::keys::KeyPackage::try_from(secret_share).expect("key package"),
+            )
+        }))
+        .collect();
+
+    let mut config =
+        ConsensusConfig::new(threshold, witnesses, Epoch::from(1)).expect("consensus config");
+    config.enable_pipelining = pipelining;
+    FrostConsensusOrchestrator::new(
+        config,
+        key_packages,
+        PublicKeyPackage::from(group_public_key),
+    )
+    .expect("orchestrator")
+}
+
+fn request(round: u64) -> ConsensusRequest {
+    let mut seed = [0u8; 32];
+    seed[..8].copy_from_slice(&round.to_le_bytes());
+    ConsensusRequest {
+        prestate_hash: Hash32::new(seed),
+        operation_bytes: round.to_le_bytes().to_vec(),
+        operation_hash: Hash32::new(seed),
+        timeout_ms: None,
+    }
+}
+
+fn bench_nonce_pool(c: &mut Criterion) {
+    let random = RealRandomHandler::new();
+    let time = PhysicalTimeHandler::new();
+    let mut group = c.benchmark_group("frost_nonce_pool");
+    group.sample_size(20);
+
+    for (threshold, total) in THRESHOLDS {
+        let label = format!("{threshold}of{total}");
+
+        let on_demand = orchestrator(threshold, total, false);
+        let mut round = 0u64;
+        group.bench_function(BenchmarkId::new("on_demand", &label), |b| {
+            b.iter(|| {
+                round += 1;
+                let response = block_on(on_demand.run_consensus(request(round), &random, &time))
+                    .expect("consensus");
+                assert!(!response.fast_path);
+                black_box(response.result.expect("commit"));
+            });
+        });
+
+        let pooled = orchestrator(threshold, total, true);
+        let mut round = 0u64;
+        group.bench_function(BenchmarkId::new("pooled", &label), |b| {
+            b.iter_batched(
+                || {
+                    block_on(pooled.replenish_nonce_pool(&random)).expect("replenish");
+                    round += 1;
+                    request(round)
+                },
+                |request| {
+                    let response =
+                        block_on(pooled.run_consensus(request, &random, &time)).expect("consensus");
+                    assert!(response.fast_path);
+                    black_box(response.result.expect("commit"))
+                },
+                BatchSize::SmallInput,
+            );
+        });
+    }
+
+    group.finish();
+}
+
+criterion_group!(benches, bench_nonce_pool);
+criterion_main!(benches);
@@ -1,11 +1,13 @@
 //! Consensus runtime configuration.
 
-use std::num::NonZeroU64;
+use std::num::{NonZeroU64, NonZeroUsize};
 
 #[derive(Debug, Clone)]
 pub struct ConsensusRuntimeConfig {
     pub default_timeout_ms: NonZeroU64,
     pub enable_pipelining: bool,
+    /// Pre-generated FROST nonces held per witness for fast-path rounds
+    pub nonce_pool_depth: NonZeroUsize,
 }
 
 impl Default for ConsensusRuntimeConfig {
@@ -14,6 +16,7 @@ impl Default for ConsensusRuntimeConfig {
             default_timeout_ms: NonZeroU64::new(30_000)
                 .expect("default timeout should be non-zero"),
             enable_pipelining: true,
+            nonce_pool_depth: NonZeroUsize::new(8).expect("nonce pool depth should be non-zero"),
         }
     }
 }
@@ -5,7 +5,8 @@
 
 use super::{
     messages::{
-        ConsensusError, ConsensusMessage, ConsensusPhase, ConsensusRequest, ConsensusResponse,
+        ConsensusError, ConsensusMessage, ConsensusPhase, ConsensusPhaseTimings, ConsensusRequest,
+        ConsensusResponse,
     },
     types::{consensus_commit_transcript_bytes, CommitFact, ConsensusConfig, ConsensusId},
     witness::{WitnessSet, WitnessTracker},
@@ -30,9 +31,10 @@ use tracing::{debug, info, warn};
 /// FROST consensus orchestrator with pipelining support
 ///
 /// Manages the cryptographic operations and optimization logic for consensus:
-/// - Fast path (1 RTT) using cached commitments
+/// - Fast path (1 RTT) using commitments from the pre-generated nonce pool
 /// - Slow path (2 RTT) for bootstrap and fallback
 /// - Epoch-aware commitment management
+/// - Pool replenishment off the critical path via [`Self::replenish_nonce_pool`]
 /// - FROST threshold signature generation and verification
 pub struct FrostConsensusOrchestrator {
     /// Current consensus configuration
@@ -127,11 +129,12 @@ impl FrostConsensusOrchestrator {
             "Starting consensus"
         );
 
+        let mut phase_timings = ConsensusPhaseTimings::default();
         let result = if fast_path {
-            self.run_fast_path(consensus_id, request, random, time)
+            self.run_fast_path(consensus_id, request, random, time, &mut phase_timings)
                 .await
         } else {
-            self.run_slow_path(consensus_id, request, random, time)
+            self.run_slow_path(consensus_id, request, random, time, &mut phase_timings)
                 .await
         };
 
@@ -142,12 +145,22 @@ impl FrostConsensusOrchestrator {
             .ts_ms
             - start_time;
 
+        debug!(
+            consensus_id = %consensus_id,
+            fast_path = fast_path,
+            commit_ms = phase_timings.commit_ms,
+            sign_ms = phase_timings.sign_ms,
+            aggregate_ms = phase_timings.aggregate_ms,
+            "Consensus phase timings"
+        );
+
         match result {
             Ok(commit_fact) => Ok(ConsensusResponse {
                 consensus_id,
                 result: Ok(commit_fact),
                 duration_ms,
                 fast_path,
+                phase_timings,
             }),
             Err(e) => {
                 warn!(consensus_id = %consensus_id, error = %e, "Consensus failed");
@@ -160,31 +173,84 @@ impl FrostConsensusOrchestrator {
                     }),
                     duration_ms,
                     fast_path,
+                    phase_timings,
                 })
             }
         }
     }
 
-    /// Run fast path (1 RTT) using cached commitments
+    /// Top up every witness's nonce pool to capacity for the current epoch
+    ///
+    /// [`ConsensusProtocol::run_consensus`](crate::ConsensusProtocol::run_consensus)
+    /// calls this after each round so that fast-path consensus only takes
+    /// pre-published commitments instead of generating them inline. Only the
+    /// deficit is generated. Returns the number of nonces generated.
+    pub async fn replenish_nonce_pool(
+        &self,
+        random: &(impl RandomEffects + ?Sized),
+    ) -> Result<usize> {
+        self.top_up_nonce_pool(random, self.witness_set.nonce_pool_capacity())
+            .await
+    }
+
+    /// Number of fast-path rounds the current nonce pool can still cover
+    pub async fn fast_path_rounds_available(&self) -> usize {
+        self.witness_set
+            .fast_path_rounds_available(self.config.epoch)
+            .await
+    }
+
+    /// Generate up to `per_witness` pooled nonces for each keyed witness
+    async fn top_up_nonce_pool(
+        &self,
+        random: &(impl RandomEffects + ?Sized),
+        per_witness: usize,
+    ) -> Result<usize> {
+        let epoch = self.config.epoch;
+        let mut generated = 0usize;
+        for witness_id in self.config.witness_set.iter() {
+            let Some(share) = self.key_packages.get(witness_id) else {
+                continue;
+            };
+            let deficit = self
+                .witness_set
+                .nonce_pool_deficit(*witness_id, epoch)
+                .await
+                .min(per_witness);
+            for _ in 0..deficit {
+                let (commitment, token) = self.generate_nonce(share, random).await?;
+                self.witness_set
+                    .update_witness_nonce(*witness_id, commitment, token, epoch)
+                    .await?;
+            }
+            generated += deficit;
+        }
+        Ok(generated)
+    }
+
+    /// Run fast path (1 RTT) using pooled commitments
+    ///
+    /// Nonces are taken from the pre-generated pool, so the round has no
+    /// commitment exchange and no inline nonce generation.
     async fn run_fast_path(
         &self,
         consensus_id: ConsensusId,
         request: ConsensusRequest,
         random: &(impl RandomEffects + ?Sized),
         time: &(impl PhysicalTimeEffects + ?Sized),
+        timings: &mut ConsensusPhaseTimings,
     ) -> Result<CommitFact> {
-        // Collect cached commitments
-        let cached_commitments = self
+        let commit_start = current_time_ms(time).await?;
+        let Some(pooled_nonces) = self
             .witness_set
-            .collect_cached_commitments(self.config.epoch)
-            .await;
-
-        if cached_commitments.len() < self.config.threshold() as usize {
-            debug!("Insufficient cached commitments, falling back to slow path");
+            .take_fast_path_nonces(self.config.epoch)
+            .await
+        else {
+            debug!("Insufficient pooled commitments, falling back to slow path");
             return self
-                .run_slow_path(consensus_id, request, random, time)
+                .run_slow_path(consensus_id, request, random, time, timings)
                 .await;
-        }
+        };
 
         // Create instance
         let instance = ConsensusInstance {
@@ -195,56 +261,42 @@ impl FrostConsensusOrchestrator {
             tracker: WitnessTracker::new(),
             phase: ConsensusPhase::Execute,
             fast_path: true,
-            start_time_ms: time
-                .physical_time()
-                .await
-                .map_err(|e| AuraError::internal(format!("time error: {e}")))?
-                .ts_ms,
+            start_time_ms: commit_start,
         };
 
         self.instances.write().await.insert(consensus_id, instance);
 
-        // Skip NonceCommit phase and go directly to signing with cached commitments
-        let aggregated_nonces: Vec<NonceCommitment> =
-            cached_commitments.values().cloned().collect();
-
-        // Sign with each witness
+        // Skip NonceCommit phase and go directly to signing with pooled commitments
         let mut tracker = WitnessTracker::new();
-        for (witness_id, commitment) in cached_commitments.iter() {
+        for (witness_id, (commitment, _)) in pooled_nonces.iter() {
             tracker.add_nonce(*witness_id, commitment.clone());
         }
+        let aggregated_nonces = tracker.get_nonces();
+        let sign_start = current_time_ms(time).await?;
+        timings.commit_ms = sign_start.saturating_sub(commit_start);
 
-        // Generate signatures
-        for witness_id in self.config.witness_set.iter() {
-            if let Some(share) = self.key_packages.get(witness_id) {
-                // Take cached nonce for signing
-                let mut witness_state = self
-                    .witness_set
-                    .get_or_create_state(*witness_id, self.config.epoch)
-                    .await;
-                if let Some((commitment, token)) = witness_state.take_nonce(self.config.epoch) {
-                    // Generate partial signature
-                    let transcript = consensus_commit_transcript_bytes(
-                        consensus_id,
-                        request.prestate_hash,
-                        request.operation_hash,
-                        &request.operation_bytes,
-                        self.config.threshold(),
-                    )?;
-                    let signature =
-                        self.sign_with_nonce(&transcript, share, &token, &aggregated_nonces)?;
-
-                    // Use operation_hash as result_id (deterministic execution assumption)
-                    let _ = tracker.add_signature(*witness_id, signature, request.operation_hash);
-
-                    // Generate and cache next round commitment for pipelining
-                    let (next_commitment, next_token) = self.generate_nonce(share, random).await?;
-                    witness_state.set_next_nonce(next_commitment, next_token, self.config.epoch);
-                }
+        let transcript = consensus_commit_transcript_bytes(
+            consensus_id,
+            request.prestate_hash,
+            request.operation_hash,
+            &request.operation_bytes,
+            self.config.threshold(),
+        )?;
+        for (witness_id, (_, token)) in pooled_nonces {
+            if let Some(share) = self.key_packages.get(&witness_id) {
+                let signature =
+                    self.sign_with_nonce(&transcript, share, &token, &aggregated_nonces)?;
+
+                // Use operation_hash as result_id (deterministic execution assumption)
+                let _ = tracker.add_signature(witness_id, signature, request.operation_hash);
             }
         }
+        let aggregate_start = current_time_ms(time).await?;
+        timings.sign_ms = aggregate_start.saturating_sub(sign_start);
 
-        self.finalize_consensus(consensus_id, tracker, time).await
+        let commit_fact = self.finalize_consensus(consensus_id, tracker, time).await;
+        timings.aggregate_ms = current_time_ms(time).await?.saturating_sub(aggregate_start);
+        commit_fact
     }
 
     /// Run slow path (2 RTT) - standard FROST consensus
@@ -254,7 +306,10 @@ impl FrostConsensusOrchestrator {
         request: ConsensusRequest,
         random: &(impl RandomEffects + ?Sized),
         time: &(impl PhysicalTimeEffects + ?Sized),
+        timings: &mut ConsensusPhaseTimings,
     ) -> Result<CommitFact> {
+        let commit_start = current_time_ms(time).await?;
+
         // Create instance
         let instance = ConsensusInstance {
             consensus_id,
@@ -264,11 +319,7 @@ impl FrostConsensusOrchestrator {
             tracker: WitnessTracker::new(),
             phase: ConsensusPhase::Execute,
             fast_path: false,
-            start_time_ms: time
-                .physical_time()
-                .await
-                .map_err(|e| AuraError::internal(format!("time error: {e}")))?
-                .ts_ms,
+            start_time_ms: commit_start,
         };
 
         self.instances.write().await.insert(consensus_id, instance);
@@ -288,39 +339,41 @@ impl FrostConsensusOrchestrator {
         if !tracker.has_nonce_threshold(self.config.threshold()) {
             return Err(AuraError::internal("Insufficient nonce commitments"));
         }
+        let sign_start = current_time_ms(time).await?;
+        timings.commit_ms = sign_start.saturating_sub(commit_start);
 
         // Phase 2: Generate signatures
         let aggregated_nonces = tracker.get_nonces();
+        let transcript = consensus_commit_transcript_bytes(
+            consensus_id,
+            request.prestate_hash,
+            request.operation_hash,
+            &request.operation_bytes,
+            self.config.threshold(),
+        )?;
 
         for (witness_id, token) in nonce_tokens {
             if let Some(share) = self.key_packages.get(&witness_id) {
-                let transcript = consensus_commit_transcript_bytes(
-                    consensus_id,
-                    request.prestate_hash,
-                    request.operation_hash,
-                    &request.operation_bytes,
-                    self.config.threshold(),
-                )?;
                 let signature =
                     self.sign_with_nonce(&transcript, share, &token, &aggregated_nonces)?;
 
                 // Use operation_hash as result_id (deterministic execution assumption)
                 let _ = tracker.add_signature(witness_id, signature, request.operation_hash);
-
-                // Generate and cache next round commitment for future pipelining
-                let (next_commitment, next_token) = self.generate_nonce(share, random).await?;
-                self.witness_set
-                    .update_witness_nonce(
-                        witness_id,
-                        next_commitment,
-                        next_token,
-                        self.config.epoch,
-                    )
-                    .await?;
             }
         }
+        let aggregate_start = current_time_ms(time).await?;
+        timings.sign_ms = aggregate_start.saturating_sub(sign_start);
+
+        let commit_fact = self.finalize_consensus(consensus_id, tracker, time).await;
+        timings.aggregate_ms = current_time_ms(time).await?.saturating_sub(aggregate_start);
+
+        // Seed one nonce per witness so the next round can take the fast path
+        // even when the orchestrator is driven without `ConsensusProtocol`.
+        if self.config.enable_pipelining {
+            self.top_up_nonce_pool(random, 1).await?;
+        }
 
-        self.finalize_consensus(consensus_id, tracker, time).await
+        commit_fact
     }
 
     /// Finalize consensus with collected signatures
@@ -530,12 +583,15 @@ impl FrostConsensusOrchestrator {
     }
 
     /// Handle epoch change
+    ///
+    /// Drops every pooled nonce; commitments published for the old epoch
+    /// must never be signed with in the new one.
     pub async fn handle_epoch_change(&self, new_epoch: Epoch) {
         if new_epoch != self.config.epoch {
             info!(
                 old_epoch = %self.config.epoch,
                 new_epoch = %new_epoch,
-                "Epoch change detected, invalidating cached commitments"
+                "Epoch change detected, invalidating pooled commitments"
             );
 
             self.witness_set.invalidate_all_caches().await;
@@ -571,6 +627,14 @@ impl FrostConsensusOrchestrator {
     }
 }
 
+async fn current_time_ms(time: &(impl PhysicalTimeEffects + ?Sized)) -> Result<u64> {
+    Ok(time
+        .physical_time()
+        .await
+        .map_err(|e| AuraError::internal(format!("time error: {e}")))?
+        .ts_ms)
+}
+
 /// Verify a threshold signature
 pub fn verify_threshold_signature(
     signature: &ThresholdSignature,
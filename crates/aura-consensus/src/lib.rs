@@ -70,7 +70,8 @@ pub mod prelude;
 
 // Re-export core types
 pub use messages::{
-    ConsensusError, ConsensusMessage, ConsensusPhase, ConsensusRequest, ConsensusResponse,
+    ConsensusError, ConsensusMessage, ConsensusPhase, ConsensusPhaseTimings, ConsensusRequest,
+    ConsensusResponse,
 };
 pub use protocol::{run_consensus, ConsensusParams, ConsensusProtocol, ProtocolStats};
 pub use types::{CommitFact, ConflictFact, ConsensusConfig, ConsensusId, ConsensusResult};
@@ -164,6 +164,22 @@ pub struct ConsensusResponse {
     pub duration_ms: u64,
     /// Whether fast path was used
     pub fast_path: bool,
+    /// Time spent in each consensus phase
+    pub phase_timings: ConsensusPhaseTimings,
+}
+
+/// Per-phase latency of a single consensus run (milliseconds)
+///
+/// On the pooled fast path `commit_ms` only covers taking pre-generated
+/// nonces from the pool; on the slow path it includes nonce generation.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct ConsensusPhaseTimings {
+    /// Gathering nonce commitments
+    pub commit_ms: u64,
+    /// Producing partial signatures
+    pub sign_ms: u64,
+    /// Aggregating and verifying the threshold signature
+    pub aggregate_ms: u64,
 }
 
 /// Errors that can occur during consensus
@@ -13,6 +13,7 @@ use crate::{
 use aura_core::{
     crypto::tree_signing::frost_aggregate,
     effects::PhysicalTimeEffects,
+    latency::{self, LatencyStage},
     time::{PhysicalTime, ProvenancedTime, TimeStamp},
     AuraError, AuthorityId, Hash32, Result,
 };
@@ -111,6 +112,7 @@ impl ConsensusProtocol {
     where
         E: GuardEffects + GuardContextProvider + PhysicalTimeEffects,
     {
+        let coordinate_latency = latency::span(LatencyStage::ConsensusCoordinate);
         let consensus_id = message.consensus_id();
         let mut instances = self.instances.write().await;
 
@@ -177,6 +179,8 @@ impl ConsensusProtocol {
                         instance.sync_core_state();
                         instance.assert_invariants();
 
+                        // Finalization is recorded as its own stage.
+                        drop(coordinate_latency);
                         return self.finalize_consensus(consensus_id, effects).await;
                     }
                     Ok(None) => {
@@ -230,6 +234,7 @@ impl ConsensusProtocol {
     where
         E: GuardEffects + GuardContextProvider + PhysicalTimeEffects,
     {
+        let _latency = latency::span(LatencyStage::ConsensusFinalize);
         let (
             prestate_hash,
             operation_hash,
@@ -143,9 +143,25 @@ impl ConsensusProtocol {
         };
 
         // Use FROST orchestrator for the actual consensus
-        self.frost_orchestrator
+        let response = self
+            .frost_orchestrator
             .run_consensus(request, random, time)
-            .await
+            .await?;
+
+        // Refill the nonce pool once the round has settled, so the next
+        // round on this protocol takes the fast path. A failed refill only
+        // costs that round the slow path.
+        if self.config.enable_pipelining {
+            if let Err(error) = self.replenish_nonce_pool(random).await {
+                warn!(
+                    consensus_id = %response.consensus_id,
+                    error = %error,
+                    "Nonce pool replenishment failed"
+                );
+            }
+        }
+
+        Ok(response)
     }
 
     /// Finalize a DKG transcript and persist its commit reference.
@@ -164,6 +180,22 @@ impl ConsensusProtocol {
     pub async fn handle_epoch_change(&self, new_epoch: Epoch) {
         self.frost_orchestrator.handle_epoch_change(new_epoch).await;
     }
+
+    /// Top up the FROST nonce pool so upcoming rounds can take the fast path
+    ///
+    /// [`Self::run_consensus`] calls this after every round when pipelining
+    /// is enabled; call it directly to fill the pool ahead of the first one.
+    pub async fn replenish_nonce_pool(
+        &self,
+        random: &(impl RandomEffects + ?Sized),
+    ) -> Result<usize> {
+        self.frost_orchestrator.replenish_nonce_pool(random).await
+    }
+
+    /// Number of fast-path rounds the current nonce pool can still cover
+    pub async fn fast_path_rounds_available(&self) -> usize {
+        self.frost_orchestrator.fast_path_rounds_available().await
+    }
 }
 
 #[cfg(test)]
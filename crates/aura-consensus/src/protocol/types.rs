@@ -39,7 +39,10 @@ pub async fn run_consensus<T: serde::Serialize>(
     random: &(impl RandomEffects + ?Sized),
     time: &(impl PhysicalTimeEffects + ?Sized),
 ) -> Result<CommitFact> {
-    let config = ConsensusConfig::new(params.threshold, params.witnesses, params.epoch)?;
+    let mut config = ConsensusConfig::new(params.threshold, params.witnesses, params.epoch)?;
+    // The protocol is dropped after this one round, so pooled nonces could
+    // never be used.
+    config.enable_pipelining = false;
     // Derive coordinator ID deterministically from the prestate hash to keep coordination scoped to the instance.
     let prestate_hash = prestate.compute_hash();
     let mut entropy = [0u8; 32];
@@ -18,6 +18,7 @@ use aura_core::{
     crypto::tree_signing::NonceToken,
     effects::{PhysicalTimeEffects, RandomEffects},
     frost::{NonceCommitment, Share},
+    latency::{self, LatencyStage},
     AuraError, AuthorityId, OperationId, Result,
 };
 use aura_guards::guards::traits::GuardContextProvider;
@@ -172,6 +173,7 @@ impl ConsensusProtocol {
     where
         E: GuardEffects + GuardContextProvider + PhysicalTimeEffects,
     {
+        let _latency = latency::span(LatencyStage::ConsensusNonceCommit);
         let (commitment, nonce_token) = self.generate_fresh_nonce_commitment(share, random).await?;
 
         // Cache nonce token for signing when SignRequest arrives
@@ -209,6 +211,7 @@ impl ConsensusProtocol {
     where
         E: GuardEffects + GuardContextProvider + PhysicalTimeEffects,
     {
+        let _latency = latency::span(LatencyStage::ConsensusSign);
         // Retrieve cached nonce token (slow path) or generate a fresh one if missing
         let mut instances = self.instances.write().await;
         let instance = instances
@@ -14,7 +14,8 @@ use aura_core::{
 use serde::{Deserialize, Serialize};
 // use rand_chacha::rand_core::SeedableRng; // Used in tests
 use async_lock::RwLock;
-use std::collections::HashMap;
+use std::collections::{HashMap, VecDeque};
+use std::num::NonZeroUsize;
 
 /// Set of witnesses participating in consensus
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq, Eq)]
@@ -125,6 +126,9 @@ pub struct WitnessSet {
 
     /// Cached witness states for pipelining optimization
     states: RwLock<HashMap<AuthorityId, WitnessState>>,
+
+    /// Maximum pre-generated nonces held per witness and epoch
+    nonce_pool_capacity: NonZeroUsize,
 }
 
 impl WitnessSet {
@@ -152,9 +156,21 @@ impl WitnessSet {
             threshold,
             witnesses,
             states: RwLock::new(HashMap::new()),
+            nonce_pool_capacity: crate::config::ConsensusRuntimeConfig::default().nonce_pool_depth,
         })
     }
 
+    /// Bound the number of pre-generated nonces held per witness
+    pub fn with_nonce_pool_capacity(mut self, capacity: NonZeroUsize) -> Self {
+        self.nonce_pool_capacity = capacity;
+        self
+    }
+
+    /// Maximum pre-generated nonces held per witness and epoch
+    pub fn nonce_pool_capacity(&self) -> usize {
+        self.nonce_pool_capacity.get()
+    }
+
     /// Check if we have sufficient witnesses for consensus
     pub fn has_quorum(&self) -> bool {
         self.witnesses.len() >= self.threshold as usize
@@ -170,7 +186,10 @@ impl WitnessSet {
             .clone()
     }
 
-    /// Update witness state with a new cached nonce
+    /// Queue a new pre-generated nonce for a witness
+    ///
+    /// Nonces beyond the pool capacity are dropped; their commitments were
+    /// never published, so discarding them cannot cause reuse.
     pub async fn update_witness_nonce(
         &self,
         witness_id: AuthorityId,
@@ -184,10 +203,69 @@ impl WitnessSet {
             .entry(witness_id)
             .or_insert_with(|| WitnessState::new(witness_id, epoch));
 
+        if state.pooled_nonce_count(epoch) >= self.nonce_pool_capacity.get() {
+            return Ok(());
+        }
         state.set_next_nonce(commitment, token, epoch);
         Ok(())
     }
 
+    /// Number of nonces a witness still needs to fill its pool for `epoch`
+    pub async fn nonce_pool_deficit(&self, witness_id: AuthorityId, epoch: Epoch) -> usize {
+        let pooled = self
+            .states
+            .read()
+            .await
+            .get(&witness_id)
+            .map_or(0, |state| state.pooled_nonce_count(epoch));
+        self.nonce_pool_capacity.get().saturating_sub(pooled)
+    }
+
+    /// Number of fast-path rounds the pooled nonces can still cover
+    ///
+    /// Each round consumes one nonce from every pooled witness, so this is the
+    /// pool depth of the `threshold`-th best stocked witness.
+    pub async fn fast_path_rounds_available(&self, epoch: Epoch) -> usize {
+        let states = self.states.read().await;
+        let mut depths: Vec<usize> = states
+            .values()
+            .map(|state| state.pooled_nonce_count(epoch))
+            .collect();
+        depths.sort_unstable_by(|a, b| b.cmp(a));
+        depths
+            .get(usize::from(self.threshold).saturating_sub(1))
+            .copied()
+            .unwrap_or(0)
+    }
+
+    /// Atomically take one pooled nonce from every stocked witness
+    ///
+    /// Returns `None` without consuming anything when fewer than `threshold`
+    /// witnesses have a nonce for `epoch`, so a failed fast-path attempt
+    /// leaves the pool intact for the slow path.
+    pub async fn take_fast_path_nonces(
+        &self,
+        epoch: Epoch,
+    ) -> Option<HashMap<AuthorityId, (NonceCommitment, NonceToken)>> {
+        let mut states = self.states.write().await;
+        let stocked = states
+            .values()
+            .filter(|state| state.has_cached_nonce(epoch))
+            .count();
+        if stocked < self.threshold as usize {
+            return None;
+        }
+
+        Some(
+            states
+                .iter_mut()
+                .filter_map(|(witness_id, state)| {
+                    state.take_nonce(epoch).map(|nonce| (*witness_id, nonce))
+                })
+                .collect(),
+        )
+    }
+
     /// Collect available next-round commitments for fast path
     pub async fn collect_cached_commitments(
         &self,
@@ -230,8 +308,8 @@ pub struct WitnessState {
     /// Current epoch
     epoch: Epoch,
 
-    /// Cached nonce for next round (pipelining optimization)
-    next_nonce: Option<(NonceCommitment, NonceToken)>,
+    /// Pre-generated nonces for upcoming rounds, oldest first (pipelining optimization)
+    nonce_pool: VecDeque<(NonceCommitment, NonceToken)>,
 
     /// Active consensus instances this witness is participating in
     active_instances: HashMap<ConsensusId, WitnessInstance>,
@@ -243,7 +321,7 @@ impl WitnessState {
         Self {
             witness_id,
             epoch,
-            next_nonce: None,
+            nonce_pool: VecDeque::new(),
             active_instances: HashMap::new(),
         }
     }
@@ -255,35 +333,49 @@ impl WitnessState {
             return None;
         }
 
-        self.next_nonce.as_ref().map(|(commitment, _)| commitment)
+        self.nonce_pool.front().map(|(commitment, _)| commitment)
     }
 
-    /// Take the cached nonce for use in the current round
+    /// Take the oldest cached nonce for use in the current round
     pub fn take_nonce(&mut self, current_epoch: Epoch) -> Option<(NonceCommitment, NonceToken)> {
         if self.epoch != current_epoch {
-            // Epoch changed, invalidate cached nonce
-            self.next_nonce = None;
+            // Epoch changed, invalidate cached nonces
+            self.nonce_pool.clear();
             self.epoch = current_epoch;
             return None;
         }
 
-        self.next_nonce.take()
+        self.nonce_pool.pop_front()
     }
 
-    /// Cache a new nonce for the next round
+    /// Queue a new nonce for an upcoming round
+    ///
+    /// Nonces from an earlier epoch are discarded first.
     pub fn set_next_nonce(&mut self, commitment: NonceCommitment, token: NonceToken, epoch: Epoch) {
-        self.epoch = epoch;
-        self.next_nonce = Some((commitment, token));
+        if self.epoch != epoch {
+            self.nonce_pool.clear();
+            self.epoch = epoch;
+        }
+        self.nonce_pool.push_back((commitment, token));
     }
 
     /// Check if we have a cached nonce ready
     pub fn has_cached_nonce(&self, current_epoch: Epoch) -> bool {
-        self.epoch == current_epoch && self.next_nonce.is_some()
+        self.epoch == current_epoch && !self.nonce_pool.is_empty()
+    }
+
+    /// Number of cached nonces usable in `current_epoch`
+    pub fn pooled_nonce_count(&self, current_epoch: Epoch) -> usize {
+        if self.epoch == current_epoch {
+            self.nonce_pool.len()
+        } else {
+            0
+        }
     }
 
-    /// Invalidate cached nonce
+    /// Invalidate all cached nonces
     pub fn invalidate(&mut self) {
-        self.next_nonce = None;
+        self.nonce_pool.clear();
     }
 
     /// Start participating in a consensus instance
@@ -626,6 +718,55 @@ mod tests {
         assert!(!witness_set.has_fast_path_quorum(Epoch::from(1)).await);
     }
 
+    fn pooled_nonce(seed: u8) -> (NonceCommitment, NonceToken) {
+        let commitment = NonceCommitment {
+            signer: u16::from(seed),
+            commitment: vec![seed; 32],
+        };
+        let token = NonceToken::from(frost_ed25519::round1::SigningNonces::new(
+            &frost_ed25519::keys::SigningShare::deserialize([1u8; 32]).unwrap(),
+            &mut rand_chacha::ChaCha20Rng::from_seed([seed; 32]),
+        ));
+        (commitment, token)
+    }
+
+    #[tokio::test]
+    async fn test_witness_set_nonce_pool_is_bounded_and_taken_atomically() {
+        let witnesses = vec![
+            AuthorityId::new_from_entropy([1u8; 32]),
+            AuthorityId::new_from_entropy([2u8; 32]),
+            AuthorityId::new_from_entropy([3u8; 32]),
+        ];
+        let epoch = Epoch::from(1);
+        let witness_set = WitnessSet::new(2, witnesses.clone())
+            .unwrap()
+            .with_nonce_pool_capacity(NonZeroUsize::new(2).unwrap());
+
+        // One stocked witness is below threshold, so nothing is consumed
+        for seed in 0..3 {
+            let (commitment, token) = pooled_nonce(seed);
+            witness_set
+                .update_witness_nonce(witnesses[0], commitment, token, epoch)
+                .await
+                .unwrap();
+        }
+        assert_eq!(witness_set.nonce_pool_deficit(witnesses[0], epoch).await, 0);
+        assert!(witness_set.take_fast_path_nonces(epoch).await.is_none());
+
+        let (commitment, token) = pooled_nonce(9);
+        witness_set
+            .update_witness_nonce(witnesses[1], commitment, token, epoch)
+            .await
+            .unwrap();
+        assert_eq!(witness_set.fast_path_rounds_available(epoch).await, 1);
+
+        let taken = witness_set.take_fast_path_nonces(epoch).await.unwrap();
+        assert_eq!(taken.len(), 2);
+        assert_eq!(taken[&witnesses[0]].0.commitment, vec![0u8; 32]);
+        assert_eq!(witness_set.fast_path_rounds_available(epoch).await, 0);
+        assert_eq!(witness_set.nonce_pool_deficit(witnesses[0], epoch).await, 1);
+    }
+
     #[test]
     fn test_witness_tracker() {
         let mut tracker = WitnessTracker::with_threshold(2);
@@ -9,12 +9,15 @@
 //! - Single device optimization: creation, increment, get
 //! - Multiple device: creation, comparison
 //! - Sorting performance for timestamps
+//! - Canonical vs compact clock serialization and comparison
 
-use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion};
+use criterion::{black_box, criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
 use std::collections::BTreeMap;
 
+use aura_core::time::compact::DeviceTable;
 use aura_core::time::{OrderingPolicy, PhysicalTime, TimeStamp, VectorClock};
 use aura_core::types::identifiers::DeviceId;
+use aura_core::util::serialization::{from_slice, to_vec};
 
 /// Benchmark VectorClock single device operations (optimized path)
 fn bench_vectorclock_single_device(c: &mut Criterion) {
@@ -204,6 +207,89 @@ fn bench_optimization_speedup(c: &mut Criterion) {
     group.finish();
 }
 
+fn multi_device_clock(devices: usize, base: u64) -> VectorClock {
+    let mut clock = VectorClock::Multiple(BTreeMap::new());
+    for i in 0..devices {
+        let mut bytes = [0u8; 32];
+        bytes[..8].copy_from_slice(&(i as u64).to_le_bytes());
+        clock.insert(DeviceId::from_bytes(bytes), base + i as u64);
+    }
+    clock
+}
+
+/// Benchmark canonical DAG-CBOR against the compact interned encoding
+fn bench_vectorclock_serialization(c: &mut Criterion) {
+    let sizes = [1, 8, 64, 256];
+
+    let mut group = c.benchmark_group("vectorclock_serialization");
+    for size in sizes {
+        let reference = multi_device_clock(size, 1_000_000);
+        let mut clock = reference.clone();
+        if let Some((device, _)) = reference.iter().next() {
+            clock.increment(*device).expect("vector clock increment");
+        }
+
+        let mut table = DeviceTable::new();
+        let dense_reference = table.dense(&reference);
+        // Devices are already interned, so encoding leaves the table unchanged
+        let mut encoder = table.clone();
+        let canonical = to_vec(&clock).expect("canonical encoding");
+        let delta = table.encode(&clock, Some(&dense_reference));
+
+        // Throughput is per encoded byte, so criterion reports each format's size
+        group.throughput(Throughput::Bytes(canonical.len() as u64));
+        group.bench_with_input(
+            BenchmarkId::new("canonical_encode", size),
+            &clock,
+            |b, clock| {
+                b.iter(|| black_box(to_vec(black_box(clock)).expect("canonical encoding")));
+            },
+        );
+        group.bench_with_input(
+            BenchmarkId::new("canonical_decode", size),
+            &canonical,
+            |b, bytes| {
+                b.iter(|| {
+                    let decoded: VectorClock =
+                        from_slice(black_box(bytes)).expect("canonical decoding");
+                    black_box(decoded)
+                });
+            },
+        );
+        group.throughput(Throughput::Bytes(delta.len() as u64));
+        group.bench_with_input(
+            BenchmarkId::new("compact_encode", size),
+            &clock,
+            |b, clock| {
+                b.iter(|| black_box(encoder.encode(black_box(clock), Some(&dense_reference))));
+            },
+        );
+        group.bench_with_input(
+            BenchmarkId::new("compact_decode", size),
+            &delta,
+            |b, bytes| {
+                b.iter(|| {
+                    black_box(
+                        table
+                            .decode(black_box(bytes), Some(&dense_reference))
+                            .expect("compact decoding"),
+                    )
+                });
+            },
+        );
+
+        let dense_clock = table.dense(&clock);
+        group.throughput(Throughput::Elements(size as u64));
+        group.bench_function(BenchmarkId::new("btree_compare", size), |b| {
+            b.iter(|| black_box(black_box(&reference).partial_cmp(black_box(&clock))));
+        });
+        group.bench_function(BenchmarkId::new("dense_compare", size), |b| {
+            b.iter(|| black_box(black_box(&dense_reference).compare(black_box(&dense_clock))));
+        });
+    }
+    group.finish();
+}
+
 criterion_group!(
     benches,
     bench_vectorclock_single_device,
@@ -211,6 +297,7 @@ criterion_group!(
     bench_timestamp_operations,
     bench_timestamp_sorting,
     bench_optimization_speedup,
+    bench_vectorclock_serialization,
 );
 
 criterion_main!(benches);
@@ -210,6 +210,85 @@ pub fn ed25519_verify(
     Ok(pk.verify_strict(message, &sig).is_ok())
 }
 
+/// One signature check in an Ed25519 batch verification.
+///
+/// Fields are raw bytes so items can be built straight from wire payloads;
+/// lengths are validated when the batch is verified.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct Ed25519BatchItem {
+    /// Signed message bytes
+    pub message: Vec<u8>,
+    /// 64-byte signature
+    pub signature: Vec<u8>,
+    /// 32-byte verifying key
+    pub public_key: Vec<u8>,
+}
+
+impl Ed25519BatchItem {
+    /// Create a batch item.
+    pub fn new(
+        message: impl Into<Vec<u8>>,
+        signature: impl Into<Vec<u8>>,
+        public_key: impl Into<Vec<u8>>,
+    ) -> Self {
+        Self {
+            message: message.into(),
+            signature: signature.into(),
+            public_key: public_key.into(),
+        }
+    }
+}
+
+/// Verify a batch of Ed25519 signatures in one multi-scalar multiplication.
+///
+/// Returns `Ok(true)` only if every signature is valid and `Ok(false)` if
+/// any is not, without saying which; re-check items individually to find
+/// the bad one. Malformed keys or signature lengths are errors.
+///
+/// A batch acceptance implies that [`ed25519_verify`], the non-strict dalek
+/// check and FROST aggregate verification all accept each item. The batch
+/// equation alone is weaker: a key or `R` with a small-order component, or
+/// a non-canonical `R`, can pass it while failing single verification. Such
+/// items are screened out first and the batch reports `Ok(false)`, so the
+/// caller's per-signature fallback decides them. Screening decompresses each
+/// `R` and each distinct key once, which is small next to the batch itself.
+pub fn ed25519_verify_batch(items: &[Ed25519BatchItem]) -> Result<bool, crate::AuraError> {
+    if items.is_empty() {
+        return Ok(true);
+    }
+
+    let mut messages = Vec::with_capacity(items.len());
+    let mut signatures = Vec::with_capacity(items.len());
+    let mut verifying_keys = Vec::with_capacity(items.len());
+    let mut screened_keys = std::collections::BTreeSet::new();
+    let mut decidable = true;
+    for item in items {
+        let public_key: [u8; 32] = item
+            .public_key
+            .as_slice()
+            .try_into()
+            .map_err(|_| crate::AuraError::crypto("invalid public key length"))?;
+        let signature = Ed25519Signature::try_from_slice(&item.signature)?;
+        verifying_keys.push(
+            ed25519_dalek::VerifyingKey::from_bytes(&public_key)
+                .map_err(|e| crate::AuraError::crypto(e.to_string()))?,
+        );
+        signatures.push(ed25519_dalek::Signature::from_bytes(&signature.0));
+        messages.push(item.message.as_slice());
+
+        decidable = decidable
+            && frost_ed25519::Signature::deserialize(signature.0).is_ok()
+            && (screened_keys.contains(&public_key)
+                || (frost_ed25519::VerifyingKey::deserialize(public_key).is_ok()
+                    && screened_keys.insert(public_key)));
+    }
+
+    if !decidable {
+        return Ok(false);
+    }
+    Ok(ed25519_dalek::verify_batch(&messages, &signatures, &verifying_keys).is_ok())
+}
+
 /// Derive verifying key from signing key bytes.
 pub fn ed25519_verifying_key(
     signing_key: &Ed25519SigningKey,
@@ -245,6 +324,57 @@ mod tests {
         assert!(ed25519_verify(message, &decoded, &signing_key.verifying_key().unwrap()).unwrap());
     }
 
+    #[test]
+    fn batch_verify_accepts_valid_and_rejects_forged_batches() {
+        let items: Vec<Ed25519BatchItem> = (0u8..4)
+            .map(|i| {
+                let signing_key = Ed25519SigningKey::from_bytes([i + 1; 32]);
+                let message = vec![i; 16];
+                let signature = signing_key.sign(&message).expect("signing should succeed");
+                let public_key = signing_key.verifying_key().expect("valid verifying key");
+                Ed25519BatchItem::new(message, signature.0, public_key.0)
+            })
+            .collect();
+        assert!(ed25519_verify_batch(&[]).expect("empty batch"));
+        assert!(ed25519_verify_batch(&items).expect("valid batch"));
+
+        let mut forged = items.clone();
+        forged[2].message[0] ^= 0xff;
+        assert!(!ed25519_verify_batch(&forged).expect("forged batch"));
+
+        let mut truncated = items;
+        truncated[1].signature.pop();
+        assert!(ed25519_verify_batch(&truncated).is_err());
+    }
+
+    #[test]
+    fn batch_verify_defers_small_order_items_to_single_verification() {
+        let signing_key = Ed25519SigningKey::from_bytes([9u8; 32]);
+        let message = b"honest".to_vec();
+        let signature = signing_key.sign(&message).expect("signing should succeed");
+        let public_key = signing_key.verifying_key().expect("valid verifying key");
+
+        // Identity key with identity `R` and `s = 0` satisfies the batch
+        // equation for any message, but strict verification rejects it.
+        let mut identity = [0u8; 32];
+        identity[0] = 1;
+        let mut weak_signature = [0u8; 64];
+        weak_signature[..32].copy_from_slice(&identity);
+        assert!(!ed25519_verify(
+            b"forged",
+            &Ed25519Signature(weak_signature),
+            &Ed25519VerifyingKey(identity)
+        )
+        .expect("decodable key"));
+
+        let items = vec![
+            Ed25519BatchItem::new(message, signature.0, public_key.0),
+            Ed25519BatchItem::new(b"forged".to_vec(), weak_signature, identity),
+        ];
+        assert!(!ed25519_verify_batch(&items).expect("decodable batch"));
+        assert!(ed25519_verify_batch(&items[..1]).expect("honest batch"));
+    }
+
     #[test]
     fn verifying_key_roundtrip_cbor() {
         let signing_key = Ed25519SigningKey::from_bytes([11u8; 32]);
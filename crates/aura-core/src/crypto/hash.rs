@@ -67,6 +67,12 @@ pub trait Hasher: Send {
 
     /// Finalize the hasher and return the 32-byte digest.
     fn finalize(self: Box<Self>) -> [u8; 32];
+
+    /// Digest of the data absorbed so far, leaving the hasher usable.
+    ///
+    /// Lets running digests over append-only inputs be read without
+    /// re-hashing the prefix.
+    fn current(&self) -> [u8; 32];
 }
 
 /// BLAKE3 hash implementation.
@@ -94,6 +100,10 @@ impl Hasher for Blake3Hasher {
     fn finalize(self: Box<Self>) -> [u8; 32] {
         *self.0.finalize().as_bytes()
     }
+
+    fn current(&self) -> [u8; 32] {
+        *self.0.finalize().as_bytes()
+    }
 }
 
 /// ============================================================================
@@ -163,6 +173,17 @@ mod tests {
         );
     }
 
+    #[test]
+    fn test_current_digest_matches_finalize_and_keeps_hasher_usable() {
+        let mut h = hasher();
+        h.update(b"hello");
+        assert_eq!(h.current(), hash(b"hello"));
+
+        h.update(b" world");
+        assert_eq!(h.current(), hash(b"hello world"));
+        assert_eq!(h.finalize(), hash(b"hello world"));
+    }
+
     #[test]
     fn test_different_inputs_different_hashes() {
         let hash1 = hash(b"data1");
@@ -2,7 +2,7 @@
 //!
 //! Simple merkle tree utilities using pure synchronous hashing.
 
-use crate::crypto::hash::hash;
+use crate::crypto::hash::{hash, hasher};
 use crate::Result;
 
 /// Maximum depth of a merkle tree (supports up to 2^32 leaves)
@@ -293,3 +293,113 @@ pub fn build_commitment_tree(
 
     Ok((Some(root), proof))
 }
+
+/// Inclusion proof against a Merkle mountain range root
+///
+/// A mountain range over `leaf_count` leaves is a list of perfect binary
+/// trees ("peaks"), one per set bit of `leaf_count`, largest first. The root
+/// bags the peaks right to left and commits to `leaf_count`. Leaf and
+/// interior hashes carry distinct domain tags, so an interior node cannot be
+/// presented as a leaf. A proof carries the sibling path from the leaf to its
+/// peak and the other peaks, so it is `O(log n)` hashes and can be checked
+/// without the leaf set.
+#[derive(Debug, Clone, PartialEq, Eq, serde::Serialize, serde::Deserialize)]
+pub struct MerkleMountainRangeProof {
+    /// Position of the leaf in append order
+    pub leaf_index: u64,
+    /// Number of leaves in the range the proof was taken against
+    pub leaf_count: u64,
+    /// Sibling hashes from the leaf up to its peak
+    pub sibling_path: Vec<[u8; 32]>,
+    /// Every other peak, left to right
+    pub peaks: Vec<[u8; 32]>,
+}
+
+const MOUNTAIN_RANGE_LEAF_TAG: &[u8] = b"AURA_MMR_LEAF_V1";
+const MOUNTAIN_RANGE_NODE_TAG: &[u8] = b"AURA_MMR_NODE_V1";
+const MOUNTAIN_RANGE_ROOT_TAG: &[u8] = b"AURA_MMR_ROOT_V1";
+
+/// Hash a leaf value into its mountain range node: H(leaf_tag || leaf)
+pub fn mountain_range_leaf(leaf: &[u8; 32]) -> [u8; 32] {
+    let mut hasher = hasher();
+    hasher.update(MOUNTAIN_RANGE_LEAF_TAG);
+    hasher.update(leaf);
+    hasher.finalize()
+}
+
+/// Hash two child nodes into their parent: H(node_tag || left || right)
+pub fn mountain_range_node(left: &[u8; 32], right: &[u8; 32]) -> [u8; 32] {
+    let mut hasher = hasher();
+    hasher.update(MOUNTAIN_RANGE_NODE_TAG);
+    hasher.update(left);
+    hasher.update(right);
+    hasher.finalize()
+}
+
+/// Bag mountain range peaks (left to right) into a single root
+///
+/// The peaks are folded right to left and the result is hashed with
+/// `leaf_count`: H(root_tag || leaf_count || bagged). An empty range has the
+/// all-zero root.
+pub fn bag_mountain_range_peaks(peaks: &[[u8; 32]], leaf_count: u64) -> [u8; 32] {
+    let mut peaks = peaks.iter().rev();
+    let Some(last) = peaks.next() else {
+        return [0u8; 32];
+    };
+    let bagged = peaks.fold(*last, |acc, peak| mountain_range_node(peak, &acc));
+
+    let mut hasher = hasher();
+    hasher.update(MOUNTAIN_RANGE_ROOT_TAG);
+    hasher.update(&leaf_count.to_le_bytes());
+    hasher.update(&bagged);
+    hasher.finalize()
+}
+
+/// Verify that `leaf_hash` is included under a mountain range `root`
+///
+/// `leaf_hash` is the untagged leaf value; the leaf tag is applied here.
+pub fn verify_mountain_range_proof(
+    proof: &MerkleMountainRangeProof,
+    root: &[u8; 32],
+    leaf_hash: &[u8; 32],
+) -> bool {
+    if proof.leaf_index >= proof.leaf_count {
+        return false;
+    }
+
+    // Peak heights follow the set bits of the leaf count, largest first
+    let mut peak_position = 0;
+    let mut peak_height = 0;
+    let mut peak_count = 0;
+    let mut offset = 0u64;
+    for height in (0..u64::BITS).rev() {
+        if (proof.leaf_count >> height) & 1 == 0 {
+            continue;
+        }
+        let size = 1u64 << height;
+        if (offset..offset + size).contains(&proof.leaf_index) {
+            peak_position = peak_count;
+            peak_height = height as usize;
+        }
+        offset += size;
+        peak_count += 1;
+    }
+    if proof.sibling_path.len() != peak_height || proof.peaks.len() + 1 != peak_count {
+        return false;
+    }
+
+    let mut current = mountain_range_leaf(leaf_hash);
+    let mut index = proof.leaf_index;
+    for sibling in &proof.sibling_path {
+        current = if index % 2 == 0 {
+            mountain_range_node(&current, sibling)
+        } else {
+            mountain_range_node(sibling, &current)
+        };
+        index /= 2;
+    }
+
+    let mut peaks = proof.peaks.clone();
+    peaks.insert(peak_position, current);
+    &bag_mountain_range_peaks(&peaks, proof.leaf_count) == root
+}
@@ -11,8 +11,9 @@ pub mod tree_signing;
 
 // Merkle helpers
 pub use merkle::{
-    build_commitment_tree, build_merkle_root, generate_merkle_proof, verify_merkle_proof,
-    SimpleMerkleProof,
+    bag_mountain_range_peaks, build_commitment_tree, build_merkle_root, generate_merkle_proof,
+    mountain_range_leaf, mountain_range_node, verify_merkle_proof, verify_mountain_range_proof,
+    MerkleMountainRangeProof, SimpleMerkleProof,
 };
 
 // Deterministic key derivation types
@@ -20,7 +21,8 @@ pub use key_derivation::{IdentityKeyContext, KeyDerivationSpec, PermissionKeyCon
 
 // Ed25519 types and operations
 pub use ed25519::{
-    ed25519_verify, ed25519_verifying_key, Ed25519Signature, Ed25519SigningKey, Ed25519VerifyingKey,
+    ed25519_verify, ed25519_verify_batch, ed25519_verifying_key, Ed25519BatchItem,
+    Ed25519Signature, Ed25519SigningKey, Ed25519VerifyingKey,
 };
 
 // HPKE types
@@ -18,6 +18,7 @@ use crate::{hash, AuraError};
 use serde::{Deserialize, Serialize};
 use std::borrow::Borrow;
 use std::fmt;
+use std::sync::{Arc, Weak};
 use zeroize::{Zeroize, ZeroizeOnDrop};
 
 /// Maximum number of entries in the LWW map per journal.
@@ -223,6 +224,23 @@ mod tests {
         let op2 = FactOpId::for_add(&actor, FactTimestamp::new(2), &key);
         assert_ne!(op1, op2);
     }
+
+    #[test]
+    fn fact_revision_tracks_content_changes() {
+        let mut fact = Fact::new();
+        let empty = fact.revision();
+        fact.insert("entry", FactValue::Number(1)).unwrap();
+        assert_ne!(fact.revision(), empty);
+
+        let mut clone = fact.clone();
+        assert_eq!(clone.revision(), fact.revision());
+        clone.insert("other", FactValue::Number(2)).unwrap();
+        assert_ne!(clone.revision(), fact.revision());
+
+        let dropped = Fact::new().revision();
+        assert_ne!(Fact::new().revision(), dropped);
+        assert_eq!(Fact::new(), Fact::new());
+    }
 }
 
 impl fmt::Display for FactOpId {
@@ -237,12 +255,40 @@ impl fmt::Display for FactOpId {
 /// They represent knowledge that has been observed and cannot be "unlearned".
 ///
 /// Uses a proper CRDT (OR-Set with LWW-Map) for distributed consistency.
-#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+#[derive(Debug, Clone, Serialize, Deserialize)]
 pub struct Fact {
     /// CRDT-based fact storage with operation timestamps
     entries: FactCrdt,
+    /// Identity of the current state; see [`Fact::revision`]. Not part of
+    /// the content. Replaced on every mutation, shared by clones.
+    #[serde(skip)]
+    revision: Arc<()>,
+}
+
+/// Handle identifying one state of a [`Fact`] set
+///
+/// Handles compare equal only when taken from the same state. A handle keeps
+/// its state's identity reserved while held, so it never matches a later
+/// state, even one of a different fact set that replaced the original.
+#[derive(Debug, Clone)]
+pub struct FactRevision(Weak<()>);
+
+impl PartialEq for FactRevision {
+    fn eq(&self, other: &Self) -> bool {
+        Weak::ptr_eq(&self.0, &other.0)
+    }
+}
+
+impl Eq for FactRevision {}
+
+impl PartialEq for Fact {
+    fn eq(&self, other: &Self) -> bool {
+        self.entries == other.entries
+    }
 }
 
+impl Eq for Fact {}
+
 /// CRDT implementation for facts using Observed-Remove Set semantics
 #[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize, PartialOrd, Ord)]
 struct FactCrdt {
@@ -352,6 +398,7 @@ impl Fact {
                 lww_map: std::collections::BTreeMap::new(),
                 operation_set: std::collections::BTreeSet::new(),
             },
+            revision: Arc::default(),
         }
     }
 
@@ -390,6 +437,7 @@ impl Fact {
         };
 
         self.ensure_operation_capacity(&add_op)?;
+        self.revision = Arc::default();
         self.entries.operation_set.insert(add_op);
 
         // Update LWW-Map with versioned value
@@ -486,6 +534,8 @@ impl Fact {
             )));
         }
 
+        self.revision = Arc::default();
+
         // Create remove operations for each add operation
         for removed_op_id in add_ops_to_remove {
             let remove_op = FactOperation::Remove {
@@ -597,6 +647,17 @@ impl Fact {
         self.entries.operation_set.len()
     }
 
+    /// Revision of this fact state
+    ///
+    /// Changes on every mutation, join and deserialization, so two facts with
+    /// the same revision have the same content. Clones share a revision.
+    /// Revisions are tied to the fact instance rather than drawn from any
+    /// shared counter, and are never serialized; use them to key caches over
+    /// fact contents.
+    pub fn revision(&self) -> FactRevision {
+        FactRevision(Arc::downgrade(&self.revision))
+    }
+
     fn validate_value(&self, value: &FactValue) -> Result<(), AuraError> {
         if let FactValue::Bytes(bytes) = value {
             if bytes.len() > MAX_FACT_BYTES_SIZE {
@@ -683,7 +744,10 @@ impl JoinSemilattice for Fact {
             result.lww_map.insert(key.clone(), merged_val);
         }
 
-        Fact { entries: result }
+        Fact {
+            entries: result,
+            revision: Arc::default(),
+        }
     }
 }
 
@@ -43,7 +43,8 @@ pub use content::{ChunkId, ContentId, ContentSize, Hash32};
 
 // Journal
 pub use journal::{
-    ActorId, AuthLevel, Cap, Fact, FactKey, FactOpId, FactTimestamp, FactValue, Journal,
+    ActorId, AuthLevel, Cap, Fact, FactKey, FactOpId, FactRevision, FactTimestamp, FactValue,
+    Journal,
 };
 
 // Temporal database
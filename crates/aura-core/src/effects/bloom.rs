@@ -6,6 +6,7 @@
 //! # Contents
 //!
 //! - `BloomFilter`: Probabilistic set membership data structure
+//! - `ScalableBloomFilter`: Growing chain of filters for unbounded sets
 //! - `BloomConfig`: Configuration for false positive rate and capacity
 //! - `BloomError`: Error type alias for bloom operations
 //!
@@ -209,6 +210,39 @@ impl BloomFilter {
             || self.current_false_positive_rate() > self.config.false_positive_rate * 2.0
     }
 
+    /// Insert an element, setting one bit per hash function.
+    pub fn insert(&mut self, element: &[u8]) {
+        let probes = probe_hashes(element, self.config.num_hash_functions);
+        self.insert_probes(&probes);
+    }
+
+    /// Check whether an element might be in the filter.
+    pub fn might_contain(&self, element: &[u8]) -> bool {
+        let probes = probe_hashes(element, self.config.num_hash_functions);
+        self.contains_probes(&probes)
+    }
+
+    fn insert_probes(&mut self, probes: &[u64]) {
+        let k = self.config.num_hash_functions as usize;
+        for &probe in &probes[..k] {
+            let (byte_index, mask) = bit_location(probe, self.config.bit_vector_size);
+            if let Some(byte) = self.bits.get_mut(byte_index) {
+                *byte |= mask;
+            }
+        }
+        self.element_count += 1;
+    }
+
+    fn contains_probes(&self, probes: &[u64]) -> bool {
+        let k = self.config.num_hash_functions as usize;
+        probes[..k].iter().all(|&probe| {
+            let (byte_index, mask) = bit_location(probe, self.config.bit_vector_size);
+            self.bits
+                .get(byte_index)
+                .is_some_and(|byte| byte & mask != 0)
+        })
+    }
+
     /// Validate invariants after deserializing a peer-provided Bloom filter.
     pub fn validate_wire(&self) -> Result<(), BloomError> {
         self.config.validate()?;
@@ -259,6 +293,152 @@ impl<'de> Deserialize<'de> for BloomFilter {
     }
 }
 
+/// Probe hash `i` of an element: the first 8 bytes of H(i || element).
+///
+/// Probe values do not depend on filter geometry, so one set of probes can
+/// be reused across filters of different sizes.
+fn probe_hashes(element: &[u8], count: u32) -> Vec<u64> {
+    (0..u64::from(count))
+        .map(|i| {
+            let mut hasher = crate::hash::hasher();
+            hasher.update(&i.to_le_bytes());
+            hasher.update(element);
+            let digest = hasher.finalize();
+            let mut prefix = [0u8; 8];
+            prefix.copy_from_slice(&digest[..8]);
+            u64::from_le_bytes(prefix)
+        })
+        .collect()
+}
+
+fn bit_location(probe: u64, bit_vector_size: u64) -> (usize, u8) {
+    let bit_index = probe % bit_vector_size;
+    ((bit_index / 8) as usize, 1u8 << (bit_index % 8))
+}
+
+/// Bloom filter that grows with its contents
+///
+/// A single [`BloomFilter`] is sized up front and its false positive rate
+/// climbs without bound once it passes `expected_elements`. This keeps a
+/// chain of filters instead: when the newest stage is full, a stage with
+/// [`GROWTH_FACTOR`](Self::GROWTH_FACTOR) times the capacity and
+/// [`TIGHTENING_RATIO`](Self::TIGHTENING_RATIO) times the false positive
+/// rate is appended. Stage rates form a geometric series, so the compound
+/// rate stays below the target however many elements are inserted.
+///
+/// Every stage uses the standard [`BloomFilter`] probing, and probe hashes
+/// are computed once per lookup and shared across stages.
+#[derive(Debug, Clone, PartialEq)]
+pub struct ScalableBloomFilter {
+    stages: Vec<BloomFilter>,
+    initial_capacity: u64,
+    target_false_positive_rate: f64,
+    max_hash_functions: u32,
+}
+
+impl ScalableBloomFilter {
+    /// Capacity multiplier between consecutive stages
+    pub const GROWTH_FACTOR: u64 = 2;
+    /// False positive rate multiplier between consecutive stages
+    pub const TIGHTENING_RATIO: f64 = 0.5;
+
+    /// Create a filter whose compound false positive rate stays below
+    /// `false_positive_rate`
+    pub fn new(initial_capacity: u64, false_positive_rate: f64) -> Result<Self, BloomError> {
+        if false_positive_rate <= 0.0 || false_positive_rate >= 1.0 {
+            return Err(BloomError::invalid(
+                "False positive rate must be between 0.0 and 1.0",
+            ));
+        }
+        let mut filter = Self {
+            stages: Vec::new(),
+            initial_capacity: initial_capacity.max(1),
+            target_false_positive_rate: false_positive_rate,
+            max_hash_functions: 0,
+        };
+        filter.push_stage()?;
+        Ok(filter)
+    }
+
+    /// Configuration for the stage at position `stage` in the chain.
+    fn stage_config(&self, stage: usize) -> BloomConfig {
+        let stage = stage as i32;
+        let capacity = self
+            .initial_capacity
+            .saturating_mul(Self::GROWTH_FACTOR.saturating_pow(stage as u32));
+        // p_i = p * (1 - r) * r^i, which sums to at most p
+        let rate = self.target_false_positive_rate
+            * (1.0 - Self::TIGHTENING_RATIO)
+            * Self::TIGHTENING_RATIO.powi(stage);
+        BloomConfig::optimal(capacity, rate)
+    }
+
+    fn push_stage(&mut self) -> Result<(), BloomError> {
+        let config = self.stage_config(self.stages.len());
+        self.max_hash_functions = self.max_hash_functions.max(config.num_hash_functions);
+        self.stages.push(BloomFilter::new(config)?);
+        Ok(())
+    }
+
+    /// Insert an element, growing the chain if the newest stage is full.
+    pub fn insert(&mut self, element: &[u8]) -> Result<(), BloomError> {
+        let full = self
+            .stages
+            .last()
+            .is_none_or(|stage| stage.element_count >= stage.config.expected_elements);
+        if full {
+            self.push_stage()?;
+        }
+        let probes = probe_hashes(element, self.max_hash_functions);
+        if let Some(stage) = self.stages.last_mut() {
+            stage.insert_probes(&probes);
+        }
+        Ok(())
+    }
+
+    /// Check whether an element might be in any stage.
+    pub fn might_contain(&self, element: &[u8]) -> bool {
+        let probes = probe_hashes(element, self.max_hash_functions);
+        self.stages
+            .iter()
+            .any(|stage| stage.contains_probes(&probes))
+    }
+
+    /// Number of inserted elements across all stages
+    pub fn element_count(&self) -> u64 {
+        self.stages.iter().map(|stage| stage.element_count).sum()
+    }
+
+    /// Check if the filter is empty
+    pub fn is_empty(&self) -> bool {
+        self.element_count() == 0
+    }
+
+    /// Number of stages in the chain
+    pub fn stage_count(&self) -> usize {
+        self.stages.len()
+    }
+
+    /// Total size of all stage bit vectors in bytes
+    pub fn byte_size(&self) -> u64 {
+        self.stages.iter().map(BloomFilter::byte_size).sum()
+    }
+
+    /// Target compound false positive rate
+    pub fn target_false_positive_rate(&self) -> f64 {
+        self.target_false_positive_rate
+    }
+
+    /// Current compound false positive probability estimate
+    pub fn current_false_positive_rate(&self) -> f64 {
+        1.0 - self
+            .stages
+            .iter()
+            .map(|stage| 1.0 - stage.current_false_positive_rate())
+            .product::<f64>()
+    }
+}
+
 /// Helper functions for common Bloom filter operations
 impl BloomConfig {
     /// Standard configuration for OpLog sync operations
@@ -498,6 +678,33 @@ mod tests {
         assert!(filter.validate_wire().is_err());
     }
 
+    #[test]
+    fn test_bloom_filter_insert_and_query() {
+        let mut filter = BloomFilter::new(BloomConfig::for_sync(100)).unwrap();
+        filter.insert(b"present");
+        assert!(filter.might_contain(b"present"));
+        assert!(!filter.might_contain(b"absent"));
+        assert_eq!(filter.element_count, 1);
+    }
+
+    #[test]
+    fn test_scalable_filter_grows_within_target_rate() {
+        let mut filter = ScalableBloomFilter::new(100, 0.01).unwrap();
+        for i in 0..5_000u32 {
+            filter.insert(&i.to_le_bytes()).unwrap();
+        }
+
+        assert_eq!(filter.element_count(), 5_000);
+        assert!(filter.stage_count() > 1);
+        assert!((0..5_000u32).all(|i| filter.might_contain(&i.to_le_bytes())));
+        assert!(filter.current_false_positive_rate() < filter.target_false_positive_rate());
+
+        let false_positives = (5_000..15_000u32)
+            .filter(|i| filter.might_contain(&i.to_le_bytes()))
+            .count();
+        assert!(false_positives < 200, "{false_positives} false positives");
+    }
+
     #[test]
     fn test_deserialize_valid_wire_bloom_filter() {
         let filter = BloomFilter::new(BloomConfig::for_sync(10)).unwrap();
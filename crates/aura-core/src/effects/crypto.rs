@@ -22,6 +22,8 @@ use core::fmt;
 use serde::{Deserialize, Serialize};
 use zeroize::{Zeroize, ZeroizeOnDrop};
 
+pub use crate::crypto::Ed25519BatchItem;
+
 pub const MAX_KEY_PACKAGE_BYTES: usize = 65_536;
 pub const MAX_PUBLIC_KEY_PACKAGE_BYTES: usize = 65_536;
 pub const MAX_SIGNING_MESSAGE_BYTES: usize = 65_536;
@@ -213,6 +215,26 @@ pub trait CryptoCoreEffects: RandomCoreEffects + Send + Sync {
         public_key: &[u8],
     ) -> Result<bool, CryptoError>;
 
+    /// Verify many Ed25519 signatures at once
+    ///
+    /// Returns `Ok(true)` only if every item verifies; `Ok(false)` does not
+    /// identify the failing item, so callers that need to name it re-check
+    /// items individually. The default checks items one by one; handlers
+    /// backed by a real curve implementation override it with a single
+    /// batched multi-scalar multiplication. Overrides must never accept a
+    /// batch that [`Self::ed25519_verify`] would reject item by item.
+    async fn ed25519_verify_batch(&self, items: &[Ed25519BatchItem]) -> Result<bool, CryptoError> {
+        for item in items {
+            if !self
+                .ed25519_verify(&item.message, &item.signature, &item.public_key)
+                .await?
+            {
+                return Ok(false);
+            }
+        }
+        Ok(true)
+    }
+
     /// Check if this crypto handler supports simulation mode
     fn is_simulated(&self) -> bool;
 
@@ -495,6 +517,11 @@ impl<T: CryptoCoreEffects + ?Sized> CryptoCoreEffects for std::sync::Arc<T> {
             .ed25519_verify(message, signature, public_key)
             .await
     }
+
+    async fn ed25519_verify_batch(&self, items: &[Ed25519BatchItem]) -> Result<bool, CryptoError> {
+        (**self).ed25519_verify_batch(items).await
+    }
+
     fn is_simulated(&self) -> bool {
         (**self).is_simulated()
     }
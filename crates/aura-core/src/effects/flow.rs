@@ -10,9 +10,9 @@
 //! - Core trait definition belongs in Layer 1 (foundation)
 
 use crate::{
-    types::flow::{FlowCost, Receipt},
+    types::flow::{FlowCost, FlowNonce, Receipt},
     types::identifiers::{AuthorityId, ContextId},
-    AuraResult,
+    AuraError, AuraResult,
 };
 use async_trait::async_trait;
 use serde::{Deserialize, Serialize};
@@ -100,6 +100,49 @@ pub trait FlowBudgetEffects: Send + Sync {
         peer: &AuthorityId,
         cost: FlowCost,
     ) -> AuraResult<Receipt>;
+
+    /// Charge several sends to the same peer.
+    ///
+    /// Returns one receipt per cost, in order, carrying the nonces that
+    /// charging each cost in turn would have produced. The default does
+    /// exactly that; handlers backed by a single budget row should override
+    /// it to debit [`total_flow_cost`] once, so the batch is charged
+    /// atomically, and derive nonces with [`batch_charge_nonces`].
+    async fn charge_flow_batch(
+        &self,
+        context: &ContextId,
+        peer: &AuthorityId,
+        costs: &[FlowCost],
+    ) -> AuraResult<Vec<Receipt>> {
+        let mut receipts = Vec::with_capacity(costs.len());
+        for &cost in costs {
+            receipts.push(self.charge_flow(context, peer, cost).await?);
+        }
+        Ok(receipts)
+    }
+}
+
+/// Sum of a batch of flow costs, failing if it does not fit a single charge.
+pub fn total_flow_cost(costs: &[FlowCost]) -> AuraResult<FlowCost> {
+    let total: u64 = costs.iter().map(|cost| cost.as_u64()).sum();
+    FlowCost::try_from(total)
+        .map_err(|_| AuraError::budget_exceeded(format!("batch flow cost {total} overflows")))
+}
+
+/// Per-charge nonces for a batch debit that left the budget at `spent_after`.
+///
+/// Nonces track cumulative spend, so charge `i` receives the spend the budget
+/// would have reached had the costs been charged one at a time.
+pub fn batch_charge_nonces(spent_after: u64, costs: &[FlowCost]) -> Vec<FlowNonce> {
+    let total: u64 = costs.iter().map(|cost| cost.as_u64()).sum();
+    let mut spent = spent_after.saturating_sub(total);
+    costs
+        .iter()
+        .map(|cost| {
+            spent = spent.saturating_add(cost.as_u64());
+            FlowNonce::new(spent)
+        })
+        .collect()
 }
 
 #[cfg_attr(target_arch = "wasm32", async_trait(?Send))]
@@ -113,4 +156,36 @@ impl<T: FlowBudgetEffects + Send + Sync + ?Sized> FlowBudgetEffects for std::syn
     ) -> AuraResult<Receipt> {
         (**self).charge_flow(context, peer, cost).await
     }
+
+    async fn charge_flow_batch(
+        &self,
+        context: &ContextId,
+        peer: &AuthorityId,
+        costs: &[FlowCost],
+    ) -> AuraResult<Vec<Receipt>> {
+        (**self).charge_flow_batch(context, peer, costs).await
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn batch_nonces_match_sequential_charges() {
+        let costs = [FlowCost::new(3), FlowCost::new(5), FlowCost::new(2)];
+        assert_eq!(total_flow_cost(&costs).unwrap(), FlowCost::new(10));
+
+        let nonces: Vec<u64> = batch_charge_nonces(17, &costs)
+            .into_iter()
+            .map(FlowNonce::value)
+            .collect();
+        assert_eq!(nonces, vec![10, 15, 17]);
+    }
+
+    #[test]
+    fn total_flow_cost_rejects_overflow() {
+        let costs = [FlowCost::new(u32::MAX), FlowCost::new(1)];
+        assert!(total_flow_cost(&costs).is_err());
+    }
 }
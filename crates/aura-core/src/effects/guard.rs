@@ -248,6 +248,34 @@ pub trait EffectInterpreter: Send + Sync {
     /// Execute an effect command asynchronously
     async fn execute(&self, cmd: EffectCommand) -> Result<EffectResult>;
 
+    /// Charge several sends to one `(context, peer)` budget
+    ///
+    /// Returns one result per amount, in order, as `execute` would for each
+    /// `ChargeBudget`. The default executes them one by one; interpreters
+    /// whose budget store can debit the total at once should override it so
+    /// the batch is charged atomically.
+    async fn charge_budget_batch(
+        &self,
+        context: ContextId,
+        authority: AuthorityId,
+        peer: AuthorityId,
+        amounts: Vec<FlowCost>,
+    ) -> Result<Vec<EffectResult>> {
+        let mut results = Vec::with_capacity(amounts.len());
+        for amount in amounts {
+            results.push(
+                self.execute(EffectCommand::ChargeBudget {
+                    context,
+                    authority,
+                    peer,
+                    amount,
+                })
+                .await?,
+            );
+        }
+        Ok(results)
+    }
+
     /// Get interpreter type for debugging
     fn interpreter_type(&self) -> &'static str;
 }
@@ -10,8 +10,8 @@
 //! enabling O(log n) lookups by predicate, authority, and time range.
 
 use crate::{
-    domain::journal::FactValue, effects::BloomFilter, time::TimeStamp,
-    types::identifiers::AuthorityId, AuraError,
+    crypto::merkle::MerkleMountainRangeProof, domain::journal::FactValue, effects::BloomFilter,
+    time::TimeStamp, types::identifiers::AuthorityId, AuraError,
 };
 use async_trait::async_trait;
 use std::future::Future;
@@ -158,6 +158,16 @@ pub trait IndexedJournalEffects: Send + Sync {
     /// Returns `true` if the fact is included in the committed state.
     async fn verify_fact_inclusion(&self, fact: &IndexedFact) -> Result<bool, AuraError>;
 
+    /// Produce an inclusion proof for a fact against the current Merkle root.
+    ///
+    /// Returns `None` if the fact is not indexed. Peers check the proof with
+    /// [`verify_mountain_range_proof`](crate::crypto::merkle::verify_mountain_range_proof)
+    /// without holding the fact set.
+    async fn fact_inclusion_proof(
+        &self,
+        fact: &IndexedFact,
+    ) -> Result<Option<MerkleMountainRangeProof>, AuraError>;
+
     /// Get the Bloom filter for fast membership tests.
     ///
     /// This can be serialized and sent to peers for efficient
@@ -223,6 +233,13 @@ impl_arc_effect!(IndexedJournalEffects {
         (**self).verify_fact_inclusion(fact).await
     }
 
+    async fn fact_inclusion_proof(
+        &self,
+        fact: &IndexedFact,
+    ) -> Result<Option<MerkleMountainRangeProof>, AuraError> {
+        (**self).fact_inclusion_proof(fact).await
+    }
+
     async fn get_bloom_filter(&self) -> Result<BloomFilter, AuraError> {
         (**self).get_bloom_filter().await
     }
@@ -126,7 +126,7 @@ pub use biometric::{
     BiometricError, BiometricFallbackPolicy, BiometricSecurityLevel, BiometricStatistics,
     BiometricType, BiometricVerificationResult,
 };
-pub use bloom::{BloomConfig, BloomError, BloomFilter};
+pub use bloom::{BloomConfig, BloomError, BloomFilter, ScalableBloomFilter};
 pub use capability::{
     CapabilityConfig, CapabilityEffects, CapabilityError, CapabilityStatistics,
     CapabilityTokenFormat, CapabilityTokenInfo, CapabilityTokenRequest,
@@ -135,12 +135,14 @@ pub use capability::{
 #[cfg(feature = "simulation")]
 pub use chaos::{ByzantineType, ChaosEffects, ChaosError, CorruptionType, ResourceType};
 pub use console::ConsoleEffects;
-pub use crypto::{CryptoCoreEffects, CryptoEffects, CryptoError, CryptoExtendedEffects};
+pub use crypto::{
+    CryptoCoreEffects, CryptoEffects, CryptoError, CryptoExtendedEffects, Ed25519BatchItem,
+};
 pub use fact::{CheckpointInfo, FactEffects, FactError, TemporalFact};
 pub use flood::{
     FloodAction, FloodBudget, FloodError, LayeredBudget, RendezvousFlooder, RendezvousPacket,
 };
-pub use flow::{FlowBudgetEffects, FlowHint};
+pub use flow::{batch_charge_nonces, total_flow_cost, FlowBudgetEffects, FlowHint};
 pub use guardian::{GuardianAcceptInput, GuardianEffects, GuardianRequestInput};
 pub use indexed::{FactId, IndexStats, IndexedFact, IndexedJournalEffects};
 pub use intent::{
@@ -0,0 +1,789 @@
+//! Hot-path latency histograms
+//!
+//! A low-overhead recording surface for the stages that dominate message
+//! latency: guard-chain phases, anti-entropy rounds, transport framing,
+//! journal reduction and consensus phases.
+//!
+//! # Design
+//!
+//! - Each thread records into its own shard of log-linear (HDR-style)
+//!   histograms, so the hot path is a handful of relaxed atomic adds on
+//!   memory no other thread writes.
+//! - Shards are merged only when [`LatencyRecorder::snapshot`] is called
+//!   (scrape time). Shards of exited threads are folded into a retired
+//!   aggregate so short-lived threads do not grow the registry.
+//! - Time comes from a [`LatencyClock`] supplied by the caller. Production
+//!   runtimes install a monotonic clock from `aura-effects`; the simulator
+//!   installs its virtual clock so recorded latencies stay deterministic.
+//! - When no recorder is installed, or the installed one is disabled,
+//!   [`span`] is a task-local check and a single atomic load and returns
+//!   `None`.
+//! - [`scope`] runs a future against its own recorder instead of the
+//!   process-wide one, so parallel simulations (one per seed) each collect
+//!   their own histograms. Tasks spawned from inside the scope do not
+//!   inherit it and record to the global recorder.
+//!
+//! Snapshots are serializable (for OpenTelemetry bridges) and can be rendered
+//! as Prometheus summaries via [`LatencySnapshot::export_prometheus`].
+//!
+//! # Example
+//!
+//! ```ignore
+//! use aura_core::latency::{self, LatencyStage};
+//!
+//! fn merge_ops() {
+//!     let _latency = latency::span(LatencyStage::AntiEntropyMerge);
+//!     // ... work measured until `_latency` is dropped ...
+//! }
+//! ```
+
+// The shard registry is touched only when a thread records for the first time
+// and at scrape time; a runtime-agnostic std mutex is intentional here.
+#![allow(clippy::disallowed_types)]
+
+use serde::{Deserialize, Serialize};
+use std::cell::RefCell;
+use std::collections::BTreeMap;
+use std::fmt::Write as _;
+use std::future::Future;
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+use std::sync::{Arc, Mutex, OnceLock, PoisonError, Weak};
+
+/// Number of linear sub-buckets per power of two (2^5 = 32, ~3% error).
+const SUB_BITS: u32 = 5;
+const SUB_COUNT: u64 = 1 << SUB_BITS;
+/// Largest tracked magnitude; longer samples saturate (2^40 ns ≈ 18 minutes).
+const MAX_BITS: u32 = 40;
+const MAX_VALUE: u64 = (1 << MAX_BITS) - 1;
+const BUCKET_COUNT: usize = (SUB_COUNT + (MAX_BITS - SUB_BITS) as u64 * SUB_COUNT) as usize;
+
+/// Instrumented hot-path stages
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord, Hash, Serialize, Deserialize)]
+pub enum LatencyStage {
+    /// Biscuit/capability authorization inside the guard chain
+    GuardAuthorization,
+    /// Flow-budget charge inside the guard chain
+    GuardFlowCharge,
+    /// Journal coupling of guard-produced facts
+    GuardJournalCouple,
+    /// Anti-entropy digest computation
+    AntiEntropyDigest,
+    /// Anti-entropy reconciliation planning (push/pull sets)
+    AntiEntropyPlan,
+    /// Anti-entropy merge of remote operations
+    AntiEntropyMerge,
+    /// Transport frame serialization
+    FrameSerialize,
+    /// Transport frame write and flush
+    FrameSend,
+    /// Journal fact reduction to authority/context state
+    Reduction,
+    /// Consensus witness nonce commitment
+    ConsensusNonceCommit,
+    /// Consensus witness signature share generation
+    ConsensusSign,
+    /// Consensus coordinator message handling, excluding finalization
+    ConsensusCoordinate,
+    /// Consensus share aggregation and commit fact construction
+    ConsensusFinalize,
+}
+
+impl LatencyStage {
+    /// All stages in declaration order
+    pub const ALL: [LatencyStage; 13] = [
+        LatencyStage::GuardAuthorization,
+        LatencyStage::GuardFlowCharge,
+        LatencyStage::GuardJournalCouple,
+        LatencyStage::AntiEntropyDigest,
+        LatencyStage::AntiEntropyPlan,
+        LatencyStage::AntiEntropyMerge,
+        LatencyStage::FrameSerialize,
+        LatencyStage::FrameSend,
+        LatencyStage::Reduction,
+        LatencyStage::ConsensusNonceCommit,
+        LatencyStage::ConsensusSign,
+        LatencyStage::ConsensusCoordinate,
+        LatencyStage::ConsensusFinalize,
+    ];
+
+    /// Stable metric label for this stage
+    pub const fn name(self) -> &'static str {
+        match self {
+            LatencyStage::GuardAuthorization => "guard.authorization",
+            LatencyStage::GuardFlowCharge => "guard.flow_charge",
+            LatencyStage::GuardJournalCouple => "guard.journal_couple",
+            LatencyStage::AntiEntropyDigest => "anti_entropy.digest",
+            LatencyStage::AntiEntropyPlan => "anti_entropy.plan",
+            LatencyStage::AntiEntropyMerge => "anti_entropy.merge",
+            LatencyStage::FrameSerialize => "transport.frame_serialize",
+            LatencyStage::FrameSend => "transport.frame_send",
+            LatencyStage::Reduction => "journal.reduction",
+            LatencyStage::ConsensusNonceCommit => "consensus.nonce_commit",
+            LatencyStage::ConsensusSign => "consensus.sign",
+            LatencyStage::ConsensusCoordinate => "consensus.coordinate",
+            LatencyStage::ConsensusFinalize => "consensus.finalize",
+        }
+    }
+
+    const fn index(self) -> usize {
+        self as usize
+    }
+}
+
+/// Time source for latency measurement
+///
+/// Implementations must be monotonic. Layer 1 only defines the interface:
+/// `aura-effects` provides a wall-clock implementation and the simulator
+/// provides one backed by virtual time.
+pub trait LatencyClock: Send + Sync {
+    /// Current reading in nanoseconds from an arbitrary fixed origin
+    fn now_nanos(&self) -> u64;
+}
+
+fn bucket_index(value: u64) -> usize {
+    let value = value.min(MAX_VALUE);
+    if value < SUB_COUNT {
+        return value as usize;
+    }
+    let exponent = 63 - value.leading_zeros();
+    let shift = exponent - SUB_BITS;
+    let sub = (value >> shift) - SUB_COUNT;
+    (SUB_COUNT + u64::from(shift) * SUB_COUNT + sub) as usize
+}
+
+/// Largest value that maps to `index`.
+fn bucket_upper_bound(index: usize) -> u64 {
+    let index = index as u64;
+    if index < SUB_COUNT {
+        return index;
+    }
+    let shift = (index - SUB_COUNT) / SUB_COUNT;
+    let sub = (index - SUB_COUNT) % SUB_COUNT + SUB_COUNT;
+    ((sub + 1) << shift) - 1
+}
+
+/// Per-stage atomic histogram owned by one thread's shard.
+struct StageCells {
+    count: AtomicU64,
+    sum: AtomicU64,
+    max: AtomicU64,
+    buckets: OnceLock<Box<[AtomicU64]>>,
+}
+
+impl StageCells {
+    const fn new() -> Self {
+        Self {
+            count: AtomicU64::new(0),
+            sum: AtomicU64::new(0),
+            max: AtomicU64::new(0),
+            buckets: OnceLock::new(),
+        }
+    }
+
+    fn record(&self, nanos: u64) {
+        let buckets = self
+            .buckets
+            .get_or_init(|| (0..BUCKET_COUNT).map(|_| AtomicU64::new(0)).collect());
+        buckets[bucket_index(nanos)].fetch_add(1, Ordering::Relaxed);
+        self.count.fetch_add(1, Ordering::Relaxed);
+        self.sum.fetch_add(nanos, Ordering::Relaxed);
+        self.max.fetch_max(nanos, Ordering::Relaxed);
+    }
+
+    fn merge_into(&self, target: &mut LatencyHistogram) {
+        let Some(buckets) = self.buckets.get() else {
+            return;
+        };
+        for (index, cell) in buckets.iter().enumerate() {
+            let hits = cell.load(Ordering::Relaxed);
+            if hits > 0 {
+                *target.buckets.entry(index as u32).or_default() += hits;
+            }
+        }
+        target.count += self.count.load(Ordering::Relaxed);
+        target.sum_nanos = target
+            .sum_nanos
+            .saturating_add(self.sum.load(Ordering::Relaxed));
+        target.max_nanos = target.max_nanos.max(self.max.load(Ordering::Relaxed));
+    }
+}
+
+struct Shard {
+    stages: [StageCells; LatencyStage::ALL.len()],
+}
+
+impl Shard {
+    fn new() -> Self {
+        Self {
+            stages: std::array::from_fn(|_| StageCells::new()),
+        }
+    }
+
+    fn merge_into(&self, target: &mut BTreeMap<LatencyStage, LatencyHistogram>) {
+        for stage in LatencyStage::ALL {
+            let mut histogram = LatencyHistogram::default();
+            self.stages[stage.index()].merge_into(&mut histogram);
+            if histogram.count > 0 {
+                target.entry(stage).or_default().merge(&histogram);
+            }
+        }
+    }
+}
+
+/// Shards owned by one recorder
+///
+/// The registry holds the only strong reference to each shard; the recording
+/// thread keeps a [`Weak`] one, so a dropped recorder frees its shards and an
+/// exited thread leaves its shard with no weak references.
+#[derive(Default)]
+struct ShardRegistry {
+    live: Vec<Arc<Shard>>,
+    retired: BTreeMap<LatencyStage, LatencyHistogram>,
+}
+
+thread_local! {
+    static LOCAL_SHARDS: RefCell<Vec<(u64, Weak<Shard>)>> = const { RefCell::new(Vec::new()) };
+}
+
+static NEXT_RECORDER_ID: AtomicU64 = AtomicU64::new(1);
+
+/// Latency recorder with per-thread shards merged on scrape
+pub struct LatencyRecorder {
+    id: u64,
+    enabled: AtomicBool,
+    clock: Arc<dyn LatencyClock>,
+    registry: Mutex<ShardRegistry>,
+}
+
+impl std::fmt::Debug for LatencyRecorder {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("LatencyRecorder")
+            .field("id", &self.id)
+            .field("enabled", &self.is_enabled())
+            .finish_non_exhaustive()
+    }
+}
+
+impl LatencyRecorder {
+    /// Create an enabled recorder reading time from `clock`
+    pub fn new(clock: Arc<dyn LatencyClock>) -> Self {
+        Self {
+            id: NEXT_RECORDER_ID.fetch_add(1, Ordering::Relaxed),
+            enabled: AtomicBool::new(true),
+            clock,
+            registry: Mutex::new(ShardRegistry::default()),
+        }
+    }
+
+    /// Whether samples are currently being recorded
+    pub fn is_enabled(&self) -> bool {
+        self.enabled.load(Ordering::Relaxed)
+    }
+
+    /// Enable or disable recording without discarding collected samples
+    pub fn set_enabled(&self, enabled: bool) {
+        self.enabled.store(enabled, Ordering::Relaxed);
+    }
+
+    /// Start timing `stage`; the sample is recorded when the span drops
+    pub fn span(&self, stage: LatencyStage) -> Option<LatencySpan<'_>> {
+        LatencySpan::start(SpanRecorder::Borrowed(self), stage)
+    }
+
+    /// Record an externally measured sample
+    pub fn record_nanos(&self, stage: LatencyStage, nanos: u64) {
+        if !self.is_enabled() {
+            return;
+        }
+        self.with_local_shard(|shard| shard.stages[stage.index()].record(nanos));
+    }
+
+    /// Merge all thread shards into a point-in-time snapshot
+    pub fn snapshot(&self) -> LatencySnapshot {
+        let mut registry = self.registry.lock().unwrap_or_else(PoisonError::into_inner);
+        let ShardRegistry { live, retired } = &mut *registry;
+
+        // A shard no thread references belongs to an exited thread: nothing
+        // can write to it anymore, so fold it into the retired totals.
+        live.retain(|shard| {
+            if Arc::weak_count(shard) == 0 {
+                shard.merge_into(retired);
+                false
+            } else {
+                true
+            }
+        });
+
+        let mut stages = retired.clone();
+        for shard in live.iter() {
+            shard.merge_into(&mut stages);
+        }
+        LatencySnapshot { stages }
+    }
+
+    fn with_local_shard<R>(&self, f: impl FnOnce(&Shard) -> R) -> R {
+        LOCAL_SHARDS.with(|cell| {
+            let mut shards = cell.borrow_mut();
+            if let Some(shard) = shards
+                .iter()
+                .find(|(id, _)| *id == self.id)
+                .and_then(|(_, shard)| shard.upgrade())
+            {
+                return f(&shard);
+            }
+            // Entries of dropped recorders no longer upgrade; prune them here
+            // so the list stays as long as the set of live recorders.
+            shards.retain(|(_, shard)| shard.strong_count() > 0);
+            let shard = Arc::new(Shard::new());
+            shards.push((self.id, Arc::downgrade(&shard)));
+            let result = f(&shard);
+            self.registry
+                .lock()
+                .unwrap_or_else(PoisonError::into_inner)
+                .live
+                .push(shard);
+            result
+        })
+    }
+}
+
+/// Recorder a span reports to: borrowed, or shared with a [`scope`].
+enum SpanRecorder<'a> {
+    Borrowed(&'a LatencyRecorder),
+    Scoped(Arc<LatencyRecorder>),
+}
+
+impl std::ops::Deref for SpanRecorder<'_> {
+    type Target = LatencyRecorder;
+
+    fn deref(&self) -> &LatencyRecorder {
+        match self {
+            Self::Borrowed(recorder) => recorder,
+            Self::Scoped(recorder) => recorder,
+        }
+    }
+}
+
+/// In-flight measurement of one stage; records on drop
+#[must_use = "a latency span records when dropped; bind it to a named variable"]
+pub struct LatencySpan<'a> {
+    recorder: SpanRecorder<'a>,
+    stage: LatencyStage,
+    started_at: u64,
+}
+
+impl<'a> LatencySpan<'a> {
+    fn start(recorder: SpanRecorder<'a>, stage: LatencyStage) -> Option<Self> {
+        if !recorder.is_enabled() {
+            return None;
+        }
+        let started_at = recorder.clock.now_nanos();
+        Some(Self {
+            recorder,
+            stage,
+            started_at,
+        })
+    }
+}
+
+impl Drop for LatencySpan<'_> {
+    fn drop(&mut self) {
+        let elapsed = self
+            .recorder
+            .clock
+            .now_nanos()
+            .saturating_sub(self.started_at);
+        self.recorder.record_nanos(self.stage, elapsed);
+    }
+}
+
+/// Merged histogram for one stage
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize, Deserialize)]
+pub struct LatencyHistogram {
+    /// Number of samples
+    pub count: u64,
+    /// Sum of all samples in nanoseconds (saturating)
+    pub sum_nanos: u64,
+    /// Largest sample in nanoseconds
+    pub max_nanos: u64,
+    /// Sparse bucket index → sample count
+    buckets: BTreeMap<u32, u64>,
+}
+
+impl LatencyHistogram {
+    /// Record a single sample
+    pub fn record(&mut self, nanos: u64) {
+        *self.buckets.entry(bucket_index(nanos) as u32).or_default() += 1;
+        self.count += 1;
+        self.sum_nanos = self.sum_nanos.saturating_add(nanos);
+        self.max_nanos = self.max_nanos.max(nanos);
+    }
+
+    /// Merge another histogram into this one
+    pub fn merge(&mut self, other: &LatencyHistogram) {
+        for (index, hits) in &other.buckets {
+            *self.buckets.entry(*index).or_default() += hits;
+        }
+        self.count += other.count;
+        self.sum_nanos = self.sum_nanos.saturating_add(other.sum_nanos);
+        self.max_nanos = self.max_nanos.max(other.max_nanos);
+    }
+
+    /// Samples recorded after `earlier`, an older snapshot of this histogram
+    ///
+    /// A maximum cannot be windowed, so `max_nanos` stays the lifetime value.
+    pub fn since(&self, earlier: &LatencyHistogram) -> LatencyHistogram {
+        let buckets = self
+            .buckets
+            .iter()
+            .filter_map(|(index, hits)| {
+                let before = earlier.buckets.get(index).copied().unwrap_or(0);
+                let window = hits.saturating_sub(before);
+                (window > 0).then_some((*index, window))
+            })
+            .collect();
+        LatencyHistogram {
+            count: self.count.saturating_sub(earlier.count),
+            sum_nanos: self.sum_nanos.saturating_sub(earlier.sum_nanos),
+            max_nanos: self.max_nanos,
+            buckets,
+        }
+    }
+
+    /// Value at quantile `q` (0.0..=1.0), as a bucket upper bound in nanoseconds
+    pub fn quantile(&self, q: f64) -> u64 {
+        if self.count == 0 {
+            return 0;
+        }
+        let rank = ((q.clamp(0.0, 1.0) * self.count as f64).ceil() as u64).max(1);
+        let mut seen = 0;
+        for (index, hits) in &self.buckets {
+            seen += hits;
+            if seen >= rank {
+                return bucket_upper_bound(*index as usize).min(self.max_nanos);
+            }
+        }
+        self.max_nanos
+    }
+
+    /// Mean sample in nanoseconds
+    pub fn mean_nanos(&self) -> u64 {
+        self.sum_nanos.checked_div(self.count).unwrap_or(0)
+    }
+
+    /// Non-empty buckets as `(upper_bound_nanos, count)` in ascending order
+    ///
+    /// Suitable for building explicit-bucket histogram data points.
+    pub fn buckets(&self) -> impl Iterator<Item = (u64, u64)> + '_ {
+        self.buckets
+            .iter()
+            .map(|(index, hits)| (bucket_upper_bound(*index as usize), *hits))
+    }
+}
+
+/// Point-in-time latency histograms for every recorded stage
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize, Deserialize)]
+pub struct LatencySnapshot {
+    /// Histograms keyed by stage; stages without samples are absent
+    pub stages: BTreeMap<LatencyStage, LatencyHistogram>,
+}
+
+impl LatencySnapshot {
+    /// Quantiles exported as Prometheus summary series
+    pub const EXPORTED_QUANTILES: [f64; 4] = [0.5, 0.9, 0.99, 0.999];
+
+    /// Histogram for `stage`, if any samples were recorded
+    pub fn stage(&self, stage: LatencyStage) -> Option<&LatencyHistogram> {
+        self.stages.get(&stage)
+    }
+
+    /// Merge another snapshot (e.g. from another recorder or process)
+    pub fn merge(&mut self, other: &LatencySnapshot) {
+        for (stage, histogram) in &other.stages {
+            self.stages.entry(*stage).or_default().merge(histogram);
+        }
+    }
+
+    /// Samples recorded after `earlier`, an older snapshot of the same recorder
+    pub fn since(&self, earlier: &LatencySnapshot) -> LatencySnapshot {
+        let stages = self
+            .stages
+            .iter()
+            .filter_map(|(stage, histogram)| {
+                let window = match earlier.stages.get(stage) {
+                    Some(before) => histogram.since(before),
+                    None => histogram.clone(),
+                };
+                (window.count > 0).then_some((*stage, window))
+            })
+            .collect();
+        LatencySnapshot { stages }
+    }
+
+    /// Render as a Prometheus summary in the text exposition format
+    pub fn export_prometheus(&self) -> String {
+        const METRIC: &str = "aura_stage_latency_seconds";
+        let mut output = String::new();
+        let _ = writeln!(output, "# HELP {METRIC} Hot-path stage latency");
+        let _ = writeln!(output, "# TYPE {METRIC} summary");
+        for (stage, histogram) in &self.stages {
+            let name = stage.name();
+            for q in Self::EXPORTED_QUANTILES {
+                let _ = writeln!(
+                    output,
+                    "{METRIC}{{stage=\"{name}\",quantile=\"{q}\"}} {}",
+                    nanos_to_seconds(histogram.quantile(q))
+                );
+            }
+            let _ = writeln!(
+                output,
+                "{METRIC}_sum{{stage=\"{name}\"}} {}",
+                nanos_to_seconds(histogram.sum_nanos)
+            );
+            let _ = writeln!(
+                output,
+                "{METRIC}_count{{stage=\"{name}\"}} {}",
+                histogram.count
+            );
+        }
+        output
+    }
+}
+
+fn nanos_to_seconds(nanos: u64) -> f64 {
+    nanos as f64 / 1_000_000_000.0
+}
+
+static GLOBAL_RECORDER: OnceLock<LatencyRecorder> = OnceLock::new();
+
+tokio::task_local! {
+    static SCOPED_RECORDER: Arc<LatencyRecorder>;
+}
+
+/// Install the process-wide recorder used by [`span`]
+///
+/// Returns the recorder back if one was already installed.
+pub fn install_global(
+    recorder: LatencyRecorder,
+) -> Result<&'static LatencyRecorder, LatencyRecorder> {
+    GLOBAL_RECORDER.set(recorder)?;
+    Ok(global().unwrap_or_else(|| unreachable!("global latency recorder was just installed")))
+}
+
+/// The process-wide recorder, if installed
+pub fn global() -> Option<&'static LatencyRecorder> {
+    GLOBAL_RECORDER.get()
+}
+
+/// Run `future` with `recorder` in place of the global recorder
+///
+/// Spans started by the future itself, on whichever worker thread polls it,
+/// record to `recorder`. Tasks it spawns are outside the scope.
+pub async fn scope<F: Future>(recorder: Arc<LatencyRecorder>, future: F) -> F::Output {
+    SCOPED_RECORDER.scope(recorder, future).await
+}
+
+/// Run a synchronous closure with `recorder` in place of the global recorder
+pub fn sync_scope<R>(recorder: Arc<LatencyRecorder>, f: impl FnOnce() -> R) -> R {
+    SCOPED_RECORDER.sync_scope(recorder, f)
+}
+
+/// Start timing `stage` on the scoped recorder, or the global one outside a
+/// [`scope`]
+///
+/// Returns `None` without reading the clock when no recorder is installed or
+/// recording is disabled.
+#[inline]
+pub fn span(stage: LatencyStage) -> Option<LatencySpan<'static>> {
+    if let Ok(span) = SCOPED_RECORDER
+        .try_with(|recorder| LatencySpan::start(SpanRecorder::Scoped(Arc::clone(recorder)), stage))
+    {
+        return span;
+    }
+    LatencySpan::start(SpanRecorder::Borrowed(global()?), stage)
+}
+
+/// Time a synchronous closure on the current recorder
+#[inline]
+pub fn timed<R>(stage: LatencyStage, f: impl FnOnce() -> R) -> R {
+    let _latency = span(stage);
+    f()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Clock that advances by a fixed step on every reading.
+    struct SteppingClock {
+        now: AtomicU64,
+        step: u64,
+    }
+
+    impl LatencyClock for SteppingClock {
+        fn now_nanos(&self) -> u64 {
+            self.now.fetch_add(self.step, Ordering::Relaxed)
+        }
+    }
+
+    fn recorder(step: u64) -> LatencyRecorder {
+        LatencyRecorder::new(Arc::new(SteppingClock {
+            now: AtomicU64::new(0),
+            step,
+        }))
+    }
+
+    #[test]
+    fn buckets_cover_range_with_bounded_error() {
+        assert_eq!(bucket_index(0), 0);
+        assert_eq!(bucket_index(31), 31);
+        assert_eq!(bucket_index(63), 63);
+        assert_eq!(bucket_index(u64::MAX), BUCKET_COUNT - 1);
+        assert_eq!(bucket_upper_bound(BUCKET_COUNT - 1), MAX_VALUE);
+
+        for value in [1, 32, 100, 1_000, 65_537, 12_345_678, 999_999_999_999] {
+            let upper = bucket_upper_bound(bucket_index(value));
+            assert!(upper >= value);
+            assert!((upper - value) as f64 <= value as f64 / SUB_COUNT as f64);
+        }
+        for index in 1..BUCKET_COUNT {
+            assert_eq!(bucket_index(bucket_upper_bound(index)), index);
+        }
+    }
+
+    #[test]
+    fn spans_merge_across_threads() {
+        let recorder = recorder(1_000);
+        std::thread::scope(|s| {
+            for _ in 0..4 {
+                s.spawn(|| {
+                    for _ in 0..25 {
+                        let _latency = recorder.span(LatencyStage::FrameSend);
+                    }
+                });
+            }
+        });
+        recorder.record_nanos(LatencyStage::Reduction, 5_000);
+
+        let snapshot = recorder.snapshot();
+        let send = snapshot.stage(LatencyStage::FrameSend).unwrap();
+        assert_eq!(send.count, 100);
+        assert_eq!(send.sum_nanos, 100_000);
+        assert_eq!(send.quantile(0.99), 1_000);
+        assert_eq!(snapshot.stage(LatencyStage::Reduction).unwrap().count, 1);
+
+        // Exited threads were retired; a second scrape sees the same totals.
+        assert_eq!(recorder.snapshot(), snapshot);
+    }
+
+    #[test]
+    fn scoped_recorders_are_isolated() {
+        let first = Arc::new(recorder(1_000));
+        let second = Arc::new(recorder(1_000));
+        std::thread::scope(|s| {
+            for (recorder, samples) in [(&first, 3), (&second, 5)] {
+                s.spawn(move || {
+                    sync_scope(Arc::clone(recorder), || {
+                        for _ in 0..samples {
+                            timed(LatencyStage::Reduction, || ());
+                        }
+                    });
+                });
+            }
+        });
+
+        let count = |recorder: &LatencyRecorder| {
+            recorder
+                .snapshot()
+                .stage(LatencyStage::Reduction)
+                .map_or(0, |histogram| histogram.count)
+        };
+        assert_eq!(count(&first), 3);
+        assert_eq!(count(&second), 5);
+    }
+
+    #[test]
+    fn dropped_recorders_leave_no_thread_shards() {
+        // A fresh thread, so no other recorder has shards in its list.
+        std::thread::scope(|s| {
+            s.spawn(|| {
+                for _ in 0..16 {
+                    recorder(10).record_nanos(LatencyStage::FrameSend, 10);
+                }
+                let kept = recorder(10);
+                kept.record_nanos(LatencyStage::FrameSend, 10);
+                kept.record_nanos(LatencyStage::FrameSend, 10);
+
+                LOCAL_SHARDS.with(|cell| {
+                    let shards = cell.borrow();
+                    assert_eq!(shards.len(), 1);
+                    assert_eq!(shards[0].0, kept.id);
+                });
+                assert_eq!(
+                    kept.snapshot()
+                        .stage(LatencyStage::FrameSend)
+                        .unwrap()
+                        .count,
+                    2
+                );
+            });
+        });
+    }
+
+    #[test]
+    fn disabled_recorder_skips_samples() {
+        let recorder = recorder(10);
+        recorder.set_enabled(false);
+        assert!(recorder.span(LatencyStage::GuardAuthorization).is_none());
+        recorder.record_nanos(LatencyStage::GuardAuthorization, 10);
+        assert!(recorder.snapshot().stages.is_empty());
+
+        recorder.set_enabled(true);
+        drop(recorder.span(LatencyStage::GuardAuthorization));
+        assert_eq!(recorder.snapshot().stages.len(), 1);
+    }
+
+    #[test]
+    fn quantiles_track_tail() {
+        let mut histogram = LatencyHistogram::default();
+        for _ in 0..990 {
+            histogram.record(1_000);
+        }
+        for _ in 0..10 {
+            histogram.record(1_000_000);
+        }
+        assert!(histogram.quantile(0.5) <= 1_031);
+        assert!(histogram.quantile(0.999) >= 1_000_000);
+        assert_eq!(histogram.quantile(1.0), 1_000_000);
+        assert_eq!(histogram.mean_nanos(), 10_990);
+    }
+
+    #[test]
+    fn snapshot_since_windows_new_samples() {
+        let recorder = recorder(0);
+        recorder.record_nanos(LatencyStage::FrameSerialize, 100);
+        recorder.record_nanos(LatencyStage::Reduction, 100);
+        let earlier = recorder.snapshot();
+        recorder.record_nanos(LatencyStage::FrameSerialize, 5_000);
+        recorder.record_nanos(LatencyStage::FrameSerialize, 5_000);
+
+        let window = recorder.snapshot().since(&earlier);
+        assert!(window.stage(LatencyStage::Reduction).is_none());
+        let serialize = window.stage(LatencyStage::FrameSerialize).unwrap();
+        assert_eq!(serialize.count, 2);
+        assert_eq!(serialize.sum_nanos, 10_000);
+        assert_eq!(serialize.quantile(0.5), 5_000);
+    }
+
+    #[test]
+    fn prometheus_export_lists_quantiles_per_stage() {
+        let recorder = recorder(2_000_000);
+        drop(recorder.span(LatencyStage::AntiEntropyMerge));
+        let text = recorder.snapshot().export_prometheus();
+        assert!(text.contains("# TYPE aura_stage_latency_seconds summary"));
+        assert!(text.contains(
+            "aura_stage_latency_seconds{stage=\"anti_entropy.merge\",quantile=\"0.99\"} 0.002"
+        ));
+        assert!(text.contains("aura_stage_latency_seconds_count{stage=\"anti_entropy.merge\"} 1"));
+    }
+}
@@ -126,6 +126,8 @@ pub mod constants;
 pub mod faults;
 /// Trusted key-resolution interfaces for verifier boundaries.
 pub mod key_resolution;
+/// Per-thread latency histograms for hot-path stages
+pub mod latency;
 /// Convenient re-exports of commonly used types
 pub mod prelude;
 /// Protocol types for version negotiation and capabilities
@@ -154,7 +156,8 @@ pub use byzantine::{
 pub use capability_name::{CapabilityName, CapabilityNameError};
 #[doc = "stable: Core journal types with semver guarantees"]
 pub use domain::journal::{
-    ActorId, AuthLevel, Cap, Fact, FactKey, FactOpId, FactTimestamp, FactValue, Journal,
+    ActorId, AuthLevel, Cap, Fact, FactKey, FactOpId, FactRevision, FactTimestamp, FactValue,
+    Journal,
 };
 pub use secrets::{
     EncryptedSecretBlob, PrivateKeyBytes, SecretBytes, SecretExportContext, SecretExportKind,
@@ -0,0 +1,466 @@
+//! Compact vector clock encoding
+//!
+//! The canonical DAG-CBOR form of a [`VectorClock`] spells out every
+//! `DeviceId` key next to a full-width counter, so in contexts with many
+//! devices the clock dominates the size of a fact. A [`DeviceTable`] shared
+//! by the members of a context interns each device once and replaces it with
+//! a small index. On top of it:
+//! - [`DenseClock`] holds counters in a `Vec<u64>` indexed by device index;
+//!   [`DenseClock::compare`] is a branch-light loop over two slices that the
+//!   compiler can vectorize;
+//! - [`DeviceTable::encode`] writes entries as LEB128 varints with counters
+//!   delta-encoded against an optional reference clock that both sides hold
+//!   (typically the last clock exchanged), so steady-state clocks cost a few
+//!   bytes per entry.
+//!
+//! Decoding restores the exact `VectorClock` value, including its `Single`
+//! or `Multiple` form and explicit zero entries. The canonical serde format
+//! is unchanged: content hashes of stored facts are computed over it.
+
+use super::{LogicalTime, VectorClock};
+use crate::{types::identifiers::DeviceId, AuraError};
+use serde::{Deserialize, Serialize};
+use std::cmp::Ordering;
+use std::collections::BTreeMap;
+
+/// Form tag of a `VectorClock::Multiple` clock.
+const FORM_MULTIPLE: u8 = 0;
+/// Form tag of a `VectorClock::Single` clock.
+const FORM_SINGLE: u8 = 1;
+
+/// Counters compared per step of the dense comparison loop.
+const COMPARE_LANES: usize = 8;
+
+/// Per-context table assigning each device a dense index.
+///
+/// Indexes are assigned in first-seen order and never reused, so peers that
+/// intern the same devices in the same order agree on every index. The
+/// serialized form is the device list alone.
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize, Deserialize)]
+#[serde(try_from = "Vec<DeviceId>", into = "Vec<DeviceId>")]
+pub struct DeviceTable {
+    devices: Vec<DeviceId>,
+    indexes: BTreeMap<DeviceId, u32>,
+}
+
+impl DeviceTable {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Index of `device`, assigning the next one if it is new.
+    pub fn intern(&mut self, device: DeviceId) -> u32 {
+        if let Some(index) = self.indexes.get(&device) {
+            return *index;
+        }
+        let index = u32::try_from(self.devices.len()).unwrap_or(u32::MAX);
+        self.devices.push(device);
+        self.indexes.insert(device, index);
+        index
+    }
+
+    pub fn index(&self, device: &DeviceId) -> Option<u32> {
+        self.indexes.get(device).copied()
+    }
+
+    pub fn device(&self, index: u32) -> Option<DeviceId> {
+        self.devices.get(index as usize).copied()
+    }
+
+    /// Devices in index order.
+    pub fn devices(&self) -> &[DeviceId] {
+        &self.devices
+    }
+
+    pub fn len(&self) -> usize {
+        self.devices.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.devices.is_empty()
+    }
+
+    /// Dense counters of `clock`, interning its devices.
+    pub fn dense(&mut self, clock: &VectorClock) -> DenseClock {
+        let mut counters = Vec::new();
+        for (device, counter) in clock.iter() {
+            let index = self.intern(*device) as usize;
+            if counters.len() <= index {
+                counters.resize(index + 1, 0);
+            }
+            counters[index] = *counter;
+        }
+        DenseClock { counters }
+    }
+
+    /// Rebuild a clock from dense counters, omitting zero counters.
+    pub fn sparse(&self, dense: &DenseClock) -> Result<VectorClock, AuraError> {
+        let mut clock = VectorClock::new();
+        for (index, counter) in dense.counters.iter().enumerate() {
+            if *counter == 0 {
+                continue;
+            }
+            let device = self
+                .devices
+                .get(index)
+                .ok_or_else(|| AuraError::invalid("dense clock index outside device table"))?;
+            clock.insert(*device, *counter);
+        }
+        Ok(clock)
+    }
+
+    /// Encode `clock`, interning its devices.
+    ///
+    /// Counters are written as differences from `reference` (missing
+    /// entries count as zero); decode with the same reference.
+    pub fn encode(&mut self, clock: &VectorClock, reference: Option<&DenseClock>) -> Vec<u8> {
+        let mut entries: Vec<(u32, u64)> = clock
+            .iter()
+            .map(|(device, counter)| (self.intern(*device), *counter))
+            .collect();
+        entries.sort_unstable_by_key(|(index, _)| *index);
+
+        let form = match clock {
+            VectorClock::Single { .. } => FORM_SINGLE,
+            VectorClock::Multiple(_) => FORM_MULTIPLE,
+        };
+        let mut out = Vec::with_capacity(2 + entries.len() * 3);
+        out.push(form);
+        write_varint(&mut out, entries.len() as u64);
+        let mut next_index = 0u32;
+        for (index, counter) in entries {
+            let base = reference.map_or(0, |reference| reference.get(index));
+            write_varint(&mut out, u64::from(index - next_index));
+            write_varint(&mut out, zigzag(counter.wrapping_sub(base)));
+            next_index = index.saturating_add(1);
+        }
+        out
+    }
+
+    /// Decode a clock written by [`DeviceTable::encode`].
+    pub fn decode(
+        &self,
+        bytes: &[u8],
+        reference: Option<&DenseClock>,
+    ) -> Result<VectorClock, AuraError> {
+        let mut reader = VarintReader::new(bytes);
+        let clock = self.read_clock(&mut reader, reference)?;
+        reader.finish()?;
+        Ok(clock)
+    }
+
+    /// Encode a logical timestamp: the clock, then the Lamport counter.
+    pub fn encode_logical(
+        &mut self,
+        time: &LogicalTime,
+        reference: Option<&DenseClock>,
+    ) -> Vec<u8> {
+        let mut out = self.encode(&time.vector, reference);
+        write_varint(&mut out, time.lamport);
+        out
+    }
+
+    /// Decode a timestamp written by [`DeviceTable::encode_logical`].
+    pub fn decode_logical(
+        &self,
+        bytes: &[u8],
+        reference: Option<&DenseClock>,
+    ) -> Result<LogicalTime, AuraError> {
+        let mut reader = VarintReader::new(bytes);
+        let vector = self.read_clock(&mut reader, reference)?;
+        let lamport = reader.varint()?;
+        reader.finish()?;
+        Ok(LogicalTime { vector, lamport })
+    }
+
+    fn read_clock(
+        &self,
+        reader: &mut VarintReader<'_>,
+        reference: Option<&DenseClock>,
+    ) -> Result<VectorClock, AuraError> {
+        let form = reader.byte()?;
+        let count = reader.varint()?;
+        match (form, count) {
+            (FORM_SINGLE, 1) | (FORM_MULTIPLE, _) => {}
+            (FORM_SINGLE, _) => {
+                return Err(AuraError::invalid(
+                    "compact clock: single-device form needs exactly one entry",
+                ))
+            }
+            _ => return Err(AuraError::invalid("compact clock: unknown form tag")),
+        }
+
+        let mut map = BTreeMap::new();
+        let mut next_index = 0u64;
+        for _ in 0..count {
+            let index = next_index
+                .checked_add(reader.varint()?)
+                .and_then(|index| u32::try_from(index).ok())
+                .ok_or_else(|| AuraError::invalid("compact clock: device index overflow"))?;
+            let device = self
+                .device(index)
+                .ok_or_else(|| AuraError::invalid("compact clock: unknown device index"))?;
+            let base = reference.map_or(0, |reference| reference.get(index));
+            map.insert(device, base.wrapping_add(unzigzag(reader.varint()?)));
+            next_index = u64::from(index) + 1;
+        }
+
+        if form == FORM_SINGLE {
+            if let Some((device, counter)) = map.pop_first() {
+                return Ok(VectorClock::Single { device, counter });
+            }
+        }
+        Ok(VectorClock::Multiple(map))
+    }
+}
+
+impl TryFrom<Vec<DeviceId>> for DeviceTable {
+    type Error = AuraError;
+
+    fn try_from(devices: Vec<DeviceId>) -> Result<Self, Self::Error> {
+        let mut table = Self::new();
+        for device in devices {
+            if table.index(&device).is_some() {
+                return Err(AuraError::invalid("device table lists a device twice"));
+            }
+            table.intern(device);
+        }
+        Ok(table)
+    }
+}
+
+impl From<DeviceTable> for Vec<DeviceId> {
+    fn from(table: DeviceTable) -> Self {
+        table.devices
+    }
+}
+
+/// Vector clock counters indexed by [`DeviceTable`] index.
+///
+/// Devices past the end of the vector have counter zero, matching the
+/// missing-entry semantics of `VectorClock`.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct DenseClock {
+    counters: Vec<u64>,
+}
+
+impl DenseClock {
+    pub fn from_counters(counters: Vec<u64>) -> Self {
+        Self { counters }
+    }
+
+    pub fn counters(&self) -> &[u64] {
+        &self.counters
+    }
+
+    /// Counter at `index`, zero when absent.
+    pub fn get(&self, index: u32) -> u64 {
+        self.counters.get(index as usize).copied().unwrap_or(0)
+    }
+
+    /// Causal order, with the semantics of `VectorClock::partial_cmp`.
+    ///
+    /// The one difference is `VectorClock`'s single-device shortcut, which
+    /// reports two one-entry clocks of different devices as concurrent even
+    /// when a counter is zero; here a zero counter is the same as no entry.
+    pub fn compare(&self, other: &Self) -> Option<Ordering> {
+        let shared = self.counters.len().min(other.counters.len());
+        let (ours, theirs) = (&self.counters[..shared], &other.counters[..shared]);
+
+        let mut less = false;
+        let mut greater = false;
+        for (a, b) in ours.chunks(COMPARE_LANES).zip(theirs.chunks(COMPARE_LANES)) {
+            // No early exit inside a chunk, so the inner loop vectorizes
+            for (x, y) in a.iter().zip(b) {
+                less |= x < y;
+                greater |= x > y;
+            }
+            if less && greater {
+                return None;
+            }
+        }
+        greater |= self.counters[shared..].iter().any(|counter| *counter > 0);
+        less |= other.counters[shared..].iter().any(|counter| *counter > 0);
+
+        match (less, greater) {
+            (false, false) => Some(Ordering::Equal),
+            (true, false) => Some(Ordering::Less),
+            (false, true) => Some(Ordering::Greater),
+            (true, true) => None,
+        }
+    }
+
+    /// Raise each counter to at least the other clock's value.
+    pub fn merge(&mut self, other: &Self) {
+        if self.counters.len() < other.counters.len() {
+            self.counters.resize(other.counters.len(), 0);
+        }
+        for (ours, theirs) in self.counters.iter_mut().zip(&other.counters) {
+            *ours = (*ours).max(*theirs);
+        }
+    }
+}
+
+fn zigzag(delta: u64) -> u64 {
+    let signed = delta as i64;
+    ((signed << 1) ^ (signed >> 63)) as u64
+}
+
+fn unzigzag(value: u64) -> u64 {
+    (value >> 1) ^ (value & 1).wrapping_neg()
+}
+
+fn write_varint(out: &mut Vec<u8>, mut value: u64) {
+    while value >= 0x80 {
+        out.push((value as u8) | 0x80);
+        value >>= 7;
+    }
+    out.push(value as u8);
+}
+
+struct VarintReader<'a> {
+    bytes: &'a [u8],
+    position: usize,
+}
+
+impl<'a> VarintReader<'a> {
+    fn new(bytes: &'a [u8]) -> Self {
+        Self { bytes, position: 0 }
+    }
+
+    fn byte(&mut self) -> Result<u8, AuraError> {
+        let byte = *self
+            .bytes
+            .get(self.position)
+            .ok_or_else(|| AuraError::invalid("compact clock: truncated input"))?;
+        self.position += 1;
+        Ok(byte)
+    }
+
+    fn varint(&mut self) -> Result<u64, AuraError> {
+        let mut value = 0u64;
+        for shift in (0..64).step_by(7) {
+            let byte = self.byte()?;
+            let bits = u64::from(byte & 0x7f);
+            if shift == 63 && bits > 1 {
+                return Err(AuraError::invalid("compact clock: varint overflow"));
+            }
+            value |= bits << shift;
+            if byte & 0x80 == 0 {
+                return Ok(value);
+            }
+        }
+        Err(AuraError::invalid("compact clock: varint overflow"))
+    }
+
+    fn finish(&self) -> Result<(), AuraError> {
+        if self.position == self.bytes.len() {
+            Ok(())
+        } else {
+            Err(AuraError::invalid("compact clock: trailing bytes"))
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn device(seed: u8) -> DeviceId {
+        DeviceId::from_bytes([seed; 32])
+    }
+
+    #[test]
+    fn delta_against_reference_shrinks_the_encoding() {
+        let mut table = DeviceTable::new();
+        let mut clock = VectorClock::new();
+        for seed in 0..16u8 {
+            clock.insert(device(seed), 1_000_000 + u64::from(seed));
+        }
+        let absolute = table.encode(&clock, None);
+        let reference = table.dense(&clock);
+
+        clock.increment(device(3)).unwrap();
+        let delta = table.encode(&clock, Some(&reference));
+        assert!(delta.len() < absolute.len());
+        assert_eq!(delta.len(), 2 + 16 * 2);
+        assert_eq!(table.decode(&delta, Some(&reference)).unwrap(), clock);
+    }
+
+    #[test]
+    fn compact_encoding_is_smaller_than_canonical() {
+        let mut table = DeviceTable::new();
+        let mut clock = VectorClock::new();
+        for seed in 0..16u8 {
+            clock.insert(device(seed), 1_000_000 + u64::from(seed));
+        }
+        let canonical = crate::util::serialization::to_vec(&clock).unwrap();
+        let absolute = table.encode(&clock, None);
+        // Interned indices replace the serialized device ids
+        assert!(absolute.len() < canonical.len());
+    }
+
+    #[test]
+    fn decode_preserves_form_and_zero_entries() {
+        let mut table = DeviceTable::new();
+        let mut map = BTreeMap::new();
+        map.insert(device(1), 0);
+        let clocks = [
+            VectorClock::single(device(2), u64::MAX),
+            VectorClock::Multiple(map),
+            VectorClock::new(),
+        ];
+        for clock in clocks {
+            let bytes = table.encode(&clock, None);
+            assert_eq!(table.decode(&bytes, None).unwrap(), clock);
+        }
+    }
+
+    #[test]
+    fn malformed_input_is_rejected() {
+        let mut table = DeviceTable::new();
+        let bytes = table.encode(&VectorClock::single(device(1), 300), None);
+
+        assert!(table.decode(&bytes[..bytes.len() - 1], None).is_err());
+        assert!(table
+            .decode(&[bytes.as_slice(), &[0]].concat(), None)
+            .is_err());
+        assert!(DeviceTable::new().decode(&bytes, None).is_err());
+        assert!(table.decode(&[FORM_SINGLE, 2, 0, 0, 0, 0], None).is_err());
+        assert!(table.decode(&[7, 0], None).is_err());
+        assert!(table
+            .decode(
+                &[
+                    FORM_MULTIPLE,
+                    1,
+                    0,
+                    0xff,
+                    0xff,
+                    0xff,
+                    0xff,
+                    0xff,
+                    0xff,
+                    0xff,
+                    0xff,
+                    0xff,
+                    0x7f
+                ],
+                None
+            )
+            .is_err());
+    }
+
+    #[test]
+    fn table_serializes_as_device_list() {
+        let mut table = DeviceTable::new();
+        table.intern(device(9));
+        table.intern(device(4));
+        let bytes = crate::util::serialization::to_vec(&table).unwrap();
+        let restored: DeviceTable = crate::util::serialization::from_slice(&bytes).unwrap();
+        assert_eq!(restored, table);
+        assert_eq!(restored.index(&device(4)), Some(1));
+
+        let duplicated = vec![device(1), device(1)];
+        assert!(DeviceTable::try_from(duplicated).is_err());
+    }
+}
@@ -8,6 +8,7 @@ use serde::{Deserialize, Serialize};
 use std::collections::BTreeMap;
 use std::fmt;
 
+pub mod compact;
 mod ordering;
 pub mod pure;
 pub mod timeout;
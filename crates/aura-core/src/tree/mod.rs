@@ -40,5 +40,5 @@ pub use snapshot::*;
 pub use types::*;
 pub use verification::{
     check_attested_op, compute_binding_message, extract_target_node, verify_attested_op,
-    CheckError, SigningWitness, TreeStateView, VerificationError,
+    verify_frost_signature, CheckError, SigningWitness, TreeStateView, VerificationError,
 };
@@ -213,7 +213,10 @@ pub fn verify_attested_op(
 }
 
 /// Verify a FROST aggregate signature.
-fn verify_frost_signature(
+///
+/// This is the signature step of [`verify_attested_op`], exposed so a check
+/// detached from an op can be verified on its own with the same semantics.
+pub fn verify_frost_signature(
     group_public_key: &[u8; 32],
     message: &[u8],
     signature: &[u8],
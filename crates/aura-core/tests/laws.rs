@@ -17,3 +17,6 @@ mod tree_policy_meet;
 
 #[path = "laws/time_ordering.rs"]
 mod time_ordering;
+
+#[path = "laws/compact_clock.rs"]
+mod compact_clock;
@@ -11,7 +11,9 @@
 
 use async_trait::async_trait;
 use aura_core::crypto::{IdentityKeyContext, KeyDerivationSpec, PermissionKeyContext};
-use aura_core::effects::crypto::{FrostKeyGenResult, FrostSigningPackage, KeyDerivationContext};
+use aura_core::effects::crypto::{
+    Ed25519BatchItem, FrostKeyGenResult, FrostSigningPackage, KeyDerivationContext,
+};
 use aura_core::effects::{
     CryptoCoreEffects, CryptoError, CryptoExtendedEffects, RandomCoreEffects,
 };
@@ -335,6 +337,10 @@ impl CryptoCoreEffects for RealCryptoHandler {
         Ok(verifying_key.verify(message, &signature).is_ok())
     }
 
+    async fn ed25519_verify_batch(&self, items: &[Ed25519BatchItem]) -> Result<bool, CryptoError> {
+        aura_core::crypto::ed25519_verify_batch(items)
+    }
+
     fn is_simulated(&self) -> bool {
         self.seeded.is_some()
     }
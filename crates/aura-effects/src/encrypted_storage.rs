@@ -10,15 +10,29 @@
 //!
 //! **Layer Constraint**: Stateless handler that composes three effect traits.
 //! No multi-party coordination. No mock implementations (those belong in aura-testkit).
+//!
+//! **Derived-key cache**: Per-key encryption keys and opaque names are KDF
+//! outputs of the master key, so they are cached in bounded maps instead of
+//! re-running the KDF on every access. Evicted encryption keys are zeroized.
+//!
+//! **Name index**: With opaque names the inner storage only sees hashed keys,
+//! so each semantic name is kept in its own encrypted index record, stored
+//! under the index directory at the opaque name of its data. `list_keys`
+//! answers prefix queries from those records, and a write touches only its
+//! own record. The data is written before its record, and removed before it,
+//! so the record is the commit point for listing: a crash between the two
+//! leaves either unlisted data, which is listed again on its next store, or a
+//! record without data, which is dropped when the index is loaded.
 
 use async_trait::async_trait;
 use aura_core::effects::{
     CryptoEffects, SecureStorageCapability, SecureStorageEffects, SecureStorageLocation,
     StorageCoreEffects, StorageError, StorageExtendedEffects, StorageStats,
 };
-use std::collections::HashMap;
+use futures::future::try_join_all;
+use std::collections::{BTreeSet, HashMap, VecDeque};
 use std::sync::Arc;
-use tokio::sync::{Mutex, RwLock};
+use tokio::sync::{Mutex, OnceCell};
 use zeroize::Zeroizing;
 
 /// Nonce size for ChaCha20-Poly1305 (96 bits = 12 bytes)
@@ -31,7 +45,10 @@ const BLOB_VERSION: u8 = 0x01;
 const MASTER_KEY_NAMESPACE: &str = "aura-encryption";
 const MASTER_KEY_ID: &str = "master-key";
 
-type MasterKeyMaterial = Arc<Zeroizing<[u8; 32]>>;
+/// Default number of derived keys (and opaque names) kept in memory
+pub const DEFAULT_DERIVED_KEY_CACHE_CAPACITY: usize = 1_024;
+
+type KeyMaterial = Zeroizing<[u8; 32]>;
 
 /// Configuration for encrypted storage behavior
 #[derive(Debug, Clone)]
@@ -44,6 +61,8 @@ pub struct EncryptedStorageConfig {
     pub key_namespace: Option<String>,
     /// Custom key identifier within namespace
     pub key_id: Option<String>,
+    /// Maximum number of per-key derived keys cached in memory
+    pub derived_key_cache_capacity: usize,
 }
 
 /// Explicit encrypted storage mode.
@@ -81,6 +100,7 @@ impl EncryptedStorageConfig {
             opaque_names: false,
             key_namespace: None,
             key_id: None,
+            derived_key_cache_capacity: DEFAULT_DERIVED_KEY_CACHE_CAPACITY,
         }
     }
 
@@ -116,11 +136,56 @@ impl EncryptedStorageConfig {
         self
     }
 
+    /// Set how many derived keys are cached; `0` disables the cache.
+    pub fn with_derived_key_cache_capacity(mut self, capacity: usize) -> Self {
+        self.derived_key_cache_capacity = capacity;
+        self
+    }
+
     fn encrypts(&self) -> bool {
         self.encryption.encrypts()
     }
 }
 
+/// Bounded map from storage key to a derived value, evicting oldest-first.
+///
+/// Values are dropped on eviction, so `Zeroizing` keys are wiped as soon as
+/// they leave the cache.
+struct DerivedKeyCache<V> {
+    entries: HashMap<String, V>,
+    order: VecDeque<String>,
+    capacity: usize,
+}
+
+impl<V: Clone> DerivedKeyCache<V> {
+    fn new(capacity: usize) -> Self {
+        Self {
+            entries: HashMap::new(),
+            order: VecDeque::new(),
+            capacity,
+        }
+    }
+
+    fn get(&self, key: &str) -> Option<V> {
+        self.entries.get(key).cloned()
+    }
+
+    fn insert(&mut self, key: &str, value: V) {
+        if self.capacity == 0 {
+            return;
+        }
+        if self.entries.insert(key.to_string(), value).is_none() {
+            self.order.push_back(key.to_string());
+        }
+        while self.entries.len() > self.capacity {
+            let Some(oldest) = self.order.pop_front() else {
+                break;
+            };
+            self.entries.remove(&oldest);
+        }
+    }
+}
+
 /// Unified encrypted storage that wraps any StorageEffects implementation.
 ///
 /// All data passing through this layer is encrypted using a master key
@@ -158,10 +223,16 @@ where
     crypto: Arc<C>,
     /// Secure storage for master key
     secure: Arc<Sec>,
-    /// Cached master key (lazily loaded/created on first use).
-    master_key: RwLock<Option<MasterKeyMaterial>>,
-    /// Single-flight guard for master-key initialization.
-    master_key_init: Mutex<()>,
+    /// Master key, loaded/created once on first use (single-flight).
+    master_key: OnceCell<KeyMaterial>,
+    /// Per-key encryption keys derived from the master key.
+    encryption_keys: Mutex<DerivedKeyCache<KeyMaterial>>,
+    /// Opaque storage names derived from the master key.
+    opaque_names: Mutex<DerivedKeyCache<String>>,
+    /// Semantic names stored under opaque names; loaded on first use.
+    name_index: Mutex<Option<BTreeSet<String>>>,
+    /// Opaque directory holding one index record per semantic name.
+    name_index_dir: OnceCell<String>,
     /// Configuration options
     config: EncryptedStorageConfig,
 }
@@ -182,8 +253,11 @@ where
             inner,
             crypto,
             secure,
-            master_key: RwLock::new(None),
-            master_key_init: Mutex::new(()),
+            master_key: OnceCell::new(),
+            encryption_keys: Mutex::new(DerivedKeyCache::new(config.derived_key_cache_capacity)),
+            opaque_names: Mutex::new(DerivedKeyCache::new(config.derived_key_cache_capacity)),
+            name_index: Mutex::new(None),
+            name_index_dir: OnceCell::new(),
             config,
         }
     }
@@ -199,17 +273,13 @@ where
         )
     }
 
-    async fn get_or_init_master_key(&self) -> Result<MasterKeyMaterial, StorageError> {
-        if let Some(key) = self.master_key.read().await.clone() {
-            return Ok(key);
-        }
-
-        // Single-flight to avoid concurrent "create key" races.
-        let _guard = self.master_key_init.lock().await;
-        if let Some(key) = self.master_key.read().await.clone() {
-            return Ok(key);
-        }
+    async fn get_or_init_master_key(&self) -> Result<&KeyMaterial, StorageError> {
+        self.master_key
+            .get_or_try_init(|| self.load_or_create_master_key())
+            .await
+    }
 
+    async fn load_or_create_master_key(&self) -> Result<KeyMaterial, StorageError> {
         let location = Self::master_key_location(&self.config);
         let read_caps = [SecureStorageCapability::Read];
         let write_caps = [SecureStorageCapability::Write];
@@ -264,10 +334,8 @@ where
             key_bytes = regenerated;
         }
 
-        let mut key = [0u8; 32];
+        let mut key = Zeroizing::new([0u8; 32]);
         key.copy_from_slice(&key_bytes);
-        let key = Arc::new(Zeroizing::new(key));
-        *self.master_key.write().await = Some(key.clone());
         Ok(key)
     }
 
@@ -276,15 +344,39 @@ where
     /// Uses the crypto KDF to derive a deterministic but unpredictable key name
     /// from the master key and semantic key.
     async fn derive_opaque_key(&self, semantic_key: &str) -> Result<String, StorageError> {
+        if let Some(name) = self.opaque_names.lock().await.get(semantic_key) {
+            return Ok(name);
+        }
+        let name = self
+            .derive_name(semantic_key.as_bytes(), b"aura-opaque-key-v1")
+            .await?;
+        self.opaque_names
+            .lock()
+            .await
+            .insert(semantic_key, name.clone());
+        Ok(name)
+    }
+
+    /// Opaque directory of the name index records.
+    ///
+    /// Derived under its own KDF label, so no semantic key can map onto it.
+    async fn name_index_dir(&self) -> Result<&str, StorageError> {
+        self.name_index_dir
+            .get_or_try_init(|| self.derive_name(b"name-index", b"aura-opaque-index-v2"))
+            .await
+            .map(String::as_str)
+    }
+
+    /// Storage key of the index record for the data stored at `storage_key`.
+    async fn name_record_key(&self, storage_key: &str) -> Result<String, StorageError> {
+        Ok(format!("{}/{storage_key}", self.name_index_dir().await?))
+    }
+
+    async fn derive_name(&self, salt: &[u8], info: &[u8]) -> Result<String, StorageError> {
         let master_key = self.get_or_init_master_key().await?;
         let derived = self
             .crypto
-            .kdf_derive(
-                &**master_key,
-                semantic_key.as_bytes(),
-                b"aura-opaque-key-v1",
-                16,
-            )
+            .kdf_derive(&**master_key, salt, info, 16)
             .await
             .map_err(|e| StorageError::EncryptionFailed {
                 reason: format!("Opaque key derivation failed: {e}"),
@@ -310,48 +402,71 @@ where
     ///
     /// This binds the encryption to the storage key, providing key separation
     /// and preventing cross-key ciphertext attacks without needing AAD.
-    async fn derive_encryption_key(&self, storage_key: &str) -> Result<[u8; 32], StorageError> {
+    async fn derive_encryption_key(&self, storage_key: &str) -> Result<KeyMaterial, StorageError> {
+        if let Some(key) = self.encryption_keys.lock().await.get(storage_key) {
+            return Ok(key);
+        }
+
         let master_key = self.get_or_init_master_key().await?;
-        let derived = self
-            .crypto
-            .kdf_derive(
-                &**master_key,
-                storage_key.as_bytes(),
-                b"aura-storage-encryption-v1",
-                32,
-            )
-            .await
-            .map_err(|e| StorageError::EncryptionFailed {
-                reason: format!("Key derivation failed: {e}"),
-            })?;
+        let derived = Zeroizing::new(
+            self.crypto
+                .kdf_derive(
+                    &**master_key,
+                    storage_key.as_bytes(),
+                    b"aura-storage-encryption-v1",
+                    32,
+                )
+                .await
+                .map_err(|e| StorageError::EncryptionFailed {
+                    reason: format!("Key derivation failed: {e}"),
+                })?,
+        );
+        if derived.len() != 32 {
+            return Err(StorageError::EncryptionFailed {
+                reason: "Key derivation returned a key of the wrong length".to_string(),
+            });
+        }
 
-        let mut key = [0u8; 32];
+        let mut key = Zeroizing::new([0u8; 32]);
         key.copy_from_slice(&derived);
+        self.encryption_keys
+            .lock()
+            .await
+            .insert(storage_key, key.clone());
         Ok(key)
     }
 
-    /// Encrypt data with a key derived from master key + storage key.
-    ///
-    /// Format: version (1 byte) || nonce (12 bytes) || ciphertext
-    async fn encrypt(&self, key: &str, data: &[u8]) -> Result<Vec<u8>, StorageError> {
-        // Derive per-key encryption key
-        let encryption_key = self.derive_encryption_key(key).await?;
-
-        // Generate unique nonce
-        let nonce_bytes = self.crypto.random_bytes(NONCE_SIZE).await;
-        if nonce_bytes.len() != NONCE_SIZE {
+    /// Draw `count` nonces with a single RNG call.
+    async fn random_nonces(&self, count: usize) -> Result<Vec<[u8; NONCE_SIZE]>, StorageError> {
+        let bytes = self.crypto.random_bytes(NONCE_SIZE * count).await;
+        if bytes.len() != NONCE_SIZE * count {
             return Err(StorageError::EncryptionFailed {
                 reason: "Failed to generate nonce".to_string(),
             });
         }
+        Ok(bytes
+            .chunks_exact(NONCE_SIZE)
+            .map(|chunk| {
+                let mut nonce = [0u8; NONCE_SIZE];
+                nonce.copy_from_slice(chunk);
+                nonce
+            })
+            .collect())
+    }
 
-        let mut nonce = [0u8; NONCE_SIZE];
-        nonce.copy_from_slice(&nonce_bytes);
-
+    /// Encrypt `data` under an already-derived key.
+    ///
+    /// Format: version (1 byte) || nonce (12 bytes) || ciphertext
+    async fn seal(
+        &self,
+        encryption_key: &KeyMaterial,
+        nonce: &[u8; NONCE_SIZE],
+        data: &[u8],
+    ) -> Result<Vec<u8>, StorageError> {
         // Encrypt with ChaCha20-Poly1305
         let ciphertext = self
             .crypto
-            .chacha20_encrypt(data, &encryption_key, &nonce)
+            .chacha20_encrypt(data, encryption_key, nonce)
             .await
             .map_err(|e| StorageError::EncryptionFailed {
                 reason: e.to_string(),
@@ -360,16 +475,20 @@ where
         // Build blob: version || nonce || ciphertext
         let mut blob = Vec::with_capacity(1 + NONCE_SIZE + ciphertext.len());
         blob.push(BLOB_VERSION);
-        blob.extend_from_slice(&nonce);
+        blob.extend_from_slice(nonce);
         blob.extend_from_slice(&ciphertext);
 
         Ok(blob)
     }
 
-    /// Decrypt data with a key derived from master key + storage key.
+    /// Decrypt a blob under an already-derived key.
     ///
     /// Expects format: version (1 byte) || nonce (12 bytes) || ciphertext
-    async fn decrypt(&self, key: &str, blob: &[u8]) -> Result<Vec<u8>, StorageError> {
+    async fn open(
+        &self,
+        encryption_key: &KeyMaterial,
+        blob: &[u8],
+    ) -> Result<Vec<u8>, StorageError> {
         // Check minimum length
         if blob.len() < 1 + NONCE_SIZE {
             return Err(StorageError::DecryptionFailed {
@@ -385,9 +504,6 @@ where
             });
         }
 
-        // Derive per-key encryption key
-        let encryption_key = self.derive_encryption_key(key).await?;
-
         // Extract nonce and ciphertext
         let nonce_bytes = &blob[1..1 + NONCE_SIZE];
         let ciphertext = &blob[1 + NONCE_SIZE..];
@@ -397,13 +513,114 @@ where
 
         // Decrypt with ChaCha20-Poly1305
         self.crypto
-            .chacha20_decrypt(ciphertext, &encryption_key, &nonce)
+            .chacha20_decrypt(ciphertext, encryption_key, &nonce)
             .await
             .map_err(|e| StorageError::DecryptionFailed {
                 reason: e.to_string(),
             })
     }
 
+    /// Encrypt data with a key derived from master key + storage key.
+    async fn encrypt(&self, key: &str, data: &[u8]) -> Result<Vec<u8>, StorageError> {
+        let encryption_key = self.derive_encryption_key(key).await?;
+        let nonces = self.random_nonces(1).await?;
+        self.seal(&encryption_key, &nonces[0], data).await
+    }
+
+    /// Decrypt data with a key derived from master key + storage key.
+    async fn decrypt(&self, key: &str, blob: &[u8]) -> Result<Vec<u8>, StorageError> {
+        let encryption_key = self.derive_encryption_key(key).await?;
+        self.open(&encryption_key, blob).await
+    }
+
+    /// Encrypt a batch in one pass: keys come from the cache (deriving any
+    /// misses concurrently), nonces come from one RNG call, and the
+    /// encryptions run concurrently.
+    async fn encrypt_batch(
+        &self,
+        pairs: HashMap<String, Vec<u8>>,
+    ) -> Result<HashMap<String, Vec<u8>>, StorageError> {
+        let pairs: Vec<(String, Vec<u8>)> = pairs.into_iter().collect();
+        let (storage_keys, encryption_keys) = futures::try_join!(
+            try_join_all(pairs.iter().map(|(key, _)| self.storage_key(key))),
+            try_join_all(pairs.iter().map(|(key, _)| self.derive_encryption_key(key))),
+        )?;
+        let nonces = self.random_nonces(pairs.len()).await?;
+        let blobs = try_join_all(
+            pairs
+                .iter()
+                .zip(&encryption_keys)
+                .zip(&nonces)
+                .map(|(((_, value), key), nonce)| self.seal(key, nonce, value)),
+        )
+        .await?;
+        Ok(storage_keys.into_iter().zip(blobs).collect())
+    }
+
+    /// Insert or remove semantic names in the encrypted name index.
+    ///
+    /// Called after the data write or removal it records. Only the records
+    /// of names that actually change are written or deleted.
+    async fn update_name_index(
+        &self,
+        insert: &[&str],
+        remove: &[&str],
+    ) -> Result<(), StorageError> {
+        let mut guard = self.name_index.lock().await;
+        let index = match &mut *guard {
+            Some(index) => index,
+            empty => empty.insert(self.load_name_index().await?),
+        };
+
+        let added: Vec<&str> = insert
+            .iter()
+            .copied()
+            .filter(|key| !index.contains(*key))
+            .collect();
+        if !added.is_empty() {
+            let mut records = HashMap::with_capacity(added.len());
+            for key in &added {
+                let record_key = self.name_record_key(&self.storage_key(key).await?).await?;
+                let record = self.encrypt(&record_key, key.as_bytes()).await?;
+                records.insert(record_key, record);
+            }
+            self.inner.store_batch(records).await?;
+            index.extend(added.into_iter().map(str::to_string));
+        }
+
+        for key in remove {
+            if index.contains(*key) {
+                let record_key = self.name_record_key(&self.storage_key(key).await?).await?;
+                self.inner.remove(&record_key).await?;
+                index.remove(*key);
+            }
+        }
+        Ok(())
+    }
+
+    /// Load the name index from its records, dropping any whose data is gone.
+    async fn load_name_index(&self) -> Result<BTreeSet<String>, StorageError> {
+        let dir = format!("{}/", self.name_index_dir().await?);
+        let record_keys = self.inner.list_keys(Some(&dir)).await?;
+        let records = self.inner.retrieve_batch(&record_keys).await?;
+
+        let mut index = BTreeSet::new();
+        for (record_key, record) in records {
+            let storage_key = &record_key[dir.len()..];
+            if !self.inner.exists(storage_key).await? {
+                // Removal crashed between deleting the data and its record.
+                self.inner.remove(&record_key).await?;
+                continue;
+            }
+            let name = self.decrypt(&record_key, &record).await?;
+            let name = String::from_utf8(name).map_err(|e| StorageError::CorruptionDetected {
+                details: format!("Failed to decode name index record: {e}"),
+            })?;
+            index.insert(name);
+        }
+        Ok(index)
+    }
+
     /// Check if a blob is encrypted (has our version header).
     ///
     /// Used for detecting unencrypted legacy data.
@@ -436,7 +653,11 @@ where
         }
         let storage_key = self.storage_key(key).await?;
         let encrypted = self.encrypt(key, &value).await?;
-        self.inner.store(&storage_key, encrypted).await
+        self.inner.store(&storage_key, encrypted).await?;
+        if self.config.opaque_names {
+            self.update_name_index(&[key], &[]).await?;
+        }
+        Ok(())
     }
 
     async fn retrieve(&self, key: &str) -> Result<Option<Vec<u8>>, StorageError> {
@@ -465,19 +686,31 @@ where
             return self.inner.remove(key).await;
         }
         let storage_key = self.storage_key(key).await?;
-        self.inner.remove(&storage_key).await
+        let removed = self.inner.remove(&storage_key).await?;
+        if self.config.opaque_names {
+            self.update_name_index(&[], &[key]).await?;
+        }
+        Ok(removed)
     }
 
+    /// With opaque names, keys (and prefix matches) come from the encrypted
+    /// name index rather than the inner storage.
     async fn list_keys(&self, prefix: Option<&str>) -> Result<Vec<String>, StorageError> {
         if !self.config.encrypts() {
             return self.inner.list_keys(prefix).await;
         }
-        // If using opaque names, we can't filter by prefix effectively
-        // Return all keys and let caller filter (or return empty if opaque)
         if self.config.opaque_names {
-            // With opaque names, we can't meaningfully list by prefix
-            // The caller would need to maintain their own index
-            return self.inner.list_keys(None).await;
+            let mut guard = self.name_index.lock().await;
+            let index = match &mut *guard {
+                Some(index) => index,
+                empty => empty.insert(self.load_name_index().await?),
+            };
+            let prefix = prefix.unwrap_or_default();
+            return Ok(index
+                .range(prefix.to_string()..)
+                .take_while(|key| key.starts_with(prefix))
+                .cloned()
+                .collect());
         }
         self.inner.list_keys(prefix).await
     }
@@ -503,14 +736,18 @@ where
         if !self.config.encrypts() {
             return self.inner.store_batch(pairs).await;
         }
-        // Encrypt each value
-        let mut encrypted_pairs = HashMap::with_capacity(pairs.len());
-        for (key, value) in pairs {
-            let storage_key = self.storage_key(&key).await?;
-            let encrypted = self.encrypt(&key, &value).await?;
-            encrypted_pairs.insert(storage_key, encrypted);
+        let names: Vec<String> = if self.config.opaque_names {
+            pairs.keys().cloned().collect()
+        } else {
+            Vec::new()
+        };
+        let encrypted_pairs = self.encrypt_batch(pairs).await?;
+        self.inner.store_batch(encrypted_pairs).await?;
+        if !names.is_empty() {
+            let names: Vec<&str> = names.iter().map(String::as_str).collect();
+            self.update_name_index(&names, &[]).await?;
         }
-        self.inner.store_batch(encrypted_pairs).await
+        Ok(())
     }
 
     async fn retrieve_batch(
@@ -521,34 +758,34 @@ where
             return self.inner.retrieve_batch(keys).await;
         }
         // Map semantic keys to storage keys
-        let mut storage_keys = Vec::with_capacity(keys.len());
-        let mut key_map = HashMap::with_capacity(keys.len());
-        for key in keys {
-            let storage_key = self.storage_key(key).await?;
-            key_map.insert(storage_key.clone(), key.clone());
-            storage_keys.push(storage_key);
-        }
+        let storage_keys = try_join_all(keys.iter().map(|key| self.storage_key(key))).await?;
+        let key_map: HashMap<&str, &String> =
+            storage_keys.iter().map(String::as_str).zip(keys).collect();
 
         // Retrieve encrypted blobs
         let encrypted = self.inner.retrieve_batch(&storage_keys).await?;
 
-        // Decrypt each value
-        let mut decrypted = HashMap::with_capacity(encrypted.len());
-        for (storage_key, blob) in encrypted {
-            if let Some(semantic_key) = key_map.get(&storage_key) {
-                let value = self.decrypt(semantic_key, &blob).await?;
-                decrypted.insert(semantic_key.clone(), value);
-            }
-        }
+        // Decrypt all values concurrently
+        let decrypted = try_join_all(encrypted.iter().filter_map(|(storage_key, blob)| {
+            let semantic_key = *key_map.get(storage_key.as_str())?;
+            Some(async move {
+                let value = self.decrypt(semantic_key, blob).await?;
+                Ok::<_, StorageError>((semantic_key.clone(), value))
+            })
+        }))
+        .await?;
 
-        Ok(decrypted)
+        Ok(decrypted.into_iter().collect())
     }
 
     async fn clear_all(&self) -> Result<(), StorageError> {
         if !self.config.encrypts() {
             return self.inner.clear_all().await;
         }
-        self.inner.clear_all().await
+        let mut index = self.name_index.lock().await;
+        self.inner.clear_all().await?;
+        *index = Some(BTreeSet::new());
+        Ok(())
     }
 
     async fn stats(&self) -> Result<StorageStats, StorageError> {
@@ -1235,4 +1472,114 @@ mod tests {
         let retrieved = encrypted.retrieve("passthrough").await.unwrap().unwrap();
         assert_eq!(retrieved, value);
     }
+
+    #[test]
+    fn derived_key_cache_evicts_oldest_first() {
+        let mut cache = DerivedKeyCache::new(2);
+        cache.insert("a", Zeroizing::new([1u8; 32]));
+        cache.insert("b", Zeroizing::new([2u8; 32]));
+        cache.insert("a", Zeroizing::new([3u8; 32]));
+        cache.insert("c", Zeroizing::new([4u8; 32]));
+
+        assert!(cache.get("a").is_none());
+        assert_eq!(*cache.get("b").unwrap(), [2u8; 32]);
+        assert_eq!(*cache.get("c").unwrap(), [4u8; 32]);
+    }
+
+    #[tokio::test]
+    async fn test_batch_round_trip_matches_single_key_path() {
+        let storage = MockStorage::new();
+        let crypto = Arc::new(MockCrypto);
+        let secure = Arc::new(MockSecureStorage::new());
+        let encrypted =
+            EncryptedStorage::new(storage, crypto, secure, EncryptedStorageConfig::default());
+
+        let mut pairs = HashMap::new();
+        for i in 0..16 {
+            pairs.insert(format!("batch/{i}"), format!("value-{i}").into_bytes());
+        }
+        encrypted.store_batch(pairs.clone()).await.unwrap();
+
+        let keys: Vec<String> = pairs.keys().cloned().collect();
+        assert_eq!(encrypted.retrieve_batch(&keys).await.unwrap(), pairs);
+        assert_eq!(
+            encrypted.retrieve("batch/3").await.unwrap(),
+            Some(b"value-3".to_vec())
+        );
+    }
+
+    #[tokio::test]
+    async fn test_opaque_names_list_by_prefix_from_name_index() {
+        let storage = MockStorage::new();
+        let crypto = Arc::new(MockCrypto);
+        let secure = Arc::new(MockSecureStorage::new());
+        let config = EncryptedStorageConfig::default().with_opaque_names();
+        let encrypted = EncryptedStorage::new(storage, crypto, secure, config);
+
+        encrypted
+            .store("journal/facts/a", b"a".to_vec())
+            .await
+            .unwrap();
+        let mut pairs = HashMap::new();
+        pairs.insert("journal/facts/b".to_string(), b"b".to_vec());
+        pairs.insert("other/c".to_string(), b"c".to_vec());
+        encrypted.store_batch(pairs).await.unwrap();
+        assert!(encrypted.remove("journal/facts/a").await.unwrap());
+
+        assert_eq!(
+            encrypted.list_keys(Some("journal/")).await.unwrap(),
+            vec!["journal/facts/b".to_string()]
+        );
+        assert!(encrypted
+            .inner()
+            .list_keys(Some("journal/"))
+            .await
+            .unwrap()
+            .is_empty());
+
+        // A fresh handler over the same storage reloads the persisted index.
+        let EncryptedStorage { inner, secure, .. } = encrypted;
+        let reopened = EncryptedStorage::new(
+            inner,
+            Arc::new(MockCrypto),
+            secure,
+            EncryptedStorageConfig::default().with_opaque_names(),
+        );
+        assert_eq!(
+            reopened.list_keys(None).await.unwrap(),
+            vec!["journal/facts/b".to_string(), "other/c".to_string()]
+        );
+    }
+
+    #[tokio::test]
+    async fn test_name_index_writes_one_record_per_name_and_recovers_on_load() {
+        let storage = MockStorage::new();
+        let crypto = Arc::new(MockCrypto);
+        let secure = Arc::new(MockSecureStorage::new());
+        let config = EncryptedStorageConfig::default().with_opaque_names();
+        let encrypted = EncryptedStorage::new(storage, crypto, secure, config);
+
+        encrypted.store("kept", b"k".to_vec()).await.unwrap();
+        encrypted.store("kept", b"k2".to_vec()).await.unwrap();
+        encrypted.store("crashed", b"c".to_vec()).await.unwrap();
+        // One data blob and one index record per name; rewrites add nothing.
+        assert_eq!(encrypted.inner().list_keys(None).await.unwrap().len(), 4);
+
+        // Crash after removing the data but before removing its record.
+        let crashed = encrypted.storage_key("crashed").await.unwrap();
+        assert!(encrypted.inner().remove(&crashed).await.unwrap());
+
+        let EncryptedStorage { inner, secure, .. } = encrypted;
+        let reopened = EncryptedStorage::new(
+            inner,
+            Arc::new(MockCrypto),
+            secure,
+            EncryptedStorageConfig::default().with_opaque_names(),
+        );
+        assert_eq!(
+            reopened.list_keys(None).await.unwrap(),
+            vec!["kept".to_string()]
+        );
+        assert_eq!(reopened.inner().list_keys(None).await.unwrap().len(), 2);
+    }
 }
@@ -70,8 +70,8 @@ use aura_core::{
         NetworkEffects, ObserverClass, PhysicalTimeEffects, RandomCoreEffects, RandomEffects,
         StorageCoreEffects, StorageEffects,
     },
-    types::identifiers::AuthorityId,
-    AuraError, AuraResult as Result,
+    types::identifiers::{AuthorityId, ContextId},
+    AuraError, AuraResult as Result, FlowCost,
 };
 use std::sync::Arc;
 use tracing::{debug, error, info};
@@ -344,6 +344,38 @@ where
         }
     }
 
+    async fn charge_budget_batch(
+        &self,
+        context: ContextId,
+        authority: AuthorityId,
+        peer: AuthorityId,
+        amounts: Vec<FlowCost>,
+    ) -> Result<Vec<EffectResult>> {
+        debug!(
+            ?authority,
+            sends = amounts.len(),
+            "Charging flow budget batch for authority"
+        );
+
+        // One debit for the whole batch; receipts keep per-send nonces
+        let receipts = self
+            .flow_budget
+            .charge_flow_batch(&context, &peer, &amounts)
+            .await
+            .map_err(|e| {
+                error!("Failed to charge flow budget batch: {}", e);
+                e
+            })?;
+
+        info!(
+            ?authority,
+            sends = receipts.len(),
+            "Successfully charged flow budget batch"
+        );
+
+        Ok(receipts.into_iter().map(EffectResult::Receipt).collect())
+    }
+
     fn interpreter_type(&self) -> &'static str {
         "production"
     }
@@ -94,6 +94,8 @@ pub mod error;
 pub mod guard_interpreter;
 pub mod identifiers;
 pub mod leakage;
+#[cfg(not(target_arch = "wasm32"))]
+pub mod log_storage;
 pub mod network_monitor;
 pub mod noise;
 pub mod query;
@@ -140,11 +142,13 @@ pub use identifiers::{
     new_operation_id, new_session_id,
 };
 pub use leakage::ProductionLeakageHandler;
+#[cfg(not(target_arch = "wasm32"))]
+pub use log_storage::{LogStorageConfig, LogStructuredStorageHandler};
 pub use network_monitor::NetworkMonitorHandler;
 pub use noise::RealNoiseHandler;
 pub use query::{
     format_rule, format_value, parse_arg_to_value, parse_fact_to_row, CapabilityPolicy,
-    QueryHandler,
+    QueryHandler, QueryResultDelta,
 };
 pub use random::RealRandomHandler;
 pub use reactive::{ReactiveHandler, SignalGraph, SignalGraphStats};
@@ -155,7 +159,8 @@ pub use secure::{FilesystemFallbackSecureStorageHandler, ProductionSecureStorage
 pub use simulation::FallbackSimulationHandler;
 #[allow(deprecated)]
 pub use time::{
-    LogicalClockHandler, OrderClockHandler, PhysicalTimeHandler, TimeComparisonHandler,
+    LogicalClockHandler, MonotonicLatencyClock, OrderClockHandler, PhysicalTimeHandler,
+    TimeComparisonHandler,
 };
 #[cfg(not(target_arch = "wasm32"))]
 pub use udp::RealUdpEffectsHandler;
@@ -182,6 +187,12 @@ cfg_if! {
                 ConnectionMetrics,
                 // Message processing
                 FramingHandler,
+                // Connection multiplexing
+                MultiplexedConnection,
+                MuxConfig,
+                MuxDriver,
+                MuxRole,
+                MuxStream,
 
                 // Core transport handlers
                 RealTransportHandler,
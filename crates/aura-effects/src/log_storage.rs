@@ -0,0 +1,1005 @@
+//! Layer 3: Log-Structured Storage Handler - Production Only
+//!
+//! Append-only alternative to [`FilesystemStorageHandler`] for workloads with
+//! many small values, such as journal persistence. Instead of one file per
+//! key, every write is appended to the active segment file and an in-memory
+//! key index records where each live value sits.
+//!
+//! ## Segment Layout
+//!
+//! Segments are files named `<id>.log` in the storage directory. Each commit
+//! appends one frame:
+//!
+//! ```text
+//! [body_len: u32][checksum: 32 bytes][body]
+//! body := op*
+//! op   := 0x00 [key_len: u32][key][value_len: u32][value]   (put)
+//!       | 0x01 [key_len: u32][key]                          (delete)
+//!       | 0x02                                              (clear)
+//! ```
+//!
+//! A frame is applied entirely or not at all: on open, a torn or corrupt
+//! frame at the end of the newest segment is truncated away, so a batch is
+//! never half-visible after a crash.
+//!
+//! ## Group Commit
+//!
+//! Concurrent writers queue their frames; whichever writer takes the segment
+//! lock first appends every queued frame and issues a single `fsync` for the
+//! whole group. `store_batch` is one frame, so a batch costs one `fsync`
+//! however many keys it holds.
+//!
+//! ## Compaction
+//!
+//! When enough of the sealed segments is garbage, their live values are
+//! copied into the active segment and the sealed files are deleted, oldest
+//! first so a crash mid-compaction never resurrects a deleted key. The
+//! commit that crosses the threshold only marks compaction due; the owner
+//! of the handler schedules [`LogStructuredStorageHandler::compact_sealed`]
+//! (the agent runs it from its task registry), or forces a pass with
+//! [`LogStructuredStorageHandler::compact`]. Sealed values are copied
+//! without holding the writer lock, which is retaken only to append the
+//! copies and swap the index.
+//!
+//! Keys follow the same validation rules as [`FilesystemStorageHandler`], so
+//! the handlers are interchangeable. Listing and stats are answered from the
+//! index without touching the filesystem.
+
+use crate::storage::FilesystemStorageHandler;
+use async_trait::async_trait;
+use aura_core::effects::{StorageCoreEffects, StorageError, StorageExtendedEffects, StorageStats};
+use std::collections::{BTreeMap, HashMap};
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::Arc;
+use tokio::fs;
+use tokio::io::{AsyncReadExt, AsyncSeekExt, AsyncWriteExt};
+use tokio::sync::{oneshot, Mutex, RwLock};
+
+const SEGMENT_EXTENSION: &str = "log";
+const FRAME_HEADER_LEN: usize = 4 + 32;
+const OP_PUT: u8 = 0;
+const OP_DELETE: u8 = 1;
+const OP_CLEAR: u8 = 2;
+
+/// Tuning knobs for [`LogStructuredStorageHandler`].
+#[derive(Debug, Clone)]
+pub struct LogStorageConfig {
+    /// Size at which the active segment is sealed and a new one started.
+    pub segment_size_bytes: u64,
+    /// Fraction of sealed bytes that must be garbage before compacting.
+    pub compaction_garbage_ratio: f64,
+    /// Minimum sealed size before compaction is considered.
+    pub min_compaction_bytes: u64,
+}
+
+impl Default for LogStorageConfig {
+    fn default() -> Self {
+        Self {
+            segment_size_bytes: 64 * 1024 * 1024,
+            compaction_garbage_ratio: 0.5,
+            min_compaction_bytes: 4 * 1024 * 1024,
+        }
+    }
+}
+
+/// Append-only, group-committed storage handler.
+///
+/// Cloning is cheap and clones share the same log.
+#[derive(Debug, Clone)]
+pub struct LogStructuredStorageHandler {
+    inner: Arc<LogInner>,
+}
+
+#[derive(Debug)]
+struct LogInner {
+    dir: PathBuf,
+    config: LogStorageConfig,
+    /// Frames waiting for the next group commit
+    queue: Mutex<Vec<PendingCommit>>,
+    /// Active segment; held for the whole append + fsync of a group
+    writer: Mutex<ActiveSegment>,
+    /// Key index and per-segment accounting; read lock is held across value
+    /// reads so compaction cannot delete a segment underneath a reader
+    index: RwLock<LogIndex>,
+    compacting: AtomicBool,
+    /// Set by the commit that crosses the garbage threshold
+    compaction_due: AtomicBool,
+}
+
+#[derive(Debug)]
+struct PendingCommit {
+    ops: Vec<LogOp>,
+    done: oneshot::Sender<Result<usize, StorageError>>,
+}
+
+#[derive(Debug)]
+enum LogOp {
+    Put { key: String, value: Vec<u8> },
+    Delete { key: String },
+    Clear,
+}
+
+#[derive(Debug)]
+struct ActiveSegment {
+    id: u64,
+    file: fs::File,
+    len: u64,
+}
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+struct Location {
+    segment: u64,
+    offset: u64,
+    len: u32,
+}
+
+#[derive(Debug, Default)]
+struct LogIndex {
+    keys: BTreeMap<String, Location>,
+    segments: BTreeMap<u64, SegmentUsage>,
+    live_bytes: u64,
+}
+
+#[derive(Debug, Default, Clone, Copy)]
+struct SegmentUsage {
+    total_bytes: u64,
+    live_bytes: u64,
+}
+
+/// Encoded frame plus the location of every value it puts.
+struct EncodedFrame {
+    bytes: Vec<u8>,
+    puts: Vec<Location>,
+}
+
+impl LogStructuredStorageHandler {
+    /// Open (or create) a log in `dir` with the default configuration.
+    pub async fn open(dir: PathBuf) -> Result<Self, StorageError> {
+        Self::open_with_config(dir, LogStorageConfig::default()).await
+    }
+
+    /// Open (or create) a log in `dir`, replaying existing segments to
+    /// rebuild the key index.
+    pub async fn open_with_config(
+        dir: PathBuf,
+        config: LogStorageConfig,
+    ) -> Result<Self, StorageError> {
+        fs::create_dir_all(&dir).await.map_err(|e| {
+            StorageError::WriteFailed(format!("Failed to create storage directory: {e}"))
+        })?;
+
+        let segment_ids = list_segments(&dir).await?;
+        let mut index = LogIndex::default();
+        for (position, &id) in segment_ids.iter().enumerate() {
+            let path = segment_path(&dir, id);
+            let bytes = fs::read(&path).await.map_err(|e| {
+                StorageError::ReadFailed(format!("Failed to read segment {id}: {e}"))
+            })?;
+            let valid_len = index.replay_segment(id, &bytes);
+            if valid_len < bytes.len() as u64 {
+                if position + 1 != segment_ids.len() {
+                    return Err(StorageError::CorruptionDetected {
+                        details: format!("sealed segment {id} is corrupt at byte {valid_len}"),
+                    });
+                }
+                truncate_segment(&path, valid_len).await?;
+            }
+        }
+
+        let writer = match segment_ids.last() {
+            Some(&id) if index.segment_len(id) < config.segment_size_bytes => {
+                open_segment(&dir, id, index.segment_len(id)).await?
+            }
+            last => {
+                let id = last.map_or(0, |id| id + 1);
+                index.segments.insert(id, SegmentUsage::default());
+                open_segment(&dir, id, 0).await?
+            }
+        };
+
+        Ok(Self {
+            inner: Arc::new(LogInner {
+                dir,
+                config,
+                queue: Mutex::new(Vec::new()),
+                writer: Mutex::new(writer),
+                index: RwLock::new(index),
+                compacting: AtomicBool::new(false),
+                compaction_due: AtomicBool::new(false),
+            }),
+        })
+    }
+
+    /// Compact sealed segments now, regardless of the garbage threshold.
+    pub async fn compact(&self) -> Result<(), StorageError> {
+        self.inner.compact().await
+    }
+
+    /// Whether a commit has marked the sealed segments due for compaction.
+    pub fn compaction_due(&self) -> bool {
+        self.inner.compaction_due.load(Ordering::Acquire)
+    }
+
+    /// Compact sealed segments if a commit marked them due.
+    ///
+    /// Meant to be driven by a periodic task owned by the handler's owner.
+    /// Returns whether a compaction pass ran; a failed pass leaves the log
+    /// marked due so the next call retries.
+    pub async fn compact_sealed(&self) -> Result<bool, StorageError> {
+        if !self.inner.compaction_due.swap(false, Ordering::AcqRel) {
+            return Ok(false);
+        }
+        let result = self.inner.compact().await;
+        if result.is_err() {
+            self.inner.compaction_due.store(true, Ordering::Release);
+        }
+        result.map(|()| true)
+    }
+
+    /// Number of segment files currently on disk.
+    pub async fn segment_count(&self) -> usize {
+        self.inner.index.read().await.segments.len()
+    }
+
+    async fn commit(&self, ops: Vec<LogOp>) -> Result<usize, StorageError> {
+        let (done, result) = oneshot::channel();
+        self.inner
+            .queue
+            .lock()
+            .await
+            .push(PendingCommit { ops, done });
+
+        // Whoever holds the writer lock commits everything queued so far. If
+        // an earlier leader already took our frame, the queue may be empty
+        // and our result is waiting on the channel.
+        let compaction_due = {
+            let mut writer = self.inner.writer.lock().await;
+            let group = std::mem::take(&mut *self.inner.queue.lock().await);
+            !group.is_empty() && self.inner.commit_group(&mut writer, group).await
+        };
+        if compaction_due {
+            self.inner.compaction_due.store(true, Ordering::Release);
+        }
+
+        result.await.map_err(|_| {
+            StorageError::WriteFailed("group commit was abandoned before completing".to_string())
+        })?
+    }
+}
+
+impl LogInner {
+    /// Append every frame in `group` with one fsync and publish the results.
+    ///
+    /// Returns whether the sealed segments are due for compaction.
+    async fn commit_group(&self, writer: &mut ActiveSegment, group: Vec<PendingCommit>) -> bool {
+        let start = writer.len;
+        let mut bytes = Vec::new();
+        let mut frames = Vec::with_capacity(group.len());
+        let mut encoded = Vec::with_capacity(group.len());
+        for pending in group {
+            match encode_frame(writer.id, start + bytes.len() as u64, &pending.ops) {
+                Ok(frame) => {
+                    bytes.extend_from_slice(&frame.bytes);
+                    frames.push(frame.puts);
+                    encoded.push(pending);
+                }
+                Err(error) => {
+                    let _ = pending.done.send(Err(error));
+                }
+            }
+        }
+        let group = encoded;
+        if group.is_empty() {
+            return false;
+        }
+
+        if let Err(error) = append_and_sync(writer, &bytes).await {
+            let detail = error.to_string();
+            for pending in group {
+                let _ = pending
+                    .done
+                    .send(Err(StorageError::WriteFailed(detail.clone())));
+            }
+            return false;
+        }
+
+        {
+            let mut index = self.index.write().await;
+            index.segment_usage(writer.id).total_bytes += bytes.len() as u64;
+            for (pending, puts) in group.into_iter().zip(frames) {
+                let removed = index.apply(pending.ops, puts);
+                let _ = pending.done.send(Ok(removed));
+            }
+        }
+
+        if writer.len >= self.config.segment_size_bytes {
+            if let Err(error) = self.roll_segment(writer).await {
+                tracing::warn!(error = %error, "Failed to roll log segment; continuing in current");
+            }
+        }
+        self.index
+            .read()
+            .await
+            .compaction_due(writer.id, &self.config)
+    }
+
+    /// Seal the active segment and start the next one.
+    async fn roll_segment(&self, writer: &mut ActiveSegment) -> Result<(), StorageError> {
+        let id = writer.id + 1;
+        *writer = open_segment(&self.dir, id, 0).await?;
+        self.index
+            .write()
+            .await
+            .segments
+            .insert(id, SegmentUsage::default());
+        Ok(())
+    }
+
+    /// Copy live values out of every sealed segment, then delete them.
+    async fn compact(&self) -> Result<(), StorageError> {
+        if self.compacting.swap(true, Ordering::AcqRel) {
+            return Ok(());
+        }
+        let result = self.compact_sealed().await;
+        self.compacting.store(false, Ordering::Release);
+        result
+    }
+
+    async fn compact_sealed(&self) -> Result<(), StorageError> {
+        // Snapshot under the writer lock so no commit lands between choosing
+        // the sealed segments and reading their live keys.
+        let (sealed, live) = {
+            let writer = self.writer.lock().await;
+            let index = self.index.read().await;
+            let sealed: Vec<u64> = index
+                .segments
+                .keys()
+                .copied()
+                .filter(|&id| id != writer.id)
+                .collect();
+            let live: Vec<(String, Location)> = index
+                .keys
+                .iter()
+                .filter(|(_, location)| location.segment != writer.id)
+                .map(|(key, location)| (key.clone(), *location))
+                .collect();
+            (sealed, live)
+        };
+        if sealed.is_empty() {
+            return Ok(());
+        }
+
+        // Only compaction deletes segments and `compacting` excludes a second
+        // pass, so the sealed files stay put while we read them unlocked.
+        let mut copies = Vec::with_capacity(live.len());
+        for (key, location) in live {
+            let value = read_value(&self.dir, location).await?;
+            copies.push((key, location, value));
+        }
+
+        // Commits update the index only while holding the writer lock, so the
+        // live set is stable from here until the swap below.
+        let mut writer = self.writer.lock().await;
+        // Keys overwritten, deleted or cleared since the snapshot must not be
+        // copied: a put after their tombstone would resurrect them on replay.
+        let (moved, ops): (Vec<_>, Vec<_>) = {
+            let index = self.index.read().await;
+            copies
+                .into_iter()
+                .filter(|(key, old, _)| index.keys.get(key) == Some(old))
+                .map(|(key, old, value)| ((key.clone(), old), LogOp::Put { key, value }))
+                .unzip()
+        };
+        let frame = if ops.is_empty() {
+            None
+        } else {
+            let frame = encode_frame(writer.id, writer.len, &ops)?;
+            append_and_sync(&mut writer, &frame.bytes).await?;
+            Some(frame)
+        };
+
+        let mut index = self.index.write().await;
+        if let Some(frame) = frame {
+            index.segment_usage(writer.id).total_bytes += frame.bytes.len() as u64;
+            for ((key, old), new) in moved.into_iter().zip(frame.puts) {
+                index.relocate(key, old, new);
+            }
+        }
+        // Oldest first: a tombstone must outlive every put it shadows.
+        for id in sealed {
+            fs::remove_file(segment_path(&self.dir, id))
+                .await
+                .map_err(|e| {
+                    StorageError::DeleteFailed(format!("Failed to remove segment {id}: {e}"))
+                })?;
+            index.segments.remove(&id);
+        }
+        drop(index);
+
+        if writer.len >= self.config.segment_size_bytes {
+            self.roll_segment(&mut writer).await?;
+        }
+        Ok(())
+    }
+}
+
+impl LogIndex {
+    /// Replay the frames of one segment; returns the length of its valid prefix.
+    fn replay_segment(&mut self, id: u64, bytes: &[u8]) -> u64 {
+        self.segments.insert(id, SegmentUsage::default());
+        let mut cursor = 0usize;
+        while let Some((ops, frame_len)) = decode_frame(id, cursor as u64, &bytes[cursor..]) {
+            self.segment_usage(id).total_bytes += frame_len as u64;
+            let (ops, puts) = ops.into_iter().unzip();
+            self.apply(ops, puts);
+            cursor += frame_len;
+        }
+        cursor as u64
+    }
+
+    fn segment_len(&self, id: u64) -> u64 {
+        self.segments.get(&id).map_or(0, |usage| usage.total_bytes)
+    }
+
+    fn segment_usage(&mut self, id: u64) -> &mut SegmentUsage {
+        self.segments.entry(id).or_default()
+    }
+
+    /// Apply committed ops; returns how many existing keys were removed.
+    ///
+    /// `puts` holds one location per op; only put locations are meaningful.
+    fn apply(&mut self, ops: Vec<LogOp>, puts: Vec<Location>) -> usize {
+        let mut removed = 0;
+        for (op, location) in ops.into_iter().zip(puts) {
+            match op {
+                LogOp::Put { key, .. } => {
+                    self.forget(self.keys.get(&key).copied());
+                    self.remember(location);
+                    self.keys.insert(key, location);
+                }
+                LogOp::Delete { key } => {
+                    let previous = self.keys.remove(&key);
+                    removed += usize::from(previous.is_some());
+                    self.forget(previous);
+                }
+                LogOp::Clear => {
+                    removed += self.keys.len();
+                    self.keys.clear();
+                    self.live_bytes = 0;
+                    for usage in self.segments.values_mut() {
+                        usage.live_bytes = 0;
+                    }
+                }
+            }
+        }
+        removed
+    }
+
+    fn relocate(&mut self, key: String, old: Location, new: Location) {
+        self.forget(Some(old));
+        self.remember(new);
+        self.keys.insert(key, new);
+    }
+
+    fn remember(&mut self, location: Location) {
+        self.live_bytes += u64::from(location.len);
+        self.segment_usage(location.segment).live_bytes += u64::from(location.len);
+    }
+
+    fn forget(&mut self, location: Option<Location>) {
+        let Some(location) = location else {
+            return;
+        };
+        self.live_bytes -= u64::from(location.len);
+        if let Some(usage) = self.segments.get_mut(&location.segment) {
+            usage.live_bytes -= u64::from(location.len);
+        }
+    }
+
+    fn compaction_due(&self, active: u64, config: &LogStorageConfig) -> bool {
+        let (total, live) = self
+            .segments
+            .iter()
+            .filter(|(&id, _)| id != active)
+            .fold((0u64, 0u64), |(total, live), (_, usage)| {
+                (total + usage.total_bytes, live + usage.live_bytes)
+            });
+        total > 0
+            && total >= config.min_compaction_bytes
+            && (total - live) as f64 >= total as f64 * config.compaction_garbage_ratio
+    }
+}
+
+#[async_trait]
+impl StorageCoreEffects for LogStructuredStorageHandler {
+    async fn store(&self, key: &str, value: Vec<u8>) -> Result<(), StorageError> {
+        FilesystemStorageHandler::validate_key_segments(key)?;
+        self.commit(vec![LogOp::Put {
+            key: key.to_string(),
+            value,
+        }])
+        .await?;
+        Ok(())
+    }
+
+    async fn retrieve(&self, key: &str) -> Result<Option<Vec<u8>>, StorageError> {
+        FilesystemStorageHandler::validate_key_segments(key)?;
+        let index = self.inner.index.read().await;
+        match index.keys.get(key) {
+            Some(&location) => Ok(Some(read_value(&self.inner.dir, location).await?)),
+            None => Ok(None),
+        }
+    }
+
+    async fn remove(&self, key: &str) -> Result<bool, StorageError> {
+        FilesystemStorageHandler::validate_key_segments(key)?;
+        if !self.inner.index.read().await.keys.contains_key(key) {
+            return Ok(false);
+        }
+        let removed = self
+            .commit(vec![LogOp::Delete {
+                key: key.to_string(),
+            }])
+            .await?;
+        Ok(removed > 0)
+    }
+
+    async fn list_keys(&self, prefix: Option<&str>) -> Result<Vec<String>, StorageError> {
+        let index = self.inner.index.read().await;
+        let keys = match prefix {
+            Some(prefix) => {
+                FilesystemStorageHandler::validate_key_prefix(prefix)?;
+                index
+                    .keys
+                    .range(prefix.to_string()..)
+                    .take_while(|(key, _)| key.starts_with(prefix))
+                    .map(|(key, _)| key.clone())
+                    .collect()
+            }
+            None => index.keys.keys().cloned().collect(),
+        };
+        Ok(keys)
+    }
+}
+
+#[async_trait]
+impl StorageExtendedEffects for LogStructuredStorageHandler {
+    async fn exists(&self, key: &str) -> Result<bool, StorageError> {
+        FilesystemStorageHandler::validate_key_segments(key)?;
+        Ok(self.inner.index.read().await.keys.contains_key(key))
+    }
+
+    async fn store_batch(&self, pairs: HashMap<String, Vec<u8>>) -> Result<(), StorageError> {
+        for key in pairs.keys() {
+            FilesystemStorageHandler::validate_key_segments(key)?;
+        }
+        if pairs.is_empty() {
+            return Ok(());
+        }
+        let ops = pairs
+            .into_iter()
+            .map(|(key, value)| LogOp::Put { key, value })
+            .collect();
+        self.commit(ops).await?;
+        Ok(())
+    }
+
+    async fn retrieve_batch(
+        &self,
+        keys: &[String],
+    ) -> Result<HashMap<String, Vec<u8>>, StorageError> {
+        for key in keys {
+            FilesystemStorageHandler::validate_key_segments(key)?;
+        }
+        let index = self.inner.index.read().await;
+        let mut out = HashMap::new();
+        for key in keys {
+            if let Some(&location) = index.keys.get(key) {
+                out.insert(key.clone(), read_value(&self.inner.dir, location).await?);
+            }
+        }
+        Ok(out)
+    }
+
+    async fn clear_all(&self) -> Result<(), StorageError> {
+        self.commit(vec![LogOp::Clear]).await?;
+        Ok(())
+    }
+
+    async fn stats(&self) -> Result<StorageStats, StorageError> {
+        let index = self.inner.index.read().await;
+        Ok(StorageStats {
+            key_count: index.keys.len() as u64,
+            total_size: index.live_bytes,
+            available_space: None,
+            backend_type: "log_structured".to_string(),
+        })
+    }
+}
+
+fn segment_path(dir: &Path, id: u64) -> PathBuf {
+    dir.join(format!("{id:016}.{SEGMENT_EXTENSION}"))
+}
+
+async fn list_segments(dir: &Path) -> Result<Vec<u64>, StorageError> {
+    let mut entries = fs::read_dir(dir)
+        .await
+        .map_err(|e| StorageError::ListFailed(format!("Failed to read storage directory: {e}")))?;
+    let mut ids = Vec::new();
+    while let Some(entry) = entries
+        .next_entry()
+        .await
+        .map_err(|e| StorageError::ListFailed(format!("Failed to read directory entry: {e}")))?
+    {
+        let path = entry.path();
+        if path.extension().and_then(|e| e.to_str()) != Some(SEGMENT_EXTENSION) {
+            continue;
+        }
+        if let Some(id) = path
+            .file_stem()
+            .and_then(|stem| stem.to_str())
+            .and_then(|stem| stem.parse::<u64>().ok())
+        {
+            ids.push(id);
+        }
+    }
+    ids.sort_unstable();
+    Ok(ids)
+}
+
+async fn open_segment(dir: &Path, id: u64, len: u64) -> Result<ActiveSegment, StorageError> {
+    let file = fs::OpenOptions::new()
+        .create(true)
+        .append(true)
+        .open(segment_path(dir, id))
+        .await
+        .map_err(|e| StorageError::WriteFailed(format!("Failed to open segment {id}: {e}")))?;
+    Ok(ActiveSegment { id, file, len })
+}
+
+async fn truncate_segment(path: &Path, len: u64) -> Result<(), StorageError> {
+    let file = fs::OpenOptions::new()
+        .write(true)
+        .open(path)
+        .await
+        .map_err(|e| StorageError::WriteFailed(format!("Failed to open torn segment: {e}")))?;
+    file.set_len(len)
+        .await
+        .map_err(|e| StorageError::WriteFailed(format!("Failed to truncate torn segment: {e}")))?;
+    file.sync_all()
+        .await
+        .map_err(|e| StorageError::WriteFailed(format!("Failed to sync truncated segment: {e}")))
+}
+
+/// Append `bytes` to the active segment and make them durable.
+///
+/// On failure the segment is truncated back to its previous length so a
+/// partial frame never precedes later commits.
+async fn append_and_sync(writer: &mut ActiveSegment, bytes: &[u8]) -> Result<(), StorageError> {
+    let written = async {
+        writer.file.write_all(bytes).await?;
+        writer.file.flush().await?;
+        writer.file.sync_data().await
+    }
+    .await;
+    if let Err(error) = written {
+        let _ = writer.file.set_len(writer.len).await;
+        return Err(StorageError::WriteFailed(format!(
+            "Failed to append to segment {}: {error}",
+            writer.id
+        )));
+    }
+    writer.len += bytes.len() as u64;
+    Ok(())
+}
+
+async fn read_value(dir: &Path, location: Location) -> Result<Vec<u8>, StorageError> {
+    let mut file = fs::File::open(segment_path(dir, location.segment))
+        .await
+        .map_err(|e| {
+            StorageError::ReadFailed(format!("Failed to open segment {}: {e}", location.segment))
+        })?;
+    file.seek(std::io::SeekFrom::Start(location.offset))
+        .await
+        .map_err(|e| StorageError::ReadFailed(format!("Failed to seek segment: {e}")))?;
+    let mut value = vec![0u8; location.len as usize];
+    file.read_exact(&mut value)
+        .await
+        .map_err(|e| StorageError::ReadFailed(format!("Failed to read value: {e}")))?;
+    Ok(value)
+}
+
+/// Encode `ops` as one frame starting at `frame_offset` within `segment`.
+///
+/// Fails if a key, a value or the whole body does not fit a `u32` length.
+fn encode_frame(
+    segment: u64,
+    frame_offset: u64,
+    ops: &[LogOp],
+) -> Result<EncodedFrame, StorageError> {
+    let body_offset = frame_offset + FRAME_HEADER_LEN as u64;
+    let mut body = Vec::new();
+    let mut puts = Vec::with_capacity(ops.len());
+    for op in ops {
+        match op {
+            LogOp::Put { key, value } => {
+                body.push(OP_PUT);
+                put_bytes(&mut body, key.as_bytes())?;
+                let offset = body_offset + body.len() as u64 + 4;
+                let len = put_bytes(&mut body, value)?;
+                puts.push(Location {
+                    segment,
+                    offset,
+                    len,
+                });
+            }
+            LogOp::Delete { key } => {
+                body.push(OP_DELETE);
+                put_bytes(&mut body, key.as_bytes())?;
+                puts.push(Location {
+                    segment,
+                    offset: 0,
+                    len: 0,
+                });
+            }
+            LogOp::Clear => {
+                body.push(OP_CLEAR);
+                puts.push(Location {
+                    segment,
+                    offset: 0,
+                    len: 0,
+                });
+            }
+        }
+    }
+
+    let mut bytes = Vec::with_capacity(FRAME_HEADER_LEN + body.len());
+    bytes.extend_from_slice(&frame_len(body.len())?.to_le_bytes());
+    bytes.extend_from_slice(&aura_core::hash::hash(&body));
+    bytes.extend_from_slice(&body);
+    Ok(EncodedFrame { bytes, puts })
+}
+
+/// Ops of a decoded frame with their locations, and the frame's length.
+type DecodedFrame = (Vec<(LogOp, Location)>, usize);
+
+/// Decode the frame at the start of `bytes`, found at `frame_offset` in
+/// `segment`. Returns `None` for a torn or corrupt frame.
+fn decode_frame(segment: u64, frame_offset: u64, bytes: &[u8]) -> Option<DecodedFrame> {
+    let body_len = u32::from_le_bytes(bytes.get(..4)?.try_into().ok()?) as usize;
+    let checksum = bytes.get(4..FRAME_HEADER_LEN)?;
+    let body = bytes.get(FRAME_HEADER_LEN..FRAME_HEADER_LEN.checked_add(body_len)?)?;
+    if aura_core::hash::hash(body) != *checksum {
+        return None;
+    }
+
+    let body_offset = frame_offset + FRAME_HEADER_LEN as u64;
+    let tombstone = Location {
+        segment,
+        offset: 0,
+        len: 0,
+    };
+    let mut ops = Vec::new();
+    let mut cursor = 0usize;
+    while cursor < body.len() {
+        let tag = body[cursor];
+        cursor += 1;
+        match tag {
+            OP_PUT => {
+                let key = take_string(body, &mut cursor)?;
+                let offset = body_offset + cursor as u64 + 4;
+                let value = take_bytes(body, &mut cursor)?.to_vec();
+                let len = value.len() as u32;
+                ops.push((
+                    LogOp::Put { key, value },
+                    Location {
+                        segment,
+                        offset,
+                        len,
+                    },
+                ));
+            }
+            OP_DELETE => {
+                let key = take_string(body, &mut cursor)?;
+                ops.push((LogOp::Delete { key }, tombstone));
+            }
+            OP_CLEAR => ops.push((LogOp::Clear, tombstone)),
+            _ => return None,
+        }
+    }
+    Some((ops, FRAME_HEADER_LEN + body_len))
+}
+
+/// Length prefix for a frame field, rejecting anything past `u32::MAX`.
+fn frame_len(len: usize) -> Result<u32, StorageError> {
+    u32::try_from(len).map_err(|_| {
+        StorageError::WriteFailed(format!("log frame field of {len} bytes exceeds u32 length"))
+    })
+}
+
+/// Append a length-prefixed field; returns the field's length.
+fn put_bytes(out: &mut Vec<u8>, bytes: &[u8]) -> Result<u32, StorageError> {
+    let len = frame_len(bytes.len())?;
+    out.extend_from_slice(&len.to_le_bytes());
+    out.extend_from_slice(bytes);
+    Ok(len)
+}
+
+fn take_bytes<'a>(body: &'a [u8], cursor: &mut usize) -> Option<&'a [u8]> {
+    let len = u32::from_le_bytes(body.get(*cursor..*cursor + 4)?.try_into().ok()?) as usize;
+    let start = *cursor + 4;
+    let bytes = body.get(start..start.checked_add(len)?)?;
+    *cursor = start + len;
+    Some(bytes)
+}
+
+fn take_string(body: &[u8], cursor: &mut usize) -> Option<String> {
+    String::from_utf8(take_bytes(body, cursor)?.to_vec()).ok()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use tempfile::TempDir;
+
+    fn small_segments() -> LogStorageConfig {
+        LogStorageConfig {
+            segment_size_bytes: 256,
+            compaction_garbage_ratio: 0.5,
+            min_compaction_bytes: u64::MAX,
+        }
+    }
+
+    #[tokio::test]
+    async fn log_storage_round_trips_and_lists_by_prefix() {
+        let temp_dir = TempDir::new().unwrap();
+        let handler = LogStructuredStorageHandler::open(temp_dir.path().to_path_buf())
+            .await
+            .unwrap();
+
+        let mut pairs = HashMap::new();
+        pairs.insert("journal/facts/a".to_string(), b"a".to_vec());
+        pairs.insert("journal/facts/b".to_string(), b"bb".to_vec());
+        pairs.insert("other/c".to_string(), b"ccc".to_vec());
+        handler.store_batch(pairs).await.unwrap();
+        handler
+            .store("journal/facts/a", b"a2".to_vec())
+            .await
+            .unwrap();
+
+        assert_eq!(
+            handler.retrieve("journal/facts/a").await.unwrap(),
+            Some(b"a2".to_vec())
+        );
+        assert_eq!(
+            handler.list_keys(Some("journal/facts/")).await.unwrap(),
+            vec!["journal/facts/a".to_string(), "journal/facts/b".to_string()]
+        );
+        assert!(handler.remove("other/c").await.unwrap());
+        assert!(!handler.remove("other/c").await.unwrap());
+
+        let stats = handler.stats().await.unwrap();
+        assert_eq!(stats.key_count, 2);
+        assert_eq!(stats.total_size, 4);
+    }
+
+    #[tokio::test]
+    async fn log_storage_recovers_index_and_drops_torn_tail() {
+        let temp_dir = TempDir::new().unwrap();
+        let dir = temp_dir.path().to_path_buf();
+        {
+            let handler = LogStructuredStorageHandler::open(dir.clone())
+                .await
+                .unwrap();
+            handler.store("kept", b"value".to_vec()).await.unwrap();
+            handler.store("gone", b"value".to_vec()).await.unwrap();
+            handler.remove("gone").await.unwrap();
+        }
+
+        // Simulate a crash halfway through appending a frame.
+        let segment = segment_path(&dir, 0);
+        let mut bytes = std::fs::read(&segment).unwrap();
+        let intact = bytes.len();
+        let torn = encode_frame(
+            0,
+            intact as u64,
+            &[LogOp::Put {
+                key: "torn".to_string(),
+                value: b"partial".to_vec(),
+            }],
+        )
+        .unwrap();
+        bytes.extend_from_slice(&torn.bytes[..torn.bytes.len() - 3]);
+        std::fs::write(&segment, bytes).unwrap();
+
+        let handler = LogStructuredStorageHandler::open(dir).await.unwrap();
+        assert_eq!(
+            handler.retrieve("kept").await.unwrap(),
+            Some(b"value".to_vec())
+        );
+        assert!(!handler.exists("gone").await.unwrap());
+        assert!(!handler.exists("torn").await.unwrap());
+        assert_eq!(std::fs::metadata(&segment).unwrap().len(), intact as u64);
+    }
+
+    #[tokio::test]
+    async fn log_storage_compaction_keeps_live_values_and_tombstones() {
+        let temp_dir = TempDir::new().unwrap();
+        let dir = temp_dir.path().to_path_buf();
+        let handler = LogStructuredStorageHandler::open_with_config(dir.clone(), small_segments())
+            .await
+            .unwrap();
+
+        for round in 0..8u8 {
+            handler.store("hot", vec![round; 64]).await.unwrap();
+        }
+        handler.store("cold", b"cold".to_vec()).await.unwrap();
+        handler.store("deleted", b"x".to_vec()).await.unwrap();
+        handler.remove("deleted").await.unwrap();
+        assert!(handler.segment_count().await > 1);
+
+        handler.compact().await.unwrap();
+        assert_eq!(handler.segment_count().await, 1);
+        drop(handler);
+
+        let reopened = LogStructuredStorageHandler::open_with_config(dir, small_segments())
+            .await
+            .unwrap();
+        assert_eq!(reopened.retrieve("hot").await.unwrap(), Some(vec![7; 64]));
+        assert_eq!(
+            reopened.retrieve("cold").await.unwrap(),
+            Some(b"cold".to_vec())
+        );
+        assert!(!reopened.exists("deleted").await.unwrap());
+    }
+
+    #[tokio::test]
+    async fn log_storage_compacts_only_once_marked_due() {
+        let temp_dir = TempDir::new().unwrap();
+        let config = LogStorageConfig {
+            min_compaction_bytes: 0,
+            ..small_segments()
+        };
+        let handler =
+            LogStructuredStorageHandler::open_with_config(temp_dir.path().to_path_buf(), config)
+                .await
+                .unwrap();
+
+        assert!(!handler.compact_sealed().await.unwrap());
+        for round in 0..8u8 {
+            handler.store("hot", vec![round; 64]).await.unwrap();
+        }
+        // Commits only mark compaction due; nothing runs until scheduled.
+        assert!(handler.compaction_due());
+        assert!(handler.segment_count().await > 1);
+
+        assert!(handler.compact_sealed().await.unwrap());
+        assert!(!handler.compaction_due());
+        assert_eq!(handler.segment_count().await, 1);
+        assert_eq!(handler.retrieve("hot").await.unwrap(), Some(vec![7; 64]));
+    }
+
+    #[test]
+    fn log_frame_lengths_reject_u32_overflow() {
+        assert_eq!(frame_len(7).unwrap(), 7);
+        if let Ok(len) = usize::try_from(u64::from(u32::MAX) + 1) {
+            assert!(frame_len(len).is_err());
+        }
+    }
+
+    #[tokio::test]
+    async fn log_storage_rejects_invalid_keys() {
+        let temp_dir = TempDir::new().unwrap();
+        let handler = LogStructuredStorageHandler::open(temp_dir.path().to_path_buf())
+            .await
+            .unwrap();
+
+        for key in ["", "../secret", "/tmp/x", "safe//unsafe"] {
+            let error = handler.store(key, b"blocked".to_vec()).await.unwrap_err();
+            assert!(matches!(error, StorageError::InvalidKey { .. }));
+        }
+        let error = handler.list_keys(Some("../")).await.unwrap_err();
+        assert!(matches!(error, StorageError::InvalidKey { .. }));
+    }
+}
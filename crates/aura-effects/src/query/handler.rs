@@ -7,7 +7,7 @@ use async_trait::async_trait;
 use std::collections::{HashMap, HashSet};
 use std::sync::Arc;
 use std::time::Duration;
-use tokio::sync::{broadcast, RwLock};
+use tokio::sync::{broadcast, Mutex, RwLock};
 
 #[cfg(target_arch = "wasm32")]
 type MonotonicInstant = web_time::Instant;
@@ -36,7 +36,8 @@ use aura_core::{Hash32, ResourceScope};
 use crate::database::query::AuraQuery;
 use crate::reactive::ReactiveHandler;
 
-use super::datalog::{format_rule, parse_fact_to_row};
+use super::datalog::parse_fact_to_row;
+use super::incremental::{evaluate_rule, IncrementalProgram, ProgramChange};
 
 // ─────────────────────────────────────────────────────────────────────────────
 // Query Registration
@@ -53,6 +54,8 @@ struct QueryRegistrationImpl<Q: Query> {
     signal: Signal<Q::Result>,
     query: Q,
     deps: Vec<FactPredicate>,
+    /// Query result maintained across refreshes
+    program: Mutex<IncrementalProgram>,
 }
 
 #[async_trait]
@@ -65,39 +68,88 @@ impl<Q: Query> QueryRegistration for QueryRegistrationImpl<Q> {
         &self.deps
     }
 
+    /// Push facts added since the last refresh through the query.
+    ///
+    /// The signal is only re-emitted, and a [`QueryResultDelta`] published,
+    /// when the result gained rows or was rebuilt.
     async fn refresh(&self, handler: &QueryHandler) -> Result<(), QueryError> {
-        let result = handler.query(&self.query).await?;
+        handler.authorize_query(&self.query).await?;
+
+        let (change, bindings) = {
+            let facts = handler.facts.read().await;
+            let mut program = self.program.lock().await;
+            let change = program.refresh(&facts);
+            if change.is_empty() {
+                return Ok(());
+            }
+            (change, program.bindings().clone())
+        };
+
+        let result = Q::parse(bindings).map_err(QueryError::from)?;
         handler
             .reactive
             .emit(&self.signal, result)
             .await
-            .map_err(|e| QueryError::execution_error(e.to_string()))
+            .map_err(|e| QueryError::execution_error(e.to_string()))?;
+        handler.publish_result_delta(self.signal.id(), change);
+        Ok(())
     }
 }
 
+/// Change to the result of a query-bound signal.
+///
+/// Published after a refresh that changed the result, so subscribers can
+/// apply new rows instead of diffing whole results.
+#[derive(Debug, Clone)]
+pub struct QueryResultDelta {
+    /// Signal the query is bound to
+    pub signal_id: SignalId,
+    /// The result was rebuilt (fact store cleared); `added` is the full result
+    pub reset: bool,
+    /// Rows added to the result
+    pub added: DatalogBindings,
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Query Facts Store
 // ─────────────────────────────────────────────────────────────────────────────
 
 /// Facts available for querying (loaded from journal).
+///
+/// Rows are shared per predicate, so cloning the store (for a snapshot) is
+/// cheap and a later `add` copies only the predicate it writes to.
 #[derive(Debug, Default, Clone)]
 pub(super) struct QueryFacts {
     /// Raw facts keyed by predicate
-    facts: HashMap<String, Vec<Vec<String>>>,
+    facts: HashMap<String, Arc<Vec<Vec<String>>>>,
+    /// Incremented by `clear`; between clears rows are only appended
+    epoch: u64,
 }
 
 impl QueryFacts {
     /// Add a fact to the store.
     pub fn add(&mut self, predicate: &str, args: Vec<String>) {
-        self.facts
-            .entry(predicate.to_string())
-            .or_default()
-            .push(args);
+        let rows = self.facts.entry(predicate.to_string()).or_default();
+        Arc::make_mut(rows).push(args);
     }
 
     /// Clear all facts.
     pub fn clear(&mut self) {
         self.facts.clear();
+        self.epoch += 1;
+    }
+
+    /// Clear count, used to detect when incremental results must be rebuilt.
+    pub fn epoch(&self) -> u64 {
+        self.epoch
+    }
+
+    /// Rows of a predicate, in insertion order.
+    pub fn rows(&self, predicate: &str) -> &[Vec<String>] {
+        self.facts
+            .get(predicate)
+            .map(|rows| rows.as_slice())
+            .unwrap_or_default()
     }
 
     /// Check if the store is empty (used in tests).
@@ -111,17 +163,22 @@ impl QueryFacts {
         self.facts.values().map(|v| v.len()).sum()
     }
 
-    /// Load facts into an AuraQuery for execution.
+    /// Load the rows of `predicate` from index `from` into an AuraQuery,
+    /// under the name `loaded_as`.
     ///
     /// Facts are loaded best-effort; malformed facts are silently skipped
     /// to allow partial query execution even with imperfect data.
-    pub fn load_into(&self, query: &mut AuraQuery) {
-        for (predicate, rows) in &self.facts {
-            for args in rows {
-                let terms: Vec<crate::database::query::FactTerm> =
-                    args.iter().map(|s| s.clone().into()).collect();
-                let _ = query.add_fact(predicate, terms);
-            }
+    pub fn load_predicate_into(
+        &self,
+        query: &mut AuraQuery,
+        predicate: &str,
+        loaded_as: &str,
+        from: usize,
+    ) {
+        for args in self.rows(predicate).iter().skip(from) {
+            let terms: Vec<crate::database::query::FactTerm> =
+                args.iter().map(|s| s.clone().into()).collect();
+            let _ = query.add_fact(loaded_as, terms);
         }
     }
 }
@@ -247,13 +304,14 @@ impl ConsensusTracker {
 
 /// Stores historical fact snapshots for Snapshot isolation.
 ///
-/// Snapshots are identified by prestate hash and contain a frozen copy
-/// of facts at that point in time. Old snapshots may be garbage collected
-/// to limit memory usage.
+/// Snapshots are identified by prestate hash and hold the facts at that
+/// point in time. They share rows with the live store copy-on-write, so a
+/// snapshot costs one reference per predicate until the live store changes.
+/// Old snapshots may be garbage collected to limit memory usage.
 #[derive(Debug, Default)]
 pub struct SnapshotStore {
     /// Snapshots keyed by prestate hash
-    snapshots: HashMap<Hash32, QueryFacts>,
+    snapshots: HashMap<Hash32, Arc<QueryFacts>>,
     /// Maximum number of snapshots to retain
     max_snapshots: usize,
     /// Order of snapshot creation (for LRU eviction)
@@ -272,10 +330,7 @@ impl SnapshotStore {
 
     /// Create a snapshot of the current facts at the given prestate hash.
     pub fn create_snapshot(&mut self, prestate_hash: Hash32, facts: &QueryFacts) {
-        // Clone the facts for the snapshot
-        let snapshot = QueryFacts {
-            facts: facts.facts.clone(),
-        };
+        let snapshot = Arc::new(facts.clone());
 
         // Evict oldest snapshot if at capacity
         while self.snapshots.len() >= self.max_snapshots && !self.creation_order.is_empty() {
@@ -288,7 +343,7 @@ impl SnapshotStore {
     }
 
     /// Get a snapshot by prestate hash.
-    pub fn get_snapshot(&self, prestate_hash: &Hash32) -> Option<&QueryFacts> {
+    pub fn get_snapshot(&self, prestate_hash: &Hash32) -> Option<&Arc<QueryFacts>> {
         self.snapshots.get(prestate_hash)
     }
 
@@ -372,12 +427,16 @@ const DEFAULT_CONSENSUS_TIMEOUT: Duration = Duration::from_secs(30);
 /// Default maximum number of snapshots to retain.
 const DEFAULT_MAX_SNAPSHOTS: usize = 100;
 
+/// Buffered result deltas before slow subscribers start lagging.
+const RESULT_DELTA_CHANNEL_CAPACITY: usize = 256;
+
 /// Production query effect handler.
 ///
 /// Implements `QueryEffects` by:
 /// - Using `AuraQuery` for Datalog execution via Biscuit
 /// - Delegating subscription management to `ReactiveHandler`
 /// - Tracking query dependencies for invalidation
+/// - Maintaining bound query results incrementally as facts arrive
 /// - Optionally using IndexedJournalEffects for efficient fact lookups
 ///
 /// # Authorization Model
@@ -419,6 +478,8 @@ pub struct QueryHandler {
     query_bindings: Arc<RwLock<HashMap<SignalId, Box<dyn QueryRegistration>>>>,
     /// Timeout for waiting on consensus
     consensus_timeout: Duration,
+    /// Result deltas of query-bound signals
+    result_deltas: broadcast::Sender<QueryResultDelta>,
 }
 
 impl QueryHandler {
@@ -442,6 +503,7 @@ impl QueryHandler {
             pending_consensus: Arc::new(RwLock::new(PendingConsensusTracker::default())),
             query_bindings: Arc::new(RwLock::new(HashMap::new())),
             consensus_timeout: DEFAULT_CONSENSUS_TIMEOUT,
+            result_deltas: broadcast::channel(RESULT_DELTA_CHANNEL_CAPACITY).0,
         }
     }
 
@@ -480,6 +542,7 @@ impl QueryHandler {
             pending_consensus: Arc::new(RwLock::new(PendingConsensusTracker::default())),
             query_bindings: Arc::new(RwLock::new(HashMap::new())),
             consensus_timeout: DEFAULT_CONSENSUS_TIMEOUT,
+            result_deltas: broadcast::channel(RESULT_DELTA_CHANNEL_CAPACITY).0,
         }
     }
 
@@ -574,30 +637,42 @@ impl QueryHandler {
     /// Register a query binding for reactive refresh.
     ///
     /// This stores the query and signal mapping and emits the initial query result.
+    /// Later refreshes evaluate only facts added since the previous one.
     pub async fn register_query_binding<Q: Query>(
         &self,
         signal: &Signal<Q::Result>,
         query: Q,
     ) -> Result<(), QueryError> {
         let deps = query.dependencies();
+        let program = IncrementalProgram::new(&query.to_datalog());
         let registration = QueryRegistrationImpl {
             signal: signal.clone(),
-            query: query.clone(),
+            query,
             deps,
+            program: Mutex::new(program),
         };
 
+        let initial = registration.refresh(self).await;
         self.query_bindings
             .write()
             .await
             .insert(signal.id().clone(), Box::new(registration));
 
-        let result = self.query(&query).await?;
-        self.reactive
-            .emit(signal, result)
-            .await
-            .map_err(|e| QueryError::execution_error(e.to_string()))?;
+        initial
+    }
 
-        Ok(())
+    /// Subscribe to result deltas of all query-bound signals.
+    pub fn subscribe_result_deltas(&self) -> broadcast::Receiver<QueryResultDelta> {
+        self.result_deltas.subscribe()
+    }
+
+    fn publish_result_delta(&self, signal_id: &SignalId, change: ProgramChange) {
+        // No receivers is fine; deltas are an optional refinement of the signal
+        let _ = self.result_deltas.send(QueryResultDelta {
+            signal_id: signal_id.clone(),
+            reset: change.reset,
+            added: DatalogBindings { rows: change.added },
+        });
     }
 
     async fn refresh_queries_for_predicate(&self, predicate: &FactPredicate) {
@@ -801,27 +876,12 @@ impl QueryHandler {
         program: &DatalogProgram,
         facts: &QueryFacts,
     ) -> Result<DatalogBindings, QueryError> {
-        let mut aura_query = AuraQuery::new();
-
-        // Load facts from the provided store
-        facts.load_into(&mut aura_query);
-
         // Execute each rule and collect results
         let mut all_rows = Vec::new();
 
         for rule in &program.rules {
-            let rule_string = format_rule(rule);
-
-            match aura_query.query(&rule_string) {
-                Ok(result) => {
-                    for fact_strings in result.facts {
-                        let row = parse_fact_to_row(&fact_strings);
-                        all_rows.push(row);
-                    }
-                }
-                Err(e) => {
-                    tracing::warn!(rule = %rule_string, error = %e, "Rule execution failed");
-                }
+            for fact_strings in evaluate_rule(facts, rule) {
+                all_rows.push(parse_fact_to_row(&fact_strings));
             }
         }
 
@@ -856,6 +916,7 @@ impl Clone for QueryHandler {
             pending_consensus: self.pending_consensus.clone(),
             query_bindings: self.query_bindings.clone(),
             consensus_timeout: self.consensus_timeout,
+            result_deltas: self.result_deltas.clone(),
         }
     }
 }
@@ -1159,6 +1220,56 @@ mod tests {
         assert_eq!(result, 1);
     }
 
+    #[tokio::test]
+    async fn test_query_binding_refresh_publishes_only_new_rows() {
+        let handler = QueryHandler::default();
+        let signal: Signal<usize> = Signal::new("query:test:contact_directory");
+        handler.reactive.register(&signal, 0).await.unwrap();
+        let mut deltas = handler.subscribe_result_deltas();
+        let user = FactPredicate::new("user");
+
+        handler.add_fact("user", vec!["alice".to_string()]).await;
+        handler
+            .register_query_binding(&signal, PublicContactQuery)
+            .await
+            .unwrap();
+        let initial = deltas.recv().await.unwrap();
+        assert!(initial.reset);
+        assert_eq!(initial.added.len(), 1);
+
+        handler.add_fact("user", vec!["bob".to_string()]).await;
+        handler.invalidate(&user).await;
+        let delta = deltas.recv().await.unwrap();
+        assert!(!delta.reset);
+        assert_eq!(delta.added.len(), 1);
+        assert_eq!(handler.reactive.read(&signal).await.unwrap(), 2);
+
+        // Nothing new: no re-emission
+        handler.invalidate(&user).await;
+        assert!(deltas.try_recv().is_err());
+
+        handler.clear_facts().await;
+        handler.add_fact("user", vec!["carol".to_string()]).await;
+        handler.invalidate(&user).await;
+        let rebuilt = deltas.recv().await.unwrap();
+        assert!(rebuilt.reset);
+        assert_eq!(handler.reactive.read(&signal).await.unwrap(), 1);
+    }
+
+    #[tokio::test]
+    async fn test_snapshot_is_unaffected_by_later_facts() {
+        let handler = QueryHandler::default();
+        handler.add_fact("user", vec!["alice".to_string()]).await;
+        let prestate_hash = Hash32([7u8; 32]);
+        handler.create_snapshot(prestate_hash).await;
+
+        handler.add_fact("user", vec!["bob".to_string()]).await;
+
+        let store = handler.snapshot_store.read().await;
+        assert_eq!(store.get_snapshot(&prestate_hash).unwrap().len(), 1);
+        assert_eq!(handler.facts.read().await.len(), 2);
+    }
+
     // ─────────────────────────────────────────────────────────────────────────
     // Isolation Infrastructure Tests
     // ─────────────────────────────────────────────────────────────────────────
@@ -0,0 +1,681 @@
+//! Incremental Datalog Evaluation
+//!
+//! Query-bound signals used to re-run their whole program whenever one of
+//! their dependencies was invalidated. [`IncrementalProgram`] keeps the facts
+//! each rule has derived and, on refresh, joins only the fact rows added
+//! since the previous evaluation (semi-naive evaluation).
+//!
+//! Every new derivation of a rule `h <- b1, ..., bn` uses at least one new
+//! row, so the new head facts are covered by the variants
+//! `h <- b1, ..., Δbi, ..., bn`, one per body atom whose predicate grew; for
+//! two atoms that is `ΔA⋈B ∪ A⋈ΔB`. A variant starts from the new rows of its
+//! delta atom and probes hash indexes over the other atoms' rows. The indexes
+//! live with the rule across refreshes and only take in appended rows, so a
+//! refresh costs time in the new rows and the matches they produce rather
+//! than in the size of the relations. Rules have no negation and fact rows
+//! only grow until the store is cleared, so the maintained result matches a
+//! full re-evaluation up to row order. As with Biscuit, base facts of the
+//! head predicate are part of the result.
+//!
+//! Recursive rules, and rules the join does not evaluate natively (symbol or
+//! null arguments, non-string body constants, head variables the body does
+//! not bind), are fully re-evaluated through Biscuit whenever a predicate
+//! they mention grows. Every rule is rebuilt after the fact store is cleared.
+
+use std::collections::{HashMap, HashSet};
+
+use aura_core::query::{DatalogBindings, DatalogProgram, DatalogRow, DatalogRule, DatalogValue};
+
+use crate::database::query::AuraQuery;
+
+use super::datalog::{format_rule, format_value, parse_fact_to_row};
+use super::handler::QueryFacts;
+
+/// Evaluate one rule from scratch against a fact store.
+///
+/// Only the predicates the rule mentions are loaded; other facts cannot
+/// affect its result. Returns Biscuit's fact strings for each derived fact.
+pub(super) fn evaluate_rule(facts: &QueryFacts, rule: &DatalogRule) -> Vec<Vec<String>> {
+    let mut query = AuraQuery::new();
+    for predicate in rule_predicates(rule) {
+        facts.load_predicate_into(&mut query, &predicate, &predicate, 0);
+    }
+    run_rule(&query, &format_rule(rule))
+}
+
+fn run_rule(query: &AuraQuery, rule_string: &str) -> Vec<Vec<String>> {
+    match query.query(rule_string) {
+        Ok(result) => result.facts,
+        Err(e) => {
+            tracing::warn!(rule = %rule_string, error = %e, "Rule execution failed");
+            Vec::new()
+        }
+    }
+}
+
+/// Head and body predicates of a rule, without duplicates.
+fn rule_predicates(rule: &DatalogRule) -> Vec<String> {
+    let mut predicates = vec![rule.head().predicate().as_str().to_string()];
+    for atom in rule.body() {
+        let predicate = atom.predicate().as_str();
+        if !predicates.iter().any(|p| p == predicate) {
+            predicates.push(predicate.to_string());
+        }
+    }
+    predicates
+}
+
+/// Rows a refresh added to a maintained program result.
+#[derive(Debug, Default)]
+pub(super) struct ProgramChange {
+    /// The result was rebuilt because the fact store was cleared
+    pub reset: bool,
+    /// Rows appended to the result
+    pub added: Vec<DatalogRow>,
+}
+
+impl ProgramChange {
+    /// Whether the result is unchanged.
+    pub fn is_empty(&self) -> bool {
+        !self.reset && self.added.is_empty()
+    }
+}
+
+/// A Datalog program whose result is maintained as facts are added.
+#[derive(Debug)]
+pub(super) struct IncrementalProgram {
+    rules: Vec<MaintainedRule>,
+    /// Fact store epoch the result was derived from (None before first refresh)
+    epoch: Option<u64>,
+    /// Accumulated result, in derivation order
+    bindings: DatalogBindings,
+}
+
+#[derive(Debug)]
+struct MaintainedRule {
+    rule: DatalogRule,
+    /// Head and body predicates
+    predicates: Vec<String>,
+    /// Native join for the rule; `None` evaluates it through Biscuit
+    plan: Option<JoinPlan>,
+    /// Rows of each predicate covered by `derived`
+    watermarks: HashMap<String, usize>,
+    /// Keys of the head facts derived so far
+    derived: HashSet<Vec<String>>,
+    evaluated: bool,
+}
+
+impl IncrementalProgram {
+    /// Prepare a program for incremental maintenance.
+    pub fn new(program: &DatalogProgram) -> Self {
+        let rules = program
+            .rules
+            .iter()
+            .map(|rule| MaintainedRule {
+                predicates: rule_predicates(rule),
+                plan: JoinPlan::compile(rule),
+                rule: rule.clone(),
+                watermarks: HashMap::new(),
+                derived: HashSet::new(),
+                evaluated: false,
+            })
+            .collect();
+
+        Self {
+            rules,
+            epoch: None,
+            bindings: DatalogBindings::new(),
+        }
+    }
+
+    /// Current program result.
+    pub fn bindings(&self) -> &DatalogBindings {
+        &self.bindings
+    }
+
+    /// Bring the result up to date with `facts`.
+    pub fn refresh(&mut self, facts: &QueryFacts) -> ProgramChange {
+        let reset = self.epoch != Some(facts.epoch());
+        if reset {
+            self.epoch = Some(facts.epoch());
+            self.bindings = DatalogBindings::new();
+            for rule in &mut self.rules {
+                rule.reset();
+            }
+        }
+
+        let mut added = Vec::new();
+        for rule in &mut self.rules {
+            added.extend(rule.refresh(facts));
+        }
+        self.bindings.rows.extend(added.iter().cloned());
+
+        ProgramChange { reset, added }
+    }
+}
+
+fn watermark(watermarks: &HashMap<String, usize>, predicate: &str) -> usize {
+    watermarks.get(predicate).copied().unwrap_or(0)
+}
+
+impl MaintainedRule {
+    fn reset(&mut self) {
+        self.watermarks.clear();
+        self.derived.clear();
+        self.evaluated = false;
+        if let Some(plan) = &mut self.plan {
+            plan.reset();
+        }
+    }
+
+    /// Evaluate what changed since the last refresh; returns new rows.
+    fn refresh(&mut self, facts: &QueryFacts) -> Vec<DatalogRow> {
+        let grown = self
+            .predicates
+            .iter()
+            .any(|predicate| facts.rows(predicate).len() > watermark(&self.watermarks, predicate));
+        if self.evaluated && !grown {
+            return Vec::new();
+        }
+
+        let evaluated = self.evaluated;
+        let from = |predicate: &str| {
+            if evaluated {
+                watermark(&self.watermarks, predicate)
+            } else {
+                0
+            }
+        };
+        let candidates: Vec<(Vec<String>, DatalogRow)> = match &mut self.plan {
+            Some(plan) => {
+                let atom_from: Vec<usize> = plan
+                    .atoms
+                    .iter()
+                    .map(|atom| from(&atom.predicate))
+                    .collect();
+                let head = &self.predicates[0];
+                let base = facts.rows(head).iter().skip(from(head)).map(|row| {
+                    row.iter()
+                        .cloned()
+                        .map(DatalogValue::String)
+                        .collect::<Vec<_>>()
+                });
+                base.chain(plan.evaluate(facts, &atom_from, !evaluated))
+                    .map(|values: Vec<DatalogValue>| {
+                        (
+                            values.iter().map(format_value).collect(),
+                            values_row(values),
+                        )
+                    })
+                    .collect()
+            }
+            None => evaluate_rule(facts, &self.rule)
+                .into_iter()
+                .map(|fact| {
+                    let row = parse_fact_to_row(&fact);
+                    (fact, row)
+                })
+                .collect(),
+        };
+
+        self.evaluated = true;
+        for predicate in &self.predicates {
+            self.watermarks
+                .insert(predicate.clone(), facts.rows(predicate).len());
+        }
+        candidates
+            .into_iter()
+            .filter(|(key, _)| self.derived.insert(key.clone()))
+            .map(|(_, row)| row)
+            .collect()
+    }
+}
+
+/// Row for head values, named like the rows parsed from Biscuit facts.
+fn values_row(values: Vec<DatalogValue>) -> DatalogRow {
+    values
+        .into_iter()
+        .enumerate()
+        .fold(DatalogRow::new(), |row, (index, value)| {
+            row.with_binding(format!("arg{index}"), value)
+        })
+}
+
+/// A non-recursive rule compiled for the semi-naive join.
+#[derive(Debug)]
+struct JoinPlan {
+    atoms: Vec<AtomPattern>,
+    head: Vec<HeadTerm>,
+    /// Number of distinct body variables
+    slot_count: usize,
+    /// Probe order per body atom, for the variant reading that atom's new rows
+    variants: Vec<Vec<Probe>>,
+    /// Indexes shared by the variants, one per atom and key column set
+    indexes: Vec<AtomIndex>,
+}
+
+#[derive(Debug)]
+struct AtomPattern {
+    predicate: String,
+    terms: Vec<Term>,
+}
+
+#[derive(Debug)]
+enum Term {
+    /// Body variable, by slot
+    Slot(usize),
+    /// String constant the column must equal
+    Constant(String),
+}
+
+#[derive(Debug)]
+enum HeadTerm {
+    Slot(usize),
+    Value(DatalogValue),
+}
+
+/// One join step: look up `atom` through an index keyed by bound slots.
+#[derive(Debug)]
+struct Probe {
+    atom: usize,
+    index: usize,
+    key_slots: Vec<usize>,
+}
+
+/// Row positions of one atom's predicate, grouped by their key columns.
+#[derive(Debug)]
+struct AtomIndex {
+    atom: usize,
+    key_columns: Vec<usize>,
+    /// Rows of the predicate indexed so far
+    covered: usize,
+    rows: HashMap<Vec<String>, Vec<usize>>,
+}
+
+impl JoinPlan {
+    /// Compile a rule, or `None` if it has to be evaluated through Biscuit.
+    ///
+    /// Fact rows are loaded into Biscuit as strings, so only string body
+    /// constants can ever match; other constants are left to Biscuit so the
+    /// two paths cannot disagree.
+    fn compile(rule: &DatalogRule) -> Option<Self> {
+        let head_predicate = rule.head().predicate();
+        let body = rule.body();
+        if body.is_empty() || body.iter().any(|atom| atom.predicate() == head_predicate) {
+            return None;
+        }
+
+        let mut slots: Vec<&str> = Vec::new();
+        let mut atoms = Vec::with_capacity(body.len());
+        for atom in body {
+            let mut terms = Vec::with_capacity(atom.args().len());
+            for arg in atom.args() {
+                terms.push(match arg {
+                    DatalogValue::Variable(name) => {
+                        let name = name.as_str();
+                        let slot = match slots.iter().position(|slot| *slot == name) {
+                            Some(slot) => slot,
+                            None => {
+                                slots.push(name);
+                                slots.len() - 1
+                            }
+                        };
+                        Term::Slot(slot)
+                    }
+                    DatalogValue::String(value) => Term::Constant(value.clone()),
+                    _ => return None,
+                });
+            }
+            atoms.push(AtomPattern {
+                predicate: atom.predicate().as_str().to_string(),
+                terms,
+            });
+        }
+
+        let mut head = Vec::with_capacity(rule.head().args().len());
+        for arg in rule.head().args() {
+            head.push(match arg {
+                DatalogValue::Variable(name) => {
+                    HeadTerm::Slot(slots.iter().position(|slot| *slot == name.as_str())?)
+                }
+                DatalogValue::String(_) | DatalogValue::Integer(_) | DatalogValue::Boolean(_) => {
+                    HeadTerm::Value(arg.clone())
+                }
+                _ => return None,
+            });
+        }
+
+        let mut indexes: Vec<AtomIndex> = Vec::new();
+        let mut variants = Vec::with_capacity(atoms.len());
+        for start in 0..atoms.len() {
+            let mut bound = vec![false; slots.len()];
+            atoms[start].bind(&mut bound);
+            let mut probes = Vec::with_capacity(atoms.len() - 1);
+            for (atom, pattern) in atoms.iter().enumerate() {
+                if atom == start {
+                    continue;
+                }
+                let (key_columns, key_slots): (Vec<usize>, Vec<usize>) = pattern
+                    .terms
+                    .iter()
+                    .enumerate()
+                    .filter_map(|(column, term)| match term {
+                        Term::Slot(slot) if bound[*slot] => Some((column, *slot)),
+                        _ => None,
+                    })
+                    .unzip();
+                pattern.bind(&mut bound);
+                let index = match indexes
+                    .iter()
+                    .position(|index| index.atom == atom && index.key_columns == key_columns)
+                {
+                    Some(index) => index,
+                    None => {
+                        indexes.push(AtomIndex {
+                            atom,
+                            key_columns,
+                            covered: 0,
+                            rows: HashMap::new(),
+                        });
+                        indexes.len() - 1
+                    }
+                };
+                probes.push(Probe {
+                    atom,
+                    index,
+                    key_slots,
+                });
+            }
+            variants.push(probes);
+        }
+
+        Some(Self {
+            atoms,
+            head,
+            slot_count: slots.len(),
+            variants,
+            indexes,
+        })
+    }
+
+    fn reset(&mut self) {
+        for index in &mut self.indexes {
+            index.covered = 0;
+            index.rows.clear();
+        }
+    }
+
+    /// Join the rows of each body atom from `from[atom]` on against the
+    /// current relations; returns head values, duplicates included.
+    ///
+    /// When every row is new, the variant of the first atom alone is the
+    /// full join.
+    fn evaluate(
+        &mut self,
+        facts: &QueryFacts,
+        from: &[usize],
+        all_new: bool,
+    ) -> Vec<Vec<DatalogValue>> {
+        for index in &mut self.indexes {
+            index.extend(facts.rows(&self.atoms[index.atom].predicate));
+        }
+
+        let variants = if all_new { 1 } else { self.atoms.len() };
+        let mut matches = Vec::new();
+        for start in 0..variants {
+            let atom = &self.atoms[start];
+            for row in facts.rows(&atom.predicate).iter().skip(from[start]) {
+                let mut binding = vec![None; self.slot_count];
+                if atom.unify(row, &mut binding) {
+                    self.probe(facts, &self.variants[start], binding, &mut matches);
+                }
+            }
+        }
+        matches
+    }
+
+    fn probe<'a>(
+        &self,
+        facts: &'a QueryFacts,
+        probes: &[Probe],
+        binding: Vec<Option<&'a str>>,
+        matches: &mut Vec<Vec<DatalogValue>>,
+    ) {
+        let Some((probe, rest)) = probes.split_first() else {
+            matches.push(self.project(&binding));
+            return;
+        };
+        let key: Vec<String> = probe
+            .key_slots
+            .iter()
+            .map(|slot| binding[*slot].unwrap_or_default().to_string())
+            .collect();
+        let Some(candidates) = self.indexes[probe.index].rows.get(&key) else {
+            return;
+        };
+
+        let atom = &self.atoms[probe.atom];
+        let rows = facts.rows(&atom.predicate);
+        for &row in candidates {
+            let mut extended = binding.clone();
+            if atom.unify(&rows[row], &mut extended) {
+                self.probe(facts, rest, extended, matches);
+            }
+        }
+    }
+
+    fn project(&self, binding: &[Option<&str>]) -> Vec<DatalogValue> {
+        self.head
+            .iter()
+            .map(|term| match term {
+                HeadTerm::Slot(slot) => {
+                    DatalogValue::String(binding[*slot].unwrap_or_default().to_string())
+                }
+                HeadTerm::Value(value) => value.clone(),
+            })
+            .collect()
+    }
+}
+
+impl AtomPattern {
+    /// Mark the slots this atom binds.
+    fn bind(&self, bound: &mut [bool]) {
+        for term in &self.terms {
+            if let Term::Slot(slot) = term {
+                bound[*slot] = true;
+            }
+        }
+    }
+
+    /// Match a row against the atom, binding its free slots.
+    fn unify<'a>(&self, row: &'a [String], binding: &mut [Option<&'a str>]) -> bool {
+        row.len() == self.terms.len()
+            && self.terms.iter().zip(row).all(|(term, value)| match term {
+                Term::Constant(constant) => constant == value,
+                Term::Slot(slot) => match binding[*slot] {
+                    Some(bound) => bound == value.as_str(),
+                    None => {
+                        binding[*slot] = Some(value.as_str());
+                        true
+                    }
+                },
+            })
+    }
+}
+
+impl AtomIndex {
+    /// Index the rows appended since the last call.
+    fn extend(&mut self, rows: &[Vec<String>]) {
+        for (position, row) in rows.iter().enumerate().skip(self.covered) {
+            let key: Option<Vec<String>> = self
+                .key_columns
+                .iter()
+                .map(|column| row.get(*column).cloned())
+                .collect();
+            if let Some(key) = key {
+                self.rows.entry(key).or_default().push(position);
+            }
+        }
+        self.covered = rows.len();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Tests
+// ─────────────────────────────────────────────────────────────────────────────
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use aura_core::query::{DatalogFact, DatalogValue};
+
+    fn member_names_program() -> DatalogProgram {
+        DatalogProgram::new(vec![DatalogRule::new(DatalogFact::new(
+            "result",
+            vec![DatalogValue::var("name"), DatalogValue::var("home")],
+        ))
+        .when(DatalogFact::new("user", vec![DatalogValue::var("name")]))
+        .when(DatalogFact::new(
+            "member",
+            vec![DatalogValue::var("name"), DatalogValue::var("home")],
+        ))])
+    }
+
+    fn full_result(facts: &QueryFacts, program: &DatalogProgram) -> HashSet<Vec<String>> {
+        program
+            .rules
+            .iter()
+            .flat_map(|rule| evaluate_rule(facts, rule))
+            .collect()
+    }
+
+    fn maintained_result(program: &IncrementalProgram) -> HashSet<String> {
+        program
+            .bindings()
+            .rows
+            .iter()
+            .map(|row| format!("{:?}", row.bindings))
+            .collect()
+    }
+
+    fn rows_of(facts: &QueryFacts, program: &DatalogProgram) -> HashSet<String> {
+        full_result(facts, program)
+            .iter()
+            .map(|fact| format!("{:?}", parse_fact_to_row(fact).bindings))
+            .collect()
+    }
+
+    #[test]
+    fn join_result_matches_full_evaluation_as_facts_arrive() {
+        let program = member_names_program();
+        let mut incremental = IncrementalProgram::new(&program);
+        let mut facts = QueryFacts::default();
+
+        facts.add("user", vec!["alice".to_string()]);
+        let change = incremental.refresh(&facts);
+        assert!(change.reset);
+        assert!(change.added.is_empty());
+
+        facts.add("member", vec!["alice".to_string(), "home-a".to_string()]);
+        facts.add("member", vec!["bob".to_string(), "home-a".to_string()]);
+        let change = incremental.refresh(&facts);
+        assert!(!change.reset);
+        assert_eq!(change.added.len(), 1);
+
+        // A new row on the other side of the join completes bob's match
+        facts.add("user", vec!["bob".to_string()]);
+        facts.add("unrelated", vec!["noise".to_string()]);
+        let change = incremental.refresh(&facts);
+        assert_eq!(change.added.len(), 1);
+        assert_eq!(maintained_result(&incremental), rows_of(&facts, &program));
+
+        assert!(incremental.refresh(&facts).is_empty());
+    }
+
+    #[test]
+    fn self_join_with_constants_matches_full_evaluation() {
+        // hop(a, c) <- edge(a, b), edge(b, c), kind(b, "hub")
+        let program = DatalogProgram::new(vec![DatalogRule::new(DatalogFact::new(
+            "hop",
+            vec![DatalogValue::var("a"), DatalogValue::var("c")],
+        ))
+        .when(DatalogFact::new(
+            "edge",
+            vec![DatalogValue::var("a"), DatalogValue::var("b")],
+        ))
+        .when(DatalogFact::new(
+            "edge",
+            vec![DatalogValue::var("b"), DatalogValue::var("c")],
+        ))
+        .when(DatalogFact::new(
+            "kind",
+            vec![
+                DatalogValue::var("b"),
+                DatalogValue::String("hub".to_string()),
+            ],
+        ))]);
+        let mut incremental = IncrementalProgram::new(&program);
+        let mut facts = QueryFacts::default();
+
+        let batches: [&[(&str, &[&str])]; 4] = [
+            &[("edge", &["a", "h"]), ("kind", &["h", "hub"])],
+            &[("edge", &["h", "b"]), ("edge", &["h", "c"])],
+            &[("edge", &["c", "h"]), ("kind", &["c", "leaf"])],
+            // Base facts of the head predicate are part of the result
+            &[("hop", &["x", "y"]), ("edge", &["h", "h"])],
+        ];
+        for batch in batches {
+            for (predicate, args) in batch {
+                facts.add(predicate, args.iter().map(|arg| arg.to_string()).collect());
+            }
+            incremental.refresh(&facts);
+            let result = maintained_result(&incremental);
+            assert_eq!(result.len(), incremental.bindings().rows.len());
+            assert_eq!(result, rows_of(&facts, &program));
+        }
+    }
+
+    #[test]
+    fn recursive_and_untyped_rules_use_full_evaluation() {
+        let edge = DatalogFact::new("edge", vec![DatalogValue::var("x"), DatalogValue::var("y")]);
+        let recursive = DatalogRule::new(DatalogFact::new(
+            "reach",
+            vec![DatalogValue::var("x"), DatalogValue::var("y")],
+        ))
+        .when(DatalogFact::new(
+            "reach",
+            vec![DatalogValue::var("x"), DatalogValue::var("z")],
+        ))
+        .when(edge.clone());
+        let symbol = DatalogRule::new(DatalogFact::new("admin", vec![DatalogValue::var("x")]))
+            .when(DatalogFact::new(
+                "role",
+                vec![DatalogValue::var("x"), DatalogValue::symbol("admin")],
+            ));
+        let unbound =
+            DatalogRule::new(DatalogFact::new("pair", vec![DatalogValue::var("z")])).when(edge);
+
+        assert!(JoinPlan::compile(&recursive).is_none());
+        assert!(JoinPlan::compile(&symbol).is_none());
+        assert!(JoinPlan::compile(&unbound).is_none());
+        assert!(JoinPlan::compile(&member_names_program().rules[0]).is_some());
+    }
+
+    #[test]
+    fn clearing_facts_rebuilds_the_result() {
+        let program = member_names_program();
+        let mut incremental = IncrementalProgram::new(&program);
+        let mut facts = QueryFacts::default();
+        facts.add("user", vec!["alice".to_string()]);
+        facts.add("member", vec!["alice".to_string(), "home-a".to_string()]);
+        assert_eq!(incremental.refresh(&facts).added.len(), 1);
+
+        facts.clear();
+        facts.add("user", vec!["carol".to_string()]);
+        facts.add("member", vec!["carol".to_string(), "home-b".to_string()]);
+        let change = incremental.refresh(&facts);
+        assert!(change.reset);
+        assert_eq!(incremental.bindings().rows.len(), 1);
+        assert_eq!(maintained_result(&incremental), rows_of(&facts, &program));
+    }
+}
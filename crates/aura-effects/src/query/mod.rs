@@ -16,18 +16,21 @@
 //! 2. Checks authorization via Biscuit capabilities
 //! 3. Executes against journal facts
 //! 4. Parses results back to typed values
-//! 5. Supports live subscriptions with automatic invalidation
+//! 5. Supports live subscriptions with automatic invalidation, maintaining
+//!    bound query results incrementally as facts arrive
 //!
 //! # Module Structure
 //!
 //! - `handler` - QueryHandler implementation and supporting types
 //! - `datalog` - Datalog formatting and parsing utilities
+//! - `incremental` - Semi-naive maintenance of bound query results
 
 mod datalog;
 mod handler;
+mod incremental;
 
 // Re-export the main handler
-pub use handler::{CapabilityPolicy, QueryHandler};
+pub use handler::{CapabilityPolicy, QueryHandler, QueryResultDelta};
 
 // Re-export datalog utilities for external use
 pub use datalog::{format_rule, format_value, parse_arg_to_value, parse_fact_to_row};
@@ -267,7 +267,7 @@ impl FilesystemStorageHandler {
         Ok(path)
     }
 
-    fn validate_key_segments(key: &str) -> Result<Vec<&str>, StorageError> {
+    pub(crate) fn validate_key_segments(key: &str) -> Result<Vec<&str>, StorageError> {
         if key.is_empty() {
             return Err(Self::invalid_key("key cannot be empty"));
         }
@@ -288,7 +288,7 @@ impl FilesystemStorageHandler {
         Ok(segments)
     }
 
-    fn validate_key_prefix(prefix: &str) -> Result<(), StorageError> {
+    pub(crate) fn validate_key_prefix(prefix: &str) -> Result<(), StorageError> {
         if prefix.is_empty() {
             return Ok(());
         }
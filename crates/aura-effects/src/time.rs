@@ -42,6 +42,35 @@ pub fn monotonic_now() -> MonotonicInstant {
     MonotonicInstant::now()
 }
 
+/// Monotonic clock for [`aura_core::latency::LatencyRecorder`].
+///
+/// Readings are nanoseconds since the clock was created.
+#[derive(Debug, Clone)]
+pub struct MonotonicLatencyClock {
+    origin: MonotonicInstant,
+}
+
+impl MonotonicLatencyClock {
+    /// Create a clock anchored at the current instant.
+    pub fn new() -> Self {
+        Self {
+            origin: monotonic_now(),
+        }
+    }
+}
+
+impl Default for MonotonicLatencyClock {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl aura_core::latency::LatencyClock for MonotonicLatencyClock {
+    fn now_nanos(&self) -> u64 {
+        u64::try_from(self.origin.elapsed().as_nanos()).unwrap_or(u64::MAX)
+    }
+}
+
 /// Production physical clock handler backed by the system clock.
 #[derive(Debug, Clone, Default)]
 pub struct PhysicalTimeHandler;
@@ -1,11 +1,36 @@
 //! Message Framing Handler
 //!
 //! Stateless message framing and serialization utilities.
+//!
+//! Frames carry a fixed 14-byte binary header (type, payload length, flags,
+//! sequence) followed by the payload. Payloads are refcounted [`Bytes`], so
+//! frames can be cloned and queued without copying:
+//! - [`FramingHandler::send_frame`] writes header and payload with one
+//!   vectored write.
+//! - [`FramingHandler::send_frames`] corks a batch: small frames are coalesced
+//!   into one buffer, large payloads are written from their own allocation,
+//!   and the writer is flushed once.
+//! - [`FramingHandler::receive_frame_shared`] decodes in place from a
+//!   [`FrameReceiveBuffer`] and returns payload slices that share its
+//!   allocation.
 
 use super::{TransportError, TransportResult};
+use aura_core::latency::{self, LatencyStage};
+use bytes::{Buf, BufMut, Bytes, BytesMut};
 use serde::{Deserialize, Serialize};
+use std::io::{self, IoSlice};
 use tokio::io::{AsyncRead, AsyncReadExt, AsyncWrite, AsyncWriteExt};
 
+/// Payloads up to this size are copied into the batch buffer by
+/// [`FramingHandler::send_frames`] instead of being written as their own slice.
+pub const COALESCE_PAYLOAD_BYTES: usize = 512;
+
+/// Maximum number of slices handed to a single vectored write.
+const MAX_WRITE_SLICES: usize = 64;
+
+/// Read-ahead granularity for [`FrameReceiveBuffer::with_read_ahead`].
+const READ_AHEAD_CHUNK: usize = 16 * 1024;
+
 /// Message framing handler
 #[derive(Debug, Clone)]
 pub struct FramingHandler {
@@ -30,6 +55,16 @@ impl FrameHeader {
     pub fn payload_length(&self) -> u32 {
         self.payload_length
     }
+
+    /// Fixed binary wire encoding: type, length, flags, sequence (big-endian).
+    pub fn encode(&self) -> [u8; FRAME_HEADER_SIZE] {
+        let mut header = [0u8; FRAME_HEADER_SIZE];
+        header[0] = self.frame_type as u8;
+        header[1..5].copy_from_slice(&self.payload_length.to_be_bytes());
+        header[5] = self.flags;
+        header[6..].copy_from_slice(&self.sequence.to_be_bytes());
+        header
+    }
 }
 
 /// Frame type enumeration
@@ -50,8 +85,8 @@ pub enum FrameType {
 pub struct Frame {
     /// Frame header containing type, length, and metadata
     pub header: FrameHeader,
-    /// Message payload
-    pub payload: Vec<u8>,
+    /// Message payload (refcounted; clones share the allocation)
+    pub payload: Bytes,
 }
 
 /// Borrowed frame view backed by a reusable receive buffer.
@@ -68,7 +103,7 @@ impl BufferedFrame<'_> {
     pub fn into_owned(self) -> Frame {
         Frame {
             header: self.header,
-            payload: self.payload.to_vec(),
+            payload: Bytes::copy_from_slice(self.payload),
         }
     }
 }
@@ -77,19 +112,45 @@ impl BufferedFrame<'_> {
 #[derive(Debug, Clone)]
 pub struct FrameReceiveBuffer {
     max_buffered_bytes: usize,
-    payload: Vec<u8>,
+    /// Read past the current frame so later frames need no extra reads
+    read_ahead: bool,
+    /// Bytes read from the stream but not yet consumed
+    pending: BytesMut,
+    /// Payload length of the last borrowed frame, consumed by the next receive
+    borrowed: usize,
 }
 
 impl FrameReceiveBuffer {
     /// Create a buffer with a fixed maximum inbound byte budget.
+    ///
+    /// Reads stop exactly at frame boundaries, so the buffer can be dropped
+    /// between frames without losing stream data.
     pub fn new(max_buffered_bytes: usize) -> Self {
         Self {
             max_buffered_bytes,
-            payload: Vec::new(),
+            read_ahead: false,
+            pending: BytesMut::new(),
+            borrowed: 0,
         }
     }
 
-    fn prepare(&mut self, payload_length: usize) -> TransportResult<&mut [u8]> {
+    /// Create a buffer that reads ahead up to its byte budget.
+    ///
+    /// A single read can then yield several frames. Bytes past the current
+    /// frame stay in the buffer, so it must live as long as the connection.
+    pub fn with_read_ahead(max_buffered_bytes: usize) -> Self {
+        Self {
+            read_ahead: true,
+            ..Self::new(max_buffered_bytes)
+        }
+    }
+
+    /// Bytes already read from the stream that no frame has consumed yet.
+    pub fn buffered_len(&self) -> usize {
+        self.pending.len() - self.borrowed
+    }
+
+    fn check_budget(&self, payload_length: usize) -> TransportResult<()> {
         let required = FRAME_HEADER_SIZE
             .checked_add(payload_length)
             .ok_or_else(|| TransportError::Protocol("Frame size overflow".to_string()))?;
@@ -99,17 +160,47 @@ impl FrameReceiveBuffer {
                 required, self.max_buffered_bytes
             )));
         }
+        Ok(())
+    }
 
-        self.payload.resize(payload_length, 0);
-        Ok(self.payload.as_mut_slice())
+    /// Drop the payload handed out by the previous borrowed receive.
+    fn release_borrowed(&mut self) {
+        self.pending.advance(self.borrowed);
+        self.borrowed = 0;
     }
 
-    fn payload(&self, payload_length: usize) -> &[u8] {
-        &self.payload[..payload_length]
+    /// Read until at least `target` bytes are pending.
+    async fn fill<R>(&mut self, reader: &mut R, target: usize) -> TransportResult<()>
+    where
+        R: AsyncRead + Unpin,
+    {
+        while self.pending.len() < target {
+            let needed = target - self.pending.len();
+            let limit = if self.read_ahead {
+                self.max_buffered_bytes.saturating_sub(self.pending.len())
+            } else {
+                needed
+            }
+            .max(needed);
+            self.pending
+                .reserve(needed.max(READ_AHEAD_CHUNK.min(limit)));
+            let read = (&mut *reader)
+                .take(limit as u64)
+                .read_buf(&mut self.pending)
+                .await
+                .map_err(TransportError::Io)?;
+            if read == 0 {
+                return Err(TransportError::Io(io::Error::new(
+                    io::ErrorKind::UnexpectedEof,
+                    "stream closed mid-frame",
+                )));
+            }
+        }
+        Ok(())
     }
 }
 
-const FRAME_HEADER_SIZE: usize = 14; // 1 + 4 + 1 + 8 bytes on the wire
+pub(crate) const FRAME_HEADER_SIZE: usize = 14; // 1 + 4 + 1 + 8 bytes on the wire
 
 impl FramingHandler {
     /// Create new framing handler
@@ -123,6 +214,11 @@ impl FramingHandler {
         Self::new(1_048_576)
     }
 
+    /// Largest payload this handler sends or accepts.
+    pub fn max_frame_size(&self) -> u32 {
+        self.max_frame_size
+    }
+
     fn default_receive_buffer(&self) -> FrameReceiveBuffer {
         FrameReceiveBuffer::new(FRAME_HEADER_SIZE + self.max_frame_size as usize)
     }
@@ -173,9 +269,9 @@ impl FramingHandler {
         })
     }
 
-    /// Serialize frame to bytes
-    pub fn serialize_frame(&self, frame: &Frame) -> TransportResult<Vec<u8>> {
-        let payload_length = u32::try_from(frame.payload.len()).map_err(|_| {
+    /// Validate a frame for sending and encode its header.
+    fn encode_header(&self, frame: &Frame) -> TransportResult<[u8; FRAME_HEADER_SIZE]> {
+        u32::try_from(frame.payload.len()).map_err(|_| {
             TransportError::Protocol(format!(
                 "Frame too large: {} > {}",
                 frame.payload.len(),
@@ -194,23 +290,35 @@ impl FramingHandler {
                 "Frame header payload length does not match payload".to_string(),
             ));
         }
+        Ok(frame.header.encode())
+    }
 
+    /// Serialize frame to bytes
+    pub fn serialize_frame(&self, frame: &Frame) -> TransportResult<Vec<u8>> {
+        let _latency = latency::span(LatencyStage::FrameSerialize);
+        let header = self.encode_header(frame)?;
         let mut buffer = Vec::with_capacity(FRAME_HEADER_SIZE + frame.payload.len());
-
-        // Serialize header
-        buffer.push(frame.header.frame_type as u8);
-        buffer.extend_from_slice(&payload_length.to_be_bytes());
-        buffer.push(frame.header.flags);
-        buffer.extend_from_slice(&frame.header.sequence.to_be_bytes());
-
-        // Add payload
+        buffer.extend_from_slice(&header);
         buffer.extend_from_slice(&frame.payload);
-
         Ok(buffer)
     }
 
-    /// Deserialize frame from bytes
-    pub fn deserialize_frame(&self, data: &[u8]) -> TransportResult<Frame> {
+    /// Append the serialized frame to `buffer`, reusing its capacity.
+    pub fn serialize_frame_into(
+        &self,
+        frame: &Frame,
+        buffer: &mut BytesMut,
+    ) -> TransportResult<()> {
+        let _latency = latency::span(LatencyStage::FrameSerialize);
+        let header = self.encode_header(frame)?;
+        buffer.reserve(FRAME_HEADER_SIZE + frame.payload.len());
+        buffer.put_slice(&header);
+        buffer.put_slice(&frame.payload);
+        Ok(())
+    }
+
+    /// Validate a single canonical frame encoding and parse its header.
+    fn parse_canonical(&self, data: &[u8]) -> TransportResult<FrameHeader> {
         if data.len() < FRAME_HEADER_SIZE {
             return Err(TransportError::Protocol(
                 "Insufficient data for frame header".to_string(),
@@ -220,19 +328,28 @@ impl FramingHandler {
             .try_into()
             .map_err(|_| TransportError::Protocol("Invalid frame header".to_string()))?;
         let header = self.parse_header(&header_bytes)?;
-        let payload_length = header.payload_length;
 
         // Validate payload length
-        let expected_total_size = FRAME_HEADER_SIZE + payload_length as usize;
+        let expected_total_size = FRAME_HEADER_SIZE + header.payload_length as usize;
         if data.len() != expected_total_size {
             return Err(TransportError::Protocol(
                 "Frame payload length is not canonical".to_string(),
             ));
         }
+        Ok(header)
+    }
 
-        // Extract payload
-        let payload = data[FRAME_HEADER_SIZE..expected_total_size].to_vec();
+    /// Deserialize frame from bytes
+    pub fn deserialize_frame(&self, data: &[u8]) -> TransportResult<Frame> {
+        let header = self.parse_canonical(data)?;
+        let payload = Bytes::copy_from_slice(&data[FRAME_HEADER_SIZE..]);
+        Ok(Frame { header, payload })
+    }
 
+    /// Deserialize frame from shared bytes; the payload aliases `data`.
+    pub fn deserialize_frame_shared(&self, data: Bytes) -> TransportResult<Frame> {
+        let header = self.parse_canonical(&data)?;
+        let payload = data.slice(FRAME_HEADER_SIZE..);
         Ok(Frame { header, payload })
     }
 
@@ -241,8 +358,47 @@ impl FramingHandler {
     where
         W: AsyncWrite + Unpin,
     {
-        let data = self.serialize_frame(frame)?;
-        writer.write_all(&data).await.map_err(TransportError::Io)?;
+        let _latency = latency::span(LatencyStage::FrameSend);
+        let header = self.encode_header(frame)?;
+        write_all_vectored(writer, &[&header, &frame.payload])
+            .await
+            .map_err(TransportError::Io)?;
+        writer.flush().await.map_err(TransportError::Io)?;
+        Ok(())
+    }
+
+    /// Send a batch of frames with a single flush.
+    ///
+    /// Headers and payloads of at most [`COALESCE_PAYLOAD_BYTES`] (control
+    /// and heartbeat frames, typically) are coalesced into one buffer;
+    /// larger payloads are written in place. Every frame is validated before
+    /// anything is written.
+    pub async fn send_frames<W>(&self, writer: &mut W, frames: &[Frame]) -> TransportResult<()>
+    where
+        W: AsyncWrite + Unpin,
+    {
+        let serialize_latency = latency::span(LatencyStage::FrameSerialize);
+        let mut chunks = Vec::new();
+        let mut cork = BytesMut::new();
+        for frame in frames {
+            cork.put_slice(&self.encode_header(frame)?);
+            if frame.payload.len() <= COALESCE_PAYLOAD_BYTES {
+                cork.put_slice(&frame.payload);
+            } else {
+                chunks.push(cork.split().freeze());
+                chunks.push(frame.payload.clone());
+            }
+        }
+        if !cork.is_empty() {
+            chunks.push(cork.freeze());
+        }
+        drop(serialize_latency);
+
+        let _latency = latency::span(LatencyStage::FrameSend);
+        let slices: Vec<&[u8]> = chunks.iter().map(|chunk| chunk.as_ref()).collect();
+        write_all_vectored(writer, &slices)
+            .await
+            .map_err(TransportError::Io)?;
         writer.flush().await.map_err(TransportError::Io)?;
         Ok(())
     }
@@ -253,9 +409,32 @@ impl FramingHandler {
         R: AsyncRead + Unpin,
     {
         let mut receive_buffer = self.default_receive_buffer();
-        self.receive_frame_buffered(reader, &mut receive_buffer)
-            .await
-            .map(BufferedFrame::into_owned)
+        self.receive_frame_shared(reader, &mut receive_buffer).await
+    }
+
+    /// Read the next header and make sure its whole payload is pending.
+    async fn receive_header<R>(
+        &self,
+        reader: &mut R,
+        receive_buffer: &mut FrameReceiveBuffer,
+    ) -> TransportResult<FrameHeader>
+    where
+        R: AsyncRead + Unpin,
+    {
+        receive_buffer.release_borrowed();
+        receive_buffer.fill(reader, FRAME_HEADER_SIZE).await?;
+        let header_bytes: [u8; FRAME_HEADER_SIZE] = receive_buffer.pending[..FRAME_HEADER_SIZE]
+            .try_into()
+            .map_err(|_| TransportError::Protocol("Invalid frame header".to_string()))?;
+        let header = self.parse_header(&header_bytes)?;
+
+        let payload_length = header.payload_length as usize;
+        receive_buffer.check_budget(payload_length)?;
+        receive_buffer
+            .fill(reader, FRAME_HEADER_SIZE + payload_length)
+            .await?;
+        receive_buffer.pending.advance(FRAME_HEADER_SIZE);
+        Ok(header)
     }
 
     /// Receive a framed message into a reusable bounded inbound buffer.
@@ -267,30 +446,38 @@ impl FramingHandler {
     where
         R: AsyncRead + Unpin,
     {
-        // Read header first
-        let mut header_bytes = [0u8; FRAME_HEADER_SIZE];
-        reader
-            .read_exact(&mut header_bytes)
-            .await
-            .map_err(TransportError::Io)?;
-
-        let header = self.parse_header(&header_bytes)?;
-        let payload_length_usize = header.payload_length as usize;
-        // Read payload
-        let payload_bytes = receive_buffer.prepare(payload_length_usize)?;
-        reader
-            .read_exact(payload_bytes)
-            .await
-            .map_err(TransportError::Io)?;
-
+        let header = self.receive_header(reader, receive_buffer).await?;
+        let payload_length = header.payload_length as usize;
+        receive_buffer.borrowed = payload_length;
         Ok(BufferedFrame {
             header,
-            payload: receive_buffer.payload(payload_length_usize),
+            payload: &receive_buffer.pending[..payload_length],
         })
     }
 
+    /// Receive a framed message whose payload shares the buffer's allocation.
+    ///
+    /// The buffer reclaims the space once every payload handed out from it
+    /// has been dropped.
+    pub async fn receive_frame_shared<R>(
+        &self,
+        reader: &mut R,
+        receive_buffer: &mut FrameReceiveBuffer,
+    ) -> TransportResult<Frame>
+    where
+        R: AsyncRead + Unpin,
+    {
+        let header = self.receive_header(reader, receive_buffer).await?;
+        let payload = receive_buffer
+            .pending
+            .split_to(header.payload_length as usize)
+            .freeze();
+        Ok(Frame { header, payload })
+    }
+
     /// Create data frame
-    pub fn create_data_frame(&self, payload: Vec<u8>, sequence: u64) -> Frame {
+    pub fn create_data_frame(&self, payload: impl Into<Bytes>, sequence: u64) -> Frame {
+        let payload = payload.into();
         Frame {
             header: FrameHeader {
                 frame_type: FrameType::Data,
@@ -303,7 +490,8 @@ impl FramingHandler {
     }
 
     /// Create control frame
-    pub fn create_control_frame(&self, payload: Vec<u8>, sequence: u64) -> Frame {
+    pub fn create_control_frame(&self, payload: impl Into<Bytes>, sequence: u64) -> Frame {
+        let payload = payload.into();
         Frame {
             header: FrameHeader {
                 frame_type: FrameType::Control,
@@ -324,7 +512,7 @@ impl FramingHandler {
                 flags: 0,
                 sequence,
             },
-            payload: Vec::new(),
+            payload: Bytes::new(),
         }
     }
 }
@@ -341,6 +529,18 @@ impl FramingHandler {
         Ok(self.create_data_frame(payload, sequence))
     }
 
+    /// Serialize message as JSON frame, encoding into `buffer`'s spare capacity.
+    pub fn serialize_json_into<T: Serialize>(
+        &self,
+        message: &T,
+        sequence: u64,
+        buffer: &mut BytesMut,
+    ) -> TransportResult<Frame> {
+        buffer.clear();
+        serde_json::to_writer((&mut *buffer).writer(), message)?;
+        Ok(self.create_data_frame(buffer.split().freeze(), sequence))
+    }
+
     /// Deserialize JSON frame to message
     pub fn deserialize_json<T: for<'de> Deserialize<'de>>(
         &self,
@@ -357,6 +557,47 @@ impl FramingHandler {
     }
 }
 
+/// Write every slice in order, using vectored writes where the writer
+/// supports them.
+pub(crate) async fn write_all_vectored<W>(writer: &mut W, slices: &[&[u8]]) -> io::Result<()>
+where
+    W: AsyncWrite + Unpin + ?Sized,
+{
+    let mut index = 0;
+    let mut offset = 0;
+    while index < slices.len() {
+        if offset == slices[index].len() {
+            index += 1;
+            offset = 0;
+            continue;
+        }
+
+        let batch: Vec<IoSlice<'_>> = std::iter::once(&slices[index][offset..])
+            .chain(slices[index + 1..].iter().copied())
+            .filter(|slice| !slice.is_empty())
+            .take(MAX_WRITE_SLICES)
+            .map(IoSlice::new)
+            .collect();
+        let mut written = writer.write_vectored(&batch).await?;
+        if written == 0 {
+            return Err(io::ErrorKind::WriteZero.into());
+        }
+
+        while written > 0 && index < slices.len() {
+            let remaining = slices[index].len() - offset;
+            if written < remaining {
+                offset += written;
+                written = 0;
+            } else {
+                written -= remaining;
+                index += 1;
+                offset = 0;
+            }
+        }
+    }
+    Ok(())
+}
+
 #[cfg(test)]
 #[allow(clippy::expect_used)]
 mod tests {
@@ -432,7 +673,7 @@ mod tests {
                 flags: 0,
                 sequence: 9,
             },
-            payload: vec![1, 2, 3],
+            payload: vec![1, 2, 3].into(),
         };
 
         let error = handler
@@ -451,7 +692,7 @@ mod tests {
                 flags: 0,
                 sequence: 10,
             },
-            payload: vec![1, 2, 3],
+            payload: vec![1, 2, 3].into(),
         };
 
         let error = handler
@@ -490,4 +731,100 @@ mod tests {
             .expect_err("concatenated frames must fail single-buffer decode");
         assert!(matches!(error, TransportError::Protocol(_)));
     }
+
+    #[tokio::test]
+    async fn send_frames_round_trips_coalesced_and_large_payloads() {
+        let handler = FramingHandler::new(4096);
+        let frames = vec![
+            handler.create_heartbeat_frame(1),
+            handler.create_control_frame(vec![7; 16], 2),
+            handler.create_data_frame(vec![8; COALESCE_PAYLOAD_BYTES + 100], 3),
+            handler.create_data_frame(vec![9; 4], 4),
+        ];
+        let mut wire = Vec::new();
+        handler
+            .send_frames(&mut wire, &frames)
+            .await
+            .expect("batch send to in-memory writer");
+
+        let expected: Vec<u8> = frames
+            .iter()
+            .flat_map(|frame| handler.serialize_frame(frame).unwrap())
+            .collect();
+        assert_eq!(wire, expected);
+
+        let mut single = Vec::new();
+        handler
+            .send_frame(&mut single, &frames[2])
+            .await
+            .expect("single send to in-memory writer");
+        assert_eq!(single, handler.serialize_frame(&frames[2]).unwrap());
+    }
+
+    #[tokio::test]
+    async fn send_frames_writes_nothing_when_any_frame_is_invalid() {
+        let handler = FramingHandler::new(64);
+        let frames = vec![
+            handler.create_data_frame(vec![1; 8], 1),
+            handler.create_data_frame(vec![2; 65], 2),
+        ];
+        let mut wire = Vec::new();
+
+        let error = handler
+            .send_frames(&mut wire, &frames)
+            .await
+            .expect_err("oversized frame must fail the batch");
+        assert!(matches!(error, TransportError::Protocol(_)));
+        assert!(wire.is_empty());
+    }
+
+    #[tokio::test]
+    async fn receive_frame_shared_reads_ahead_and_slices_payloads() {
+        let handler = FramingHandler::new(128);
+        let data: Vec<u8> = (0..3u8)
+            .flat_map(|n| {
+                handler
+                    .serialize_frame(&handler.create_data_frame(vec![n; 40], u64::from(n)))
+                    .unwrap()
+            })
+            .collect();
+        let mut stream = data.as_slice();
+        let mut buffer = FrameReceiveBuffer::with_read_ahead(data.len());
+
+        let first = handler
+            .receive_frame_shared(&mut stream, &mut buffer)
+            .await
+            .expect("first frame");
+        assert_eq!(first.payload.as_ref(), &[0; 40]);
+        assert!(stream.is_empty(), "read-ahead should drain the stream");
+        assert_eq!(buffer.buffered_len(), 2 * (FRAME_HEADER_SIZE + 40));
+
+        for n in 1..3u8 {
+            let frame = handler
+                .receive_frame_shared(&mut stream, &mut buffer)
+                .await
+                .expect("buffered frame");
+            assert_eq!(frame.header.sequence, u64::from(n));
+            assert_eq!(frame.payload.as_ref(), &[n; 40]);
+        }
+        assert_eq!(first.payload.len(), 40);
+        assert_eq!(buffer.buffered_len(), 0);
+    }
+
+    #[test]
+    fn serialize_json_into_reuses_buffer_and_round_trips() {
+        let handler = FramingHandler::new(128);
+        let mut buffer = BytesMut::with_capacity(64);
+
+        let frame = handler
+            .serialize_json_into(&vec!["a", "b"], 5, &mut buffer)
+            .expect("json encode");
+        let decoded: Vec<String> = handler.deserialize_json(&frame).expect("json decode");
+        assert_eq!(decoded, vec!["a".to_string(), "b".to_string()]);
+
+        let shared = handler
+            .deserialize_frame_shared(Bytes::from(handler.serialize_frame(&frame).unwrap()))
+            .expect("shared decode");
+        assert_eq!(shared.payload, frame.payload);
+    }
 }
@@ -8,6 +8,7 @@
 //! - **WebSocketTransportHandler**: Browser-compatible WebSocket protocol
 //! - **RealTransportHandler**: Production transport with TransportEffects implementation
 //! - **FramingHandler**: Message delimiting (length-prefix framing for streams)
+//! - **MultiplexedConnection**: Many logical streams over one TCP socket
 //! - **Utils**: Address validation, connection metrics, timeout management
 //!
 //! **Layer Constraint** (per docs/103_effect_system.md):
@@ -29,12 +30,14 @@ cfg_if! {
     } else {
         mod env;
         pub mod framing;
+        pub mod mux;
         pub mod real;
         pub mod tcp;
         pub mod utils;
         pub mod websocket;
 
         pub use framing::FramingHandler;
+        pub use mux::{MultiplexedConnection, MuxConfig, MuxDriver, MuxRole, MuxStream};
         pub use real::RealTransportHandler;
         pub use tcp::TcpTransportHandler;
         pub use utils::{AddressResolver, BufferUtils, ConnectionMetrics, TimeoutHelper, UrlValidator};
@@ -0,0 +1,855 @@
+//! Multiplexed Streams over One TCP Connection
+//!
+//! Lets concurrent protocol sessions to the same peer share one socket
+//! instead of each paying a TCP handshake. Logical streams are told apart by
+//! the sequence field of [`FramingHandler`] frames:
+//! - **Stream ids**: the dialing side allocates odd ids and the accepting
+//!   side even ids, so either end can open streams without coordination.
+//! - **Frames**: `Data` frames carry stream payloads, an empty `Control`
+//!   frame closes a stream, and `Heartbeat` frames answer health checks.
+//! - **Back-pressure**: a connection admits at most
+//!   `max_streams_per_connection` open streams, outbound frames go through a
+//!   bounded queue, and each stream buffers at most `stream_queue_depth`
+//!   inbound payloads; a slow consumer stalls its connection's reader rather
+//!   than growing memory.
+//! - **Closing**: every open stream holds a reserved write-queue slot for its
+//!   close frame, so dropping a stream never waits or spawns. Frames for a
+//!   remote stream id that was already closed are dropped, not admitted as a
+//!   new stream.
+//!
+//! Queued frames are written in corked batches by the connection's
+//! [`MuxDriver`], which the caller runs on a task it owns. Pooling
+//! connections per peer is runtime policy and belongs to the agent; this
+//! module manages a single connection.
+
+// Stream tables are plain maps touched synchronously (including from `Drop`);
+// no lock is held across `.await`.
+#![allow(clippy::disallowed_types)]
+
+use super::framing::{Frame, FrameReceiveBuffer, FrameType, FramingHandler, FRAME_HEADER_SIZE};
+use super::{TransportError, TransportResult};
+use bytes::Bytes;
+use std::collections::{BTreeSet, HashMap};
+use std::net::SocketAddr;
+use std::num::NonZeroUsize;
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+use std::sync::{Arc, Mutex, MutexGuard, PoisonError};
+use std::time::Duration;
+use tokio::net::tcp::{OwnedReadHalf, OwnedWriteHalf};
+use tokio::net::TcpStream;
+use tokio::sync::mpsc::error::TrySendError;
+use tokio::sync::{mpsc, oneshot, OwnedSemaphorePermit, Semaphore};
+use tokio::time::{timeout, Instant};
+
+/// Preface a dialer writes before its first frame, so listeners can tell
+/// multiplexed connections from single-message ones.
+pub const MUX_PREFACE: [u8; 8] = *b"AURAMUX1";
+
+/// Heartbeat flag marking the reply to a health-check probe.
+const HEARTBEAT_ACK: u8 = 0x01;
+
+/// Maximum number of queued frames written with one flush.
+const MAX_WRITE_BATCH: usize = 64;
+
+/// Limits for one multiplexed connection.
+#[derive(Debug, Clone)]
+pub struct MuxConfig {
+    /// Open streams admitted per connection before `open_stream` waits
+    pub max_streams_per_connection: NonZeroUsize,
+    /// Inbound payloads buffered per stream before the reader stalls
+    pub stream_queue_depth: NonZeroUsize,
+    /// Outbound frames queued per connection before senders wait
+    pub write_queue_depth: NonZeroUsize,
+    /// Largest payload carried by a single stream frame
+    pub max_frame_size: u32,
+}
+
+impl Default for MuxConfig {
+    #[allow(clippy::expect_used)] // Default mux limits are compile-time non-zero values.
+    fn default() -> Self {
+        Self {
+            max_streams_per_connection: NonZeroUsize::new(64)
+                .expect("stream limit should be non-zero"),
+            stream_queue_depth: NonZeroUsize::new(32).expect("stream queue should be non-zero"),
+            write_queue_depth: NonZeroUsize::new(256).expect("write queue should be non-zero"),
+            max_frame_size: 1_048_576,
+        }
+    }
+}
+
+/// Which end of the connection this side is; decides stream id parity.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum MuxRole {
+    /// Side that dialed the connection (odd stream ids)
+    Dialer,
+    /// Side that accepted the connection (even stream ids)
+    Acceptor,
+}
+
+impl MuxRole {
+    fn first_stream_id(self) -> u64 {
+        match self {
+            Self::Dialer => 1,
+            Self::Acceptor => 2,
+        }
+    }
+
+    fn peer(self) -> Self {
+        match self {
+            Self::Dialer => Self::Acceptor,
+            Self::Acceptor => Self::Dialer,
+        }
+    }
+}
+
+/// One TCP connection carrying many logical streams.
+///
+/// Clones share the connection; the socket is closed once every clone and
+/// every stream opened on it have been dropped.
+#[derive(Debug, Clone)]
+pub struct MultiplexedConnection {
+    shared: Arc<ConnectionShared>,
+}
+
+/// Socket I/O for one [`MultiplexedConnection`].
+///
+/// The connection does no I/O until its driver runs, so the caller decides
+/// which task owns the reader and writer. [`run`](Self::run) returns once the
+/// socket fails or every handle to the connection has been dropped.
+#[derive(Debug)]
+#[must_use = "a multiplexed connection does no I/O until its driver runs"]
+pub struct MuxDriver {
+    reader: OwnedReadHalf,
+    writer: OwnedWriteHalf,
+    framing: FramingHandler,
+    state: Arc<ConnectionState>,
+    outbound: mpsc::Sender<Outbound>,
+    outbound_queue: mpsc::Receiver<Outbound>,
+    accept_queue: mpsc::Sender<InboundStream>,
+    stream_queue_depth: usize,
+    remote_ids: RemoteStreamIds,
+    shutdown: oneshot::Receiver<()>,
+}
+
+/// Logical stream on a [`MultiplexedConnection`].
+///
+/// Dropping the stream closes it on both ends and releases its slot.
+#[derive(Debug)]
+pub struct MuxStream {
+    id: u64,
+    connection: Arc<ConnectionShared>,
+    inbound: mpsc::Receiver<Bytes>,
+    /// Write-queue slot reserved for the close frame
+    close: Option<mpsc::OwnedPermit<Outbound>>,
+    _permit: OwnedSemaphorePermit,
+}
+
+/// Stream opened by the remote side, waiting for `accept_stream`.
+#[derive(Debug)]
+struct InboundStream {
+    id: u64,
+    inbound: mpsc::Receiver<Bytes>,
+    close: mpsc::OwnedPermit<Outbound>,
+    permit: OwnedSemaphorePermit,
+}
+
+/// Frame queued for the writer.
+#[derive(Debug)]
+struct Outbound {
+    frame: Frame,
+    /// Completed once the batch carrying `frame` has been flushed
+    flushed: Option<oneshot::Sender<Result<(), String>>>,
+}
+
+impl From<Frame> for Outbound {
+    fn from(frame: Frame) -> Self {
+        Self {
+            frame,
+            flushed: None,
+        }
+    }
+}
+
+/// Remote stream ids the reader has already seen.
+///
+/// The peer allocates ids in increasing order but may first send on them out
+/// of order, so ids skipped below the highest one seen stay admissible. At
+/// most `max_skipped` of those are remembered; any other id at or below the
+/// highest one seen belongs to a closed stream.
+#[derive(Debug)]
+struct RemoteStreamIds {
+    /// Lowest remote id above every id seen so far
+    next: u64,
+    skipped: BTreeSet<u64>,
+    max_skipped: usize,
+}
+
+/// State shared between the connection handle and its reader task.
+#[derive(Debug)]
+struct ConnectionState {
+    /// Inbound payload queues by stream id
+    streams: Mutex<HashMap<u64, mpsc::Sender<Bytes>>>,
+    /// Outstanding health-check probes by probe id
+    probes: Mutex<HashMap<u64, oneshot::Sender<()>>>,
+    /// Open-stream slots; closed together with the connection
+    permits: Arc<Semaphore>,
+    closed: AtomicBool,
+    /// Stream id parity used by this side (1 for odd, 0 for even)
+    local_parity: u64,
+    epoch: Instant,
+    last_activity_ms: AtomicU64,
+}
+
+#[derive(Debug)]
+struct ConnectionShared {
+    remote_addr: SocketAddr,
+    framing: FramingHandler,
+    max_frame_size: u32,
+    max_streams: usize,
+    stream_queue_depth: usize,
+    state: Arc<ConnectionState>,
+    outbound: mpsc::Sender<Outbound>,
+    accepted: tokio::sync::Mutex<mpsc::Receiver<InboundStream>>,
+    next_stream_id: AtomicU64,
+    next_probe_id: AtomicU64,
+    /// Dropped with the last handle, which stops the driver's reader
+    _shutdown: oneshot::Sender<()>,
+}
+
+impl MultiplexedConnection {
+    /// Multiplex an established TCP stream.
+    ///
+    /// Any preface exchange must already have happened. The returned
+    /// [`MuxDriver`] performs the connection's socket I/O and must be run by
+    /// the caller.
+    pub fn new(
+        stream: TcpStream,
+        role: MuxRole,
+        config: &MuxConfig,
+    ) -> TransportResult<(Self, MuxDriver)> {
+        let remote_addr = stream.peer_addr()?;
+        stream.set_nodelay(true)?;
+        let (reader, writer) = stream.into_split();
+
+        let max_streams = config.max_streams_per_connection.get();
+        let epoch = Instant::now();
+        let state = Arc::new(ConnectionState {
+            streams: Mutex::new(HashMap::new()),
+            probes: Mutex::new(HashMap::new()),
+            permits: Arc::new(Semaphore::new(max_streams)),
+            closed: AtomicBool::new(false),
+            local_parity: role.first_stream_id() % 2,
+            epoch,
+            last_activity_ms: AtomicU64::new(0),
+        });
+        let framing = FramingHandler::new(config.max_frame_size);
+        // Open streams each hold one slot for their close frame on top of
+        // the configured depth.
+        let (outbound, outbound_queue) =
+            mpsc::channel(config.write_queue_depth.get() + max_streams);
+        let (accept_queue, accepted) = mpsc::channel(max_streams);
+        let (shutdown_tx, shutdown) = oneshot::channel();
+
+        let driver = MuxDriver {
+            reader,
+            writer,
+            framing: framing.clone(),
+            state: state.clone(),
+            outbound: outbound.clone(),
+            outbound_queue,
+            accept_queue,
+            stream_queue_depth: config.stream_queue_depth.get(),
+            remote_ids: RemoteStreamIds::new(role.peer().first_stream_id(), max_streams),
+            shutdown,
+        };
+        let connection = Self {
+            shared: Arc::new(ConnectionShared {
+                remote_addr,
+                framing,
+                max_frame_size: config.max_frame_size,
+                max_streams,
+                stream_queue_depth: config.stream_queue_depth.get(),
+                state,
+                outbound,
+                accepted: tokio::sync::Mutex::new(accepted),
+                next_stream_id: AtomicU64::new(role.first_stream_id()),
+                next_probe_id: AtomicU64::new(0),
+                _shutdown: shutdown_tx,
+            }),
+        };
+        Ok((connection, driver))
+    }
+
+    /// Remote socket address.
+    pub fn remote_addr(&self) -> SocketAddr {
+        self.shared.remote_addr
+    }
+
+    /// Whether both handles share the same underlying connection.
+    pub fn ptr_eq(&self, other: &Self) -> bool {
+        Arc::ptr_eq(&self.shared, &other.shared)
+    }
+
+    /// Whether the socket has failed or been closed by the peer.
+    pub fn is_closed(&self) -> bool {
+        self.shared.state.closed.load(Ordering::Acquire)
+    }
+
+    /// Number of streams currently open in either direction.
+    pub fn open_stream_count(&self) -> usize {
+        self.shared.max_streams - self.shared.state.permits.available_permits()
+    }
+
+    /// Time since the last frame or stream close, or `None` while streams
+    /// are open.
+    pub fn idle_for(&self) -> Option<Duration> {
+        if self.open_stream_count() > 0 {
+            return None;
+        }
+        let last = self.shared.state.last_activity_ms.load(Ordering::Relaxed);
+        Some(
+            self.shared
+                .state
+                .epoch
+                .elapsed()
+                .saturating_sub(Duration::from_millis(last)),
+        )
+    }
+
+    /// Open a stream, waiting for a free slot when the connection is full.
+    pub async fn open_stream(&self) -> TransportResult<MuxStream> {
+        let permit = self
+            .shared
+            .state
+            .permits
+            .clone()
+            .acquire_owned()
+            .await
+            .map_err(|_| connection_closed())?;
+        let close = self
+            .shared
+            .outbound
+            .clone()
+            .reserve_owned()
+            .await
+            .map_err(|_| connection_closed())?;
+        self.register_stream(permit, close)
+    }
+
+    /// Open a stream if the connection has a free slot and write-queue room.
+    pub fn try_open_stream(&self) -> Option<TransportResult<MuxStream>> {
+        let permit = self.shared.state.permits.clone().try_acquire_owned().ok()?;
+        let close = match self.shared.outbound.clone().try_reserve_owned() {
+            Ok(close) => close,
+            Err(TrySendError::Full(_)) => return None,
+            Err(TrySendError::Closed(_)) => return Some(Err(connection_closed())),
+        };
+        Some(self.register_stream(permit, close))
+    }
+
+    fn register_stream(
+        &self,
+        permit: OwnedSemaphorePermit,
+        close: mpsc::OwnedPermit<Outbound>,
+    ) -> TransportResult<MuxStream> {
+        if self.is_closed() {
+            return Err(connection_closed());
+        }
+        let id = self.shared.next_stream_id.fetch_add(2, Ordering::Relaxed);
+        let (sender, inbound) = mpsc::channel(self.shared.stream_queue_depth);
+        lock(&self.shared.state.streams).insert(id, sender);
+        Ok(MuxStream {
+            id,
+            connection: self.shared.clone(),
+            inbound,
+            close: Some(close),
+            _permit: permit,
+        })
+    }
+
+    /// Next stream opened by the peer, or `None` once the connection closes.
+    pub async fn accept_stream(&self) -> Option<MuxStream> {
+        let InboundStream {
+            id,
+            inbound,
+            close,
+            permit,
+        } = self.shared.accepted.lock().await.recv().await?;
+        Some(MuxStream {
+            id,
+            connection: self.shared.clone(),
+            inbound,
+            close: Some(close),
+            _permit: permit,
+        })
+    }
+
+    /// Round-trip a heartbeat, failing if no reply arrives within `deadline`.
+    pub async fn health_check(&self, deadline: Duration) -> TransportResult<()> {
+        let probe_id = self.shared.next_probe_id.fetch_add(1, Ordering::Relaxed);
+        let (sender, reply) = oneshot::channel();
+        lock(&self.shared.state.probes).insert(probe_id, sender);
+
+        let result = async {
+            if self.is_closed() {
+                return Err(connection_closed());
+            }
+            let probe = self.shared.framing.create_heartbeat_frame(probe_id);
+            self.shared
+                .outbound
+                .send(Outbound::from(probe))
+                .await
+                .map_err(|_| connection_closed())?;
+            timeout(deadline, reply)
+                .await
+                .map_err(|_| TransportError::Timeout("Multiplexed heartbeat timeout".to_string()))?
+                .map_err(|_| connection_closed())
+        }
+        .await;
+
+        lock(&self.shared.state.probes).remove(&probe_id);
+        result
+    }
+}
+
+impl MuxStream {
+    /// Stream id carried in the frame sequence field.
+    pub fn id(&self) -> u64 {
+        self.id
+    }
+
+    /// Queue a payload for the peer, waiting while the write queue is full.
+    ///
+    /// Delivery failures after queueing surface as the connection closing.
+    pub async fn send(&self, payload: impl Into<Bytes>) -> TransportResult<()> {
+        let frame = self.data_frame(payload.into())?;
+        self.queue(Outbound::from(frame)).await
+    }
+
+    /// Send a payload and wait until the writer has flushed it to the socket.
+    ///
+    /// Unlike [`send`](Self::send), a failed write is reported to the caller
+    /// instead of only closing the connection.
+    pub async fn send_flushed(&self, payload: impl Into<Bytes>) -> TransportResult<()> {
+        let frame = self.data_frame(payload.into())?;
+        let (flushed, written) = oneshot::channel();
+        self.queue(Outbound {
+            frame,
+            flushed: Some(flushed),
+        })
+        .await?;
+        match written.await {
+            Ok(Ok(())) => Ok(()),
+            Ok(Err(reason)) => Err(TransportError::ConnectionFailed(format!(
+                "Multiplexed write failed: {reason}"
+            ))),
+            Err(_) => Err(connection_closed()),
+        }
+    }
+
+    fn data_frame(&self, payload: Bytes) -> TransportResult<Frame> {
+        if payload.len() > self.connection.max_frame_size as usize {
+            return Err(TransportError::Protocol(format!(
+                "Stream payload too large: {} > {}",
+                payload.len(),
+                self.connection.max_frame_size
+            )));
+        }
+        if self.connection.state.closed.load(Ordering::Acquire) {
+            return Err(connection_closed());
+        }
+        Ok(self.connection.framing.create_data_frame(payload, self.id))
+    }
+
+    async fn queue(&self, outbound: Outbound) -> TransportResult<()> {
+        self.connection
+            .outbound
+            .send(outbound)
+            .await
+            .map_err(|_| connection_closed())
+    }
+
+    /// Next payload from the peer, or `None` once either side closes.
+    pub async fn recv(&mut self) -> Option<Bytes> {
+        self.inbound.recv().await
+    }
+}
+
+impl Drop for MuxStream {
+    fn drop(&mut self) {
+        let state = &self.connection.state;
+        lock(&state.streams).remove(&self.id);
+        state.touch();
+
+        // The close frame takes the slot reserved at open, so it queues
+        // behind this stream's earlier sends without waiting.
+        if let Some(slot) = self.close.take() {
+            let close = self
+                .connection
+                .framing
+                .create_control_frame(Bytes::new(), self.id);
+            slot.send(Outbound::from(close));
+        }
+    }
+}
+
+impl MuxDriver {
+    /// Run the connection's reader and writer until the connection closes.
+    ///
+    /// The writer drains queued frames and exits once the last sender
+    /// (including the reader's) is gone.
+    pub async fn run(self) {
+        let Self {
+            reader,
+            writer,
+            framing,
+            state,
+            outbound,
+            outbound_queue,
+            accept_queue,
+            stream_queue_depth,
+            remote_ids,
+            shutdown,
+        } = self;
+        tokio::join!(
+            write_loop(writer, framing.clone(), outbound_queue, state.clone()),
+            read_loop(
+                reader,
+                framing,
+                state,
+                outbound,
+                accept_queue,
+                stream_queue_depth,
+                remote_ids,
+                shutdown,
+            ),
+        );
+    }
+}
+
+impl RemoteStreamIds {
+    fn new(first: u64, max_skipped: usize) -> Self {
+        Self {
+            next: first,
+            skipped: BTreeSet::new(),
+            max_skipped,
+        }
+    }
+
+    /// Whether `stream_id` (of remote parity) names a stream the peer has
+    /// not used before; records it as seen either way.
+    fn first_use(&mut self, stream_id: u64) -> bool {
+        if stream_id < self.next {
+            return self.skipped.remove(&stream_id);
+        }
+        let window = 2 * self.max_skipped as u64;
+        let mut skipped = self.next.max(stream_id.saturating_sub(window));
+        while skipped < stream_id {
+            self.skipped.insert(skipped);
+            skipped += 2;
+        }
+        while self.skipped.len() > self.max_skipped {
+            self.skipped.pop_first();
+        }
+        self.next = stream_id.saturating_add(2);
+        true
+    }
+}
+
+impl ConnectionState {
+    fn touch(&self) {
+        let elapsed = self.epoch.elapsed().as_millis() as u64;
+        self.last_activity_ms.store(elapsed, Ordering::Relaxed);
+    }
+
+    fn is_local_stream(&self, stream_id: u64) -> bool {
+        stream_id % 2 == self.local_parity
+    }
+
+    fn close(&self) {
+        self.closed.store(true, Ordering::Release);
+        self.permits.close();
+        lock(&self.streams).clear();
+        lock(&self.probes).clear();
+    }
+}
+
+async fn write_loop(
+    mut writer: OwnedWriteHalf,
+    framing: FramingHandler,
+    mut outbound: mpsc::Receiver<Outbound>,
+    state: Arc<ConnectionState>,
+) {
+    let mut batch = Vec::with_capacity(MAX_WRITE_BATCH);
+    let mut flushed = Vec::new();
+    while let Some(next) = outbound.recv().await {
+        let mut next = Some(next);
+        while let Some(Outbound {
+            frame,
+            flushed: waiter,
+        }) = next.take()
+        {
+            batch.push(frame);
+            flushed.extend(waiter);
+            if batch.len() < MAX_WRITE_BATCH {
+                next = outbound.try_recv().ok();
+            }
+        }
+        let result = framing.send_frames(&mut writer, &batch).await;
+        for waiter in flushed.drain(..) {
+            let _ = waiter.send(
+                result
+                    .as_ref()
+                    .map(|_| ())
+                    .map_err(|error| error.to_string()),
+            );
+        }
+        if result.is_err() {
+            break;
+        }
+        batch.clear();
+    }
+    state.close();
+}
+
+#[allow(clippy::too_many_arguments)] // Driver state is moved in piecewise
+async fn read_loop(
+    mut reader: OwnedReadHalf,
+    framing: FramingHandler,
+    state: Arc<ConnectionState>,
+    outbound: mpsc::Sender<Outbound>,
+    accept_queue: mpsc::Sender<InboundStream>,
+    stream_queue_depth: usize,
+    mut remote_ids: RemoteStreamIds,
+    mut shutdown: oneshot::Receiver<()>,
+) {
+    let budget = FRAME_HEADER_SIZE + framing.max_frame_size() as usize;
+    let mut buffer = FrameReceiveBuffer::with_read_ahead(budget);
+
+    loop {
+        let frame = tokio::select! {
+            received = framing.receive_frame_shared(&mut reader, &mut buffer) => match received {
+                Ok(frame) => frame,
+                Err(_) => break,
+            },
+            _ = &mut shutdown => break,
+        };
+        state.touch();
+        let stream_id = frame.header.sequence;
+        match frame.header.frame_type {
+            FrameType::Data => {
+                let known = lock(&state.streams).get(&stream_id).cloned();
+                let sender = match known {
+                    Some(sender) => sender,
+                    None if !state.is_local_stream(stream_id)
+                        && remote_ids.first_use(stream_id) =>
+                    {
+                        match admit_inbound_stream(
+                            stream_id,
+                            &state,
+                            &outbound,
+                            &accept_queue,
+                            stream_queue_depth,
+                        )
+                        .await
+                        {
+                            Some(sender) => sender,
+                            None => {
+                                let reject = framing.create_control_frame(Bytes::new(), stream_id);
+                                let _ = outbound.try_send(Outbound::from(reject));
+                                continue;
+                            }
+                        }
+                    }
+                    // Late data for a stream either side already closed
+                    None => continue,
+                };
+                // A receiver dropped mid-delivery just discards the payload
+                let _ = sender.send(frame.payload).await;
+            }
+            FrameType::Control => {
+                lock(&state.streams).remove(&stream_id);
+            }
+            FrameType::Heartbeat if frame.header.flags & HEARTBEAT_ACK != 0 => {
+                if let Some(waiter) = lock(&state.probes).remove(&stream_id) {
+                    let _ = waiter.send(());
+                }
+            }
+            FrameType::Heartbeat => {
+                let mut ack = framing.create_heartbeat_frame(stream_id);
+                ack.header.flags = HEARTBEAT_ACK;
+                if outbound.send(Outbound::from(ack)).await.is_err() {
+                    break;
+                }
+            }
+            FrameType::Error => break,
+        }
+    }
+    state.close();
+}
+
+/// Register a peer-opened stream if a slot and an accept-queue entry are free.
+///
+/// Waits for write-queue room to reserve the stream's close frame.
+async fn admit_inbound_stream(
+    stream_id: u64,
+    state: &ConnectionState,
+    outbound: &mpsc::Sender<Outbound>,
+    accept_queue: &mpsc::Sender<InboundStream>,
+    stream_queue_depth: usize,
+) -> Option<mpsc::Sender<Bytes>> {
+    let permit = state.permits.clone().try_acquire_owned().ok()?;
+    let close = outbound.clone().reserve_owned().await.ok()?;
+    let (sender, inbound) = mpsc::channel(stream_queue_depth);
+    lock(&state.streams).insert(stream_id, sender.clone());
+    let admitted = accept_queue.try_send(InboundStream {
+        id: stream_id,
+        inbound,
+        close,
+        permit,
+    });
+    if admitted.is_err() {
+        lock(&state.streams).remove(&stream_id);
+        return None;
+    }
+    Some(sender)
+}
+
+fn connection_closed() -> TransportError {
+    TransportError::ConnectionFailed("Multiplexed connection closed".to_string())
+}
+
+/// Stream tables hold only channel handles, so a panic while holding the
+/// lock cannot leave them half-updated.
+fn lock<T>(mutex: &Mutex<T>) -> MutexGuard<'_, T> {
+    mutex.lock().unwrap_or_else(PoisonError::into_inner)
+}
+
+#[cfg(test)]
+#[allow(clippy::expect_used)]
+mod tests {
+    use super::*;
+    use std::future::Future;
+    use tokio::net::TcpListener;
+
+    /// Connect a dialer and an acceptor and run `body` while both drivers run.
+    async fn with_connected_pair<F, Fut>(config: &MuxConfig, body: F)
+    where
+        F: FnOnce(MultiplexedConnection, MultiplexedConnection) -> Fut,
+        Fut: Future<Output = ()>,
+    {
+        let listener = TcpListener::bind("127.0.0.1:0").await.expect("bind");
+        let addr = listener.local_addr().expect("listener addr");
+        let (dialed, accepted) = tokio::join!(TcpStream::connect(addr), listener.accept());
+        let (dialer, dialer_driver) =
+            MultiplexedConnection::new(dialed.expect("connect"), MuxRole::Dialer, config)
+                .expect("dialer mux");
+        let (accepted, _) = accepted.expect("accept");
+        let (acceptor, acceptor_driver) =
+            MultiplexedConnection::new(accepted, MuxRole::Acceptor, config).expect("acceptor mux");
+
+        let drivers = async {
+            tokio::join!(dialer_driver.run(), acceptor_driver.run());
+            std::future::pending::<()>().await;
+        };
+        tokio::select! {
+            () = body(dialer, acceptor) => {}
+            () = drivers => {}
+        }
+    }
+
+    #[tokio::test]
+    async fn concurrent_streams_share_one_connection() {
+        with_connected_pair(&MuxConfig::default(), |dialer, acceptor| async move {
+            let first = dialer.open_stream().await.expect("first stream");
+            let mut second = dialer.open_stream().await.expect("second stream");
+            assert_eq!((first.id(), second.id()), (1, 3));
+            first.send(b"one".to_vec()).await.expect("send first");
+            second.send(b"two".to_vec()).await.expect("send second");
+
+            let mut inbound_first = acceptor.accept_stream().await.expect("accept first");
+            let inbound_second = acceptor.accept_stream().await.expect("accept second");
+            assert_eq!(inbound_first.id(), 1);
+            assert_eq!(inbound_first.recv().await.as_deref(), Some(&b"one"[..]));
+            inbound_second
+                .send_flushed(b"reply".to_vec())
+                .await
+                .expect("reply");
+            assert_eq!(second.recv().await.as_deref(), Some(&b"reply"[..]));
+
+            drop(first);
+            assert_eq!(inbound_first.recv().await, None);
+            assert_eq!(dialer.open_stream_count(), 1);
+        })
+        .await;
+    }
+
+    #[tokio::test]
+    async fn late_data_for_a_closed_stream_is_not_admitted_again() {
+        with_connected_pair(&MuxConfig::default(), |dialer, acceptor| async move {
+            let first = dialer.open_stream().await.expect("first stream");
+            first.send(b"early".to_vec()).await.expect("send early");
+            let mut inbound = acceptor.accept_stream().await.expect("accept first");
+            assert_eq!(inbound.recv().await.as_deref(), Some(&b"early"[..]));
+            drop(inbound);
+
+            // Sent after the acceptor closed the stream
+            first.send(b"late".to_vec()).await.expect("send late");
+            let second = dialer.open_stream().await.expect("second stream");
+            second.send(b"fresh".to_vec()).await.expect("send fresh");
+
+            let mut accepted = acceptor.accept_stream().await.expect("accept second");
+            assert_eq!(accepted.id(), second.id());
+            assert_eq!(accepted.recv().await.as_deref(), Some(&b"fresh"[..]));
+            assert_eq!(acceptor.open_stream_count(), 1);
+        })
+        .await;
+    }
+
+    #[test]
+    fn remote_ids_admit_out_of_order_first_use_once() {
+        let mut ids = RemoteStreamIds::new(1, 2);
+        assert!(ids.first_use(5));
+        assert!(ids.first_use(1));
+        assert!(ids.first_use(3));
+        assert!(!ids.first_use(1));
+        assert!(!ids.first_use(5));
+
+        // Only the `max_skipped` most recent gaps are remembered
+        assert!(ids.first_use(15));
+        assert!(!ids.first_use(9));
+        assert!(ids.first_use(11));
+        assert!(ids.first_use(13));
+    }
+
+    #[tokio::test]
+    async fn stream_slots_apply_backpressure_and_heartbeats_track_health() {
+        let config = MuxConfig {
+            max_streams_per_connection: NonZeroUsize::new(1).expect("limit"),
+            ..MuxConfig::default()
+        };
+        with_connected_pair(&config, |dialer, acceptor| async move {
+            let stream = dialer.open_stream().await.expect("only stream");
+            assert!(dialer.try_open_stream().is_none());
+            assert!(dialer.idle_for().is_none());
+            drop(stream);
+            assert!(dialer.try_open_stream().is_some());
+            assert!(dialer.idle_for().is_some());
+
+            dialer
+                .health_check(Duration::from_secs(1))
+                .await
+                .expect("live peer answers heartbeat");
+            drop(acceptor);
+            for _ in 0..100 {
+                if dialer.is_closed() {
+                    break;
+                }
+                tokio::time::sleep(Duration::from_millis(10)).await;
+            }
+            assert!(dialer.is_closed());
+            assert!(dialer.health_check(Duration::from_secs(1)).await.is_err());
+        })
+        .await;
+    }
+}
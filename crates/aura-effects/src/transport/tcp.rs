@@ -5,6 +5,8 @@
 //! Target: <200 lines, leverage tokio ecosystem.
 
 use super::env::tcp_listen_addr;
+use super::framing::write_all_vectored;
+use super::mux::{MultiplexedConnection, MuxConfig, MuxDriver, MuxRole, MUX_PREFACE};
 use super::{
     utils::TimeoutHelper, ConnectionId, TransportAddress, TransportConfig, TransportConnection,
     TransportError, TransportMetadata, TransportResult, TransportSocketAddr,
@@ -16,6 +18,7 @@ use aura_core::{
     },
     hash,
 };
+use bytes::{Bytes, BytesMut};
 use std::io;
 use std::net::SocketAddr;
 use tokio::io::{AsyncReadExt, AsyncWriteExt};
@@ -123,6 +126,57 @@ impl TcpTransportHandler {
         })
     }
 
+    /// Connect to a remote peer and multiplex the connection
+    ///
+    /// Writes [`MUX_PREFACE`] so the listener can tell the connection apart
+    /// from single-message ones. The caller runs the returned [`MuxDriver`].
+    pub async fn connect_multiplexed(
+        &self,
+        addr: TransportSocketAddr,
+        config: &MuxConfig,
+    ) -> TransportResult<(MultiplexedConnection, MuxDriver)> {
+        let mut stream = self
+            .connect_stream_with_retry(*addr.as_socket_addr())
+            .await?;
+
+        timeout(self.config.write_timeout.get(), async {
+            stream.write_all(&MUX_PREFACE).await?;
+            stream.flush().await
+        })
+        .await
+        .map_err(|_| TransportError::Timeout("TCP write timeout".to_string()))?
+        .map_err(TransportError::Io)?;
+
+        MultiplexedConnection::new(stream, MuxRole::Dialer, config)
+    }
+
+    /// Accept a connection whose dialer opened with [`MUX_PREFACE`]
+    ///
+    /// The caller runs the returned [`MuxDriver`].
+    pub async fn accept_multiplexed(
+        &self,
+        listener: &TcpListener,
+        config: &MuxConfig,
+    ) -> TransportResult<(MultiplexedConnection, MuxDriver)> {
+        let (mut stream, _connection) = self.accept(listener).await?;
+
+        let mut preface = [0u8; MUX_PREFACE.len()];
+        timeout(
+            self.config.read_timeout.get(),
+            stream.read_exact(&mut preface),
+        )
+        .await
+        .map_err(|_| TransportError::Timeout("TCP read preface timeout".to_string()))?
+        .map_err(TransportError::Io)?;
+        if preface != MUX_PREFACE {
+            return Err(TransportError::Protocol(
+                "Connection is not multiplexed".to_string(),
+            ));
+        }
+
+        MultiplexedConnection::new(stream, MuxRole::Acceptor, config)
+    }
+
     /// Listen for incoming TCP connections
     pub async fn listen(&self, bind_addr: TransportSocketAddr) -> TransportResult<TcpListener> {
         let listener = TcpListener::bind(*bind_addr.as_socket_addr())
@@ -192,20 +246,40 @@ impl TcpTransportHandler {
     }
 
     /// Send framed message (length-prefixed)
+    ///
+    /// Prefix and payload go out in one vectored write with a single flush.
     pub async fn send_framed(&self, stream: &mut TcpStream, data: &[u8]) -> TransportResult<usize> {
         let len = data.len() as u32;
         let len_bytes = len.to_be_bytes();
 
-        // Send length prefix
-        self.send(stream, &len_bytes).await?;
-        // Send data
-        self.send(stream, data).await?;
+        timeout(self.config.write_timeout.get(), async {
+            write_all_vectored(stream, &[&len_bytes, data]).await?;
+            stream.flush().await
+        })
+        .await
+        .map_err(|_| TransportError::Timeout("TCP write timeout".to_string()))?
+        .map_err(TransportError::Io)?;
 
         Ok(4 + data.len())
     }
 
     /// Receive framed message (length-prefixed)
     pub async fn receive_framed(&self, stream: &mut TcpStream) -> TransportResult<Vec<u8>> {
+        let mut buffer = BytesMut::new();
+        let data = self.receive_framed_into(stream, &mut buffer).await?;
+        Ok(Vec::from(data))
+    }
+
+    /// Receive framed message into a reusable buffer
+    ///
+    /// The payload is read straight into `buffer`'s spare capacity and split
+    /// off without copying; the allocation is reused once the returned bytes
+    /// are dropped.
+    pub async fn receive_framed_into(
+        &self,
+        stream: &mut TcpStream,
+        buffer: &mut BytesMut,
+    ) -> TransportResult<Bytes> {
         // Read 4-byte length prefix
         let mut len_bytes = [0u8; 4];
         timeout(
@@ -228,13 +302,22 @@ impl TcpTransportHandler {
         }
 
         // Read message data
-        let mut data = vec![0u8; len];
-        timeout(self.config.read_timeout.get(), stream.read_exact(&mut data))
-            .await
-            .map_err(|_| TransportError::Timeout("TCP read data timeout".to_string()))?
-            .map_err(TransportError::Io)?;
+        buffer.clear();
+        buffer.reserve(len);
+        timeout(self.config.read_timeout.get(), async {
+            let mut payload = (&mut *stream).take(len as u64);
+            while buffer.len() < len {
+                if payload.read_buf(buffer).await? == 0 {
+                    return Err(io::Error::from(io::ErrorKind::UnexpectedEof));
+                }
+            }
+            Ok(())
+        })
+        .await
+        .map_err(|_| TransportError::Timeout("TCP read data timeout".to_string()))?
+        .map_err(TransportError::Io)?;
 
-        Ok(data)
+        Ok(buffer.split().freeze())
     }
 }
 
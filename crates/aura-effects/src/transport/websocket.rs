@@ -223,12 +223,44 @@ impl WebSocketTransportHandler {
         ws_stream: &mut WebSocketStream<TcpStream>,
         data: &[u8],
     ) -> TransportResult<()> {
-        let message = Message::Binary(data.to_vec());
+        self.send_owned(ws_stream, data.to_vec()).await
+    }
 
-        timeout(self.config.write_timeout.get(), ws_stream.send(message))
-            .await
-            .map_err(|_| TransportError::Timeout("WebSocket send timeout".to_string()))?
-            .map_err(|e| TransportError::ConnectionFailed(format!("WebSocket send failed: {e}")))?;
+    /// Send an owned message over WebSocket without copying it
+    pub async fn send_owned(
+        &self,
+        ws_stream: &mut WebSocketStream<TcpStream>,
+        data: Vec<u8>,
+    ) -> TransportResult<()> {
+        timeout(
+            self.config.write_timeout.get(),
+            ws_stream.send(Message::Binary(data)),
+        )
+        .await
+        .map_err(|_| TransportError::Timeout("WebSocket send timeout".to_string()))?
+        .map_err(|e| TransportError::ConnectionFailed(format!("WebSocket send failed: {e}")))?;
+
+        Ok(())
+    }
+
+    /// Send several messages over WebSocket with a single flush
+    ///
+    /// Messages are queued into the sink's write buffer and flushed together,
+    /// so a burst costs one socket flush instead of one per message.
+    pub async fn send_batch(
+        &self,
+        ws_stream: &mut WebSocketStream<TcpStream>,
+        messages: Vec<Vec<u8>>,
+    ) -> TransportResult<()> {
+        timeout(self.config.write_timeout.get(), async {
+            for data in messages {
+                ws_stream.feed(Message::Binary(data)).await?;
+            }
+            ws_stream.flush().await
+        })
+        .await
+        .map_err(|_| TransportError::Timeout("WebSocket send timeout".to_string()))?
+        .map_err(|e| TransportError::ConnectionFailed(format!("WebSocket send failed: {e}")))?;
 
         Ok(())
     }
@@ -349,7 +381,7 @@ impl NetworkExtendedEffects for WebSocketTransportHandler {
             .connect(TransportUrl::from(url))
             .await
             .map_err(|e| NetworkError::ConnectionFailed(e.to_string()))?;
-        WebSocketTransportHandler::send(self, &mut ws_stream, &data)
+        self.send_owned(&mut ws_stream, data)
             .await
             .map_err(|e| NetworkError::SendFailed {
                 peer_id: None,
@@ -416,7 +448,7 @@ impl NetworkCoreEffects for WebSocketTransportHandler {
             .connect(TransportUrl::from(url))
             .await
             .map_err(|e| NetworkError::ConnectionFailed(e.to_string()))?;
-        self.send(&mut ws_stream, &message)
+        self.send_owned(&mut ws_stream, message)
             .await
             .map_err(|e| NetworkError::SendFailed {
                 peer_id: Some(peer_id),
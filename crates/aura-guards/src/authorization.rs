@@ -20,10 +20,14 @@
     clippy::disallowed_methods, // Guard chain coordinates time/random effects
     deprecated // Deprecated time/random functions used intentionally for effect coordination
 )]
-use aura_authorization::{BiscuitError, ResourceScope, VerifiedBiscuitToken};
+use aura_authorization::{
+    AuthorizationDecisionKey, BiscuitAuthorizerCache, BiscuitError, ResourceScope,
+    VerifiedBiscuitToken,
+};
 use aura_core::types::identifiers::AuthorityId;
 use aura_core::CapabilityName;
 use biscuit_auth::{macros::*, Authorizer, AuthorizerLimits, PublicKey};
+use std::sync::Arc;
 use std::time::Duration;
 
 const GUARD_BISCUIT_LIMITS: AuthorizerLimits = AuthorizerLimits {
@@ -35,6 +39,7 @@ const GUARD_BISCUIT_LIMITS: AuthorizerLimits = AuthorizerLimits {
 pub struct BiscuitAuthorizationBridge {
     root_public_key: PublicKey,
     authority_id: AuthorityId,
+    cache: Arc<BiscuitAuthorizerCache>,
 }
 
 impl BiscuitAuthorizationBridge {
@@ -212,9 +217,26 @@ impl BiscuitAuthorizationBridge {
     }
 
     pub fn new(root_public_key: PublicKey, authority_id: AuthorityId) -> Self {
+        Self::with_cache(
+            root_public_key,
+            authority_id,
+            Arc::new(BiscuitAuthorizerCache::new()),
+        )
+    }
+
+    /// Bridge that reuses authorizers and decisions cached by earlier bridges.
+    ///
+    /// The guard chain builds a bridge per request, so it passes a cache it
+    /// owns to keep per-token state across requests.
+    pub fn with_cache(
+        root_public_key: PublicKey,
+        authority_id: AuthorityId,
+        cache: Arc<BiscuitAuthorizerCache>,
+    ) -> Self {
         Self {
             root_public_key,
             authority_id,
+            cache,
         }
     }
 
@@ -242,6 +264,8 @@ impl BiscuitAuthorizationBridge {
 
     /// Production Biscuit authorization with cryptographic verification and Datalog policy evaluation
     /// Requires current time for deterministic behavior - use PhysicalTimeEffects in callers
+    ///
+    /// Decisions are cached per token, operation, scope and second.
     pub fn authorize(
         &self,
         token: &VerifiedBiscuitToken,
@@ -249,7 +273,21 @@ impl BiscuitAuthorizationBridge {
         resource: &ResourceScope,
         current_time_seconds: u64,
     ) -> Result<AuthorizationResult, BiscuitError> {
-        let mut authorizer = token.authorizer()?;
+        let key = AuthorizationDecisionKey::new(
+            token,
+            self.authority_id,
+            operation,
+            resource,
+            current_time_seconds,
+        );
+        if let Some(authorized) = self.cache.decision(&key) {
+            return Ok(AuthorizationResult {
+                authorized,
+                delegation_depth: self.extract_delegation_depth_from_token(token),
+            });
+        }
+
+        let mut authorizer = self.cache.authorizer(token)?;
 
         // Phase 2: Add ambient facts for authorization context
         self.add_authorize_ambient_facts(&mut authorizer, operation, current_time_seconds)?;
@@ -265,10 +303,10 @@ impl BiscuitAuthorizationBridge {
             Err(e) => return Err(BiscuitError::BiscuitLib(e)),
         };
 
+        self.cache.record_decision(key, authorized);
         Ok(AuthorizationResult {
             authorized,
             delegation_depth: self.extract_delegation_depth_from_token(token),
-            token_facts: self.extract_diagnostic_token_facts(token, current_time_seconds),
         })
     }
 
@@ -285,7 +323,7 @@ impl BiscuitAuthorizationBridge {
             .map_err(|error| BiscuitError::InvalidCapability(error.to_string()))?;
         let capability = capability_name.as_str();
 
-        let mut authorizer = token.authorizer()?;
+        let mut authorizer = self.cache.authorizer(token)?;
 
         // Add ambient facts for capability check
         self.add_authority_fact(&mut authorizer)?;
@@ -320,7 +358,9 @@ impl BiscuitAuthorizationBridge {
     }
 
     /// Extract readable token facts from a verified token for diagnostics only.
-    fn extract_diagnostic_token_facts(
+    ///
+    /// Built on request; [`Self::authorize`] does not collect them.
+    pub fn extract_diagnostic_token_facts(
         &self,
         token: &VerifiedBiscuitToken,
         current_time_seconds: u64,
@@ -333,7 +373,7 @@ impl BiscuitAuthorizationBridge {
         facts.push("extracted_from_token".to_string());
 
         // Try to extract facts from the verified token using an authorizer.
-        if let Ok(authorizer) = token.authorizer() {
+        if let Ok(authorizer) = self.cache.authorizer(token) {
             // Get the world facts which include facts from all token blocks
             let (world_facts, world_rules, _world_checks, _world_policies) = authorizer.dump();
             // Parse facts from the world dump
@@ -357,11 +397,10 @@ impl BiscuitAuthorizationBridge {
     }
 }
 
-#[derive(Debug, Clone)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub struct AuthorizationResult {
     pub authorized: bool,
     pub delegation_depth: Option<u32>,
-    pub token_facts: Vec<String>,
 }
 
 #[cfg(test)]
@@ -481,6 +520,32 @@ mod tests {
         );
     }
 
+    #[test]
+    fn bridges_sharing_a_cache_reuse_decisions() {
+        let (bridge, token) = test_bridge();
+        let scope = aura_authorization::ResourceScope::Authority {
+            authority_id: bridge.authority_id(),
+            operation: aura_core::types::scope::AuthorityOp::UpdateTree,
+        };
+        let cache = Arc::new(BiscuitAuthorizerCache::new());
+
+        for _ in 0..3 {
+            let per_request = BiscuitAuthorizationBridge::with_cache(
+                bridge.root_public_key(),
+                bridge.authority_id(),
+                cache.clone(),
+            );
+            let result = per_request
+                .authorize(&token, "execute", &scope, 1000)
+                .unwrap_or_else(|err| panic!("authorize failed: {err:?}"));
+            assert!(result.authorized);
+        }
+
+        assert_eq!(cache.authorizer_count(), 1);
+        assert_eq!(cache.decision_count(), 1);
+        assert_eq!(cache.decision_hits(), 2);
+    }
+
     #[test]
     fn capability_name_validation_rejects_uppercase() {
         let (bridge, token) = test_bridge();
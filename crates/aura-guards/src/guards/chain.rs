@@ -7,10 +7,14 @@
 use super::traits::GuardContextProvider;
 use super::types::{CapabilityId, GuardOperation, GuardOperationId};
 use super::GuardEffects;
-use crate::guards::executor::{execute_guard_plan, BorrowedEffectInterpreter, GuardPlan};
+use crate::guards::executor::{
+    convert_send_guard_to_request, execute_guard_batch, execute_guard_plan,
+    BorrowedEffectInterpreter, GuardPlan,
+};
 use crate::guards::{
     config::GuardRuntimeConfig, privacy::track_leakage_consumption, JournalCoupler, LeakageBudget,
 };
+use aura_core::latency::{self, LatencyStage};
 use aura_core::types::identifiers::{AuthorityId, ContextId};
 use aura_core::{AuraError, AuraResult, FlowCost, Receipt};
 use tracing::{debug, warn};
@@ -85,6 +89,25 @@ pub struct SendGuardMetrics {
     pub authorization_checks: u32,
 }
 
+impl SendGuardMetrics {
+    /// Metrics for one send from its pure-executor result.
+    ///
+    /// The executor reports a single execution time, so it is split evenly
+    /// between the authorization and flow stages.
+    pub(crate) fn from_execution(
+        execution_time_us: u64,
+        total_time_us: u64,
+        authorized: bool,
+    ) -> Self {
+        Self {
+            authorization_eval_time_us: execution_time_us / 2,
+            flow_eval_time_us: execution_time_us / 2,
+            total_time_us,
+            authorization_checks: u32::from(authorized),
+        }
+    }
+}
+
 impl SendGuardChain {
     /// Create new send guard chain
     ///
@@ -216,6 +239,7 @@ impl SendGuardChain {
 
         // Check and charge flow budget using the effect system
         // This implements the charge-before-send invariant
+        let _latency = latency::span(LatencyStage::GuardFlowCharge);
         let receipt = effect_system
             .charge_flow(&self.context, &self.peer, self.cost)
             .await
@@ -334,6 +358,140 @@ impl SendGuardChain {
 
         Ok(result)
     }
+
+    /// Evaluate a burst of sends that share a context and authorization requirement.
+    ///
+    /// The Biscuit token is evaluated once for the whole burst and each peer's
+    /// budget is debited once for the combined cost, but every send still gets
+    /// its own result and receipt, in input order. Sends are rejected up front
+    /// if they do not share a context and authorization requirement.
+    pub async fn evaluate_batch<
+        E: GuardEffects + GuardContextProvider + aura_core::PhysicalTimeEffects,
+    >(
+        sends: &[SendGuardChain],
+        effect_system: &E,
+    ) -> AuraResult<Vec<SendGuardResult>> {
+        let Some(first) = sends.first() else {
+            return Ok(Vec::new());
+        };
+        if sends.iter().any(|send| {
+            send.context != first.context
+                || send.message_authorization != first.message_authorization
+        }) {
+            return Err(AuraError::invalid(
+                "batched sends must share a context and authorization requirement",
+            ));
+        }
+
+        debug!(
+            sends = sends.len(),
+            authorization = %first.message_authorization,
+            context = ?first.context,
+            "Starting batched send guard evaluation"
+        );
+
+        let config = GuardRuntimeConfig::default();
+        for send in sends {
+            if let Some(budget) = &send.leakage_budget {
+                let operation_id = send
+                    .operation_id
+                    .as_ref()
+                    .map(ToString::to_string)
+                    .unwrap_or_else(|| "unnamed_send".to_string());
+                track_leakage_consumption(
+                    send.context,
+                    Some(send.peer),
+                    budget,
+                    operation_id.as_str(),
+                    config.default_observers.clone(),
+                    effect_system,
+                )
+                .await?;
+            }
+        }
+
+        let start_ms = effect_system.physical_time().await?.ts_ms;
+        let authority = GuardContextProvider::authority_id(effect_system);
+        let requests = sends
+            .iter()
+            .map(|send| convert_send_guard_to_request(send, authority))
+            .collect::<AuraResult<Vec<_>>>()?;
+        let interpreter = std::sync::Arc::new(BorrowedEffectInterpreter::new(effect_system));
+        let results = execute_guard_batch(effect_system, &requests, interpreter).await?;
+        let total_time_us = effect_system
+            .physical_time()
+            .await?
+            .ts_ms
+            .saturating_sub(start_ms)
+            * 1000;
+
+        Ok(sends
+            .iter()
+            .zip(results)
+            .map(|(send, result)| SendGuardResult {
+                authorized: result.authorized,
+                authorization_satisfied: result.authorized,
+                flow_authorized: result.authorized,
+                receipt: result.receipt,
+                authorization_level: Some(send.message_authorization.to_string()),
+                metrics: SendGuardMetrics::from_execution(
+                    result.execution_time_us,
+                    total_time_us,
+                    result.authorized,
+                ),
+                denial_reason: if result.authorized {
+                    None
+                } else {
+                    result.denial_reason
+                },
+            })
+            .collect())
+    }
+
+    /// Evaluate a burst of sends and couple the journal facts of the authorized ones.
+    ///
+    /// Coupled facts from the whole burst are merged and persisted together;
+    /// see [`JournalCoupler::couple_batch_with_sends`].
+    pub async fn evaluate_batch_with_coupling<
+        E: GuardEffects
+            + GuardContextProvider
+            + aura_core::TimeEffects
+            + aura_core::PhysicalTimeEffects,
+    >(
+        sends: &[SendGuardChain],
+        effect_system: &E,
+    ) -> AuraResult<Vec<SendGuardResult>> {
+        let results = Self::evaluate_batch(sends, effect_system).await?;
+
+        let couplers: Vec<&JournalCoupler> = sends
+            .iter()
+            .zip(&results)
+            .filter(|(_, result)| result.authorized)
+            .filter_map(|(send, _)| send.journal_coupler.as_ref())
+            .collect();
+        if !couplers.is_empty() {
+            debug!(
+                couplers = couplers.len(),
+                "Applying journal coupling after batched send authorization"
+            );
+            let coupling_result = JournalCoupler::couple_batch_with_sends(&couplers, effect_system)
+                .await
+                .map_err(|e| {
+                    warn!(
+                        error = %e,
+                        "Journal coupling failed after batched send authorization"
+                    );
+                    AuraError::internal(format!("Journal coupling failed: {e}"))
+                })?;
+
+            debug!(
+                facts_applied = coupling_result.operations_applied,
+                "Batched journal coupling completed successfully"
+            );
+        }
+
+        Ok(results)
+    }
 }
 
 /// Create a send guard chain for a message send
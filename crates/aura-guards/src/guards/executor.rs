@@ -16,19 +16,20 @@ use aura_core::{
     effects::{
         guard::{
             Decision, EffectCommand, EffectInterpreter, EffectResult, FlowBudgetView,
-            GuardSnapshot, MetadataView,
+            GuardSnapshot, JournalEntry, MetadataView,
         },
-        FlowBudgetEffects, JournalEffects, LeakageEffects, PhysicalTimeEffects, RandomEffects,
-        StorageEffects,
+        total_flow_cost, FlowBudgetEffects, JournalEffects, LeakageEffects, PhysicalTimeEffects,
+        RandomEffects, StorageEffects,
     },
     journal::Journal,
+    latency::{self, LatencyStage},
     time::TimeStamp,
     types::identifiers::{AuthorityId, ContextId},
-    AuraError, AuraResult as Result, Cap, FlowCost, Receipt,
+    AuraError, AuraResult as Result, Cap, FlowCost, JoinSemilattice, Receipt,
 };
 
 // Re-export key types for easier use by macro-generated code
-use aura_authorization::{ResourceScope, VerifiedBiscuitToken};
+use aura_authorization::{BiscuitAuthorizerCache, ResourceScope, VerifiedBiscuitToken};
 pub use aura_core::effects::guard::{
     EffectCommand as ChoreographyCommand, EffectResult as ChoreographyResult,
 };
@@ -62,6 +63,7 @@ where
             peer,
             amount,
         } => {
+            let _latency = latency::span(LatencyStage::GuardFlowCharge);
             let receipt = effects.charge_flow(&context, &peer, amount).await?;
             Ok(EffectResult::Receipt(receipt))
         }
@@ -115,6 +117,20 @@ where
     }
 }
 
+async fn charge_budget_batch_with_effects<E>(
+    effects: &E,
+    context: ContextId,
+    peer: AuthorityId,
+    amounts: Vec<FlowCost>,
+) -> Result<Vec<EffectResult>>
+where
+    E: FlowBudgetEffects,
+{
+    let _latency = latency::span(LatencyStage::GuardFlowCharge);
+    let receipts = effects.charge_flow_batch(&context, &peer, &amounts).await?;
+    Ok(receipts.into_iter().map(EffectResult::Receipt).collect())
+}
+
 /// Executor for pure guard chains with effect interpretation
 #[derive(Debug)]
 pub struct GuardChainExecutor<I: EffectInterpreter> {
@@ -122,6 +138,9 @@ pub struct GuardChainExecutor<I: EffectInterpreter> {
     guard_chain: GuardChain,
     /// Effect interpreter for executing commands
     interpreter: Arc<I>,
+    /// Biscuit authorizers and decisions reused across requests when the
+    /// effect system does not provide a longer-lived cache
+    biscuit_cache: Arc<BiscuitAuthorizerCache>,
 }
 
 impl<I: EffectInterpreter> GuardChainExecutor<I> {
@@ -130,6 +149,7 @@ impl<I: EffectInterpreter> GuardChainExecutor<I> {
         Self {
             guard_chain,
             interpreter,
+            biscuit_cache: Arc::new(BiscuitAuthorizerCache::new()),
         }
     }
 
@@ -245,12 +265,243 @@ impl<I: EffectInterpreter> GuardChainExecutor<I> {
         })
     }
 
+    /// Execute requests that share an authority, context and operation as one batch.
+    ///
+    /// The snapshot is prepared once, so the Biscuit token is evaluated once
+    /// and each peer's budget is read once. Every request is still evaluated
+    /// by the pure chain and gets its own result and receipt, but effects are
+    /// coalesced: each peer's charges go to the interpreter as one
+    /// [`EffectInterpreter::charge_budget_batch`] call, and the journal entries
+    /// of all charged requests are joined into a single `AppendJournal`.
+    ///
+    /// A peer whose combined cost exceeds its headroom, or whose debit fails,
+    /// has all of its requests denied; requests to other peers proceed.
+    pub async fn execute_batch<E>(
+        &self,
+        effect_system: &E,
+        requests: &[GuardRequest],
+    ) -> Result<Vec<GuardChainResult>>
+    where
+        E: crate::guards::GuardEffects + GuardContextProvider,
+    {
+        let Some(first) = requests.first() else {
+            return Ok(Vec::new());
+        };
+        if requests.iter().any(|request| {
+            request.authority != first.authority
+                || request.context != first.context
+                || request.operation != first.operation
+        }) {
+            return Err(AuraError::invalid(
+                "guard batch requests must share authority, context and operation",
+            ));
+        }
+        let start_time_ms = Self::current_time_ms(effect_system).await?;
+
+        let mut peers = Vec::new();
+        for request in requests {
+            if !peers.contains(&request.peer) {
+                peers.push(request.peer);
+            }
+        }
+        let snapshot = self
+            .prepare_snapshot_for_peers(effect_system, first, &peers)
+            .await?;
+
+        debug!(
+            authority = ?first.authority,
+            operation = %first.operation,
+            requests = requests.len(),
+            peers = peers.len(),
+            "Evaluating pure guard chain for batch"
+        );
+
+        // Evaluate each request purely, then split out the effects to coalesce.
+        let mut denials = Vec::with_capacity(requests.len());
+        let mut charges: Vec<((ContextId, AuthorityId), Vec<(usize, FlowCost)>)> = Vec::new();
+        let mut journal_entries = Vec::new();
+        let mut other_commands = Vec::new();
+        for (index, request) in requests.iter().enumerate() {
+            let outcome = self.guard_chain.evaluate(&snapshot, request);
+            denials.push(outcome.decision.denial_reason().map(ToString::to_string));
+            for command in outcome.effects {
+                match command {
+                    EffectCommand::ChargeBudget {
+                        context,
+                        peer,
+                        amount,
+                        ..
+                    } => {
+                        let key = (context, peer);
+                        match charges.iter_mut().find(|(group, _)| *group == key) {
+                            Some((_, group)) => group.push((index, amount)),
+                            None => charges.push((key, vec![(index, amount)])),
+                        }
+                    }
+                    EffectCommand::AppendJournal { entry } => journal_entries.push((index, entry)),
+                    command => other_commands.push((index, command)),
+                }
+            }
+        }
+
+        let mut effects_executed = vec![0usize; requests.len()];
+        let mut receipts: Vec<Option<Receipt>> = vec![None; requests.len()];
+        for ((context, peer), group) in charges {
+            let group: Vec<(usize, FlowCost)> = group
+                .into_iter()
+                .filter(|(index, _)| denials[*index].is_none())
+                .collect();
+            if group.is_empty() {
+                continue;
+            }
+            let costs: Vec<FlowCost> = group.iter().map(|(_, cost)| *cost).collect();
+            let fits = total_flow_cost(&costs).is_ok_and(|total| {
+                snapshot
+                    .budgets
+                    .get(&context, &peer)
+                    .is_none_or(|remaining| remaining >= total)
+            });
+            let charged = if fits {
+                self.interpreter
+                    .charge_budget_batch(context, first.authority, peer, costs)
+                    .await
+                    .map_err(|e| format!("Flow budget charge failed: {e}"))
+                    .and_then(|results| {
+                        results
+                            .into_iter()
+                            .map(|result| match result {
+                                EffectResult::Failure(reason) => {
+                                    Err(format!("Flow budget charge failed: {reason}"))
+                                }
+                                EffectResult::Receipt(receipt) => Ok(Some(receipt)),
+                                _ => Ok(None),
+                            })
+                            .collect::<std::result::Result<Vec<_>, _>>()
+                    })
+            } else {
+                Err("Insufficient flow budget for batch".to_string())
+            };
+            match charged {
+                Ok(batch_receipts) => {
+                    for ((index, _), receipt) in group.into_iter().zip(batch_receipts) {
+                        effects_executed[index] += 1;
+                        receipts[index] = receipt;
+                    }
+                }
+                Err(reason) => {
+                    warn!(
+                        peer = ?peer,
+                        sends = group.len(),
+                        reason = %reason,
+                        "Guard batch denied sends to peer"
+                    );
+                    for (index, _) in group {
+                        denials[index] = Some(reason.clone());
+                    }
+                }
+            }
+        }
+
+        // Charge-before-journal: only charged requests contribute facts.
+        let mut merged_entry: Option<JournalEntry> = None;
+        let mut journaled = Vec::new();
+        for (index, entry) in journal_entries {
+            if denials[index].is_some() {
+                continue;
+            }
+            journaled.push(index);
+            match &mut merged_entry {
+                Some(merged) => merged.fact = merged.fact.join(&entry.fact),
+                None => merged_entry = Some(entry),
+            }
+        }
+        if let Some(entry) = merged_entry {
+            self.interpreter
+                .execute(EffectCommand::AppendJournal { entry })
+                .await
+                .inspect_err(|e| error!(error = %e, "Failed to append batched journal entry"))?;
+            for index in journaled {
+                effects_executed[index] += 1;
+            }
+        }
+
+        for (index, command) in other_commands {
+            if denials[index].is_some() {
+                continue;
+            }
+            self.interpreter
+                .execute(command)
+                .await
+                .inspect_err(|e| error!(error = %e, "Failed to execute batched effect command"))?;
+            effects_executed[index] += 1;
+        }
+
+        let total_time_us = (Self::current_time_ms(effect_system)
+            .await?
+            .saturating_sub(start_time_ms))
+            * 1000;
+
+        info!(
+            authority = ?first.authority,
+            operation = %first.operation,
+            requests = requests.len(),
+            denied = denials.iter().filter(|reason| reason.is_some()).count(),
+            total_time_us = total_time_us,
+            "Guard chain batch execution completed"
+        );
+
+        Ok(denials
+            .into_iter()
+            .zip(receipts)
+            .zip(effects_executed)
+            .map(|((denial, receipt), effects_executed)| match denial {
+                Some(reason) => GuardChainResult {
+                    authorized: false,
+                    decision: Decision::Denied(reason.clone()),
+                    effects_executed: 0,
+                    denial_reason: Some(reason),
+                    execution_time_us: total_time_us,
+                    receipt: None,
+                },
+                None => GuardChainResult {
+                    authorized: true,
+                    decision: Decision::Authorized,
+                    effects_executed,
+                    denial_reason: None,
+                    execution_time_us: total_time_us,
+                    receipt,
+                },
+            })
+            .collect())
+    }
+
     /// Prepare guard snapshot from current effect system state
     async fn prepare_snapshot<E>(
         &self,
         effect_system: &E,
         request: &GuardRequest,
     ) -> Result<GuardSnapshot>
+    where
+        E: crate::guards::GuardEffects
+            + GuardContextProvider
+            + PhysicalTimeEffects
+            + FlowBudgetEffects
+            + StorageEffects
+            + RandomEffects,
+    {
+        self.prepare_snapshot_for_peers(effect_system, request, std::slice::from_ref(&request.peer))
+            .await
+    }
+
+    /// Prepare a snapshot holding the budget of every peer in `peers`.
+    ///
+    /// Biscuit authorization is evaluated once, for `request`'s operation.
+    async fn prepare_snapshot_for_peers<E>(
+        &self,
+        effect_system: &E,
+        request: &GuardRequest,
+        peers: &[AuthorityId],
+    ) -> Result<GuardSnapshot>
     where
         E: crate::guards::GuardEffects
             + GuardContextProvider
@@ -265,15 +516,17 @@ impl<I: EffectInterpreter> GuardChainExecutor<I> {
         // Get flow budgets. Missing or errored budget state must fail closed;
         // the journal implementation provides any configured default budget.
         let mut budgets = HashMap::new();
-        let budget = effect_system
-            .get_flow_budget(&request.context, &request.peer)
-            .await
-            .map_err(|error| {
-                AuraError::budget_exceeded(format!("flow budget lookup failed: {error}"))
-            })?;
-        let remaining = aura_core::FlowCost::try_from(budget.remaining())
-            .map_err(|e| AuraError::invalid(e.to_string()))?;
-        budgets.insert((request.context, request.peer), remaining);
+        for peer in peers {
+            let budget = effect_system
+                .get_flow_budget(&request.context, peer)
+                .await
+                .map_err(|error| {
+                    AuraError::budget_exceeded(format!("flow budget lookup failed: {error}"))
+                })?;
+            let remaining = aura_core::FlowCost::try_from(budget.remaining())
+                .map_err(|e| AuraError::invalid(e.to_string()))?;
+            budgets.insert((request.context, *peer), remaining);
+        }
         let budget_view = FlowBudgetView::new(budgets);
 
         // Capability container (capability enforcement handled by AuthorizationEffects)
@@ -284,9 +537,11 @@ impl<I: EffectInterpreter> GuardChainExecutor<I> {
         metadata_map.insert("authority_id".to_string(), request.authority.to_string());
 
         let authz_key = format!("authz:{}", request.operation);
-        let authz_ok = self
-            .evaluate_biscuit_authorization(effect_system, request)
-            .await;
+        let authz_ok = {
+            let _latency = latency::span(LatencyStage::GuardAuthorization);
+            self.evaluate_biscuit_authorization(effect_system, request)
+                .await
+        };
         metadata_map.insert(
             authz_key,
             if authz_ok {
@@ -403,7 +658,11 @@ impl<I: EffectInterpreter> GuardChainExecutor<I> {
             }
         };
 
-        let bridge = BiscuitAuthorizationBridge::new(root_pk, effect_system.authority_id());
+        let cache = effect_system
+            .biscuit_authorizer_cache()
+            .unwrap_or_else(|| self.biscuit_cache.clone());
+        let bridge =
+            BiscuitAuthorizationBridge::with_cache(root_pk, effect_system.authority_id(), cache);
         let evaluator = BiscuitGuardEvaluator::new(bridge);
 
         let resource = ResourceScope::Context {
@@ -506,6 +765,16 @@ where
         execute_effect_command_with_effects(self.effects.as_ref(), cmd).await
     }
 
+    async fn charge_budget_batch(
+        &self,
+        context: ContextId,
+        _authority: AuthorityId,
+        peer: AuthorityId,
+        amounts: Vec<FlowCost>,
+    ) -> Result<Vec<EffectResult>> {
+        charge_budget_batch_with_effects(self.effects.as_ref(), context, peer, amounts).await
+    }
+
     fn interpreter_type(&self) -> &'static str {
         "EffectSystemInterpreter"
     }
@@ -527,6 +796,16 @@ where
         execute_effect_command_with_effects(self.effects, cmd).await
     }
 
+    async fn charge_budget_batch(
+        &self,
+        context: ContextId,
+        _authority: AuthorityId,
+        peer: AuthorityId,
+        amounts: Vec<FlowCost>,
+    ) -> Result<Vec<EffectResult>> {
+        charge_budget_batch_with_effects(self.effects, context, peer, amounts).await
+    }
+
     fn interpreter_type(&self) -> &'static str {
         "BorrowedEffectInterpreter"
     }
@@ -632,6 +911,23 @@ where
     execute_guard_plan(effect_system, &plan, interpreter).await
 }
 
+/// Execute a batch of requests through the standard guard chain.
+///
+/// See [`GuardChainExecutor::execute_batch`] for how effects are coalesced.
+pub async fn execute_guard_batch<E, I>(
+    effect_system: &E,
+    requests: &[GuardRequest],
+    interpreter: Arc<I>,
+) -> Result<Vec<GuardChainResult>>
+where
+    E: crate::guards::GuardEffects + GuardContextProvider,
+    I: EffectInterpreter,
+{
+    GuardChainExecutor::new(GuardChain::standard(), interpreter)
+        .execute_batch(effect_system, requests)
+        .await
+}
+
 /// Shared guard plan for send-site and choreography execution.
 #[derive(Debug, Clone)]
 pub struct GuardPlan {
@@ -788,12 +1084,11 @@ impl SendGuardChain {
             } else {
                 None
             },
-            metrics: SendGuardMetrics {
-                authorization_eval_time_us: result.execution_time_us / 2,
-                flow_eval_time_us: result.execution_time_us / 2,
+            metrics: SendGuardMetrics::from_execution(
+                result.execution_time_us,
                 total_time_us,
-                authorization_checks: if result.authorized { 1 } else { 0 },
-            },
+                result.authorized,
+            ),
             denial_reason: result.denial_reason,
         })
     }
@@ -41,6 +41,7 @@
 //! journal facts using join-semilattice operations.
 
 use super::{GuardEffects, GuardOperationId, ProtocolGuard};
+use aura_core::latency::{self, LatencyStage};
 use aura_core::{AuraError, AuraResult, Journal, RetryPolicy, TimeEffects};
 use aura_mpst::journal::{JournalAnnotation, JournalOpType};
 use serde_json::Value as JsonValue;
@@ -449,6 +450,7 @@ impl JournalCoupler {
         effect_system: &E,
         receipt: &Option<aura_core::Receipt>,
     ) -> AuraResult<CouplingMetrics> {
+        let _latency = latency::span(LatencyStage::GuardJournalCouple);
         let operation_id = GuardOperationId::custom("send_coupling")
             .expect("send_coupling is a valid guard operation id");
 
@@ -484,6 +486,82 @@ impl JournalCoupler {
             coupling_successful: true,
         })
     }
+    /// Couple the journal annotations of a batch of successful sends.
+    ///
+    /// `AddFacts` deltas from every coupler are joined up front and applied
+    /// with a single `merge_facts` call; other annotation kinds are applied
+    /// per coupler as in [`couple_with_send`](Self::couple_with_send). The
+    /// journal is loaded and persisted once for the whole batch.
+    #[instrument(skip(couplers, effect_system), fields(couplers = couplers.len()))]
+    pub async fn couple_batch_with_sends<E: aura_core::effects::JournalEffects + TimeEffects>(
+        couplers: &[&JournalCoupler],
+        effect_system: &E,
+    ) -> AuraResult<CouplingMetrics> {
+        let _latency = latency::span(LatencyStage::GuardJournalCouple);
+        let operation_id = GuardOperationId::custom("send_coupling")
+            .expect("send_coupling is a valid guard operation id");
+
+        let mut fact_delta: Option<Journal> = None;
+        let mut fact_count = 0usize;
+        let mut remaining = Vec::new();
+        for coupler in couplers {
+            let Some(annotation) = coupler.annotations.get(&operation_id) else {
+                continue;
+            };
+            if matches!(annotation.op_type, JournalOpType::AddFacts) {
+                let delta = annotation.delta.as_ref().ok_or_else(|| {
+                    AuraError::invalid("journal AddFacts annotation missing required delta")
+                })?;
+                fact_delta
+                    .get_or_insert_with(Journal::new)
+                    .merge_facts(delta.facts.clone());
+                fact_count += 1;
+            } else {
+                remaining.push(*coupler);
+            }
+        }
+
+        if fact_delta.is_none() && remaining.is_empty() {
+            debug!("No journal annotations for send batch");
+            return Ok(CouplingMetrics {
+                coupling_successful: true,
+                ..CouplingMetrics::default()
+            });
+        }
+
+        let mut journal = effect_system.get_journal().await.map_err(|error| {
+            AuraError::internal(format!(
+                "journal coupling failed to load current journal: {error}"
+            ))
+        })?;
+
+        let mut operations_applied = 0usize;
+        if let Some(delta) = fact_delta {
+            journal = effect_system.merge_facts(journal, delta).await?;
+            operations_applied += fact_count;
+        }
+        for coupler in remaining {
+            let (updated_journal, applied_ops) = coupler
+                .apply_annotations(&operation_id, effect_system, &journal)
+                .await?;
+            journal = updated_journal;
+            operations_applied += applied_ops.len();
+        }
+
+        effect_system.persist_journal(&journal).await?;
+        debug!(
+            operations_applied,
+            "Journal coupling with send batch completed successfully"
+        );
+
+        Ok(CouplingMetrics {
+            // Timing captured by tracing span, not explicit measurement
+            journal_application_time_us: 0,
+            operations_applied,
+            retry_attempts: 0,
+            coupling_successful: true,
+        })
+    }
 
     /// Apply a single journal annotation
     async fn apply_single_annotation<E: aura_core::effects::JournalEffects + TimeEffects>(
@@ -4,8 +4,10 @@
 //! guard interpreter path (ADR-014). This module intentionally limits the
 //! surface area to authority/metadata access.
 
+use aura_authorization::BiscuitAuthorizerCache;
 use aura_core::effects::ExecutionMode;
 use aura_core::types::identifiers::AuthorityId;
+use std::sync::Arc;
 
 /// Minimal context provider for guards (authority + metadata).
 pub trait GuardContextProvider {
@@ -17,6 +19,15 @@ pub trait GuardContextProvider {
     fn can_perform_operation(&self, _operation: &str) -> bool {
         true
     }
+
+    /// Biscuit authorizer and decision cache shared by every guard evaluation.
+    ///
+    /// Guard executors are built per send, so a provider that outlives many
+    /// sends should own one cache and return it here; `None` leaves each
+    /// executor with a private, short-lived cache.
+    fn biscuit_authorizer_cache(&self) -> Option<Arc<BiscuitAuthorizerCache>> {
+        None
+    }
 }
 
 impl<T> GuardContextProvider for std::sync::Arc<T>
@@ -38,6 +49,10 @@ where
     fn can_perform_operation(&self, operation: &str) -> bool {
         (**self).can_perform_operation(operation)
     }
+
+    fn biscuit_authorizer_cache(&self) -> Option<Arc<BiscuitAuthorizerCache>> {
+        (**self).biscuit_authorizer_cache()
+    }
 }
 
 pub const META_BISCUIT_TOKEN: &str = "biscuit_token";
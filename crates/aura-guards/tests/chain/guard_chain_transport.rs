@@ -7,23 +7,32 @@
 #![allow(missing_docs)]
 use super::support::{test_authority, test_context};
 use async_trait::async_trait;
+use aura_authorization::{BiscuitAuthorizerCache, TokenAuthority};
 use aura_core::effects::authorization::AuthorizationError;
 use aura_core::effects::guard::{EffectCommand, EffectInterpreter, EffectResult};
 use aura_core::effects::leakage::{LeakageBudget, LeakageEvent, ObserverClass};
 use aura_core::effects::storage::{StorageError, StorageStats};
 use aura_core::effects::time::TimeError;
 use aura_core::effects::{
-    AuthorizationEffects, FlowBudgetEffects, JournalEffects, LeakageEffects, PhysicalTimeEffects,
-    RandomCoreEffects, StorageCoreEffects, StorageExtendedEffects,
+    batch_charge_nonces, total_flow_cost, AuthorizationEffects, FlowBudgetEffects, JournalEffects,
+    LeakageEffects, PhysicalTimeEffects, RandomCoreEffects, StorageCoreEffects,
+    StorageExtendedEffects,
 };
 use aura_core::time::PhysicalTime;
 use aura_core::types::flow::{FlowCost, FlowNonce, Receipt, ReceiptSig};
 use aura_core::types::Epoch;
 use aura_core::{AuraError, AuraResult, Cap, FlowBudget, Journal};
 use aura_core::{AuthorityId, ContextId};
-use aura_guards::executor::{execute_guard_plan, prepare_snapshot_from_effects, GuardPlan};
-use aura_guards::guards::pure::GuardRequest;
-use aura_guards::guards::traits::GuardContextProvider;
+use aura_guards::executor::{
+    execute_guard_batch, execute_guard_plan, prepare_snapshot_from_effects,
+    BorrowedEffectInterpreter, GuardChainExecutor, GuardPlan,
+};
+use aura_guards::guards::pure::{FlowBudgetGuard, GuardChain, GuardRequest, JournalCouplingGuard};
+use aura_guards::guards::traits::{
+    GuardContextProvider, META_BISCUIT_ISSUER_AUTHORITY, META_BISCUIT_ROOT_PK, META_BISCUIT_TOKEN,
+};
+use aura_guards::{CapabilityId, SendGuardChain};
+use base64::{engine::general_purpose::STANDARD as BASE64, Engine};
 use std::collections::HashMap;
 use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering};
 use std::sync::Arc;
@@ -57,8 +66,11 @@ struct TestEffects {
     journal: Mutex<Journal>,
     flow_budget: Mutex<FlowBudget>,
     fail_budget_lookup: AtomicBool,
+    debits: AtomicUsize,
     nonce: AtomicU64,
     time_ms: AtomicU64,
+    metadata: HashMap<String, String>,
+    authorizers: Option<Arc<BiscuitAuthorizerCache>>,
 }
 
 impl TestEffects {
@@ -69,11 +81,37 @@ impl TestEffects {
             journal: Mutex::new(Journal::new()),
             flow_budget: Mutex::new(FlowBudget::new(1_000, Epoch::from(1))),
             fail_budget_lookup: AtomicBool::new(false),
+            debits: AtomicUsize::new(0),
             nonce: AtomicU64::new(0),
             time_ms: AtomicU64::new(1_700_000_000_000),
+            metadata: HashMap::new(),
+            authorizers: None,
         }
     }
 
+    /// Publish a Biscuit token granting `capabilities` and own an authorizer
+    /// cache, as a long-lived runtime effect system does.
+    fn with_biscuit_token(mut self, capabilities: Vec<aura_core::CapabilityName>) -> Self {
+        let issuer = TokenAuthority::new(self.authority_id);
+        let token = issuer
+            .create_token(self.authority_id, capabilities)
+            .expect("test token should build");
+        self.metadata.insert(
+            META_BISCUIT_TOKEN.to_string(),
+            BASE64.encode(token.to_vec().expect("token should serialize")),
+        );
+        self.metadata.insert(
+            META_BISCUIT_ROOT_PK.to_string(),
+            BASE64.encode(issuer.root_public_key().to_bytes()),
+        );
+        self.metadata.insert(
+            META_BISCUIT_ISSUER_AUTHORITY.to_string(),
+            self.authority_id.to_string(),
+        );
+        self.authorizers = Some(Arc::new(BiscuitAuthorizerCache::new()));
+        self
+    }
+
     async fn set_flow_budget(&self, budget: FlowBudget) {
         *self.flow_budget.lock().await = budget;
     }
@@ -88,8 +126,12 @@ impl GuardContextProvider for TestEffects {
         self.authority_id
     }
 
-    fn get_metadata(&self, _key: &str) -> Option<String> {
-        None
+    fn get_metadata(&self, key: &str) -> Option<String> {
+        self.metadata.get(key).cloned()
+    }
+
+    fn biscuit_authorizer_cache(&self) -> Option<Arc<BiscuitAuthorizerCache>> {
+        self.authorizers.clone()
     }
 }
 
@@ -251,6 +293,7 @@ impl JournalEffects for TestEffects {
         _peer: &AuthorityId,
         cost: FlowCost,
     ) -> Result<FlowBudget, AuraError> {
+        self.debits.fetch_add(1, Ordering::SeqCst);
         let mut budget = self.flow_budget.lock().await;
         match budget.record_charge(cost) {
             Ok(()) => Ok(*budget),
@@ -280,6 +323,86 @@ impl FlowBudgetEffects for TestEffects {
             ReceiptSig::new(Vec::new())?,
         ))
     }
+
+    async fn charge_flow_batch(
+        &self,
+        context: &ContextId,
+        peer: &AuthorityId,
+        costs: &[FlowCost],
+    ) -> AuraResult<Vec<Receipt>> {
+        let budget = self
+            .charge_flow_budget(context, peer, total_flow_cost(costs)?)
+            .await?;
+        batch_charge_nonces(budget.spent, costs)
+            .into_iter()
+            .zip(costs)
+            .map(|(nonce, cost)| -> AuraResult<Receipt> {
+                Ok(Receipt::new(
+                    *context,
+                    self.authority_id,
+                    *peer,
+                    Epoch::from(1),
+                    *cost,
+                    nonce,
+                    aura_core::Hash32::default(),
+                    ReceiptSig::new(Vec::new())?,
+                ))
+            })
+            .collect()
+    }
+}
+
+/// Forwards to the effect system while counting batch charges and appends.
+struct BatchCountingInterpreter<'a> {
+    inner: BorrowedEffectInterpreter<'a, TestEffects>,
+    batch_charges: AtomicUsize,
+    single_charges: AtomicUsize,
+    journal_appends: AtomicUsize,
+}
+
+impl<'a> BatchCountingInterpreter<'a> {
+    fn new(effects: &'a TestEffects) -> Self {
+        Self {
+            inner: BorrowedEffectInterpreter::new(effects),
+            batch_charges: AtomicUsize::new(0),
+            single_charges: AtomicUsize::new(0),
+            journal_appends: AtomicUsize::new(0),
+        }
+    }
+}
+
+#[cfg_attr(target_arch = "wasm32", async_trait(?Send))]
+#[cfg_attr(not(target_arch = "wasm32"), async_trait)]
+impl EffectInterpreter for BatchCountingInterpreter<'_> {
+    async fn execute(&self, cmd: EffectCommand) -> AuraResult<EffectResult> {
+        match &cmd {
+            EffectCommand::ChargeBudget { .. } => {
+                self.single_charges.fetch_add(1, Ordering::SeqCst);
+            }
+            EffectCommand::AppendJournal { .. } => {
+                self.journal_appends.fetch_add(1, Ordering::SeqCst);
+            }
+            _ => {}
+        }
+        self.inner.execute(cmd).await
+    }
+
+    async fn charge_budget_batch(
+        &self,
+        context: ContextId,
+        authority: AuthorityId,
+        peer: AuthorityId,
+        amounts: Vec<FlowCost>,
+    ) -> AuraResult<Vec<EffectResult>> {
+        self.batch_charges.fetch_add(1, Ordering::SeqCst);
+        self.inner
+            .charge_budget_batch(context, authority, peer, amounts)
+            .await
+    }
+
+    fn interpreter_type(&self) -> &'static str {
+        "BatchCountingInterpreter"
+    }
 }
 
 #[async_trait]
@@ -426,3 +549,138 @@ async fn zero_flow_budget_does_not_create_implicit_headroom() {
         .budgets
         .has_budget(&context, &authority, FlowCost::new(1)));
 }
+
+fn batch_request(authority: AuthorityId, context: ContextId, peer: AuthorityId) -> GuardRequest {
+    GuardRequest::new(
+        authority,
+        aura_guards::GuardOperationId::custom("amp:send").expect("valid operation"),
+        FlowCost::new(1),
+    )
+    .with_context_id(context)
+    .with_peer(peer)
+    .with_context(context.to_bytes().to_vec())
+}
+
+#[tokio::test]
+async fn guard_batch_without_token_denies_every_send_and_charges_nothing() {
+    let authority = test_authority(31);
+    let context = test_context(33);
+    let effects = TestEffects::new(authority);
+    let requests: Vec<GuardRequest> = [32, 34, 32]
+        .into_iter()
+        .map(|peer| batch_request(authority, context, test_authority(peer)))
+        .collect();
+
+    let interpreter = Arc::new(CountingInterpreter {
+        send_count: Arc::new(AtomicUsize::new(0)),
+    });
+    let results = execute_guard_batch(&effects, &requests, interpreter)
+        .await
+        .expect("batch should evaluate");
+
+    assert_eq!(results.len(), requests.len());
+    assert!(results
+        .iter()
+        .all(|result| !result.authorized && result.receipt.is_none()));
+    assert_eq!(effects.flow_budget.lock().await.spent, 0);
+}
+
+#[tokio::test]
+async fn guard_batch_rejects_mixed_contexts() {
+    let authority = test_authority(41);
+    let peer = test_authority(42);
+    let effects = TestEffects::new(authority);
+    let requests = vec![
+        batch_request(authority, test_context(43), peer),
+        batch_request(authority, test_context(44), peer),
+    ];
+
+    let interpreter = Arc::new(CountingInterpreter {
+        send_count: Arc::new(AtomicUsize::new(0)),
+    });
+    let error = execute_guard_batch(&effects, &requests, interpreter)
+        .await
+        .expect_err("mixed contexts must be rejected");
+    assert!(error.to_string().contains("must share"));
+}
+
+#[tokio::test]
+async fn guard_batch_charges_once_through_interpreter_and_joins_journal() {
+    let authority = test_authority(51);
+    let peer = test_authority(52);
+    let context = test_context(53);
+    let effects = TestEffects::new(authority);
+    let requests: Vec<GuardRequest> = (0..3)
+        .map(|_| batch_request(authority, context, peer))
+        .collect();
+
+    // Biscuit evaluation is covered above; this exercises effect coalescing.
+    let chain = GuardChain::new()
+        .with_guard(FlowBudgetGuard)
+        .with_guard(JournalCouplingGuard);
+    let interpreter = Arc::new(BatchCountingInterpreter::new(&effects));
+    let results = GuardChainExecutor::new(chain, interpreter.clone())
+        .execute_batch(&effects, &requests)
+        .await
+        .expect("batch should execute");
+
+    assert!(results.iter().all(|result| result.authorized));
+    assert_eq!(interpreter.batch_charges.load(Ordering::SeqCst), 1);
+    assert_eq!(interpreter.single_charges.load(Ordering::SeqCst), 0);
+    assert_eq!(effects.debits.load(Ordering::SeqCst), 1);
+    assert_eq!(effects.flow_budget.lock().await.spent, 3);
+
+    let nonces: Vec<FlowNonce> = results
+        .iter()
+        .map(|result| {
+            result
+                .receipt
+                .as_ref()
+                .expect("charged send has a receipt")
+                .nonce
+        })
+        .collect();
+    assert_eq!(nonces, batch_charge_nonces(3, &[FlowCost::new(1); 3]));
+
+    assert_eq!(interpreter.journal_appends.load(Ordering::SeqCst), 1);
+    assert!(effects
+        .journal
+        .lock()
+        .await
+        .facts
+        .contains_key("operation_executed"));
+}
+
+#[tokio::test]
+async fn send_guard_evaluations_reuse_the_provider_authorizer_cache() {
+    let authority = test_authority(61);
+    let effects = TestEffects::new(authority)
+        .with_biscuit_token(vec![aura_core::capability_name!("amp:send")]);
+    let cache = effects
+        .biscuit_authorizer_cache()
+        .expect("effects own an authorizer cache");
+    let guard = SendGuardChain::new(
+        CapabilityId::try_from("amp:send").expect("valid capability"),
+        test_context(62),
+        test_authority(63),
+        FlowCost::new(1),
+    );
+
+    let first = guard
+        .evaluate(&effects)
+        .await
+        .expect("first send evaluates");
+    assert_eq!(cache.authorizer_count(), 1);
+    assert_eq!(cache.decision_count(), 1);
+    assert_eq!(cache.decision_hits(), 0);
+
+    // A second send builds a new executor but finds the decision cached.
+    let second = guard
+        .evaluate(&effects)
+        .await
+        .expect("second send evaluates");
+    assert_eq!(second.authorized, first.authorized);
+    assert_eq!(cache.authorizer_count(), 1);
+    assert_eq!(cache.decision_count(), 1);
+    assert_eq!(cache.decision_hits(), 1);
+}
@@ -15,16 +15,16 @@ fn key_bytes(seed: u64, index: u32) -> Vec<u8> {
 
 fn build_state(device_count: u32) -> AuthorityTreeState {
     let mut state = AuthorityTreeState::new();
-    for i in 0..device_count {
-        state.add_device(key_bytes(0xFACE_B00C, i));
-    }
+    state.add_devices((0..device_count).map(|i| key_bytes(0xFACE_B00C, i)));
     state
 }
 
 fn bench_incremental_vs_full(c: &mut Criterion) {
     let mut group = c.benchmark_group("authority_tree_incremental_vs_full");
 
-    for n in [32_u32, 128, 512, 2048] {
+    for n in [32_u32, 128, 512, 2048, 8192, 32_768] {
+        // Cloning the large trees dominates setup; keep their sample counts low
+        group.sample_size(if n >= 8192 { 10 } else { 100 });
         let base_state = build_state(n);
         let leaf = LeafId(n / 2);
         let new_key = key_bytes(0x1234_5678, n);
@@ -63,6 +63,14 @@ fn bench_incremental_vs_full(c: &mut Criterion) {
                 );
             },
         );
+
+        group.bench_with_input(
+            BenchmarkId::new("merkle_proof", n),
+            &base_state,
+            |b, state| {
+                b.iter(|| black_box(state.merkle_proof(leaf)));
+            },
+        );
     }
 
     group.finish();
@@ -135,7 +135,7 @@ fn validate_acyclicity(state: &TreeState) -> ApplicationResult<()> {
             }
 
             // Follow children (though these shouldn't create cycles if parent pointers are correct)
-            for child in state.get_children(current) {
+            for child in state.children(current) {
                 if !visited.contains(&child) {
                     stack.push_back(child);
                 }
@@ -565,7 +565,7 @@ fn recompute_commitments(
             h.update(&aura_core::policy_hash(&branch.policy));
 
             // Hash children commitments
-            for child in state.get_children(node) {
+            for child in state.children(node) {
                 if let Some(child_branch) = state.get_branch(&child) {
                     h.update(&child_branch.commitment);
                 }
@@ -0,0 +1,178 @@
+//! Flat branch arena for the authority tree
+//!
+//! `AuthorityTreeState` numbers branches breadth-first from the root, so
+//! branch indices are dense and every child has a larger index than its
+//! parent. [`BranchArena`] stores branch `i` at position `i` of one vector,
+//! next to its parent, children and cached hashes, and stores leaf parents in
+//! a vector indexed by `LeafId`:
+//! - walking a path to the root is a chain of vector reads with no
+//!   allocation ([`BranchArena::leaf_path`]);
+//! - iterating branches in reverse index order visits children before
+//!   parents, so full recomputes need no depth sort.
+
+use aura_core::tree::{LeafId, NodeIndex, TreeHash32};
+use serde::{Deserialize, Serialize};
+
+/// Child reference in the authority-internal branch topology.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord, Serialize, Deserialize)]
+pub(crate) enum ChildRef {
+    Branch(NodeIndex),
+    Leaf(LeafId),
+}
+
+/// Leaf parent slot of a leaf without a parent branch.
+const NO_PARENT: u32 = u32::MAX;
+
+/// One branch with its topology and cached hashes.
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+pub(crate) struct ArenaBranch {
+    /// Parent branch (None for the root).
+    pub parent: Option<NodeIndex>,
+    /// Ordered children.
+    pub children: (ChildRef, ChildRef),
+    /// Depth below the root (root = 0).
+    pub depth: u32,
+    /// Number of unique active leaves in the subtree.
+    pub leaf_count: u32,
+    /// Cached branch commitment.
+    pub commitment: TreeHash32,
+    /// Cached plain Merkle hash of the subtree, used for proofs.
+    pub plain_hash: TreeHash32,
+}
+
+/// Branches indexed by `NodeIndex`, plus leaf parents indexed by `LeafId`.
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize, Deserialize)]
+pub(crate) struct BranchArena {
+    branches: Vec<ArenaBranch>,
+    /// Parent branch index per leaf slot (`NO_PARENT` when absent).
+    leaf_parents: Vec<u32>,
+}
+
+impl BranchArena {
+    pub fn clear(&mut self) {
+        self.branches.clear();
+        self.leaf_parents.clear();
+    }
+
+    pub fn len(&self) -> usize {
+        self.branches.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.branches.is_empty()
+    }
+
+    /// Root branch, always `NodeIndex(0)` in a non-empty arena.
+    pub fn root(&self) -> Option<NodeIndex> {
+        (!self.branches.is_empty()).then_some(NodeIndex(0))
+    }
+
+    /// Append the branch with the next index and record its leaf children.
+    pub fn push(&mut self, branch: ArenaBranch) -> NodeIndex {
+        let node = NodeIndex(u32::try_from(self.branches.len()).unwrap_or(u32::MAX));
+        for child in [branch.children.0, branch.children.1] {
+            if let ChildRef::Leaf(leaf) = child {
+                let slot = leaf.0 as usize;
+                if self.leaf_parents.len() <= slot {
+                    self.leaf_parents.resize(slot + 1, NO_PARENT);
+                }
+                self.leaf_parents[slot] = node.0;
+            }
+        }
+        self.branches.push(branch);
+        node
+    }
+
+    pub fn get(&self, node: NodeIndex) -> Option<&ArenaBranch> {
+        self.branches.get(node.0 as usize)
+    }
+
+    pub fn get_mut(&mut self, node: NodeIndex) -> Option<&mut ArenaBranch> {
+        self.branches.get_mut(node.0 as usize)
+    }
+
+    /// Branches in index order; reverse it to visit children first.
+    pub fn iter(&self) -> impl DoubleEndedIterator<Item = (NodeIndex, &ArenaBranch)> {
+        self.branches
+            .iter()
+            .enumerate()
+            .map(|(index, branch)| (NodeIndex(index as u32), branch))
+    }
+
+    pub fn parent(&self, node: NodeIndex) -> Option<NodeIndex> {
+        self.get(node).and_then(|branch| branch.parent)
+    }
+
+    pub fn leaf_parent(&self, leaf: LeafId) -> Option<NodeIndex> {
+        self.leaf_parents
+            .get(leaf.0 as usize)
+            .copied()
+            .filter(|parent| *parent != NO_PARENT)
+            .map(NodeIndex)
+    }
+
+    /// Leaves with a parent branch, in leaf order.
+    pub fn leaf_parents(&self) -> impl Iterator<Item = (LeafId, NodeIndex)> + '_ {
+        self.leaf_parents
+            .iter()
+            .enumerate()
+            .filter(|(_, parent)| **parent != NO_PARENT)
+            .map(|(leaf, parent)| (LeafId(leaf as u32), NodeIndex(*parent)))
+    }
+
+    /// Branches from a leaf's parent up to the root, without allocating.
+    pub fn leaf_path(&self, leaf: LeafId) -> impl Iterator<Item = NodeIndex> + '_ {
+        std::iter::successors(self.leaf_parent(leaf), move |node| self.parent(*node))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn branch(parent: Option<NodeIndex>, left: ChildRef, right: ChildRef) -> ArenaBranch {
+        ArenaBranch {
+            parent,
+            children: (left, right),
+            depth: 0,
+            leaf_count: 1,
+            commitment: [0u8; 32],
+            plain_hash: [0u8; 32],
+        }
+    }
+
+    #[test]
+    fn leaf_path_walks_parents_to_root() {
+        let mut arena = BranchArena::default();
+        let root = arena.push(branch(
+            None,
+            ChildRef::Branch(NodeIndex(1)),
+            ChildRef::Branch(NodeIndex(2)),
+        ));
+        arena.push(branch(
+            Some(root),
+            ChildRef::Leaf(LeafId(0)),
+            ChildRef::Leaf(LeafId(1)),
+        ));
+        arena.push(branch(
+            Some(root),
+            ChildRef::Leaf(LeafId(4)),
+            ChildRef::Leaf(LeafId(4)),
+        ));
+
+        assert_eq!(arena.root(), Some(NodeIndex(0)));
+        assert_eq!(
+            arena.leaf_path(LeafId(4)).collect::<Vec<_>>(),
+            vec![NodeIndex(2), NodeIndex(0)]
+        );
+        assert_eq!(arena.leaf_path(LeafId(3)).count(), 0);
+        assert_eq!(
+            arena.leaf_parents().collect::<Vec<_>>(),
+            vec![
+                (LeafId(0), NodeIndex(1)),
+                (LeafId(1), NodeIndex(1)),
+                (LeafId(4), NodeIndex(2)),
+            ]
+        );
+    }
+}
@@ -2,21 +2,20 @@
 //!
 //! This module provides the internal TreeState implementation that hides
 //! device structure from external view, using LeafId as the internal handle.
+//!
+//! Topology lives in a flat [`BranchArena`] that also caches each branch's
+//! commitment and plain Merkle hash. A leaf key update rehashes only the
+//! leaf's path to the root, and Merkle proofs are read from the cached
+//! hashes on demand, so neither costs more than O(depth).
 
+use crate::commitment_tree::arena::{ArenaBranch, BranchArena, ChildRef};
 use crate::commitment_tree::local_types::{ExternalLeafView, LocalLeafNode};
 use aura_core::{
     tree::{commit_branch, commit_leaf, BranchNode, Epoch, LeafId, NodeIndex, Policy, TreeHash32},
     Hash32,
 };
 use serde::{Deserialize, Serialize};
-use std::collections::{BTreeMap, BTreeSet, VecDeque};
-
-/// Child reference in the authority-internal branch topology.
-#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord, Serialize, Deserialize)]
-enum ChildRef {
-    Branch(NodeIndex),
-    Leaf(LeafId),
-}
+use std::collections::{BTreeMap, BTreeSet};
 
 /// Authority-internal tree state with hidden device structure.
 #[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
@@ -45,9 +44,6 @@ pub struct AuthorityTreeState {
     /// Active leaf indices.
     active_leaves: BTreeSet<LeafId>,
 
-    /// Cached Merkle proof paths for each leaf.
-    merkle_paths: BTreeMap<LeafId, Vec<Vec<u8>>>,
-
     /// Root for the plain Merkle proof tree built from leaf commitments.
     #[serde(default)]
     merkle_root: TreeHash32,
@@ -64,41 +60,13 @@ pub struct AuthorityTreeState {
     /// Recorded notifications for devices and relying parties.
     dkg_notifications: Vec<DkgNotification>,
 
-    /// Root branch in the current topology.
-    #[serde(default)]
-    root_branch: Option<NodeIndex>,
-
-    /// Parent pointer for each non-root branch.
-    #[serde(default)]
-    branch_parent: BTreeMap<NodeIndex, NodeIndex>,
-
-    /// Ordered children for each branch.
-    #[serde(default)]
-    branch_children: BTreeMap<NodeIndex, (ChildRef, ChildRef)>,
-
-    /// Parent branch for each active leaf.
-    #[serde(default)]
-    leaf_parent: BTreeMap<LeafId, NodeIndex>,
-
-    /// Branch depth cache (root = 0).
-    #[serde(default)]
-    branch_depth: BTreeMap<NodeIndex, u32>,
-
-    /// Number of unique active leaves in each branch subtree.
-    #[serde(default)]
-    branch_leaf_counts: BTreeMap<NodeIndex, u32>,
-
-    /// Dirty branches awaiting recomputation.
+    /// Branch topology with cached commitments, indexed by `NodeIndex`.
     #[serde(default)]
-    dirty_branches: BTreeSet<NodeIndex>,
+    topology: BranchArena,
 
     /// Number of branch commitments recomputed in the last flush.
     #[serde(default)]
     last_recomputed_branch_count: u32,
-
-    /// Branches touched during the last flush; used for scoped proof refresh.
-    #[serde(default)]
-    last_recomputed_branches: BTreeSet<NodeIndex>,
 }
 
 #[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
@@ -114,6 +82,7 @@ enum DkgNotificationKind {
     RotationScheduled,
 }
 
+/// Branch of the bottom-up pairing pass, before breadth-first numbering.
 #[derive(Debug, Clone, PartialEq, Eq)]
 struct TempBranch {
     left: TempChild,
@@ -140,35 +109,48 @@ impl AuthorityTreeState {
             next_leaf_id: 0,
             threshold: 1,
             active_leaves: BTreeSet::new(),
-            merkle_paths: BTreeMap::new(),
             merkle_root: [0u8; 32],
             frost_key_cache: BTreeMap::new(),
             pending_dkg_devices: BTreeSet::new(),
             scheduled_dkg_epochs: BTreeMap::new(),
             dkg_notifications: Vec::new(),
-            root_branch: None,
-            branch_parent: BTreeMap::new(),
-            branch_children: BTreeMap::new(),
-            leaf_parent: BTreeMap::new(),
-            branch_depth: BTreeMap::new(),
-            branch_leaf_counts: BTreeMap::new(),
-            dirty_branches: BTreeSet::new(),
+            topology: BranchArena::default(),
             last_recomputed_branch_count: 0,
-            last_recomputed_branches: BTreeSet::new(),
         }
     }
 
     /// Add a device with public key, returns the assigned leaf index.
     pub fn add_device(&mut self, public_key: Vec<u8>) -> LeafId {
+        let leaf_id = self.insert_device(public_key);
+        self.refresh_after_structural_change();
+        leaf_id
+    }
+
+    /// Add several devices with a single structural refresh.
+    ///
+    /// Produces the same tree and commitments as calling [`Self::add_device`]
+    /// for each key in turn, but rebuilds the topology once.
+    pub fn add_devices<I>(&mut self, public_keys: I) -> Vec<LeafId>
+    where
+        I: IntoIterator<Item = Vec<u8>>,
+    {
+        let leaf_ids: Vec<LeafId> = public_keys
+            .into_iter()
+            .map(|public_key| self.insert_device(public_key))
+            .collect();
+        if !leaf_ids.is_empty() {
+            self.refresh_after_structural_change();
+        }
+        leaf_ids
+    }
+
+    fn insert_device(&mut self, public_key: Vec<u8>) -> LeafId {
         let leaf_id = LeafId(self.next_leaf_id);
         self.next_leaf_id = self.next_leaf_id.saturating_add(1);
 
         let leaf = LocalLeafNode::new(leaf_id, public_key);
         self.leaves.insert(leaf_id, leaf);
         self.active_leaves.insert(leaf_id);
-
-        self.refresh_after_structural_change();
-
         leaf_id
     }
 
@@ -220,7 +202,6 @@ impl AuthorityTreeState {
 
         self.active_leaves.remove(&leaf_id);
         self.leaf_commitments.remove(&leaf_id);
-        self.leaf_parent.remove(&leaf_id);
         self.frost_key_cache.remove(&leaf_id);
         self.pending_dkg_devices.remove(&leaf_id);
 
@@ -280,10 +261,33 @@ impl AuthorityTreeState {
             .map(|leaf| leaf.public_key.clone())
     }
 
-    /// Get encoded Merkle proof for one leaf.
+    /// Get encoded Merkle proof for one active leaf.
+    ///
+    /// Built from the cached subtree hashes along the leaf's path.
     #[must_use]
-    pub fn merkle_proof(&self, leaf_id: LeafId) -> Option<&[Vec<u8>]> {
-        self.merkle_paths.get(&leaf_id).map(std::vec::Vec::as_slice)
+    pub fn merkle_proof(&self, leaf_id: LeafId) -> Option<Vec<Vec<u8>>> {
+        if !self.active_leaves.contains(&leaf_id) {
+            return None;
+        }
+
+        let mut path = Vec::new();
+        let mut child_ref = ChildRef::Leaf(leaf_id);
+        for branch in self.topology.leaf_path(leaf_id) {
+            let (left, right) = self.topology.get(branch)?.children;
+            let (sibling_is_left, sibling_ref) = if left == child_ref {
+                (false, right)
+            } else if right == child_ref {
+                (true, left)
+            } else {
+                break;
+            };
+
+            let (_, sibling_hash) = self.child_hashes(sibling_ref);
+            path.push(Self::encode_proof_element(sibling_is_left, sibling_hash));
+            child_ref = ChildRef::Branch(branch);
+        }
+
+        Some(path)
     }
 
     /// Validate one provided proof path against current tree state.
@@ -313,12 +317,11 @@ impl AuthorityTreeState {
         current == self.merkle_root
     }
 
-    /// Validate the currently cached proof path for one leaf.
+    /// Validate the current proof path for one leaf.
     #[must_use]
     pub fn verify_merkle_proof(&self, leaf_id: LeafId) -> bool {
-        self.merkle_paths
-            .get(&leaf_id)
-            .is_some_and(|path| self.verify_merkle_proof_path(leaf_id, path))
+        self.merkle_proof(leaf_id)
+            .is_some_and(|path| self.verify_merkle_proof_path(leaf_id, &path))
     }
 
     /// Number of branches recomputed by the last incremental flush.
@@ -327,6 +330,11 @@ impl AuthorityTreeState {
         self.last_recomputed_branch_count
     }
 
+    /// Branches from a leaf's parent up to the root, without allocating.
+    pub fn leaf_path(&self, leaf_id: LeafId) -> impl Iterator<Item = NodeIndex> + '_ {
+        self.topology.leaf_path(leaf_id)
+    }
+
     /// Recompute root commitment using a full reference pass.
     ///
     /// This intentionally ignores dirty-path optimization and recomputes every
@@ -343,17 +351,10 @@ impl AuthorityTreeState {
             }
         }
 
-        let mut branch_commitments = BTreeMap::new();
-        let mut nodes: Vec<_> = self.branches.keys().copied().collect();
-        nodes.sort_by_key(|node| {
-            let depth = self.branch_depth.get(node).copied().unwrap_or(0);
-            (std::cmp::Reverse(depth), node.0)
-        });
-
-        for node in nodes {
-            let Some((left, right)) = self.branch_children.get(&node).copied() else {
-                continue;
-            };
+        // Reverse index order visits children before their parents.
+        let mut branch_commitments = vec![[0u8; 32]; self.topology.len()];
+        for (node, branch) in self.topology.iter().rev() {
+            let (left, right) = branch.children;
             let left_hash =
                 Self::child_commitment_from_maps(left, &leaf_commitments, &branch_commitments);
             let right_hash =
@@ -362,20 +363,13 @@ impl AuthorityTreeState {
                 .branches
                 .get(&node)
                 .map(|b| b.policy)
-                .unwrap_or_else(|| {
-                    self.policy_for_subtree(
-                        self.branch_leaf_counts.get(&node).copied().unwrap_or(1),
-                    )
-                });
+                .unwrap_or_else(|| self.policy_for_subtree(branch.leaf_count));
 
-            let commitment = commit_branch(node, self.epoch, &policy, &left_hash, &right_hash);
-            branch_commitments.insert(node, commitment);
+            branch_commitments[node.0 as usize] =
+                commit_branch(node, self.epoch, &policy, &left_hash, &right_hash);
         }
 
-        let root_hash = self
-            .root_branch
-            .and_then(|node| branch_commitments.get(&node).copied())
-            .unwrap_or([0u8; 32]);
+        let root_hash = branch_commitments.first().copied().unwrap_or([0u8; 32]);
         self.finalize_tree_commitment(root_hash.to_vec()).0
     }
 
@@ -394,18 +388,17 @@ impl AuthorityTreeState {
     }
 
     fn refresh_from_leaf_change(&mut self, leaf_id: LeafId) {
-        self.update_branch_policies();
-        self.mark_dirty_from_leaf(leaf_id);
-        self.recompute_subtree_commitment();
-        self.update_merkle_proof_paths();
+        // Policies depend only on subtree sizes and the threshold, so only
+        // the hashes on the leaf's path change.
+        self.recompute_leaf_path(leaf_id);
+        self.update_root_commitment_from_topology();
         self.assert_topology_invariants_debug();
     }
 
     fn refresh_nonstructural_commitments(&mut self) {
         self.update_branch_policies();
-        self.mark_all_branches_dirty();
-        self.recompute_subtree_commitment();
-        self.update_merkle_proof_paths();
+        self.recompute_all_branches();
+        self.update_root_commitment_from_topology();
         self.assert_topology_invariants_debug();
     }
 
@@ -449,32 +442,26 @@ impl AuthorityTreeState {
     }
 
     fn rebuild_topology_from_active_leaves(&mut self) {
-        self.root_branch = None;
-        self.branch_parent.clear();
-        self.branch_children.clear();
-        self.leaf_parent.clear();
-        self.branch_depth.clear();
-        self.branch_leaf_counts.clear();
+        self.topology.clear();
         self.branches.clear();
-        self.dirty_branches.clear();
-
-        let mut leaves: Vec<LeafId> = self.active_leaves.iter().copied().collect();
-        leaves.sort();
 
-        if leaves.is_empty() {
+        if self.active_leaves.is_empty() {
             self.root_commitment = self.finalize_tree_commitment(vec![0u8; 32]).0;
-            self.merkle_paths.clear();
             self.merkle_root = [0u8; 32];
             return;
         }
 
-        let mut temp_branches: BTreeMap<u32, TempBranch> = BTreeMap::new();
-        let mut next_temp_id: u32 = 0;
-
-        let mut level: Vec<TempChild> = leaves.into_iter().map(TempChild::Leaf).collect();
+        // Pair children bottom-up, carrying an odd last child as its own pair.
+        let mut temp_branches: Vec<TempBranch> = Vec::new();
+        let mut level: Vec<TempChild> = self
+            .active_leaves
+            .iter()
+            .copied()
+            .map(TempChild::Leaf)
+            .collect();
 
         while level.len() > 1 {
-            let mut next_level = Vec::new();
+            let mut next_level = Vec::with_capacity(level.len().div_ceil(2));
             for pair in level.chunks(2) {
                 let left = pair[0];
                 let right = pair.get(1).copied().unwrap_or(left);
@@ -485,16 +472,14 @@ impl AuthorityTreeState {
                 } else {
                     left_count.saturating_add(right_count)
                 };
-                temp_branches.insert(
-                    next_temp_id,
-                    TempBranch {
-                        left,
-                        right,
-                        unique_leaf_count,
-                    },
-                );
-                next_level.push(TempChild::Branch(next_temp_id));
-                next_temp_id = next_temp_id.saturating_add(1);
+                next_level.push(TempChild::Branch(
+                    u32::try_from(temp_branches.len()).unwrap_or(u32::MAX),
+                ));
+                temp_branches.push(TempBranch {
+                    left,
+                    right,
+                    unique_leaf_count,
+                });
             }
             level = next_level;
         }
@@ -502,78 +487,57 @@ impl AuthorityTreeState {
         let root_temp = match level.first().copied() {
             Some(TempChild::Branch(root)) => root,
             Some(TempChild::Leaf(leaf)) => {
-                let root = next_temp_id;
-                temp_branches.insert(
-                    root,
-                    TempBranch {
-                        left: TempChild::Leaf(leaf),
-                        right: TempChild::Leaf(leaf),
-                        unique_leaf_count: 1,
-                    },
-                );
-                root
+                temp_branches.push(TempBranch {
+                    left: TempChild::Leaf(leaf),
+                    right: TempChild::Leaf(leaf),
+                    unique_leaf_count: 1,
+                });
+                u32::try_from(temp_branches.len() - 1).unwrap_or(u32::MAX)
             }
             None => return,
         };
 
-        let mut temp_to_branch: BTreeMap<u32, NodeIndex> = BTreeMap::new();
-        let mut queue = VecDeque::new();
-        temp_to_branch.insert(root_temp, NodeIndex(0));
-        self.root_branch = Some(NodeIndex(0));
-        self.branch_depth.insert(NodeIndex(0), 0);
-        queue.push_back(root_temp);
-        let mut next_node_index: u32 = 1;
-
-        while let Some(temp_id) = queue.pop_front() {
-            let node_index = temp_to_branch[&temp_id];
-            let depth = self.branch_depth.get(&node_index).copied().unwrap_or(0);
-            let Some(temp_branch) = temp_branches.get(&temp_id) else {
-                continue;
-            };
-
+        // Number branches breadth-first from the root: `order[i]` is the
+        // pairing branch that becomes `NodeIndex(i)`.
+        let mut temp_to_branch: Vec<Option<NodeIndex>> = vec![None; temp_branches.len()];
+        let mut order = vec![root_temp];
+        let mut parents = vec![None];
+        let mut depths = vec![0u32];
+        temp_to_branch[root_temp as usize] = Some(NodeIndex(0));
+        let mut cursor = 0;
+        while cursor < order.len() {
+            let temp_branch = &temp_branches[order[cursor] as usize];
+            let node = NodeIndex(u32::try_from(cursor).unwrap_or(u32::MAX));
             for child in [temp_branch.left, temp_branch.right] {
-                if let TempChild::Branch(child_temp_id) = child {
-                    if let std::collections::btree_map::Entry::Vacant(entry) =
-                        temp_to_branch.entry(child_temp_id)
-                    {
-                        let child_node = NodeIndex(next_node_index);
-                        next_node_index = next_node_index.saturating_add(1);
-                        entry.insert(child_node);
-                        self.branch_parent.insert(child_node, node_index);
-                        self.branch_depth
-                            .insert(child_node, depth.saturating_add(1));
-                        queue.push_back(child_temp_id);
+                if let TempChild::Branch(child_temp) = child {
+                    if temp_to_branch[child_temp as usize].is_none() {
+                        temp_to_branch[child_temp as usize] =
+                            Some(NodeIndex(u32::try_from(order.len()).unwrap_or(u32::MAX)));
+                        order.push(child_temp);
+                        parents.push(Some(node));
+                        depths.push(depths[cursor].saturating_add(1));
                     }
                 }
             }
+            cursor += 1;
         }
 
-        let mut ordered: Vec<(NodeIndex, u32)> = temp_to_branch
-            .iter()
-            .map(|(temp, node)| (*node, *temp))
-            .collect();
-        ordered.sort_by_key(|(node, _)| node.0);
-
-        for (node, temp_id) in ordered {
-            let Some(temp_branch) = temp_branches.get(&temp_id) else {
-                continue;
-            };
-
-            let left = Self::map_temp_child(temp_branch.left, &temp_to_branch);
-            let right = Self::map_temp_child(temp_branch.right, &temp_to_branch);
-            self.branch_children.insert(node, (left, right));
-
-            if let ChildRef::Leaf(leaf) = left {
-                self.leaf_parent.insert(leaf, node);
-            }
-            if let ChildRef::Leaf(leaf) = right {
-                self.leaf_parent.insert(leaf, node);
-            }
-
+        for (index, temp_id) in order.iter().enumerate() {
+            let temp_branch = &temp_branches[*temp_id as usize];
             let leaf_count = temp_branch.unique_leaf_count.max(1);
-            self.branch_leaf_counts.insert(node, leaf_count);
-            let policy = self.policy_for_subtree(leaf_count);
+            let node = self.topology.push(ArenaBranch {
+                parent: parents[index],
+                children: (
+                    Self::map_temp_child(temp_branch.left, &temp_to_branch),
+                    Self::map_temp_child(temp_branch.right, &temp_to_branch),
+                ),
+                depth: depths[index],
+                leaf_count,
+                commitment: [0u8; 32],
+                plain_hash: [0u8; 32],
+            });
 
+            let policy = self.policy_for_subtree(leaf_count);
             self.branches.insert(
                 node,
                 BranchNode {
@@ -585,26 +549,32 @@ impl AuthorityTreeState {
         }
     }
 
-    fn map_temp_child(child: TempChild, mapping: &BTreeMap<u32, NodeIndex>) -> ChildRef {
+    fn map_temp_child(child: TempChild, mapping: &[Option<NodeIndex>]) -> ChildRef {
         match child {
-            TempChild::Branch(temp) => ChildRef::Branch(mapping[&temp]),
+            TempChild::Branch(temp) => {
+                ChildRef::Branch(mapping[temp as usize].unwrap_or(NodeIndex(u32::MAX)))
+            }
             TempChild::Leaf(leaf) => ChildRef::Leaf(leaf),
         }
     }
 
-    fn temp_child_leaf_count(child: TempChild, branches: &BTreeMap<u32, TempBranch>) -> u32 {
+    fn temp_child_leaf_count(child: TempChild, branches: &[TempBranch]) -> u32 {
         match child {
             TempChild::Leaf(_) => 1,
             TempChild::Branch(branch) => branches
-                .get(&branch)
+                .get(branch as usize)
                 .map(|entry| entry.unique_leaf_count)
                 .unwrap_or(1),
         }
     }
 
     fn policy_for_subtree(&self, leaf_count: u32) -> Policy {
+        Self::subtree_policy(self.threshold, leaf_count)
+    }
+
+    fn subtree_policy(threshold: u16, leaf_count: u32) -> Policy {
         let n = u16::try_from(leaf_count.max(1)).unwrap_or(u16::MAX);
-        let m = self.threshold.clamp(1, n);
+        let m = threshold.clamp(1, n);
 
         if n == 1 || m == n {
             Policy::All
@@ -616,280 +586,113 @@ impl AuthorityTreeState {
     }
 
     fn update_branch_policies(&mut self) {
-        let updates: Vec<_> = self
-            .branch_leaf_counts
-            .iter()
-            .map(|(node, leaf_count)| (*node, self.policy_for_subtree(*leaf_count)))
-            .collect();
-
-        for (node, policy) in updates {
-            if let Some(branch) = self.branches.get_mut(&node) {
-                branch.policy = policy;
+        let threshold = self.threshold;
+        for (node, branch) in self.topology.iter() {
+            if let Some(entry) = self.branches.get_mut(&node) {
+                entry.policy = Self::subtree_policy(threshold, branch.leaf_count);
             }
         }
     }
 
-    fn mark_all_branches_dirty(&mut self) {
-        self.dirty_branches = self.branches.keys().copied().collect();
-    }
-
-    fn mark_dirty_from_branch(&mut self, node: NodeIndex) {
-        if self.branches.contains_key(&node) {
-            self.dirty_branches.insert(node);
-        }
-    }
-
-    fn mark_dirty_from_leaf(&mut self, leaf_id: LeafId) {
-        if let Some(parent) = self.leaf_parent.get(&leaf_id).copied() {
-            self.mark_dirty_from_branch(parent);
+    /// Rehash the branches from a leaf's parent up to the root.
+    fn recompute_leaf_path(&mut self, leaf_id: LeafId) {
+        let mut recomputed: u32 = 0;
+        let mut next = self.topology.leaf_parent(leaf_id);
+        while let Some(node) = next {
+            self.recompute_branch(node);
+            recomputed = recomputed.saturating_add(1);
+            next = self.topology.parent(node);
         }
+        self.last_recomputed_branch_count = recomputed;
     }
 
-    fn collect_dirty_paths_to_root(&self) -> BTreeSet<NodeIndex> {
-        let mut affected = BTreeSet::new();
-
-        for branch in &self.dirty_branches {
-            let mut current = Some(*branch);
-            while let Some(node) = current {
-                if !affected.insert(node) {
-                    break;
-                }
-                current = self.branch_parent.get(&node).copied();
-            }
+    fn recompute_all_branches(&mut self) {
+        // Reverse index order visits children before their parents.
+        for index in (0..self.topology.len()).rev() {
+            self.recompute_branch(NodeIndex(u32::try_from(index).unwrap_or(u32::MAX)));
         }
-
-        affected
+        self.last_recomputed_branch_count = u32::try_from(self.topology.len()).unwrap_or(u32::MAX);
     }
 
-    fn flush_dirty_commitments_bottom_up(&mut self) {
-        let affected = self.collect_dirty_paths_to_root();
-        if affected.is_empty() {
-            self.last_recomputed_branch_count = 0;
-            self.last_recomputed_branches.clear();
-            self.update_root_commitment_from_topology();
+    /// Recompute one branch's commitment and plain hash from its children.
+    fn recompute_branch(&mut self, node: NodeIndex) {
+        let Some(branch) = self.topology.get(node) else {
             return;
-        }
-
-        let mut nodes: Vec<_> = affected.into_iter().collect();
-        nodes.sort_by_key(|node| {
-            let depth = self.branch_depth.get(node).copied().unwrap_or(0);
-            (std::cmp::Reverse(depth), node.0)
-        });
-
-        for node in &nodes {
-            let commitment = self.recompute_branch_commitment(*node);
-            if let Some(branch) = self.branches.get_mut(node) {
-                branch.commitment = commitment;
-            }
-        }
-
-        self.last_recomputed_branch_count = u32::try_from(nodes.len()).unwrap_or(u32::MAX);
-        self.last_recomputed_branches = nodes.iter().copied().collect();
-        self.dirty_branches.clear();
-        self.update_root_commitment_from_topology();
-    }
-
-    fn recompute_subtree_commitment(&mut self) {
-        self.flush_dirty_commitments_bottom_up();
-    }
-
-    fn recompute_branch_commitment(&self, node: NodeIndex) -> TreeHash32 {
-        let Some((left, right)) = self.branch_children.get(&node).copied() else {
-            return [0u8; 32];
         };
-
-        let left_hash = self.child_commitment(left);
-        let right_hash = self.child_commitment(right);
+        let (left, right) = branch.children;
         let policy = self
             .branches
             .get(&node)
-            .map(|branch| branch.policy)
-            .unwrap_or_else(|| {
-                self.policy_for_subtree(self.branch_leaf_counts.get(&node).copied().unwrap_or(1))
-            });
-
-        commit_branch(node, self.epoch, &policy, &left_hash, &right_hash)
-    }
-
-    fn child_commitment(&self, child: ChildRef) -> TreeHash32 {
+            .map(|entry| entry.policy)
+            .unwrap_or_else(|| self.policy_for_subtree(branch.leaf_count));
+
+        let (left_commitment, left_plain) = self.child_hashes(left);
+        let (right_commitment, right_plain) = self.child_hashes(right);
+        let commitment = commit_branch(
+            node,
+            self.epoch,
+            &policy,
+            &left_commitment,
+            &right_commitment,
+        );
+        let mut hasher = aura_core::hash::hasher();
+        hasher.update(&left_plain);
+        hasher.update(&right_plain);
+        let plain_hash = hasher.finalize();
+
+        if let Some(branch) = self.topology.get_mut(node) {
+            branch.commitment = commitment;
+            branch.plain_hash = plain_hash;
+        }
+        if let Some(entry) = self.branches.get_mut(&node) {
+            entry.commitment = commitment;
+        }
+    }
+
+    /// Commitment and plain Merkle hash of a child; a leaf's are equal.
+    fn child_hashes(&self, child: ChildRef) -> (TreeHash32, TreeHash32) {
         match child {
-            ChildRef::Leaf(leaf) => self
-                .leaf_commitments
-                .get(&leaf)
-                .copied()
-                .unwrap_or([0u8; 32]),
+            ChildRef::Leaf(leaf) => {
+                let commitment = self
+                    .leaf_commitments
+                    .get(&leaf)
+                    .copied()
+                    .unwrap_or([0u8; 32]);
+                (commitment, commitment)
+            }
             ChildRef::Branch(node) => self
-                .branches
-                .get(&node)
-                .map(|branch| branch.commitment)
-                .unwrap_or([0u8; 32]),
+                .topology
+                .get(node)
+                .map(|branch| (branch.commitment, branch.plain_hash))
+                .unwrap_or(([0u8; 32], [0u8; 32])),
         }
     }
 
     fn child_commitment_from_maps(
         child: ChildRef,
         leaf_commitments: &BTreeMap<LeafId, TreeHash32>,
-        branch_commitments: &BTreeMap<NodeIndex, TreeHash32>,
+        branch_commitments: &[TreeHash32],
     ) -> TreeHash32 {
         match child {
             ChildRef::Leaf(leaf) => leaf_commitments.get(&leaf).copied().unwrap_or([0u8; 32]),
             ChildRef::Branch(branch) => branch_commitments
-                .get(&branch)
+                .get(branch.0 as usize)
                 .copied()
                 .unwrap_or([0u8; 32]),
         }
     }
 
     fn update_root_commitment_from_topology(&mut self) {
-        let root_hash = self
-            .root_branch
-            .and_then(|root| self.branches.get(&root).map(|branch| branch.commitment))
-            .unwrap_or([0u8; 32]);
+        let (root_hash, merkle_root) = self
+            .topology
+            .root()
+            .and_then(|root| self.topology.get(root))
+            .map(|branch| (branch.commitment, branch.plain_hash))
+            .unwrap_or(([0u8; 32], [0u8; 32]));
+        self.merkle_root = merkle_root;
         self.root_commitment = self.finalize_tree_commitment(root_hash.to_vec()).0;
     }
 
-    fn update_merkle_proof_paths(&mut self) {
-        if self.active_leaves.is_empty() {
-            self.merkle_paths.clear();
-            self.merkle_root = [0u8; 32];
-            return;
-        }
-
-        let Some(root) = self.root_branch else {
-            self.merkle_paths.clear();
-            self.merkle_root = [0u8; 32];
-            return;
-        };
-
-        // Build plain subtree hashes from the materialized topology so proof
-        // paths share the same deterministic shape as branch commitments.
-        let mut plain_branch_hashes: BTreeMap<NodeIndex, TreeHash32> = BTreeMap::new();
-        let mut nodes: Vec<_> = self.branches.keys().copied().collect();
-        nodes.sort_by_key(|node| {
-            let depth = self.branch_depth.get(node).copied().unwrap_or(0);
-            (std::cmp::Reverse(depth), node.0)
-        });
-        for node in nodes {
-            let Some((left, right)) = self.branch_children.get(&node).copied() else {
-                continue;
-            };
-            let left_hash = self.child_plain_hash(left, &plain_branch_hashes);
-            let right_hash = self.child_plain_hash(right, &plain_branch_hashes);
-            let mut hasher = aura_core::hash::hasher();
-            hasher.update(&left_hash);
-            hasher.update(&right_hash);
-            plain_branch_hashes.insert(node, hasher.finalize());
-        }
-
-        self.merkle_root = plain_branch_hashes.get(&root).copied().unwrap_or([0u8; 32]);
-
-        self.merkle_paths
-            .retain(|leaf, _| self.active_leaves.contains(leaf));
-
-        let target_leaves = if self.merkle_paths.len() != self.active_leaves.len() {
-            self.active_leaves.iter().copied().collect()
-        } else {
-            self.collect_affected_leaves_for_proof_refresh()
-        };
-
-        for leaf in target_leaves {
-            let path = self.compute_merkle_proof_for_leaf(leaf, &plain_branch_hashes);
-            self.merkle_paths.insert(leaf, path);
-        }
-    }
-
-    fn child_plain_hash(
-        &self,
-        child: ChildRef,
-        branch_hashes: &BTreeMap<NodeIndex, TreeHash32>,
-    ) -> TreeHash32 {
-        match child {
-            ChildRef::Leaf(leaf) => self
-                .leaf_commitments
-                .get(&leaf)
-                .copied()
-                .unwrap_or([0u8; 32]),
-            ChildRef::Branch(node) => branch_hashes.get(&node).copied().unwrap_or([0u8; 32]),
-        }
-    }
-
-    fn collect_affected_leaves_for_proof_refresh(&self) -> BTreeSet<LeafId> {
-        let mut affected = BTreeSet::new();
-
-        if self.last_recomputed_branches.is_empty() {
-            return affected;
-        }
-
-        for branch in &self.last_recomputed_branches {
-            self.collect_subtree_leaves(ChildRef::Branch(*branch), &mut affected);
-
-            if let Some(parent) = self.branch_parent.get(branch).copied() {
-                let Some((left, right)) = self.branch_children.get(&parent).copied() else {
-                    continue;
-                };
-                let sibling = if left == ChildRef::Branch(*branch) {
-                    right
-                } else if right == ChildRef::Branch(*branch) {
-                    left
-                } else {
-                    continue;
-                };
-                self.collect_subtree_leaves(sibling, &mut affected);
-            }
-        }
-
-        affected
-    }
-
-    fn collect_subtree_leaves(&self, child: ChildRef, out: &mut BTreeSet<LeafId>) {
-        let mut stack = vec![child];
-        while let Some(current) = stack.pop() {
-            match current {
-                ChildRef::Leaf(leaf) => {
-                    out.insert(leaf);
-                }
-                ChildRef::Branch(branch) => {
-                    if let Some((left, right)) = self.branch_children.get(&branch).copied() {
-                        stack.push(right);
-                        stack.push(left);
-                    }
-                }
-            }
-        }
-    }
-
-    fn compute_merkle_proof_for_leaf(
-        &self,
-        leaf: LeafId,
-        plain_branch_hashes: &BTreeMap<NodeIndex, TreeHash32>,
-    ) -> Vec<Vec<u8>> {
-        let mut path = Vec::new();
-        let mut child_ref = ChildRef::Leaf(leaf);
-        let mut parent = self.leaf_parent.get(&leaf).copied();
-
-        while let Some(branch) = parent {
-            let Some((left, right)) = self.branch_children.get(&branch).copied() else {
-                break;
-            };
-
-            let (sibling_is_left, sibling_ref) = if left == child_ref {
-                (false, right)
-            } else if right == child_ref {
-                (true, left)
-            } else {
-                break;
-            };
-
-            let sibling_hash = self.child_plain_hash(sibling_ref, plain_branch_hashes);
-            path.push(Self::encode_proof_element(sibling_is_left, sibling_hash));
-
-            child_ref = ChildRef::Branch(branch);
-            parent = self.branch_parent.get(&branch).copied();
-        }
-
-        path
-    }
-
     fn encode_proof_element(sibling_is_left: bool, hash: TreeHash32) -> Vec<u8> {
         let mut out = Vec::with_capacity(33);
         out.push(if sibling_is_left { 1 } else { 0 });
@@ -919,7 +722,6 @@ impl AuthorityTreeState {
 
     fn mark_key_derivation_stale(&mut self) {
         // Topology/epoch changes invalidate in-memory derivation artifacts.
-        self.merkle_paths.clear();
         self.merkle_root = [0u8; 32];
     }
 
@@ -976,97 +778,82 @@ impl AuthorityTreeState {
 
     fn assert_topology_invariants(&self) -> Result<(), String> {
         if self.active_leaves.is_empty() {
-            if self.root_branch.is_some() || !self.branches.is_empty() {
+            if !self.topology.is_empty() || !self.branches.is_empty() {
                 return Err("empty tree has unexpected root/branches".to_string());
             }
-            if !self.leaf_parent.is_empty() || !self.branch_children.is_empty() {
+            if self.topology.leaf_parents().next().is_some() {
                 return Err("empty tree has topology edges".to_string());
             }
             return Ok(());
         }
 
-        let Some(root) = self.root_branch else {
+        let Some(root) = self.topology.root() else {
             return Err("non-empty tree missing root branch".to_string());
         };
 
-        if root != NodeIndex(0) {
-            return Err(format!("root must be NodeIndex(0), got {}", root.0));
-        }
-
-        for branch in self.branches.keys() {
-            if *branch != root && !self.branch_parent.contains_key(branch) {
-                return Err(format!("branch {} missing parent", branch.0));
-            }
-            if !self.branch_children.contains_key(branch) {
-                return Err(format!("branch {} missing children", branch.0));
-            }
-            if !self.branch_depth.contains_key(branch) {
-                return Err(format!("branch {} missing depth", branch.0));
-            }
-            if !self.branch_leaf_counts.contains_key(branch) {
-                return Err(format!("branch {} missing leaf-count", branch.0));
-            }
+        if self.branches.len() != self.topology.len() {
+            return Err(format!(
+                "branch map has {} entries but topology has {}",
+                self.branches.len(),
+                self.topology.len()
+            ));
         }
 
-        for leaf in &self.active_leaves {
-            if !self.leaves.contains_key(leaf) {
-                return Err(format!("active leaf {} missing node", leaf.0));
-            }
-            let Some(parent) = self.leaf_parent.get(leaf).copied() else {
-                return Err(format!("leaf {} missing parent", leaf.0));
-            };
-            if !self.branches.contains_key(&parent) {
-                return Err(format!(
-                    "leaf {} parent {} missing branch",
-                    leaf.0, parent.0
-                ));
+        for (node, branch) in self.topology.iter() {
+            if !self.branches.contains_key(&node) {
+                return Err(format!("branch {} missing node", node.0));
             }
-        }
 
-        // Check for cycles / invalid parent pointers.
-        for branch in self.branches.keys() {
-            let mut seen = BTreeSet::new();
-            let mut current = Some(*branch);
-            while let Some(node) = current {
-                if !seen.insert(node) {
-                    return Err(format!("cycle detected from branch {}", branch.0));
+            // Parents precede children, which also rules out cycles.
+            match branch.parent {
+                None if node != root => {
+                    return Err(format!("branch {} missing parent", node.0));
+                }
+                Some(parent) if parent.0 >= node.0 => {
+                    return Err(format!(
+                        "branch {} has parent {} that does not precede it",
+                        node.0, parent.0
+                    ));
+                }
+                Some(parent) => {
+                    let parent_depth = self.topology.get(parent).map(|p| p.depth);
+                    if parent_depth.map(|depth| depth.saturating_add(1)) != Some(branch.depth) {
+                        return Err(format!("branch {} depth mismatch", node.0));
+                    }
                 }
-                current = self.branch_parent.get(&node).copied();
+                None => {}
             }
-        }
 
-        // Check child references.
-        for (branch, (left, right)) in &self.branch_children {
-            for child in [left, right] {
+            for child in [branch.children.0, branch.children.1] {
                 match child {
                     ChildRef::Branch(child_branch) => {
-                        if !self.branches.contains_key(child_branch) {
+                        if self.topology.get(child_branch).is_none() {
                             return Err(format!(
                                 "branch {} references missing child branch {}",
-                                branch.0, child_branch.0
+                                node.0, child_branch.0
                             ));
                         }
-                        let parent = self.branch_parent.get(child_branch).copied();
-                        if parent != Some(*branch) && *child_branch != *branch {
+                        let parent = self.topology.parent(child_branch);
+                        if parent != Some(node) {
                             return Err(format!(
                                 "child branch {} has parent {:?}, expected {}",
                                 child_branch.0,
                                 parent.map(|p| p.0),
-                                branch.0
+                                node.0
                             ));
                         }
                     }
                     ChildRef::Leaf(leaf) => {
-                        if !self.active_leaves.contains(leaf) {
+                        if !self.active_leaves.contains(&leaf) {
                             return Err(format!(
                                 "branch {} references inactive/missing leaf {}",
-                                branch.0, leaf.0
+                                node.0, leaf.0
                             ));
                         }
-                        if self.leaf_parent.get(leaf).copied() != Some(*branch) {
+                        if self.topology.leaf_parent(leaf) != Some(node) {
                             return Err(format!(
                                 "leaf {} parent mismatch: expected {}",
-                                leaf.0, branch.0
+                                leaf.0, node.0
                             ));
                         }
                     }
@@ -1074,6 +861,21 @@ impl AuthorityTreeState {
             }
         }
 
+        for leaf in &self.active_leaves {
+            if !self.leaves.contains_key(leaf) {
+                return Err(format!("active leaf {} missing node", leaf.0));
+            }
+            let Some(parent) = self.topology.leaf_parent(*leaf) else {
+                return Err(format!("leaf {} missing parent", leaf.0));
+            };
+            if self.topology.get(parent).is_none() {
+                return Err(format!(
+                    "leaf {} parent {} missing branch",
+                    leaf.0, parent.0
+                ));
+            }
+        }
+
         Ok(())
     }
 }
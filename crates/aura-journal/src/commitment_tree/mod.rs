@@ -16,6 +16,8 @@
 
 /// Commitment tree application and verification
 pub mod application;
+/// Flat branch arena backing the authority tree topology
+mod arena;
 /// AttestedOp converter for fact-based journal
 pub mod attested_ops;
 /// Authority-internal tree state
@@ -374,12 +374,11 @@ fn compute_branch_commitment(
     policy: &Policy,
 ) -> Result<Hash32, ReductionError> {
     // Get child commitments
-    let children = state.get_children(node);
     let mut child_commitments = Vec::new();
 
     // Collect commitments from child branches
-    for child in &children {
-        if let Some(child_branch) = state.get_branch(child) {
+    for child in state.children(node) {
+        if let Some(child_branch) = state.get_branch(&child) {
             child_commitments.push(child_branch.commitment);
         }
     }
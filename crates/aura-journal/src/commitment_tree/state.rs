@@ -73,10 +73,21 @@ impl TreeTopology {
 
     /// Get children of a node
     pub fn get_children(&self, node: NodeIndex) -> BTreeSet<NodeIndex> {
+        self.children(node).collect()
+    }
+
+    /// Iterate children of a node in index order, without allocating
+    pub fn children(&self, node: NodeIndex) -> impl Iterator<Item = NodeIndex> + '_ {
         self.children_pointers
             .get(&node)
-            .cloned()
-            .unwrap_or_default()
+            .into_iter()
+            .flatten()
+            .copied()
+    }
+
+    /// Get the number of children of a node
+    pub fn child_count(&self, node: NodeIndex) -> usize {
+        self.children_pointers.get(&node).map_or(0, BTreeSet::len)
     }
 
     /// Get parent of a leaf
@@ -86,24 +97,24 @@ impl TreeTopology {
 
     /// Get path from node to root
     pub fn get_path_to_root(&self, start: NodeIndex) -> Vec<NodeIndex> {
-        let mut path = vec![start];
-        let mut current = start;
-
-        while let Some(parent) = self.get_parent(current) {
-            path.push(parent);
-            current = parent;
-        }
-
-        path
+        self.path_to_root(start).collect()
     }
 
     /// Get path from leaf to root
     pub fn get_leaf_path_to_root(&self, leaf_id: LeafId) -> Vec<NodeIndex> {
-        if let Some(parent) = self.get_leaf_parent(leaf_id) {
-            self.get_path_to_root(parent)
-        } else {
-            Vec::new()
-        }
+        self.leaf_path_to_root(leaf_id).collect()
+    }
+
+    /// Iterate from a node up to the root, without allocating
+    pub fn path_to_root(&self, start: NodeIndex) -> impl Iterator<Item = NodeIndex> + '_ {
+        std::iter::successors(Some(start), move |node| self.get_parent(*node))
+    }
+
+    /// Iterate from a leaf's parent up to the root, without allocating
+    pub fn leaf_path_to_root(&self, leaf_id: LeafId) -> impl Iterator<Item = NodeIndex> + '_ {
+        std::iter::successors(self.get_leaf_parent(leaf_id), move |node| {
+            self.get_parent(*node)
+        })
     }
 
     /// Get the root branch node, if one has been materialized.
@@ -236,6 +247,16 @@ impl TreeState {
         self.tree_topology.get_children(node)
     }
 
+    /// Iterate children of a branch node, without allocating
+    pub fn children(&self, node: NodeIndex) -> impl Iterator<Item = NodeIndex> + '_ {
+        self.tree_topology.children(node)
+    }
+
+    /// Get the number of children of a branch node
+    pub fn child_count(&self, node: NodeIndex) -> usize {
+        self.tree_topology.child_count(node)
+    }
+
     /// Get the root branch node, if one exists.
     pub fn root_node(&self) -> Option<NodeIndex> {
         self.tree_topology.root_node()
@@ -256,6 +277,16 @@ impl TreeState {
         self.tree_topology.get_leaf_path_to_root(leaf_id)
     }
 
+    /// Iterate from a node up to the root, without allocating
+    pub fn path_to_root(&self, node: NodeIndex) -> impl Iterator<Item = NodeIndex> + '_ {
+        self.tree_topology.path_to_root(node)
+    }
+
+    /// Iterate from a leaf's parent up to the root, without allocating
+    pub fn leaf_path_to_root(&self, leaf_id: LeafId) -> impl Iterator<Item = NodeIndex> + '_ {
+        self.tree_topology.leaf_path_to_root(leaf_id)
+    }
+
     /// Get all nodes on paths from given nodes to root
     /// This is used for computing affected nodes efficiently
     pub fn get_affected_paths(
@@ -267,12 +298,12 @@ impl TreeState {
 
         // Add paths for branch nodes
         for &node in nodes {
-            affected.extend(self.get_path_to_root(node));
+            affected.extend(self.path_to_root(node));
         }
 
         // Add paths for leaves
         for &leaf in leaves {
-            affected.extend(self.get_leaf_path_to_root(leaf));
+            affected.extend(self.leaf_path_to_root(leaf));
         }
 
         affected
@@ -469,7 +500,7 @@ impl TreeState {
         let policy = self
             .get_policy(index)
             .ok_or(TreeStateError::PolicyNotFound(*index))?;
-        let child_count = self.get_children(*index).len();
+        let child_count = self.child_count(*index);
         let threshold =
             policy
                 .required_signers(child_count)
@@ -495,7 +526,7 @@ impl TreeStateView for TreeState {
     }
 
     fn child_count(&self, node: NodeIndex) -> usize {
-        self.get_children(node).len()
+        TreeState::child_count(self, node)
     }
 
     fn current_epoch(&self) -> Epoch {
@@ -85,7 +85,9 @@ pub use fact::{
     TreeOpKind,
 };
 pub use reduction::{
-    reduce_authority, reduce_context, ChannelEpochState, ReductionNamespaceError, RelationalState,
+    reduce_authority, reduce_context, reduce_context_ref, ChannelEpochState,
+    IncrementalContextReducer, ReductionNamespaceError, RelationalBindingRef,
+    RelationalBindingTypeRef, RelationalState, RelationalStateRef,
 };
 
 /// Primary Journal API
@@ -8,20 +8,27 @@ use crate::fact::{
     AmpTransitionPolicy, AmpTransitionSupersession, AmpTransitionSuppressionScope, AttestedOp,
     CertifiedChannelEpochBump, ChannelBootstrap, ChannelBumpReason, ChannelCheckpoint,
     ChannelPolicy, CommittedChannelEpochBump, FactContent, FinalizedChannelEpochBump, Journal,
-    JournalNamespace, ProposedChannelEpochBump, RelationalFact,
+    JournalNamespace, LeakageFact, ProposedChannelEpochBump, ProtocolRelationalFact,
+    RelationalFact,
 };
 use aura_core::{
     effects::LeakageBudget,
     hash,
+    latency::{self, LatencyStage},
     time::OrderTime,
     tree::{commit_leaf, policy_hash, LeafId, Policy},
     types::authority::TreeStateSummary,
     types::identifiers::{AuthorityId, ChannelId, ContextId},
     Hash32,
 };
+use std::borrow::Cow;
 use std::collections::{BTreeMap, BTreeSet};
 use thiserror::Error;
 
+mod incremental;
+
+pub use incremental::IncrementalContextReducer;
+
 /// Error type for journal namespace mismatches during reduction
 #[derive(Debug, Clone, Error, PartialEq, Eq)]
 pub enum ReductionNamespaceError {
@@ -224,25 +231,63 @@ fn compute_authority_state_hash(state: &aura_core::types::authority::AuthoritySt
 
 /// Compute deterministic hash of relational state
 fn compute_relational_state_hash(state: &RelationalState) -> Hash32 {
+    hash_relational_state(
+        state.bindings.iter().map(|binding| {
+            (
+                binding.context_id,
+                format!("{:?}", binding.binding_type),
+                binding.data.as_slice(),
+            )
+        }),
+        &state.flow_budgets,
+        &state.leakage_budget,
+        &state.channel_epochs,
+        &state.amp_transitions,
+    )
+}
+
+/// Compute deterministic hash of a borrowed relational state
+///
+/// Equal to [`compute_relational_state_hash`] of the owned state.
+fn compute_relational_state_ref_hash(state: &RelationalStateRef<'_>) -> Hash32 {
+    hash_relational_state(
+        state.bindings.iter().map(|binding| {
+            (
+                binding.context_id,
+                format!("{:?}", binding.binding_type),
+                binding.data.as_ref(),
+            )
+        }),
+        &state.flow_budgets,
+        &state.leakage_budget,
+        &state.channel_epochs,
+        &state.amp_transitions,
+    )
+}
+
+fn hash_relational_state<'b>(
+    bindings: impl Iterator<Item = (ContextId, String, &'b [u8])>,
+    flow_budgets: &BTreeMap<(AuthorityId, AuthorityId, u64), u64>,
+    leakage_budget: &LeakageBudget,
+    channel_epochs: &BTreeMap<ChannelId, ChannelEpochState>,
+    amp_transitions: &BTreeMap<AmpTransitionParentKey, AmpTransitionReduction>,
+) -> Hash32 {
     let mut hasher = hash::hasher();
 
-    // Hash bindings (sorted for deterministic order)
+    // Hash bindings (sorted for deterministic order). Each binding type is
+    // formatted once and only references to the payloads are sorted.
     hasher.update(b"BINDINGS");
-    let mut sorted_bindings = state.bindings.clone();
-    sorted_bindings.sort_by(|a, b| {
-        a.context_id
-            .cmp(&b.context_id)
-            .then(format!("{:?}", a.binding_type).cmp(&format!("{:?}", b.binding_type)))
-    });
-    for binding in &sorted_bindings {
-        hasher.update(binding.context_id.0.as_bytes());
-        hasher.update(format!("{:?}", binding.binding_type).as_bytes());
-        hasher.update(&binding.data);
+    let mut sorted_bindings: Vec<_> = bindings.collect();
+    sorted_bindings.sort_by(|a, b| a.0.cmp(&b.0).then_with(|| a.1.cmp(&b.1)));
+    for (context_id, binding_type, data) in &sorted_bindings {
+        hasher.update(context_id.0.as_bytes());
+        hasher.update(binding_type.as_bytes());
+        hasher.update(data);
     }
 
     // Hash flow budgets (sorted for deterministic order)
     hasher.update(b"FLOW_BUDGETS");
-    for ((source, dest, epoch), amount) in &state.flow_budgets {
+    for ((source, dest, epoch), amount) in flow_budgets {
         hasher.update(source.0.as_bytes());
         hasher.update(dest.0.as_bytes());
         hasher.update(&epoch.to_le_bytes());
@@ -251,12 +296,12 @@ fn compute_relational_state_hash(state: &RelationalState) -> Hash32 {
 
     // Hash leakage budgets
     hasher.update(b"LEAKAGE_BUDGET");
-    hasher.update(&state.leakage_budget.external_consumed.to_le_bytes());
-    hasher.update(&state.leakage_budget.neighbor_consumed.to_le_bytes());
-    hasher.update(&state.leakage_budget.in_group_consumed.to_le_bytes());
+    hasher.update(&leakage_budget.external_consumed.to_le_bytes());
+    hasher.update(&leakage_budget.neighbor_consumed.to_le_bytes());
+    hasher.update(&leakage_budget.in_group_consumed.to_le_bytes());
 
     hasher.update(b"CHANNEL_EPOCHS");
-    for (channel_id, epoch_state) in &state.channel_epochs {
+    for (channel_id, epoch_state) in channel_epochs {
         hasher.update(channel_id.as_bytes());
         hasher.update(&epoch_state.chan_epoch.to_le_bytes());
         hasher.update(&epoch_state.last_checkpoint_gen.to_le_bytes());
@@ -280,7 +325,7 @@ fn compute_relational_state_hash(state: &RelationalState) -> Hash32 {
     }
 
     hasher.update(b"AMP_TRANSITIONS");
-    for (parent, transition) in &state.amp_transitions {
+    for (parent, transition) in amp_transitions {
         hasher.update(parent.context.0.as_bytes());
         hasher.update(parent.channel.as_bytes());
         hasher.update(&parent.parent_epoch.to_le_bytes());
@@ -336,6 +381,7 @@ fn compute_relational_state_hash(state: &RelationalState) -> Hash32 {
 pub fn reduce_authority(
     journal: &Journal,
 ) -> Result<aura_core::types::authority::AuthorityState, ReductionNamespaceError> {
+    let _latency = latency::span(LatencyStage::Reduction);
     match &journal.namespace {
         JournalNamespace::Authority(_) => {
             // Extract all attested operations
@@ -606,6 +652,227 @@ pub enum RelationalBindingType {
     Generic(String),
 }
 
+/// Relational binding borrowed from the journal fact it was reduced from.
+///
+/// Generic fact payloads are borrowed rather than copied; protocol binding
+/// keys are derived and therefore owned.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct RelationalBindingRef<'a> {
+    /// Type of binding
+    pub binding_type: RelationalBindingTypeRef<'a>,
+    /// Context this binding belongs to
+    pub context_id: ContextId,
+    /// Binding data
+    pub data: Cow<'a, [u8]>,
+}
+
+impl RelationalBindingRef<'_> {
+    /// Copy the binding out of the journal.
+    pub fn into_owned(self) -> RelationalBinding {
+        RelationalBinding {
+            binding_type: self.binding_type.into_owned(),
+            context_id: self.context_id,
+            data: self.data.into_owned(),
+        }
+    }
+}
+
+/// Borrowed form of [`RelationalBindingType`].
+///
+/// Its `Debug` output matches the owned type, which the relational state
+/// hash relies on.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum RelationalBindingTypeRef<'a> {
+    /// Guardian relationship between two authorities
+    GuardianBinding {
+        /// The primary account authority
+        account_id: AuthorityId,
+        /// The guardian authority
+        guardian_id: AuthorityId,
+    },
+    /// Recovery grant from a guardian to an account
+    RecoveryGrant {
+        /// The account receiving the grant
+        account_id: AuthorityId,
+        /// The guardian issuing the grant
+        guardian_id: AuthorityId,
+    },
+    /// Generic relational binding type
+    Generic(&'a str),
+}
+
+impl RelationalBindingTypeRef<'_> {
+    /// Copy the binding type out of the journal.
+    pub fn into_owned(self) -> RelationalBindingType {
+        match self {
+            Self::GuardianBinding {
+                account_id,
+                guardian_id,
+            } => RelationalBindingType::GuardianBinding {
+                account_id,
+                guardian_id,
+            },
+            Self::RecoveryGrant {
+                account_id,
+                guardian_id,
+            } => RelationalBindingType::RecoveryGrant {
+                account_id,
+                guardian_id,
+            },
+            Self::Generic(sub_type) => RelationalBindingType::Generic(sub_type.to_string()),
+        }
+    }
+}
+
+/// Relational state whose bindings borrow from the reduced journal
+///
+/// Produced by [`reduce_context_ref`]. Reducing a large context this way
+/// does not copy fact payloads; call [`into_owned`](Self::into_owned) only
+/// when the state must outlive the journal.
+#[derive(Debug, Clone)]
+pub struct RelationalStateRef<'a> {
+    /// Active relational bindings
+    pub bindings: Vec<RelationalBindingRef<'a>>,
+    /// Flow budget state by context
+    pub flow_budgets: BTreeMap<(AuthorityId, AuthorityId, u64), u64>,
+    /// Leakage budget totals for this context
+    pub leakage_budget: LeakageBudget,
+    /// AMP channel epoch state keyed by channel id
+    pub channel_epochs: BTreeMap<ChannelId, ChannelEpochState>,
+    /// AMP channel transition reduction keyed by parent prestate
+    pub amp_transitions: BTreeMap<AmpTransitionParentKey, AmpTransitionReduction>,
+}
+
+impl RelationalStateRef<'_> {
+    /// Copy the state out of the journal.
+    pub fn into_owned(self) -> RelationalState {
+        RelationalState {
+            bindings: self
+                .bindings
+                .into_iter()
+                .map(RelationalBindingRef::into_owned)
+                .collect(),
+            flow_budgets: self.flow_budgets,
+            leakage_budget: self.leakage_budget,
+            channel_epochs: self.channel_epochs,
+            amp_transitions: self.amp_transitions,
+        }
+    }
+
+    /// Deterministic hash of the state, equal to the owned state's hash.
+    pub fn state_hash(&self) -> Hash32 {
+        compute_relational_state_ref_hash(self)
+    }
+}
+
+/// One relational fact, classified by how context reduction consumes it.
+///
+/// Shared by [`reduce_context_ref`] and [`IncrementalContextReducer`] so both
+/// paths interpret every fact identically.
+enum ContextFact<'a> {
+    Binding(RelationalBindingRef<'a>),
+    Checkpoint(&'a ChannelCheckpoint),
+    Proposed(&'a ProposedChannelEpochBump),
+    Certified(&'a CertifiedChannelEpochBump),
+    Committed(&'a CommittedChannelEpochBump),
+    Finalized(&'a FinalizedChannelEpochBump),
+    Abort(&'a AmpTransitionAbort),
+    Conflict(&'a AmpTransitionConflict),
+    Supersession(&'a AmpTransitionSupersession),
+    Alarm(&'a AmpEmergencyAlarm),
+    Policy(&'a ChannelPolicy),
+    Bootstrap(&'a ChannelBootstrap),
+    Leakage(&'a LeakageFact),
+}
+
+fn classify_context_fact(context_id: ContextId, rf: &RelationalFact) -> ContextFact<'_> {
+    match rf {
+        RelationalFact::Protocol(protocol) => match protocol {
+            ProtocolRelationalFact::GuardianBinding {
+                account_id,
+                guardian_id,
+                ..
+            } => ContextFact::Binding(RelationalBindingRef {
+                binding_type: RelationalBindingTypeRef::GuardianBinding {
+                    account_id: *account_id,
+                    guardian_id: *guardian_id,
+                },
+                context_id,
+                data: Cow::Owned(protocol.binding_key().data()),
+            }),
+            ProtocolRelationalFact::RecoveryGrant {
+                account_id,
+                guardian_id,
+                ..
+            } => ContextFact::Binding(RelationalBindingRef {
+                binding_type: RelationalBindingTypeRef::RecoveryGrant {
+                    account_id: *account_id,
+                    guardian_id: *guardian_id,
+                },
+                context_id,
+                data: Cow::Owned(protocol.binding_key().data()),
+            }),
+            ProtocolRelationalFact::Consensus { .. }
+            | ProtocolRelationalFact::SessionDelegation(_)
+            | ProtocolRelationalFact::DkgTranscriptCommit(_)
+            | ProtocolRelationalFact::ConvergenceCert(_)
+            | ProtocolRelationalFact::ReversionFact(_)
+            | ProtocolRelationalFact::RotateFact(_) => {
+                let key = protocol.binding_key();
+                ContextFact::Binding(RelationalBindingRef {
+                    binding_type: RelationalBindingTypeRef::Generic(key.sub_type()),
+                    context_id,
+                    data: Cow::Owned(key.data()),
+                })
+            }
+            ProtocolRelationalFact::AmpChannelCheckpoint(cp) => ContextFact::Checkpoint(cp),
+            ProtocolRelationalFact::AmpProposedChannelEpochBump(bump) => {
+                ContextFact::Proposed(bump)
+            }
+            ProtocolRelationalFact::AmpCertifiedChannelEpochBump(bump) => {
+                ContextFact::Certified(bump)
+            }
+            ProtocolRelationalFact::AmpCommittedChannelEpochBump(bump) => {
+                ContextFact::Committed(bump)
+            }
+            ProtocolRelationalFact::AmpFinalizedChannelEpochBump(bump) => {
+                ContextFact::Finalized(bump)
+            }
+            ProtocolRelationalFact::AmpTransitionAbort(abort) => ContextFact::Abort(abort),
+            ProtocolRelationalFact::AmpTransitionConflict(conflict) => {
+                ContextFact::Conflict(conflict)
+            }
+            ProtocolRelationalFact::AmpTransitionSupersession(supersession) => {
+                ContextFact::Supersession(supersession)
+            }
+            ProtocolRelationalFact::AmpEmergencyAlarm(alarm) => ContextFact::Alarm(alarm),
+            ProtocolRelationalFact::AmpChannelPolicy(policy) => ContextFact::Policy(policy),
+            ProtocolRelationalFact::AmpChannelBootstrap(bootstrap) => {
+                ContextFact::Bootstrap(bootstrap)
+            }
+            ProtocolRelationalFact::LeakageEvent(event) => ContextFact::Leakage(event),
+        },
+        // Generic bindings handle all domain-specific facts
+        // (ChatFact, InvitationFact, ContactFact, etc.)
+        // via DomainFact::to_generic()
+        RelationalFact::Generic {
+            context_id: ctx,
+            envelope,
+        } => ContextFact::Binding(RelationalBindingRef {
+            binding_type: RelationalBindingTypeRef::Generic(envelope.type_id.as_str()),
+            context_id: *ctx,
+            data: Cow::Borrowed(&envelope.payload),
+        }),
+    }
+}
+
+fn apply_leakage_event(leakage_budget: &mut LeakageBudget, event: &LeakageFact) {
+    let observer = aura_core::effects::ObserverClass::from(event.observer);
+    let current = leakage_budget.for_observer(observer);
+    let next = current.saturating_add(event.amount);
+    leakage_budget.set_for_observer(observer, next);
+}
+
 /// Reduce a context journal to derive relational state
 ///
 /// This function computes the current relational state by processing
@@ -616,274 +883,146 @@ pub enum RelationalBindingType {
 /// Returns `ReductionNamespaceError::AuthorityAsContext` if the journal
 /// has an Authority namespace instead of a Context namespace.
 pub fn reduce_context(journal: &Journal) -> Result<RelationalState, ReductionNamespaceError> {
+    reduce_context_ref(journal).map(RelationalStateRef::into_owned)
+}
+
+/// Reduce a context journal without copying fact payloads
+///
+/// Bindings borrow their payloads from `journal`, and AMP facts are indexed
+/// by reference while transitions are reduced, so the only allocations are
+/// the derived state itself.
+///
+/// # Errors
+///
+/// Returns `ReductionNamespaceError::AuthorityAsContext` if the journal
+/// has an Authority namespace instead of a Context namespace.
+pub fn reduce_context_ref(
+    journal: &Journal,
+) -> Result<RelationalStateRef<'_>, ReductionNamespaceError> {
+    let _latency = latency::span(LatencyStage::Reduction);
     match &journal.namespace {
         JournalNamespace::Context(context_id) => {
             let mut bindings = Vec::new();
             let flow_budgets = BTreeMap::new();
             let mut leakage_budget = LeakageBudget::zero();
-            let mut channel_checkpoints: BTreeMap<(ChannelId, u64), Vec<ChannelCheckpoint>> =
+            let mut channel_ids = BTreeSet::new();
+            let mut channel_checkpoints: BTreeMap<(ChannelId, u64), &ChannelCheckpoint> =
+                BTreeMap::new();
+            let mut transition_facts: BTreeMap<AmpTransitionParentKey, TransitionFactRefs<'_>> =
                 BTreeMap::new();
-            let mut proposed_bumps = Vec::new();
-            let mut certified_bumps = Vec::new();
-            let mut committed_bumps = Vec::new();
-            let mut finalized_bumps = Vec::new();
-            let mut transition_aborts = Vec::new();
-            let mut transition_conflicts = Vec::new();
-            let mut transition_supersessions = Vec::new();
-            let mut emergency_alarms = Vec::new();
-            let mut channel_policies: BTreeMap<ChannelId, ChannelPolicy> = BTreeMap::new();
-            let mut channel_bootstraps: BTreeMap<ChannelId, ChannelBootstrap> = BTreeMap::new();
+            let mut proposals: BTreeMap<Hash32, &ProposedChannelEpochBump> = BTreeMap::new();
+            let mut policy_skip_windows: BTreeMap<ChannelId, u32> = BTreeMap::new();
+            let mut channel_bootstraps: BTreeMap<ChannelId, &ChannelBootstrap> = BTreeMap::new();
 
             for fact in &journal.facts {
-                if let FactContent::Relational(rf) = &fact.content {
-                    let binding = match rf {
-                        RelationalFact::Protocol(protocol) => match protocol {
-                            crate::fact::ProtocolRelationalFact::GuardianBinding {
-                                account_id,
-                                guardian_id,
-                                ..
-                            } => RelationalBinding {
-                                binding_type: RelationalBindingType::GuardianBinding {
-                                    account_id: *account_id,
-                                    guardian_id: *guardian_id,
-                                },
-                                context_id: *context_id,
-                                data: protocol.binding_key().data(),
-                            },
-                            crate::fact::ProtocolRelationalFact::RecoveryGrant {
-                                account_id,
-                                guardian_id,
-                                ..
-                            } => RelationalBinding {
-                                binding_type: RelationalBindingType::RecoveryGrant {
-                                    account_id: *account_id,
-                                    guardian_id: *guardian_id,
-                                },
-                                context_id: *context_id,
-                                data: protocol.binding_key().data(),
-                            },
-                            crate::fact::ProtocolRelationalFact::Consensus { .. } => {
-                                let key = protocol.binding_key();
-                                RelationalBinding {
-                                    binding_type: RelationalBindingType::Generic(
-                                        key.sub_type().to_string(),
-                                    ),
-                                    context_id: *context_id,
-                                    data: key.data(),
+                let FactContent::Relational(rf) = &fact.content else {
+                    continue;
+                };
+                match classify_context_fact(*context_id, rf) {
+                    ContextFact::Binding(binding) => bindings.push(binding),
+                    ContextFact::Checkpoint(cp) => {
+                        channel_ids.insert(cp.channel);
+                        channel_checkpoints
+                            .entry((cp.channel, cp.chan_epoch))
+                            .and_modify(|current| {
+                                if supersedes_checkpoint(cp, current) {
+                                    *current = cp;
                                 }
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpChannelCheckpoint(cp) => {
-                                channel_checkpoints
-                                    .entry((cp.channel, cp.chan_epoch))
-                                    .or_default()
-                                    .push(cp.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpProposedChannelEpochBump(
-                                bump,
-                            ) => {
-                                proposed_bumps.push(bump.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpCertifiedChannelEpochBump(
-                                bump,
-                            ) => {
-                                certified_bumps.push(bump.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpFinalizedChannelEpochBump(
-                                bump,
-                            ) => {
-                                finalized_bumps.push(bump.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpTransitionAbort(abort) => {
-                                transition_aborts.push(abort.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpTransitionConflict(
-                                conflict,
-                            ) => {
-                                transition_conflicts.push(conflict.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpTransitionSupersession(
-                                supersession,
-                            ) => {
-                                transition_supersessions.push(supersession.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpEmergencyAlarm(alarm) => {
-                                emergency_alarms.push(alarm.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpCommittedChannelEpochBump(
-                                bump,
-                            ) => {
-                                committed_bumps.push(bump.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpChannelPolicy(policy) => {
-                                channel_policies
-                                    .entry(policy.channel)
-                                    .and_modify(|existing| {
-                                        // Prefer policies that specify a skip window override
-                                        if existing.skip_window.is_none()
-                                            && policy.skip_window.is_some()
-                                        {
-                                            *existing = policy.clone();
-                                        }
-                                    })
-                                    .or_insert_with(|| policy.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::AmpChannelBootstrap(bootstrap) => {
-                                channel_bootstraps.insert(bootstrap.channel, bootstrap.clone());
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::LeakageEvent(event) => {
-                                let observer =
-                                    aura_core::effects::ObserverClass::from(event.observer);
-                                let current = leakage_budget.for_observer(observer);
-                                let next = current.saturating_add(event.amount);
-                                leakage_budget.set_for_observer(observer, next);
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::SessionDelegation(_) => {
-                                let key = protocol.binding_key();
-                                bindings.push(RelationalBinding {
-                                    binding_type: RelationalBindingType::Generic(
-                                        key.sub_type().to_string(),
-                                    ),
-                                    context_id: *context_id,
-                                    data: key.data(),
-                                });
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::DkgTranscriptCommit(_) => {
-                                let key = protocol.binding_key();
-                                bindings.push(RelationalBinding {
-                                    binding_type: RelationalBindingType::Generic(
-                                        key.sub_type().to_string(),
-                                    ),
-                                    context_id: *context_id,
-                                    data: key.data(),
-                                });
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::ConvergenceCert(_) => {
-                                let key = protocol.binding_key();
-                                bindings.push(RelationalBinding {
-                                    binding_type: RelationalBindingType::Generic(
-                                        key.sub_type().to_string(),
-                                    ),
-                                    context_id: *context_id,
-                                    data: key.data(),
-                                });
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::ReversionFact(_) => {
-                                let key = protocol.binding_key();
-                                bindings.push(RelationalBinding {
-                                    binding_type: RelationalBindingType::Generic(
-                                        key.sub_type().to_string(),
-                                    ),
-                                    context_id: *context_id,
-                                    data: key.data(),
-                                });
-                                continue;
-                            }
-                            crate::fact::ProtocolRelationalFact::RotateFact(_) => {
-                                let key = protocol.binding_key();
-                                bindings.push(RelationalBinding {
-                                    binding_type: RelationalBindingType::Generic(
-                                        key.sub_type().to_string(),
-                                    ),
-                                    context_id: *context_id,
-                                    data: key.data(),
-                                });
-                                continue;
-                            }
-                        },
-                        // Generic bindings handle all domain-specific facts
-                        // (ChatFact, InvitationFact, ContactFact, etc.)
-                        // via DomainFact::to_generic()
-                        RelationalFact::Generic {
-                            context_id: ctx,
-                            envelope,
-                        } => RelationalBinding {
-                            binding_type: RelationalBindingType::Generic(
-                                envelope.type_id.as_str().to_string(),
-                            ),
-                            context_id: *ctx,
-                            data: envelope.payload.clone(),
-                        },
-                    };
-                    bindings.push(binding);
+                            })
+                            .or_insert(cp);
+                    }
+                    ContextFact::Proposed(bump) => {
+                        channel_ids.insert(bump.channel);
+                        proposals.entry(bump.transition_id).or_insert(bump);
+                        transition_facts
+                            .entry(AmpTransitionParentKey::from(&bump.transition_identity()))
+                            .or_default()
+                            .proposed
+                            .push(bump);
+                    }
+                    ContextFact::Certified(bump) => {
+                        channel_ids.insert(bump.identity.channel);
+                        transition_facts
+                            .entry(AmpTransitionParentKey::from(&bump.identity))
+                            .or_default()
+                            .certified
+                            .push(bump);
+                    }
+                    ContextFact::Committed(bump) => {
+                        channel_ids.insert(bump.channel);
+                        transition_facts
+                            .entry(committed_parent_key(bump))
+                            .or_default()
+                            .committed
+                            .push(bump);
+                    }
+                    ContextFact::Finalized(bump) => {
+                        channel_ids.insert(bump.identity.channel);
+                        transition_facts
+                            .entry(AmpTransitionParentKey::from(&bump.identity))
+                            .or_default()
+                            .finalized
+                            .push(bump);
+                    }
+                    ContextFact::Abort(abort) => transition_facts
+                        .entry(abort_parent_key(abort))
+                        .or_default()
+                        .aborts
+                        .push(abort),
+                    ContextFact::Conflict(conflict) => transition_facts
+                        .entry(conflict_parent_key(conflict))
+                        .or_default()
+                        .conflicts
+                        .push(conflict),
+                    ContextFact::Supersession(supersession) => transition_facts
+                        .entry(supersession_parent_key(supersession))
+                        .or_default()
+                        .supersessions
+                        .push(supersession),
+                    ContextFact::Alarm(alarm) => transition_facts
+                        .entry(alarm_parent_key(alarm))
+                        .or_default()
+                        .alarms
+                        .push(alarm),
+                    ContextFact::Policy(policy) => {
+                        channel_ids.insert(policy.channel);
+                        // Prefer the first policy that specifies a skip window override
+                        if let Some(skip_window) = policy.skip_window {
+                            policy_skip_windows
+                                .entry(policy.channel)
+                                .or_insert(skip_window);
+                        }
+                    }
+                    ContextFact::Bootstrap(bootstrap) => {
+                        channel_ids.insert(bootstrap.channel);
+                        channel_bootstraps.insert(bootstrap.channel, bootstrap);
+                    }
+                    ContextFact::Leakage(event) => apply_leakage_event(&mut leakage_budget, event),
                 }
             }
 
-            let mut channel_epochs = BTreeMap::new();
-            let amp_transitions = reduce_amp_transitions(
-                &proposed_bumps,
-                &certified_bumps,
-                &committed_bumps,
-                &finalized_bumps,
-                &transition_aborts,
-                &transition_conflicts,
-                &transition_supersessions,
-                &emergency_alarms,
-            );
-            let mut channel_ids = BTreeSet::new();
-            channel_ids.extend(channel_checkpoints.keys().map(|(channel, _)| *channel));
-            channel_ids.extend(proposed_bumps.iter().map(|b| b.channel));
-            channel_ids.extend(certified_bumps.iter().map(|b| b.identity.channel));
-            channel_ids.extend(committed_bumps.iter().map(|b| b.channel));
-            channel_ids.extend(finalized_bumps.iter().map(|b| b.identity.channel));
-            channel_ids.extend(channel_policies.keys().copied());
-            channel_ids.extend(channel_bootstraps.keys().copied());
-
-            for channel in channel_ids {
-                let chan_epoch = highest_reduced_epoch(channel, &amp_transitions);
-                // Find the latest checkpoint from any epoch <= current epoch
-                let checkpoint = (0..=chan_epoch)
-                    .rev()
-                    .find_map(|epoch| canonical_checkpoint(channel, epoch, &channel_checkpoints))
-                    .cloned();
-                let last_checkpoint_gen = checkpoint.as_ref().map(|c| c.base_gen).unwrap_or(0);
-                let skip_window = checkpoint
-                    .as_ref()
-                    .and_then(|c| c.skip_window_override)
-                    .or_else(|| channel_policies.get(&channel).and_then(|p| p.skip_window))
-                    .unwrap_or(DEFAULT_SKIP_WINDOW);
-                let current_gen = last_checkpoint_gen;
-                let transition = amp_transitions
-                    .values()
-                    .find(|transition| {
-                        transition.parent.channel == channel
-                            && transition.parent.parent_epoch == chan_epoch
-                    })
-                    .cloned();
-                let pending_bump = transition.as_ref().and_then(|transition| {
-                    select_live_bump_from_transition(transition, &proposed_bumps)
-                });
-                let bootstrap = channel_bootstraps.get(&channel).cloned();
-
-                channel_epochs.insert(
-                    channel,
-                    ChannelEpochState {
-                        chan_epoch,
-                        pending_bump,
-                        bootstrap,
-                        last_checkpoint_gen,
-                        current_gen,
-                        skip_window,
-                        transition,
-                    },
-                );
-            }
+            let amp_transitions: BTreeMap<_, _> = transition_facts
+                .iter()
+                .filter(|(_, facts)| facts.opens_group())
+                .map(|(parent, facts)| (*parent, reduce_amp_transition_group(*parent, facts)))
+                .collect();
 
-            Ok(RelationalState {
+            let channel_epochs = channel_ids
+                .into_iter()
+                .map(|channel| {
+                    let epoch_state = derive_channel_epoch_state(
+                        channel,
+                        &amp_transitions,
+                        |epoch| channel_checkpoints.get(&(channel, epoch)).copied(),
+                        policy_skip_windows.get(&channel).copied(),
+                        channel_bootstraps.get(&channel).copied(),
+                        |transition_id| proposals.get(&transition_id).copied(),
+                    );
+                    (channel, epoch_state)
+                })
+                .collect();
+
+            Ok(RelationalStateRef {
                 bindings,
                 flow_budgets,
                 leakage_budget,
@@ -895,6 +1034,90 @@ pub fn reduce_context(journal: &Journal) -> Result<RelationalState, ReductionNam
     }
 }
 
+/// Transition facts sharing one parent prestate, borrowed in journal order.
+#[derive(Debug, Default)]
+struct TransitionFactRefs<'a> {
+    proposed: Vec<&'a ProposedChannelEpochBump>,
+    certified: Vec<&'a CertifiedChannelEpochBump>,
+    committed: Vec<&'a CommittedChannelEpochBump>,
+    finalized: Vec<&'a FinalizedChannelEpochBump>,
+    aborts: Vec<&'a AmpTransitionAbort>,
+    conflicts: Vec<&'a AmpTransitionConflict>,
+    supersessions: Vec<&'a AmpTransitionSupersession>,
+    alarms: Vec<&'a AmpEmergencyAlarm>,
+}
+
+impl TransitionFactRefs<'_> {
+    /// Whether these facts produce a reduced transition for their parent.
+    fn opens_group(&self) -> bool {
+        self.proposed
+            .iter()
+            .any(|proposal| valid_proposed_bump(proposal))
+            || self.certified.iter().any(|cert| valid_certified_bump(cert))
+            || self.committed.iter().any(|bump| valid_committed_bump(bump))
+            || self
+                .finalized
+                .iter()
+                .any(|commit| valid_finalized_bump(commit))
+            || !self.aborts.is_empty()
+            || !self.conflicts.is_empty()
+            || !self.supersessions.is_empty()
+            || !self.alarms.is_empty()
+    }
+}
+
+/// Whether `candidate` replaces `current` as the canonical checkpoint for its
+/// (channel, epoch)
+///
+/// Select the checkpoint with the highest base_gen; tie-break with commitment
+/// bytes to make ordering deterministic. Exact ties go to the later fact.
+fn supersedes_checkpoint(candidate: &ChannelCheckpoint, current: &ChannelCheckpoint) -> bool {
+    (candidate.base_gen, &candidate.ck_commitment) >= (current.base_gen, &current.ck_commitment)
+}
+
+/// Derive one channel's epoch state from its reduced transitions.
+///
+/// `checkpoint_at` yields the canonical checkpoint for an epoch and
+/// `proposal_for` the proposal that names a transition id, so callers can
+/// back them with whatever index they keep.
+fn derive_channel_epoch_state<'a>(
+    channel: ChannelId,
+    amp_transitions: &BTreeMap<AmpTransitionParentKey, AmpTransitionReduction>,
+    checkpoint_at: impl Fn(u64) -> Option<&'a ChannelCheckpoint>,
+    policy_skip_window: Option<u32>,
+    bootstrap: Option<&ChannelBootstrap>,
+    proposal_for: impl Fn(Hash32) -> Option<&'a ProposedChannelEpochBump>,
+) -> ChannelEpochState {
+    let chan_epoch = highest_reduced_epoch(channel, amp_transitions);
+    // Find the latest checkpoint from any epoch <= current epoch
+    let checkpoint = (0..=chan_epoch).rev().find_map(&checkpoint_at);
+    let last_checkpoint_gen = checkpoint.map(|c| c.base_gen).unwrap_or(0);
+    let skip_window = checkpoint
+        .and_then(|c| c.skip_window_override)
+        .or(policy_skip_window)
+        .unwrap_or(DEFAULT_SKIP_WINDOW);
+    let current_gen = last_checkpoint_gen;
+    let transition = amp_transitions
+        .values()
+        .find(|transition| {
+            transition.parent.channel == channel && transition.parent.parent_epoch == chan_epoch
+        })
+        .cloned();
+    let pending_bump = transition
+        .as_ref()
+        .and_then(|transition| select_live_bump_from_transition(transition, &proposal_for));
+
+    ChannelEpochState {
+        chan_epoch,
+        pending_bump,
+        bootstrap: bootstrap.cloned(),
+        last_checkpoint_gen,
+        current_gen,
+        skip_window,
+        transition,
+    }
+}
+
 fn highest_reduced_epoch(
     channel: ChannelId,
     amp_transitions: &BTreeMap<AmpTransitionParentKey, AmpTransitionReduction>,
@@ -915,135 +1138,36 @@ fn highest_reduced_epoch(
     epoch
 }
 
-fn canonical_checkpoint(
-    channel: ChannelId,
-    epoch: u64,
-    checkpoints: &BTreeMap<(ChannelId, u64), Vec<ChannelCheckpoint>>,
-) -> Option<&ChannelCheckpoint> {
-    // Select the checkpoint with the highest base_gen; tie-break with commitment bytes to make ordering deterministic.
-    checkpoints.get(&(channel, epoch)).and_then(|cps| {
-        cps.iter()
-            .max_by(|a, b| (a.base_gen, &a.ck_commitment).cmp(&(b.base_gen, &b.ck_commitment)))
-    })
-}
-
-fn reduce_amp_transitions(
-    proposed: &[ProposedChannelEpochBump],
-    certified: &[CertifiedChannelEpochBump],
-    committed: &[CommittedChannelEpochBump],
-    finalized: &[FinalizedChannelEpochBump],
-    aborts: &[AmpTransitionAbort],
-    conflicts: &[AmpTransitionConflict],
-    supersessions: &[AmpTransitionSupersession],
-    alarms: &[AmpEmergencyAlarm],
-) -> BTreeMap<AmpTransitionParentKey, AmpTransitionReduction> {
-    let mut groups = BTreeSet::new();
-    for proposal in proposed
-        .iter()
-        .filter(|proposal| valid_proposed_bump(proposal))
-    {
-        groups.insert(AmpTransitionParentKey::from(
-            &proposal.transition_identity(),
-        ));
-    }
-    for cert in certified.iter().filter(|cert| valid_certified_bump(cert)) {
-        groups.insert(AmpTransitionParentKey::from(&cert.identity));
-    }
-    for bump in committed.iter().filter(|bump| valid_committed_bump(bump)) {
-        groups.insert(AmpTransitionParentKey {
-            context: bump.context,
-            channel: bump.channel,
-            parent_epoch: bump.parent_epoch,
-            parent_commitment: bump.parent_commitment,
-        });
-    }
-    for commit in finalized
-        .iter()
-        .filter(|commit| valid_finalized_bump(commit))
-    {
-        groups.insert(AmpTransitionParentKey::from(&commit.identity));
-    }
-    for abort in aborts {
-        groups.insert(AmpTransitionParentKey {
-            context: abort.context,
-            channel: abort.channel,
-            parent_epoch: abort.parent_epoch,
-            parent_commitment: abort.parent_commitment,
-        });
-    }
-    for conflict in conflicts {
-        groups.insert(AmpTransitionParentKey {
-            context: conflict.context,
-            channel: conflict.channel,
-            parent_epoch: conflict.parent_epoch,
-            parent_commitment: conflict.parent_commitment,
-        });
-    }
-    for supersession in supersessions {
-        groups.insert(AmpTransitionParentKey {
-            context: supersession.context,
-            channel: supersession.channel,
-            parent_epoch: supersession.parent_epoch,
-            parent_commitment: supersession.parent_commitment,
-        });
-    }
-    for alarm in alarms {
-        groups.insert(AmpTransitionParentKey {
-            context: alarm.context,
-            channel: alarm.channel,
-            parent_epoch: alarm.parent_epoch,
-            parent_commitment: alarm.parent_commitment,
-        });
-    }
-
-    groups
-        .into_iter()
-        .map(|parent| {
-            let reduction = reduce_amp_transition_group(
-                parent,
-                proposed,
-                certified,
-                committed,
-                finalized,
-                aborts,
-                conflicts,
-                supersessions,
-                alarms,
-            );
-            (parent, reduction)
-        })
-        .collect()
-}
-
 fn reduce_amp_transition_group(
     parent: AmpTransitionParentKey,
-    proposed: &[ProposedChannelEpochBump],
-    certified: &[CertifiedChannelEpochBump],
-    committed: &[CommittedChannelEpochBump],
-    finalized: &[FinalizedChannelEpochBump],
-    aborts: &[AmpTransitionAbort],
-    conflicts: &[AmpTransitionConflict],
-    supersessions: &[AmpTransitionSupersession],
-    alarms: &[AmpEmergencyAlarm],
+    facts: &TransitionFactRefs<'_>,
 ) -> AmpTransitionReduction {
+    let TransitionFactRefs {
+        proposed,
+        certified,
+        committed,
+        finalized,
+        aborts,
+        conflicts,
+        supersessions,
+        alarms,
+    } = facts;
+
     let observed_transition_ids = proposed
         .iter()
         .filter(|proposal| valid_proposed_bump(proposal))
-        .filter(|proposal| AmpTransitionParentKey::from(&proposal.transition_identity()) == parent)
         .map(|proposal| proposal.transition_id)
         .collect::<BTreeSet<_>>();
 
     let mut certified_transition_ids = certified
         .iter()
         .filter(|cert| valid_certified_bump(cert))
-        .filter(|cert| AmpTransitionParentKey::from(&cert.identity) == parent)
         .map(|cert| cert.transition_id)
         .collect::<BTreeSet<_>>();
 
     let mut finalized_transition_ids = finalized
         .iter()
         .filter(|commit| valid_finalized_bump(commit))
-        .filter(|commit| AmpTransitionParentKey::from(&commit.identity) == parent)
         .map(|commit| commit.transition_id)
         .collect::<BTreeSet<_>>();
 
@@ -1051,31 +1175,19 @@ fn reduce_amp_transition_group(
         committed
             .iter()
             .filter(|bump| valid_committed_bump(bump))
-            .filter(|bump| {
-                bump.context == parent.context
-                    && bump.channel == parent.channel
-                    && bump.parent_epoch == parent.parent_epoch
-                    && bump.parent_commitment == parent.parent_commitment
-            })
             .map(|bump| bump.transition_id),
     );
 
     let mut suppressed_a2 = BTreeSet::new();
     let mut suppressed_a3 = BTreeSet::new();
-    for abort in aborts
-        .iter()
-        .filter(|abort| abort_parent_key(abort) == parent)
-    {
+    for abort in aborts {
         suppressed_a2.insert(abort.transition_id);
         if abort.scope == AmpTransitionSuppressionScope::A2AndA3 {
             suppressed_a3.insert(abort.transition_id);
         }
     }
     let mut superseded_any = false;
-    for supersession in supersessions
-        .iter()
-        .filter(|supersession| supersession_parent_key(supersession) == parent)
-    {
+    for supersession in supersessions {
         superseded_any = true;
         suppressed_a2.insert(supersession.superseded_transition_id);
         if supersession.scope == AmpTransitionSuppressionScope::A2AndA3 {
@@ -1091,31 +1203,22 @@ fn reduce_amp_transition_group(
     finalized_transition_ids.retain(|transition_id| !suppressed_a3.contains(transition_id));
 
     let mut conflict_evidence_ids = BTreeSet::new();
-    for conflict in conflicts
-        .iter()
-        .filter(|conflict| conflict_parent_key(conflict) == parent)
-    {
+    for conflict in conflicts {
         conflict_evidence_ids.insert(conflict.evidence_id);
         conflict_evidence_ids.insert(conflict.first_transition_id);
         conflict_evidence_ids.insert(conflict.second_transition_id);
     }
     let emergency_alarm_ids = alarms
         .iter()
-        .filter(|alarm| alarm_parent_key(alarm) == parent)
         .map(|alarm| alarm.evidence_id)
         .collect::<BTreeSet<_>>();
     let mut emergency_suspects = alarms
         .iter()
-        .filter(|alarm| alarm_parent_key(alarm) == parent)
         .map(|alarm| alarm.suspect)
         .collect::<BTreeSet<_>>();
     let mut quarantine_epochs = BTreeSet::new();
     let mut prune_before_epochs = BTreeSet::new();
-    for cert in certified
-        .iter()
-        .filter(|cert| valid_certified_bump(cert))
-        .filter(|cert| AmpTransitionParentKey::from(&cert.identity) == parent)
-    {
+    for cert in certified.iter().filter(|cert| valid_certified_bump(cert)) {
         emergency_suspects.extend(cert.excluded_authorities.iter().copied());
         if cert.identity.transition_policy == AmpTransitionPolicy::EmergencyQuarantineTransition {
             quarantine_epochs.insert(cert.identity.successor_epoch);
@@ -1130,7 +1233,6 @@ fn reduce_amp_transition_group(
     for commit in finalized
         .iter()
         .filter(|commit| valid_finalized_bump(commit))
-        .filter(|commit| AmpTransitionParentKey::from(&commit.identity) == parent)
     {
         emergency_suspects.extend(commit.excluded_authorities.iter().copied());
         if commit.identity.transition_policy == AmpTransitionPolicy::EmergencyQuarantineTransition {
@@ -1195,17 +1297,15 @@ fn reduce_amp_transition_group(
     }
 }
 
-fn select_live_bump_from_transition(
+fn select_live_bump_from_transition<'a>(
     transition: &AmpTransitionReduction,
-    proposed: &[ProposedChannelEpochBump],
+    proposal_for: impl Fn(Hash32) -> Option<&'a ProposedChannelEpochBump>,
 ) -> Option<PendingBump> {
     if transition.status != AmpTransitionReductionStatus::A2Live {
         return None;
     }
     let transition_id = transition.live_transition_id?;
-    let proposal = proposed
-        .iter()
-        .find(|proposal| proposal.transition_id == transition_id);
+    let proposal = proposal_for(transition_id);
 
     Some(PendingBump {
         parent_epoch: transition.parent.parent_epoch,
@@ -1267,6 +1367,15 @@ fn valid_finalized_bump(commit: &FinalizedChannelEpochBump) -> bool {
         && commit.transition_id == commit.identity.transition_id()
 }
 
+fn committed_parent_key(bump: &CommittedChannelEpochBump) -> AmpTransitionParentKey {
+    AmpTransitionParentKey {
+        context: bump.context,
+        channel: bump.channel,
+        parent_epoch: bump.parent_epoch,
+        parent_commitment: bump.parent_commitment,
+    }
+}
+
 fn abort_parent_key(abort: &AmpTransitionAbort) -> AmpTransitionParentKey {
     AmpTransitionParentKey {
         context: abort.context,
@@ -1321,10 +1430,7 @@ pub fn compute_snapshot(
             let state = reduce_authority(journal)?;
             compute_authority_state_hash(&state)
         }
-        JournalNamespace::Context(_) => {
-            let state = reduce_context(journal)?;
-            compute_relational_state_hash(&state)
-        }
+        JournalNamespace::Context(_) => reduce_context_ref(journal)?.state_hash(),
     };
 
     // Identify supersedable facts: everything older than the current snapshot
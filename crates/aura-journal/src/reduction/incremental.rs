@@ -0,0 +1,481 @@
+//! Incremental context reduction
+//!
+//! [`reduce_context`](super::reduce_context) walks the whole fact set and
+//! rebuilds every index on each call, so repeated reads of a growing context
+//! cost `O(journal)`. [`IncrementalContextReducer`] keeps those indexes and
+//! the derived [`RelationalState`] materialized, absorbs only facts it has not
+//! seen, and re-derives only the transition groups and channels the new facts
+//! touch. The resulting state is identical to a full reduction.
+//!
+//! Context journals only grow under join, so the reducer treats an unchanged
+//! fact count as "nothing new". Call [`IncrementalContextReducer::reset`]
+//! after garbage collection or any other operation that removes facts.
+
+use super::{
+    abort_parent_key, alarm_parent_key, apply_leakage_event, classify_context_fact,
+    committed_parent_key, compute_relational_state_hash, conflict_parent_key,
+    derive_channel_epoch_state, reduce_amp_transition_group, supersession_parent_key,
+    AmpTransitionParentKey, ChannelEpochState, ContextFact, ReductionNamespaceError,
+    RelationalState, TransitionFactRefs,
+};
+use crate::fact::{
+    AmpEmergencyAlarm, AmpTransitionAbort, AmpTransitionConflict, AmpTransitionSupersession,
+    CertifiedChannelEpochBump, ChannelBootstrap, ChannelCheckpoint, CommittedChannelEpochBump,
+    Fact, FactContent, FinalizedChannelEpochBump, Journal, JournalNamespace,
+    ProposedChannelEpochBump,
+};
+use aura_core::{
+    effects::LeakageBudget,
+    types::identifiers::{ChannelId, ContextId},
+    Hash32,
+};
+use std::collections::{BTreeMap, BTreeSet};
+
+/// Position of a fact in journal order.
+///
+/// Journal facts sort by `OrderTime` first. `rank` separates facts that share
+/// an order token, in the order the journal holds them, so order-sensitive
+/// selections (first policy, last bootstrap) match a full reduction.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord)]
+struct FactKey {
+    order: [u8; 32],
+    rank: u32,
+}
+
+/// Transition facts sharing one parent prestate.
+#[derive(Debug, Clone, Default)]
+struct TransitionFacts {
+    proposed: Vec<ProposedChannelEpochBump>,
+    certified: Vec<CertifiedChannelEpochBump>,
+    committed: Vec<CommittedChannelEpochBump>,
+    finalized: Vec<FinalizedChannelEpochBump>,
+    aborts: Vec<AmpTransitionAbort>,
+    conflicts: Vec<AmpTransitionConflict>,
+    supersessions: Vec<AmpTransitionSupersession>,
+    alarms: Vec<AmpEmergencyAlarm>,
+}
+
+impl TransitionFacts {
+    /// Borrowed view for group reduction.
+    fn as_refs(&self) -> TransitionFactRefs<'_> {
+        TransitionFactRefs {
+            proposed: self.proposed.iter().collect(),
+            certified: self.certified.iter().collect(),
+            committed: self.committed.iter().collect(),
+            finalized: self.finalized.iter().collect(),
+            aborts: self.aborts.iter().collect(),
+            conflicts: self.conflicts.iter().collect(),
+            supersessions: self.supersessions.iter().collect(),
+            alarms: self.alarms.iter().collect(),
+        }
+    }
+}
+
+/// Context reducer that keeps its derived state across journal growth.
+///
+/// Each read absorbs the facts merged since the previous read and re-derives
+/// only the AMP transition groups and channels they affect, so reads cost
+/// `O(new facts)` rather than `O(journal size)`. The relational state hash is
+/// cached until the state changes.
+#[derive(Debug, Clone)]
+pub struct IncrementalContextReducer {
+    context_id: ContextId,
+    /// Number of absorbed facts per order token
+    orders: BTreeMap<[u8; 32], u32>,
+    absorbed: usize,
+    /// Journal position of each entry in `state.bindings`
+    binding_keys: Vec<FactKey>,
+    /// Canonical checkpoint per (channel, epoch)
+    checkpoints: BTreeMap<(ChannelId, u64), (FactKey, ChannelCheckpoint)>,
+    /// Skip window of the first policy that sets one, per channel
+    policy_skip_windows: BTreeMap<ChannelId, (FactKey, u32)>,
+    /// Last bootstrap per channel
+    bootstraps: BTreeMap<ChannelId, (FactKey, ChannelBootstrap)>,
+    /// First proposal naming each transition id
+    proposals: BTreeMap<Hash32, (FactKey, ProposedChannelEpochBump)>,
+    transitions: BTreeMap<AmpTransitionParentKey, TransitionFacts>,
+    channels: BTreeSet<ChannelId>,
+    dirty_transitions: BTreeSet<AmpTransitionParentKey>,
+    dirty_channels: BTreeSet<ChannelId>,
+    dirty_proposals: BTreeSet<Hash32>,
+    state: RelationalState,
+    state_hash: Option<Hash32>,
+}
+
+impl IncrementalContextReducer {
+    /// Create a reducer for an empty context journal.
+    pub fn new(context_id: ContextId) -> Self {
+        Self {
+            context_id,
+            orders: BTreeMap::new(),
+            absorbed: 0,
+            binding_keys: Vec::new(),
+            checkpoints: BTreeMap::new(),
+            policy_skip_windows: BTreeMap::new(),
+            bootstraps: BTreeMap::new(),
+            proposals: BTreeMap::new(),
+            transitions: BTreeMap::new(),
+            channels: BTreeSet::new(),
+            dirty_transitions: BTreeSet::new(),
+            dirty_channels: BTreeSet::new(),
+            dirty_proposals: BTreeSet::new(),
+            state: RelationalState {
+                bindings: Vec::new(),
+                flow_budgets: BTreeMap::new(),
+                leakage_budget: LeakageBudget::zero(),
+                channel_epochs: BTreeMap::new(),
+                amp_transitions: BTreeMap::new(),
+            },
+            state_hash: None,
+        }
+    }
+
+    /// Create a reducer and absorb an existing context journal.
+    ///
+    /// # Errors
+    ///
+    /// Returns `ReductionNamespaceError::AuthorityAsContext` if the journal
+    /// has an Authority namespace instead of a Context namespace.
+    pub fn from_journal(journal: &Journal) -> Result<Self, ReductionNamespaceError> {
+        let JournalNamespace::Context(context_id) = &journal.namespace else {
+            return Err(ReductionNamespaceError::AuthorityAsContext);
+        };
+        let mut reducer = Self::new(*context_id);
+        reducer.observe(journal)?;
+        Ok(reducer)
+    }
+
+    /// Context this reducer tracks.
+    pub fn context_id(&self) -> ContextId {
+        self.context_id
+    }
+
+    /// Number of journal facts absorbed so far.
+    pub fn fact_count(&self) -> usize {
+        self.absorbed
+    }
+
+    /// Forget all absorbed facts; the next read rebuilds from scratch.
+    pub fn reset(&mut self) {
+        *self = Self::new(self.context_id);
+    }
+
+    /// Current relational state.
+    pub fn state(&self) -> &RelationalState {
+        &self.state
+    }
+
+    /// Current epoch state for one channel.
+    pub fn channel_epoch(&self, channel: &ChannelId) -> Option<&ChannelEpochState> {
+        self.state.channel_epochs.get(channel)
+    }
+
+    /// Consume the reducer, returning its relational state.
+    pub fn into_state(self) -> RelationalState {
+        self.state
+    }
+
+    /// Deterministic hash of the current state, as used by
+    /// [`compute_snapshot`](super::compute_snapshot).
+    ///
+    /// Computed on first use and cached until new facts change the state.
+    pub fn state_hash(&mut self) -> Hash32 {
+        *self
+            .state_hash
+            .get_or_insert_with(|| compute_relational_state_hash(&self.state))
+    }
+
+    /// Bring the reducer up to date with the journal.
+    ///
+    /// An unchanged journal costs `O(1)`. Otherwise the journal is scanned by
+    /// order token and only unseen facts are reduced; callers that know which
+    /// facts were merged should prefer [`apply_facts`](Self::apply_facts).
+    ///
+    /// # Errors
+    ///
+    /// Returns `ReductionNamespaceError::AuthorityAsContext` for an authority
+    /// journal and `ReductionFailure` for a journal of another context.
+    pub fn observe(
+        &mut self,
+        journal: &Journal,
+    ) -> Result<&RelationalState, ReductionNamespaceError> {
+        self.check_namespace(journal)?;
+        self.catch_up(journal);
+        self.refresh();
+        Ok(&self.state)
+    }
+
+    /// Absorb facts that were just merged into `journal`.
+    ///
+    /// Costs `O(facts)`. Facts already absorbed are skipped; a fact whose
+    /// order token collides with an absorbed one falls back to
+    /// [`observe`](Self::observe) so journal order stays exact.
+    ///
+    /// # Errors
+    ///
+    /// Same as [`observe`](Self::observe).
+    pub fn apply_facts<'a, I>(
+        &mut self,
+        journal: &Journal,
+        facts: I,
+    ) -> Result<&RelationalState, ReductionNamespaceError>
+    where
+        I: IntoIterator<Item = &'a Fact>,
+    {
+        self.check_namespace(journal)?;
+        for fact in facts {
+            if self.orders.contains_key(&fact.order.0) {
+                self.catch_up(journal);
+                break;
+            }
+            self.absorb(
+                FactKey {
+                    order: fact.order.0,
+                    rank: 0,
+                },
+                fact,
+            );
+        }
+        self.refresh();
+        Ok(&self.state)
+    }
+
+    fn check_namespace(&self, journal: &Journal) -> Result<(), ReductionNamespaceError> {
+        match &journal.namespace {
+            JournalNamespace::Context(context_id) if *context_id == self.context_id => Ok(()),
+            JournalNamespace::Context(context_id) => {
+                Err(ReductionNamespaceError::ReductionFailure(format!(
+                    "reducer tracks context {} but journal belongs to {context_id}",
+                    self.context_id
+                )))
+            }
+            JournalNamespace::Authority(_) => Err(ReductionNamespaceError::AuthorityAsContext),
+        }
+    }
+
+    /// Absorb every journal fact not yet seen.
+    fn catch_up(&mut self, journal: &Journal) {
+        if journal.facts.len() == self.absorbed {
+            return;
+        }
+
+        // (order token, rank within its run, facts absorbed for that token)
+        let mut run: Option<([u8; 32], u32, u32)> = None;
+        for fact in &journal.facts {
+            let order = fact.order.0;
+            let (rank, known) = match run {
+                Some((previous, rank, known)) if previous == order => (rank + 1, known),
+                _ => (0, self.orders.get(&order).copied().unwrap_or(0)),
+            };
+            run = Some((order, rank, known));
+
+            if known == 0 {
+                self.absorb(FactKey { order, rank }, fact);
+            } else if rank >= known {
+                // A new fact joined an absorbed run; ranks within the run
+                // shifted, so rebuild rather than guess the new positions.
+                self.rebuild(journal);
+                return;
+            }
+        }
+    }
+
+    fn rebuild(&mut self, journal: &Journal) {
+        self.reset();
+        let mut previous: Option<([u8; 32], u32)> = None;
+        for fact in &journal.facts {
+            let order = fact.order.0;
+            let rank = match previous {
+                Some((prev, rank)) if prev == order => rank + 1,
+                _ => 0,
+            };
+            previous = Some((order, rank));
+            self.absorb(FactKey { order, rank }, fact);
+        }
+    }
+
+    fn absorb(&mut self, key: FactKey, fact: &Fact) {
+        *self.orders.entry(key.order).or_default() += 1;
+        self.absorbed += 1;
+
+        let FactContent::Relational(rf) = &fact.content else {
+            return;
+        };
+        self.state_hash = None;
+
+        match classify_context_fact(self.context_id, rf) {
+            ContextFact::Binding(binding) => {
+                let position = self
+                    .binding_keys
+                    .partition_point(|existing| *existing < key);
+                self.binding_keys.insert(position, key);
+                self.state.bindings.insert(position, binding.into_owned());
+            }
+            ContextFact::Checkpoint(cp) => {
+                self.track_channel(cp.channel);
+                let replace = self
+                    .checkpoints
+                    .get(&(cp.channel, cp.chan_epoch))
+                    .is_none_or(|(existing_key, existing)| {
+                        // Same selection as `supersedes_checkpoint`: highest
+                        // base_gen, then commitment, then the later fact.
+                        (cp.base_gen, &cp.ck_commitment, key)
+                            > (existing.base_gen, &existing.ck_commitment, *existing_key)
+                    });
+                if replace {
+                    self.checkpoints
+                        .insert((cp.channel, cp.chan_epoch), (key, cp.clone()));
+                }
+            }
+            ContextFact::Proposed(bump) => {
+                self.track_channel(bump.channel);
+                let replace = self
+                    .proposals
+                    .get(&bump.transition_id)
+                    .is_none_or(|(existing_key, _)| key < *existing_key);
+                if replace {
+                    self.proposals
+                        .insert(bump.transition_id, (key, bump.clone()));
+                    self.dirty_proposals.insert(bump.transition_id);
+                }
+                self.transition_facts(AmpTransitionParentKey::from(&bump.transition_identity()))
+                    .proposed
+                    .push(bump.clone());
+            }
+            ContextFact::Certified(bump) => {
+                self.track_channel(bump.identity.channel);
+                self.transition_facts(AmpTransitionParentKey::from(&bump.identity))
+                    .certified
+                    .push(bump.clone());
+            }
+            ContextFact::Committed(bump) => {
+                self.track_channel(bump.channel);
+                self.transition_facts(committed_parent_key(bump))
+                    .committed
+                    .push(bump.clone());
+            }
+            ContextFact::Finalized(bump) => {
+                self.track_channel(bump.identity.channel);
+                self.transition_facts(AmpTransitionParentKey::from(&bump.identity))
+                    .finalized
+                    .push(bump.clone());
+            }
+            ContextFact::Abort(abort) => {
+                self.transition_facts(abort_parent_key(abort))
+                    .aborts
+                    .push(abort.clone());
+            }
+            ContextFact::Conflict(conflict) => {
+                self.transition_facts(conflict_parent_key(conflict))
+                    .conflicts
+                    .push(conflict.clone());
+            }
+            ContextFact::Supersession(supersession) => {
+                self.transition_facts(supersession_parent_key(supersession))
+                    .supersessions
+                    .push(supersession.clone());
+            }
+            ContextFact::Alarm(alarm) => {
+                self.transition_facts(alarm_parent_key(alarm))
+                    .alarms
+                    .push(alarm.clone());
+            }
+            ContextFact::Policy(policy) => {
+                self.track_channel(policy.channel);
+                if let Some(skip_window) = policy.skip_window {
+                    let replace = self
+                        .policy_skip_windows
+                        .get(&policy.channel)
+                        .is_none_or(|(existing_key, _)| key < *existing_key);
+                    if replace {
+                        self.policy_skip_windows
+                            .insert(policy.channel, (key, skip_window));
+                    }
+                }
+            }
+            ContextFact::Bootstrap(bootstrap) => {
+                self.track_channel(bootstrap.channel);
+                let replace = self
+                    .bootstraps
+                    .get(&bootstrap.channel)
+                    .is_none_or(|(existing_key, _)| key > *existing_key);
+                if replace {
+                    self.bootstraps
+                        .insert(bootstrap.channel, (key, bootstrap.clone()));
+                }
+            }
+            ContextFact::Leakage(event) => {
+                apply_leakage_event(&mut self.state.leakage_budget, event);
+            }
+        }
+    }
+
+    fn track_channel(&mut self, channel: ChannelId) {
+        self.channels.insert(channel);
+        self.dirty_channels.insert(channel);
+    }
+
+    fn transition_facts(&mut self, parent: AmpTransitionParentKey) -> &mut TransitionFacts {
+        self.dirty_transitions.insert(parent);
+        self.transitions.entry(parent).or_default()
+    }
+
+    /// Re-derive the transition groups and channels touched since the last read.
+    fn refresh(&mut self) {
+        for parent in std::mem::take(&mut self.dirty_transitions) {
+            let reduced = self
+                .transitions
+                .get(&parent)
+                .map(TransitionFacts::as_refs)
+                .filter(TransitionFactRefs::opens_group)
+                .map(|facts| reduce_amp_transition_group(parent, &facts));
+            match reduced {
+                Some(reduction) => {
+                    self.state.amp_transitions.insert(parent, reduction);
+                }
+                None => {
+                    self.state.amp_transitions.remove(&parent);
+                }
+            }
+            self.dirty_channels.insert(parent.channel);
+        }
+
+        // A channel's pending bump reads the first proposal naming its live
+        // transition, which may have changed without touching its group.
+        let dirty_proposals = std::mem::take(&mut self.dirty_proposals);
+        if !dirty_proposals.is_empty() {
+            for (channel, epoch_state) in &self.state.channel_epochs {
+                let live = epoch_state
+                    .transition
+                    .as_ref()
+                    .and_then(|transition| transition.live_transition_id);
+                if live.is_some_and(|transition_id| dirty_proposals.contains(&transition_id)) {
+                    self.dirty_channels.insert(*channel);
+                }
+            }
+        }
+
+        for channel in std::mem::take(&mut self.dirty_channels) {
+            if !self.channels.contains(&channel) {
+                continue;
+            }
+            let epoch_state = derive_channel_epoch_state(
+                channel,
+                &self.state.amp_transitions,
+                |epoch| self.checkpoints.get(&(channel, epoch)).map(|(_, cp)| cp),
+                self.policy_skip_windows
+                    .get(&channel)
+                    .map(|(_, skip_window)| *skip_window),
+                self.bootstraps
+                    .get(&channel)
+                    .map(|(_, bootstrap)| bootstrap),
+                |transition_id| {
+                    self.proposals
+                        .get(&transition_id)
+                        .map(|(_, proposal)| proposal)
+                },
+            );
+            self.state.channel_epochs.insert(channel, epoch_state);
+        }
+    }
+}
@@ -215,6 +215,39 @@ fn serialization_roundtrip_preserves_commitment_and_topology() {
     );
 }
 
+#[test]
+fn bulk_add_matches_sequential_add() {
+    let sequential = build_state(37);
+    let mut bulk = AuthorityTreeState::new();
+    let leaves = bulk.add_devices((0..37).map(|i| key_bytes(0xCAFE_BABE, i)));
+
+    assert_eq!(leaves.len(), 37);
+    assert_eq!(bulk.root_commitment, sequential.root_commitment);
+    assert_eq!(bulk.branches, sequential.branches);
+    for leaf in leaves {
+        assert_eq!(bulk.merkle_proof(leaf), sequential.merkle_proof(leaf));
+    }
+}
+
+#[test]
+fn leaf_update_recomputes_only_the_leaf_path() {
+    let mut state = build_state(1000);
+    let target = LeafId(617);
+    let path: Vec<_> = state.leaf_path(target).collect();
+    assert_eq!(path.len(), 10);
+    assert_eq!(path.last().map(|node| node.0), Some(0));
+
+    state
+        .update_leaf_public_key(target, vec![0x5A; 32])
+        .expect("leaf update should succeed");
+    assert_eq!(state.last_recomputed_branch_count(), 10);
+    assert_eq!(
+        state.root_commitment,
+        state.recompute_root_commitment_full()
+    );
+    assert!(state.verify_merkle_proof(LeafId(3)));
+}
+
 #[test]
 fn tree_state_summary_cross_check() {
     let mut state = build_state(7);
@@ -1,20 +1,24 @@
-use aura_core::time::{OrderTime, TimeStamp};
+use aura_core::time::{OrderTime, PhysicalTime, TimeStamp};
+use aura_core::types::facts::FactTypeId;
 use aura_core::types::identifiers::{AuthorityId, ChannelId, ContextId};
 use aura_core::Hash32;
+use aura_journal::extensibility::{FactEncoding, FactEnvelope};
 use aura_journal::fact::{
     AmpEmergencyAlarm, AmpTransitionAbort, AmpTransitionConflict, AmpTransitionIdentity,
     AmpTransitionPolicy, AmpTransitionSupersession, AmpTransitionSuppressionScope,
-    AmpTransitionWitnessSignature, CertifiedChannelEpochBump, ChannelBumpReason, ChannelCheckpoint,
-    FinalizedChannelEpochBump, ProposedChannelEpochBump,
+    AmpTransitionWitnessSignature, CertifiedChannelEpochBump, ChannelBootstrap, ChannelBumpReason,
+    ChannelCheckpoint, ChannelPolicy, FinalizedChannelEpochBump, ProposedChannelEpochBump,
 };
 use aura_journal::reduction::{
     can_prune_checkpoint, can_prune_proposed_bump, compute_checkpoint_pruning_boundary,
-    reduce_authority, reduce_context, AmpTransitionReductionStatus, ReductionNamespaceError,
-    RelationalBindingType,
+    compute_snapshot, reduce_authority, reduce_context, reduce_context_ref,
+    AmpTransitionReductionStatus, IncrementalContextReducer, ReductionNamespaceError,
+    RelationalBindingType, RelationalBindingTypeRef,
 };
 use aura_journal::{
     Fact, FactAttestedOp, FactContent, FactJournal, JournalNamespace, RelationalFact, TreeOpKind,
 };
+use std::borrow::Cow;
 use std::collections::BTreeSet;
 
 #[test]
@@ -708,6 +712,264 @@ fn add_protocol_fact(
     );
 }
 
+fn protocol_fact(order: u8, fact: aura_journal::ProtocolRelationalFact) -> Fact {
+    Fact::new(
+        OrderTime([order; 32]),
+        TimeStamp::OrderClock(OrderTime([order; 32])),
+        FactContent::Relational(RelationalFact::Protocol(fact)),
+    )
+}
+
+/// Mixed context facts listed out of journal order, so appending them one by
+/// one inserts into the middle of the fact set as well as the end.
+fn incremental_fixture(ctx: ContextId, channel: ChannelId) -> Vec<Fact> {
+    use aura_journal::ProtocolRelationalFact as P;
+
+    let proposal = ProposedChannelEpochBump::new(
+        ctx,
+        channel,
+        0,
+        1,
+        Hash32::new([31u8; 32]),
+        ChannelBumpReason::Routine,
+    );
+    let identity = proposal.transition_identity();
+    let bootstrap = |seed: u8| ChannelBootstrap {
+        context: ctx,
+        channel,
+        bootstrap_id: Hash32::new([seed; 32]),
+        dealer: AuthorityId::new_from_entropy([seed; 32]),
+        recipients: vec![],
+        created_at: PhysicalTime {
+            ts_ms: u64::from(seed),
+            uncertainty: None,
+        },
+        expires_at: None,
+    };
+    let checkpoint = |chan_epoch: u64, base_gen: u64| ChannelCheckpoint {
+        context: ctx,
+        channel,
+        chan_epoch,
+        base_gen,
+        window: 1024,
+        ck_commitment: Hash32::new([base_gen as u8; 32]),
+        skip_window_override: None,
+    };
+
+    vec![
+        protocol_fact(
+            50,
+            P::GuardianBinding {
+                account_id: AuthorityId::new_from_entropy([32u8; 32]),
+                guardian_id: AuthorityId::new_from_entropy([33u8; 32]),
+                binding_hash: Hash32::default(),
+            },
+        ),
+        protocol_fact(30, P::AmpChannelCheckpoint(checkpoint(0, 10))),
+        protocol_fact(90, P::AmpProposedChannelEpochBump(proposal.clone())),
+        protocol_fact(
+            70,
+            P::AmpChannelPolicy(ChannelPolicy {
+                context: ctx,
+                channel,
+                skip_window: None,
+            }),
+        ),
+        protocol_fact(
+            110,
+            P::AmpCertifiedChannelEpochBump(certified_bump(identity.clone(), 2, [34u8; 32])),
+        ),
+        protocol_fact(
+            20,
+            P::AmpChannelPolicy(ChannelPolicy {
+                context: ctx,
+                channel,
+                skip_window: Some(64),
+            }),
+        ),
+        protocol_fact(60, P::AmpChannelBootstrap(bootstrap(35))),
+        protocol_fact(
+            40,
+            P::RecoveryGrant {
+                account_id: AuthorityId::new_from_entropy([36u8; 32]),
+                guardian_id: AuthorityId::new_from_entropy([37u8; 32]),
+                grant_hash: Hash32::default(),
+            },
+        ),
+        protocol_fact(10, P::AmpChannelBootstrap(bootstrap(38))),
+        protocol_fact(
+            140,
+            P::AmpFinalizedChannelEpochBump(finalized_bump(identity, [39u8; 32])),
+        ),
+        protocol_fact(130, P::AmpChannelCheckpoint(checkpoint(1, 20))),
+    ]
+}
+
+fn assert_matches_full_reduction(reducer: &mut IncrementalContextReducer, journal: &FactJournal) {
+    let full = reduce_context(journal).unwrap();
+    let incremental = reducer.state();
+
+    assert_eq!(incremental.channel_epochs, full.channel_epochs);
+    assert_eq!(incremental.amp_transitions, full.amp_transitions);
+    assert_eq!(
+        incremental.leakage_budget.external_consumed,
+        full.leakage_budget.external_consumed
+    );
+    assert_eq!(
+        incremental
+            .bindings
+            .iter()
+            .map(|binding| (binding.binding_type.clone(), binding.data.clone()))
+            .collect::<Vec<_>>(),
+        full.bindings
+            .iter()
+            .map(|binding| (binding.binding_type.clone(), binding.data.clone()))
+            .collect::<Vec<_>>()
+    );
+    assert_eq!(reducer.fact_count(), journal.facts.len());
+    assert_eq!(
+        reducer.state_hash(),
+        compute_snapshot(journal, 0).unwrap().0
+    );
+}
+
+#[test]
+fn incremental_context_reducer_matches_full_reduction_as_journal_grows() {
+    let ctx = ContextId::new_from_entropy([30u8; 32]);
+    let channel = ChannelId::from_bytes([30u8; 32]);
+    let mut journal = FactJournal::new(JournalNamespace::Context(ctx));
+    let mut reducer = IncrementalContextReducer::new(ctx);
+
+    for fact in incremental_fixture(ctx, channel) {
+        journal.add_fact(fact).unwrap();
+        reducer.observe(&journal).unwrap();
+        assert_matches_full_reduction(&mut reducer, &journal);
+    }
+
+    let epoch_state = reducer.channel_epoch(&channel).unwrap();
+    assert_eq!(epoch_state.chan_epoch, 1);
+    assert_eq!(epoch_state.last_checkpoint_gen, 20);
+    assert_eq!(epoch_state.skip_window, 64);
+}
+
+#[test]
+fn incremental_context_reducer_applies_merged_facts_only() {
+    let ctx = ContextId::new_from_entropy([41u8; 32]);
+    let channel = ChannelId::from_bytes([41u8; 32]);
+    let facts = incremental_fixture(ctx, channel);
+    let (initial, merged) = facts.split_at(4);
+
+    let mut journal = FactJournal::new(JournalNamespace::Context(ctx));
+    for fact in initial {
+        journal.add_fact(fact.clone()).unwrap();
+    }
+    let mut reducer = IncrementalContextReducer::from_journal(&journal).unwrap();
+    assert_matches_full_reduction(&mut reducer, &journal);
+
+    for fact in merged {
+        journal.add_fact(fact.clone()).unwrap();
+        reducer.apply_facts(&journal, [fact]).unwrap();
+        assert_matches_full_reduction(&mut reducer, &journal);
+    }
+
+    // Re-applying absorbed facts is a no-op.
+    let unchanged = reducer.state_hash();
+    reducer.apply_facts(&journal, &facts).unwrap();
+    assert_eq!(reducer.state_hash(), unchanged);
+    assert_matches_full_reduction(&mut reducer, &journal);
+
+    // A distinct fact sharing an absorbed order token keeps journal order.
+    let colliding = protocol_fact(
+        60,
+        aura_journal::ProtocolRelationalFact::AmpChannelPolicy(ChannelPolicy {
+            context: ctx,
+            channel,
+            skip_window: Some(8),
+        }),
+    );
+    journal.add_fact(colliding.clone()).unwrap();
+    reducer.apply_facts(&journal, [&colliding]).unwrap();
+    assert_matches_full_reduction(&mut reducer, &journal);
+}
+
+#[test]
+fn incremental_context_reducer_rejects_foreign_journals() {
+    let ctx = ContextId::new_from_entropy([42u8; 32]);
+    let other = ContextId::new_from_entropy([43u8; 32]);
+    let mut reducer = IncrementalContextReducer::new(ctx);
+
+    let authority = FactJournal::new(JournalNamespace::Authority(AuthorityId::new_from_entropy(
+        [44u8; 32],
+    )));
+    assert_eq!(
+        reducer.observe(&authority).unwrap_err(),
+        ReductionNamespaceError::AuthorityAsContext
+    );
+    assert!(IncrementalContextReducer::from_journal(&authority).is_err());
+
+    let foreign = FactJournal::new(JournalNamespace::Context(other));
+    assert!(matches!(
+        reducer.observe(&foreign),
+        Err(ReductionNamespaceError::ReductionFailure(_))
+    ));
+}
+
+#[test]
+fn borrowed_context_reduction_matches_owned_without_copying_payloads() {
+    let ctx = ContextId::new_from_entropy([45u8; 32]);
+    let channel = ChannelId::from_bytes([46u8; 32]);
+    let mut journal = FactJournal::new(JournalNamespace::Context(ctx));
+    for fact in incremental_fixture(ctx, channel) {
+        journal.add_fact(fact).unwrap();
+    }
+    journal
+        .add_fact(Fact::new(
+            OrderTime([70u8; 32]),
+            TimeStamp::OrderClock(OrderTime([70u8; 32])),
+            FactContent::Relational(RelationalFact::Generic {
+                context_id: ctx,
+                envelope: FactEnvelope {
+                    type_id: FactTypeId::from("borrowed"),
+                    schema_version: 1,
+                    encoding: FactEncoding::DagCbor,
+                    payload: vec![7u8; 64],
+                },
+            }),
+        ))
+        .unwrap();
+
+    let borrowed = reduce_context_ref(&journal).unwrap();
+    let owned = reduce_context(&journal).unwrap();
+
+    let generic = borrowed
+        .bindings
+        .iter()
+        .find(|binding| binding.binding_type == RelationalBindingTypeRef::Generic("borrowed"))
+        .expect("generic binding");
+    assert!(matches!(generic.data, Cow::Borrowed(_)));
+
+    assert_eq!(
+        borrowed.state_hash(),
+        compute_snapshot(&journal, 0).unwrap().0
+    );
+    assert_eq!(borrowed.channel_epochs, owned.channel_epochs);
+    assert_eq!(borrowed.amp_transitions, owned.amp_transitions);
+    assert_eq!(
+        borrowed
+            .clone()
+            .into_owned()
+            .bindings
+            .into_iter()
+            .map(|binding| (binding.binding_type, binding.data))
+            .collect::<Vec<_>>(),
+        owned
+            .bindings
+            .into_iter()
+            .map(|binding| (binding.binding_type, binding.data))
+            .collect::<Vec<_>>()
+    );
+}
+
 #[test]
 fn checkpoint_pruning_boundary() {
     assert_eq!(compute_checkpoint_pruning_boundary(5000, None), 2440);
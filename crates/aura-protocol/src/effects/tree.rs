@@ -22,6 +22,7 @@
 //! - [`docs/102_authority_and_identity.md`](../../../../docs/102_authority_and_identity.md) - Tree operations
 
 use async_trait::async_trait;
+use aura_core::crypto::Ed25519BatchItem;
 use aura_core::{
     AttestedOp, AuraError, Epoch, Hash32, LeafId, LeafNode, NodeIndex, Policy, TreeOpKind,
 };
@@ -176,6 +177,73 @@ pub trait TreeEffects: Send + Sync {
         state: &TreeState,
     ) -> Result<bool, AuraError>;
 
+    /// Detach the signature check behind [`Self::verify_aggregate_sig`]
+    ///
+    /// Resolves the group key and binding message for `op` against `state`
+    /// without verifying, so a caller walking many ops through evolving
+    /// states can verify them together with
+    /// [`Self::verify_aggregate_sig_batch`]. Threshold and key-resolution
+    /// failures are reported here exactly as `verify_aggregate_sig` would.
+    ///
+    /// ## Returns
+    ///
+    /// - `Ok(Some(check))` with the Ed25519 check for the aggregate signature
+    /// - `Ok(None)` if the handler only supports per-op verification
+    /// - `Err(_)` if verification cannot be performed
+    async fn aggregate_sig_check(
+        &self,
+        op: &AttestedOp,
+        state: &TreeState,
+    ) -> Result<Option<Ed25519BatchItem>, AuraError> {
+        let _ = (op, state);
+        Ok(None)
+    }
+
+    /// Verify checks produced by [`Self::aggregate_sig_check`] as one batch
+    ///
+    /// Returns `Ok(true)` only if every signature is valid; `Ok(false)` does
+    /// not say which failed, so callers re-check items one at a time with
+    /// [`Self::verify_aggregate_sig_check`] to name the offending op.
+    async fn verify_aggregate_sig_batch(
+        &self,
+        checks: &[Ed25519BatchItem],
+    ) -> Result<bool, AuraError> {
+        aura_core::crypto::ed25519_verify_batch(checks)
+    }
+
+    /// Verify one check produced by [`Self::aggregate_sig_check`] on its own
+    ///
+    /// Accepts exactly the signatures [`Self::verify_aggregate_sig`] accepts
+    /// for the op the check was detached from. Use it after a rejected batch
+    /// to find the failing op; a batch of one is not a substitute, since
+    /// batch acceptance only implies single acceptance, not the reverse.
+    ///
+    /// ## Returns
+    ///
+    /// - `Ok(true)` if the signature is valid
+    /// - `Ok(false)` if it is not
+    /// - `Err(_)` if the check's group key is malformed
+    async fn verify_aggregate_sig_check(
+        &self,
+        check: &Ed25519BatchItem,
+    ) -> Result<bool, AuraError> {
+        use aura_core::tree::VerificationError;
+
+        let group_key: [u8; 32] = check
+            .public_key
+            .as_slice()
+            .try_into()
+            .map_err(|_| AuraError::crypto("invalid group key length"))?;
+        match aura_core::tree::verify_frost_signature(&group_key, &check.message, &check.signature)
+        {
+            Ok(()) => Ok(true),
+            Err(VerificationError::SignatureFailed(_)) => Ok(false),
+            Err(error) => Err(AuraError::crypto(format!(
+                "signature verification failed: {error}"
+            ))),
+        }
+    }
+
     // ===== Operation Proposals =====
     //
     // These methods create TreeOpKind proposals that will later be attested
@@ -351,6 +419,28 @@ impl<T: TreeEffects + ?Sized> TreeEffects for std::sync::Arc<T> {
         (**self).verify_aggregate_sig(op, state).await
     }
 
+    async fn aggregate_sig_check(
+        &self,
+        op: &AttestedOp,
+        state: &TreeState,
+    ) -> Result<Option<Ed25519BatchItem>, AuraError> {
+        (**self).aggregate_sig_check(op, state).await
+    }
+
+    async fn verify_aggregate_sig_batch(
+        &self,
+        checks: &[Ed25519BatchItem],
+    ) -> Result<bool, AuraError> {
+        (**self).verify_aggregate_sig_batch(checks).await
+    }
+
+    async fn verify_aggregate_sig_check(
+        &self,
+        check: &Ed25519BatchItem,
+    ) -> Result<bool, AuraError> {
+        (**self).verify_aggregate_sig_check(check).await
+    }
+
     async fn add_leaf(&self, leaf: LeafNode, under: NodeIndex) -> Result<TreeOpKind, AuraError> {
         (**self).add_leaf(leaf, under).await
     }
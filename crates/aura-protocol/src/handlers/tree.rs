@@ -27,8 +27,11 @@
 
 use crate::effects::tree::{Cut, ProposalId, Snapshot, TreeEffects};
 use async_trait::async_trait;
+use aura_core::crypto::Ed25519BatchItem;
 use aura_core::effects::storage::StorageEffects;
-use aura_core::tree::{AttestedOp, LeafId, LeafNode, NodeIndex, Policy, TreeOpKind};
+use aura_core::tree::{
+    AttestedOp, BranchSigningKey, LeafId, LeafNode, NodeIndex, Policy, TreeOpKind,
+};
 use aura_core::util::serialization::to_vec;
 use aura_core::Epoch;
 use aura_core::{hash, AuraError, Hash32};
@@ -302,7 +305,7 @@ fn snapshot_transcript(
         .get_policy(&root_node)
         .copied()
         .ok_or_else(|| AuraError::invalid("Snapshot tree state is missing a root policy"))?;
-    let root_child_count = u32::try_from(snapshot.tree_state.get_children(root_node).len())
+    let root_child_count = u32::try_from(snapshot.tree_state.child_count(root_node))
         .map_err(|_| AuraError::invalid("Snapshot root child count exceeds u32"))?;
     let required_signers = root_policy
         .required_signers(
@@ -419,36 +422,38 @@ impl TreeEffects for PersistentTreeHandler {
         op: &AttestedOp,
         state: &aura_journal::commitment_tree::TreeState,
     ) -> Result<bool, AuraError> {
-        use aura_core::tree::verification::extract_target_node;
-
-        let target_node = extract_target_node(&op.op.op).or_else(|| match &op.op.op {
-            TreeOpKind::RemoveLeaf { leaf, .. } => state.get_remove_leaf_affected_parent(leaf),
-            _ => None,
-        });
-
-        let node = target_node.ok_or_else(|| {
-            AuraError::invalid("Unable to resolve signing node for attested operation")
-        })?;
-
-        let signing_key = state.signing_keys().get(&node).ok_or_else(|| {
-            AuraError::invalid(format!("Missing signing key for branch {}", node.0))
-        })?;
-        let policy = state
-            .get_policy(&node)
-            .ok_or_else(|| AuraError::invalid(format!("Missing policy for branch {}", node.0)))?;
-        let child_count = state.get_children(node).len();
-        let threshold = policy.required_signers(child_count).map_err(|e| {
-            AuraError::invalid(format!(
-                "Invalid policy for branch {} (child_count={}): {e}",
-                node.0, child_count
-            ))
-        })?;
-
+        let (signing_key, threshold) = signing_key_for(op, state)?;
         aura_core::tree::verify_attested_op(op, signing_key, threshold, state.epoch)
             .map(|_| true)
             .map_err(|e| AuraError::crypto(format!("signature verification failed: {e}")))
     }
 
+    async fn aggregate_sig_check(
+        &self,
+        op: &AttestedOp,
+        state: &aura_journal::commitment_tree::TreeState,
+    ) -> Result<Option<Ed25519BatchItem>, AuraError> {
+        use aura_core::tree::verification::{compute_binding_message, VerificationError};
+
+        let (signing_key, threshold) = signing_key_for(op, state)?;
+        if op.signer_count < threshold {
+            let error = VerificationError::InsufficientSigners {
+                required: threshold,
+                provided: op.signer_count,
+            };
+            return Err(AuraError::crypto(format!(
+                "signature verification failed: {error}"
+            )));
+        }
+
+        let group_key = signing_key.group_key();
+        Ok(Some(Ed25519BatchItem::new(
+            compute_binding_message(op, state.epoch, group_key),
+            op.agg_sig.clone(),
+            group_key.to_vec(),
+        )))
+    }
+
     async fn add_leaf(&self, leaf: LeafNode, under: NodeIndex) -> Result<TreeOpKind, AuraError> {
         Ok(TreeOpKind::AddLeaf { leaf, under })
     }
@@ -510,6 +515,40 @@ impl TreeEffects for PersistentTreeHandler {
     }
 }
 
+/// Resolve the branch signing key and threshold that must authorize `op`.
+fn signing_key_for<'a>(
+    op: &AttestedOp,
+    state: &'a aura_journal::commitment_tree::TreeState,
+) -> Result<(&'a BranchSigningKey, u16), AuraError> {
+    use aura_core::tree::verification::extract_target_node;
+
+    let target_node = extract_target_node(&op.op.op).or_else(|| match &op.op.op {
+        TreeOpKind::RemoveLeaf { leaf, .. } => state.get_remove_leaf_affected_parent(leaf),
+        _ => None,
+    });
+
+    let node = target_node.ok_or_else(|| {
+        AuraError::invalid("Unable to resolve signing node for attested operation")
+    })?;
+
+    let signing_key = state
+        .signing_keys()
+        .get(&node)
+        .ok_or_else(|| AuraError::invalid(format!("Missing signing key for branch {}", node.0)))?;
+    let policy = state
+        .get_policy(&node)
+        .ok_or_else(|| AuraError::invalid(format!("Missing policy for branch {}", node.0)))?;
+    let child_count = state.child_count(node);
+    let threshold = policy.required_signers(child_count).map_err(|e| {
+        AuraError::invalid(format!(
+            "Invalid policy for branch {} (child_count={}): {e}",
+            node.0, child_count
+        ))
+    })?;
+
+    Ok((signing_key, threshold))
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -1,7 +1,7 @@
 //! Canonical, domain-separated signing transcripts.
 
 use crate::{AuthenticationError, Result};
-use aura_core::effects::CryptoEffects;
+use aura_core::effects::{CryptoEffects, Ed25519BatchItem};
 use aura_core::threshold::{ApprovalContext, SignableOperation, SigningContext};
 use aura_core::util::serialization;
 use aura_core::AuthorityId;
@@ -157,6 +157,48 @@ where
         })
 }
 
+/// Batch-verify Ed25519 signatures and locate the first invalid one.
+///
+/// Runs a single [`CryptoCoreEffects::ed25519_verify_batch`] call for the
+/// common all-valid case. Batch implementations accept only items that
+/// single verification also accepts, so this is a fast path, not a weaker
+/// check. If the batch is rejected, items are re-checked one at a time so the
+/// caller can name the offending item; errors from that pass surface exactly
+/// as sequential verification would report them.
+///
+/// Returns `Ok(None)` when every signature is valid and `Ok(Some(index))` for
+/// the first one that is not.
+///
+/// [`CryptoCoreEffects::ed25519_verify_batch`]: aura_core::effects::CryptoCoreEffects::ed25519_verify_batch
+pub async fn first_invalid_ed25519_signature<E>(
+    crypto: &E,
+    items: &[Ed25519BatchItem],
+) -> Result<Option<usize>>
+where
+    E: CryptoEffects + Send + Sync + ?Sized,
+{
+    if items.is_empty() {
+        return Ok(None);
+    }
+    // A malformed item fails the whole batch; the per-item pass attributes it
+    if let Ok(true) = crypto.ed25519_verify_batch(items).await {
+        return Ok(None);
+    }
+
+    for (index, item) in items.iter().enumerate() {
+        let valid = crypto
+            .ed25519_verify(&item.message, &item.signature, &item.public_key)
+            .await
+            .map_err(|error| AuthenticationError::CryptoError {
+                details: format!("Ed25519 verification of batch item {index} failed: {error}"),
+            })?;
+        if !valid {
+            return Ok(Some(index));
+        }
+    }
+    Ok(None)
+}
+
 /// Verify a FROST aggregate signature over a typed transcript.
 pub async fn verify_frost_transcript<E, T>(
     crypto: &E,
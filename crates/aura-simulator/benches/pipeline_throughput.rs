@@ -0,0 +1,113 @@
+#![allow(clippy::expect_used, clippy::disallowed_methods)]
+#![allow(missing_docs)]
+//! End-to-end message pipeline throughput across group and journal sizes.
+//!
+//! Each scenario builds a `PipelineHarness` (N simulation agents on a shared
+//! transport), records a fixed-size run into a `PipelineBaselineV1`, then lets
+//! criterion time individual messages through send → guards → journal couple →
+//! transport → receive → decrypt → view update.
+//!
+//! The baseline is written to `$AURA_PIPELINE_BASELINE` (default:
+//! `<target>/tmp/pipeline_baseline.json`). Set `AURA_PIPELINE_COMPARE` to an
+//! earlier baseline to print every scenario metric and stage p99 that got
+//! worse by more than `AURA_PIPELINE_TOLERANCE` (default `0.1`).
+
+use aura_core::latency::LatencyRecorder;
+use aura_effects::time::MonotonicLatencyClock;
+use aura_simulator::{PipelineBaselineV1, PipelineHarness, PipelineScenario};
+use criterion::{criterion_group, criterion_main, BenchmarkId, Criterion, Throughput};
+use std::path::PathBuf;
+use std::sync::Arc;
+use std::time::Duration;
+
+const SEED: u64 = 0x5eed_0030;
+const BASELINE_MESSAGES: usize = 50;
+
+fn baseline_path() -> PathBuf {
+    std::env::var_os("AURA_PIPELINE_BASELINE")
+        .map(PathBuf::from)
+        .unwrap_or_else(|| {
+            PathBuf::from(env!("CARGO_TARGET_TMPDIR")).join("pipeline_baseline.json")
+        })
+}
+
+fn report_regressions(candidate: &PipelineBaselineV1) {
+    let Some(previous) = std::env::var_os("AURA_PIPELINE_COMPARE").map(PathBuf::from) else {
+        return;
+    };
+    let tolerance = std::env::var("AURA_PIPELINE_TOLERANCE")
+        .ok()
+        .and_then(|value| value.parse::<f64>().ok())
+        .unwrap_or(0.1);
+    let previous = PipelineBaselineV1::load(&previous).expect("load comparison baseline");
+    let regressions = previous.regressions(candidate, tolerance);
+    if regressions.is_empty() {
+        eprintln!("pipeline_throughput: no regressions beyond {tolerance}");
+    }
+    for regression in regressions {
+        eprintln!(
+            "pipeline_throughput regression {} {}: {:.1} -> {:.1} ({:.2}x)",
+            regression.scenario,
+            regression.metric,
+            regression.baseline,
+            regression.candidate,
+            regression.ratio
+        );
+    }
+}
+
+fn bench_pipeline(c: &mut Criterion) {
+    let clock = Arc::new(MonotonicLatencyClock::new());
+    let runtime = tokio::runtime::Builder::new_multi_thread()
+        .enable_all()
+        .build()
+        .expect("tokio runtime");
+    let storage = tempfile::tempdir().expect("agent storage");
+    let mut baseline = PipelineBaselineV1::new(SEED);
+
+    let mut group = c.benchmark_group("pipeline_throughput");
+    group.sample_size(10);
+    group.measurement_time(Duration::from_secs(10));
+    group.throughput(Throughput::Elements(1));
+
+    for scenario in PipelineScenario::matrix() {
+        let mut harness = runtime
+            .block_on(PipelineHarness::new(
+                scenario,
+                SEED,
+                storage.path().join(scenario.label().replace('/', "_")),
+            ))
+            .expect("build pipeline harness")
+            .with_latency_recorder(Arc::new(LatencyRecorder::new(clock.clone())));
+
+        let report = runtime
+            .block_on(harness.run(BASELINE_MESSAGES))
+            .expect("baseline run");
+        baseline.record(&report);
+
+        let id = BenchmarkId::new(
+            format!("group_{}", scenario.group_size),
+            format!("journal_{}", scenario.journal_facts),
+        );
+        group.bench_function(id, |b| {
+            b.iter_custom(|iters| {
+                let report = runtime
+                    .block_on(harness.run(iters as usize))
+                    .expect("pipeline run");
+                report.elapsed
+            });
+        });
+    }
+    group.finish();
+
+    let path = baseline_path();
+    baseline.write(&path).expect("write pipeline baseline");
+    eprintln!(
+        "pipeline_throughput: baseline written to {}",
+        path.display()
+    );
+    report_regressions(&baseline);
+}
+
+criterion_group!(benches, bench_pipeline);
+criterion_main!(benches);
@@ -227,6 +227,10 @@ impl CryptoCoreEffects for SimulationEffectSystem {
             .await
     }
 
+    async fn ed25519_verify_batch(&self, items: &[Ed25519BatchItem]) -> Result<bool, CryptoError> {
+        self.crypto.ed25519_verify_batch(items).await
+    }
+
     fn is_simulated(&self) -> bool {
         true
     }
@@ -103,6 +103,16 @@ impl Default for SimulationTimeHandler {
     }
 }
 
+/// Latency spans measured against simulated time.
+///
+/// Spans only grow when the simulator advances its clock, so recorded
+/// histograms are identical across replays of the same seed.
+impl aura_core::latency::LatencyClock for SimulationTimeHandler {
+    fn now_nanos(&self) -> u64 {
+        self.timestamp_ms().saturating_mul(1_000_000)
+    }
+}
+
 #[async_trait]
 impl PhysicalTimeEffects for SimulationTimeHandler {
     async fn physical_time(&self) -> Result<PhysicalTime, TimeError> {
@@ -116,6 +116,8 @@ pub mod handlers;
 pub mod differential_tester;
 pub mod experiments;
 pub mod liveness;
+/// End-to-end AMP message pipeline throughput harness.
+pub mod pipeline_throughput;
 /// Online property definitions for simulator monitoring.
 pub mod properties;
 /// Per-tick property monitor runtime.
@@ -223,6 +225,10 @@ pub use liveness::{
     check_consensus_terminates_within, consensus_liveness_checker, BoundedLivenessChecker,
     BoundedLivenessProperty, LivenessCheckResult, SynchronyAssumption,
 };
+pub use pipeline_throughput::{
+    PipelineBaselineV1, PipelineHarness, PipelineRegression, PipelineRunReport, PipelineScenario,
+    PipelineScenarioBaseline, PipelineStageBaseline, AURA_PIPELINE_BASELINE_SCHEMA_V1,
+};
 pub use properties::{
     default_property_suite, AuraProperty, GuardStage, PropertyContext, PropertyEvent,
     PropertyStateSnapshot, ProtocolPropertyClass, ProtocolPropertySuiteIds,
@@ -0,0 +1,700 @@
+//! End-to-end AMP message pipeline throughput harness.
+//!
+//! Drives a group of simulation agents on one [`SharedTransport`] through the
+//! path a chat message takes in production: `ChatServiceApi::send_message`,
+//! the `amp_send` AEAD path (reduce-before-send, guard chain, journal
+//! coupling, broadcast), delivery, and `ChatServiceApi::ingest_sealed_message`
+//! on every receiver (decrypt + view update).
+//!
+//! A run reports messages/sec and end-to-end latency quantiles alongside the
+//! per-stage histograms collected by [`aura_core::latency`] over the same
+//! window. [`PipelineBaselineV1`] is the compact machine-readable form that
+//! benches write out and compare against, so a regression in one stage shows
+//! up as a number instead of a vague slowdown.
+
+use crate::experiments::{write_experiment_artifact, AuraExperimentError};
+use crate::quint::amp_channel_handlers::{authority_from_label, build_agent};
+use aura_agent::handlers::{ChatGroupId, ChatServiceApi};
+use aura_agent::{AuraAgent, AuraEffectSystem, SharedTransport};
+use aura_amp::AmpJournalEffects;
+use aura_core::effects::time::PhysicalTimeEffects;
+use aura_core::effects::transport::TransportError;
+use aura_core::effects::{
+    AmpChannelEffects, ChannelCreateParams, ChannelJoinParams, ChannelSendParams,
+    SecureStorageCapability, SecureStorageEffects, SecureStorageLocation, TransportEffects,
+};
+use aura_core::hash::hash;
+use aura_core::latency::{self, LatencyHistogram, LatencyRecorder, LatencySnapshot};
+use aura_core::types::facts::{FactEncoding, FactEnvelope, FactTypeId};
+use aura_core::types::identifiers::{AuthorityId, ChannelId, ContextId};
+use aura_core::{AuraError, Hash32, Result};
+use aura_effects::time::monotonic_now;
+use aura_journal::fact::{ChannelBootstrap, ProtocolRelationalFact, RelationalFact};
+use futures::future::try_join_all;
+use serde::{Deserialize, Serialize};
+use std::collections::BTreeMap;
+use std::path::{Path, PathBuf};
+use std::sync::Arc;
+use std::time::Duration;
+use uuid::Uuid;
+
+/// Schema identifier for [`PipelineBaselineV1`] artifacts.
+pub const AURA_PIPELINE_BASELINE_SCHEMA_V1: &str = "aura.simulator.pipeline-baseline.v1";
+
+const AMP_MESSAGE_CONTENT_TYPE: &str = "application/aura-amp";
+const FILLER_FACT_TYPE_ID: &str = "pipeline-filler/v1";
+const FILLER_BATCH: usize = 256;
+const RECEIVE_ATTEMPTS: usize = 1024;
+
+/// One point in the throughput matrix.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord, Hash, Serialize, Deserialize)]
+pub struct PipelineScenario {
+    /// Number of agents in the chat group (one sender, the rest receive).
+    pub group_size: usize,
+    /// Filler facts committed to the group context on every node before the
+    /// run, so reduce-before-send scales with journal size.
+    pub journal_facts: usize,
+}
+
+impl PipelineScenario {
+    /// Group sizes covered by [`Self::matrix`].
+    pub const GROUP_SIZES: [usize; 3] = [2, 10, 100];
+    /// Journal sizes covered by [`Self::matrix`].
+    pub const JOURNAL_SIZES: [usize; 2] = [0, 1_000];
+
+    /// Create a scenario.
+    pub const fn new(group_size: usize, journal_facts: usize) -> Self {
+        Self {
+            group_size,
+            journal_facts,
+        }
+    }
+
+    /// Full group-size × journal-size matrix.
+    pub fn matrix() -> Vec<Self> {
+        Self::GROUP_SIZES
+            .iter()
+            .flat_map(|&group_size| {
+                Self::JOURNAL_SIZES
+                    .iter()
+                    .map(move |&journal_facts| Self::new(group_size, journal_facts))
+            })
+            .collect()
+    }
+
+    /// Stable label used for bench ids and regression reports.
+    pub fn label(&self) -> String {
+        format!("group={}/journal={}", self.group_size, self.journal_facts)
+    }
+}
+
+struct PipelineNode {
+    // Held so the agent's runtime outlives the run.
+    _agent: Arc<AuraAgent>,
+    authority: AuthorityId,
+    effects: Arc<AuraEffectSystem>,
+    chat: ChatServiceApi,
+}
+
+impl PipelineNode {
+    async fn join_group(
+        &self,
+        context: ContextId,
+        channel: ChannelId,
+        bootstrap: &ChannelBootstrap,
+        key: &[u8],
+    ) -> Result<()> {
+        self.effects
+            .create_channel(ChannelCreateParams {
+                context,
+                channel: Some(channel),
+                skip_window: None,
+                topic: None,
+            })
+            .await
+            .map_err(|e| AuraError::invalid(format!("create channel failed: {e}")))?;
+        self.effects
+            .join_channel(ChannelJoinParams {
+                context,
+                channel,
+                participant: self.authority,
+            })
+            .await
+            .map_err(|e| AuraError::invalid(format!("join channel failed: {e}")))?;
+
+        let location =
+            SecureStorageLocation::amp_bootstrap_key(&context, &channel, &bootstrap.bootstrap_id);
+        self.effects
+            .secure_store(
+                &location,
+                key,
+                &[
+                    SecureStorageCapability::Read,
+                    SecureStorageCapability::Write,
+                ],
+            )
+            .await
+            .map_err(|e| AuraError::internal(format!("bootstrap key write failed: {e}")))?;
+        self.effects
+            .insert_relational_fact(RelationalFact::Protocol(
+                ProtocolRelationalFact::AmpChannelBootstrap(bootstrap.clone()),
+            ))
+            .await
+            .map_err(|e| AuraError::internal(format!("bootstrap fact insert failed: {e}")))?;
+
+        Ok(())
+    }
+
+    async fn prefill_journal(&self, context: ContextId, facts: usize) -> Result<()> {
+        let mut next = 0u64;
+        let mut remaining = facts;
+        while remaining > 0 {
+            let batch = remaining.min(FILLER_BATCH);
+            let filler = (0..batch)
+                .map(|_| {
+                    next += 1;
+                    RelationalFact::Generic {
+                        context_id: context,
+                        envelope: FactEnvelope {
+                            type_id: FactTypeId::new(FILLER_FACT_TYPE_ID),
+                            schema_version: 1,
+                            encoding: FactEncoding::DagCbor,
+                            payload: next.to_le_bytes().to_vec(),
+                        },
+                    }
+                })
+                .collect();
+            self.effects.commit_relational_facts(filler).await?;
+            remaining -= batch;
+        }
+        Ok(())
+    }
+
+    async fn now_ms(&self) -> Result<u64> {
+        self.effects
+            .physical_time()
+            .await
+            .map(|now| now.ts_ms)
+            .map_err(|e| AuraError::internal(format!("time read failed: {e}")))
+    }
+
+    /// Drain this node's inbox up to the next AMP envelope and ingest it.
+    async fn deliver(
+        &self,
+        group_id: &ChatGroupId,
+        sender: AuthorityId,
+        message_id: &str,
+        sent_at_ms: u64,
+    ) -> Result<()> {
+        for _ in 0..RECEIVE_ATTEMPTS {
+            match self.effects.receive_envelope().await {
+                Ok(envelope) => {
+                    let content_type = envelope.metadata.get("content-type");
+                    if envelope.source != sender
+                        || !content_type.is_some_and(|ct| ct == AMP_MESSAGE_CONTENT_TYPE)
+                    {
+                        continue;
+                    }
+                    return self
+                        .chat
+                        .ingest_sealed_message(
+                            group_id,
+                            sender,
+                            message_id.to_string(),
+                            envelope.payload,
+                            sent_at_ms,
+                        )
+                        .await
+                        .map_err(|e| AuraError::internal(format!("ingest message failed: {e}")));
+                }
+                Err(TransportError::NoMessage) => tokio::task::yield_now().await,
+                Err(e) => return Err(AuraError::internal(format!("receive failed: {e}"))),
+            }
+        }
+        Err(AuraError::not_found(format!(
+            "AMP envelope from {sender} not delivered to {}",
+            self.authority
+        )))
+    }
+}
+
+/// Multi-node chat group wired for end-to-end throughput runs.
+pub struct PipelineHarness {
+    scenario: PipelineScenario,
+    group_id: ChatGroupId,
+    context: ContextId,
+    channel: ChannelId,
+    nodes: Vec<PipelineNode>,
+    sent: usize,
+    recorder: Option<Arc<LatencyRecorder>>,
+}
+
+impl PipelineHarness {
+    /// Build `scenario.group_size` agents, bootstrap a shared AMP channel on
+    /// each and prefill their journals.
+    pub async fn new(scenario: PipelineScenario, seed: u64, base_path: PathBuf) -> Result<Self> {
+        if scenario.group_size < 2 {
+            return Err(AuraError::invalid(
+                "pipeline group needs at least two members",
+            ));
+        }
+
+        let shared_transport = SharedTransport::new();
+        let mut nodes = Vec::with_capacity(scenario.group_size);
+        for index in 0..scenario.group_size {
+            let label = format!("pipeline-{index}");
+            let authority = authority_from_label(&label);
+            let agent = build_agent(
+                seed.wrapping_add(index as u64),
+                &label,
+                authority,
+                base_path.join(&label),
+                shared_transport.clone(),
+            )
+            .await?;
+            let chat = agent
+                .chat()
+                .map_err(|e| AuraError::internal(format!("chat service unavailable: {e}")))?;
+            nodes.push(PipelineNode {
+                authority,
+                effects: agent.runtime().effects(),
+                chat,
+                _agent: agent,
+            });
+        }
+
+        let group_seed = hash(format!("pipeline-group:{seed}").as_bytes());
+        let mut group_bytes = [0u8; 16];
+        group_bytes.copy_from_slice(&group_seed[..16]);
+        let group_id = ChatGroupId::from_uuid(Uuid::from_bytes(group_bytes));
+        let context = ChatServiceApi::context_id_for_group(&group_id);
+        let channel = ChatServiceApi::channel_id_for_group(&group_id);
+
+        let key = hash(format!("pipeline-bootstrap:{seed}").as_bytes());
+        let bootstrap = ChannelBootstrap {
+            context,
+            channel,
+            bootstrap_id: Hash32::from_bytes(&key),
+            dealer: nodes[0].authority,
+            recipients: nodes.iter().map(|node| node.authority).collect(),
+            created_at: nodes[0]
+                .effects
+                .physical_time()
+                .await
+                .map_err(|e| AuraError::internal(format!("time read failed: {e}")))?,
+            expires_at: None,
+        };
+        for node in &nodes {
+            node.join_group(context, channel, &bootstrap, &key).await?;
+            node.prefill_journal(context, scenario.journal_facts)
+                .await?;
+        }
+
+        Ok(Self {
+            scenario,
+            group_id,
+            context,
+            channel,
+            nodes,
+            sent: 0,
+            recorder: None,
+        })
+    }
+
+    /// Record stage latencies of this harness's runs into `recorder` instead
+    /// of the process-wide one, so concurrent runs do not mix histograms.
+    pub fn with_latency_recorder(mut self, recorder: Arc<LatencyRecorder>) -> Self {
+        self.recorder = Some(recorder);
+        self
+    }
+
+    /// Snapshot of the recorder this harness reports stages from.
+    fn stage_snapshot(&self) -> LatencySnapshot {
+        match &self.recorder {
+            Some(recorder) => recorder.snapshot(),
+            None => latency::global()
+                .map(|recorder| recorder.snapshot())
+                .unwrap_or_default(),
+        }
+    }
+
+    /// Scenario this harness was built for.
+    pub fn scenario(&self) -> PipelineScenario {
+        self.scenario
+    }
+
+    /// Send one message from the next sender in rotation and wait until every
+    /// other member has ingested it. Returns the end-to-end latency.
+    pub async fn send_one(&mut self) -> Result<Duration> {
+        let index = self.sent;
+        let sender = &self.nodes[index % self.nodes.len()];
+        let content = format!("pipeline message {index}");
+
+        let started = monotonic_now();
+        let message = sender
+            .chat
+            .send_message(&self.group_id, sender.authority, content.clone())
+            .await
+            .map_err(|e| AuraError::internal(format!("chat send failed: {e}")))?;
+        sender
+            .effects
+            .send_message(ChannelSendParams {
+                context: self.context,
+                channel: self.channel,
+                sender: sender.authority,
+                plaintext: content.into_bytes(),
+                reply_to: None,
+            })
+            .await
+            .map_err(|e| AuraError::internal(format!("amp send failed: {e}")))?;
+
+        let message_id = message.id.0.to_string();
+        let sent_at_ms = sender.now_ms().await?;
+        try_join_all(
+            self.nodes
+                .iter()
+                .filter(|node| node.authority != sender.authority)
+                .map(|node| {
+                    node.deliver(&self.group_id, sender.authority, &message_id, sent_at_ms)
+                }),
+        )
+        .await?;
+        let elapsed = started.elapsed();
+
+        self.sent += 1;
+        Ok(elapsed)
+    }
+
+    async fn send_many(&mut self, messages: usize) -> Result<LatencyHistogram> {
+        let mut latency = LatencyHistogram::default();
+        for _ in 0..messages {
+            let elapsed = self.send_one().await?;
+            latency.record(u64::try_from(elapsed.as_nanos()).unwrap_or(u64::MAX));
+        }
+        Ok(latency)
+    }
+
+    /// Push `messages` through the pipeline and report throughput, latency
+    /// and the stage histograms recorded during the run.
+    pub async fn run(&mut self, messages: usize) -> Result<PipelineRunReport> {
+        let stages_before = self.stage_snapshot();
+        let started = monotonic_now();
+        let latency = match self.recorder.clone() {
+            Some(recorder) => latency::scope(recorder, self.send_many(messages)).await?,
+            None => self.send_many(messages).await?,
+        };
+        let elapsed = started.elapsed();
+
+        let stages = self.stage_snapshot().since(&stages_before);
+        Ok(PipelineRunReport {
+            scenario: self.scenario,
+            messages,
+            elapsed,
+            latency,
+            stages,
+        })
+    }
+}
+
+/// Result of one [`PipelineHarness::run`].
+#[derive(Debug, Clone)]
+pub struct PipelineRunReport {
+    /// Scenario measured.
+    pub scenario: PipelineScenario,
+    /// Messages delivered to every receiver.
+    pub messages: usize,
+    /// Wall-clock duration of the run.
+    pub elapsed: Duration,
+    /// End-to-end latency per message, send call to last receiver view update.
+    pub latency: LatencyHistogram,
+    /// Stage histograms recorded during the run; empty when the harness has
+    /// no recorder and no global latency recorder is installed.
+    pub stages: LatencySnapshot,
+}
+
+impl PipelineRunReport {
+    /// Delivered messages per second.
+    pub fn messages_per_sec(&self) -> f64 {
+        let secs = self.elapsed.as_secs_f64();
+        if secs > 0.0 {
+            self.messages as f64 / secs
+        } else {
+            0.0
+        }
+    }
+}
+
+/// Per-stage latency summary in a baseline.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
+pub struct PipelineStageBaseline {
+    /// Samples recorded for the stage during the run.
+    pub count: u64,
+    /// Median stage latency in nanoseconds.
+    pub p50_ns: u64,
+    /// 99th percentile stage latency in nanoseconds.
+    pub p99_ns: u64,
+}
+
+/// Baseline numbers for one scenario.
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+pub struct PipelineScenarioBaseline {
+    /// Group size measured.
+    pub group_size: usize,
+    /// Journal prefill measured.
+    pub journal_facts: usize,
+    /// Messages in the measured run.
+    pub messages: usize,
+    /// Delivered messages per second.
+    pub messages_per_sec: f64,
+    /// Median end-to-end latency in microseconds.
+    pub latency_p50_us: u64,
+    /// 99th percentile end-to-end latency in microseconds.
+    pub latency_p99_us: u64,
+    /// Stage summaries keyed by stage name.
+    pub stages: BTreeMap<String, PipelineStageBaseline>,
+}
+
+impl PipelineScenarioBaseline {
+    /// Summarize a run report.
+    pub fn from_report(report: &PipelineRunReport) -> Self {
+        Self {
+            group_size: report.scenario.group_size,
+            journal_facts: report.scenario.journal_facts,
+            messages: report.messages,
+            messages_per_sec: report.messages_per_sec(),
+            latency_p50_us: report.latency.quantile(0.5) / 1_000,
+            latency_p99_us: report.latency.quantile(0.99) / 1_000,
+            stages: report
+                .stages
+                .stages
+                .iter()
+                .map(|(stage, histogram)| {
+                    (
+                        stage.name().to_string(),
+                        PipelineStageBaseline {
+                            count: histogram.count,
+                            p50_ns: histogram.quantile(0.5),
+                            p99_ns: histogram.quantile(0.99),
+                        },
+                    )
+                })
+                .collect(),
+        }
+    }
+
+    /// Scenario this entry describes.
+    pub fn scenario(&self) -> PipelineScenario {
+        PipelineScenario::new(self.group_size, self.journal_facts)
+    }
+}
+
+/// Machine-readable pipeline throughput baseline.
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+pub struct PipelineBaselineV1 {
+    /// Always [`AURA_PIPELINE_BASELINE_SCHEMA_V1`].
+    pub schema_version: String,
+    /// Seed the harnesses were built with.
+    pub seed: u64,
+    /// One entry per measured scenario.
+    pub scenarios: Vec<PipelineScenarioBaseline>,
+}
+
+/// One metric that got worse than the baseline allows.
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+pub struct PipelineRegression {
+    /// Scenario label (see [`PipelineScenario::label`]).
+    pub scenario: String,
+    /// Metric name: `messages_per_sec`, `latency_p50_us`, `latency_p99_us`
+    /// or `stage.<name>.p99_ns`.
+    pub metric: String,
+    /// Baseline value.
+    pub baseline: f64,
+    /// Candidate value.
+    pub candidate: f64,
+    /// How many times worse the candidate is (always > 1 + tolerance).
+    pub ratio: f64,
+}
+
+impl PipelineBaselineV1 {
+    /// Create an empty baseline.
+    pub fn new(seed: u64) -> Self {
+        Self {
+            schema_version: AURA_PIPELINE_BASELINE_SCHEMA_V1.to_string(),
+            seed,
+            scenarios: Vec::new(),
+        }
+    }
+
+    /// Record a run, replacing any earlier entry for the same scenario.
+    pub fn record(&mut self, report: &PipelineRunReport) {
+        self.scenarios
+            .retain(|entry| entry.scenario() != report.scenario);
+        self.scenarios
+            .push(PipelineScenarioBaseline::from_report(report));
+        self.scenarios
+            .sort_by_key(PipelineScenarioBaseline::scenario);
+    }
+
+    /// Write the baseline as pretty JSON.
+    pub fn write(&self, path: &Path) -> std::result::Result<(), AuraExperimentError> {
+        write_experiment_artifact(path, self)
+    }
+
+    /// Load a baseline written by [`Self::write`].
+    pub fn load(path: &Path) -> std::result::Result<Self, AuraExperimentError> {
+        let bytes = std::fs::read(path).map_err(|error| {
+            AuraExperimentError::Run(format!(
+                "failed reading pipeline baseline {}: {error}",
+                path.display()
+            ))
+        })?;
+        let baseline: Self =
+            serde_json::from_slice(&bytes).map_err(|error| AuraExperimentError::Serialize {
+                message: error.to_string(),
+            })?;
+        if baseline.schema_version != AURA_PIPELINE_BASELINE_SCHEMA_V1 {
+            return Err(AuraExperimentError::Run(format!(
+                "unsupported pipeline baseline schema {}",
+                baseline.schema_version
+            )));
+        }
+        Ok(baseline)
+    }
+
+    /// Metrics in `candidate` more than `tolerance` (e.g. `0.1` for 10%)
+    /// worse than this baseline. Scenarios or stages missing on either side
+    /// are skipped.
+    pub fn regressions(&self, candidate: &Self, tolerance: f64) -> Vec<PipelineRegression> {
+        let limit = 1.0 + tolerance;
+        let mut regressions = Vec::new();
+        for base in &self.scenarios {
+            let Some(cand) = candidate
+                .scenarios
+                .iter()
+                .find(|entry| entry.scenario() == base.scenario())
+            else {
+                continue;
+            };
+            let label = base.scenario().label();
+            let mut check = |metric: String, baseline: f64, candidate: f64, ratio: f64| {
+                if ratio > limit {
+                    regressions.push(PipelineRegression {
+                        scenario: label.clone(),
+                        metric,
+                        baseline,
+                        candidate,
+                        ratio,
+                    });
+                }
+            };
+
+            check(
+                "messages_per_sec".to_string(),
+                base.messages_per_sec,
+                cand.messages_per_sec,
+                slowdown(cand.messages_per_sec, base.messages_per_sec),
+            );
+            check(
+                "latency_p50_us".to_string(),
+                base.latency_p50_us as f64,
+                cand.latency_p50_us as f64,
+                slowdown(base.latency_p50_us as f64, cand.latency_p50_us as f64),
+            );
+            check(
+                "latency_p99_us".to_string(),
+                base.latency_p99_us as f64,
+                cand.latency_p99_us as f64,
+                slowdown(base.latency_p99_us as f64, cand.latency_p99_us as f64),
+            );
+            for (stage, base_stage) in &base.stages {
+                let Some(cand_stage) = cand.stages.get(stage) else {
+                    continue;
+                };
+                check(
+                    format!("stage.{stage}.p99_ns"),
+                    base_stage.p99_ns as f64,
+                    cand_stage.p99_ns as f64,
+                    slowdown(base_stage.p99_ns as f64, cand_stage.p99_ns as f64),
+                );
+            }
+        }
+        regressions
+    }
+}
+
+/// `worse / better`, treating a zero `better` as "no signal".
+fn slowdown(better: f64, worse: f64) -> f64 {
+    if better > 0.0 {
+        worse / better
+    } else {
+        1.0
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use aura_core::latency::LatencyStage;
+
+    fn report(group_size: usize, per_message_us: u64, stage_ns: u64) -> PipelineRunReport {
+        let mut latency = LatencyHistogram::default();
+        let mut stage = LatencyHistogram::default();
+        for _ in 0..100 {
+            latency.record(per_message_us * 1_000);
+            stage.record(stage_ns);
+        }
+        let mut stages = LatencySnapshot::default();
+        stages
+            .stages
+            .insert(LatencyStage::GuardAuthorization, stage);
+        PipelineRunReport {
+            scenario: PipelineScenario::new(group_size, 0),
+            messages: 100,
+            elapsed: Duration::from_micros(per_message_us * 100),
+            latency,
+            stages,
+        }
+    }
+
+    #[test]
+    fn matrix_covers_every_group_and_journal_size() {
+        let matrix = PipelineScenario::matrix();
+        assert_eq!(
+            matrix.len(),
+            PipelineScenario::GROUP_SIZES.len() * PipelineScenario::JOURNAL_SIZES.len()
+        );
+        assert!(matrix.contains(&PipelineScenario::new(100, 1_000)));
+        assert_eq!(matrix[0].label(), "group=2/journal=0");
+    }
+
+    #[test]
+    fn baseline_flags_slower_scenarios_and_stages() {
+        let mut baseline = PipelineBaselineV1::new(7);
+        baseline.record(&report(2, 100, 5_000));
+        baseline.record(&report(10, 100, 5_000));
+
+        let mut candidate = PipelineBaselineV1::new(7);
+        candidate.record(&report(2, 100, 5_000));
+        candidate.record(&report(10, 200, 20_000));
+
+        assert!(baseline.regressions(&baseline, 0.1).is_empty());
+        let regressions = baseline.regressions(&candidate, 0.1);
+        assert!(regressions
+            .iter()
+            .all(|regression| regression.scenario == "group=10/journal=0"));
+        let metrics: Vec<_> = regressions.iter().map(|r| r.metric.as_str()).collect();
+        assert!(metrics.contains(&"messages_per_sec"));
+        assert!(metrics.contains(&"latency_p99_us"));
+        assert!(metrics.contains(&"stage.guard.authorization.p99_ns"));
+    }
+
+    #[test]
+    fn baseline_round_trips_through_disk() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let path = dir.path().join("pipeline_baseline.json");
+        let mut baseline = PipelineBaselineV1::new(3);
+        baseline.record(&report(2, 50, 1_000));
+        baseline.write(&path).expect("write baseline");
+        assert_eq!(PipelineBaselineV1::load(&path).expect("load"), baseline);
+    }
+}
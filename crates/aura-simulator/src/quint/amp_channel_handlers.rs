@@ -782,7 +782,7 @@ fn normalize_name(name: &str) -> String {
     name.trim().to_lowercase()
 }
 
-fn authority_from_label(label: &str) -> AuthorityId {
+pub(crate) fn authority_from_label(label: &str) -> AuthorityId {
     let material = format!("amp-harness:{label}:authority");
     AuthorityId::new_from_entropy(hash(material.as_bytes()))
 }
@@ -796,7 +796,7 @@ fn channel_id_from_input(input: &str) -> ChannelId {
     ChannelId::from_str(input).unwrap_or_else(|_| ChannelId::from_bytes(hash(input.as_bytes())))
 }
 
-async fn build_agent(
+pub(crate) async fn build_agent(
     seed: u64,
     label: &str,
     authority: AuthorityId,
@@ -29,7 +29,8 @@ use std::sync::{Arc, Mutex};
 
 use super::action_registry::ActionRegistry;
 use super::aura_state_extractors::QuintSimulationState;
-use super::itf_fuzzer::ITFTrace;
+use super::itf_fuzzer::{ITFState, ITFTrace};
+use super::itf_stream::ITFStateStream;
 use aura_core::effects::ActionResult;
 
 // =============================================================================
@@ -242,6 +243,44 @@ impl RandomCoreEffects for SeededRandomProvider {
 // Generative Simulator
 // =============================================================================
 
+/// Replay state shared by in-memory and streaming trace replay
+struct ReplayProgress {
+    current_state: QuintSimulationState,
+    steps: Vec<SimulationStep>,
+    property_violations: Vec<PropertyViolation>,
+}
+
+impl ReplayProgress {
+    fn new(initial_state: QuintSimulationState) -> Self {
+        Self {
+            current_state: initial_state,
+            steps: Vec::new(),
+            property_violations: Vec::new(),
+        }
+    }
+
+    fn completed(self) -> SimulationResult {
+        SimulationResult {
+            step_count: self.steps.len() as u32,
+            steps: self.steps,
+            final_state: self.current_state,
+            success: true,
+            property_violations: self.property_violations,
+        }
+    }
+
+    /// Result of a replay stopped by the failed action at `index`
+    fn failed(self, index: usize) -> SimulationResult {
+        SimulationResult {
+            steps: self.steps,
+            final_state: self.current_state,
+            success: false,
+            step_count: index as u32,
+            property_violations: self.property_violations,
+        }
+    }
+}
+
 /// Generative simulator that drives Aura effects from Quint specifications
 ///
 /// This is the main orchestrator for generative simulations, providing:
@@ -287,9 +326,7 @@ impl GenerativeSimulator {
         trace: &ITFTrace,
         initial_state: QuintSimulationState,
     ) -> Result<SimulationResult> {
-        let mut current_state = initial_state;
-        let mut steps = Vec::new();
-        let mut property_violations = Vec::new();
+        let mut progress = ReplayProgress::new(initial_state);
 
         if self.config.verbose {
             tracing::info!("Replaying ITF trace with {} states", trace.states.len());
@@ -300,92 +337,126 @@ impl GenerativeSimulator {
             if index == 0 {
                 continue;
             }
-
-            // Extract action and nondet picks
-            let mut action_name = itf_state.action_taken.clone();
-            if action_name
-                .as_deref()
-                .is_some_and(|name| name == "init" || name == "step")
-                || action_name.is_none()
-            {
-                if let Some(Value::String(name)) = itf_state.variables.get("action_name") {
-                    action_name = Some(name.clone());
-                }
+            if !self.replay_state(index, itf_state, &mut progress).await? {
+                return Ok(progress.failed(index));
             }
+        }
 
-            let action_name = action_name
-                .as_ref()
-                .ok_or_else(|| aura_core::AuraError::invalid("ITF state missing action_taken"))?;
-
-            let nondet_picks = itf_state.nondet_picks.clone().unwrap_or_default();
-
-            // Get action parameters from state variables
-            let params = self.extract_action_params(&itf_state.variables);
+        Ok(progress.completed())
+    }
 
-            // Record pre-state
-            let pre_state = current_state.to_quint();
+    /// Replay ITF states as a streaming parser decodes them
+    ///
+    /// Each state is dropped once its action ran, so memory stays bounded by
+    /// the stream capacity however long the trace is, provided
+    /// `record_trace` is off (recorded steps keep their pre and post states).
+    /// Decoding and validation errors surface after the last decoded state.
+    pub async fn replay_stream(
+        &self,
+        mut stream: ITFStateStream,
+        initial_state: QuintSimulationState,
+    ) -> Result<SimulationResult> {
+        let mut progress = ReplayProgress::new(initial_state);
 
-            // Execute action
-            let result = self
-                .execute_action(action_name, &params, &nondet_picks, &current_state)
-                .await;
+        let mut index = 0;
+        while let Some(itf_state) = stream.next_state().await {
+            if index > 0 && !self.replay_state(index, &itf_state, &mut progress).await? {
+                // Dropping the stream stops the parser
+                return Ok(progress.failed(index));
+            }
+            index += 1;
+        }
 
-            match result {
-                Ok((_action_result, new_state)) => {
-                    let post_state = new_state.to_quint();
+        let summary = stream
+            .finish()
+            .await
+            .map_err(|e| aura_core::AuraError::invalid(format!("ITF stream failed: {e}")))?;
+        if self.config.verbose {
+            tracing::info!(
+                "Replayed streamed ITF trace with {} states",
+                summary.state_count
+            );
+        }
+        Ok(progress.completed())
+    }
 
-                    if self.config.record_trace {
-                        steps.push(SimulationStep {
-                            index: index as u64,
-                            action: action_name.clone(),
-                            params: params.clone(),
-                            nondet_picks: nondet_picks.clone(),
-                            pre_state,
-                            post_state: post_state.clone(),
-                            success: true,
-                            error: None,
-                        });
-                    }
+    /// Execute the action of one ITF state; returns false if it failed
+    async fn replay_state(
+        &self,
+        index: usize,
+        itf_state: &ITFState,
+        progress: &mut ReplayProgress,
+    ) -> Result<bool> {
+        // Extract action and nondet picks
+        let mut action_name = itf_state.action_taken.clone();
+        if action_name
+            .as_deref()
+            .is_some_and(|name| name == "init" || name == "step")
+            || action_name.is_none()
+        {
+            if let Some(Value::String(name)) = itf_state.variables.get("action_name") {
+                action_name = Some(name.clone());
+            }
+        }
 
-                    // Check for property violations
-                    if let Some(violation) = self.check_step_properties(index as u32, &post_state) {
-                        property_violations.push(violation);
-                    }
+        let action_name = action_name
+            .as_ref()
+            .ok_or_else(|| aura_core::AuraError::invalid("ITF state missing action_taken"))?;
+
+        let nondet_picks = itf_state.nondet_picks.clone().unwrap_or_default();
+
+        // Get action parameters from state variables
+        let params = self.extract_action_params(&itf_state.variables);
+
+        // Record pre-state
+        let pre_state = progress.current_state.to_quint();
+
+        // Execute action
+        let result = self
+            .execute_action(action_name, &params, &nondet_picks, &progress.current_state)
+            .await;
+
+        match result {
+            Ok((_action_result, new_state)) => {
+                let post_state = new_state.to_quint();
+
+                if self.config.record_trace {
+                    progress.steps.push(SimulationStep {
+                        index: index as u64,
+                        action: action_name.clone(),
+                        params: params.clone(),
+                        nondet_picks: nondet_picks.clone(),
+                        pre_state,
+                        post_state: post_state.clone(),
+                        success: true,
+                        error: None,
+                    });
+                }
 
-                    current_state = new_state;
+                // Check for property violations
+                if let Some(violation) = self.check_step_properties(index as u32, &post_state) {
+                    progress.property_violations.push(violation);
                 }
-                Err(e) => {
-                    if self.config.record_trace {
-                        steps.push(SimulationStep {
-                            index: index as u64,
-                            action: action_name.clone(),
-                            params: params.clone(),
-                            nondet_picks: nondet_picks.clone(),
-                            pre_state,
-                            post_state: Value::Null,
-                            success: false,
-                            error: Some(e.to_string()),
-                        });
-                    }
 
-                    return Ok(SimulationResult {
-                        steps,
-                        final_state: current_state,
+                progress.current_state = new_state;
+                Ok(true)
+            }
+            Err(e) => {
+                if self.config.record_trace {
+                    progress.steps.push(SimulationStep {
+                        index: index as u64,
+                        action: action_name.clone(),
+                        params: params.clone(),
+                        nondet_picks: nondet_picks.clone(),
+                        pre_state,
+                        post_state: Value::Null,
                         success: false,
-                        step_count: index as u32,
-                        property_violations,
+                        error: Some(e.to_string()),
                     });
                 }
+                Ok(false)
             }
         }
-
-        Ok(SimulationResult {
-            step_count: steps.len() as u32,
-            steps,
-            final_state: current_state,
-            success: true,
-            property_violations,
-        })
     }
 
     // =========================================================================
@@ -6,12 +6,14 @@
 
 use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
+use std::io::Read;
 use std::path::{Path, PathBuf};
 use std::sync::Arc;
 
 use super::action_registry::ActionRegistry;
 use super::aura_state_extractors::QuintSimulationState;
 use super::generative_simulator::{GenerativeSimulator, GenerativeSimulatorConfig, SimulationStep};
+use super::itf_stream::ITFStateStream;
 use super::trace_converter::{ExecutionTrace, QuintTrace, TraceConversionConfig, TraceConverter};
 use super::{ChaosGenerator, QuintCliRunner};
 use crate::quint::simulation_evaluator::SimulationPropertyEvaluator;
@@ -319,6 +321,9 @@ impl ITFBasedFuzzer {
     }
 
     /// Parse ITF trace from file
+    ///
+    /// Loads the whole trace; use [`Self::replay_itf_stream_with_effects`] to
+    /// replay large traces state by state.
     pub async fn parse_itf_file(&self, path: &Path) -> Result<ITFTrace, ITFFuzzError> {
         let content = self.read_path_to_string(path).await?;
         self.parse_itf_trace(&content)
@@ -594,6 +599,44 @@ impl ITFBasedFuzzer {
         })
     }
 
+    /// Replay an ITF trace through real effect handlers as it is parsed
+    ///
+    /// Like [`Self::replay_trace_with_effects`], but states are decoded from
+    /// `reader` on a blocking thread and executed as they arrive, so at most
+    /// `capacity` states are buffered. Disable `record_trace` in `config` to
+    /// keep memory independent of trace length.
+    pub async fn replay_itf_stream_with_effects(
+        &self,
+        reader: impl Read + Send + 'static,
+        capacity: usize,
+        registry: ActionRegistry,
+        initial_state: QuintSimulationState,
+        config: Option<GenerativeSimulatorConfig>,
+    ) -> Result<GenerativeSimulationResult, ITFFuzzError> {
+        let simulator = GenerativeSimulator::new(registry, config.unwrap_or_default());
+
+        let result = simulator
+            .replay_stream(ITFStateStream::spawn(reader, capacity), initial_state)
+            .await
+            .map_err(|e| ITFFuzzError::TraceConversionError(format!("Replay failed: {e}")))?;
+
+        Ok(GenerativeSimulationResult {
+            steps: result.steps,
+            final_state: result.final_state,
+            success: result.success,
+            step_count: result.step_count as u64,
+            property_violations: result
+                .property_violations
+                .into_iter()
+                .map(|v| GenerativePropertyViolation {
+                    property: v.property,
+                    step_index: v.step_index,
+                    description: v.description,
+                })
+                .collect(),
+        })
+    }
+
     /// Explore the state space starting from an initial state
     ///
     /// Uses GenerativeSimulator to explore states by randomly selecting
@@ -9,6 +9,7 @@ use serde_json::Value;
 
 use super::aura_state_extractors::QuintSimulationState;
 use super::itf_fuzzer::{ITFMeta, ITFState, ITFStateMeta, ITFTrace};
+use super::itf_stream::ITFStateStream;
 use aura_core::{AuraError, Result};
 use std::collections::HashMap;
 
@@ -23,6 +24,15 @@ impl ITFLoader {
         Self::parse_json(&content)
     }
 
+    /// Open an ITF file as a stream of states, buffering at most `capacity`
+    ///
+    /// Must be called from within a Tokio runtime.
+    pub fn open_stream(path: impl AsRef<Path>, capacity: usize) -> Result<ITFStateStream> {
+        let file = std::fs::File::open(path.as_ref())
+            .map_err(|e| AuraError::invalid(format!("Failed to open ITF file: {e}")))?;
+        Ok(ITFStateStream::spawn(file, capacity))
+    }
+
     /// Parse ITF trace from JSON string
     pub fn parse_json(json: &str) -> Result<ITFTrace> {
         serde_json::from_str(json)
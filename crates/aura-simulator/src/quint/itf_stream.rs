@@ -0,0 +1,386 @@
+//! Streaming ITF Trace Parsing
+//!
+//! [`ITFBasedFuzzer::parse_itf_trace`](super::ITFBasedFuzzer::parse_itf_trace)
+//! materializes a whole [`ITFTrace`](super::ITFTrace). Traces from deep
+//! model-checking runs reach hundreds of megabytes, so this module decodes
+//! the `states` array one [`ITFState`] at a time:
+//! - [`read_itf_states`] parses from any reader on the calling thread and
+//!   hands each validated state to a callback before decoding the next;
+//! - [`ITFStateStream`] runs that parser on a blocking thread and passes
+//!   states through a bounded channel, so an async consumer such as
+//!   [`GenerativeSimulator::replay_stream`](super::GenerativeSimulator::replay_stream)
+//!   holds at most `capacity` decoded states.
+//!
+//! States get the checks `parse_itf_trace` applies to a full trace:
+//! `ITF` format, sequential indices and every declared variable present.
+//! `#meta` and `vars` must precede `states`, as Quint and Apalache write
+//! them; variables declared after `states` cannot be checked.
+
+use serde::de::{DeserializeSeed, Error as _, IgnoredAny, MapAccess, SeqAccess, Visitor};
+use std::fmt;
+use std::io::{BufReader, Read};
+use tokio::sync::mpsc;
+use tokio::task::JoinHandle;
+
+use super::itf_fuzzer::{ITFFuzzError, ITFMeta, ITFState};
+
+/// Default number of decoded states buffered by an [`ITFStateStream`].
+pub const DEFAULT_ITF_STREAM_CAPACITY: usize = 16;
+
+/// Trace fields decoded before the `states` array.
+#[derive(Debug, Clone, Default)]
+pub struct ITFTraceHeader {
+    /// Trace metadata
+    pub meta: Option<ITFMeta>,
+    /// Execution parameters
+    pub params: Vec<String>,
+    /// State variables
+    pub vars: Vec<String>,
+}
+
+/// Everything but the states of a streamed trace.
+#[derive(Debug, Clone)]
+pub struct ITFStreamSummary {
+    /// Header fields, including any that followed `states`
+    pub header: ITFTraceHeader,
+    /// Number of states decoded
+    pub state_count: u64,
+    /// Optional loop index for infinite traces
+    pub loop_index: Option<usize>,
+}
+
+/// Parse an ITF trace, handing each state to `on_state` as it is decoded.
+///
+/// Only one state is held in memory at a time. An error from `on_state`
+/// stops parsing and is returned as is.
+pub fn read_itf_states<R, F>(reader: R, on_state: F) -> Result<ITFStreamSummary, ITFFuzzError>
+where
+    R: Read,
+    F: FnMut(&ITFTraceHeader, ITFState) -> Result<(), ITFFuzzError>,
+{
+    let mut sink = StateSink {
+        on_state,
+        header: ITFTraceHeader::default(),
+        loop_index: None,
+        state_count: 0,
+        saw_states: false,
+        failure: None,
+    };
+    let mut deserializer = serde_json::Deserializer::from_reader(BufReader::new(reader));
+    let parsed = TraceDocument { sink: &mut sink }
+        .deserialize(&mut deserializer)
+        .and_then(|()| deserializer.end());
+    if let Some(failure) = sink.failure.take() {
+        return Err(failure);
+    }
+    parsed?;
+    sink.finish()
+}
+
+struct StateSink<F> {
+    on_state: F,
+    header: ITFTraceHeader,
+    loop_index: Option<usize>,
+    state_count: u64,
+    saw_states: bool,
+    /// Error raised while handling a state, returned instead of serde's
+    failure: Option<ITFFuzzError>,
+}
+
+impl<F> StateSink<F>
+where
+    F: FnMut(&ITFTraceHeader, ITFState) -> Result<(), ITFFuzzError>,
+{
+    fn accept(&mut self, state: ITFState) -> Result<(), ITFFuzzError> {
+        if self.state_count == 0 {
+            self.check_format()?;
+        }
+        if state.meta.index != self.state_count {
+            return Err(ITFFuzzError::ValidationError(format!(
+                "State index mismatch: expected {}, got {}",
+                self.state_count, state.meta.index
+            )));
+        }
+        for var in &self.header.vars {
+            if !state.variables.contains_key(var) {
+                return Err(ITFFuzzError::ValidationError(format!(
+                    "State {} missing variable '{}'",
+                    state.meta.index, var
+                )));
+            }
+        }
+        self.state_count += 1;
+        (self.on_state)(&self.header, state)
+    }
+
+    fn check_format(&self) -> Result<(), ITFFuzzError> {
+        let meta = self.header.meta.as_ref().ok_or_else(|| {
+            ITFFuzzError::ValidationError("ITF '#meta' must precede 'states'".to_string())
+        })?;
+        if meta.format != "ITF" {
+            return Err(ITFFuzzError::ValidationError(format!(
+                "Invalid format: expected 'ITF', got '{}'",
+                meta.format
+            )));
+        }
+        Ok(())
+    }
+
+    fn finish(self) -> Result<ITFStreamSummary, ITFFuzzError> {
+        if !self.saw_states {
+            return Err(ITFFuzzError::ValidationError(
+                "ITF trace has no 'states'".to_string(),
+            ));
+        }
+        self.check_format()?;
+        Ok(ITFStreamSummary {
+            header: self.header,
+            state_count: self.state_count,
+            loop_index: self.loop_index,
+        })
+    }
+}
+
+/// Top-level trace object; decodes header fields and streams `states`.
+struct TraceDocument<'a, F> {
+    sink: &'a mut StateSink<F>,
+}
+
+impl<'de, F> DeserializeSeed<'de> for TraceDocument<'_, F>
+where
+    F: FnMut(&ITFTraceHeader, ITFState) -> Result<(), ITFFuzzError>,
+{
+    type Value = ();
+
+    fn deserialize<D>(self, deserializer: D) -> Result<(), D::Error>
+    where
+        D: serde::Deserializer<'de>,
+    {
+        deserializer.deserialize_map(self)
+    }
+}
+
+impl<'de, F> Visitor<'de> for TraceDocument<'_, F>
+where
+    F: FnMut(&ITFTraceHeader, ITFState) -> Result<(), ITFFuzzError>,
+{
+    type Value = ();
+
+    fn expecting(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.write_str("an ITF trace object")
+    }
+
+    fn visit_map<A>(self, mut map: A) -> Result<(), A::Error>
+    where
+        A: MapAccess<'de>,
+    {
+        while let Some(key) = map.next_key::<String>()? {
+            match key.as_str() {
+                "#meta" => self.sink.header.meta = Some(map.next_value()?),
+                "params" => self.sink.header.params = map.next_value()?,
+                "vars" => self.sink.header.vars = map.next_value()?,
+                "loop" | "loop_index" => self.sink.loop_index = map.next_value()?,
+                "states" => {
+                    self.sink.saw_states = true;
+                    map.next_value_seed(StateArray {
+                        sink: &mut *self.sink,
+                    })?;
+                }
+                _ => {
+                    map.next_value::<IgnoredAny>()?;
+                }
+            }
+        }
+        Ok(())
+    }
+}
+
+/// The `states` array, decoded element by element.
+struct StateArray<'a, F> {
+    sink: &'a mut StateSink<F>,
+}
+
+impl<'de, F> DeserializeSeed<'de> for StateArray<'_, F>
+where
+    F: FnMut(&ITFTraceHeader, ITFState) -> Result<(), ITFFuzzError>,
+{
+    type Value = ();
+
+    fn deserialize<D>(self, deserializer: D) -> Result<(), D::Error>
+    where
+        D: serde::Deserializer<'de>,
+    {
+        deserializer.deserialize_seq(self)
+    }
+}
+
+impl<'de, F> Visitor<'de> for StateArray<'_, F>
+where
+    F: FnMut(&ITFTraceHeader, ITFState) -> Result<(), ITFFuzzError>,
+{
+    type Value = ();
+
+    fn expecting(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.write_str("an array of ITF states")
+    }
+
+    fn visit_seq<A>(self, mut seq: A) -> Result<(), A::Error>
+    where
+        A: SeqAccess<'de>,
+    {
+        while let Some(state) = seq.next_element::<ITFState>()? {
+            if let Err(failure) = self.sink.accept(state) {
+                let message = failure.to_string();
+                self.sink.failure = Some(failure);
+                return Err(A::Error::custom(message));
+            }
+        }
+        Ok(())
+    }
+}
+
+/// ITF states decoded on a blocking thread and received asynchronously.
+///
+/// The parser blocks once `capacity` states are waiting, so memory does not
+/// grow with the trace. Dropping the stream stops the parser at its next
+/// state.
+pub struct ITFStateStream {
+    receiver: mpsc::Receiver<ITFState>,
+    parser: JoinHandle<Result<ITFStreamSummary, ITFFuzzError>>,
+}
+
+impl ITFStateStream {
+    /// Start parsing `reader` on the runtime's blocking pool.
+    pub fn spawn<R>(reader: R, capacity: usize) -> Self
+    where
+        R: Read + Send + 'static,
+    {
+        let (sender, receiver) = mpsc::channel(capacity.max(1));
+        let parser = tokio::task::spawn_blocking(move || {
+            read_itf_states(reader, |_, state| {
+                sender.blocking_send(state).map_err(|_| {
+                    ITFFuzzError::TraceConversionError("ITF state consumer closed".to_string())
+                })
+            })
+        });
+        Self { receiver, parser }
+    }
+
+    /// Next decoded state; `None` once the parser finished or failed.
+    pub async fn next_state(&mut self) -> Option<ITFState> {
+        self.receiver.recv().await
+    }
+
+    /// Wait for the parser and return the trace summary or its error.
+    ///
+    /// States not yet received are discarded.
+    pub async fn finish(mut self) -> Result<ITFStreamSummary, ITFFuzzError> {
+        self.receiver.close();
+        self.parser.await.map_err(|e| {
+            ITFFuzzError::TraceConversionError(format!("ITF parser task failed: {e}"))
+        })?
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Trace JSON with keys in the order Quint writes them.
+    fn trace_json(state_count: u64) -> String {
+        let states: Vec<String> = (0..state_count)
+            .map(|index| {
+                let action = if index == 0 { "init" } else { "step" };
+                format!(
+                    r##"{{"#meta":{{"index":{index}}},"counter":{index},"mbt::actionTaken":"{action}"}}"##
+                )
+            })
+            .collect();
+        format!(
+            r##"{{"#meta":{{"format":"ITF","format-description":"https://apalache-mc.org/docs/adr/015adr-trace.html","source":"counter.qnt","status":"ok","description":"streaming test","timestamp":0}},"vars":["counter"],"states":[{}],"loop":3}}"##,
+            states.join(",")
+        )
+    }
+
+    #[test]
+    fn states_are_delivered_in_order() {
+        let json = trace_json(50);
+        let mut indices = Vec::new();
+        let summary = read_itf_states(json.as_bytes(), |header, state| {
+            assert_eq!(header.vars, vec!["counter".to_string()]);
+            indices.push(state.meta.index);
+            Ok(())
+        })
+        .unwrap();
+
+        assert_eq!(indices, (0..50).collect::<Vec<_>>());
+        assert_eq!(summary.state_count, 50);
+        assert_eq!(summary.loop_index, Some(3));
+    }
+
+    #[test]
+    fn stream_matches_full_parse() {
+        let json = trace_json(8);
+        let full: super::super::ITFTrace = serde_json::from_str(&json).unwrap();
+        let mut streamed = Vec::new();
+        read_itf_states(json.as_bytes(), |_, state| {
+            streamed.push(state);
+            Ok(())
+        })
+        .unwrap();
+
+        assert_eq!(streamed.len(), full.states.len());
+        for (streamed, full) in streamed.iter().zip(&full.states) {
+            assert_eq!(streamed.meta.index, full.meta.index);
+            assert_eq!(streamed.variables, full.variables);
+            assert_eq!(streamed.action_taken, full.action_taken);
+        }
+    }
+
+    #[test]
+    fn invalid_states_are_rejected() {
+        let json = trace_json(4);
+        let skipped = json.replace(r#"{"index":2}"#, r#"{"index":7}"#);
+        let err = read_itf_states(skipped.as_bytes(), |_, _| Ok(())).unwrap_err();
+        assert!(matches!(err, ITFFuzzError::ValidationError(_)));
+
+        let missing = json.replace(r#""counter":1,"#, "");
+        let err = read_itf_states(missing.as_bytes(), |_, _| Ok(())).unwrap_err();
+        assert!(matches!(err, ITFFuzzError::ValidationError(_)));
+
+        let truncated = &json[..json.len() - 40];
+        let err = read_itf_states(truncated.as_bytes(), |_, _| Ok(())).unwrap_err();
+        assert!(matches!(err, ITFFuzzError::JsonError(_)));
+    }
+
+    #[test]
+    fn callback_errors_stop_parsing() {
+        let json = trace_json(10);
+        let mut seen = 0;
+        let err = read_itf_states(json.as_bytes(), |_, _| {
+            seen += 1;
+            if seen == 3 {
+                Err(ITFFuzzError::CommandFailed("stop".to_string()))
+            } else {
+                Ok(())
+            }
+        })
+        .unwrap_err();
+        assert!(matches!(err, ITFFuzzError::CommandFailed(_)));
+        assert_eq!(seen, 3);
+    }
+
+    #[tokio::test]
+    async fn async_stream_yields_every_state() {
+        let json = trace_json(100);
+        let mut stream = ITFStateStream::spawn(std::io::Cursor::new(json.into_bytes()), 2);
+        let mut count = 0;
+        while let Some(state) = stream.next_state().await {
+            assert_eq!(state.meta.index, count);
+            count += 1;
+        }
+        let summary = stream.finish().await.unwrap();
+        assert_eq!(count, 100);
+        assert_eq!(summary.state_count, 100);
+    }
+}
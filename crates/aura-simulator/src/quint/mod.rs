@@ -29,7 +29,9 @@ pub mod domain_handlers;
 pub mod generative_simulator;
 pub mod itf_fuzzer;
 pub mod itf_loader;
+pub mod itf_stream;
 pub mod properties;
+pub mod seed_campaign;
 pub mod simulation_evaluator;
 pub mod state_mapper;
 pub mod trace_converter;
@@ -122,7 +124,18 @@ pub use aura_state_extractors::{
     QuintSimulationState, QuintStateExtractor, TransportOpRecord,
 };
 
+// Parallel multi-seed campaigns
+pub use seed_campaign::{
+    CampaignEvent, CampaignProgress, ExplorationProperty, FailureSignature, SeedCampaign,
+    SeedCampaignConfig, SeedCampaignError, SeedCampaignReport, SeedFailure, SeedOutcome,
+    SeedProperty, SeedViolation,
+};
+
 // ITF trace loading and replay
 pub use itf_loader::{
     ITFLoader, ITFTraceBuilder, InferredAction, SimulationSequence, SimulationSequenceStep,
 };
+pub use itf_stream::{
+    read_itf_states, ITFStateStream, ITFStreamSummary, ITFTraceHeader,
+    DEFAULT_ITF_STREAM_CAPACITY,
+};
@@ -0,0 +1,764 @@
+//! Parallel Multi-Seed Property Campaigns
+//!
+//! [`GenerativeSimulator::explore`] and ITF replay check one seed or trace
+//! at a time. [`SeedCampaign`] shards a seed range across worker threads:
+//! - each worker builds its own environment through [`SeedProperty::worker`]
+//!   and drives it on a current-thread runtime without a timer driver, so
+//!   runs only see simulated time and every seed reproduces on its own;
+//! - each worker owns a contiguous seed range and takes chunks from its
+//!   front; an idle worker steals the back half of the largest range left;
+//! - violations stream to the caller as workers report them, deduplicated by
+//!   a signature over the property and the minimized trace leading to it.
+//!
+//! Wall-clock time is read only to report seeds per second.
+
+use async_trait::async_trait;
+use aura_core::{AuraError, Result};
+use parking_lot::Mutex;
+use std::collections::HashMap;
+use std::num::NonZeroUsize;
+use std::ops::Range;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::mpsc;
+use std::time::{Duration, Instant};
+
+use super::action_registry::ActionRegistry;
+use super::aura_state_extractors::QuintSimulationState;
+use super::generative_simulator::{GenerativeSimulator, GenerativeSimulatorConfig, SimulationStep};
+use super::itf_fuzzer::{
+    GenerativePropertyViolation, GenerativeSimulationResult, PropertyViolation,
+};
+
+// =============================================================================
+// Seed Properties
+// =============================================================================
+
+/// A property checked by running one deterministic simulation per seed.
+///
+/// Workers call [`SeedProperty::worker`] once on their own thread, so the
+/// environment needs no `Send` bound and is never shared between workers.
+#[async_trait(?Send)]
+pub trait SeedProperty: Sync {
+    /// Per-worker simulation environment
+    type Worker;
+
+    /// Build the environment of worker `worker_index`.
+    fn worker(&self, worker_index: usize) -> Result<Self::Worker>;
+
+    /// Run one seed and report the violations it found.
+    async fn run_seed(&self, worker: &mut Self::Worker, seed: u64) -> Result<SeedOutcome>;
+}
+
+/// A violation reported by one seed.
+#[derive(Debug, Clone)]
+pub enum SeedViolation {
+    /// Violation carrying the ITF trace that led to it
+    Model(PropertyViolation),
+    /// Violation found while executing through effects
+    Generative(GenerativePropertyViolation),
+}
+
+impl SeedViolation {
+    pub fn property(&self) -> &str {
+        match self {
+            Self::Model(violation) => &violation.property_name,
+            Self::Generative(violation) => &violation.property,
+        }
+    }
+
+    pub fn step_index(&self) -> u64 {
+        match self {
+            Self::Model(violation) => violation.violation_step,
+            Self::Generative(violation) => violation.step_index,
+        }
+    }
+
+    pub fn description(&self) -> &str {
+        match self {
+            Self::Model(violation) => &violation.violation_description,
+            Self::Generative(violation) => &violation.description,
+        }
+    }
+}
+
+/// Result of running one seed.
+#[derive(Debug, Clone, Default)]
+pub struct SeedOutcome {
+    /// Executed steps, used to minimize generative violations
+    pub steps: Vec<SimulationStep>,
+    /// Violations found by the seed
+    pub violations: Vec<SeedViolation>,
+}
+
+impl From<GenerativeSimulationResult> for SeedOutcome {
+    fn from(result: GenerativeSimulationResult) -> Self {
+        Self {
+            steps: result.steps,
+            violations: result
+                .property_violations
+                .into_iter()
+                .map(SeedViolation::Generative)
+                .collect(),
+        }
+    }
+}
+
+/// Seed property exploring an action registry with [`GenerativeSimulator`].
+///
+/// Each worker gets a registry of its own from `make_registry`, so handlers
+/// holding state are not shared between workers.
+pub struct ExplorationProperty<F> {
+    make_registry: F,
+    initial_state: QuintSimulationState,
+    max_steps: u32,
+}
+
+impl<F> ExplorationProperty<F>
+where
+    F: Fn() -> ActionRegistry + Sync,
+{
+    pub fn new(make_registry: F, initial_state: QuintSimulationState, max_steps: u32) -> Self {
+        Self {
+            make_registry,
+            initial_state,
+            max_steps,
+        }
+    }
+}
+
+#[async_trait(?Send)]
+impl<F> SeedProperty for ExplorationProperty<F>
+where
+    F: Fn() -> ActionRegistry + Sync,
+{
+    type Worker = GenerativeSimulator;
+
+    fn worker(&self, _worker_index: usize) -> Result<GenerativeSimulator> {
+        let config = GenerativeSimulatorConfig {
+            max_steps: self.max_steps,
+            record_trace: true,
+            verbose: false,
+            exploration_seed: None,
+        };
+        Ok(GenerativeSimulator::new((self.make_registry)(), config))
+    }
+
+    async fn run_seed(
+        &self,
+        simulator: &mut GenerativeSimulator,
+        seed: u64,
+    ) -> Result<SeedOutcome> {
+        let result = simulator
+            .explore(self.initial_state.clone(), Some(seed))
+            .await?;
+        Ok(SeedOutcome {
+            steps: result.steps,
+            violations: result
+                .property_violations
+                .into_iter()
+                .map(|v| {
+                    SeedViolation::Generative(GenerativePropertyViolation {
+                        property: v.property,
+                        step_index: v.step_index,
+                        description: v.description,
+                    })
+                })
+                .collect(),
+        })
+    }
+}
+
+// =============================================================================
+// Failures and Reports
+// =============================================================================
+
+/// Hash of a violated property and its minimized trace.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash, PartialOrd, Ord)]
+pub struct FailureSignature(pub [u8; 32]);
+
+impl FailureSignature {
+    fn of(property: &str, trace: &[String]) -> Self {
+        let mut bytes = Vec::new();
+        for part in std::iter::once(property).chain(trace.iter().map(String::as_str)) {
+            bytes.extend_from_slice(&(part.len() as u64).to_le_bytes());
+            bytes.extend_from_slice(part.as_bytes());
+        }
+        Self(aura_core::hash::hash(&bytes))
+    }
+}
+
+/// Actions leading to a violation, without steps that had no effect.
+///
+/// Steps after the violation are dropped, and so are failed steps: a failed
+/// action leaves the simulation state unchanged.
+fn minimized_trace(outcome: &SeedOutcome, violation: &SeedViolation) -> Vec<String> {
+    match violation {
+        SeedViolation::Model(violation) => violation
+            .violation_trace
+            .states
+            .iter()
+            .filter(|state| state.meta.index > 0 && state.meta.index <= violation.violation_step)
+            .filter_map(|state| state.action_taken.clone())
+            .collect(),
+        SeedViolation::Generative(violation) => outcome
+            .steps
+            .iter()
+            .filter(|step| step.success && step.index <= violation.step_index)
+            .map(|step| step.action.clone())
+            .collect(),
+    }
+}
+
+/// A distinct failure found by a campaign.
+#[derive(Debug, Clone)]
+pub struct SeedFailure {
+    pub signature: FailureSignature,
+    /// Lowest seed reported with this signature
+    pub seed: u64,
+    /// Violation reported by `seed`
+    pub violation: SeedViolation,
+    /// Minimized action trace
+    pub trace: Vec<String>,
+    /// Number of seeds reporting this signature
+    pub occurrences: u64,
+}
+
+/// Throughput snapshot of a running campaign.
+#[derive(Debug, Clone, Copy)]
+pub struct CampaignProgress {
+    pub seeds_run: u64,
+    pub seeds_total: u64,
+    pub unique_failures: usize,
+    pub elapsed: Duration,
+}
+
+impl CampaignProgress {
+    pub fn seeds_per_second(&self) -> f64 {
+        seeds_per_second(self.seeds_run, self.elapsed)
+    }
+}
+
+/// Event streamed to the caller while a campaign runs.
+#[derive(Debug)]
+pub enum CampaignEvent<'a> {
+    /// First seed reporting a new failure signature
+    Failure(&'a SeedFailure),
+    /// A seed returned an error instead of an outcome
+    SeedError { seed: u64, error: &'a AuraError },
+    /// Periodic throughput snapshot
+    Progress(CampaignProgress),
+}
+
+/// Final result of a campaign.
+#[derive(Debug, Clone, Default)]
+pub struct SeedCampaignReport {
+    pub seeds_run: u64,
+    pub passed_seeds: u64,
+    pub failed_seeds: u64,
+    /// Seeds whose run returned an error, by seed
+    pub errored_seeds: Vec<(u64, String)>,
+    /// Distinct failures, by lowest seed
+    pub failures: Vec<SeedFailure>,
+    /// The campaign stopped at `max_unique_failures`
+    pub stopped_early: bool,
+    pub elapsed: Duration,
+}
+
+impl SeedCampaignReport {
+    pub fn seeds_per_second(&self) -> f64 {
+        seeds_per_second(self.seeds_run, self.elapsed)
+    }
+}
+
+fn seeds_per_second(seeds: u64, elapsed: Duration) -> f64 {
+    let seconds = elapsed.as_secs_f64();
+    if seconds > 0.0 {
+        seeds as f64 / seconds
+    } else {
+        0.0
+    }
+}
+
+/// Errors that stop a campaign.
+#[derive(Debug, thiserror::Error)]
+pub enum SeedCampaignError {
+    #[error("Campaign worker {worker} failed to start: {reason}")]
+    WorkerStart { worker: usize, reason: String },
+}
+
+// =============================================================================
+// Campaign Runner
+// =============================================================================
+
+/// Configuration for a multi-seed campaign.
+#[derive(Debug, Clone)]
+pub struct SeedCampaignConfig {
+    /// Seeds to run
+    pub seeds: Range<u64>,
+    /// Worker threads (0 = available parallelism)
+    pub workers: usize,
+    /// Seeds a worker takes from its range at a time
+    pub chunk_size: u64,
+    /// Stop once this many distinct failures were found
+    pub max_unique_failures: Option<usize>,
+    /// Emit a progress event every this many seeds (0 = never)
+    pub progress_interval: u64,
+}
+
+impl Default for SeedCampaignConfig {
+    fn default() -> Self {
+        Self {
+            seeds: 0..10_000,
+            workers: 0,
+            chunk_size: 64,
+            max_unique_failures: None,
+            progress_interval: 0,
+        }
+    }
+}
+
+/// Runs a [`SeedProperty`] over a seed range on a pool of worker threads.
+#[derive(Debug, Clone)]
+pub struct SeedCampaign {
+    config: SeedCampaignConfig,
+}
+
+enum WorkerMessage {
+    Seed {
+        seed: u64,
+        findings: Vec<(FailureSignature, SeedViolation, Vec<String>)>,
+    },
+    SeedError {
+        seed: u64,
+        error: AuraError,
+    },
+    StartFailed {
+        worker: usize,
+        reason: String,
+    },
+}
+
+impl SeedCampaign {
+    pub fn new(config: SeedCampaignConfig) -> Self {
+        Self { config }
+    }
+
+    pub fn config(&self) -> &SeedCampaignConfig {
+        &self.config
+    }
+
+    fn worker_count(&self) -> usize {
+        let requested = if self.config.workers == 0 {
+            std::thread::available_parallelism().map_or(1, NonZeroUsize::get)
+        } else {
+            self.config.workers
+        };
+        let seeds = self
+            .config
+            .seeds
+            .end
+            .saturating_sub(self.config.seeds.start);
+        requested
+            .min(usize::try_from(seeds).unwrap_or(usize::MAX))
+            .max(1)
+    }
+
+    /// Run every seed, calling `on_event` on this thread as results arrive.
+    pub fn run<P: SeedProperty>(
+        &self,
+        property: &P,
+        mut on_event: impl FnMut(CampaignEvent<'_>),
+    ) -> std::result::Result<SeedCampaignReport, SeedCampaignError> {
+        let started = Instant::now();
+        let workers = self.worker_count();
+        let shards = SeedShards::new(self.config.seeds.clone(), workers);
+        let chunk_size = self.config.chunk_size.max(1);
+        let seeds_total = self
+            .config
+            .seeds
+            .end
+            .saturating_sub(self.config.seeds.start);
+        let stop = AtomicBool::new(false);
+
+        let mut report = SeedCampaignReport::default();
+        let mut by_signature: HashMap<FailureSignature, usize> = HashMap::new();
+        let mut start_error = None;
+
+        std::thread::scope(|scope| {
+            let (sender, receiver) = mpsc::channel();
+            for worker in 0..workers {
+                let sender = sender.clone();
+                let (shards, stop) = (&shards, &stop);
+                scope.spawn(move || {
+                    run_worker(property, worker, shards, chunk_size, stop, &sender);
+                });
+            }
+            drop(sender);
+
+            // Leaving the loop drops the receiver, which stops the workers
+            'receive: for message in receiver {
+                match message {
+                    WorkerMessage::Seed { seed, findings } => {
+                        report.seeds_run += 1;
+                        if findings.is_empty() {
+                            report.passed_seeds += 1;
+                        } else {
+                            report.failed_seeds += 1;
+                        }
+                        for (signature, violation, trace) in findings {
+                            if let Some(&index) = by_signature.get(&signature) {
+                                let failure = &mut report.failures[index];
+                                failure.occurrences += 1;
+                                if seed < failure.seed {
+                                    failure.seed = seed;
+                                    failure.violation = violation;
+                                    failure.trace = trace;
+                                }
+                                continue;
+                            }
+                            by_signature.insert(signature, report.failures.len());
+                            report.failures.push(SeedFailure {
+                                signature,
+                                seed,
+                                violation,
+                                trace,
+                                occurrences: 1,
+                            });
+                            if let Some(failure) = report.failures.last() {
+                                on_event(CampaignEvent::Failure(failure));
+                            }
+                            if self
+                                .config
+                                .max_unique_failures
+                                .is_some_and(|max| report.failures.len() >= max)
+                            {
+                                report.stopped_early = true;
+                                stop.store(true, Ordering::Relaxed);
+                                break 'receive;
+                            }
+                        }
+                    }
+                    WorkerMessage::SeedError { seed, error } => {
+                        report.seeds_run += 1;
+                        on_event(CampaignEvent::SeedError {
+                            seed,
+                            error: &error,
+                        });
+                        report.errored_seeds.push((seed, error.to_string()));
+                    }
+                    WorkerMessage::StartFailed { worker, reason } => {
+                        stop.store(true, Ordering::Relaxed);
+                        start_error = Some(SeedCampaignError::WorkerStart { worker, reason });
+                        break 'receive;
+                    }
+                }
+
+                let interval = self.config.progress_interval;
+                if interval > 0 && report.seeds_run % interval == 0 {
+                    on_event(CampaignEvent::Progress(CampaignProgress {
+                        seeds_run: report.seeds_run,
+                        seeds_total,
+                        unique_failures: report.failures.len(),
+                        elapsed: started.elapsed(),
+                    }));
+                }
+            }
+        });
+
+        if let Some(error) = start_error {
+            return Err(error);
+        }
+        report.failures.sort_by_key(|failure| failure.seed);
+        report.errored_seeds.sort_by_key(|(seed, _)| *seed);
+        report.elapsed = started.elapsed();
+        Ok(report)
+    }
+}
+
+fn run_worker<P: SeedProperty>(
+    property: &P,
+    worker_index: usize,
+    shards: &SeedShards,
+    chunk_size: u64,
+    stop: &AtomicBool,
+    sender: &mpsc::Sender<WorkerMessage>,
+) {
+    // No timer driver: a run that reaches for real time fails instead of
+    // making its seed depend on the wall clock
+    let runtime = match tokio::runtime::Builder::new_current_thread().build() {
+        Ok(runtime) => runtime,
+        Err(error) => {
+            let _ = sender.send(WorkerMessage::StartFailed {
+                worker: worker_index,
+                reason: error.to_string(),
+            });
+            return;
+        }
+    };
+    let mut worker = match property.worker(worker_index) {
+        Ok(worker) => worker,
+        Err(error) => {
+            let _ = sender.send(WorkerMessage::StartFailed {
+                worker: worker_index,
+                reason: error.to_string(),
+            });
+            return;
+        }
+    };
+
+    while let Some(chunk) = shards.next_chunk(worker_index, chunk_size) {
+        for seed in chunk {
+            if stop.load(Ordering::Relaxed) {
+                return;
+            }
+            let message = match runtime.block_on(property.run_seed(&mut worker, seed)) {
+                Ok(outcome) => WorkerMessage::Seed {
+                    seed,
+                    findings: findings(&outcome),
+                },
+                Err(error) => WorkerMessage::SeedError { seed, error },
+            };
+            if sender.send(message).is_err() {
+                return;
+            }
+        }
+    }
+}
+
+/// Violations of one outcome with their signatures, one per signature.
+fn findings(outcome: &SeedOutcome) -> Vec<(FailureSignature, SeedViolation, Vec<String>)> {
+    let mut findings: Vec<(FailureSignature, SeedViolation, Vec<String>)> = Vec::new();
+    for violation in &outcome.violations {
+        let trace = minimized_trace(outcome, violation);
+        let signature = FailureSignature::of(violation.property(), &trace);
+        if findings.iter().all(|(seen, _, _)| *seen != signature) {
+            findings.push((signature, violation.clone(), trace));
+        }
+    }
+    findings
+}
+
+/// Per-worker seed ranges with stealing.
+struct SeedShards {
+    ranges: Vec<Mutex<Range<u64>>>,
+}
+
+impl SeedShards {
+    fn new(seeds: Range<u64>, workers: usize) -> Self {
+        let total = seeds.end.saturating_sub(seeds.start);
+        let workers = workers.max(1) as u64;
+        let ranges = (0..workers)
+            .map(|worker| {
+                let start = seeds.start + total * worker / workers;
+                let end = seeds.start + total * (worker + 1) / workers;
+                Mutex::new(start..end)
+            })
+            .collect();
+        Self { ranges }
+    }
+
+    /// Next seeds for `worker`, stolen from another worker once its own
+    /// range is empty; `None` when every range is empty.
+    fn next_chunk(&self, worker: usize, chunk_size: u64) -> Option<Range<u64>> {
+        loop {
+            {
+                let mut own = self.ranges[worker].lock();
+                if !own.is_empty() {
+                    let end = own.end.min(own.start.saturating_add(chunk_size));
+                    let chunk = own.start..end;
+                    own.start = end;
+                    return Some(chunk);
+                }
+            }
+
+            let victim = (0..self.ranges.len())
+                .filter(|index| *index != worker)
+                .map(|index| (index, range_len(&self.ranges[index].lock())))
+                .filter(|(_, len)| *len > 0)
+                .max_by_key(|(_, len)| *len)
+                .map(|(index, _)| index)?;
+            let stolen = {
+                let mut range = self.ranges[victim].lock();
+                let middle = range.start + range_len(&range) / 2;
+                let stolen = middle..range.end;
+                range.end = middle;
+                stolen
+            };
+            *self.ranges[worker].lock() = stolen;
+        }
+    }
+}
+
+fn range_len(range: &Range<u64>) -> u64 {
+    range.end.saturating_sub(range.start)
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::quint::domain_handlers::capability_properties_registry;
+    use serde_json::Value;
+    use std::collections::BTreeSet;
+
+    /// Fails seeds ending in 3 with one trace and seeds ending in 7 with two
+    /// traces; seed 5 errors.
+    struct ModuloProperty;
+
+    fn step(index: u64, action: &str) -> SimulationStep {
+        SimulationStep {
+            index,
+            action: action.to_string(),
+            params: Value::Null,
+            nondet_picks: HashMap::new(),
+            pre_state: Value::Null,
+            post_state: Value::Null,
+            success: true,
+            error: None,
+        }
+    }
+
+    #[async_trait(?Send)]
+    impl SeedProperty for ModuloProperty {
+        type Worker = u64;
+
+        fn worker(&self, _worker_index: usize) -> Result<u64> {
+            Ok(0)
+        }
+
+        async fn run_seed(&self, runs: &mut u64, seed: u64) -> Result<SeedOutcome> {
+            *runs += 1;
+            if seed == 5 {
+                return Err(AuraError::invalid("seed 5 is broken"));
+            }
+            let last = match seed % 10 {
+                3 => "commit".to_string(),
+                7 => format!("fork{}", seed % 20),
+                _ => return Ok(SeedOutcome::default()),
+            };
+            Ok(SeedOutcome {
+                steps: vec![step(0, "init"), step(1, &last), step(2, "after")],
+                violations: vec![SeedViolation::Generative(GenerativePropertyViolation {
+                    property: "agreement".to_string(),
+                    step_index: 1,
+                    description: format!("seed {seed}"),
+                })],
+            })
+        }
+    }
+
+    fn campaign(workers: usize) -> SeedCampaign {
+        SeedCampaign::new(SeedCampaignConfig {
+            seeds: 0..1000,
+            workers,
+            chunk_size: 8,
+            ..SeedCampaignConfig::default()
+        })
+    }
+
+    #[test]
+    fn failures_are_deduplicated_by_minimized_trace() {
+        let mut streamed = 0;
+        let report = campaign(4)
+            .run(&ModuloProperty, |event| {
+                if let CampaignEvent::Failure(_) = event {
+                    streamed += 1;
+                }
+            })
+            .unwrap();
+
+        assert_eq!(report.seeds_run, 1000);
+        assert_eq!(report.failed_seeds, 200);
+        assert_eq!(report.errored_seeds.len(), 1);
+        assert_eq!(streamed, 3);
+
+        let summary: Vec<(u64, u64, Vec<String>)> = report
+            .failures
+            .iter()
+            .map(|f| (f.seed, f.occurrences, f.trace.clone()))
+            .collect();
+        assert_eq!(
+            summary,
+            vec![
+                (3, 100, vec!["init".to_string(), "commit".to_string()]),
+                (7, 50, vec!["init".to_string(), "fork7".to_string()]),
+                (17, 50, vec!["init".to_string(), "fork17".to_string()]),
+            ]
+        );
+        assert_eq!(report.failures[0].violation.description(), "seed 3");
+    }
+
+    #[test]
+    fn report_does_not_depend_on_worker_count() {
+        let summarize = |report: SeedCampaignReport| {
+            report
+                .failures
+                .iter()
+                .map(|f| (f.signature, f.seed, f.occurrences))
+                .collect::<Vec<_>>()
+        };
+        let single = campaign(1).run(&ModuloProperty, |_| {}).unwrap();
+        let parallel = campaign(7).run(&ModuloProperty, |_| {}).unwrap();
+        assert_eq!(summarize(single), summarize(parallel));
+    }
+
+    #[test]
+    fn campaign_stops_at_max_unique_failures() {
+        let campaign = SeedCampaign::new(SeedCampaignConfig {
+            seeds: 0..1000,
+            workers: 2,
+            chunk_size: 4,
+            max_unique_failures: Some(1),
+            progress_interval: 0,
+        });
+        let report = campaign.run(&ModuloProperty, |_| {}).unwrap();
+        assert!(report.stopped_early);
+        assert_eq!(report.failures.len(), 1);
+        assert!(report.seeds_run < 1000);
+    }
+
+    #[test]
+    fn idle_workers_steal_every_remaining_seed() {
+        let shards = SeedShards::new(10..110, 4);
+        let mut seen = BTreeSet::new();
+        while let Some(chunk) = shards.next_chunk(0, 3) {
+            for seed in chunk {
+                assert!(seen.insert(seed));
+            }
+        }
+        assert_eq!(seen, (10..110).collect());
+    }
+
+    #[test]
+    fn exploration_campaign_runs_each_seed_once() {
+        let mut state = QuintSimulationState::new();
+        state.init_context(
+            aura_core::types::ContextId::new_from_entropy([1u8; 32]),
+            aura_core::types::AuthorityId::new_from_entropy([2u8; 32]),
+            100,
+        );
+        let property = ExplorationProperty::new(capability_properties_registry, state, 5);
+        let campaign = SeedCampaign::new(SeedCampaignConfig {
+            seeds: 0..32,
+            workers: 3,
+            chunk_size: 2,
+            progress_interval: 8,
+            ..SeedCampaignConfig::default()
+        });
+
+        let mut progress = Vec::new();
+        let report = campaign
+            .run(&property, |event| {
+                if let CampaignEvent::Progress(snapshot) = event {
+                    progress.push(snapshot.seeds_run);
+                }
+            })
+            .unwrap();
+        assert_eq!(report.seeds_run, 32);
+        assert_eq!(report.passed_seeds + report.failed_seeds, 32);
+        assert_eq!(progress, vec![8, 16, 24, 32]);
+    }
+}
@@ -0,0 +1,244 @@
+//! Content-defined chunking
+//!
+//! FastCDC-style boundaries from a Gear rolling hash. A boundary depends
+//! only on the bytes just before it, so an edit moves the boundaries near
+//! it and leaves every other chunk byte-identical. Identical chunks hash to
+//! the same content-addressed [`aura_core::ChunkId`], so edited versions of
+//! a document share storage and sync bandwidth with earlier versions.
+//!
+//! Normalized chunking uses a stricter mask below the target size and a
+//! looser one above it. That keeps sizes clustered around the average
+//! without the tail of tiny or maximal chunks a single mask produces.
+
+use crate::erasure::read_full;
+use aura_core::AuraError;
+use serde::{Deserialize, Serialize};
+use std::io::Read;
+
+/// How content is split into data chunks
+#[derive(Debug, Clone, Copy, Default, Serialize, Deserialize, PartialEq, Eq)]
+pub enum ChunkingStrategy {
+    /// Fixed `max_chunk_size` boundaries
+    #[default]
+    Fixed,
+    /// Gear-hash boundaries between `min_chunk_size` and `max_chunk_size`
+    ContentDefined {
+        /// Smallest chunk produced, except for the final chunk
+        min_chunk_size: u32,
+        /// Target average chunk size
+        avg_chunk_size: u32,
+    },
+}
+
+const fn build_gear_table() -> [u64; 256] {
+    // SplitMix64 from a fixed seed; boundaries must be stable across releases
+    let mut table = [0u64; 256];
+    let mut state: u64 = 0x6175_7261_3a63_6463; // "aura:cdc"
+    let mut index = 0;
+    while index < 256 {
+        state = state.wrapping_add(0x9e37_79b9_7f4a_7c15);
+        let mut z = state;
+        z = (z ^ (z >> 30)).wrapping_mul(0xbf58_476d_1ce4_e5b9);
+        z = (z ^ (z >> 27)).wrapping_mul(0x94d0_49bb_1331_11eb);
+        table[index] = z ^ (z >> 31);
+        index += 1;
+    }
+    table
+}
+
+const GEAR: [u64; 256] = build_gear_table();
+
+/// Boundary finder for content-defined chunking
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct ContentDefinedChunker {
+    min_size: usize,
+    avg_size: usize,
+    max_size: usize,
+    /// Mask with more bits, used before the average size is reached
+    mask_strict: u64,
+    /// Mask with fewer bits, used after the average size is reached
+    mask_loose: u64,
+}
+
+impl ContentDefinedChunker {
+    /// Create a chunker with the given size bounds
+    pub fn new(min_size: u32, avg_size: u32, max_size: u32) -> Result<Self, AuraError> {
+        if min_size == 0 || !(min_size <= avg_size && avg_size <= max_size) {
+            return Err(AuraError::invalid(
+                "Content-defined chunking needs 0 < min <= avg <= max",
+            ));
+        }
+
+        let bits = avg_size.max(2).ilog2();
+        Ok(Self {
+            min_size: min_size as usize,
+            avg_size: avg_size as usize,
+            max_size: max_size as usize,
+            mask_strict: high_bits_mask((bits + 1).min(63)),
+            mask_loose: high_bits_mask(bits.saturating_sub(1).max(1)),
+        })
+    }
+
+    /// Largest chunk this chunker produces
+    pub fn max_size(&self) -> usize {
+        self.max_size
+    }
+
+    /// Length of the first chunk in `data`
+    ///
+    /// Treats the end of `data` as the end of content, so callers streaming
+    /// content must pass at least `max_size` bytes unless the stream ended.
+    pub fn cut_point(&self, data: &[u8]) -> usize {
+        if data.len() <= self.min_size {
+            return data.len();
+        }
+        let limit = data.len().min(self.max_size);
+        let normal = limit.min(self.avg_size);
+
+        // Bytes before min_size never end a chunk, so they are not hashed
+        let mut hash = 0u64;
+        for (offset, &byte) in data[self.min_size..normal].iter().enumerate() {
+            hash = (hash << 1).wrapping_add(GEAR[usize::from(byte)]);
+            if hash & self.mask_strict == 0 {
+                return self.min_size + offset + 1;
+            }
+        }
+        for (offset, &byte) in data[normal..limit].iter().enumerate() {
+            hash = (hash << 1).wrapping_add(GEAR[usize::from(byte)]);
+            if hash & self.mask_loose == 0 {
+                return normal + offset + 1;
+            }
+        }
+        limit
+    }
+
+    /// Split in-memory content into chunks
+    pub fn chunks<'a>(&'a self, mut data: &'a [u8]) -> impl Iterator<Item = &'a [u8]> + 'a {
+        std::iter::from_fn(move || {
+            if data.is_empty() {
+                return None;
+            }
+            let (chunk, rest) = data.split_at(self.cut_point(data));
+            data = rest;
+            Some(chunk)
+        })
+    }
+}
+
+/// Gear hash shifts left, so the high bits mix in the most bytes
+fn high_bits_mask(bits: u32) -> u64 {
+    u64::MAX << (64 - bits)
+}
+
+/// Reads content a chunk at a time, holding at most `max_size` bytes
+pub(crate) struct StreamingChunker<R> {
+    reader: R,
+    chunker: ContentDefinedChunker,
+    buffer: Vec<u8>,
+    start: usize,
+    end: usize,
+    eof: bool,
+}
+
+impl<R: Read> StreamingChunker<R> {
+    pub(crate) fn new(reader: R, chunker: ContentDefinedChunker) -> Self {
+        let buffer = vec![0u8; chunker.max_size()];
+        Self {
+            reader,
+            chunker,
+            buffer,
+            start: 0,
+            end: 0,
+            eof: false,
+        }
+    }
+
+    /// Copy the next chunk into `out` and return its length; 0 at the end
+    pub(crate) fn next_chunk(&mut self, out: &mut [u8]) -> Result<usize, AuraError> {
+        if !self.eof && self.end - self.start < self.buffer.len() {
+            self.buffer.copy_within(self.start..self.end, 0);
+            self.end -= self.start;
+            self.start = 0;
+            let read = read_full(&mut self.reader, &mut self.buffer[self.end..])?;
+            self.eof = self.end + read < self.buffer.len();
+            self.end += read;
+        }
+
+        let available = &self.buffer[self.start..self.end];
+        let cut = self.chunker.cut_point(available);
+        out[..cut].copy_from_slice(&available[..cut]);
+        self.start += cut;
+        Ok(cut)
+    }
+
+    /// Whether every byte of the content has been returned
+    pub(crate) fn is_exhausted(&self) -> bool {
+        self.eof && self.start == self.end
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn document(len: usize, seed: u64) -> Vec<u8> {
+        let mut state = seed;
+        (0..len)
+            .map(|_| {
+                state = state
+                    .wrapping_mul(6364136223846793005)
+                    .wrapping_add(1442695040888963407);
+                (state >> 33) as u8
+            })
+            .collect()
+    }
+
+    #[test]
+    fn chunks_respect_size_bounds() {
+        let chunker = ContentDefinedChunker::new(256, 1024, 4096).unwrap();
+        let data = document(64 * 1024, 1);
+        let chunks: Vec<&[u8]> = chunker.chunks(&data).collect();
+
+        assert_eq!(chunks.concat(), data);
+        let (last, rest) = chunks.split_last().unwrap();
+        assert!(rest.iter().all(|c| (256..=4096).contains(&c.len())));
+        assert!(last.len() <= 4096);
+    }
+
+    #[test]
+    fn insertion_only_changes_nearby_chunks() {
+        let chunker = ContentDefinedChunker::new(256, 1024, 4096).unwrap();
+        let original = document(64 * 1024, 2);
+        let mut edited = original.clone();
+        edited.splice(20_000..20_000, b"inserted paragraph".iter().copied());
+
+        let before: std::collections::BTreeSet<&[u8]> = chunker.chunks(&original).collect();
+        let after: Vec<&[u8]> = chunker.chunks(&edited).collect();
+        let shared = after.iter().filter(|chunk| before.contains(*chunk)).count();
+        assert!(
+            shared + 3 >= after.len(),
+            "only chunks around the edit should change ({shared} of {} shared)",
+            after.len()
+        );
+    }
+
+    #[test]
+    fn streaming_matches_in_memory_boundaries() {
+        let chunker = ContentDefinedChunker::new(64, 256, 1024).unwrap();
+        let data = document(10_000, 3);
+        let expected: Vec<&[u8]> = chunker.chunks(&data).collect();
+
+        let mut stream = StreamingChunker::new(data.as_slice(), chunker.clone());
+        let mut out = vec![0u8; 1024];
+        let mut streamed = Vec::new();
+        loop {
+            let len = stream.next_chunk(&mut out).unwrap();
+            if len == 0 {
+                break;
+            }
+            streamed.push(out[..len].to_vec());
+        }
+        assert!(stream.is_exhausted());
+        assert_eq!(streamed, expected);
+    }
+}
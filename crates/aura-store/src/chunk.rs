@@ -5,6 +5,8 @@
 //!
 //! **Time System**: Uses `PhysicalTime` for timestamps per the unified time architecture.
 
+use crate::cdc::ChunkingStrategy;
+use crate::erasure::{encode_stream, ChunkStripe};
 use crate::types::physical_time_ms;
 use crate::StorageCapability;
 use aura_core::time::PhysicalTime;
@@ -26,6 +28,9 @@ pub struct ErasureConfig {
     pub parity_chunks: u8,
     /// Maximum chunk size in bytes
     pub max_chunk_size: u32,
+    /// How data chunk boundaries are chosen
+    #[serde(default)]
+    pub chunking: ChunkingStrategy,
 }
 
 impl ErasureConfig {
@@ -35,15 +40,32 @@ impl ErasureConfig {
             data_chunks,
             parity_chunks,
             max_chunk_size,
+            chunking: ChunkingStrategy::Fixed,
         }
     }
 
+    /// Use content-defined chunk boundaries capped at `max_chunk_size`
+    ///
+    /// Boundaries follow the content, so unchanged regions of an edited
+    /// object produce the same chunk IDs as before.
+    pub fn with_content_defined_chunking(
+        mut self,
+        min_chunk_size: u32,
+        avg_chunk_size: u32,
+    ) -> Self {
+        self.chunking = ChunkingStrategy::ContentDefined {
+            min_chunk_size,
+            avg_chunk_size,
+        };
+        self
+    }
+
     /// Total number of chunks (data + parity)
     pub fn total_chunks(&self) -> u8 {
         self.data_chunks + self.parity_chunks
     }
 
-    /// Minimum chunks needed for recovery
+    /// Minimum chunks of each stripe needed for recovery
     pub fn min_chunks(&self) -> u8 {
         self.data_chunks
     }
@@ -112,6 +134,59 @@ impl ChunkLayout {
     pub fn get_chunk_size(&self, index: usize) -> Option<u32> {
         self.chunk_sizes.get(index).copied()
     }
+
+    /// Number of data chunks (the rest are parity)
+    pub fn data_chunk_count(&self) -> usize {
+        // chunks = data + ceil(data / k) * m, so each k + m chunks span one stripe
+        let data_per_stripe = usize::from(self.erasure_config.data_chunks.max(1));
+        let parity_per_stripe = usize::from(self.erasure_config.parity_chunks);
+        let stripe_count = self
+            .chunks
+            .len()
+            .div_ceil(data_per_stripe + parity_per_stripe);
+        self.chunks
+            .len()
+            .saturating_sub(stripe_count * parity_per_stripe)
+    }
+
+    /// Group chunk indices into erasure-coded stripes
+    ///
+    /// Data chunks come first in content order, `data_chunks` per stripe.
+    /// Parity chunks follow, `parity_chunks` per stripe in stripe order.
+    pub fn stripes(&self) -> Result<Vec<ChunkStripe>, AuraError> {
+        let data_per_stripe = usize::from(self.erasure_config.data_chunks);
+        let parity_per_stripe = usize::from(self.erasure_config.parity_chunks);
+        if data_per_stripe == 0 {
+            return Err(AuraError::invalid(
+                "Erasure coding requires at least one data shard",
+            ));
+        }
+
+        let data_count = self.data_chunk_count();
+        let stripe_count = data_count.div_ceil(data_per_stripe);
+        if self.chunks.len() != data_count + stripe_count * parity_per_stripe {
+            return Err(AuraError::invalid(
+                "Chunk count does not match erasure layout",
+            ));
+        }
+
+        Ok((0..stripe_count)
+            .map(|stripe| {
+                let data_start = stripe * data_per_stripe;
+                let data = data_start..(data_start + data_per_stripe).min(data_count);
+                let parity_start = data_count + stripe * parity_per_stripe;
+                ChunkStripe {
+                    shard_len: self.chunk_sizes[data.clone()]
+                        .iter()
+                        .copied()
+                        .max()
+                        .unwrap_or(0) as usize,
+                    data,
+                    parity: parity_start..parity_start + parity_per_stripe,
+                }
+            })
+            .collect())
+    }
 }
 
 /// Manifest for a single chunk with metadata
@@ -294,8 +369,10 @@ impl ContentManifest {
 /// Pure function to plan chunk layout from content size (without actual content)
 ///
 /// This is used for planning replication before content is available.
-/// Returns a layout with provisional chunk IDs derived deterministically from
-/// the content size and chunk indices. These IDs enable storage allocation
+/// Returns a layout with the same shape as [`compute_chunk_layout`]: data
+/// chunks, then `parity_chunks` parity chunks per stripe. Chunk IDs are
+/// provisional and derived deterministically from the content size and
+/// chunk indices. These IDs enable storage allocation
 /// planning and are replaced with content-derived IDs once actual chunking occurs.
 ///
 /// # Provisional ID Derivation
@@ -306,6 +383,9 @@ impl ContentManifest {
 ///
 /// This ensures deterministic, collision-free IDs for planning purposes while
 /// clearly distinguishing them from content-addressed IDs.
+///
+/// Content-defined boundaries depend on the bytes themselves, so
+/// content-defined configurations cannot be planned from size alone.
 pub fn plan_chunk_layout_from_size(
     content_size: u64,
     erasure_config: ErasureConfig,
@@ -313,6 +393,11 @@ pub fn plan_chunk_layout_from_size(
     if content_size == 0 {
         return Err(AuraError::invalid("Empty content"));
     }
+    if erasure_config.chunking != ChunkingStrategy::Fixed {
+        return Err(AuraError::invalid(
+            "Content-defined chunk layouts require the content",
+        ));
+    }
 
     let chunk_size = erasure_config.max_chunk_size as u64;
     let num_data_chunks = content_size.div_ceil(chunk_size);
@@ -336,16 +421,23 @@ pub fn plan_chunk_layout_from_size(
         chunk_sizes.push(this_chunk_size);
     }
 
-    // Derive provisional parity chunk IDs
-    for i in 0..erasure_config.parity_chunks {
-        let mut hasher = aura_core::hash::hasher();
-        hasher.update(b"aura:store:plan:parity:");
-        hasher.update(&content_size.to_le_bytes());
-        hasher.update(&(i as u32).to_le_bytes());
-        let digest = hasher.finalize();
-        let parity_id = ChunkId::from_bytes(&digest[..]);
-        chunks.push(parity_id);
-        chunk_sizes.push((chunk_size as u32).min(content_size as u32));
+    // Derive provisional parity chunk IDs, sized like each stripe's first data chunk
+    let data_per_stripe = u64::from(erasure_config.data_chunks.max(1));
+    let stripe_count = num_data_chunks.div_ceil(data_per_stripe);
+    let mut parity_index = 0u32;
+    for stripe in 0..stripe_count {
+        let stripe_chunk_size = chunk_sizes[(stripe * data_per_stripe) as usize];
+        for _ in 0..erasure_config.parity_chunks {
+            let mut hasher = aura_core::hash::hasher();
+            hasher.update(b"aura:store:plan:parity:");
+            hasher.update(&content_size.to_le_bytes());
+            hasher.update(&parity_index.to_le_bytes());
+            let digest = hasher.finalize();
+            let parity_id = ChunkId::from_bytes(&digest[..]);
+            chunks.push(parity_id);
+            chunk_sizes.push(stripe_chunk_size);
+            parity_index += 1;
+        }
     }
 
     ChunkLayout::new(
@@ -357,42 +449,15 @@ pub fn plan_chunk_layout_from_size(
 }
 
 /// Pure function to compute chunk layout from content
+///
+/// Chunk IDs are content-addressed, including the Reed-Solomon parity
+/// chunks. Use [`encode_stream`] to capture the chunk bytes as well, or to
+/// encode from a reader without holding the whole content in memory.
 pub fn compute_chunk_layout(
     content: &[u8],
     erasure_config: ErasureConfig,
 ) -> Result<ChunkLayout, AuraError> {
-    if content.is_empty() {
-        return Err(AuraError::invalid("Empty content"));
-    }
-
-    let chunk_size = erasure_config.max_chunk_size as usize;
-    let mut chunks = Vec::new();
-    let mut chunk_sizes = Vec::new();
-
-    // Split content into data chunks
-    for chunk_data in content.chunks(chunk_size) {
-        let chunk_id = ChunkId::from_bytes(chunk_data);
-        chunks.push(chunk_id);
-        chunk_sizes.push(chunk_data.len() as u32);
-    }
-
-    // Add parity chunks derived deterministically from content to enable integrity checks
-    for i in 0..erasure_config.parity_chunks {
-        let mut hasher = aura_core::hash::hasher();
-        hasher.update(&(i as u32).to_le_bytes());
-        hasher.update(content);
-        let digest = hasher.finalize();
-        let parity_id = ChunkId::from_bytes(&digest[..]);
-        chunks.push(parity_id);
-        chunk_sizes.push(chunk_size.min(content.len()) as u32);
-    }
-
-    ChunkLayout::new(
-        chunks,
-        chunk_sizes,
-        ContentSize(content.len() as u64),
-        erasure_config,
-    )
+    encode_stream(content, erasure_config, |_| Ok(()))
 }
 
 #[cfg(test)]
@@ -430,11 +495,23 @@ mod tests {
 
         let layout = compute_chunk_layout(content, config).unwrap();
 
-        // Should have data chunks + parity chunks
-        assert!(layout.chunk_count() > 2); // At least data chunks
+        // 4 data chunks in 2 stripes, one parity chunk per stripe
+        assert_eq!(layout.chunk_count(), 6);
         assert_eq!(layout.total_size.0, content.len() as u64);
     }
 
+    #[test]
+    fn test_planned_layout_matches_computed_shape() {
+        let content = vec![7u8; 2500];
+        let config = ErasureConfig::new(3, 2, 512);
+
+        let planned = plan_chunk_layout_from_size(content.len() as u64, config.clone()).unwrap();
+        let computed = compute_chunk_layout(&content, config).unwrap();
+
+        assert_eq!(planned.chunk_sizes, computed.chunk_sizes);
+        assert_eq!(planned.stripes().unwrap(), computed.stripes().unwrap());
+    }
+
     #[test]
     fn test_manifests_require_created_at() {
         let chunk_id = ChunkId::from_bytes(b"chunk1");
@@ -3,24 +3,22 @@
 //! This module defines CRDT types for storage state management,
 //! implementing join and meet semilattice operations for convergence.
 
+use crate::search::{query_terms, InvertedIndex, SearchResultItem};
 use crate::types::{physical_time_ms, NodeId};
-use crate::SearchIndexEntry;
+use crate::{SearchIndexEntry, SearchQuery, SearchResults};
 use aura_core::time::PhysicalTime;
 use aura_core::{AuthorityId, ChunkId, ContentId, JoinSemilattice};
 use serde::{Deserialize, Serialize};
 use std::collections::{BTreeMap, BTreeSet};
 
-fn insert_if_newer_index_entry(
-    entries: &mut BTreeMap<ContentId, SearchIndexEntry>,
+fn is_newer_index_entry(
+    entries: &BTreeMap<ContentId, SearchIndexEntry>,
     content_id: &ContentId,
     candidate: &SearchIndexEntry,
-) {
-    match entries.get(content_id) {
-        Some(existing) if candidate.timestamp <= existing.timestamp => {}
-        _ => {
-            entries.insert(content_id.clone(), candidate.clone());
-        }
-    }
+) -> bool {
+    entries
+        .get(content_id)
+        .is_none_or(|existing| candidate.timestamp > existing.timestamp)
 }
 
 fn insert_if_newer_node_timestamp(
@@ -38,33 +36,92 @@ fn insert_if_newer_node_timestamp(
         .or_insert_with(|| candidate.clone());
 }
 
+fn build_term_index(entries: &BTreeMap<ContentId, SearchIndexEntry>) -> InvertedIndex<ContentId> {
+    let mut search = InvertedIndex::new();
+    for (content_id, entry) in entries {
+        // Fresh document IDs only run out past u32::MAX entries
+        let _ = search.add_document(content_id.clone(), entry.terms.iter().map(String::as_str));
+    }
+    search
+}
+
 /// Storage index CRDT for tracking content and search terms
-#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+///
+/// Entries are the replicated state. The inverted term index is derived
+/// from them, kept in step by every mutation, and serialized alongside so
+/// it does not have to be rebuilt at startup.
+#[derive(Debug, Clone, Serialize, Deserialize)]
+#[serde(from = "StorageIndexSnapshot")]
 pub struct StorageIndex {
     /// Mapping from content ID to search index entries
-    pub entries: BTreeMap<ContentId, SearchIndexEntry>,
+    entries: BTreeMap<ContentId, SearchIndexEntry>,
     /// Version vector for causal ordering
     pub version: u64,
+    /// Inverted index over entry terms
+    search: InvertedIndex<ContentId>,
+}
+
+/// Serialized form of [`StorageIndex`]; snapshots without a matching term
+/// index get one rebuilt from their entries
+#[derive(Deserialize)]
+struct StorageIndexSnapshot {
+    entries: BTreeMap<ContentId, SearchIndexEntry>,
+    version: u64,
+    #[serde(default)]
+    search: Option<InvertedIndex<ContentId>>,
 }
 
+impl From<StorageIndexSnapshot> for StorageIndex {
+    fn from(snapshot: StorageIndexSnapshot) -> Self {
+        let entries = snapshot.entries;
+        let search = match snapshot.search {
+            Some(search)
+                if search.len() == entries.len()
+                    && entries.keys().all(|content_id| search.contains(content_id)) =>
+            {
+                search
+            }
+            _ => build_term_index(&entries),
+        };
+        Self {
+            entries,
+            version: snapshot.version,
+            search,
+        }
+    }
+}
+
+/// Equality covers the replicated state; term index layout depends on
+/// insertion order
+impl PartialEq for StorageIndex {
+    fn eq(&self, other: &Self) -> bool {
+        self.entries == other.entries && self.version == other.version
+    }
+}
+
+impl Eq for StorageIndex {}
+
 impl StorageIndex {
     /// Create a new empty storage index
     pub fn new() -> Self {
         Self {
             entries: BTreeMap::new(),
             version: 0,
+            search: InvertedIndex::new(),
         }
     }
 
     /// Add or update an index entry
     pub fn add_entry(&mut self, content_id: ContentId, entry: SearchIndexEntry) {
-        self.entries.insert(content_id, entry);
+        self.entries.insert(content_id.clone(), entry);
+        self.reindex(&content_id);
         self.version += 1;
     }
 
     /// Remove an index entry
     pub fn remove_entry(&mut self, content_id: &ContentId) -> Option<SearchIndexEntry> {
         self.version += 1;
+        self.search.remove_document(content_id);
         self.entries.remove(content_id)
     }
 
@@ -73,6 +130,11 @@ impl StorageIndex {
         self.entries.get(content_id)
     }
 
+    /// All index entries by content ID
+    pub fn entries(&self) -> &BTreeMap<ContentId, SearchIndexEntry> {
+        &self.entries
+    }
+
     /// Get all content IDs
     pub fn content_ids(&self) -> impl Iterator<Item = &ContentId> {
         self.entries.keys()
@@ -88,13 +150,62 @@ impl StorageIndex {
         self.entries.is_empty()
     }
 
-    /// Search within this index
+    /// Entries matching any query term, in content ID order
     pub fn search(&self, terms: &str) -> Vec<&SearchIndexEntry> {
-        self.entries
-            .values()
-            .filter(|entry| entry.matches_terms(terms))
+        let terms = query_terms(terms);
+        self.search
+            .matching(terms.iter().map(String::as_str))
+            .into_iter()
+            .filter_map(|content_id| self.entries.get(content_id))
             .collect()
     }
+
+    /// BM25-ranked entries for a query, limited to its scope and limit
+    ///
+    /// Scores are relative to the best hit, which scores 1.0. Only the
+    /// posting lists of the query terms are read, and documents that cannot
+    /// reach the top results are skipped, so `total_count` is a lower bound.
+    pub fn ranked_search(&self, query: &SearchQuery) -> SearchResults {
+        let terms = query_terms(&query.terms);
+        let ranked = self.search.top_k(
+            terms.iter().map(String::as_str),
+            query.effective_limit(),
+            |content_id| {
+                self.entries
+                    .get(content_id)
+                    .is_some_and(|entry| query.scope.contains_content(&entry.content_id))
+            },
+        );
+
+        let best = ranked.hits.first().map_or(1.0, |hit| hit.score);
+        let items = ranked
+            .hits
+            .iter()
+            .filter_map(|hit| {
+                let entry = self.entries.get(hit.key)?;
+                Some(SearchResultItem::new(
+                    entry.content_id.clone(),
+                    hit.score / best,
+                    entry.required_capabilities.clone(),
+                ))
+            })
+            .collect();
+        let total_count = u32::try_from(ranked.examined).unwrap_or(u32::MAX);
+        SearchResults::new(query.clone(), items, total_count)
+    }
+
+    /// Bring the term index in line with the entry for `content_id`
+    fn reindex(&mut self, content_id: &ContentId) {
+        let Some(entry) = self.entries.get(content_id) else {
+            self.search.remove_document(content_id);
+            return;
+        };
+        let terms = entry.terms.iter().map(String::as_str);
+        if self.search.add_document(content_id.clone(), terms).is_err() {
+            // Document IDs are never reused; compact them by rebuilding
+            self.search = build_term_index(&self.entries);
+        }
+    }
 }
 
 impl Default for StorageIndex {
@@ -106,18 +217,21 @@ impl Default for StorageIndex {
 /// Join semilattice implementation for StorageIndex (union of entries)
 impl JoinSemilattice for StorageIndex {
     fn join(&self, other: &Self) -> Self {
-        let mut merged_entries = self.entries.clone();
+        let mut merged = self.clone();
 
         // Merge entries, taking the one with the latest timestamp for conflicts
         for (content_id, other_entry) in &other.entries {
-            insert_if_newer_index_entry(&mut merged_entries, content_id, other_entry);
+            if is_newer_index_entry(&merged.entries, content_id, other_entry) {
+                merged
+                    .entries
+                    .insert(content_id.clone(), other_entry.clone());
+                merged.reindex(content_id);
+            }
         }
 
-        Self {
-            entries: merged_entries,
-            // Take max version (do not increment - preserves idempotency: a ⊔ a = a)
-            version: self.version.max(other.version),
-        }
+        // Take max version (do not increment - preserves idempotency: a ⊔ a = a)
+        merged.version = self.version.max(other.version);
+        merged
     }
 }
 
@@ -275,6 +389,7 @@ impl StorageOperation {
                             .map(|s| s.to_string())
                             .collect();
                         entry.terms = new_terms;
+                        index.reindex(content_id);
                     }
                 }
             }
@@ -529,6 +644,43 @@ mod tests {
         assert!(merged.get_entry(&content_id2).is_some());
     }
 
+    #[test]
+    fn test_storage_index_ranked_search() {
+        let mut index = StorageIndex::new();
+        for (name, text) in [
+            ("user/alice/notes", "rust storage notes for storage sync"),
+            ("user/alice/todo", "buy milk and fix storage"),
+            ("user/bob/notes", "storage storage storage"),
+        ] {
+            let terms = text.split_whitespace().map(str::to_string).collect();
+            let entry = SearchIndexEntry::new(name.to_string(), terms, vec![], physical_time_ms(1));
+            index.add_entry(ContentId::from_bytes(name.as_bytes()), entry);
+        }
+
+        let query = SearchQuery::new(
+            "Storage sync".to_string(),
+            crate::SearchScope::namespace("user/alice"),
+        );
+        let results = index.ranked_search(&query);
+        let ids: Vec<&str> = results
+            .items
+            .iter()
+            .map(|item| item.content_id.as_str())
+            .collect();
+        assert_eq!(ids, ["user/alice/notes", "user/alice/todo"]);
+        assert_eq!(results.items[0].score, 1.0);
+        assert_eq!(index.search("milk").len(), 1);
+
+        // The term index survives serialization and is rebuilt when absent
+        let json = serde_json::to_value(&index).unwrap();
+        let restored: StorageIndex = serde_json::from_value(json.clone()).unwrap();
+        assert_eq!(restored.ranked_search(&query).items, results.items);
+        let mut legacy = json;
+        legacy.as_object_mut().unwrap().remove("search");
+        let rebuilt: StorageIndex = serde_json::from_value(legacy).unwrap();
+        assert_eq!(rebuilt.ranked_search(&query).items, results.items);
+    }
+
     #[test]
     fn test_storage_op_log_join() {
         let mut log1 = StorageOpLog::new();
@@ -0,0 +1,207 @@
+//! Cross-object chunk deduplication
+//!
+//! Chunk IDs are content-addressed, so two manifests that contain the same
+//! bytes reference the same chunk. [`ChunkReferences`] tracks which
+//! manifests reference each chunk. A chunk is stored and synced once, and
+//! it can be collected only after its last referencing manifest is removed.
+//! Pair it with content-defined chunking
+//! ([`crate::ErasureConfig::with_content_defined_chunking`]) so that edited
+//! versions of a document keep most of their chunk IDs.
+
+use crate::chunk::ContentManifest;
+use aura_core::{ChunkId, ContentId};
+use serde::{Deserialize, Serialize};
+use std::collections::{BTreeMap, BTreeSet};
+
+/// Reference tracking for a stored chunk
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+pub struct ChunkReference {
+    /// Chunk size in bytes
+    pub size: u32,
+    /// Manifests whose layout includes this chunk
+    pub referenced_by: BTreeSet<ContentId>,
+}
+
+impl ChunkReference {
+    /// Number of manifests referencing this chunk
+    pub fn count(&self) -> usize {
+        self.referenced_by.len()
+    }
+}
+
+/// Outcome of registering a manifest
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct DedupReport {
+    /// Layout indices of chunks not stored before; only these need upload
+    pub new_chunks: Vec<usize>,
+    /// Bytes in chunks not stored before
+    pub new_bytes: u64,
+    /// Number of layout chunks that were already stored
+    pub reused_chunks: usize,
+    /// Bytes saved by reusing stored chunks
+    pub reused_bytes: u64,
+}
+
+/// Content-addressed chunk reference counts across manifests
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize, Deserialize)]
+pub struct ChunkReferences {
+    /// Stored chunks and the manifests referencing them
+    pub chunks: BTreeMap<ChunkId, ChunkReference>,
+}
+
+impl ChunkReferences {
+    /// Create an empty reference table
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Register a manifest's chunks and report which ones are new
+    ///
+    /// Registering the same manifest again leaves the table unchanged and
+    /// reports every chunk as reused. A chunk repeated within one layout
+    /// counts as a single reference and uploads once.
+    pub fn add_manifest(&mut self, manifest: &ContentManifest) -> DedupReport {
+        let mut report = DedupReport::default();
+        let layout = &manifest.layout;
+        for (index, (chunk_id, &size)) in layout.chunks.iter().zip(&layout.chunk_sizes).enumerate()
+        {
+            let reference = self
+                .chunks
+                .entry(chunk_id.clone())
+                .or_insert_with(|| ChunkReference {
+                    size,
+                    referenced_by: BTreeSet::new(),
+                });
+            let first_reference = reference.referenced_by.is_empty();
+            reference.referenced_by.insert(manifest.content_id.clone());
+
+            if first_reference {
+                report.new_chunks.push(index);
+                report.new_bytes += u64::from(size);
+            } else {
+                report.reused_chunks += 1;
+                report.reused_bytes += u64::from(size);
+            }
+        }
+        report
+    }
+
+    /// Drop a manifest's references; returns chunks that are now unreferenced
+    pub fn remove_manifest(&mut self, manifest: &ContentManifest) -> Vec<ChunkId> {
+        let mut released = Vec::new();
+        for chunk_id in &manifest.layout.chunks {
+            let Some(reference) = self.chunks.get_mut(chunk_id) else {
+                continue;
+            };
+            reference.referenced_by.remove(&manifest.content_id);
+            if reference.referenced_by.is_empty() {
+                self.chunks.remove(chunk_id);
+                released.push(chunk_id.clone());
+            }
+        }
+        released
+    }
+
+    /// Number of manifests referencing a chunk
+    pub fn reference_count(&self, chunk_id: &ChunkId) -> usize {
+        self.chunks.get(chunk_id).map_or(0, ChunkReference::count)
+    }
+
+    /// Whether a chunk is already stored
+    pub fn contains(&self, chunk_id: &ChunkId) -> bool {
+        self.chunks.contains_key(chunk_id)
+    }
+
+    /// Bytes stored once per distinct chunk
+    pub fn stored_bytes(&self) -> u64 {
+        self.chunks
+            .values()
+            .map(|reference| u64::from(reference.size))
+            .sum()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::chunk::{compute_chunk_layout, ErasureConfig};
+    use crate::types::physical_time_ms;
+    use crate::ChunkManifest;
+
+    fn manifest(name: &[u8], content: &[u8]) -> ContentManifest {
+        let config = ErasureConfig::new(4, 1, 4096).with_content_defined_chunking(256, 1024);
+        let layout = compute_chunk_layout(content, config).unwrap();
+        let chunk_manifests = layout
+            .chunks
+            .iter()
+            .zip(&layout.chunk_sizes)
+            .map(|(id, &size)| ChunkManifest::new(id.clone(), size, vec![], physical_time_ms(1)))
+            .collect();
+        ContentManifest::new(
+            ContentId::from_bytes(name),
+            layout,
+            chunk_manifests,
+            physical_time_ms(1),
+        )
+        .unwrap()
+    }
+
+    fn document(len: usize) -> Vec<u8> {
+        let mut state = 7u64;
+        (0..len)
+            .map(|_| {
+                state = state
+                    .wrapping_mul(6364136223846793005)
+                    .wrapping_add(1442695040888963407);
+                (state >> 33) as u8
+            })
+            .collect()
+    }
+
+    #[test]
+    fn edited_version_reuses_unchanged_chunks() {
+        let original = document(128 * 1024);
+        let mut edited = original.clone();
+        edited.splice(90_000..90_000, b"a new sentence".iter().copied());
+
+        let first = manifest(b"v1", &original);
+        let second = manifest(b"v2", &edited);
+        let mut references = ChunkReferences::new();
+
+        let initial = references.add_manifest(&first);
+        assert_eq!(initial.reused_chunks, 0);
+        let update = references.add_manifest(&second);
+        assert!(
+            update.new_bytes * 4 < update.reused_bytes,
+            "edit should upload a small fraction ({} new, {} reused)",
+            update.new_bytes,
+            update.reused_bytes
+        );
+
+        let released = references.remove_manifest(&first);
+        assert!(!released.is_empty());
+        assert!(released.iter().all(|id| !second.layout.chunks.contains(id)));
+        assert!(second
+            .layout
+            .chunks
+            .iter()
+            .all(|id| references.reference_count(id) == 1));
+
+        references.remove_manifest(&second);
+        assert_eq!(references, ChunkReferences::new());
+    }
+
+    #[test]
+    fn registering_twice_is_idempotent() {
+        let content = document(16 * 1024);
+        let entry = manifest(b"doc", &content);
+        let mut references = ChunkReferences::new();
+
+        let first = references.add_manifest(&entry);
+        assert_eq!(first.new_bytes, references.stored_bytes());
+        let snapshot = references.clone();
+        let second = references.add_manifest(&entry);
+        assert!(second.new_chunks.is_empty());
+        assert_eq!(references, snapshot);
+    }
+}
@@ -0,0 +1,674 @@
+//! Reed-Solomon erasure coding for content chunks
+//!
+//! Content is split into stripes of `data_chunks` data shards of at most
+//! `max_chunk_size` bytes each, and every stripe gets `parity_chunks`
+//! parity shards. The code is systematic. Data shards are stored as they
+//! are, and parity rows come from a Cauchy matrix. Every square submatrix
+//! of the encoding matrix is therefore invertible, so any
+//! [`ErasureConfig::min_chunks`] shards of a stripe rebuild it.
+//!
+//! Encoding and reconstruction both stream. They hold one stripe in memory
+//! and never the whole object. They work on `std::io` readers and writers
+//! because this crate stays synchronous. Async handlers bridge their
+//! streams onto these functions.
+
+mod gf256;
+
+use crate::cdc::{ChunkingStrategy, ContentDefinedChunker, StreamingChunker};
+use crate::chunk::{ChunkLayout, ErasureConfig};
+use aura_core::{AuraError, ChunkId, ContentSize};
+use std::io::{ErrorKind, Read, Write};
+
+/// Systematic Reed-Solomon codec over GF(2^8)
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct ReedSolomon {
+    data_shards: usize,
+    parity_shards: usize,
+    /// Cauchy parity rows, `parity_shards` x `data_shards`
+    parity_matrix: Vec<Vec<u8>>,
+}
+
+impl ReedSolomon {
+    /// Create a codec for `data_shards` data and `parity_shards` parity shards
+    pub fn new(data_shards: usize, parity_shards: usize) -> Result<Self, AuraError> {
+        if data_shards == 0 {
+            return Err(AuraError::invalid(
+                "Erasure coding requires at least one data shard",
+            ));
+        }
+        if data_shards + parity_shards > 256 {
+            return Err(AuraError::invalid(
+                "Erasure coding supports at most 256 shards per stripe",
+            ));
+        }
+
+        // Cauchy matrix 1 / (x_i + y_j) with disjoint x = k.., y = 0..k
+        let parity_matrix = (0..parity_shards)
+            .map(|row| {
+                (0..data_shards)
+                    .map(|col| {
+                        gf256::inv(((data_shards + row) ^ col) as u8)
+                            .ok_or_else(|| AuraError::internal("Degenerate Cauchy matrix"))
+                    })
+                    .collect::<Result<Vec<u8>, AuraError>>()
+            })
+            .collect::<Result<Vec<_>, _>>()?;
+
+        Ok(Self {
+            data_shards,
+            parity_shards,
+            parity_matrix,
+        })
+    }
+
+    /// Create a codec matching an erasure configuration
+    pub fn from_config(config: &ErasureConfig) -> Result<Self, AuraError> {
+        Self::new(
+            usize::from(config.data_chunks),
+            usize::from(config.parity_chunks),
+        )
+    }
+
+    /// Number of data shards per stripe
+    pub fn data_shards(&self) -> usize {
+        self.data_shards
+    }
+
+    /// Number of parity shards per stripe
+    pub fn parity_shards(&self) -> usize {
+        self.parity_shards
+    }
+
+    /// Total shards per stripe
+    pub fn total_shards(&self) -> usize {
+        self.data_shards + self.parity_shards
+    }
+
+    /// Compute parity shards for equal-length data shards
+    pub fn encode(&self, data: &[&[u8]]) -> Result<Vec<Vec<u8>>, AuraError> {
+        let shard_len = data.first().map_or(0, |shard| shard.len());
+        let mut parity = vec![vec![0u8; shard_len]; self.parity_shards];
+        let mut outputs: Vec<&mut [u8]> = parity.iter_mut().map(Vec::as_mut_slice).collect();
+        self.encode_into(data, &mut outputs)?;
+        Ok(parity)
+    }
+
+    /// Compute parity shards into caller-provided buffers
+    pub fn encode_into(&self, data: &[&[u8]], parity: &mut [&mut [u8]]) -> Result<(), AuraError> {
+        if data.len() != self.data_shards || parity.len() != self.parity_shards {
+            return Err(AuraError::invalid("Shard count does not match codec"));
+        }
+        let shard_len = data[0].len();
+        if data.iter().any(|shard| shard.len() != shard_len)
+            || parity.iter().any(|shard| shard.len() != shard_len)
+        {
+            return Err(AuraError::invalid(
+                "Shards in a stripe must share one length",
+            ));
+        }
+
+        for (row, output) in self.parity_matrix.iter().zip(parity.iter_mut()) {
+            output.fill(0);
+            for (&coefficient, shard) in row.iter().zip(data) {
+                gf256::mul_add_slice(coefficient, shard, output);
+            }
+        }
+        Ok(())
+    }
+
+    /// Rebuild every missing shard (data and parity) in place
+    pub fn reconstruct(&self, shards: &mut [Option<Vec<u8>>]) -> Result<(), AuraError> {
+        self.reconstruct_data(shards)?;
+        if shards[self.data_shards..].iter().all(Option::is_some) {
+            return Ok(());
+        }
+
+        let shard_len = present_len(shards)?;
+        let data: Vec<&[u8]> = shards[..self.data_shards]
+            .iter()
+            .map(|shard| shard.as_deref().unwrap_or_default())
+            .collect();
+        let mut rebuilt = Vec::new();
+        for (parity_index, row) in self.parity_matrix.iter().enumerate() {
+            if shards[self.data_shards + parity_index].is_some() {
+                continue;
+            }
+            let mut output = vec![0u8; shard_len];
+            for (&coefficient, shard) in row.iter().zip(&data) {
+                gf256::mul_add_slice(coefficient, shard, &mut output);
+            }
+            rebuilt.push((self.data_shards + parity_index, output));
+        }
+        for (index, output) in rebuilt {
+            shards[index] = Some(output);
+        }
+        Ok(())
+    }
+
+    /// Rebuild missing data shards in place, leaving missing parity absent
+    ///
+    /// Needs any `data_shards` present shards of one length.
+    pub fn reconstruct_data(&self, shards: &mut [Option<Vec<u8>>]) -> Result<(), AuraError> {
+        if shards.len() != self.total_shards() {
+            return Err(AuraError::invalid("Shard count does not match codec"));
+        }
+        let shard_len = present_len(shards)?;
+        if shards[..self.data_shards].iter().all(Option::is_some) {
+            return Ok(());
+        }
+
+        let present: Vec<usize> = shards
+            .iter()
+            .enumerate()
+            .filter_map(|(index, shard)| shard.is_some().then_some(index))
+            .take(self.data_shards)
+            .collect();
+        if present.len() < self.data_shards {
+            return Err(AuraError::invalid(format!(
+                "Reconstruction needs {} shards, only {} available",
+                self.data_shards,
+                present.len()
+            )));
+        }
+
+        let decode = invert(
+            present
+                .iter()
+                .map(|&index| self.encoding_row(index))
+                .collect(),
+        )?;
+        let mut rebuilt = Vec::new();
+        for (data_index, row) in decode.iter().enumerate() {
+            if shards[data_index].is_some() {
+                continue;
+            }
+            let mut output = vec![0u8; shard_len];
+            for (&coefficient, &source) in row.iter().zip(&present) {
+                if let Some(shard) = shards[source].as_deref() {
+                    gf256::mul_add_slice(coefficient, shard, &mut output);
+                }
+            }
+            rebuilt.push((data_index, output));
+        }
+        for (index, output) in rebuilt {
+            shards[index] = Some(output);
+        }
+        Ok(())
+    }
+
+    fn encoding_row(&self, index: usize) -> Vec<u8> {
+        if index < self.data_shards {
+            let mut row = vec![0u8; self.data_shards];
+            row[index] = 1;
+            row
+        } else {
+            self.parity_matrix[index - self.data_shards].clone()
+        }
+    }
+}
+
+fn present_len(shards: &[Option<Vec<u8>>]) -> Result<usize, AuraError> {
+    let mut lengths = shards.iter().flatten().map(Vec::len);
+    let shard_len = lengths
+        .next()
+        .ok_or_else(|| AuraError::invalid("No shards available for reconstruction"))?;
+    if lengths.any(|len| len != shard_len) {
+        return Err(AuraError::invalid(
+            "Shards in a stripe must share one length",
+        ));
+    }
+    Ok(shard_len)
+}
+
+/// Gauss-Jordan inversion of a square matrix over GF(2^8)
+fn invert(mut matrix: Vec<Vec<u8>>) -> Result<Vec<Vec<u8>>, AuraError> {
+    let size = matrix.len();
+    let mut inverse: Vec<Vec<u8>> = (0..size)
+        .map(|row| {
+            let mut identity = vec![0u8; size];
+            identity[row] = 1;
+            identity
+        })
+        .collect();
+
+    for col in 0..size {
+        let pivot = (col..size)
+            .find(|&row| matrix[row][col] != 0)
+            .ok_or_else(|| AuraError::internal("Singular erasure decoding matrix"))?;
+        matrix.swap(col, pivot);
+        inverse.swap(col, pivot);
+
+        let scale = gf256::inv(matrix[col][col])
+            .ok_or_else(|| AuraError::internal("Singular erasure decoding matrix"))?;
+        for value in matrix[col].iter_mut().chain(inverse[col].iter_mut()) {
+            *value = gf256::mul(*value, scale);
+        }
+
+        for row in 0..size {
+            let factor = matrix[row][col];
+            if row == col || factor == 0 {
+                continue;
+            }
+            for k in 0..size {
+                matrix[row][k] ^= gf256::mul(factor, matrix[col][k]);
+                inverse[row][k] ^= gf256::mul(factor, inverse[col][k]);
+            }
+        }
+    }
+    Ok(inverse)
+}
+
+/// A data or parity chunk produced while encoding a stream
+#[derive(Debug, Clone)]
+pub struct EncodedChunk<'a> {
+    /// Content-derived chunk identifier
+    pub chunk_id: ChunkId,
+    /// Stripe the chunk belongs to
+    pub stripe: u32,
+    /// Shard position within the stripe; parity follows the data shards
+    pub shard: u8,
+    /// Whether this is a parity shard
+    pub is_parity: bool,
+    /// Chunk bytes, valid only for the duration of the sink call
+    pub bytes: &'a [u8],
+}
+
+/// Data and parity chunk positions of one stripe within a [`ChunkLayout`]
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct ChunkStripe {
+    /// Layout indices of the stripe's data chunks
+    pub data: std::ops::Range<usize>,
+    /// Layout indices of the stripe's parity chunks
+    pub parity: std::ops::Range<usize>,
+    /// Length every shard in the stripe is padded to
+    pub shard_len: usize,
+}
+
+/// Source of data chunks for [`encode_stream`]
+enum ChunkSource<R> {
+    Fixed { reader: R, exhausted: bool },
+    ContentDefined(StreamingChunker<R>),
+}
+
+impl<R: Read> ChunkSource<R> {
+    fn new(reader: R, erasure_config: &ErasureConfig) -> Result<Self, AuraError> {
+        Ok(match erasure_config.chunking {
+            ChunkingStrategy::Fixed => Self::Fixed {
+                reader,
+                exhausted: false,
+            },
+            ChunkingStrategy::ContentDefined {
+                min_chunk_size,
+                avg_chunk_size,
+            } => Self::ContentDefined(StreamingChunker::new(
+                reader,
+                ContentDefinedChunker::new(
+                    min_chunk_size,
+                    avg_chunk_size,
+                    erasure_config.max_chunk_size,
+                )?,
+            )),
+        })
+    }
+
+    /// Read the next chunk into `out` (sized `max_chunk_size`); 0 at the end
+    fn next_chunk(&mut self, out: &mut [u8]) -> Result<usize, AuraError> {
+        match self {
+            Self::Fixed { reader, exhausted } => {
+                let read = read_full(reader, out)?;
+                *exhausted = read < out.len();
+                Ok(read)
+            }
+            Self::ContentDefined(chunker) => chunker.next_chunk(out),
+        }
+    }
+
+    fn is_exhausted(&self) -> bool {
+        match self {
+            Self::Fixed { exhausted, .. } => *exhausted,
+            Self::ContentDefined(chunker) => chunker.is_exhausted(),
+        }
+    }
+}
+
+/// Chunk and erasure-encode content from a reader
+///
+/// Chunk boundaries follow [`ErasureConfig::chunking`]. Reads one stripe
+/// at a time. Each data and parity chunk goes to `sink`
+/// as soon as it exists, so memory stays at one stripe however large the
+/// content is. Returns the layout: data chunks in content order, then
+/// parity chunks in stripe order.
+pub fn encode_stream<R, F>(
+    reader: R,
+    erasure_config: ErasureConfig,
+    mut sink: F,
+) -> Result<ChunkLayout, AuraError>
+where
+    R: Read,
+    F: FnMut(EncodedChunk<'_>) -> Result<(), AuraError>,
+{
+    let codec = ReedSolomon::from_config(&erasure_config)?;
+    let chunk_size = erasure_config.max_chunk_size as usize;
+    if chunk_size == 0 {
+        return Err(AuraError::invalid("Chunk size must be non-zero"));
+    }
+
+    let mut source = ChunkSource::new(reader, &erasure_config)?;
+    let mut data_shards = vec![vec![0u8; chunk_size]; codec.data_shards()];
+    let mut parity_shards = vec![vec![0u8; chunk_size]; codec.parity_shards()];
+    let (mut data_ids, mut data_sizes) = (Vec::new(), Vec::new());
+    let (mut parity_ids, mut parity_sizes) = (Vec::new(), Vec::new());
+    let mut total_size = 0u64;
+    let mut exhausted = false;
+
+    for stripe in 0u32.. {
+        let mut filled = 0usize;
+        let mut shard_len = 0usize;
+        for (shard_index, shard) in data_shards.iter_mut().enumerate() {
+            let read = source.next_chunk(shard)?;
+            if read == 0 {
+                exhausted = true;
+                break;
+            }
+            exhausted = source.is_exhausted();
+            shard_len = shard_len.max(read);
+            shard[read..].fill(0);
+
+            let chunk_id = ChunkId::from_bytes(&shard[..read]);
+            sink(EncodedChunk {
+                chunk_id: chunk_id.clone(),
+                stripe,
+                shard: shard_index as u8,
+                is_parity: false,
+                bytes: &shard[..read],
+            })?;
+            data_ids.push(chunk_id);
+            data_sizes.push(read as u32);
+            total_size += read as u64;
+            filled += 1;
+            if exhausted {
+                break;
+            }
+        }
+        if filled == 0 {
+            break;
+        }
+
+        // Shards past the end of content encode as zeros
+        for shard in &mut data_shards[filled..] {
+            shard[..shard_len].fill(0);
+        }
+        let data: Vec<&[u8]> = data_shards
+            .iter()
+            .map(|shard| &shard[..shard_len])
+            .collect();
+        let mut parity: Vec<&mut [u8]> = parity_shards
+            .iter_mut()
+            .map(|shard| &mut shard[..shard_len])
+            .collect();
+        codec.encode_into(&data, &mut parity)?;
+
+        for (parity_index, shard) in parity.iter().enumerate() {
+            let chunk_id = ChunkId::from_bytes(shard);
+            sink(EncodedChunk {
+                chunk_id: chunk_id.clone(),
+                stripe,
+                shard: (codec.data_shards() + parity_index) as u8,
+                is_parity: true,
+                bytes: shard,
+            })?;
+            parity_ids.push(chunk_id);
+            parity_sizes.push(shard_len as u32);
+        }
+
+        if exhausted {
+            break;
+        }
+    }
+
+    if total_size == 0 {
+        return Err(AuraError::invalid("Empty content"));
+    }
+
+    data_ids.extend(parity_ids);
+    data_sizes.extend(parity_sizes);
+    ChunkLayout::new(
+        data_ids,
+        data_sizes,
+        ContentSize(total_size),
+        erasure_config,
+    )
+}
+
+/// Reassemble content from any `min_chunks` chunks per stripe
+///
+/// `fetch` is called with a layout index and the expected chunk ID. It
+/// returns the chunk bytes, or `None` if the chunk is unavailable. Data
+/// chunks are requested first. Parity is fetched only for stripes that are
+/// missing data. A chunk whose bytes do not hash to the expected ID is
+/// treated as missing.
+pub fn reconstruct_stream<W, F>(
+    layout: &ChunkLayout,
+    mut fetch: F,
+    mut writer: W,
+) -> Result<(), AuraError>
+where
+    W: Write,
+    F: FnMut(usize, &ChunkId) -> Option<Vec<u8>>,
+{
+    let codec = ReedSolomon::from_config(&layout.erasure_config)?;
+    let data_shards = codec.data_shards();
+
+    for stripe in layout.stripes()? {
+        let mut shards: Vec<Option<Vec<u8>>> = vec![None; codec.total_shards()];
+        let mut available = 0usize;
+
+        for (position, index) in stripe.data.clone().enumerate() {
+            shards[position] = fetch_verified(layout, index, stripe.shard_len, &mut fetch);
+            available += usize::from(shards[position].is_some());
+        }
+        // Shards past the end of content are implicit zeros
+        for shard in &mut shards[stripe.data.len()..data_shards] {
+            *shard = Some(vec![0u8; stripe.shard_len]);
+            available += 1;
+        }
+
+        if available < data_shards {
+            for (offset, index) in stripe.parity.clone().enumerate() {
+                shards[data_shards + offset] =
+                    fetch_verified(layout, index, stripe.shard_len, &mut fetch);
+                available += usize::from(shards[data_shards + offset].is_some());
+                if available >= data_shards {
+                    break;
+                }
+            }
+            codec.reconstruct_data(&mut shards)?;
+        }
+
+        for (position, index) in stripe.data.clone().enumerate() {
+            let size = layout
+                .get_chunk_size(index)
+                .ok_or_else(|| AuraError::invalid("Chunk size missing from layout"))?
+                as usize;
+            let shard = shards[position]
+                .as_deref()
+                .ok_or_else(|| AuraError::internal("Data shard missing after reconstruction"))?;
+            writer
+                .write_all(&shard[..size])
+                .map_err(|e| AuraError::storage(format!("Chunk write failed: {e}")))?;
+        }
+    }
+
+    writer
+        .flush()
+        .map_err(|e| AuraError::storage(format!("Chunk write failed: {e}")))
+}
+
+fn fetch_verified<F>(
+    layout: &ChunkLayout,
+    index: usize,
+    shard_len: usize,
+    fetch: &mut F,
+) -> Option<Vec<u8>>
+where
+    F: FnMut(usize, &ChunkId) -> Option<Vec<u8>>,
+{
+    let expected = layout.get_chunk(index)?;
+    let mut bytes = fetch(index, expected)?;
+    if &ChunkId::from_bytes(&bytes) != expected || bytes.len() > shard_len {
+        return None;
+    }
+    bytes.resize(shard_len, 0);
+    Some(bytes)
+}
+
+pub(crate) fn read_full<R: Read>(reader: &mut R, buffer: &mut [u8]) -> Result<usize, AuraError> {
+    let mut filled = 0;
+    while filled < buffer.len() {
+        match reader.read(&mut buffer[filled..]) {
+            Ok(0) => break,
+            Ok(read) => filled += read,
+            Err(e) if e.kind() == ErrorKind::Interrupted => {}
+            Err(e) => return Err(AuraError::storage(format!("Chunk read failed: {e}"))),
+        }
+    }
+    Ok(filled)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::collections::HashMap;
+
+    fn sample(len: usize) -> Vec<u8> {
+        (0..len).map(|i| (i * 31 + i / 7) as u8).collect()
+    }
+
+    #[test]
+    fn any_min_chunks_shards_rebuild_the_stripe() {
+        let codec = ReedSolomon::new(3, 2).unwrap();
+        let data: Vec<Vec<u8>> = (0..3).map(|i| sample(97 + i)[i..].to_vec()).collect();
+        let data: Vec<&[u8]> = data.iter().map(Vec::as_slice).collect();
+        let parity = codec.encode(&data).unwrap();
+        let full: Vec<Vec<u8>> = data
+            .iter()
+            .map(|shard| shard.to_vec())
+            .chain(parity)
+            .collect();
+
+        // Every way of dropping two of five shards
+        for first in 0..5 {
+            for second in first + 1..5 {
+                let mut shards: Vec<Option<Vec<u8>>> = full.iter().cloned().map(Some).collect();
+                shards[first] = None;
+                shards[second] = None;
+                codec.reconstruct(&mut shards).unwrap();
+                let rebuilt: Vec<Vec<u8>> = shards.into_iter().map(Option::unwrap).collect();
+                assert_eq!(rebuilt, full, "lost shards {first} and {second}");
+            }
+        }
+
+        let mut too_few: Vec<Option<Vec<u8>>> = full.iter().cloned().map(Some).collect();
+        too_few[0] = None;
+        too_few[1] = None;
+        too_few[4] = None;
+        assert!(codec.reconstruct(&mut too_few).is_err());
+    }
+
+    #[test]
+    fn streamed_content_survives_lost_chunks_in_every_stripe() {
+        let config = ErasureConfig::new(3, 2, 64);
+        let content = sample(64 * 7 + 13);
+        let mut stored = HashMap::new();
+        let layout = encode_stream(content.as_slice(), config, |chunk| {
+            stored.insert(chunk.chunk_id, chunk.bytes.to_vec());
+            Ok(())
+        })
+        .unwrap();
+
+        // 8 data chunks in 3 stripes, each stripe with 2 parity chunks
+        assert_eq!(layout.chunk_count(), 8 + 3 * 2);
+        assert_eq!(layout.total_size.0, content.len() as u64);
+
+        // Lose the first data chunk and first parity chunk of every stripe
+        let lost: Vec<usize> = layout
+            .stripes()
+            .unwrap()
+            .into_iter()
+            .flat_map(|stripe| [stripe.data.start, stripe.parity.start])
+            .collect();
+        let mut restored = Vec::new();
+        reconstruct_stream(
+            &layout,
+            |index, chunk_id| {
+                if lost.contains(&index) {
+                    None
+                } else {
+                    stored.get(chunk_id).cloned()
+                }
+            },
+            &mut restored,
+        )
+        .unwrap();
+        assert_eq!(restored, content);
+    }
+
+    #[test]
+    fn content_defined_chunks_survive_lost_chunks() {
+        let config = ErasureConfig::new(3, 1, 512).with_content_defined_chunking(32, 128);
+        let content = sample(4000);
+        let mut stored = HashMap::new();
+        let layout = encode_stream(content.as_slice(), config, |chunk| {
+            stored.insert(chunk.chunk_id, chunk.bytes.to_vec());
+            Ok(())
+        })
+        .unwrap();
+
+        let stripes = layout.stripes().unwrap();
+        assert!(layout.chunk_sizes[..layout.data_chunk_count()]
+            .iter()
+            .any(|&size| size != layout.chunk_sizes[0]));
+        let lost: Vec<usize> = stripes.iter().map(|stripe| stripe.data.start).collect();
+        let mut restored = Vec::new();
+        reconstruct_stream(
+            &layout,
+            |index, chunk_id| {
+                if lost.contains(&index) {
+                    None
+                } else {
+                    stored.get(chunk_id).cloned()
+                }
+            },
+            &mut restored,
+        )
+        .unwrap();
+        assert_eq!(restored, content);
+    }
+
+    #[test]
+    fn corrupted_chunks_count_as_missing() {
+        let config = ErasureConfig::new(2, 1, 16);
+        let content = sample(40);
+        let mut stored = HashMap::new();
+        let layout = encode_stream(content.as_slice(), config, |chunk| {
+            stored.insert(chunk.chunk_id, chunk.bytes.to_vec());
+            Ok(())
+        })
+        .unwrap();
+
+        let mut restored = Vec::new();
+        reconstruct_stream(
+            &layout,
+            |index, chunk_id| {
+                let mut bytes = stored.get(chunk_id).cloned()?;
+                if index == 0 {
+                    bytes[0] ^= 0xff;
+                }
+                Some(bytes)
+            },
+            &mut restored,
+        )
+        .unwrap();
+        assert_eq!(restored, content);
+    }
+}
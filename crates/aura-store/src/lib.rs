@@ -44,6 +44,15 @@
 /// Content addressing and chunk management types
 pub mod chunk;
 
+/// Reed-Solomon erasure coding and streaming chunk encoding
+pub mod erasure;
+
+/// Content-defined chunking with Gear-hash boundaries
+pub mod cdc;
+
+/// Cross-object chunk deduplication by reference count
+pub mod dedup;
+
 /// Storage capability metadata types
 pub mod capabilities;
 
@@ -67,12 +76,18 @@ pub use aura_core::{ChunkId, ContentId, ContentSize};
 
 // Re-export main APIs
 pub use capabilities::{AccessDecision, StorageCapability, StoragePermission, StorageResource};
+pub use cdc::{ChunkingStrategy, ContentDefinedChunker};
 pub use chunk::{
     compute_chunk_layout, plan_chunk_layout_from_size, ChunkLayout, ChunkManifest, ContentManifest,
     ErasureConfig,
 };
 pub use crdt::{StorageIndex, StorageOpLog, StorageOpType, StorageOperation, StorageState};
+pub use dedup::{ChunkReference, ChunkReferences, DedupReport};
+pub use erasure::{encode_stream, reconstruct_stream, ChunkStripe, EncodedChunk, ReedSolomon};
 pub use errors::StorageError;
 pub use facts::{StorageFact, StorageFactDelta, StorageFactReducer, STORAGE_FACT_TYPE_ID};
-pub use search::{SearchIndexEntry, SearchQuery, SearchResults, SearchScope};
+pub use search::{
+    InvertedIndex, RankedHits, SearchHit, SearchIndexEntry, SearchQuery, SearchResults,
+    SearchScope, SEARCH_INDEX_STORAGE_KEY,
+};
 pub use types::{ByteSize, ChunkCount, ChunkIndex, NodeId};
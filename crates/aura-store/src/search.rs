@@ -3,8 +3,15 @@
 //! This module defines pure types and functions for storage search operations,
 //! capability-based result filtering, and privacy-preserving search.
 //!
+//! Ranked retrieval lives in [`InvertedIndex`], which keeps interned terms
+//! and compressed posting lists so queries touch only matching documents.
+//!
 //! **Time System**: Uses `PhysicalTime` for timestamps per the unified time architecture.
 
+mod inverted;
+
+pub use inverted::{InvertedIndex, RankedHits, SearchHit, SEARCH_INDEX_STORAGE_KEY};
+
 use crate::types::physical_time_ms;
 use crate::StorageCapability;
 use aura_core::time::PhysicalTime;
@@ -17,6 +24,25 @@ fn insert_metadata(metadata: &mut BTreeMap<String, String>, key: String, value:
     metadata.insert(key, value);
 }
 
+/// Split content into lowercase index terms, dropping terms of two characters or fewer
+pub fn tokenize(content: &str) -> Vec<String> {
+    content
+        .to_lowercase()
+        .split(|c: char| c.is_whitespace() || c.is_ascii_punctuation())
+        .filter(|s| !s.is_empty() && s.len() > 2) // Filter short terms
+        .map(|s| s.to_string())
+        .collect()
+}
+
+/// Split a query string into lowercase terms
+pub fn query_terms(query: &str) -> BTreeSet<String> {
+    query
+        .to_lowercase()
+        .split_whitespace()
+        .map(|s| s.to_string())
+        .collect()
+}
+
 fn namespace_scope_path(namespace: &str) -> Result<StoragePath, StoragePathError> {
     let trimmed = namespace.trim().trim_end_matches('/');
     let raw = if trimmed == "*" || trimmed == "/*" {
@@ -278,24 +304,16 @@ impl SearchIndexEntry {
     }
 
     /// Check if this entry matches query terms
-    pub fn matches_terms(&self, query_terms: &str) -> bool {
-        let query_words: BTreeSet<String> = query_terms
-            .to_lowercase()
-            .split_whitespace()
-            .map(|s| s.to_string())
-            .collect();
+    pub fn matches_terms(&self, query: &str) -> bool {
+        let query_words = query_terms(query);
 
         // Simple term intersection matching
         !query_words.is_disjoint(&self.terms)
     }
 
     /// Calculate relevance score for query
-    pub fn calculate_score(&self, query_terms: &str) -> f64 {
-        let query_words: BTreeSet<String> = query_terms
-            .to_lowercase()
-            .split_whitespace()
-            .map(|s| s.to_string())
-            .collect();
+    pub fn calculate_score(&self, query: &str) -> f64 {
+        let query_words = query_terms(query);
 
         if query_words.is_empty() || self.terms.is_empty() {
             return 0.0;
@@ -319,13 +337,7 @@ pub fn build_search_index(
     let mut index_entries = Vec::new();
 
     for (content_id, content, capabilities, timestamp) in content_entries {
-        // Simple tokenization (split on whitespace and punctuation)
-        let terms: BTreeSet<String> = content
-            .to_lowercase()
-            .split(|c: char| c.is_whitespace() || c.is_ascii_punctuation())
-            .filter(|s| !s.is_empty() && s.len() > 2) // Filter short terms
-            .map(|s| s.to_string())
-            .collect();
+        let terms: BTreeSet<String> = tokenize(content).into_iter().collect();
 
         let entry = SearchIndexEntry::new(
             content_id.clone(),
@@ -0,0 +1,694 @@
+//! Inverted index with BM25 ranking
+//!
+//! Terms are interned to dense IDs once, at indexing time. Each term keeps a
+//! posting list of `(document, term frequency)` pairs in ascending document
+//! order, delta and varint coded in blocks of 64 postings. Each
+//! block records its last document, so a cursor can skip whole blocks.
+//!
+//! Top-k retrieval walks the query's posting lists document-at-a-time with
+//! MaxScore pruning. Terms whose combined score upper bound cannot lift a
+//! document into the current top k stop driving candidates. They are only
+//! probed for candidates the remaining terms produce, and probing stops as
+//! soon as the partial score plus the remaining bounds falls short.
+
+use aura_core::util::serialization::{from_slice_trusted, to_vec};
+use aura_core::AuraError;
+use serde::{Deserialize, Serialize};
+use std::cmp::{Ordering, Reverse};
+use std::collections::{BTreeMap, BTreeSet, BinaryHeap};
+
+/// Storage key for a persisted search index snapshot
+pub const SEARCH_INDEX_STORAGE_KEY: &str = "search_index/v1";
+
+/// Postings per skip block
+const BLOCK_LEN: u32 = 64;
+
+/// BM25 term frequency saturation
+const BM25_K1: f64 = 1.2;
+
+/// BM25 document length normalization
+const BM25_B: f64 = 0.75;
+
+type TermId = u32;
+type DocId = u32;
+
+/// Skip entry for one posting block
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
+struct PostingBlock {
+    /// Last document in the block
+    last_doc: DocId,
+    /// Byte offset just past the block
+    end: u32,
+}
+
+/// Compressed `(document, term frequency)` postings for one term
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize, Deserialize)]
+struct PostingList {
+    bytes: Vec<u8>,
+    blocks: Vec<PostingBlock>,
+    len: u32,
+    max_term_frequency: u32,
+}
+
+impl PostingList {
+    /// Append a posting; `doc` must exceed every document already present
+    fn push(&mut self, doc: DocId, term_frequency: u32) {
+        let previous = self.blocks.last().map_or(0, |block| block.last_doc);
+        write_varint(&mut self.bytes, doc - previous);
+        write_varint(&mut self.bytes, term_frequency);
+
+        let end = self.bytes.len() as u32;
+        if self.len.is_multiple_of(BLOCK_LEN) {
+            self.blocks.push(PostingBlock { last_doc: doc, end });
+        } else if let Some(block) = self.blocks.last_mut() {
+            *block = PostingBlock { last_doc: doc, end };
+        }
+        self.len += 1;
+        self.max_term_frequency = self.max_term_frequency.max(term_frequency);
+    }
+
+    /// Rebuild without `doc`; removal is rare next to lookups
+    fn remove(&mut self, doc: DocId) {
+        let mut cursor = PostingCursor::new(self);
+        let mut rebuilt = PostingList::default();
+        while let Some(posting) = cursor.current {
+            if posting.0 != doc {
+                rebuilt.push(posting.0, posting.1);
+            }
+            cursor.next();
+        }
+        *self = rebuilt;
+    }
+
+    fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+}
+
+/// Forward-only reader over a posting list
+struct PostingCursor<'a> {
+    list: &'a PostingList,
+    block: usize,
+    offset: usize,
+    previous: DocId,
+    current: Option<(DocId, u32)>,
+}
+
+impl<'a> PostingCursor<'a> {
+    fn new(list: &'a PostingList) -> Self {
+        let mut cursor = Self {
+            list,
+            block: 0,
+            offset: 0,
+            previous: 0,
+            current: None,
+        };
+        cursor.next();
+        cursor
+    }
+
+    fn doc(&self) -> Option<DocId> {
+        self.current.map(|(doc, _)| doc)
+    }
+
+    fn next(&mut self) {
+        let bytes = &self.list.bytes;
+        let decoded = read_varint(bytes, &mut self.offset)
+            .zip(read_varint(bytes, &mut self.offset))
+            .and_then(|(delta, term_frequency)| {
+                Some((self.previous.checked_add(delta)?, term_frequency))
+            });
+        self.current = decoded;
+        if let Some((doc, _)) = decoded {
+            self.previous = doc;
+            while self
+                .list
+                .blocks
+                .get(self.block)
+                .is_some_and(|block| self.offset > block.end as usize)
+            {
+                self.block += 1;
+            }
+        }
+    }
+
+    /// Move to the first posting at or after `target`
+    fn advance_to(&mut self, target: DocId) {
+        if self.doc().is_none_or(|doc| doc >= target) {
+            return;
+        }
+
+        let blocks = &self.list.blocks;
+        let mut block = self.block;
+        while blocks.get(block).is_some_and(|b| b.last_doc < target) {
+            block += 1;
+        }
+        if block == blocks.len() {
+            self.current = None;
+            return;
+        }
+        if block != self.block {
+            let skipped = blocks[block - 1];
+            self.block = block;
+            self.offset = skipped.end as usize;
+            self.previous = skipped.last_doc;
+            self.next();
+        }
+        while self.doc().is_some_and(|doc| doc < target) {
+            self.next();
+        }
+    }
+}
+
+fn write_varint(out: &mut Vec<u8>, mut value: u32) {
+    while value >= 0x80 {
+        out.push((value as u8) | 0x80);
+        value >>= 7;
+    }
+    out.push(value as u8);
+}
+
+fn read_varint(bytes: &[u8], offset: &mut usize) -> Option<u32> {
+    let mut value = 0u32;
+    for shift in (0..35).step_by(7) {
+        let byte = *bytes.get(*offset)?;
+        *offset += 1;
+        value |= u32::from(byte & 0x7f).checked_shl(shift)?;
+        if byte & 0x80 == 0 {
+            return Some(value);
+        }
+    }
+    None
+}
+
+/// Per-document bookkeeping needed for scoring and removal
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+struct IndexedDocument<K> {
+    key: K,
+    length: u32,
+    terms: Vec<TermId>,
+}
+
+/// A ranked document from [`InvertedIndex::top_k`]
+#[derive(Debug, Clone, PartialEq)]
+pub struct SearchHit<'a, K> {
+    /// Document key
+    pub key: &'a K,
+    /// BM25 score
+    pub score: f64,
+}
+
+/// Top-k hits and how many candidates were examined to find them
+#[derive(Debug, Clone, PartialEq)]
+pub struct RankedHits<'a, K> {
+    /// Hits in descending score order, ties broken by indexing order
+    pub hits: Vec<SearchHit<'a, K>>,
+    /// Candidates that passed the filter and were scored. Pruning skips
+    /// documents that cannot reach the top k, so this is a lower bound on
+    /// the number of matching documents.
+    pub examined: usize,
+}
+
+/// Inverted term index over documents keyed by `K`
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+pub struct InvertedIndex<K: Ord = String> {
+    term_ids: BTreeMap<String, TermId>,
+    postings: Vec<PostingList>,
+    doc_ids: BTreeMap<K, DocId>,
+    documents: BTreeMap<DocId, IndexedDocument<K>>,
+    next_doc: DocId,
+    total_length: u64,
+}
+
+impl<K: Ord> Default for InvertedIndex<K> {
+    fn default() -> Self {
+        Self {
+            term_ids: BTreeMap::new(),
+            postings: Vec::new(),
+            doc_ids: BTreeMap::new(),
+            documents: BTreeMap::new(),
+            next_doc: 0,
+            total_length: 0,
+        }
+    }
+}
+
+/// A query term with its cursor and scoring inputs
+struct QueryTerm<'a> {
+    cursor: PostingCursor<'a>,
+    idf: f64,
+    upper_bound: f64,
+}
+
+/// Heap entry; the heap keeps the lowest-ranked hit on top
+#[derive(Debug, Clone, Copy)]
+struct Ranked {
+    score: f64,
+    doc: DocId,
+}
+
+impl Ord for Ranked {
+    fn cmp(&self, other: &Self) -> Ordering {
+        // Higher score ranks first; on ties the earlier document wins
+        self.score
+            .total_cmp(&other.score)
+            .then_with(|| other.doc.cmp(&self.doc))
+    }
+}
+
+impl PartialOrd for Ranked {
+    fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
+        Some(self.cmp(other))
+    }
+}
+
+impl PartialEq for Ranked {
+    fn eq(&self, other: &Self) -> bool {
+        self.cmp(other) == Ordering::Equal
+    }
+}
+
+impl Eq for Ranked {}
+
+impl<K: Ord + Clone> InvertedIndex<K> {
+    /// Create an empty index
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Number of indexed documents
+    pub fn len(&self) -> usize {
+        self.documents.len()
+    }
+
+    /// Check if no documents are indexed
+    pub fn is_empty(&self) -> bool {
+        self.documents.is_empty()
+    }
+
+    /// Check if a document is indexed
+    pub fn contains(&self, key: &K) -> bool {
+        self.doc_ids.contains_key(key)
+    }
+
+    /// Index a document's terms, replacing any previous version
+    ///
+    /// Repeated terms raise the term frequency. Terms are matched exactly;
+    /// callers normalize them (see [`super::tokenize`]).
+    pub fn add_document<'t>(
+        &mut self,
+        key: K,
+        terms: impl IntoIterator<Item = &'t str>,
+    ) -> Result<(), AuraError> {
+        self.remove_document(&key);
+
+        let mut frequencies: BTreeMap<TermId, u32> = BTreeMap::new();
+        let mut length = 0u32;
+        for term in terms {
+            let term_id = self.intern(term)?;
+            *frequencies.entry(term_id).or_default() += 1;
+            length = length.saturating_add(1);
+        }
+
+        let doc = self.next_doc;
+        self.next_doc = doc
+            .checked_add(1)
+            .ok_or_else(|| AuraError::internal("Search index document IDs exhausted"))?;
+        for (&term_id, &term_frequency) in &frequencies {
+            self.postings[term_id as usize].push(doc, term_frequency);
+        }
+        self.total_length += u64::from(length);
+        self.doc_ids.insert(key.clone(), doc);
+        self.documents.insert(
+            doc,
+            IndexedDocument {
+                key,
+                length,
+                terms: frequencies.into_keys().collect(),
+            },
+        );
+        Ok(())
+    }
+
+    /// Drop a document; returns whether it was indexed
+    pub fn remove_document(&mut self, key: &K) -> bool {
+        let Some(doc) = self.doc_ids.remove(key) else {
+            return false;
+        };
+        if let Some(document) = self.documents.remove(&doc) {
+            for term_id in document.terms {
+                self.postings[term_id as usize].remove(doc);
+            }
+            self.total_length -= u64::from(document.length);
+        }
+        true
+    }
+
+    /// Keys of documents containing any of `terms`, in key order
+    pub fn matching<'t>(&self, terms: impl IntoIterator<Item = &'t str>) -> BTreeSet<&K> {
+        let mut keys = BTreeSet::new();
+        for list in self.lookup_lists(terms) {
+            let mut cursor = PostingCursor::new(list);
+            while let Some(doc) = cursor.doc() {
+                if let Some(document) = self.documents.get(&doc) {
+                    keys.insert(&document.key);
+                }
+                cursor.next();
+            }
+        }
+        keys
+    }
+
+    /// The `k` best-scoring documents for `terms` that pass `filter`
+    pub fn top_k<'t>(
+        &self,
+        terms: impl IntoIterator<Item = &'t str>,
+        k: usize,
+        mut filter: impl FnMut(&K) -> bool,
+    ) -> RankedHits<'_, K> {
+        let mut query = self.query_terms(terms);
+        if k == 0 || query.is_empty() {
+            return RankedHits {
+                hits: Vec::new(),
+                examined: 0,
+            };
+        }
+
+        query.sort_by(|a, b| a.upper_bound.total_cmp(&b.upper_bound));
+        // bound_prefix[i]: best total the terms up to and including i can add
+        let bound_prefix: Vec<f64> = query
+            .iter()
+            .scan(0.0, |sum, term| {
+                *sum += term.upper_bound;
+                Some(*sum)
+            })
+            .collect();
+
+        let average_length = self.total_length as f64 / self.documents.len().max(1) as f64;
+        let mut heap: BinaryHeap<Reverse<Ranked>> = BinaryHeap::with_capacity(k + 1);
+        let mut threshold = f64::NEG_INFINITY;
+        let mut first_essential = 0;
+        let mut examined = 0;
+
+        loop {
+            // Terms before first_essential cannot reach the top k on their own
+            while first_essential < query.len() && bound_prefix[first_essential] <= threshold {
+                first_essential += 1;
+            }
+            let Some(candidate) = query[first_essential..]
+                .iter()
+                .filter_map(|term| term.cursor.doc())
+                .min()
+            else {
+                break;
+            };
+            let Some(document) = self.documents.get(&candidate) else {
+                advance_past(&mut query[first_essential..], candidate);
+                continue;
+            };
+            if !filter(&document.key) {
+                advance_past(&mut query[first_essential..], candidate);
+                continue;
+            }
+            examined += 1;
+
+            let normalizer =
+                BM25_K1 * (1.0 - BM25_B + BM25_B * f64::from(document.length) / average_length);
+            let mut score = 0.0;
+            for term in &mut query[first_essential..] {
+                if let Some((doc, term_frequency)) = term.cursor.current {
+                    if doc == candidate {
+                        score += term_score(term.idf, term_frequency, normalizer);
+                        term.cursor.next();
+                    }
+                }
+            }
+            for index in (0..first_essential).rev() {
+                if score + bound_prefix[index] <= threshold {
+                    break;
+                }
+                let term = &mut query[index];
+                term.cursor.advance_to(candidate);
+                if let Some((doc, term_frequency)) = term.cursor.current {
+                    if doc == candidate {
+                        score += term_score(term.idf, term_frequency, normalizer);
+                    }
+                }
+            }
+
+            if heap.len() < k || score > threshold {
+                heap.push(Reverse(Ranked {
+                    score,
+                    doc: candidate,
+                }));
+                if heap.len() > k {
+                    heap.pop();
+                }
+                if heap.len() == k {
+                    threshold = heap
+                        .peek()
+                        .map_or(threshold, |Reverse(lowest)| lowest.score);
+                }
+            }
+        }
+
+        let hits = heap
+            .into_sorted_vec()
+            .into_iter()
+            .filter_map(|Reverse(ranked)| {
+                Some(SearchHit {
+                    key: &self.documents.get(&ranked.doc)?.key,
+                    score: ranked.score,
+                })
+            })
+            .collect();
+        RankedHits { hits, examined }
+    }
+
+    fn intern(&mut self, term: &str) -> Result<TermId, AuraError> {
+        if let Some(&term_id) = self.term_ids.get(term) {
+            return Ok(term_id);
+        }
+        let term_id = TermId::try_from(self.postings.len())
+            .map_err(|_| AuraError::internal("Search index term IDs exhausted"))?;
+        self.term_ids.insert(term.to_string(), term_id);
+        self.postings.push(PostingList::default());
+        Ok(term_id)
+    }
+
+    fn lookup_lists<'t>(&self, terms: impl IntoIterator<Item = &'t str>) -> Vec<&PostingList> {
+        let term_ids: BTreeSet<TermId> = terms
+            .into_iter()
+            .filter_map(|term| self.term_ids.get(term).copied())
+            .collect();
+        term_ids
+            .into_iter()
+            .filter_map(|term_id| self.postings.get(term_id as usize))
+            .filter(|list| !list.is_empty())
+            .collect()
+    }
+
+    fn query_terms<'t>(&self, terms: impl IntoIterator<Item = &'t str>) -> Vec<QueryTerm<'_>> {
+        let documents = self.documents.len() as f64;
+        self.lookup_lists(terms)
+            .into_iter()
+            .map(|list| {
+                let frequency = f64::from(list.len);
+                let idf = (1.0 + (documents - frequency + 0.5) / (frequency + 0.5)).ln();
+                // Document length 0 gives the smallest normalizer
+                let upper_bound =
+                    term_score(idf, list.max_term_frequency, BM25_K1 * (1.0 - BM25_B));
+                QueryTerm {
+                    cursor: PostingCursor::new(list),
+                    idf,
+                    upper_bound,
+                }
+            })
+            .collect()
+    }
+}
+
+impl<K> InvertedIndex<K>
+where
+    K: Ord + Clone + Serialize + for<'de> Deserialize<'de>,
+{
+    /// Encode the index for [`SEARCH_INDEX_STORAGE_KEY`] so it does not have
+    /// to be rebuilt at startup
+    pub fn to_bytes(&self) -> Result<Vec<u8>, AuraError> {
+        to_vec(self).map_err(|error| AuraError::serialization(error.to_string()))
+    }
+
+    /// Decode an index written by [`InvertedIndex::to_bytes`]
+    pub fn from_bytes(bytes: &[u8]) -> Result<Self, AuraError> {
+        from_slice_trusted(bytes).map_err(|error| AuraError::serialization(error.to_string()))
+    }
+}
+
+fn term_score(idf: f64, term_frequency: u32, normalizer: f64) -> f64 {
+    let term_frequency = f64::from(term_frequency);
+    idf * term_frequency * (BM25_K1 + 1.0) / (term_frequency + normalizer)
+}
+
+fn advance_past(terms: &mut [QueryTerm<'_>], doc: DocId) {
+    for term in terms {
+        if term.cursor.doc() == Some(doc) {
+            term.cursor.next();
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn index(documents: &[(&str, &str)]) -> InvertedIndex {
+        let mut index = InvertedIndex::new();
+        for (key, text) in documents {
+            index
+                .add_document(key.to_string(), text.split_whitespace())
+                .unwrap();
+        }
+        index
+    }
+
+    /// Exhaustive BM25 over every document, for checking pruning
+    fn brute_force(index: &InvertedIndex, terms: &[&str]) -> Vec<(String, f64)> {
+        let average = index.total_length as f64 / index.len() as f64;
+        let mut scored: Vec<(DocId, String, f64)> = index
+            .documents
+            .iter()
+            .filter_map(|(&doc, document)| {
+                let normalizer =
+                    BM25_K1 * (1.0 - BM25_B + BM25_B * f64::from(document.length) / average);
+                let score: f64 = index
+                    .query_terms(terms.iter().copied())
+                    .into_iter()
+                    .filter_map(|mut term| {
+                        term.cursor.advance_to(doc);
+                        let (found, tf) = term.cursor.current?;
+                        (found == doc).then(|| term_score(term.idf, tf, normalizer))
+                    })
+                    .sum();
+                (score > 0.0).then(|| (doc, document.key.clone(), score))
+            })
+            .collect();
+        scored.sort_by(|a, b| b.2.total_cmp(&a.2).then(a.0.cmp(&b.0)));
+        scored
+            .into_iter()
+            .map(|(_, key, score)| (key, score))
+            .collect()
+    }
+
+    #[test]
+    fn posting_lists_skip_across_blocks() {
+        let mut list = PostingList::default();
+        let docs: Vec<DocId> = (0..500).map(|i| i * 3 + 1).collect();
+        for &doc in &docs {
+            list.push(doc, doc % 5 + 1);
+        }
+
+        let mut cursor = PostingCursor::new(&list);
+        for target in [0, 2, 200, 201, 1000, 1498] {
+            cursor.advance_to(target);
+            let expected = docs.iter().copied().find(|&doc| doc >= target);
+            assert_eq!(cursor.doc(), expected, "advance_to({target})");
+        }
+        cursor.advance_to(1500);
+        assert_eq!(cursor.doc(), None);
+
+        list.remove(301);
+        let remaining: Vec<DocId> = {
+            let mut cursor = PostingCursor::new(&list);
+            std::iter::from_fn(|| {
+                let doc = cursor.doc()?;
+                cursor.next();
+                Some(doc)
+            })
+            .collect()
+        };
+        assert_eq!(remaining.len(), docs.len() - 1);
+        assert!(!remaining.contains(&301));
+    }
+
+    #[test]
+    fn ranks_rare_and_frequent_terms_with_bm25() {
+        let index = index(&[
+            ("a", "rust storage engine"),
+            ("b", "rust rust rust compiler"),
+            ("c", "storage replication storage"),
+            ("d", "unrelated words only"),
+        ]);
+
+        let ranked = index.top_k(["rust"], 10, |_| true);
+        let keys: Vec<&str> = ranked.hits.iter().map(|hit| hit.key.as_str()).collect();
+        assert_eq!(keys, ["b", "a"]);
+
+        let ranked = index.top_k(["storage", "engine"], 1, |_| true);
+        assert_eq!(ranked.hits[0].key, "a");
+        assert!(index.top_k(["missing"], 10, |_| true).hits.is_empty());
+    }
+
+    #[test]
+    fn pruned_top_k_matches_exhaustive_scoring() {
+        let vocabulary = ["alpha", "beta", "gamma", "delta", "omega", "sigma", "kappa"];
+        let mut state = 11u64;
+        let documents: Vec<(String, String)> = (0..400)
+            .map(|doc| {
+                let words: Vec<&str> = (0..3 + doc % 9)
+                    .map(|_| {
+                        state = state
+                            .wrapping_mul(6364136223846793005)
+                            .wrapping_add(1442695040888963407);
+                        // Skew toward the front of the vocabulary
+                        let pick = ((state >> 33) % 64) as usize;
+                        vocabulary[(pick * pick / 600).min(vocabulary.len() - 1)]
+                    })
+                    .collect();
+                (format!("doc{doc}"), words.join(" "))
+            })
+            .collect();
+        let mut index = InvertedIndex::new();
+        for (key, text) in &documents {
+            index
+                .add_document(key.clone(), text.split_whitespace())
+                .unwrap();
+        }
+
+        let query = ["alpha", "gamma", "kappa"];
+        let expected = brute_force(&index, &query);
+        let ranked = index.top_k(query, 10, |_| true);
+        let actual: Vec<(String, f64)> = ranked
+            .hits
+            .iter()
+            .map(|hit| (hit.key.clone(), hit.score))
+            .collect();
+        assert_eq!(actual.len(), 10);
+        for ((key, score), (expected_key, expected_score)) in actual.iter().zip(&expected) {
+            assert_eq!(key, expected_key);
+            assert!((score - expected_score).abs() < 1e-9);
+        }
+        assert!(
+            ranked.examined < expected.len(),
+            "pruning should skip candidates"
+        );
+    }
+
+    #[test]
+    fn updates_and_persistence_keep_the_index_consistent() {
+        let mut index = index(&[("a", "old text"), ("b", "other text")]);
+        index
+            .add_document("a".to_string(), "new words".split_whitespace())
+            .unwrap();
+        assert!(index.matching(["old"]).is_empty());
+        assert_eq!(
+            index.matching(["text"]).into_iter().collect::<Vec<_>>(),
+            ["b"]
+        );
+        assert!(index.remove_document(&"b".to_string()));
+        assert!(!index.remove_document(&"b".to_string()));
+
+        let restored = InvertedIndex::<String>::from_bytes(&index.to_bytes().unwrap()).unwrap();
+        assert_eq!(restored, index);
+        assert_eq!(restored.top_k(["words"], 5, |_| true).hits[0].key, "a");
+    }
+}
@@ -0,0 +1,112 @@
+#![allow(missing_docs)]
+
+use aura_core::{AttestedOp, ContextId, DeviceId, Epoch, Hash32, TreeOp, TreeOpKind};
+use aura_guards::{
+    DecodedIngress, IngressSource, IngressVerificationEvidence, VerifiedIngress,
+    VerifiedIngressMetadata, REQUIRED_INGRESS_VERIFICATION_CHECKS,
+};
+use aura_sync::protocols::anti_entropy::{
+    AntiEntropyProtocol, FingerprintIndex, VerifiedRemoteOpsBatch,
+};
+use criterion::{black_box, criterion_group, criterion_main, BatchSize, BenchmarkId, Criterion};
+
+const BATCH_SIZE: usize = 100;
+
+fn op(ordinal: u64) -> AttestedOp {
+    AttestedOp {
+        op: TreeOp {
+            parent_epoch: Epoch::new(ordinal),
+            parent_commitment: [0u8; 32],
+            op: TreeOpKind::RotateEpoch { affected: vec![] },
+            version: 1,
+        },
+        agg_sig: ordinal.to_le_bytes().to_vec(),
+        signer_count: 1,
+    }
+}
+
+fn verified(ops: Vec<AttestedOp>) -> VerifiedIngress<VerifiedRemoteOpsBatch> {
+    let batch = VerifiedRemoteOpsBatch::new(ops);
+    let metadata = VerifiedIngressMetadata::new(
+        IngressSource::Device(DeviceId::new_from_entropy([7u8; 32])),
+        ContextId::new_from_entropy([9u8; 32]),
+        None,
+        Hash32::from_value(&batch).expect("hash batch"),
+        1,
+    );
+    let evidence =
+        IngressVerificationEvidence::new(metadata.clone(), REQUIRED_INGRESS_VERIFICATION_CHECKS)
+            .expect("complete ingress evidence");
+    DecodedIngress::new(batch, metadata)
+        .verify(evidence)
+        .expect("verified batch")
+}
+
+fn catch_up_batches(total: u64) -> Vec<VerifiedIngress<VerifiedRemoteOpsBatch>> {
+    (0..total)
+        .map(op)
+        .collect::<Vec<_>>()
+        .chunks(BATCH_SIZE)
+        .map(|chunk| verified(chunk.to_vec()))
+        .collect()
+}
+
+fn bench_catch_up(c: &mut Criterion) {
+    let protocol = AntiEntropyProtocol::default();
+    let mut group = c.benchmark_group("anti_entropy_catch_up");
+    group.sample_size(10);
+
+    for total in [1_000_u64, 10_000, 100_000] {
+        group.bench_with_input(
+            BenchmarkId::new("fingerprint_index", total),
+            &total,
+            |b, &total| {
+                b.iter_batched(
+                    || catch_up_batches(total),
+                    |batches| {
+                        let mut index = FingerprintIndex::new();
+                        for batch in batches {
+                            let result = protocol
+                                .merge_batch_into(&mut index, batch)
+                                .expect("merge batch");
+                            black_box(result.applied);
+                        }
+                        black_box(index.len());
+                    },
+                    BatchSize::LargeInput,
+                );
+            },
+        );
+
+        // The rebuild-per-batch reference is quadratic; 100k ops would take
+        // minutes per sample, so it only runs at the smaller sizes.
+        if total > 10_000 {
+            continue;
+        }
+        group.bench_with_input(
+            BenchmarkId::new("rebuild_per_batch_reference", total),
+            &total,
+            |b, &total| {
+                b.iter_batched(
+                    || catch_up_batches(total),
+                    |batches| {
+                        let mut local_ops = Vec::new();
+                        for batch in batches {
+                            let result = protocol
+                                .merge_batch(&mut local_ops, batch)
+                                .expect("merge batch");
+                            black_box(result.applied);
+                        }
+                        black_box(local_ops.len());
+                    },
+                    BatchSize::LargeInput,
+                );
+            },
+        );
+    }
+
+    group.finish();
+}
+
+criterion_group!(benches, bench_catch_up);
+criterion_main!(benches);
@@ -835,10 +835,13 @@ impl MetricsCollector {
     }
 
     /// Export metrics in Prometheus format
+    ///
+    /// Hot-path stage latencies from the global
+    /// [`aura_core::latency`] recorder are appended when one is installed.
     pub fn export_prometheus(&self) -> String {
         let snapshot = self.export_snapshot(0);
 
-        format!(
+        let mut output = format!(
             "# HELP aura_sync_sessions_total Total number of sync sessions initiated\n\
             # TYPE aura_sync_sessions_total counter\n\
             aura_sync_sessions_total {}\n\
@@ -877,7 +880,11 @@ impl MetricsCollector {
             snapshot.errors.protocol_errors_total,
             snapshot.errors.timeout_errors_total,
             snapshot.errors.validation_errors_total
-        )
+        );
+        if let Some(recorder) = aura_core::latency::global() {
+            output.push_str(&recorder.snapshot().export_prometheus());
+        }
+        output
     }
 }
 
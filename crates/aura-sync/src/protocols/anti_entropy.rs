@@ -42,17 +42,18 @@
 use std::collections::HashSet;
 use std::time::Duration;
 
+use parking_lot::Mutex;
 use serde::{Deserialize, Serialize};
 
 use crate::capabilities::SyncCapability;
 use crate::core::{
-    binary_serialize, exchange_json_with_peer, json_serialize, send_bytes_to_peer,
-    sync_biscuit_guard_error, sync_session_error, SyncResult,
+    binary_serialize, exchange_json_with_peer, json_serialize, receive_json_from_expected_peer,
+    send_bytes_to_peer, sync_biscuit_guard_error, sync_session_error, SyncResult,
 };
 use crate::infrastructure::RetryPolicy;
 use crate::protocols::journal_apply::JournalApplyService;
 use aura_authorization::{BiscuitTokenManager, VerifiedBiscuitToken};
-use aura_core::effects::{JournalEffects, NetworkEffects, PhysicalTimeEffects};
+use aura_core::effects::{Ed25519BatchItem, JournalEffects, NetworkEffects, PhysicalTimeEffects};
 use aura_core::types::scope::ResourceScope;
 use aura_core::types::Epoch;
 use aura_core::{
@@ -64,13 +65,28 @@ use aura_guards::{
     IngressVerificationError, IngressVerificationEvidence, VerifiedIngress,
     VerifiedIngressMetadata, REQUIRED_INGRESS_VERIFICATION_CHECKS,
 };
-use aura_journal::commitment_tree::apply_structurally_verified;
+use aura_journal::commitment_tree::{apply_structurally_verified, TreeState};
 use aura_protocol::effects::TreeEffects;
 
+mod digest_accumulator;
+mod fingerprint_index;
+mod range_digest;
+
+pub use digest_accumulator::JournalDigestAccumulator;
+pub use fingerprint_index::{FingerprintIndex, FingerprintedOp, DEFAULT_FINGERPRINT_HORIZON};
+pub use range_digest::{
+    FingerprintRange, RangeDigestIndex, RangeDigestMessage, RangeEntry, RangePayload,
+    RangeReconciler, RangeReconciliationStep,
+};
+
 const ANTI_ENTROPY_OPERATION_ID: &str = "anti_entropy";
 const ANTI_ENTROPY_AUTHZ_OPERATION_ID: &str = "anti_entropy.authorize";
 const ANTI_ENTROPY_PROGRESS_OPERATION_ID: &str = "anti_entropy.progress";
-const ANTI_ENTROPY_SCHEMA_VERSION: u16 = 1;
+/// Version 2 tags every peer request with [`AntiEntropyPeerRequest`];
+/// version 1 sent the bare digest, operation request or pushed batch.
+const ANTI_ENTROPY_SCHEMA_VERSION: u16 = 2;
+/// Upper bound on range-digest exchange rounds before reconciliation is abandoned
+const MAX_RANGE_DIGEST_ROUNDS: u32 = 64;
 
 // =============================================================================
 // Types
@@ -144,6 +160,56 @@ pub struct AntiEntropyRequest {
     pub missing_operations: Vec<OperationFingerprint>,
 }
 
+/// Message sent by an initiating peer to an anti-entropy responder
+///
+/// Requests are tagged so [`AntiEntropyProtocol::serve_peer_request`] can
+/// dispatch them; replies are the bare payload the initiator expects.
+#[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
+pub enum AntiEntropyPeerRequest {
+    /// Exchange journal digests; answered with the responder's digest
+    Digest(JournalDigest),
+    /// Request operations by index or fingerprint; answered with operations
+    Operations(AntiEntropyRequest),
+    /// One round of a range-digest exchange; answered with the next round
+    RangeDigest(RangeDigestMessage),
+    /// Operations pushed to the responder; no reply is sent
+    Push(Vec<AttestedOp>),
+}
+
+/// Every request shape a responder accepts, current format first
+///
+/// Schema-version-1 peers send the bare digest, operation request or pushed
+/// batch; those payloads are translated into the matching
+/// [`AntiEntropyPeerRequest`] variant so older initiators can still be served.
+#[derive(Deserialize)]
+#[serde(untagged)]
+enum PeerRequestWire {
+    Current(AntiEntropyPeerRequest),
+    V1Push(Vec<AttestedOp>),
+    V1Digest(JournalDigest),
+    V1Operations(AntiEntropyRequest),
+}
+
+impl From<PeerRequestWire> for AntiEntropyPeerRequest {
+    fn from(request: PeerRequestWire) -> Self {
+        match request {
+            PeerRequestWire::Current(request) => request,
+            PeerRequestWire::V1Push(operations) => Self::Push(operations),
+            PeerRequestWire::V1Digest(digest) => Self::Digest(digest),
+            PeerRequestWire::V1Operations(request) => Self::Operations(request),
+        }
+    }
+}
+
+/// Outcome of serving one peer request
+#[derive(Debug, Clone, PartialEq)]
+pub enum AntiEntropyServed {
+    /// The request was answered
+    Replied,
+    /// The peer pushed operations, which still need verification and merge
+    Pushed(Vec<AttestedOp>),
+}
+
 /// Remote anti-entropy operations that have passed batch-level verification and
 /// are eligible for the canonical apply boundary.
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq, Eq)]
@@ -439,6 +505,21 @@ pub struct AntiEntropyConfig {
 
     /// Timeout for operation transfer
     pub transfer_timeout: Duration,
+
+    /// Strategy used when digests report divergent histories
+    #[serde(default)]
+    pub reconciliation: ReconciliationMode,
+}
+
+/// How diverged operation logs are reconciled
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default, Serialize, Deserialize)]
+pub enum ReconciliationMode {
+    /// Re-pull the log from index zero in `batch_size` chunks
+    #[default]
+    PrefixReplay,
+    /// Exchange hierarchical fingerprint-range digests and transfer only the
+    /// symmetric difference through `AntiEntropyRequest::missing_operations`
+    RangeDigest(RangeReconciler),
 }
 
 impl Default for AntiEntropyConfig {
@@ -452,6 +533,7 @@ impl Default for AntiEntropyConfig {
                 .with_initial_delay(Duration::from_millis(100)),
             digest_timeout: Duration::from_secs(10),
             transfer_timeout: Duration::from_secs(30),
+            reconciliation: ReconciliationMode::default(),
         }
     }
 }
@@ -476,6 +558,10 @@ pub struct AntiEntropyProtocol {
     token_manager: Option<BiscuitTokenManager>,
     /// Optional Biscuit guard evaluator for permission checks
     guard_evaluator: Option<std::sync::Arc<BiscuitGuardEvaluator>>,
+    /// Running digest of the local journal, shared across clones
+    local_digest: std::sync::Arc<Mutex<JournalDigestAccumulator>>,
+    /// Fingerprints of remote ops already applied, shared across clones
+    applied_index: std::sync::Arc<Mutex<FingerprintIndex>>,
 }
 
 impl AntiEntropyProtocol {
@@ -520,6 +606,8 @@ impl AntiEntropyProtocol {
             config,
             token_manager: None,
             guard_evaluator: None,
+            local_digest: std::sync::Arc::default(),
+            applied_index: std::sync::Arc::default(),
         }
     }
 
@@ -533,6 +621,8 @@ impl AntiEntropyProtocol {
             config,
             token_manager: Some(token_manager),
             guard_evaluator: Some(std::sync::Arc::new(guard_evaluator)),
+            local_digest: std::sync::Arc::default(),
+            applied_index: std::sync::Arc::default(),
         }
     }
 
@@ -739,8 +829,8 @@ impl AntiEntropyProtocol {
         // this would come from the journal's operation log
         let local_ops: Vec<AttestedOp> = vec![];
 
-        // Step 2: Compute local digest
-        let local_digest = self.compute_digest(&local_journal, &local_ops)?;
+        // Step 2: Compute local digest, absorbing only what changed since the last round
+        let local_digest = self.local_digest(&local_journal, &local_ops)?;
 
         // Step 3: Exchange digests with peer
         let remote_digest = self
@@ -823,7 +913,7 @@ impl AntiEntropyProtocol {
                 &peer,
                 "digest",
                 "digest",
-                local_digest,
+                &AntiEntropyPeerRequest::Digest(local_digest.clone()),
                 "digest",
                 "digest",
             )
@@ -858,11 +948,25 @@ impl AntiEntropyProtocol {
             .plan_request(local_digest, remote_digest)
             .ok_or_else(|| sync_session_error("No operations needed despite LocalBehind status"))?;
 
+        self.pull_requested_operations(effects, peer, request).await
+    }
+
+    /// Send a planned request to the peer and merge the operations it returns
+    async fn pull_requested_operations<E>(
+        &self,
+        effects: &E,
+        peer: DeviceId,
+        request: AntiEntropyRequest,
+    ) -> SyncResult<AntiEntropyResult>
+    where
+        E: JournalEffects + NetworkEffects + TreeEffects + Send + Sync,
+    {
         tracing::debug!(
             operation_id = ANTI_ENTROPY_OPERATION_ID,
             peer_id = %peer,
             max_ops = request.max_ops,
             from_index = request.from_index,
+            targeted_ops = request.missing_operations.len(),
             "Requesting operations from peer"
         );
 
@@ -873,7 +977,7 @@ impl AntiEntropyProtocol {
                 &peer,
                 "request",
                 "operation request",
-                &request,
+                &AntiEntropyPeerRequest::Operations(request.clone()),
                 "operations",
                 "operations",
             )
@@ -899,7 +1003,6 @@ impl AntiEntropyProtocol {
             );
 
             // Merge operations into local state
-            let mut local_ops = vec![]; // In full implementation, get from journal
             let merge_chunk_size = self.merge_chunk_size();
             let merge_batch_count =
                 Self::merge_batch_count(remote_ops.payload().len(), merge_chunk_size);
@@ -933,7 +1036,20 @@ impl AntiEntropyProtocol {
             {
                 let verified_chunk =
                     verified_remote_ops_batch(remote_ops.evidence().metadata(), chunk.to_vec())?;
-                let merge_result = self.merge_batch(&mut local_ops, verified_chunk)?;
+                let (fresh, duplicates) = {
+                    let (batch, _) = verified_chunk.into_parts();
+                    self.applied_index
+                        .lock()
+                        .admit(batch.ops)
+                        .map_err(|e| sync_session_error(format!("Failed to fingerprint: {e}")))?
+                };
+                let merge_result = AntiEntropyResult {
+                    applied: fresh.len() as u64,
+                    duplicates,
+                    applied_ops: fresh.iter().map(|entry| entry.op.clone()).collect(),
+                    final_status: None,
+                    rounds: 1,
+                };
 
                 tracing::debug!(
                     operation_id = ANTI_ENTROPY_PROGRESS_OPERATION_ID,
@@ -957,8 +1073,17 @@ impl AntiEntropyProtocol {
                         "Applied new operations from peer"
                     );
 
-                    self.persist_applied_operations_chunk(effects, peer, &merge_result.applied_ops)
-                        .await?;
+                    if let Err(error) = self
+                        .persist_applied_operations_chunk(effects, peer, &merge_result.applied_ops)
+                        .await
+                    {
+                        // Release the admitted fingerprints so a failed chunk
+                        // is retried rather than treated as duplicate.
+                        self.applied_index
+                            .lock()
+                            .forget(fresh.iter().map(|entry| &entry.fingerprint));
+                        return Err(error);
+                    }
                 }
 
                 total_result.applied += merge_result.applied;
@@ -1039,60 +1164,108 @@ impl AntiEntropyProtocol {
             )
         })?;
 
+        // Signatures the tree handler can detach are verified as one batch once
+        // the structural walk is done. The walk stops at the first failure,
+        // which is only reported if every signature before it verifies, so
+        // errors match a sequential op-by-op check.
         let mut seen_fingerprints = HashSet::with_capacity(incoming.len());
+        let mut pending_signatures = PendingAggregateSignatures::default();
+        let mut first_failure = None;
         for (index, op) in incoming.iter().enumerate() {
-            let fingerprint = fingerprint(op).map_err(|error| {
-                crate::core::errors::sync_protocol_with_peer(
-                    "anti_entropy",
-                    format!("fingerprint remote operation {index} failed: {error}"),
+            if let Err(error) = self
+                .admit_remote_operation(
+                    effects,
                     peer,
+                    index,
+                    op,
+                    &mut shadow_state,
+                    &mut seen_fingerprints,
+                    &mut pending_signatures,
                 )
-            })?;
-
-            if !seen_fingerprints.insert(fingerprint) {
-                return Err(crate::core::errors::sync_protocol_with_peer(
-                    "anti_entropy",
-                    format!(
-                        "remote operation batch replayed fingerprint {} at index {}",
-                        hex::encode(fingerprint),
-                        index
-                    ),
-                    peer,
-                ));
-            }
-
-            let signature_valid = effects
-                .verify_aggregate_sig(op, &shadow_state)
                 .await
-                .map_err(|error| {
-                    crate::core::errors::sync_protocol_with_peer(
-                        "anti_entropy",
-                        format!("remote operation {index} signature verification failed: {error}"),
-                        peer,
-                    )
-                })?;
-            if !signature_valid {
-                return Err(crate::core::errors::sync_protocol_with_peer(
-                    "anti_entropy",
-                    format!("remote operation {index} failed signature verification"),
-                    peer,
-                ));
+            {
+                first_failure = Some(error);
+                break;
             }
+        }
 
-            apply_structurally_verified(&mut shadow_state, op).map_err(|error| {
-                crate::core::errors::sync_protocol_with_peer(
-                    "anti_entropy",
-                    format!(
-                        "remote operation {index} failed causal or parent verification: {error}"
-                    ),
-                    peer,
-                )
-            })?;
+        pending_signatures.verify(effects, peer).await?;
+        if let Some(error) = first_failure {
+            return Err(error);
         }
 
         verified_remote_ops_batch(&metadata, incoming)
     }
 
+    /// Replay-check one remote op, queue or run its signature check, and
+    /// apply it to the shadow state used for the ops that follow.
+    #[allow(clippy::too_many_arguments)]
+    async fn admit_remote_operation<E>(
+        &self,
+        effects: &E,
+        peer: DeviceId,
+        index: usize,
+        op: &AttestedOp,
+        shadow_state: &mut TreeState,
+        seen_fingerprints: &mut HashSet<OperationFingerprint>,
+        pending_signatures: &mut PendingAggregateSignatures,
+    ) -> SyncResult<()>
+    where
+        E: TreeEffects + Send + Sync,
+    {
+        let fingerprint = fingerprint(op).map_err(|error| {
+            crate::core::errors::sync_protocol_with_peer(
+                "anti_entropy",
+                format!("fingerprint remote operation {index} failed: {error}"),
+                peer,
+            )
+        })?;
+
+        if !seen_fingerprints.insert(fingerprint) {
+            return Err(crate::core::errors::sync_protocol_with_peer(
+                "anti_entropy",
+                format!(
+                    "remote operation batch replayed fingerprint {} at index {}",
+                    hex::encode(fingerprint),
+                    index
+                ),
+                peer,
+            ));
+        }
+
+        let signature_error = |error: AuraError| {
+            crate::core::errors::sync_protocol_with_peer(
+                "anti_entropy",
+                format!("remote operation {index} signature verification failed: {error}"),
+                peer,
+            )
+        };
+        match effects
+            .aggregate_sig_check(op, shadow_state)
+            .await
+            .map_err(signature_error)?
+        {
+            Some(check) => pending_signatures.push(index, check),
+            None => {
+                let signature_valid = effects
+                    .verify_aggregate_sig(op, shadow_state)
+                    .await
+                    .map_err(signature_error)?;
+                if !signature_valid {
+                    return Err(invalid_remote_signature(peer, index));
+                }
+            }
+        }
+
+        apply_structurally_verified(shadow_state, op).map_err(|error| {
+            crate::core::errors::sync_protocol_with_peer(
+                "anti_entropy",
+                format!("remote operation {index} failed causal or parent verification: {error}"),
+                peer,
+            )
+        })
+    }
+
     async fn verify_and_apply_remote_operation<E>(
         &self,
         effects: &E,
@@ -1222,7 +1395,20 @@ impl AntiEntropyProtocol {
     {
         // Determine which operations to send
         let ops_to_send = self.operations_to_push(local_ops, local_digest, remote_digest);
+        self.send_operations_to_peer(effects, peer, ops_to_send)
+            .await
+    }
 
+    /// Serialize and send a slice of operations to the peer
+    async fn send_operations_to_peer<E>(
+        &self,
+        effects: &E,
+        peer: DeviceId,
+        ops_to_send: &[AttestedOp],
+    ) -> SyncResult<()>
+    where
+        E: NetworkEffects + Send + Sync,
+    {
         tracing::debug!(
             operation_id = ANTI_ENTROPY_OPERATION_ID,
             peer_id = %peer,
@@ -1232,7 +1418,11 @@ impl AntiEntropyProtocol {
 
         if !ops_to_send.is_empty() {
             // Serialize operations
-            let ops_data = json_serialize("operations", "operations", ops_to_send)?;
+            let ops_data = json_serialize(
+                "operations",
+                "operations",
+                &AntiEntropyPeerRequest::Push(ops_to_send.to_vec()),
+            )?;
             send_bytes_to_peer(effects, peer.0, &peer, "operations", ops_data).await?;
 
             tracing::info!(
@@ -1266,6 +1456,12 @@ impl AntiEntropyProtocol {
             "Diverged state detected with peer"
         );
 
+        if let ReconciliationMode::RangeDigest(reconciler) = self.config.reconciliation {
+            return self
+                .reconcile_by_range_digest(effects, peer, local_ops, &reconciler)
+                .await;
+        }
+
         // For diverged state, we do a full exchange:
         // 1. Send all our operations to peer
         // 2. Request all operations from peer
@@ -1283,6 +1479,155 @@ impl AntiEntropyProtocol {
         Ok(Self::with_status(DigestStatus::Diverged, pull_result))
     }
 
+    /// Reconcile diverged logs by exchanging fingerprint-range digests
+    ///
+    /// Only the symmetric difference is transferred: operations the peer lacks
+    /// are pushed directly, and operations we lack are requested by
+    /// fingerprint through `AntiEntropyRequest::missing_operations`.
+    async fn reconcile_by_range_digest<E>(
+        &self,
+        effects: &E,
+        peer: DeviceId,
+        local_ops: &[AttestedOp],
+        reconciler: &RangeReconciler,
+    ) -> SyncResult<AntiEntropyResult>
+    where
+        E: JournalEffects + NetworkEffects + TreeEffects + Send + Sync,
+    {
+        let fingerprints = fingerprint_all(local_ops)?;
+        let index = RangeDigestIndex::from_fingerprints(fingerprints.iter().copied());
+
+        let mut local_missing = Vec::new();
+        let mut remote_missing = Vec::new();
+        let mut message = reconciler.initiate(&index);
+        let mut rounds = 0u32;
+
+        while !message.is_empty() {
+            if rounds >= MAX_RANGE_DIGEST_ROUNDS {
+                return Err(sync_session_error(format!(
+                    "range digest reconciliation with peer {peer} did not converge within {MAX_RANGE_DIGEST_ROUNDS} rounds"
+                )));
+            }
+            rounds += 1;
+
+            let reply: RangeDigestMessage = exchange_json_with_peer(
+                effects,
+                peer.0,
+                &peer,
+                "range_digest",
+                "range digest",
+                &AntiEntropyPeerRequest::RangeDigest(message),
+                "range_digest",
+                "range digest",
+            )
+            .await?;
+            let step = reconciler.respond(&index, &reply)?;
+            local_missing.extend(step.local_missing);
+            remote_missing.extend(step.remote_missing);
+            message = step.reply;
+        }
+
+        tracing::debug!(
+            operation_id = ANTI_ENTROPY_OPERATION_ID,
+            peer_id = %peer,
+            rounds,
+            local_missing = local_missing.len(),
+            remote_missing = remote_missing.len(),
+            "Range digest reconciliation converged with peer"
+        );
+
+        if !remote_missing.is_empty() {
+            let remote_missing: HashSet<_> = remote_missing.into_iter().collect();
+            let ops_to_send: Vec<AttestedOp> = local_ops
+                .iter()
+                .zip(&fingerprints)
+                .filter(|(_, fp)| remote_missing.contains(*fp))
+                .map(|(op, _)| op.clone())
+                .collect();
+            for chunk in ops_to_send.chunks(self.merge_chunk_size()) {
+                self.send_operations_to_peer(effects, peer, chunk).await?;
+            }
+        }
+
+        let mut result = AntiEntropyResult::default();
+        for chunk in local_missing.chunks(self.merge_chunk_size()) {
+            let request = self.plan_targeted_request(chunk.to_vec());
+            let pulled = self
+                .pull_requested_operations(effects, peer, request)
+                .await?;
+            result.applied += pulled.applied;
+            result.duplicates += pulled.duplicates;
+        }
+
+        Ok(Self::with_status(DigestStatus::Diverged, result))
+    }
+
+    /// Answer one request from a peer running [`Self::execute`]
+    ///
+    /// Digest, operation and range-digest requests are answered from
+    /// `local_journal` and `local_ops`. Pushed operations are handed back
+    /// unverified so the caller admits them through the verified merge path.
+    pub async fn serve_peer_request<E>(
+        &self,
+        effects: &E,
+        peer: DeviceId,
+        local_journal: &Journal,
+        local_ops: &[AttestedOp],
+    ) -> SyncResult<AntiEntropyServed>
+    where
+        E: NetworkEffects + Send + Sync,
+    {
+        let request: PeerRequestWire = receive_json_from_expected_peer(
+            effects,
+            peer.0,
+            &peer,
+            "request",
+            "anti-entropy request",
+        )
+        .await?;
+
+        let reply = match AntiEntropyPeerRequest::from(request) {
+            AntiEntropyPeerRequest::Digest(_) => json_serialize(
+                "digest",
+                "digest",
+                &self.local_digest(local_journal, local_ops)?,
+            )?,
+            AntiEntropyPeerRequest::Operations(request) => json_serialize(
+                "operations",
+                "operations",
+                &self.select_requested_operations(local_ops, &request)?,
+            )?,
+            AntiEntropyPeerRequest::RangeDigest(message) => json_serialize(
+                "range_digest",
+                "range digest",
+                &self.answer_range_digest(local_ops, &message)?,
+            )?,
+            AntiEntropyPeerRequest::Push(operations) => {
+                return Ok(AntiEntropyServed::Pushed(operations));
+            }
+        };
+
+        send_bytes_to_peer(effects, peer.0, &peer, "anti-entropy reply", reply).await?;
+        Ok(AntiEntropyServed::Replied)
+    }
+
+    /// Answer one round of a peer's range-digest exchange
+    ///
+    /// Uses the configured reconciler parameters, or the defaults when this
+    /// side is configured for prefix replay.
+    pub fn answer_range_digest(
+        &self,
+        local_ops: &[AttestedOp],
+        message: &RangeDigestMessage,
+    ) -> SyncResult<RangeDigestMessage> {
+        let reconciler = match self.config.reconciliation {
+            ReconciliationMode::RangeDigest(reconciler) => reconciler,
+            ReconciliationMode::PrefixReplay => RangeReconciler::default(),
+        };
+        let index = RangeDigestIndex::from_fingerprints(fingerprint_all(local_ops)?);
+        Ok(reconciler.respond(&index, message)?.reply)
+    }
+
     /// Compute a digest for the given journal state and operation log
     pub fn compute_digest(
         &self,
@@ -1321,6 +1666,32 @@ impl AntiEntropyProtocol {
         })
     }
 
+    /// Digest of the local journal and operation log
+    ///
+    /// Equivalent to [`Self::compute_digest`], but maintained incrementally:
+    /// an unchanged journal costs `O(1)` and appended operations cost
+    /// `O(new ops)`. Only call this with the local replica's journal.
+    pub fn local_digest(
+        &self,
+        journal: &Journal,
+        operations: &[AttestedOp],
+    ) -> SyncResult<JournalDigest> {
+        self.local_digest.lock().digest(journal, operations)
+    }
+
+    /// Record operations appended to the local log ahead of the next digest
+    pub fn record_appended_operations(&self, operations: &[AttestedOp]) -> SyncResult<()> {
+        self.local_digest
+            .lock()
+            .append_operations(operations)
+            .map_err(|e| sync_session_error(format!("Failed to fingerprint op: {e}")))
+    }
+
+    /// Discard the running local digest after the journal is replaced wholesale
+    pub fn reset_local_digest(&self) {
+        self.local_digest.lock().reset();
+    }
+
     /// Compare two digests and classify their relationship
     pub fn compare(local: &JournalDigest, remote: &JournalDigest) -> DigestStatus {
         if local.matches(remote) {
@@ -1358,7 +1729,80 @@ impl AntiEntropyProtocol {
         }
     }
 
+    /// Plan a request for specific operations identified by fingerprint
+    pub fn plan_targeted_request(
+        &self,
+        missing_operations: Vec<OperationFingerprint>,
+    ) -> AntiEntropyRequest {
+        AntiEntropyRequest {
+            from_index: 0,
+            max_ops: missing_operations.len().min(u32::MAX as usize) as u32,
+            missing_operations,
+        }
+    }
+
+    /// Select the local operations that answer a peer's request
+    ///
+    /// Targeted requests are served by fingerprint; otherwise the request is
+    /// served from `from_index`. Either way at most `max_ops` are returned.
+    pub fn select_requested_operations(
+        &self,
+        local_ops: &[AttestedOp],
+        request: &AntiEntropyRequest,
+    ) -> SyncResult<Vec<AttestedOp>> {
+        let limit = (request.max_ops as usize).min(self.config.batch_size.max(1) as usize);
+
+        if request.missing_operations.is_empty() {
+            let start = (request.from_index as usize).min(local_ops.len());
+            let end = start.saturating_add(limit).min(local_ops.len());
+            return Ok(local_ops[start..end].to_vec());
+        }
+
+        let wanted: HashSet<_> = request.missing_operations.iter().collect();
+        let mut selected = Vec::with_capacity(wanted.len().min(limit));
+        for op in local_ops {
+            if selected.len() >= limit {
+                break;
+            }
+            let fp = fingerprint(op)
+                .map_err(|e| sync_session_error(format!("Failed to fingerprint: {e}")))?;
+            if wanted.contains(&fp) {
+                selected.push(op.clone());
+            }
+        }
+        Ok(selected)
+    }
+
+    /// Merge a batch into a long-lived fingerprint index
+    ///
+    /// Only the incoming ops are fingerprinted, so the cost depends on the
+    /// batch size rather than the length of the local log.
+    pub fn merge_batch_into(
+        &self,
+        index: &mut FingerprintIndex,
+        incoming: VerifiedIngress<VerifiedRemoteOpsBatch>,
+    ) -> SyncResult<AntiEntropyResult> {
+        let (incoming, _) = incoming.into_parts();
+        let (fresh, duplicates) = index
+            .admit(incoming.ops)
+            .map_err(|e| sync_session_error(format!("Failed to fingerprint: {e}")))?;
+
+        let applied = fresh.len() as u64;
+        let applied_ops = fresh.into_iter().map(|entry| entry.op).collect();
+
+        Ok(AntiEntropyResult {
+            applied,
+            duplicates,
+            applied_ops,
+            final_status: None,
+            rounds: 1,
+        })
+    }
+
     /// Merge a batch of operations, deduplicating already-seen entries
+    ///
+    /// Rebuilds the fingerprint set over `local_ops` on every call; prefer
+    /// [`Self::merge_batch_into`] when merging many batches into one log.
     pub fn merge_batch(
         &self,
         local_ops: &mut Vec<AttestedOp>,
@@ -1433,6 +1877,68 @@ fn fingerprint(op: &AttestedOp) -> AuraResult<OperationFingerprint> {
     hash_serialized(op)
 }
 
+fn fingerprint_all(ops: &[AttestedOp]) -> SyncResult<Vec<OperationFingerprint>> {
+    ops.iter()
+        .map(fingerprint)
+        .collect::<AuraResult<Vec<_>>>()
+        .map_err(|e| sync_session_error(format!("Failed to fingerprint op: {e}")))
+}
+
+fn invalid_remote_signature(peer: DeviceId, index: usize) -> AuraError {
+    crate::core::errors::sync_protocol_with_peer(
+        "anti_entropy",
+        format!("remote operation {index} failed signature verification"),
+        peer,
+    )
+}
+
+/// Aggregate signature checks detached from a remote batch, keyed by the
+/// index of the op they belong to.
+#[derive(Default)]
+struct PendingAggregateSignatures {
+    indices: Vec<usize>,
+    checks: Vec<Ed25519BatchItem>,
+}
+
+impl PendingAggregateSignatures {
+    fn push(&mut self, index: usize, check: Ed25519BatchItem) {
+        self.indices.push(index);
+        self.checks.push(check);
+    }
+
+    /// Verify every queued check in one batch, falling back to single
+    /// verification of each op to name the first bad one when the batch is
+    /// rejected. Acceptance is therefore the same as verifying op by op.
+    async fn verify<E>(&self, effects: &E, peer: DeviceId) -> SyncResult<()>
+    where
+        E: TreeEffects + Send + Sync,
+    {
+        if self.checks.is_empty() {
+            return Ok(());
+        }
+        if let Ok(true) = effects.verify_aggregate_sig_batch(&self.checks).await {
+            return Ok(());
+        }
+
+        for (index, check) in self.indices.iter().zip(&self.checks) {
+            let signature_valid = effects
+                .verify_aggregate_sig_check(check)
+                .await
+                .map_err(|error| {
+                    crate::core::errors::sync_protocol_with_peer(
+                        "anti_entropy",
+                        format!("remote operation {index} signature verification failed: {error}"),
+                        peer,
+                    )
+                })?;
+            if !signature_valid {
+                return Err(invalid_remote_signature(peer, *index));
+            }
+        }
+        Ok(())
+    }
+}
+
 fn verified_remote_ops_batch(
     metadata: &VerifiedIngressMetadata,
     ops: Vec<AttestedOp>,
@@ -1502,8 +2008,10 @@ pub fn compute_digest(journal: &Journal, operations: &[AttestedOp]) -> SyncResul
 mod tests {
     use super::*;
     use async_trait::async_trait;
-    use aura_core::{AuthorityId, Epoch, FlowBudget, FlowCost, TreeOp, TreeOpKind};
-    use aura_journal::commitment_tree::TreeState;
+    use aura_core::effects::{NetworkCoreEffects, NetworkError, NetworkExtendedEffects};
+    use aura_core::{
+        AuthorityId, Ed25519SigningKey, Epoch, FlowBudget, FlowCost, TreeOp, TreeOpKind,
+    };
     use std::sync::{Arc, Mutex};
 
     #[derive(Clone)]
@@ -1511,6 +2019,17 @@ mod tests {
         state: Arc<Mutex<TreeState>>,
         journal_result: Result<Journal, AuraError>,
         applied: Arc<Mutex<Vec<AttestedOp>>>,
+        /// When set, aggregate signatures are real Ed25519 signatures by this
+        /// key and are handed out as detached batch checks.
+        batch_signer: Option<Ed25519SigningKey>,
+        /// In-memory link to one peer, for request/response tests.
+        link: Option<Arc<TestLink>>,
+    }
+
+    struct TestLink {
+        local: uuid::Uuid,
+        outbox: tokio::sync::mpsc::Sender<(uuid::Uuid, Vec<u8>)>,
+        inbox: tokio::sync::Mutex<tokio::sync::mpsc::Receiver<(uuid::Uuid, Vec<u8>)>>,
     }
 
     impl VerificationTestEffects {
@@ -1519,6 +2038,8 @@ mod tests {
                 state: Arc::new(Mutex::new(TreeState::new())),
                 journal_result: Ok(Journal::default()),
                 applied: Arc::new(Mutex::new(Vec::new())),
+                batch_signer: None,
+                link: None,
             }
         }
 
@@ -1527,8 +2048,72 @@ mod tests {
                 state: Arc::new(Mutex::new(TreeState::new())),
                 journal_result: Err(error),
                 applied: Arc::new(Mutex::new(Vec::new())),
+                batch_signer: None,
+                link: None,
             }
         }
+
+        fn batch_signed(signer: Ed25519SigningKey) -> Self {
+            Self {
+                batch_signer: Some(signer),
+                ..Self::healthy()
+            }
+        }
+
+        /// Two healthy effect sets whose network calls reach each other.
+        fn linked(a: DeviceId, b: DeviceId) -> (Self, Self) {
+            let (to_b, from_a) = tokio::sync::mpsc::channel(64);
+            let (to_a, from_b) = tokio::sync::mpsc::channel(64);
+            let endpoint = |local: DeviceId, outbox, inbox| Self {
+                link: Some(Arc::new(TestLink {
+                    local: local.0,
+                    outbox,
+                    inbox: tokio::sync::Mutex::new(inbox),
+                })),
+                ..Self::healthy()
+            };
+            (endpoint(a, to_b, from_b), endpoint(b, to_a, from_a))
+        }
+
+        fn link(&self) -> Result<&TestLink, NetworkError> {
+            self.link.as_deref().ok_or(NetworkError::NotImplemented)
+        }
+    }
+
+    #[async_trait]
+    impl NetworkCoreEffects for VerificationTestEffects {
+        async fn send_to_peer(
+            &self,
+            peer_id: uuid::Uuid,
+            message: Vec<u8>,
+        ) -> Result<(), NetworkError> {
+            let link = self.link()?;
+            link.outbox
+                .send((link.local, message))
+                .await
+                .map_err(|_| NetworkError::SendFailed {
+                    peer_id: Some(peer_id),
+                    reason: "test link closed".to_string(),
+                })
+        }
+
+        async fn broadcast(&self, _message: Vec<u8>) -> Result<(), NetworkError> {
+            Err(NetworkError::NotImplemented)
+        }
+
+        async fn receive(&self) -> Result<(uuid::Uuid, Vec<u8>), NetworkError> {
+            self.link()?.inbox.lock().await.recv().await.ok_or_else(|| {
+                NetworkError::ReceiveFailed {
+                    reason: "test link closed".to_string(),
+                }
+            })
+        }
+    }
+
+    impl NetworkExtendedEffects for VerificationTestEffects {}
+
+    fn batch_signing_message(op: &AttestedOp) -> Vec<u8> {
+        hash_serialized(&op.op).expect("hash tree op").to_vec()
     }
 
     #[async_trait]
@@ -1615,6 +2200,21 @@ mod tests {
             Ok(!op.agg_sig.is_empty())
         }
 
+        async fn aggregate_sig_check(
+            &self,
+            op: &AttestedOp,
+            _state: &TreeState,
+        ) -> Result<Option<Ed25519BatchItem>, AuraError> {
+            let Some(signer) = &self.batch_signer else {
+                return Ok(None);
+            };
+            Ok(Some(Ed25519BatchItem::new(
+                batch_signing_message(op),
+                op.agg_sig.clone(),
+                signer.verifying_key()?.0,
+            )))
+        }
+
         async fn add_leaf(
             &self,
             _leaf: aura_core::LeafNode,
@@ -1802,6 +2402,136 @@ mod tests {
         assert_eq!(local_ops.len(), 3);
     }
 
+    #[test]
+    fn test_merge_batch_into_dedups_across_batches() {
+        let protocol = AntiEntropyProtocol::default();
+        let mut index = FingerprintIndex::from_ops(vec![sample_op(1)]).unwrap();
+        let peer = DeviceId::new_from_entropy([8u8; 32]);
+        let batch = |ops: Vec<AttestedOp>| {
+            let metadata = VerifiedIngressMetadata::new(
+                IngressSource::Device(peer),
+                peer_sync_context(peer),
+                None,
+                Hash32::from_value(&ops).expect("hash incoming ops"),
+                ANTI_ENTROPY_SCHEMA_VERSION,
+            );
+            verified_remote_ops_batch(&metadata, ops).unwrap()
+        };
+
+        let first = protocol
+            .merge_batch_into(
+                &mut index,
+                batch(vec![sample_op(1), sample_op(2), sample_op(2)]),
+            )
+            .unwrap();
+        assert_eq!(first.applied, 1);
+        assert_eq!(first.duplicates, 2);
+
+        let second = protocol
+            .merge_batch_into(&mut index, batch(vec![sample_op(2), sample_op(3)]))
+            .unwrap();
+        assert_eq!(second.applied, 1);
+        assert_eq!(second.duplicates, 1);
+        assert_eq!(index.len(), 3);
+        assert_eq!(second.applied_ops, vec![sample_op(3)]);
+    }
+
+    #[test]
+    fn test_targeted_request_serves_only_missing_operations() {
+        let protocol = AntiEntropyProtocol::default();
+        let local_ops = vec![sample_op(1), sample_op(2), sample_op(3)];
+        let wanted = fingerprint(&local_ops[2]).unwrap();
+
+        let request = protocol.plan_targeted_request(vec![wanted]);
+        assert_eq!(request.max_ops, 1);
+
+        let served = protocol
+            .select_requested_operations(&local_ops, &request)
+            .unwrap();
+        assert_eq!(served, vec![local_ops[2].clone()]);
+    }
+
+    #[test]
+    fn test_prefix_request_serves_from_index() {
+        let protocol = AntiEntropyProtocol::default();
+        let local_ops = vec![sample_op(1), sample_op(2), sample_op(3)];
+        let request = AntiEntropyRequest {
+            from_index: 1,
+            max_ops: 5,
+            missing_operations: Vec::new(),
+        };
+
+        let served = protocol
+            .select_requested_operations(&local_ops, &request)
+            .unwrap();
+        assert_eq!(served, local_ops[1..].to_vec());
+    }
+
+    #[tokio::test]
+    async fn range_digest_round_trip_moves_both_directions_through_responder() {
+        let initiator_id = DeviceId::new_from_entropy([51u8; 32]);
+        let responder_id = DeviceId::new_from_entropy([52u8; 32]);
+        let (initiator_effects, responder_effects) =
+            VerificationTestEffects::linked(initiator_id, responder_id);
+
+        let reconciler = RangeReconciler::default();
+        let protocol = AntiEntropyProtocol::new(AntiEntropyConfig {
+            reconciliation: ReconciliationMode::RangeDigest(reconciler),
+            ..AntiEntropyConfig::default()
+        });
+        let responder = AntiEntropyProtocol::default();
+
+        let initiator_only = sample_op(9);
+        let responder_ops = valid_verified_batch(responder_id, 3).into_parts().0;
+        let responder_journal = Journal::default();
+
+        let initiate = async {
+            // Moved in so the link closes, ending the serve loop, once done.
+            let effects = initiator_effects;
+            let result = protocol
+                .reconcile_by_range_digest(
+                    &effects,
+                    responder_id,
+                    std::slice::from_ref(&initiator_only),
+                    &reconciler,
+                )
+                .await;
+            let applied = effects.applied.lock().unwrap().clone();
+            (result, applied)
+        };
+        let serve = async {
+            let mut pushed = Vec::new();
+            let mut replies = 0usize;
+            loop {
+                match responder
+                    .serve_peer_request(
+                        &responder_effects,
+                        initiator_id,
+                        &responder_journal,
+                        &responder_ops,
+                    )
+                    .await
+                {
+                    Ok(AntiEntropyServed::Replied) => replies += 1,
+                    Ok(AntiEntropyServed::Pushed(ops)) => pushed.extend(ops),
+                    Err(_) => break,
+                }
+            }
+            (pushed, replies)
+        };
+
+        let ((result, applied), (pushed, replies)) = tokio::join!(initiate, serve);
+        let result = result.expect("range digest reconciliation");
+
+        assert_eq!(result.applied, 3);
+        assert_eq!(applied, responder_ops);
+        assert_eq!(pushed, vec![initiator_only]);
+        assert!(
+            replies >= 2,
+            "range digest and operation pull are both answered"
+        );
+    }
+
     #[tokio::test]
     async fn verify_remote_operation_batch_accepts_valid_verified_sync_batch() {
         let protocol = AntiEntropyProtocol::default();
@@ -1836,6 +2566,42 @@ mod tests {
         assert!(error.to_string().contains("signature verification"));
     }
 
+    #[tokio::test]
+    async fn verify_remote_operation_batch_names_forged_op_after_batch_rejection() {
+        let protocol = AntiEntropyProtocol::default();
+        let peer = DeviceId::new_from_entropy([45u8; 32]);
+        let signer = Ed25519SigningKey::from_bytes([45u8; 32]);
+        let effects = VerificationTestEffects::batch_signed(signer);
+        let (mut ops, evidence) = valid_verified_batch(peer, 3).into_parts();
+        for op in &mut ops {
+            op.agg_sig = signer
+                .sign(&batch_signing_message(op))
+                .expect("sign op")
+                .0
+                .to_vec();
+        }
+        let rewrap = |ops: Vec<AttestedOp>| {
+            DecodedIngress::new(ops, evidence.metadata().clone())
+                .verify(evidence.clone())
+                .expect("re-wrapped batch")
+        };
+
+        let verified = protocol
+            .verify_remote_operation_batch(&effects, peer, rewrap(ops.clone()))
+            .await
+            .expect("batch-signed ops should verify");
+        assert_eq!(verified.payload().len(), 3);
+
+        ops[1].agg_sig[0] ^= 0xff;
+        let error = protocol
+            .verify_remote_operation_batch(&effects, peer, rewrap(ops))
+            .await
+            .expect_err("forged op should fail");
+        assert!(error
+            .to_string()
+            .contains("remote operation 1 failed signature verification"));
+    }
+
     #[tokio::test]
     async fn verify_remote_operation_batch_rejects_unauthorized_namespace_context() {
         let protocol = AntiEntropyProtocol::default();
@@ -1939,6 +2705,63 @@ mod tests {
         assert!(error.to_string().contains("Failed to deserialize"));
     }
 
+    #[test]
+    fn schema_v1_peer_requests_are_translated_and_unknown_shapes_rejected() {
+        let decode = |bytes: &[u8]| {
+            crate::core::json_deserialize::<PeerRequestWire>(
+                "request",
+                "anti-entropy request",
+                bytes,
+            )
+            .map(AntiEntropyPeerRequest::from)
+        };
+        let digest = JournalDigest {
+            operation_count: 3,
+            last_epoch: Some(1),
+            operation_hash: [1u8; 32],
+            fact_hash: [2u8; 32],
+            caps_hash: [3u8; 32],
+        };
+        let request = AntiEntropyRequest {
+            from_index: 2,
+            max_ops: 16,
+            missing_operations: vec![[4u8; 32]],
+        };
+        let pushed = vec![sample_op(5)];
+
+        for current in [
+            AntiEntropyPeerRequest::Digest(digest.clone()),
+            AntiEntropyPeerRequest::Operations(request.clone()),
+            AntiEntropyPeerRequest::Push(pushed.clone()),
+        ] {
+            let bytes = serde_json::to_vec(&current).unwrap();
+            assert_eq!(decode(&bytes).unwrap(), current);
+        }
+
+        let v1_digest = serde_json::to_vec(&digest).unwrap();
+        let v1_request = serde_json::to_vec(&request).unwrap();
+        let v1_push = serde_json::to_vec(&pushed).unwrap();
+        assert_eq!(
+            decode(&v1_digest).unwrap(),
+            AntiEntropyPeerRequest::Digest(digest)
+        );
+        assert_eq!(
+            decode(&v1_request).unwrap(),
+            AntiEntropyPeerRequest::Operations(request)
+        );
+        assert_eq!(
+            decode(&v1_push).unwrap(),
+            AntiEntropyPeerRequest::Push(pushed)
+        );
+        assert_eq!(
+            decode(b"[]").unwrap(),
+            AntiEntropyPeerRequest::Push(Vec::new())
+        );
+
+        let error = decode(br#"{"Snapshot":{}}"#).expect_err("unknown request shape");
+        assert!(error.to_string().contains("Failed to deserialize"));
+    }
+
     #[test]
     fn test_merge_batch_count_uses_configured_chunk_size() {
         assert_eq!(AntiEntropyProtocol::merge_batch_count(0, 4), 0);
@@ -0,0 +1,237 @@
+//! Incrementally maintained journal digest
+//!
+//! `compute_digest` re-serializes the fact set and fingerprints every operation
+//! on each call. The accumulator keeps a running hash over the ordered
+//! operation fingerprints and a cached fact hash, so a digest over an
+//! unchanged journal costs `O(1)` and a digest after appends costs
+//! `O(new ops)`. Digests are byte-identical to `compute_digest`, so peers
+//! using either path compare equal.
+//!
+//! The accumulator tracks one local replica's append-only operation log. The
+//! fact hash is cached against [`Fact::revision`], which changes on every
+//! mutation, so a replaced or edited fact set is always rehashed. Call
+//! [`JournalDigestAccumulator::reset`] to drop all cached state.
+
+use aura_core::hash::{self, Hasher};
+use aura_core::{AttestedOp, AuraResult, Fact, FactRevision, Journal};
+
+use super::{fingerprint, hash_serialized, JournalDigest, OperationFingerprint};
+use crate::core::{sync_session_error, SyncResult};
+
+/// Fact hash cached against the fact-set revision it was computed for.
+#[derive(Debug, Clone)]
+struct CachedFactHash {
+    revision: FactRevision,
+    hash: [u8; 32],
+}
+
+/// Running digest over a local journal and its append-only operation log.
+pub struct JournalDigestAccumulator {
+    operation_count: u64,
+    last_epoch: Option<u64>,
+    last_fingerprint: Option<OperationFingerprint>,
+    operation_hasher: Box<dyn Hasher>,
+    facts: Option<CachedFactHash>,
+}
+
+impl std::fmt::Debug for JournalDigestAccumulator {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("JournalDigestAccumulator")
+            .field("operation_count", &self.operation_count)
+            .field("last_epoch", &self.last_epoch)
+            .field("facts_cached", &self.facts.is_some())
+            .finish()
+    }
+}
+
+impl Default for JournalDigestAccumulator {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl JournalDigestAccumulator {
+    /// Create an accumulator over an empty journal.
+    pub fn new() -> Self {
+        Self {
+            operation_count: 0,
+            last_epoch: None,
+            last_fingerprint: None,
+            operation_hasher: hash::hasher(),
+            facts: None,
+        }
+    }
+
+    /// Forget all absorbed state; the next digest rebuilds from scratch.
+    pub fn reset(&mut self) {
+        *self = Self::new();
+    }
+
+    /// Number of operations absorbed so far.
+    pub fn operation_count(&self) -> u64 {
+        self.operation_count
+    }
+
+    /// Absorb operations appended to the log since the last call.
+    pub fn append_operations(&mut self, ops: &[AttestedOp]) -> AuraResult<()> {
+        for op in ops {
+            let fp = fingerprint(op)?;
+            self.operation_hasher.update(&fp);
+            self.operation_count += 1;
+            self.last_fingerprint = Some(fp);
+
+            let epoch = u64::from(op.op.parent_epoch);
+            self.last_epoch = Some(
+                self.last_epoch
+                    .map_or(epoch, |existing| existing.max(epoch)),
+            );
+        }
+        Ok(())
+    }
+
+    /// Bring the accumulator up to date with the full operation log.
+    ///
+    /// Only the suffix past the absorbed count is fingerprinted. A log that
+    /// shrank, or whose last absorbed operation changed, is treated as a
+    /// replacement and re-absorbed from the start.
+    pub fn observe_operations(&mut self, log: &[AttestedOp]) -> AuraResult<()> {
+        let absorbed = self.operation_count as usize;
+        let prefix_intact = match (absorbed, self.last_fingerprint) {
+            (0, _) => true,
+            (n, Some(last)) if n <= log.len() => fingerprint(&log[n - 1])? == last,
+            _ => false,
+        };
+
+        if prefix_intact {
+            self.append_operations(&log[absorbed..])
+        } else {
+            let facts = self.facts.take();
+            self.reset();
+            self.facts = facts;
+            self.append_operations(log)
+        }
+    }
+
+    /// Fact hash for the given fact set, recomputed only when it changed.
+    pub fn observe_facts(&mut self, facts: &Fact) -> AuraResult<[u8; 32]> {
+        let revision = facts.revision();
+        if let Some(cached) = &self.facts {
+            if cached.revision == revision {
+                return Ok(cached.hash);
+            }
+        }
+
+        let hash = hash_serialized(facts)?;
+        self.facts = Some(CachedFactHash { revision, hash });
+        Ok(hash)
+    }
+
+    /// Digest of the journal and operation log, absorbing only what changed.
+    pub fn digest(&mut self, journal: &Journal, log: &[AttestedOp]) -> SyncResult<JournalDigest> {
+        self.observe_operations(log)
+            .map_err(|e| sync_session_error(format!("Failed to fingerprint op: {e}")))?;
+        let fact_hash = self
+            .observe_facts(&journal.facts)
+            .map_err(|e| sync_session_error(format!("Failed to hash facts: {e}")))?;
+        // Capability tokens are small and replaced rather than grown; hashing
+        // them directly is cheaper than tracking revisions.
+        let caps_hash = hash_serialized(&journal.caps)
+            .map_err(|e| sync_session_error(format!("Failed to hash caps: {e}")))?;
+
+        Ok(JournalDigest {
+            operation_count: self.operation_count,
+            last_epoch: self.last_epoch,
+            operation_hash: self.operation_hasher.current(),
+            fact_hash,
+            caps_hash,
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::super::compute_digest;
+    use super::*;
+    use aura_core::{Epoch, FactValue, TreeOp, TreeOpKind};
+
+    fn op(epoch: u64, tag: u8) -> AttestedOp {
+        AttestedOp {
+            op: TreeOp {
+                parent_epoch: Epoch::new(epoch),
+                parent_commitment: [tag; 32],
+                op: TreeOpKind::RotateEpoch { affected: vec![] },
+                version: 1,
+            },
+            agg_sig: vec![tag],
+            signer_count: 1,
+        }
+    }
+
+    #[test]
+    fn matches_full_recompute_across_appends() {
+        let mut journal = Journal::default();
+        let mut log = Vec::new();
+        let mut accumulator = JournalDigestAccumulator::new();
+
+        assert_eq!(
+            accumulator.digest(&journal, &log).unwrap(),
+            compute_digest(&journal, &log).unwrap()
+        );
+
+        for round in 0..5u8 {
+            log.push(op(u64::from(round), round));
+            log.push(op(u64::from(round) + 1, round.wrapping_add(100)));
+            journal
+                .facts
+                .insert(format!("key-{round}"), FactValue::Number(i64::from(round)))
+                .unwrap();
+
+            assert_eq!(
+                accumulator.digest(&journal, &log).unwrap(),
+                compute_digest(&journal, &log).unwrap()
+            );
+        }
+        assert_eq!(accumulator.operation_count(), 10);
+    }
+
+    #[test]
+    fn rehashes_replaced_facts_with_equal_counts() {
+        let log = vec![op(1, 1)];
+        let mut accumulator = JournalDigestAccumulator::new();
+
+        let mut journal = Journal::default();
+        journal.facts.insert("a", FactValue::Number(1)).unwrap();
+        accumulator.digest(&journal, &log).unwrap();
+
+        // Same operation and entry counts, different content.
+        let mut replaced = Fact::new();
+        replaced.insert("b", FactValue::Number(2)).unwrap();
+        journal.facts = replaced;
+        assert_eq!(
+            accumulator.digest(&journal, &log).unwrap(),
+            compute_digest(&journal, &log).unwrap()
+        );
+    }
+
+    #[test]
+    fn rebuilds_when_log_is_replaced() {
+        let journal = Journal::default();
+        let mut accumulator = JournalDigestAccumulator::new();
+        let original = vec![op(1, 1), op(2, 2), op(3, 3)];
+        accumulator.digest(&journal, &original).unwrap();
+
+        let shorter = vec![op(1, 1)];
+        assert_eq!(
+            accumulator.digest(&journal, &shorter).unwrap(),
+            compute_digest(&journal, &shorter).unwrap()
+        );
+
+        let rewritten = vec![op(1, 1), op(9, 9), op(3, 3)];
+        accumulator.digest(&journal, &original[..1]).unwrap();
+        let mut diverged = accumulator.digest(&journal, &rewritten[..2]).unwrap();
+        assert_eq!(diverged, compute_digest(&journal, &rewritten[..2]).unwrap());
+
+        diverged = accumulator.digest(&journal, &original).unwrap();
+        assert_eq!(diverged, compute_digest(&journal, &original).unwrap());
+    }
+}
@@ -0,0 +1,250 @@
+//! Long-lived fingerprint index for operation deduplication
+//!
+//! Fingerprinting an op re-serializes it, so rebuilding a fingerprint set over
+//! the whole local log for every incoming batch makes catch-up quadratic. The
+//! index keeps a hash set of fingerprints already applied, so merging a batch
+//! costs `O(batch)` regardless of log length.
+//!
+//! Only fingerprints are retained, and only the most recent `horizon` of
+//! them. The index is a fast path in front of the canonical tree apply, which
+//! still rejects replays, so forgetting an old fingerprint costs at most one
+//! redundant verification rather than a duplicate apply.
+
+use std::collections::{HashSet, VecDeque};
+
+use aura_core::{AttestedOp, AuraResult};
+
+use super::{fingerprint, OperationFingerprint};
+
+/// Default number of fingerprints an index retains before pruning.
+pub const DEFAULT_FINGERPRINT_HORIZON: usize = 65_536;
+
+/// An attested operation with its cached fingerprint.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct FingerprintedOp {
+    /// Content fingerprint of `op`
+    pub fingerprint: OperationFingerprint,
+    /// The operation itself
+    pub op: AttestedOp,
+}
+
+impl FingerprintedOp {
+    /// Fingerprint an operation once.
+    pub fn new(op: AttestedOp) -> AuraResult<Self> {
+        Ok(Self {
+            fingerprint: fingerprint(&op)?,
+            op,
+        })
+    }
+}
+
+/// Bounded set of applied operation fingerprints with `O(1)` membership.
+#[derive(Debug, Clone)]
+pub struct FingerprintIndex {
+    /// Fingerprints in admission order, oldest first
+    order: VecDeque<OperationFingerprint>,
+    seen: HashSet<OperationFingerprint>,
+    horizon: usize,
+}
+
+impl Default for FingerprintIndex {
+    fn default() -> Self {
+        Self::with_horizon(DEFAULT_FINGERPRINT_HORIZON)
+    }
+}
+
+impl FingerprintIndex {
+    /// Create an empty index with the default pruning horizon.
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Create an empty index that retains at most `horizon` fingerprints.
+    pub fn with_horizon(horizon: usize) -> Self {
+        let horizon = horizon.max(1);
+        Self {
+            order: VecDeque::new(),
+            seen: HashSet::new(),
+            horizon,
+        }
+    }
+
+    /// Build an index over an existing log, fingerprinting each op once.
+    pub fn from_ops<I>(ops: I) -> AuraResult<Self>
+    where
+        I: IntoIterator<Item = AttestedOp>,
+    {
+        let mut index = Self::new();
+        for op in ops {
+            index.insert(fingerprint(&op)?);
+        }
+        Ok(index)
+    }
+
+    /// Number of fingerprints currently retained.
+    pub fn len(&self) -> usize {
+        self.seen.len()
+    }
+
+    /// Whether the index holds no fingerprints.
+    pub fn is_empty(&self) -> bool {
+        self.seen.is_empty()
+    }
+
+    /// Maximum number of fingerprints retained.
+    pub fn horizon(&self) -> usize {
+        self.horizon
+    }
+
+    /// Check whether an operation with this fingerprint has been applied.
+    pub fn contains(&self, fingerprint: &OperationFingerprint) -> bool {
+        self.seen.contains(fingerprint)
+    }
+
+    /// Record a fingerprint; returns `false` if it was already present.
+    ///
+    /// The oldest fingerprints are pruned once the horizon is exceeded.
+    pub fn insert(&mut self, fingerprint: OperationFingerprint) -> bool {
+        if !self.seen.insert(fingerprint) {
+            return false;
+        }
+        self.order.push_back(fingerprint);
+        while self.order.len() > self.horizon {
+            if let Some(oldest) = self.order.pop_front() {
+                self.seen.remove(&oldest);
+            }
+        }
+        true
+    }
+
+    /// Split a batch into ops not yet in the index and a duplicate count,
+    /// recording the new ops in the same step.
+    ///
+    /// If any op fails to fingerprint, nothing is recorded. Selection and insertion happen under one borrow, so two merges of the
+    /// same op behind a shared lock cannot both admit it. If applying the
+    /// admitted ops fails, [`forget`](Self::forget) them so a later round
+    /// retries instead of treating them as duplicates.
+    pub fn admit(&mut self, batch: Vec<AttestedOp>) -> AuraResult<(Vec<FingerprintedOp>, u64)> {
+        self.admit_with(batch, fingerprint)
+    }
+
+    fn admit_with(
+        &mut self,
+        batch: Vec<AttestedOp>,
+        fingerprint: impl Fn(&AttestedOp) -> AuraResult<OperationFingerprint>,
+    ) -> AuraResult<(Vec<FingerprintedOp>, u64)> {
+        // Fingerprint the whole batch before inserting, so a failure partway
+        // through leaves the index untouched.
+        let entries = batch
+            .into_iter()
+            .map(|op| {
+                Ok(FingerprintedOp {
+                    fingerprint: fingerprint(&op)?,
+                    op,
+                })
+            })
+            .collect::<AuraResult<Vec<_>>>()?;
+
+        let mut fresh = Vec::with_capacity(entries.len());
+        let mut duplicates = 0;
+
+        for entry in entries {
+            if self.insert(entry.fingerprint) {
+                fresh.push(entry);
+            } else {
+                duplicates += 1;
+            }
+        }
+
+        Ok((fresh, duplicates))
+    }
+
+    /// Drop fingerprints admitted for ops whose apply did not succeed.
+    pub fn forget<'a, I>(&mut self, fingerprints: I)
+    where
+        I: IntoIterator<Item = &'a OperationFingerprint>,
+    {
+        let mut removed = HashSet::new();
+        for fingerprint in fingerprints {
+            if self.seen.remove(fingerprint) {
+                removed.insert(*fingerprint);
+            }
+        }
+        if !removed.is_empty() {
+            self.order
+                .retain(|fingerprint| !removed.contains(fingerprint));
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use aura_core::{AuraError, Epoch, TreeOp, TreeOpKind};
+
+    fn fp(tag: u8) -> OperationFingerprint {
+        [tag; 32]
+    }
+
+    fn op(epoch: u64) -> AttestedOp {
+        AttestedOp {
+            op: TreeOp {
+                parent_epoch: Epoch::new(epoch),
+                parent_commitment: [0u8; 32],
+                op: TreeOpKind::RotateEpoch { affected: vec![] },
+                version: 1,
+            },
+            agg_sig: vec![],
+            signer_count: 1,
+        }
+    }
+
+    #[test]
+    fn prunes_oldest_past_horizon() {
+        let mut index = FingerprintIndex::with_horizon(2);
+        assert!(index.insert(fp(1)));
+        assert!(index.insert(fp(2)));
+        assert!(index.insert(fp(3)));
+
+        assert_eq!(index.len(), 2);
+        assert!(!index.contains(&fp(1)));
+        assert!(index.contains(&fp(2)) && index.contains(&fp(3)));
+    }
+
+    #[test]
+    fn forget_allows_readmission() {
+        let mut index = FingerprintIndex::with_horizon(4);
+        index.insert(fp(1));
+        index.insert(fp(2));
+        index.forget([&fp(1)]);
+
+        assert!(!index.contains(&fp(1)));
+        assert!(index.insert(fp(1)));
+        index.insert(fp(3));
+        index.insert(fp(4));
+        index.insert(fp(5));
+        // fp(2) is now the oldest and is pruned first.
+        assert!(!index.contains(&fp(2)));
+        assert!(index.contains(&fp(1)));
+    }
+
+    #[test]
+    fn failed_fingerprint_admits_nothing() {
+        let mut index = FingerprintIndex::new();
+        let batch = vec![op(1), op(2), op(3)];
+        let error = index
+            .admit_with(batch.clone(), |op| {
+                if op.op.parent_epoch == Epoch::new(3) {
+                    Err(AuraError::internal("fingerprint failed"))
+                } else {
+                    fingerprint(op)
+                }
+            })
+            .expect_err("third op fails to fingerprint");
+
+        assert!(error.to_string().contains("fingerprint failed"));
+        assert!(index.is_empty());
+        let (fresh, duplicates) = index.admit(batch).unwrap();
+        assert_eq!((fresh.len(), duplicates), (3, 0));
+    }
+}
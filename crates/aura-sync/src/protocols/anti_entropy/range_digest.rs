@@ -0,0 +1,516 @@
+//! Range-based set reconciliation over operation fingerprints
+//!
+//! Instead of comparing a single hash of the whole operation log, peers
+//! exchange summaries of fingerprint ranges. A range whose summary matches is
+//! settled in one entry; a range that differs is split into `branch_factor`
+//! sub-ranges and the exchange recurses until ranges are small enough to send
+//! their fingerprints directly. With `Δ` differing operations the exchange
+//! takes `O(log n)` rounds and `O(Δ · branch_factor · log n)` entries in
+//! total, independent of how long the shared prefix of history is.
+//!
+//! Range summaries are `(count, xor)` pairs over the sorted fingerprint set.
+//! The index keeps a prefix-XOR table, so any range is summarized in
+//! `O(log n)` (two binary searches) without touching the operations.
+
+use std::collections::BTreeSet;
+
+use serde::{Deserialize, Serialize};
+
+use super::OperationFingerprint;
+use crate::core::{sync_validation_error, SyncResult};
+use aura_core::hash;
+
+const RANGE_SUMMARY_DOMAIN: &[u8] = b"aura.sync.anti_entropy.range_summary.v1";
+
+/// Half-open range `[lower, upper)` of the fingerprint space.
+///
+/// `upper == None` extends the range to the end of the fingerprint space.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
+pub struct FingerprintRange {
+    /// Inclusive lower bound
+    pub lower: OperationFingerprint,
+    /// Exclusive upper bound, or `None` for the end of the space
+    pub upper: Option<OperationFingerprint>,
+}
+
+impl FingerprintRange {
+    /// The range covering every fingerprint.
+    pub const FULL: Self = Self {
+        lower: [0u8; 32],
+        upper: None,
+    };
+
+    /// Check whether a fingerprint falls within this range.
+    pub fn contains(&self, fingerprint: &OperationFingerprint) -> bool {
+        *fingerprint >= self.lower && self.upper.as_ref().is_none_or(|upper| fingerprint < upper)
+    }
+
+    fn is_well_formed(&self) -> bool {
+        self.upper.as_ref().is_none_or(|upper| self.lower < *upper)
+    }
+}
+
+/// Content of one range entry in a reconciliation message.
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+pub enum RangePayload {
+    /// Compact summary of the sender's fingerprints in the range
+    Summary {
+        /// Number of fingerprints in the range
+        count: u64,
+        /// Domain-separated hash of the count and XOR of the fingerprints
+        digest: [u8; 32],
+    },
+    /// Explicit fingerprints held by the sender within the range
+    Fingerprints {
+        /// Sorted fingerprints
+        fingerprints: Vec<OperationFingerprint>,
+        /// Whether the receiver should answer with the fingerprints it holds
+        /// that the sender lacks. Answers set this to `false`, which ends the
+        /// exchange for the range.
+        reply_expected: bool,
+        /// In an answer, the fingerprints of the answered entry that the
+        /// answering side lacks, so both sides learn the full difference.
+        #[serde(default, skip_serializing_if = "Vec::is_empty")]
+        requested: Vec<OperationFingerprint>,
+    },
+}
+
+/// A single range and its payload.
+#[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
+pub struct RangeEntry {
+    /// Range described by this entry
+    pub range: FingerprintRange,
+    /// Summary or explicit fingerprints for the range
+    pub payload: RangePayload,
+}
+
+/// One round of a range-digest exchange.
+#[derive(Debug, Clone, Default, PartialEq, Eq, Serialize, Deserialize)]
+pub struct RangeDigestMessage {
+    /// Ranges still under reconciliation
+    pub entries: Vec<RangeEntry>,
+}
+
+impl RangeDigestMessage {
+    /// An empty message means every range has been settled.
+    pub fn is_empty(&self) -> bool {
+        self.entries.is_empty()
+    }
+}
+
+/// Sorted fingerprint set with a prefix-XOR table for range summaries.
+#[derive(Debug, Clone, Default)]
+pub struct RangeDigestIndex {
+    fingerprints: Vec<OperationFingerprint>,
+    /// `prefix_xor[i]` is the XOR of `fingerprints[..i]`
+    prefix_xor: Vec<[u8; 32]>,
+}
+
+impl RangeDigestIndex {
+    /// Build an index from an arbitrary collection of fingerprints.
+    ///
+    /// Duplicate fingerprints are collapsed.
+    pub fn from_fingerprints<I>(fingerprints: I) -> Self
+    where
+        I: IntoIterator<Item = OperationFingerprint>,
+    {
+        let mut fingerprints: Vec<_> = fingerprints.into_iter().collect();
+        fingerprints.sort_unstable();
+        fingerprints.dedup();
+
+        let mut prefix_xor = Vec::with_capacity(fingerprints.len() + 1);
+        let mut acc = [0u8; 32];
+        prefix_xor.push(acc);
+        for fingerprint in &fingerprints {
+            xor_into(&mut acc, fingerprint);
+            prefix_xor.push(acc);
+        }
+
+        Self {
+            fingerprints,
+            prefix_xor,
+        }
+    }
+
+    /// Number of distinct fingerprints in the index.
+    pub fn len(&self) -> usize {
+        self.fingerprints.len()
+    }
+
+    /// Whether the index holds no fingerprints.
+    pub fn is_empty(&self) -> bool {
+        self.fingerprints.is_empty()
+    }
+
+    /// Check whether a fingerprint is present.
+    pub fn contains(&self, fingerprint: &OperationFingerprint) -> bool {
+        self.fingerprints.binary_search(fingerprint).is_ok()
+    }
+
+    /// Summarize the fingerprints held within a range.
+    pub fn summarize(&self, range: &FingerprintRange) -> RangePayload {
+        let (start, end) = self.bounds(range);
+        self.summary_for(start, end)
+    }
+
+    /// Fingerprints held within a range, in sorted order.
+    pub fn fingerprints_in(&self, range: &FingerprintRange) -> &[OperationFingerprint] {
+        let (start, end) = self.bounds(range);
+        &self.fingerprints[start..end]
+    }
+
+    fn bounds(&self, range: &FingerprintRange) -> (usize, usize) {
+        let start = self.fingerprints.partition_point(|fp| *fp < range.lower);
+        let end = match range.upper {
+            Some(upper) => self.fingerprints.partition_point(|fp| *fp < upper),
+            None => self.fingerprints.len(),
+        };
+        (start, end.max(start))
+    }
+
+    fn summary_for(&self, start: usize, end: usize) -> RangePayload {
+        let mut xor = self.prefix_xor[end];
+        xor_into(&mut xor, &self.prefix_xor[start]);
+        let count = (end - start) as u64;
+
+        let mut h = hash::hasher();
+        h.update(RANGE_SUMMARY_DOMAIN);
+        h.update(&count.to_le_bytes());
+        h.update(&xor);
+        RangePayload::Summary {
+            count,
+            digest: h.finalize(),
+        }
+    }
+}
+
+/// Outcome of processing one incoming range-digest message.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct RangeReconciliationStep {
+    /// Message to send back; empty when every range is settled
+    pub reply: RangeDigestMessage,
+    /// Fingerprints the peer holds that are missing locally
+    pub local_missing: Vec<OperationFingerprint>,
+    /// Fingerprints held locally that the peer is missing
+    pub remote_missing: Vec<OperationFingerprint>,
+}
+
+impl RangeReconciliationStep {
+    /// Whether the exchange has converged and no reply is needed.
+    pub fn is_complete(&self) -> bool {
+        self.reply.is_empty()
+    }
+}
+
+/// Parameters for the range-digest exchange.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
+pub struct RangeReconciler {
+    /// Number of sub-ranges a differing range is split into
+    pub branch_factor: usize,
+    /// Ranges with at most this many local fingerprints are sent explicitly
+    pub item_threshold: usize,
+    /// Upper bound on entries accepted in a single incoming message
+    pub max_entries: usize,
+}
+
+impl Default for RangeReconciler {
+    fn default() -> Self {
+        Self {
+            branch_factor: 16,
+            item_threshold: 16,
+            max_entries: 4096,
+        }
+    }
+}
+
+impl RangeReconciler {
+    /// Build the opening message of an exchange.
+    pub fn initiate(&self, index: &RangeDigestIndex) -> RangeDigestMessage {
+        RangeDigestMessage {
+            entries: vec![self.describe(index, FingerprintRange::FULL)],
+        }
+    }
+
+    /// Process a message from the peer and produce the reply.
+    pub fn respond(
+        &self,
+        index: &RangeDigestIndex,
+        message: &RangeDigestMessage,
+    ) -> SyncResult<RangeReconciliationStep> {
+        if message.entries.len() > self.max_entries {
+            return Err(sync_validation_error(format!(
+                "range digest message has {} entries; limit is {}",
+                message.entries.len(),
+                self.max_entries
+            )));
+        }
+
+        let mut step = RangeReconciliationStep::default();
+        for entry in &message.entries {
+            if !entry.range.is_well_formed() {
+                return Err(sync_validation_error(
+                    "range digest entry has an empty or inverted range",
+                ));
+            }
+
+            match &entry.payload {
+                RangePayload::Summary { .. } => {
+                    if index.summarize(&entry.range) != entry.payload {
+                        self.split_into(index, entry.range, &mut step.reply.entries);
+                    }
+                }
+                RangePayload::Fingerprints {
+                    fingerprints,
+                    reply_expected,
+                    requested,
+                } => {
+                    if fingerprints
+                        .iter()
+                        .chain(requested)
+                        .any(|fp| !entry.range.contains(fp))
+                    {
+                        return Err(sync_validation_error(
+                            "range digest entry lists a fingerprint outside its range",
+                        ));
+                    }
+
+                    let local_missing: Vec<_> = fingerprints
+                        .iter()
+                        .filter(|fp| !index.contains(fp))
+                        .copied()
+                        .collect();
+                    step.local_missing.extend_from_slice(&local_missing);
+                    step.remote_missing
+                        .extend(requested.iter().filter(|fp| index.contains(fp)).copied());
+
+                    if *reply_expected {
+                        let remote: BTreeSet<_> = fingerprints.iter().collect();
+                        let missing: Vec<_> = index
+                            .fingerprints_in(&entry.range)
+                            .iter()
+                            .filter(|fp| !remote.contains(fp))
+                            .copied()
+                            .collect();
+                        if !missing.is_empty() || !local_missing.is_empty() {
+                            step.remote_missing.extend_from_slice(&missing);
+                            step.reply.entries.push(RangeEntry {
+                                range: entry.range,
+                                payload: RangePayload::Fingerprints {
+                                    fingerprints: missing,
+                                    reply_expected: false,
+                                    requested: local_missing,
+                                },
+                            });
+                        }
+                    }
+                }
+            }
+        }
+
+        Ok(step)
+    }
+
+    /// Describe a range as a summary, or explicitly when it is small.
+    fn describe(&self, index: &RangeDigestIndex, range: FingerprintRange) -> RangeEntry {
+        let (start, end) = index.bounds(&range);
+        let payload = if end - start <= self.item_threshold {
+            RangePayload::Fingerprints {
+                fingerprints: index.fingerprints[start..end].to_vec(),
+                reply_expected: true,
+                requested: Vec::new(),
+            }
+        } else {
+            index.summary_for(start, end)
+        };
+        RangeEntry { range, payload }
+    }
+
+    /// Answer a mismatched summary: list small ranges explicitly, otherwise
+    /// split them at local fingerprint boundaries.
+    fn split_into(
+        &self,
+        index: &RangeDigestIndex,
+        range: FingerprintRange,
+        out: &mut Vec<RangeEntry>,
+    ) {
+        let (start, end) = index.bounds(&range);
+        let len = end - start;
+        if len <= self.item_threshold {
+            out.push(self.describe(index, range));
+            return;
+        }
+
+        let parts = self.branch_factor.max(2).min(len);
+        let mut lower = range.lower;
+        for part in 1..=parts {
+            let upper = if part == parts {
+                range.upper
+            } else {
+                Some(index.fingerprints[start + len * part / parts])
+            };
+            out.push(self.describe(index, FingerprintRange { lower, upper }));
+            if let Some(next) = upper {
+                lower = next;
+            }
+        }
+    }
+}
+
+fn xor_into(acc: &mut [u8; 32], value: &[u8; 32]) {
+    for (a, v) in acc.iter_mut().zip(value.iter()) {
+        *a ^= v;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn fp(seed: u32) -> OperationFingerprint {
+        hash::hash(&seed.to_le_bytes())
+    }
+
+    /// Drive an exchange to completion and return what the initiator learned.
+    ///
+    /// Only the initiator's own steps are consulted: the responder is treated
+    /// as a remote peer that is seen solely through its replies.
+    fn reconcile(
+        reconciler: &RangeReconciler,
+        local: &RangeDigestIndex,
+        remote: &RangeDigestIndex,
+    ) -> (
+        BTreeSet<OperationFingerprint>,
+        BTreeSet<OperationFingerprint>,
+        usize,
+    ) {
+        let mut local_missing = BTreeSet::new();
+        let mut remote_missing = BTreeSet::new();
+        let mut message = reconciler.initiate(local);
+        let mut entries = message.entries.len();
+
+        for round in 0.. {
+            assert!(round < 64, "range reconciliation did not converge");
+            let reply = reconciler.respond(remote, &message).unwrap().reply;
+            entries += reply.entries.len();
+
+            let step = reconciler.respond(local, &reply).unwrap();
+            local_missing.extend(step.local_missing.iter().copied());
+            remote_missing.extend(step.remote_missing.iter().copied());
+            if step.is_complete() {
+                break;
+            }
+            entries += step.reply.entries.len();
+            message = step.reply;
+        }
+
+        (local_missing, remote_missing, entries)
+    }
+
+    #[test]
+    fn identical_sets_settle_in_one_entry() {
+        let reconciler = RangeReconciler::default();
+        let index = RangeDigestIndex::from_fingerprints((0..1000).map(fp));
+
+        let (local_missing, remote_missing, entries) = reconcile(&reconciler, &index, &index);
+
+        assert!(local_missing.is_empty());
+        assert!(remote_missing.is_empty());
+        assert_eq!(entries, 1);
+    }
+
+    #[test]
+    fn finds_symmetric_difference() {
+        let reconciler = RangeReconciler::default();
+        let local = RangeDigestIndex::from_fingerprints((0..5000).map(fp));
+        let remote = RangeDigestIndex::from_fingerprints(
+            (0..5000)
+                .filter(|i| i % 1000 != 7)
+                .map(fp)
+                .chain([90_001, 90_002].into_iter().map(fp)),
+        );
+
+        let (local_missing, remote_missing, _) = reconcile(&reconciler, &local, &remote);
+
+        let expected_local: BTreeSet<_> = [90_001, 90_002].into_iter().map(fp).collect();
+        let expected_remote: BTreeSet<_> = (0..5000).filter(|i| i % 1000 == 7).map(fp).collect();
+        assert_eq!(local_missing, expected_local);
+        assert_eq!(remote_missing, expected_remote);
+    }
+
+    #[test]
+    fn explicit_initiator_learns_what_peer_lacks() {
+        let reconciler = RangeReconciler::default();
+        let local = RangeDigestIndex::from_fingerprints((0..5).map(fp));
+        let remote = RangeDigestIndex::from_fingerprints((0..3).chain([100]).map(fp));
+
+        let (local_missing, remote_missing, _) = reconcile(&reconciler, &local, &remote);
+
+        assert_eq!(local_missing, [100].into_iter().map(fp).collect());
+        assert_eq!(remote_missing, [3, 4].into_iter().map(fp).collect());
+    }
+
+    #[test]
+    fn single_divergent_op_costs_logarithmic_entries() {
+        let reconciler = RangeReconciler::default();
+        let local = RangeDigestIndex::from_fingerprints((0..100_000).map(fp));
+        let remote = RangeDigestIndex::from_fingerprints((0..100_001).map(fp));
+
+        let (local_missing, remote_missing, entries) = reconcile(&reconciler, &local, &remote);
+
+        assert_eq!(
+            local_missing.into_iter().collect::<Vec<_>>(),
+            vec![fp(100_000)]
+        );
+        assert!(remote_missing.is_empty());
+        // log16(100k) ≈ 4 levels of at most 16 entries each
+        assert!(entries < 100, "exchanged {entries} entries");
+    }
+
+    #[test]
+    fn empty_side_receives_everything() {
+        let reconciler = RangeReconciler::default();
+        let local = RangeDigestIndex::default();
+        let remote = RangeDigestIndex::from_fingerprints((0..300).map(fp));
+
+        let (local_missing, remote_missing, _) = reconcile(&reconciler, &local, &remote);
+
+        assert_eq!(local_missing.len(), 300);
+        assert!(remote_missing.is_empty());
+    }
+
+    #[test]
+    fn rejects_malformed_entries() {
+        let reconciler = RangeReconciler::default();
+        let index = RangeDigestIndex::from_fingerprints((0..10).map(fp));
+
+        let inverted = RangeDigestMessage {
+            entries: vec![RangeEntry {
+                range: FingerprintRange {
+                    lower: [9u8; 32],
+                    upper: Some([1u8; 32]),
+                },
+                payload: RangePayload::Fingerprints {
+                    fingerprints: vec![],
+                    reply_expected: true,
+                    requested: vec![],
+                },
+            }],
+        };
+        assert!(reconciler.respond(&index, &inverted).is_err());
+
+        let out_of_range = RangeDigestMessage {
+            entries: vec![RangeEntry {
+                range: FingerprintRange {
+                    lower: [0u8; 32],
+                    upper: Some([1u8; 32]),
+                },
+                payload: RangePayload::Fingerprints {
+                    fingerprints: vec![[2u8; 32]],
+                    reply_expected: true,
+                    requested: vec![],
+                },
+            }],
+        };
+        assert!(reconciler.respond(&index, &out_of_range).is_err());
+    }
+}
@@ -96,9 +96,10 @@ impl<T> SyncCoreProtocolEffects for T where
 
 // Re-export key types for convenience
 pub use anti_entropy::{
-    AntiEntropyConfig, AntiEntropyProtocol, AntiEntropyRequest, AntiEntropyResult, DigestStatus,
-    JournalDigest, LoggingProgressCallback, NoOpProgressCallback, SyncProgressCallback,
-    SyncProgressEvent,
+    AntiEntropyConfig, AntiEntropyPeerRequest, AntiEntropyProtocol, AntiEntropyRequest,
+    AntiEntropyResult, AntiEntropyServed, DigestStatus, FingerprintIndex, FingerprintedOp,
+    JournalDigest, JournalDigestAccumulator, LoggingProgressCallback, NoOpProgressCallback,
+    RangeReconciler, ReconciliationMode, SyncProgressCallback, SyncProgressEvent,
 };
 
 pub use journal::{
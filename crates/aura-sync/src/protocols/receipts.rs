@@ -22,7 +22,7 @@
 use serde::{Deserialize, Serialize};
 
 use crate::core::{sync_session_error, SyncResult};
-use aura_core::effects::CryptoEffects;
+use aura_core::effects::{CryptoEffects, Ed25519BatchItem};
 #[cfg(test)]
 use aura_core::{hash, KeyResolutionError, TrustedKeyDomain, TrustedPublicKey};
 use aura_core::{ContextId, DeviceId, Hash32, TrustedKeyResolver};
@@ -33,7 +33,7 @@ use aura_guards::{
 };
 #[cfg(test)]
 use aura_signature::sign_ed25519_transcript;
-use aura_signature::{verify_ed25519_transcript, SecurityTranscript};
+use aura_signature::{first_invalid_ed25519_signature, SecurityTranscript};
 
 const RECEIPT_PROTOCOL_VERSION: u16 = 1;
 
@@ -214,33 +214,60 @@ impl ReceiptVerificationProtocol {
     where
         E: CryptoEffects + Send + Sync,
     {
+        let check = self.prepare_receipt(receipt, key_resolver)?;
+        let receipt = receipt.payload();
+
+        // Use CryptoEffects to verify the signature with Ed25519
+        let is_valid = crypto_effects
+            .ed25519_verify(&check.message, &check.signature, &check.public_key)
+            .await
+            .map_err(|e| sync_session_error(format!("Ed25519 verification failed: {e}")))?;
+
+        if !is_valid {
+            tracing::warn!(
+                "Receipt signature verification failed for device {} message {:?}",
+                receipt.signer,
+                receipt.message_hash
+            );
+            return Ok(false);
+        }
+
+        tracing::debug!(
+            "Successfully verified receipt signature for device {}",
+            receipt.signer
+        );
+
+        Ok(true)
+    }
+
+    /// Validate a receipt against its verified ingress scope and build the
+    /// signature check over its transcript without running it.
+    fn prepare_receipt(
+        &self,
+        receipt: &VerifiedIngress<Receipt>,
+        key_resolver: &impl TrustedKeyResolver,
+    ) -> SyncResult<Ed25519BatchItem> {
         let expected_signer = receipt
             .evidence()
             .metadata()
             .source_device()
             .ok_or_else(|| sync_session_error("Receipt ingress source is not device-scoped"))?;
         let expected_context = receipt.evidence().metadata().context_id();
-        self.verify_receipt_payload(
+        self.prepare_receipt_payload(
             receipt.payload(),
             expected_signer,
             expected_context,
-            crypto_effects,
             key_resolver,
         )
-        .await
     }
 
-    async fn verify_receipt_payload<E>(
+    fn prepare_receipt_payload(
         &self,
         receipt: &Receipt,
         expected_signer: DeviceId,
         expected_context: ContextId,
-        crypto_effects: &E,
         key_resolver: &impl TrustedKeyResolver,
-    ) -> SyncResult<bool>
-    where
-        E: CryptoEffects + Send + Sync,
-    {
+    ) -> SyncResult<Ed25519BatchItem> {
         // Basic validation
         if receipt.signature.is_empty() {
             return Err(sync_session_error("Receipt has empty signature"));
@@ -300,7 +327,6 @@ impl ReceiptVerificationProtocol {
             (None, None) => {}
         }
 
-        // Verify the signature using CryptoEffects
         tracing::debug!(
             "Verifying receipt signature for device {} over message hash {:?}",
             receipt.signer,
@@ -313,36 +339,28 @@ impl ReceiptVerificationProtocol {
                 sync_session_error(format!("Receipt signer key resolution failed: {e}"))
             })?;
 
-        let transcript = receipt_transcript(receipt)?;
+        let transcript_bytes =
+            receipt_transcript(receipt)?
+                .transcript_bytes()
+                .map_err(|error| {
+                    sync_session_error(format!("Failed to encode receipt transcript: {error}"))
+                })?;
 
-        // Use CryptoEffects to verify the signature with Ed25519
-        let is_valid = verify_ed25519_transcript(
-            crypto_effects,
-            &transcript,
-            &receipt.signature,
+        Ok(Ed25519BatchItem::new(
+            transcript_bytes,
+            receipt.signature.clone(),
             trusted_key.bytes(),
-        )
-        .await
-        .map_err(|e| sync_session_error(format!("Ed25519 verification failed: {e}")))?;
-
-        if !is_valid {
-            tracing::warn!(
-                "Receipt signature verification failed for device {} message {:?}",
-                receipt.signer,
-                receipt.message_hash
-            );
-            return Ok(false);
-        }
-
-        tracing::debug!(
-            "Successfully verified receipt signature for device {}",
-            receipt.signer
-        );
-
-        Ok(true)
+        ))
     }
 
     /// Verify a receipt chain using cryptographic verification
+    ///
+    /// Structural and linkage checks run first while the signature checks
+    /// are collected; the signatures are then verified as one batch. A
+    /// rejected batch is re-checked receipt by receipt, so the result still
+    /// reports the first bad receipt and an earlier bad signature takes
+    /// precedence over a later structural failure, exactly as a sequential
+    /// walk would.
     pub async fn verify_receipt_chain<E>(
         &self,
         receipts: &[VerifiedIngress<Receipt>],
@@ -375,96 +393,112 @@ impl ReceiptVerificationProtocol {
         }
 
         let mut signers = Vec::new();
+        let mut checks = Vec::with_capacity(receipts.len());
         let mut last_timestamp = 0;
         let mut last_receipt_transcript_hash = None;
+        // First non-signature failure; only reported if every signature up to
+        // and including the failing receipt verifies.
+        let mut chain_failure: Option<SyncResult<&'static str>> = None;
 
         for receipt in receipts {
-            // Verify individual receipt cryptographically
-            if !self
-                .verify_receipt(receipt, crypto_effects, key_resolver)
-                .await?
+            let check = match self.prepare_receipt(receipt, key_resolver) {
+                Ok(check) => check,
+                Err(error) => {
+                    chain_failure = Some(Err(error));
+                    break;
+                }
+            };
+            let transcript_hash = Hash32::from_bytes(&check.message);
+            checks.push(check);
+
+            let receipt = receipt.payload();
+            if let Some(violation) =
+                self.chain_violation(receipt, last_timestamp, last_receipt_transcript_hash)
             {
-                return Ok(VerificationResult {
-                    valid: false,
-                    receipts_verified: signers.len() as u32,
-                    chain_depth: receipts_len,
-                    signers,
-                    error: Some("Receipt signature verification failed".to_string()),
-                });
+                chain_failure = Some(Ok(violation));
+                break;
             }
-            let receipt = receipt.payload();
 
-            // Check chronological ordering
-            if self.config.require_chronological && receipt.timestamp < last_timestamp {
-                return Ok(VerificationResult {
-                    valid: false,
-                    receipts_verified: signers.len() as u32,
-                    chain_depth: receipts_len,
-                    signers,
-                    error: Some("Receipts not in chronological order".to_string()),
-                });
-            }
+            signers.push(receipt.signer);
+            last_timestamp = receipt.timestamp;
+            last_receipt_transcript_hash = Some(transcript_hash);
+        }
 
-            // Verify the chain is linked to the exact previous transcript.
-            match (last_receipt_transcript_hash, receipt.previous_receipt_hash) {
-                (Some(expected_previous_hash), Some(actual_previous_hash))
-                    if expected_previous_hash != actual_previous_hash =>
-                {
-                    return Ok(VerificationResult {
-                        valid: false,
-                        receipts_verified: signers.len() as u32,
-                        chain_depth: receipts_len,
-                        signers,
-                        error: Some("Receipt chain linkage mismatch".to_string()),
-                    });
-                }
-                (Some(_), None) => {
-                    return Ok(VerificationResult {
-                        valid: false,
-                        receipts_verified: signers.len() as u32,
-                        chain_depth: receipts_len,
-                        signers,
-                        error: Some(
-                            "Receipt chain is missing previous receipt linkage".to_string(),
-                        ),
-                    });
-                }
-                (None, Some(_)) => {
-                    return Ok(VerificationResult {
-                        valid: false,
-                        receipts_verified: signers.len() as u32,
-                        chain_depth: receipts_len,
-                        signers,
-                        error: Some("Receipt chain starts with a non-root receipt".to_string()),
-                    });
-                }
-                (None, None) | (Some(_), Some(_)) => {}
-            }
+        let invalid = first_invalid_ed25519_signature(crypto_effects, &checks)
+            .await
+            .map_err(|e| sync_session_error(format!("Ed25519 verification failed: {e}")))?;
+        if let Some(index) = invalid {
+            let receipt = receipts[index].payload();
+            tracing::warn!(
+                "Receipt signature verification failed for device {} message {:?} at chain index {}",
+                receipt.signer,
+                receipt.message_hash,
+                index
+            );
+            signers.truncate(index);
+            return Ok(VerificationResult {
+                valid: false,
+                receipts_verified: index as u32,
+                chain_depth: receipts_len,
+                signers,
+                error: Some("Receipt signature verification failed".to_string()),
+            });
+        }
 
-            if let Some(ref prev) = receipt.previous_receipt {
-                if prev.timestamp > receipt.timestamp {
-                    return Ok(VerificationResult {
-                        valid: false,
-                        receipts_verified: signers.len() as u32,
-                        chain_depth: receipts_len,
-                        signers,
-                        error: Some("Previous receipt has later timestamp".to_string()),
-                    });
-                }
+        match chain_failure {
+            Some(Err(error)) => Err(error),
+            Some(Ok(violation)) => Ok(VerificationResult {
+                valid: false,
+                receipts_verified: signers.len() as u32,
+                chain_depth: receipts_len,
+                signers,
+                error: Some(violation.to_string()),
+            }),
+            None => Ok(VerificationResult {
+                valid: true,
+                receipts_verified: receipts_len,
+                chain_depth: receipts_len,
+                signers,
+                error: None,
+            }),
+        }
+    }
+
+    /// Ordering and linkage checks between a receipt and its predecessor.
+    fn chain_violation(
+        &self,
+        receipt: &Receipt,
+        last_timestamp: u64,
+        last_receipt_transcript_hash: Option<Hash32>,
+    ) -> Option<&'static str> {
+        // Check chronological ordering
+        if self.config.require_chronological && receipt.timestamp < last_timestamp {
+            return Some("Receipts not in chronological order");
+        }
+
+        // Verify the chain is linked to the exact previous transcript.
+        match (last_receipt_transcript_hash, receipt.previous_receipt_hash) {
+            (Some(expected_previous_hash), Some(actual_previous_hash))
+                if expected_previous_hash != actual_previous_hash =>
+            {
+                return Some("Receipt chain linkage mismatch");
             }
+            (Some(_), None) => {
+                return Some("Receipt chain is missing previous receipt linkage");
+            }
+            (None, Some(_)) => {
+                return Some("Receipt chain starts with a non-root receipt");
+            }
+            (None, None) | (Some(_), Some(_)) => {}
+        }
 
-            signers.push(receipt.signer);
-            last_timestamp = receipt.timestamp;
-            last_receipt_transcript_hash = Some(receipt_transcript_hash(receipt)?);
+        if let Some(ref prev) = receipt.previous_receipt {
+            if prev.timestamp > receipt.timestamp {
+                return Some("Previous receipt has later timestamp");
+            }
         }
 
-        Ok(VerificationResult {
-            valid: true,
-            receipts_verified: receipts_len,
-            chain_depth: receipts_len,
-            signers,
-            error: None,
-        })
+        None
     }
 
     /// Create a cryptographically signed receipt for tests.
@@ -759,6 +793,51 @@ mod tests {
         assert_eq!(result.chain_depth, 3);
     }
 
+    #[aura_macros::aura_test]
+    async fn receipt_chain_batch_failure_names_the_forged_receipt() {
+        let protocol = ReceiptVerificationProtocol::default();
+        let crypto = RealCryptoHandler::for_simulation_seed([12; 32]);
+        let time = SimulatedTimeHandler::new();
+        let receipt1 = signed_receipt_for_tests(&protocol, &crypto, &time, 1, 100_000, None).await;
+        let mut receipt2 = signed_receipt_for_tests(
+            &protocol,
+            &crypto,
+            &time,
+            2,
+            200_000,
+            Some(Box::new(receipt1.clone())),
+        )
+        .await;
+        let receipt3 = signed_receipt_for_tests(
+            &protocol,
+            &crypto,
+            &time,
+            3,
+            300_000,
+            Some(Box::new(receipt2.clone())),
+        )
+        .await;
+        receipt2.signature[0] ^= 0xff;
+        let receipts = vec![receipt1, receipt2, receipt3];
+        let keys = keys_for_receipts(&receipts);
+        let chain = receipts
+            .into_iter()
+            .map(verified_receipt_for_tests)
+            .collect::<Vec<_>>();
+
+        let result = protocol
+            .verify_receipt_chain(&chain, &crypto, &keys)
+            .await
+            .unwrap();
+        assert!(!result.valid);
+        assert_eq!(result.receipts_verified, 1);
+        assert_eq!(result.signers, vec![DeviceId::from_bytes([1; 32])]);
+        assert!(result
+            .error
+            .unwrap()
+            .contains("signature verification failed"));
+    }
+
     #[aura_macros::aura_test]
     async fn test_chronological_ordering() {
         let protocol = ReceiptVerificationProtocol::default();
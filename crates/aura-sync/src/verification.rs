@@ -692,6 +692,14 @@ mod tests {
             Ok(facts.iter().any(|f| f.id == fact.id))
         }
 
+        async fn fact_inclusion_proof(
+            &self,
+            _fact: &IndexedFact,
+        ) -> Result<Option<aura_core::crypto::merkle::MerkleMountainRangeProof>, AuraError>
+        {
+            Ok(None)
+        }
+
         async fn get_bloom_filter(&self) -> Result<BloomFilter, AuraError> {
             BloomFilter::new(BloomConfig::for_sync(100))
         }
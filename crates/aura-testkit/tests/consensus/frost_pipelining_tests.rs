@@ -8,11 +8,24 @@
 //! - Epoch rotation invalidation behavior
 //! - Duplicate commitment rejection
 //! - WitnessState nonce lifecycle
-
-use aura_consensus::witness::{WitnessSet, WitnessState, WitnessTracker};
-use aura_core::{frost::NonceCommitment, types::Epoch, AuthorityId};
+//! - Pooled nonces driving single-round orchestrator consensus
+//! - Protocol rounds refilling the nonce pool
+
+use aura_consensus::{
+    config::ConsensusRuntimeConfig,
+    frost::FrostConsensusOrchestrator,
+    witness::{WitnessSet, WitnessState, WitnessTracker},
+    ConsensusConfig, ConsensusProtocol, ConsensusRequest,
+};
+use aura_core::{
+    frost::{NonceCommitment, PublicKeyPackage, Share},
+    types::Epoch,
+    AuthorityId, ContextId, Hash32, Prestate,
+};
+use aura_effects::{PhysicalTimeHandler, RealRandomHandler};
 use aura_testkit::builders::keys::helpers::test_frost_key_shares;
 use rand::SeedableRng;
+use std::collections::HashMap;
 
 /// Helper to create test authority IDs
 fn authority(seed: u8) -> AuthorityId {
@@ -142,6 +155,135 @@ async fn test_epoch_rotation_invalidation() {
     );
 }
 
+fn pooled_orchestrator(threshold: u16, total: u16, epoch: Epoch) -> FrostConsensusOrchestrator {
+    let (key_packages, pubkey_package) = test_frost_key_shares(threshold, total, 777);
+    let witnesses: Vec<AuthorityId> = (0..total).map(|i| authority(40 + i as u8)).collect();
+    let shares: HashMap<AuthorityId, Share> = witnesses
+        .iter()
+        .copied()
+        .zip(key_packages.into_values().map(Share::from))
+        .collect();
+    let config = ConsensusConfig::new(threshold, witnesses, epoch)
+        .unwrap_or_else(|err| panic!("consensus config failed: {err:?}"));
+    FrostConsensusOrchestrator::new(config, shares, PublicKeyPackage::from(pubkey_package))
+        .unwrap_or_else(|err| panic!("orchestrator creation failed: {err:?}"))
+}
+
+fn request(seed: u8) -> ConsensusRequest {
+    ConsensusRequest {
+        prestate_hash: Hash32::new([seed; 32]),
+        operation_bytes: vec![seed; 16],
+        operation_hash: Hash32::new([seed.wrapping_add(1); 32]),
+        timeout_ms: None,
+    }
+}
+
+/// Test that a replenished pool carries consensus on the fast path until drained
+///
+/// Every fast-path round must consume one pooled nonce per witness; signing
+/// twice with the same nonce would leak the signing share.
+#[tokio::test]
+async fn test_pooled_fast_path_consumes_nonces() {
+    let orchestrator = pooled_orchestrator(3, 5, Epoch::from(1));
+    let random = RealRandomHandler::new();
+    let time = PhysicalTimeHandler::new();
+
+    let generated = orchestrator
+        .replenish_nonce_pool(&random)
+        .await
+        .unwrap_or_else(|err| panic!("replenish failed: {err:?}"));
+    let depth = orchestrator.fast_path_rounds_available().await;
+    assert!(depth > 0, "Replenished pool should cover fast-path rounds");
+    assert_eq!(generated, depth * 5, "Each witness fills its pool");
+
+    for round in 0..depth {
+        let response = orchestrator
+            .run_consensus(request(round as u8), &random, &time)
+            .await
+            .unwrap_or_else(|err| panic!("consensus failed: {err:?}"));
+        assert!(response.fast_path, "Round {round} should use the pool");
+        let commit = response
+            .result
+            .unwrap_or_else(|err| panic!("round {round} did not commit: {err:?}"));
+        assert!(commit.fast_path);
+        assert_eq!(
+            orchestrator.fast_path_rounds_available().await,
+            depth - round - 1
+        );
+    }
+
+    // Drained pool falls back to the slow path, which seeds one round ahead
+    let response = orchestrator
+        .run_consensus(request(200), &random, &time)
+        .await
+        .unwrap_or_else(|err| panic!("consensus failed: {err:?}"));
+    assert!(!response.fast_path, "Drained pool should use the slow path");
+    assert!(response.result.is_ok());
+    assert_eq!(orchestrator.fast_path_rounds_available().await, 1);
+}
+
+/// Test that every protocol round refills the pool for the next one
+#[tokio::test]
+async fn test_protocol_rounds_replenish_nonce_pool() {
+    let (key_packages, pubkey_package) = test_frost_key_shares(2, 3, 778);
+    let witnesses: Vec<AuthorityId> = (0..3).map(|i| authority(60 + i)).collect();
+    let shares: HashMap<AuthorityId, Share> = witnesses
+        .iter()
+        .copied()
+        .zip(key_packages.into_values().map(Share::from))
+        .collect();
+    let config = ConsensusConfig::new(2, witnesses.clone(), Epoch::from(1))
+        .unwrap_or_else(|err| panic!("consensus config failed: {err:?}"));
+    let protocol = ConsensusProtocol::new(
+        authority(70),
+        ContextId::new_from_entropy([71u8; 32]),
+        config,
+        shares,
+        PublicKeyPackage::from(pubkey_package),
+    )
+    .unwrap_or_else(|err| panic!("protocol creation failed: {err:?}"));
+    let prestate = Prestate::new(vec![(witnesses[0], Hash32::default())], Hash32::default())
+        .unwrap_or_else(|err| panic!("prestate failed: {err:?}"));
+    let capacity = ConsensusRuntimeConfig::default().nonce_pool_depth.get();
+    let random = RealRandomHandler::new();
+    let time = PhysicalTimeHandler::new();
+
+    assert_eq!(protocol.fast_path_rounds_available().await, 0);
+    for round in 0u8..3 {
+        let response = protocol
+            .run_consensus(&prestate, &round, &random, &time)
+            .await
+            .unwrap_or_else(|err| panic!("consensus failed: {err:?}"));
+        assert_eq!(response.fast_path, round > 0, "Round {round} path");
+        assert!(response.result.is_ok());
+        assert_eq!(
+            protocol.fast_path_rounds_available().await,
+            capacity,
+            "Round {round} should leave a full pool"
+        );
+    }
+}
+
+/// Test that an epoch change empties the orchestrator's nonce pool
+#[tokio::test]
+async fn test_epoch_change_drains_nonce_pool() {
+    let orchestrator = pooled_orchestrator(2, 3, Epoch::from(1));
+    let random = RealRandomHandler::new();
+
+    orchestrator
+        .replenish_nonce_pool(&random)
+        .await
+        .unwrap_or_else(|err| panic!("replenish failed: {err:?}"));
+    assert!(orchestrator.fast_path_rounds_available().await > 0);
+
+    orchestrator.handle_epoch_change(Epoch::from(2)).await;
+    assert_eq!(
+        orchestrator.fast_path_rounds_available().await,
+        0,
+        "Pooled nonces must not survive an epoch change"
+    );
+}
+
 /// Test that duplicate commitments are handled correctly
 ///
 /// Verifies that the tracker properly deduplicates commitments from the same witness.